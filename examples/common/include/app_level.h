@@ -76,7 +76,7 @@
  * value, therefore user must not do time consuming operations inside the callback.
  *
  * The smallest possible callback interval for a given transition time will be limited by
- * @ref MODEL_TIMER_TIMEOUT_MIN_TICKS.
+ * @ref MODEL_TRANSITION_ENGINE_TICK_MIN_MS.
  *
  * This module will call the `get_cb` to fetch the present level value from the application.
  *
@@ -100,7 +100,7 @@
 /**
  * Macro to create application level app_level_server_t context.
  *
- * Individual timer instances are created for each model instance.
+ * Transitions of all model instances are driven by the shared transition engine.
  *
  * @param[in] _name                 Name of the app_level_server_t instance
  * @param[in] _force_segmented      If the Generic Level server shall use force segmentation of messages
@@ -111,12 +111,10 @@
  * @param[in] _transition_cb        Callback for setting the application transition time and state value to given values.
 */
 #define APP_LEVEL_SERVER_DEF(_name, _force_segmented, _mic_size, _p_dtt, _set_cb, _get_cb, _transition_cb)  \
-    APP_TIMER_DEF(_name ## _timer); \
     static app_level_server_t _name =  \
     {  \
         .server.settings.force_segmented = _force_segmented,  \
         .server.settings.transmic_size = _mic_size,  \
-        .state.transition.timer.p_timer_id = &_name ## _timer,  \
         .p_dtt_ms = _p_dtt, \
         .level_set_cb = _set_cb,  \
         .level_get_cb = _get_cb,  \
@@ -105,7 +105,7 @@ typedef struct
 /**
  * Macro to create application level app_light_ctl_setup_server_t context.
  *
- * Individual timer instances are created for each model instance.
+ * Transitions of all model instances are driven by the shared transition engine.
  * An app light lightness structure needs to be created separately for each model instance.
  *
  * @param[in] _name                     Name of the [app_light_ctl_setup_server_t](@ref __app_light_ctl_setup_server_t) instance.
@@ -116,12 +116,10 @@ typedef struct
  * @param[in] _light_ctl_transition_cb  Callback for setting the application transition time and state value to given values.
  */
 #define APP_LIGHT_CTL_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size, _light_ctl_set_cb, _light_ctl_get_cb, _light_ctl_transition_cb) \
-    APP_TIMER_DEF(_name ## _timer);                                           \
     static app_light_ctl_setup_server_t _name =                               \
     {                                                                         \
         .light_ctl_setup_srv.settings.force_segmented = _force_segmented,     \
         .light_ctl_setup_srv.settings.transmic_size = _mic_size,              \
-        .state.transition.timer.p_timer_id = &_name ## _timer,                \
         .app_light_ctl_set_cb = _light_ctl_set_cb,                            \
         .app_light_ctl_get_cb = _light_ctl_get_cb,                            \
         .app_light_ctl_transition_cb = _light_ctl_transition_cb,              \
@@ -147,6 +145,10 @@ typedef struct
     uint32_t initial_present_temperature32;
     /** Initial present delta_uv required for handling Set/Delta Set message. */
     int16_t initial_present_delta_uv;
+    /** Interpolates the temperature32 state during a Set/Delta Set transition. */
+    model_transition_follower_t temperature32_follower;
+    /** Interpolates the delta_uv state during a Set/Delta Set transition. */
+    model_transition_follower_t delta_uv_follower;
 
     /** Present temperature32 value when message was received */
     uint32_t init_present_temp32_snapshot;
@@ -31,6 +31,7 @@ typedef struct app_light_hsl_state_s {
     uint16_t snapshot_present_hue;
     uint16_t snapshot_target_hue;
     uint16_t initial_present_hue;
+    model_transition_follower_t hue_follower; /* interpolates towards the target in Set/Delta Set */
     app_transition_t transition_hue;
     bool new_tid_hue;                   /* used for Generic Level delta/move transaction identifier */
     uint32_t published_hue_ms;          /* control published time for transition */
@@ -41,6 +42,7 @@ typedef struct app_light_hsl_state_s {
     uint16_t snapshot_present_saturation;
     uint16_t snapshot_target_saturation;
     uint16_t initial_present_saturation;
+    model_transition_follower_t saturation_follower; /* interpolates towards the target in Set/Delta Set */
     app_transition_t transition_saturation;
     bool new_tid_saturation;
     uint32_t published_saturation_ms;
@@ -113,14 +115,10 @@ struct app_light_hsl_setup_server_s {
 
 /* macro to create application level app_light_hsl_setup_server_t context  */
 #define APP_LIGHT_HSL_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size, _light_hsl_set_cb, _light_hsl_get_cb, _light_hsl_transition_cb) \
-    APP_TIMER_DEF(_name ## _timer_hue);                                                 \
-    APP_TIMER_DEF(_name ## _timer_saturation);                                          \
     static app_light_hsl_setup_server_t _name =                                         \
     {                                                                                   \
         .light_hsl_setup_srv.settings.force_segmented = _force_segmented,               \
         .light_hsl_setup_srv.settings.transmic_size = _mic_size,                        \
-        .state.transition_hue.timer.p_timer_id = &_name ## _timer_hue,                  \
-        .state.transition_saturation.timer.p_timer_id = &_name ## _timer_saturation,    \
         .app_light_hsl_set_cb = _light_hsl_set_cb,                                      \
         .app_light_hsl_get_cb = _light_hsl_get_cb,                                      \
         .app_light_hsl_transition_cb = _light_hsl_transition_cb                         \
@@ -86,14 +86,12 @@
 
 #define APP_LIGHT_LC_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size)                     \
     APP_TIMER_DEF(_name ## _fsm_timer);                                                       \
-    APP_TIMER_DEF(_name ## _light_pi_timer);                                                  \
     APP_TIMER_DEF(_name ## _sensor_delay_timer);                                              \
     static app_light_lc_setup_server_t _name =                                                \
     {                                                                                         \
         .light_lc_setup_srv.settings.force_segmented = _force_segmented,                      \
         .light_lc_setup_srv.settings.transmic_size = _mic_size,                               \
         .light_lc_setup_srv.fsm_timer.p_timer_id = &_name ## _fsm_timer,                      \
-        .light_lc_setup_srv.light_pi_timer.p_timer_id = &_name ## _light_pi_timer,            \
         .light_lc_setup_srv.sensor_delay_timer.p_timer_id = &_name ## _sensor_delay_timer,    \
     };
 
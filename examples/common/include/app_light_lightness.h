@@ -85,7 +85,7 @@
 /**
  * Macro to create application level app_light_lightness_setup_server_t context.
  *
- * Individual timer instances are created for each model instance.
+ * Transitions of all model instances are driven by the shared transition engine.
  *
  * @param[in] _name                 Name of the [app_light_lightness_setup_server_t](@ref __app_light_lightness_setup_server_t) instance
  * @param[in] _force_segmented      If the light lightness server shall use force segmentation of messages
@@ -95,14 +95,12 @@
  * @param[in] _transition_cb        Callback for setting the application transition time and state value to given values.
  */
 #define APP_LIGHT_LIGHTNESS_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size, _set_cb, _get_cb, _transition_cb) \
-    APP_TIMER_DEF(_name ## _timer);                                     \
     static app_light_lightness_setup_server_t _name =                   \
     {                                                                   \
         .light_lightness_setup_server.settings.force_segmented = _force_segmented, \
         .light_lightness_setup_server.settings.transmic_size = _mic_size, \
         .app_add_notify.app_add_publish_cb = NULL,                      \
         .app_add_notify.app_notify_set_cb = NULL,                       \
-        .state.transition.timer.p_timer_id = &_name ## _timer,          \
         .app_light_lightness_set_cb = _set_cb,                          \
         .app_light_lightness_get_cb = _get_cb,                          \
         .app_light_lightness_transition_cb = _transition_cb             \
@@ -120,6 +118,8 @@ typedef struct
     uint16_t target_lightness;
     /** Initial present lightness required for handling Set/Delta Set message. */
     uint16_t initial_present_lightness;
+    /** Interpolates from the initial present lightness to the target during a Set/Delta Set transition. */
+    model_transition_follower_t lightness_follower;
 
     /** Present value when message was received */
     uint16_t init_present_snapshot;
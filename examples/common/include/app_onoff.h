@@ -86,7 +86,7 @@
 /**
  * Macro to create application level app_onoff_server_t context.
  *
- * Individual timer instances are created for each model instance.
+ * Transitions of all model instances are driven by the shared transition engine.
  *
  * @param[in] _name                 Name of the app_onoff_server_t instance
  * @param[in] _force_segmented      If the Generic OnOff server shall use force segmentation of messages
@@ -96,12 +96,10 @@
  * @param[in] _transition_cb        Callback for setting the application transition time and state value to given values.
  */
 #define APP_ONOFF_SERVER_DEF(_name, _force_segmented, _mic_size, _set_cb, _get_cb, _transition_cb)  \
-    APP_TIMER_DEF(_name ## _timer); \
     static app_onoff_server_t _name =  \
     {  \
         .server.settings.force_segmented = _force_segmented,  \
         .server.settings.transmic_size = _mic_size,  \
-        .state.transition.timer.p_timer_id = &_name ## _timer,  \
         .onoff_set_cb = _set_cb,  \
         .onoff_get_cb = _get_cb,  \
         .onoff_transition_cb = _transition_cb  \
@@ -189,6 +187,12 @@ struct __app_onoff_server_t
     /** Internal variable. Scene callback interface.
      * @note Available only if  @ref SCENE_SETUP_SERVER_INSTANCES_MAX is equal or larger than 1. */
     app_scene_model_interface_t scene_if;
+    /** Internal variable. Scene snapshot state, an alternative to @ref scene_if. Register it with
+     * @ref app_scene_snapshot_model_add() to store the OnOff state with scene snapshots, and
+     * register @ref scene_if with @ref app_scene_legacy_model_add() to keep recalling the scenes
+     * stored through @ref scene_if.
+     * @note Available only if  @ref SCENE_SETUP_SERVER_INSTANCES_MAX is equal or larger than 1. */
+    scene_snapshot_model_t scene_snapshot;
     /** Internal variable. Pointer to app_scene context.
      * @note Available only if @ref SCENE_SETUP_SERVER_INSTANCES_MAX is equal or larger than 1. */
     app_scene_setup_server_t  * p_app_scene;
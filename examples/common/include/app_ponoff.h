@@ -50,7 +50,7 @@
 /**
  * Macro to create application level app_onoff_server_t context.
  *
- * Individual timer instances are created for each model instance.
+ * Transitions of all model instances are driven by the shared transition engine.
  *
  * @param[in] _name                 Name of the app_onoff_server_t instance
  * @param[in] _force_segmented      If the Generic OnOff server shall use force segmentation of messages
@@ -60,7 +60,6 @@
  * @param[in] _transition_cb        Callback for setting the application transition time and state value to given values.
  */
 #define APP_PONOFF_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size, _set_cb, _get_cb, _transition_cb)  \
-    APP_TIMER_DEF(_name ## _timer); \
     static app_ponoff_setup_server_t _name = \
     {  \
         .server.settings.force_segmented = _force_segmented, \
@@ -69,7 +68,6 @@
         .server.generic_ponoff_srv.generic_onoff_srv.settings.transmic_size = _mic_size, \
         .server.generic_dtt_srv.settings.force_segmented = _force_segmented, \
         .server.generic_dtt_srv.settings.transmic_size = _mic_size, \
-        .state.transition.timer.p_timer_id = &_name ## _timer, \
         .onoff_set_cb = _set_cb, \
         .onoff_get_cb = _get_cb, \
         .onoff_transition_cb = _transition_cb \
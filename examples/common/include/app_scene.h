@@ -41,6 +41,7 @@
 #include <stdint.h>
 
 #include "scene_setup_server.h"
+#include "scene_snapshot.h"
 #include "app_transition.h"
 #include "nrf_mesh_config_examples.h"
 
@@ -64,6 +65,10 @@
  *
  * These callbacks should be implemented by those models that should be stored with scenes (see
  * "Stored with Scene" column in @tagMeshMdlSp for each model).
+ *
+ * Alternatively, models can register their scene state with @ref app_scene_snapshot_model_add().
+ * The states of these models are stored together in one [scene snapshot](@ref SCENE_SNAPSHOT) per
+ * scene, and are applied in one pass on recall.
  * <br>
  * @warning To comply with the @tagMeshMdlSp test cases, the application must adhere to
  * the requirements defined in the following sections:
@@ -77,7 +82,7 @@
 /**
  * Macro to create application level app_scene_setup_server_t context.
  *
- * Individual timer instances are created for each model instance.
+ * Transitions of all model instances are driven by the shared transition engine.
  *
  * @param[in] _name                     Name of the app_scene_server_t instance
  * @param[in] _force_segmented          If the Scene server shall use force segmentation of messages
@@ -87,12 +92,10 @@
  * @param[in] _p_dtt_server             Pointer to default transition time server instance.
 */
 #define APP_SCENE_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size, _transition_cb, _p_dtt_server);  \
-    APP_TIMER_DEF(_name ## _timer);                                             \
     static app_scene_setup_server_t _name =                                     \
     {                                                                           \
         .scene_setup_server.settings.force_segmented = _force_segmented,        \
         .scene_setup_server.settings.transmic_size = _mic_size,                 \
-        .state.transition.timer.p_timer_id = &_name ## _timer,                  \
         .app_scene_transition_cb = _transition_cb,                              \
         .scene_setup_server.p_gen_dtt_server = _p_dtt_server                        \
     };
@@ -217,6 +220,12 @@ struct __app_scene_setup_server_t
     app_scene_model_interface_t * scene_models[APP_SCENE_MODEL_COUNT];
     /** Internal variable. Number of registered models in App Scene. */
     uint32_t next_model_interface;
+    /** Internal variable. Snapshots of the models registered with @ref app_scene_snapshot_model_add(). */
+    scene_snapshot_t snapshot;
+    /** Internal variable. Models registered with @ref app_scene_legacy_model_add(). */
+    app_scene_model_interface_t * legacy_models[APP_SCENE_MODEL_COUNT];
+    /** Internal variable. Number of models registered with @ref app_scene_legacy_model_add(). */
+    uint32_t next_legacy_model;
 };
 
 /** Initializes the behavioral module for the Scene model
@@ -254,6 +263,44 @@ uint32_t app_scene_model_init(app_scene_setup_server_t * p_app, uint8_t element_
 uint32_t app_scene_model_add(app_scene_setup_server_t * p_app,
                              app_scene_model_interface_t * p_app_scene_model_interface);
 
+/** The API is to be called by application to register a model which is to be stored with scene
+ * snapshots.
+ *
+ * Models must be registered in the same order on every boot.
+ *
+ * @param[in] p_app                 Pointer to [app_scene_setup_server_t](@ref
+ *                                  __app_scene_setup_server_t) context.
+ * @param[in] p_model               Pointer to the scene state of the model.
+ *
+ * @retval NRF_SUCCESS              The model is registered successfully.
+ * @retval NRF_ERROR_NULL           NULL pointer is supplied to the function or to the required
+ *                                  member variable pointers.
+ * @retval NRF_ERROR_INVALID_PARAM  The model has no state.
+ * @retval NRF_ERROR_NO_MEM         @ref SCENE_SNAPSHOT_MODELS_MAX models are already added, or the
+ *                                  states would exceed @ref SCENE_SNAPSHOT_STATE_SIZE_MAX.
+ */
+uint32_t app_scene_snapshot_model_add(app_scene_setup_server_t * p_app,
+                                      scene_snapshot_model_t * p_model);
+
+/** The API is to be called by application to keep recalling the scenes stored by earlier firmware
+ * for a model that has moved from @ref app_scene_model_add() to @ref app_scene_snapshot_model_add().
+ *
+ * When a recalled scene has no snapshot, it is recalled through the scene interface of the model
+ * instead. Only the recall and delete callbacks of the interface are used, new scenes are stored
+ * as snapshots.
+ *
+ * @param[in] p_app                         Pointer to [app_scene_setup_server_t](@ref
+ *                                          __app_scene_setup_server_t) context.
+ * @param[in] p_app_scene_model_interface   Pointer to the scene interface the model used before.
+ *
+ * @retval NRF_SUCCESS              The model is registered successfully.
+ * @retval NRF_ERROR_NULL           NULL pointer is supplied to the function.
+ * @retval NRF_ERROR_NO_MEM         The (/@ref APP_SCENE_MODEL_COUNT) number of models already
+ *                                  added.
+ */
+uint32_t app_scene_legacy_model_add(app_scene_setup_server_t * p_app,
+                                    app_scene_model_interface_t * p_app_scene_model_interface);
+
 /**
  * This API is called by the behavioral modules of other models to inform that the current state of
  * the device has been changed.
@@ -42,6 +42,7 @@
 #include "model_common.h"
 
 #include "app_sensor.h"
+#include "sensor_cadence.h"
 #include "sensor_utils.h"
 
 
@@ -61,8 +62,6 @@ typedef uint32_t chr_volume_t;
 
 typedef struct __sensor_cadence_t sensor_cadence_t;
 
-typedef bool (*sensor_in_fast_region_t)(sensor_cadence_t *);
-typedef bool (*sensor_delta_trigger_fast_t)(sensor_cadence_t *);
 typedef uint16_t (*cadence_value_marshall_t)(sensor_cadence_t *, uint8_t *, uint16_t);
 
 struct __sensor_cadence_t
@@ -78,8 +77,7 @@ struct __sensor_cadence_t
     uint8_t * p_fast_cadence_high;                   /**< Value for fast cadence range */
     uint8_t * p_previous_value;                      /**< The previous sensor value */
     uint8_t * p_current_value;                       /**< The current sensor value */
-    sensor_in_fast_region_t in_fast_region;          /**< Function returning whether the value is in the fast cadence region */
-    sensor_delta_trigger_fast_t delta_trigger_fast;  /**< Function returning whether the delta should trigger fast cadence */
+    sensor_cadence_eval_t eval;                      /**< The cadence compiled for evaluating samples */
     cadence_value_marshall_t value_marshall;         /**< Function to marshall the data in the supplied buffer into correct format */
     uint16_t property_id;                            /**< Sensor property ID */
     uint8_t fast_period_exponent;                    /**< Fast cadence exponent */
@@ -40,8 +40,8 @@
 
 #include <stdint.h>
 
-#include "app_timer.h"
 #include "model_common.h"
+#include "model_transition_engine.h"
 #include "fsm.h"
 #include "timer_scheduler.h"
 
@@ -59,8 +59,9 @@
  * @ref app_transition_transition_tick_cb_t callbacks, therefore user must not do time
  * consuming operations inside the callback.
  *
- * The smallest possible callback interval for a given transition time will be limited by
- * @ref MODEL_TIMER_TIMEOUT_MIN_TICKS.
+ * All transitions are driven by the shared @ref MODEL_TRANSITION_ENGINE, so the callback interval
+ * adapts to the transition: a tick is generated for every change of the transition progress, but
+ * never more often than the requested minimum step time or @ref MODEL_TRANSITION_ENGINE_TICK_MIN_MS.
  *
  * @{
  */
@@ -154,8 +155,8 @@ struct __app_transition_t
     /** Time to delay the requested transition. */
     uint32_t delay_ms;
 
-    /** Transition timer */
-    model_timer_t timer;
+    /** Transition engine channel */
+    model_transition_channel_t channel;
     /** Delay timer */
     timer_event_t delay_timer;
     /** Context to be passed to triggered callbacks */
@@ -185,6 +186,50 @@ uint32_t app_transition_remaining_time_get(app_transition_t * p_transition);
  */
 uint32_t app_transition_elapsed_time_get(app_transition_t * p_transition);
 
+/** Gets the transition progress.
+ *
+ * The progress moves linearly from zero at the start of the transition to the `required_delta` of
+ * the ongoing transition at the end of it. For a move transition, the progress keeps growing by
+ * `required_delta` every `transition_time_ms`.
+ *
+ * @param[in]  p_transition   Pointer to transition context.
+ *
+ * @returns Change of the value since the start of the transition.
+ */
+static inline int32_t app_transition_progress_get(const app_transition_t * p_transition)
+{
+    return model_transition_engine_value_get(&p_transition->channel);
+}
+
+/** Starts interpolating a value over the ongoing transition.
+ *
+ * Used by the transition start callback, or right after a retarget, for values that don't move by
+ * the `required_delta` of the transition, like the components of a color.
+ *
+ * @param[in]  p_transition   Pointer to transition context.
+ * @param[out] p_follower     Follower to start.
+ * @param[in]  delta          Change of the value over the transition.
+ */
+static inline void app_transition_follower_start(const app_transition_t * p_transition,
+                                                 model_transition_follower_t * p_follower,
+                                                 int32_t delta)
+{
+    model_transition_engine_follower_start(p_follower, &p_transition->channel, delta);
+}
+
+/** Gets the change of a value interpolated with @ref app_transition_follower_start.
+ *
+ * @param[in]     p_transition   Pointer to transition context.
+ * @param[in,out] p_follower     Follower started on the ongoing transition.
+ *
+ * @returns Change of the value since the start of the transition.
+ */
+static inline int32_t app_transition_follower_get(const app_transition_t * p_transition,
+                                                  model_transition_follower_t * p_follower)
+{
+    return model_transition_engine_follower_value_get(p_follower, &p_transition->channel);
+}
+
 /** Checks if the transition time has been complete.
  *
  *
@@ -201,6 +246,23 @@ bool app_transition_time_complete_check(app_transition_t * p_transition);
  */
 void app_transition_trigger(app_transition_t * p_transition);
 
+/** Retargets the ongoing transition with the requested transition parameters.
+ *
+ * Unlike @ref app_transition_trigger, the transition is not restarted: the transition start
+ * callback is not called and the ongoing transition continues from its present value towards the
+ * new target, reaching it after the requested transition time. This is used for a stream of
+ * cumulative Delta Set messages, where each message moves the target of the same transaction.
+ *
+ * @param[in]  p_transition     Pointer to transition context.
+ * @param[in]  required_delta   Change of the value from the present value to the new target.
+ *
+ * @retval  True    If the ongoing transition has been retargeted.
+ * @retval  False   If there is no ongoing transition that can be retargeted: the transition is idle,
+ *                  delayed or a move, or the requested parameters would not start a transition.
+ *                  Use @ref app_transition_trigger instead.
+ */
+bool app_transition_retarget(app_transition_t * p_transition, int32_t required_delta);
+
 /** Aborts the transition if any in progress.
  *
  * @param[in]  p_transition   Pointer to transition context.
@@ -212,10 +274,6 @@ void app_transition_abort(app_transition_t *p_transition);
  * @param[in] p_transition          Pointer to the app_transition_t structure
  *
  * @retval NRF_SUCCESS              The transition module is initialized successfully.
- * @retval NRF_ERROR_NULL           NULL pointer is supplied to the function or to the required
- *                                  member variable pointers.
- * @retval NRF_ERROR_INVALID_PARAM  If the application timer module has not been initialized.
- * @retval NRF_ERROR_INVALID_STATE  If the application timer is running.
 */
 uint32_t app_transition_init(app_transition_t * p_transition);
 
@@ -58,6 +58,16 @@
  */
 void ble_stack_init(void);
 
+/**
+ * Sets the size of the SoftDevice GATT notification queue to @ref MESH_GATT_HVN_TX_QUEUE_SIZE.
+ *
+ * Must be called between nrf_sdh_ble_default_cfg_set() and nrf_sdh_ble_enable(). Does nothing
+ * when the size is the SoftDevice default.
+ *
+ * @param[in] ram_start Start of the application RAM, as given by nrf_sdh_ble_default_cfg_set().
+ */
+void ble_gatts_hvn_queue_cfg_set(uint32_t ram_start);
+
 /**
  * Initializes the Generic Attribute Profile (GAP).
  *
@@ -175,26 +175,33 @@ static void app_level_transition_start_cb(const app_transition_t * p_transition)
     __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1, "Starting transition\n");
 }
 
-static void app_level_transition_tick_cb(const app_transition_t * p_transition)
+static void app_level_transition_retarget(app_level_server_t * p_app)
 {
-    app_level_server_t * p_app = transition_to_app(p_transition);
     app_transition_params_t * p_params = app_transition_ongoing_get(&p_app->state.transition);
 
-    if (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET)
-    {
-        /* Calculate new value using linear interpolation and provide to the application. */
-        int32_t delta = (p_app->state.target_level - p_app->state.initial_present_level);
-        p_app->state.present_level = p_app->state.initial_present_level +
-                                        (delta * (int64_t)app_transition_elapsed_time_get(&p_app->state.transition) /
-                                          (int64_t)p_params->transition_time_ms);
-    }
-    else
+    p_app->state.delta = p_params->required_delta;
+    p_app->state.initial_present_level = p_app->state.present_level;
+    p_app->state.target_level = p_app->state.target_snapshot;
+
+    if (p_app->level_transition_cb != NULL)
     {
-        p_app->state.present_level = p_app->state.initial_present_level +
-                                        (((int64_t)app_transition_elapsed_time_get(&p_app->state.transition) * (int64_t)p_app->state.delta) /
-                                          (int64_t)p_params->transition_time_ms);
+        p_app->level_transition_cb(p_app, p_params->transition_time_ms,
+                                          p_app->state.target_level,
+                                          p_params->transition_type);
     }
 
+    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1, "Retargeting transition\n");
+}
+
+static void app_level_transition_tick_cb(const app_transition_t * p_transition)
+{
+    app_level_server_t * p_app = transition_to_app(p_transition);
+
+    /* The transition delta is the distance from the initial level to the target, and the progress
+     * of a move grows by the delta every transition time. */
+    p_app->state.present_level = p_app->state.initial_present_level +
+                                    app_transition_progress_get(&p_app->state.transition);
+
     if (p_app->level_set_cb != NULL)
     {
         p_app->level_set_cb(p_app, p_app->state.present_level);
@@ -346,7 +353,18 @@ static void generic_level_state_delta_set_cb(const generic_level_server_t * p_se
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Delta SET: initial-level: %d  present-level: %d  target-level: %d\n",
           p_app->state.init_present_snapshot, p_app->state.present_level, p_app->state.target_snapshot);
 
-    app_transition_trigger(&p_app->state.transition);
+    /* A continued transaction moves the target of the ongoing transition, restarting it from the
+     * initial snapshot would make the level jump back on every message of a dimmer stream. */
+    if (!model_transaction_is_new(&p_app->server.tid_tracker) &&
+        app_transition_retarget(&p_app->state.transition,
+                                (int32_t)p_app->state.target_snapshot - (int32_t)p_app->state.present_level))
+    {
+        app_level_transition_retarget(p_app);
+    }
+    else
+    {
+        app_transition_trigger(&p_app->state.transition);
+    }
 
 #if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
     if (p_in->delta_level != 0)
@@ -523,6 +541,8 @@ uint32_t app_level_init(app_level_server_t * p_app, uint8_t element_index)
     }
 
     p_app->server.settings.p_callbacks = &m_level_srv_cbs;
+    p_app->server.settings.coalesce_interval_ms = GENERIC_LEVEL_SERVER_COALESCE_INTERVAL_MS;
+    p_app->server.settings.publish_interval_min_ms = GENERIC_LEVEL_SERVER_PUBLISH_INTERVAL_MIN_MS;
     status = generic_level_server_init(&p_app->server, element_index);
     if (status != NRF_SUCCESS)
     {
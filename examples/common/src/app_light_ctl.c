@@ -826,6 +826,17 @@ static void transition_start_cb(const app_transition_t * p_transition)
     p_app->state.target_temperature32 = p_app->state.target_temp32_snapshot;
     p_app->state.target_delta_uv = p_app->state.target_duv_snapshot;
 
+    if (p_params->transition_type != APP_CTL_TRANSITION_MOVE_SET)
+    {
+        /* The transition delta is the larger of the two changes, each state follows it with its own. */
+        app_transition_follower_start(p_transition, &p_app->state.temperature32_follower,
+                                      (int32_t)p_app->state.target_temperature32 -
+                                      (int32_t)p_app->state.initial_present_temperature32);
+        app_transition_follower_start(p_transition, &p_app->state.delta_uv_follower,
+                                      (int32_t)p_app->state.target_delta_uv -
+                                      (int32_t)p_app->state.initial_present_delta_uv);
+    }
+
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Element %d: starting transition: initial-t32: %d delta: %d tt: %d\n",
           p_app->light_ctl_setup_srv.settings.element_index,
           light_ctl_utils_temperature32_to_temperature(p_app->state.initial_present_temperature32),
@@ -901,8 +912,6 @@ static void transition_tick_cb(const app_transition_t * p_transition)
     uint32_t elapsed_ms;
     uint32_t remaining_ms;
     app_light_ctl_setup_server_t * p_app;
-    int64_t delta_temperature32;
-    int32_t delta_duv;
     int32_t total_time_ms;
     light_ctl_temperature_range_set_params_t range_set;
 
@@ -920,22 +929,17 @@ static void transition_tick_cb(const app_transition_t * p_transition)
     {
         /* Lightness is handled in the other state machine */
         /* Calculate new values using linear interpolation and provide to the application. */
-        delta_temperature32 =
-            ((int64_t)p_app->state.target_temperature32 - (int64_t)p_app->state.initial_present_temperature32);
         p_app->state.present_temperature32 = p_app->state.initial_present_temperature32 +
-            ((int64_t)delta_temperature32 * (int64_t)elapsed_ms / total_time_ms);
-
-        delta_duv = (p_app->state.target_delta_uv - p_app->state.initial_present_delta_uv);
+            app_transition_follower_get(p_transition, &p_app->state.temperature32_follower);
         p_app->state.present_delta_uv = p_app->state.initial_present_delta_uv +
-            ((int64_t)delta_duv * (int64_t)elapsed_ms / total_time_ms);
+            app_transition_follower_get(p_transition, &p_app->state.delta_uv_follower);
     }
     else
     {
         /* A move command only comes from a level client, which is only bound to the temperature
          * state, not the delta UV state */
-        delta_temperature32 = SCALE_UP((int64_t)p_params->required_delta, T32_SCALE_FACTOR);
         p_app->state.present_temperature32 = p_app->state.initial_present_temperature32 +
-            (((int64_t)elapsed_ms * delta_temperature32) / (int64_t)p_params->transition_time_ms);
+            SCALE_UP(app_transition_progress_get(p_transition), T32_SCALE_FACTOR);
     }
 
     ERROR_CHECK(light_ctl_mc_temperature32_range_state_get(p_app->light_ctl_setup_srv.state.handle, &range_set));
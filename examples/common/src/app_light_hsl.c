@@ -1119,6 +1119,11 @@ static void transition_hue_start_cb(const app_transition_t *p_transition)
     }
     p_app->state.target_hue = p_app->state.snapshot_target_hue;
 
+    if (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET) {
+        app_transition_follower_start(p_transition, &p_app->state.hue_follower,
+                                      (int32_t)p_app->state.target_hue - (int32_t)p_app->state.initial_present_hue);
+    }
+
     NRF_LOG_INFO("%s(): element %d: starting transition: init H: %d delta: %d tt: %d",
           __func__,
           p_app->light_hsl_setup_srv.settings.element_index,
@@ -1144,7 +1149,6 @@ static void transition_hue_tick_cb(const app_transition_t *p_transition)
     int32_t total_time_ms;
     uint32_t elapsed_ms;
     uint32_t remaining_ms;
-    int32_t delta;
     int32_t present_hue;
     light_hsl_range_set_params_t range;
 
@@ -1162,14 +1166,10 @@ static void transition_hue_tick_cb(const app_transition_t *p_transition)
     if (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET) {
         /* lightness is handled in the other state machine */
         /* calculate new values using linear interpolation and provide to the application */
-        delta = (int32_t)p_app->state.target_hue - (int32_t)p_app->state.initial_present_hue;
         present_hue = p_app->state.initial_present_hue +
-            ((int64_t)delta * (int64_t)elapsed_ms / total_time_ms);
+            app_transition_follower_get(p_transition, &p_app->state.hue_follower);
     } else {
-        delta = p_params->required_delta;
-        present_hue = p_app->state.initial_present_hue +
-           (((int64_t)elapsed_ms * (int64_t)delta) /
-                (int64_t)p_params->transition_time_ms);
+        present_hue = p_app->state.initial_present_hue + app_transition_progress_get(p_transition);
     }
 
     ERROR_CHECK(light_hsl_mc_range_state_get(p_app->light_hsl_setup_srv.state.handle, &range));
@@ -1286,6 +1286,11 @@ static void transition_saturation_start_cb(const app_transition_t *p_transition)
     }
     p_app->state.target_saturation = p_app->state.snapshot_target_saturation;
 
+    if (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET) {
+        app_transition_follower_start(p_transition, &p_app->state.saturation_follower,
+                                      (int32_t)p_app->state.target_saturation - (int32_t)p_app->state.initial_present_saturation);
+    }
+
     NRF_LOG_INFO("%s(): element %d: starting transition: init S: %d delta: %d tt: %d",
           __func__,
           p_app->light_hsl_setup_srv.settings.element_index,
@@ -1311,7 +1316,6 @@ static void transition_saturation_tick_cb(const app_transition_t *p_transition)
     uint32_t elapsed_ms;
     uint32_t remaining_ms;
     int32_t present_saturation;
-    int32_t delta;
     int32_t total_time_ms;
     light_hsl_range_set_params_t range;
 
@@ -1327,14 +1331,10 @@ static void transition_saturation_tick_cb(const app_transition_t *p_transition)
     remaining_ms = total_time_ms - elapsed_ms;
 
     if (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET) {
-        delta =
-            ((int32_t)p_app->state.target_saturation - (int32_t)p_app->state.initial_present_saturation);
         present_saturation = p_app->state.initial_present_saturation +
-            ((int64_t)delta * (int64_t)elapsed_ms / total_time_ms);
+            app_transition_follower_get(p_transition, &p_app->state.saturation_follower);
     } else  {
-        delta = p_params->required_delta;
-        present_saturation = p_app->state.initial_present_saturation +
-            (((int64_t)elapsed_ms * delta) / (int64_t)p_params->transition_time_ms);
+        present_saturation = p_app->state.initial_present_saturation + app_transition_progress_get(p_transition);
     }
 
     ERROR_CHECK(light_hsl_mc_range_state_get(p_app->light_hsl_setup_srv.state.handle, &range));
@@ -42,6 +42,7 @@
 #include "light_lc_state_utils.h"
 #include "light_lc_mc.h"
 #include "light_lc_fsm.h"
+#include "light_lc_light_pi.h"
 
 #include "mesh_app_utils.h"
 
@@ -325,6 +326,9 @@ static void app_light_lc_scene_recall(const app_scene_model_interface_t * p_app_
         }
     }
 
+    /* The states were restored behind the property setters, refresh the cached regulator coefficients. */
+    light_lc_light_pi_coefficients_update(&p_app->light_lc_setup_srv);
+
     /* Set Light LC Mode state to current value*/
     ERROR_CHECK(light_lc_fsm_mode_on_off_event_generate(&p_app->light_lc_setup_srv, 
                                                         (bool) mode));
@@ -67,6 +67,7 @@ static list_node_t * mp_app_light_lightness_head;
 static bearer_event_flag_t m_transition_abort_flag;
 
 /* Forward declarations */
+static void transition_retarget(app_light_lightness_setup_server_t * p_app);
 static void transition_parameters_set(app_light_lightness_setup_server_t * p_app,
                                       int32_t delta,
                                       const model_transition_t * p_in_transition,
@@ -340,7 +341,18 @@ static void light_lightness_state_delta_set_cb(const light_lightness_setup_serve
           p_params->transition_time_ms,
           p_app->state.target_snapshot);
 
-    app_transition_trigger(&p_app->state.transition);
+    /* A continued transaction moves the target of the ongoing transition instead of restarting it,
+     * so that a dimmer stream changes the lightness smoothly. */
+    if (!p_app->state.new_tid &&
+        app_transition_retarget(&p_app->state.transition,
+                                (int32_t)p_app->state.target_snapshot - (int32_t)p_app->state.present_lightness))
+    {
+        transition_retarget(p_app);
+    }
+    else
+    {
+        app_transition_trigger(&p_app->state.transition);
+    }
 
 #if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
     if (p_in->delta_lightness != 0)
@@ -668,6 +680,10 @@ static uint32_t app_light_lightness_setup_server_init(light_lightness_setup_serv
      */
     p_setup_server->settings.p_callbacks = &light_lightness_setup_srv_cbs;
 
+    /* Merge the messages of a dimmer stream and limit the rate of the resulting publications. */
+    p_setup_server->light_lightness_srv.settings.coalesce_interval_ms = GENERIC_LEVEL_SERVER_COALESCE_INTERVAL_MS;
+    p_setup_server->light_lightness_srv.settings.publish_interval_min_ms = GENERIC_LEVEL_SERVER_PUBLISH_INTERVAL_MIN_MS;
+
     /* The setup server will initialize a generic PonOff instance.
     *  Initialize the PonOff callback structure.
     */
@@ -768,6 +784,14 @@ static void transition_delay_start_cb(const app_transition_t * p_transition)
 #endif
 }
 
+/* The target may be clipped to the range, so the interpolated span can differ from the requested delta. */
+static void lightness_follower_start(app_light_lightness_setup_server_t * p_app)
+{
+    app_transition_follower_start(&p_app->state.transition,
+                                  &p_app->state.lightness_follower,
+                                  (int32_t)p_app->state.target_lightness - (int32_t)p_app->state.initial_present_lightness);
+}
+
 static void transition_start_cb(const app_transition_t * p_transition)
 {
     app_light_lightness_setup_server_t * p_app;
@@ -784,6 +808,11 @@ static void transition_start_cb(const app_transition_t * p_transition)
     }
     p_app->state.target_lightness = p_app->state.target_snapshot;
 
+    if (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET)
+    {
+        lightness_follower_start(p_app);
+    }
+
     p_app->state.published_ms = 0;
 
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO,
@@ -801,6 +830,32 @@ static void transition_start_cb(const app_transition_t * p_transition)
     }
 }
 
+static void transition_retarget(app_light_lightness_setup_server_t * p_app)
+{
+    app_transition_params_t * p_params = app_transition_ongoing_get(&p_app->state.transition);
+
+    p_app->state.initial_present_lightness = p_app->state.present_lightness;
+    p_app->state.target_lightness = p_app->state.target_snapshot;
+    lightness_follower_start(p_app);
+
+    /* The elapsed time of the transition restarts from zero. */
+    p_app->state.published_ms = 0;
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO,
+          "Element %d: retargeting transition: initial-l: %d delta: %d tt: %d\n",
+          p_app->light_lightness_setup_server.settings.element_index,
+          p_app->state.initial_present_lightness,
+          p_params->required_delta,
+          p_params->transition_time_ms);
+
+    if (p_app->app_light_lightness_transition_cb != NULL)
+    {
+        p_app->app_light_lightness_transition_cb(p_app,
+                    p_params->transition_time_ms,
+                    p_app->state.target_lightness);
+    }
+}
+
 
 /* 6.1.2.2.5 Binding with the Light Lightness Range state
  * Light Lightness Actual = Light Lightness Range Min
@@ -854,16 +909,13 @@ static void transition_tick_cb(const app_transition_t * p_transition)
     /* Calculate new value using linear interpolation and provide to the application. */
     if (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET)
     {
-        int32_t delta = (p_app->state.target_lightness - p_app->state.initial_present_lightness);
         present_lightness = p_app->state.initial_present_lightness +
-            (delta * (int64_t)elapsed_ms /
-             (int32_t)p_params->transition_time_ms);
+            app_transition_follower_get(p_transition, &p_app->state.lightness_follower);
     }
     else
     {
         present_lightness = p_app->state.initial_present_lightness +
-            (((int64_t)elapsed_ms * (int64_t)p_params->required_delta) /
-             (int64_t)p_params->transition_time_ms);
+            app_transition_progress_get(p_transition);
     }
 
     range_get(p_app->light_lightness_setup_server.state.handle, &range);
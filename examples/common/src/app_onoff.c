@@ -80,6 +80,18 @@ const app_scene_callbacks_t m_scene_onoff_cbs =
     .scene_delete_cb = app_onoff_scene_delete
 };
 
+static void app_onoff_scene_snapshot_get(const scene_snapshot_model_t * p_model, uint8_t * p_state);
+static void app_onoff_scene_snapshot_apply(const scene_snapshot_model_t * p_model,
+                                           const uint8_t * p_state,
+                                           uint32_t delay_ms,
+                                           uint32_t transition_time_ms);
+
+const scene_snapshot_model_callbacks_t m_scene_snapshot_onoff_cbs =
+{
+    .state_get_cb = app_onoff_scene_snapshot_get,
+    .state_apply_cb = app_onoff_scene_snapshot_apply
+};
+
 #endif
 
 const generic_onoff_server_callbacks_t m_onoff_srv_cbs =
@@ -279,6 +291,34 @@ static void app_onoff_scene_recall(const app_scene_model_interface_t * p_app_sce
     }
 }
 
+static void app_onoff_scene_snapshot_get(const scene_snapshot_model_t * p_model, uint8_t * p_state)
+{
+    app_onoff_server_t * p_app = PARENT_BY_FIELD_GET(app_onoff_server_t, scene_snapshot, p_model);
+
+    p_state[0] = p_app->state.present_onoff;
+}
+
+static void app_onoff_scene_snapshot_apply(const scene_snapshot_model_t * p_model,
+                                           const uint8_t * p_state,
+                                           uint32_t delay_ms,
+                                           uint32_t transition_time_ms)
+{
+    app_onoff_server_t * p_app = PARENT_BY_FIELD_GET(app_onoff_server_t, scene_snapshot, p_model);
+
+    bool present_on_off;
+    p_app->onoff_get_cb(p_app, &present_on_off);
+
+    p_app->state.target_onoff = (p_state[0] != 0);
+    model_transition_t in_transition = {.delay_ms = delay_ms, .transition_time_ms = transition_time_ms};
+
+    if (present_on_off != p_app->state.target_onoff)
+    {
+        app_transition_abort(&p_app->state.transition);
+        transition_parameters_set(p_app, &in_transition);
+        app_transition_trigger(&p_app->state.transition);
+    }
+}
+
 static void app_onoff_scene_delete(const app_scene_model_interface_t * p_app_scene_if,
                                    uint8_t scene_index)
 {
@@ -351,6 +391,8 @@ uint32_t app_onoff_init(app_onoff_server_t * p_app, uint8_t element_index)
 
 #if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
     p_app->scene_if.p_callbacks = &m_scene_onoff_cbs;
+    p_app->scene_snapshot.p_callbacks = &m_scene_snapshot_onoff_cbs;
+    p_app->scene_snapshot.state_size = sizeof(uint8_t);
 #endif
     p_app->state.transition.delay_start_cb = NULL;
     p_app->state.transition.transition_start_cb = transition_start_cb;
@@ -44,6 +44,7 @@
 #include "nrf_mesh_assert.h"
 #include "mesh_app_utils.h"
 #include "scene_mc.h"
+#include "scene_snapshot.h"
 
 #if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
 
@@ -130,7 +131,22 @@ static void scene_state_store_cb(const scene_setup_server_t * p_self,
     uint8_t status_code = SCENE_STATUS_REGISTER_FULL;
 
     uint8_t scene_index;
+    bool is_new_scene = (scene_mc_recall(p_self->state_handle, p_in->scene_number, &scene_index) != NRF_SUCCESS);
     uint32_t status = scene_mc_store(p_self->state_handle, p_in->scene_number, &scene_index);
+    if (status == NRF_SUCCESS)
+    {
+        status = scene_snapshot_store(&p_app->snapshot, scene_index);
+        if (status != NRF_SUCCESS)
+        {
+            /* The snapshot doesn't fit, keep the scene as it was. */
+            __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Scene snapshot store failed: %d\n", status);
+            if (is_new_scene)
+            {
+                ERROR_CHECK(scene_mc_delete(p_self->state_handle, p_in->scene_number, &scene_index));
+            }
+        }
+    }
+
     if (status == NRF_SUCCESS)
     {
         p_app->state.current_scene_number = p_in->scene_number;
@@ -181,6 +197,12 @@ static void scene_state_delete_cb(const scene_setup_server_t * p_self,
             p_app->scene_models[i]->p_callbacks->scene_delete_cb(p_app->scene_models[i],
                                                                  scene_index);
         }
+        for (uint32_t i = 0; i < p_app->next_legacy_model; i++)
+        {
+            p_app->legacy_models[i]->p_callbacks->scene_delete_cb(p_app->legacy_models[i],
+                                                                  scene_index);
+        }
+        ERROR_CHECK(scene_snapshot_delete(&p_app->snapshot, scene_index));
     }
 
     if (p_out != NULL)
@@ -286,6 +308,38 @@ static void scene_state_recall_cb(const scene_setup_server_t * p_self,
             }
 
             transition_parameters_set(p_app, p_transition, APP_TRANSITION_TYPE_SET);
+
+            /* Models in the snapshot start their transitions together. */
+            uint32_t snapshot_status = scene_snapshot_recall(&p_app->snapshot,
+                                                             scene_index,
+                                                             p_app->state.transition.delay_ms,
+                                                             p_app->state.transition.requested_params.transition_time_ms);
+            if (snapshot_status == NRF_ERROR_NOT_FOUND && p_app->next_legacy_model > 0)
+            {
+                /* Stored by earlier firmware, before the models moved to snapshots. */
+                for (uint32_t i = 0; i < p_app->next_legacy_model; i++)
+                {
+                    p_app->legacy_models[i]->p_callbacks->scene_recall_cb(p_app->legacy_models[i],
+                                                                          scene_index,
+                                                                          p_app->state.transition.delay_ms,
+                                                                          p_app->state.transition.requested_params.transition_time_ms);
+                }
+                snapshot_status = NRF_SUCCESS;
+            }
+
+            if (snapshot_status != NRF_SUCCESS)
+            {
+                __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Scene snapshot recall failed: %d\n", snapshot_status);
+                /* Nothing to recall the scene with. */
+                if (p_app->next_model_interface == 0)
+                {
+                    status_code = SCENE_STATUS_NOT_FOUND;
+                }
+            }
+        }
+
+        if (status_code == SCENE_STATUS_SUCCESS)
+        {
             p_app->state.target_scene_number = p_in->scene_number;
 
             for (uint32_t i = 0; i < p_app->next_model_interface; i++)
@@ -341,6 +395,13 @@ static uint32_t app_scene_setup_server_init(scene_setup_server_t * p_setup_serve
         return status;
     }
 
+    app_scene_setup_server_t * p_app = PARENT_BY_FIELD_GET(app_scene_setup_server_t, scene_setup_server, p_setup_server);
+    status = scene_snapshot_init(&p_app->snapshot, p_setup_server->state_handle);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
     /* Initialize the Scene Setup server callback structure. */
    p_setup_server->settings.p_callbacks = &scene_setup_srv_cbs;
 
@@ -490,6 +551,36 @@ uint32_t app_scene_model_add(app_scene_setup_server_t * p_app,
     return NRF_SUCCESS;
 }
 
+uint32_t app_scene_snapshot_model_add(app_scene_setup_server_t * p_app,
+                                      scene_snapshot_model_t * p_model)
+{
+    if (p_app == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    return scene_snapshot_model_add(&p_app->snapshot, p_model);
+}
+
+uint32_t app_scene_legacy_model_add(app_scene_setup_server_t * p_app,
+                                    app_scene_model_interface_t * p_app_scene_model_interface)
+{
+    if ((p_app == NULL) || (p_app_scene_model_interface == NULL))
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (p_app->next_legacy_model >= ARRAY_SIZE(p_app->legacy_models))
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_app->legacy_models[p_app->next_legacy_model] = p_app_scene_model_interface;
+    p_app->next_legacy_model++;
+
+    return NRF_SUCCESS;
+}
+
 void app_scene_model_scene_changed(app_scene_setup_server_t * p_app)
 {
     p_app->state.current_scene_number = SCENE_NUMBER_NO_SCENE;
@@ -62,9 +62,6 @@
 #define SERIALIZED_CADENCE_DELTA_VECTORS (2)
 #define SERIALIZED_CADENCE_VALUE_VECTORS (2)
 
-#define MAXIMUM_MINIMUM_STATUS_INTERVAL_VALUE (26)
-#define MAXIMIM_FAST_CADENCE_PERIOD_DIVISOR_VALUE (15)
-
 static uint64_t m_minimum_publish_interval;
 
 /* static function definitions.
@@ -171,6 +168,30 @@ static inline uint16_t delta_vector_bytes_allocated_get(uint16_t property_id)
     return MAX(bytes_trigger_type_0, bytes_trigger_type_1);
 }
 
+static bool value_is_signed_get(uint16_t property_id)
+{
+    switch (property_id) {
+
+#ifdef SENSOR_PRESENT_AMBIENT_TEMPERATURE_ENABLE
+    case SENSOR_PRESENT_AMBIENT_TEMPERATURE_PROPERTY_ID:
+        return true;
+#endif /* SENSOR_PRESENT_AMBIENT_TEMPERATURE_ENABLE */
+
+#ifdef SENSOR_DESIRED_AMBIENT_TEMPERATURE_ENABLE
+    case SENSOR_DESIRED_AMBIENT_TEMPERATURE_PROPERTY_ID:
+        return true;
+#endif /* SENSOR_DESIRED_AMBIENT_TEMPERATURE_ENABLE */
+
+#ifdef SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_ENABLE
+    case SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_PROPERTY_ID:
+        return true;
+#endif /* SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_ENABLE */
+
+    default:
+        return false;
+    }
+}
+
 static uint16_t cadence_serialized_bytes(sensor_cadence_t * p)
 {
     /*                                            bits     bytes
@@ -229,609 +250,48 @@ static uint32_t cadence_update(sensor_cadence_t * p, uint8_t * p_in, uint16_t by
     /* Consider data after the property id as a uint8_t array.
      */
     bytes -= sizeof(uint16_t);
-    uint16_t offset = 0;
     p_in = &p_in[sizeof(uint16_t)];
 
-    /* 4.1.3.1 Fast Cadence Period Divisor:
-     * "The valid range for the Fast Cadence Period Divisor state is 0–15 and other values are
-     * Prohibited."
+    /* Compiling the cadence validates it, so that the instance is left untouched if the cadence
+     * has prohibited values or is too short.
      */
-    if ((p_in[offset] & CADENCE_DIVISOR_MASK) > MAXIMIM_FAST_CADENCE_PERIOD_DIVISOR_VALUE)
+    sensor_cadence_eval_t eval;
+    uint32_t status = sensor_cadence_compile(&eval,
+                                             p->range_value_bytes_allocated,
+                                             value_is_signed_get(p->property_id),
+                                             p_in,
+                                             bytes);
+    if (status != NRF_SUCCESS)
     {
         __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR,
-              "ERR: prohibited value for cadence divisor ((0x%x (%d), %d) = (value, offset)\n",
-              p_in[offset] & CADENCE_DIVISOR_MASK,
-              p_in[offset] & CADENCE_DIVISOR_MASK,
-              offset);
-        return NRF_ERROR_INVALID_DATA;
+              "ERR: invalid cadence for property 0x%04x (0x%x (%d)) = (status)\n",
+              p->property_id,
+              status,
+              status);
+        return status;
     }
 
-    uint8_t fast_period_exponent = (p_in[offset] & CADENCE_DIVISOR_MASK);
-    uint8_t trigger_type = (p_in[offset++] >> CADENCE_TRIGGER_SHIFT) & CADENCE_TRIGGER_MASK;
+    uint16_t offset = 0;
+    p->fast_period_exponent = (p_in[offset] & CADENCE_DIVISOR_MASK);
+    p->trigger_type = (p_in[offset++] >> CADENCE_TRIGGER_SHIFT) & CADENCE_TRIGGER_MASK;
 
-    uint16_t delta_vector_bytes = delta_vector_bytes_get(p->property_id, trigger_type);
-    if ((offset + delta_vector_bytes) > bytes)
-    {
-        return NRF_ERROR_INVALID_LENGTH;
-    }
-    uint8_t * p_trigger_delta_down = &p_in[offset];
+    uint16_t delta_vector_bytes = delta_vector_bytes_get(p->property_id, p->trigger_type);
+    memcpy(p->p_trigger_delta_down, &p_in[offset], delta_vector_bytes);
     offset += delta_vector_bytes;
-
-    if ((offset + delta_vector_bytes) > bytes)
-    {
-        return NRF_ERROR_INVALID_LENGTH;
-    }
-    uint8_t * p_trigger_delta_up = &p_in[offset];
+    memcpy(p->p_trigger_delta_up, &p_in[offset], delta_vector_bytes);
     offset += delta_vector_bytes;
 
-    if (offset > bytes)
-    {
-        return NRF_ERROR_INVALID_LENGTH;
-    }
-
-    /* 4.1.3.5 Status Min Interval:
-     * "The valid range for the Status Min Interval is 0–26 and other values are Prohibited."
-     */
-    if (p_in[offset] > MAXIMUM_MINIMUM_STATUS_INTERVAL_VALUE)
-    {
-        __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR,
-              "ERR: prohibited value for Status Min Interval (0x%x (%d), %d) = (value, offset)\n",
-              p_in[offset],
-              p_in[offset],
-              offset);
-        return NRF_ERROR_INVALID_DATA;
-
-    }
-    uint8_t min_interval_exponent = p_in[offset++];
+    p->min_interval_exponent = p_in[offset++];
 
-    if ((offset + p->range_value_bytes_allocated) > bytes)
-    {
-        return NRF_ERROR_INVALID_LENGTH;
-    }
-    uint8_t * p_fast_cadence_low = &p_in[offset];
+    memcpy(p->p_fast_cadence_low, &p_in[offset], p->range_value_bytes_allocated);
     offset += p->range_value_bytes_allocated;
+    memcpy(p->p_fast_cadence_high, &p_in[offset], p->range_value_bytes_allocated);
 
-    if ((offset + p->range_value_bytes_allocated) > bytes)
-    {
-        return NRF_ERROR_INVALID_LENGTH;
-    }
-    uint8_t * p_fast_cadence_high = &p_in[offset];
-
-
-    p->fast_period_exponent  = fast_period_exponent;
-    p->trigger_type          = trigger_type;
-    memcpy(p->p_trigger_delta_down, p_trigger_delta_down, delta_vector_bytes);
-    memcpy(p->p_trigger_delta_up,   p_trigger_delta_up,   delta_vector_bytes);
-    p->min_interval_exponent = min_interval_exponent;
-    memcpy(p->p_fast_cadence_low,  p_fast_cadence_low,  p->range_value_bytes_allocated);
-    memcpy(p->p_fast_cadence_high, p_fast_cadence_high, p->range_value_bytes_allocated);
+    p->eval = eval;
 
     return NRF_SUCCESS;
 }
 
-#if SENSOR_MOTION_SENSED_ENABLE || SENSOR_PRESENCE_DETECT_ENABLE || SENSOR_VENDOR_LEAK_DETECT_ENABLE
-static bool chr_uint8_in_fast_region(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    /* Percentage8 data representations specify the current value and the range.
-     */
-    uint8_t value = *p->p_current_value;
-
-    /* @tagMeshMdlSp Section 4.1.3:
-     * "If the Fast Cadence High value is equal or higher than the Fast Cadence Low value, and the
-     * measured value is within the closed interval [Fast Cadence Low, Fast Cadence High], the Sensor
-     * Status messages are published more frequently."
-     *
-     * "If the Fast Cadence High value is lower than the Fast Cadence Low value, and the measured
-     * value is lower than the Fast Cadence High value or is higher than the Fast Cadence Low value,
-     * the Sensor Status messages are published more frequently."
-     */
-    return  (*p->p_fast_cadence_high >= *p->p_fast_cadence_low)
-        ? (value >= *p->p_fast_cadence_low) && (value <= *p->p_fast_cadence_high)
-        : (value > *p->p_fast_cadence_low) || (value < *p->p_fast_cadence_high);
-}
-
-
-static bool chr_uint8_delta_value(uint16_t current,
-                                  uint16_t previous,
-                                  uint8_t  delta_up,
-                                  uint8_t  delta_down)
-{
-    /* "... the format shall be defined by the Format Type of the characteristic that the Sensor
-     * Property ID state references (see Section 4.1.1.1)."
-     *
-     * "The message shall be published when the value of the measured quantity is lower than the
-     * previously published value decremented by the value of the Status Trigger Delta Down state
-     * (see Section 4.1.3.3) or when it is higher than the previously published value incremented
-     * by the value of the Status Trigger Delta Up state (see Section 4.1.3.4)."
-     *
-     */
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-              "Formatted trigger: current: %u, previous: %u, delta up: %u, delta down: %u, diff: %u\n",
-              current, previous, delta_up, delta_down, current > previous ? current - previous : previous - current);
-
-    return (current > previous) ? (delta_up > 0 && (current - previous) >= delta_up)
-                                : (delta_down > 0 && (previous - current) >= delta_down);
-}
-
-static bool chr_uint8_delta_percent(uint16_t current,
-                                    uint16_t previous,
-                                    uint16_t delta_up,
-                                    uint16_t delta_down)
-{
-    if (!previous)
-    {
-        return true;
-    }
-
-    uint16_t trigger;
-    uint16_t difference;
-
-    if (previous > current)
-    {
-        trigger = delta_down;
-        difference = previous - current;
-    }
-    else
-    {
-        trigger = delta_up;
-        difference = current - previous;
-    }
-
-    uint16_t diff_percentage = 100 * ((100 * difference) / previous);
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-          "Unitless trigger: current: %u, previous: %u, delta up: %u, delta down: %u, diff percentage: %u\n",
-          current, previous, delta_up, delta_down, diff_percentage);
-
-    return trigger > 0 && diff_percentage >= trigger;
-}
-
-static bool chr_uint8_delta_trigger_fast(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    /*
-     * Reference @tagMeshMdlSp, Section 4.1.3:
-     * "... the Status Trigger Type (see Section 4.1.3.2), Status Trigger Delta Down (see Section
-     * 4.1.3.3), and the Status Trigger Delta Up (see Section 4.1.3.4) ..." values specify fast
-     * cadence triggers based upon rate of change.
-     */
-    if (p->trigger_type)
-    {
-        /*
-         * Section 4.1.3.2:
-         * For trigger_type = 1:
-         * " ... the unit is "unitless", the format type is 0x06 (uint16), and the value is
-         * represented as a percentage change with a resolution of 0.01 percent.
-         */
-        return chr_uint8_delta_percent((uint16_t)*p->p_current_value,
-                                       (uint16_t)*p->p_previous_value,
-                                       *(uint16_t *)p->p_trigger_delta_up,
-                                       *(uint16_t *)p->p_trigger_delta_down);
-    }
-    else
-    {
-        /* "... the format shall be defined by the Format Type of the characteristic that the Sensor
-         * Property ID state references (see Section 4.1.1.1)."
-         */
-        return chr_uint8_delta_value((uint16_t)*p->p_current_value,
-                                     (uint16_t)*p->p_previous_value,
-                                     *p->p_trigger_delta_up,
-                                     *p->p_trigger_delta_down);
-    }
-}
-#endif /* uint8_t */
-
-
-#if SENSOR_DESIRED_AMBIENT_TEMPERATURE_ENABLE || SENSOR_PRESENT_AMBIENT_TEMPERATURE_ENABLE
-static bool chr_int8_in_fast_region(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    /* uint16 value */
-    int8_t value = *(int8_t *)p->p_current_value;
-    int8_t fast_cadence_low = *(int8_t *)p->p_fast_cadence_low;
-    int8_t fast_cadence_high = *(int8_t *)p->p_fast_cadence_high;
-
-    /* @tagMeshMdlSp Section 4.1.3 */
-    return  (fast_cadence_high >= fast_cadence_low)
-        ? (value >= fast_cadence_low) && (value <= fast_cadence_high)
-        : (value > fast_cadence_low) || (value < fast_cadence_high);
-}
-
-
-static bool chr_int8_delta_value(int16_t current,
-                                 int16_t previous,
-                                 int8_t delta_up,
-                                 int8_t delta_down)
-{
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Formatted trigger: current: %d, previous: %d, delta up: %d, delta down: %d, diff: %d\n",
-        current, previous, delta_up, delta_down, current > previous ? current - previous : previous - current);
-
-    return (current > previous) ? (delta_up > 0 && (current - previous) >= delta_up)
-                                : (delta_down > 0 && (previous - current) >= delta_down);
-}
-
-static bool chr_int8_delta_percent(int16_t current,
-                                   int16_t previous,
-                                   uint16_t delta_up,
-                                   uint16_t delta_down)
-{
-    if (!previous) {
-        return true;
-    }
-
-    uint16_t trigger;
-    uint16_t difference;
-
-    if (previous > current) {
-        trigger = delta_down;
-        difference = previous - current;
-    } else {
-        trigger = delta_up;
-        difference = current - previous;
-    }
-
-    int16_t diff_percentage = 100 * ((100 * difference) / previous);
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Unitless trigger: current: %d, previous: %d, delta up: %d, delta down: %d, diff percentage: %d",
-        current, previous, delta_up, delta_down, diff_percentage);
-
-    return trigger > 0 && diff_percentage >= trigger;
-}
-
-static bool chr_int8_delta_trigger_fast(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    if (p->trigger_type) {
-        return chr_int8_delta_percent(*(int8_t *)p->p_current_value,
-                                      *(int8_t *)p->p_previous_value,
-                                      *(uint16_t *)p->p_trigger_delta_up,
-                                      *(uint16_t *)p->p_trigger_delta_down);
-    } else {
-        return chr_int8_delta_value(*(int8_t *)p->p_current_value,
-                                    *(int8_t *)p->p_previous_value,
-                                    *(int8_t *)p->p_trigger_delta_up,
-                                    *(int8_t *)p->p_trigger_delta_down);
-    }
-}
-#endif /* SENSOR_DESIRED_AMBIENT_TEMPERATURE_ENABLE || SENSOR_PRESENT_AMBIENT_TEMPERATURE_ENABLE */
-
-
-#if SENSOR_PRESENT_INPUT_VOLTAGE_ENABLE                 || \
-    SENSOR_PRESENT_INPUT_CURRENT_ENABLE                 || \
-    SENSOR_PRESENT_AMBIENT_RELATIVE_HUMIDITY_ENABLE     || \
-    SENSOR_PRESENT_INDOOR_RELATIVE_HUMIDITY_ENABLE      || \
-    SENSOR_PRESENT_OUTDOOR_RELATIVE_HUMIDITY_ENABLE
-static bool chr_uint16_in_fast_region(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    /* uint16 value */
-    uint16_t value = *(uint16_t *)p->p_current_value;
-    uint16_t fast_cadence_low = *(uint16_t *)p->p_fast_cadence_low;
-    uint16_t fast_cadence_high = *(uint16_t *)p->p_fast_cadence_high;
-
-    /* @tagMeshMdlSp Section 4.1.3 */
-    return  (fast_cadence_high >= fast_cadence_low)
-        ? (value >= fast_cadence_low) && (value <= fast_cadence_high)
-        : (value > fast_cadence_low) || (value < fast_cadence_high);
-}
-
-
-static bool chr_uint16_delta_value(uint16_t current,
-                                   uint16_t previous,
-                                   uint16_t delta_up,
-                                   uint16_t delta_down)
-{
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Formatted trigger: current: %u, previous: %u, delta up: %u, delta down: %u, diff: %u\n",
-        current, previous, delta_up, delta_down, current > previous ? current - previous : previous - current);
-
-    return (current > previous) ? (delta_up > 0 && (current - previous) >= delta_up)
-                                : (delta_down > 0 && (previous - current) >= delta_down);
-}
-
-static bool chr_uint16_delta_percent(uint16_t current,
-                                     uint16_t previous,
-                                     uint16_t delta_up,
-                                     uint16_t delta_down)
-{
-    if (!previous) {
-        return true;
-    }
-
-    uint16_t trigger;
-    uint16_t difference;
-
-    if (previous > current) {
-        trigger = delta_down;
-        difference = previous - current;
-    } else {
-        trigger = delta_up;
-        difference = current - previous;
-    }
-
-    uint16_t diff_percentage = 100 * ((100 * difference) / previous);
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Unitless trigger: current: %u, previous: %u, delta up: %u, delta down: %u, diff percentage: %u",
-        current, previous, delta_up, delta_down, diff_percentage);
-
-    return trigger > 0 && diff_percentage >= trigger;
-}
-
-static bool chr_uint16_delta_trigger_fast(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    if (p->trigger_type) {
-        return chr_uint16_delta_percent(*(uint16_t *)p->p_current_value,
-                                        *(uint16_t *)p->p_previous_value,
-                                        *(uint16_t *)p->p_trigger_delta_up,
-                                        *(uint16_t *)p->p_trigger_delta_down);
-    } else {
-        return chr_uint16_delta_value(*(uint16_t *)p->p_current_value,
-                                      *(uint16_t *)p->p_previous_value,
-                                      *(uint16_t *)p->p_trigger_delta_up,
-                                      *(uint16_t *)p->p_trigger_delta_down);
-    }
-}
-#endif /* uint16 */
-
-
-#if SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_ENABLE
-static bool chr_int16_in_fast_region(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    /* uint16 value */
-    uint16_t value = *(int16_t *)p->p_current_value;
-    uint16_t fast_cadence_low = *(int16_t *)p->p_fast_cadence_low;
-    uint16_t fast_cadence_high = *(int16_t *)p->p_fast_cadence_high;
-
-    /* @tagMeshMdlSp Section 4.1.3 */
-    return  (fast_cadence_high >= fast_cadence_low)
-        ? (value >= fast_cadence_low) && (value <= fast_cadence_high)
-        : (value > fast_cadence_low) || (value < fast_cadence_high);
-}
-
-
-static bool chr_int16_delta_value(int16_t current,
-                                  int16_t previous,
-                                  int16_t delta_up,
-                                  int16_t delta_down)
-{
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Formatted trigger: current: %d, previous: %d, delta up: %d, delta down: %d, diff: %d\n",
-        current, previous, delta_up, delta_down, current > previous ? current - previous : previous - current);
-
-    return (current > previous) ? (delta_up > 0 && (current - previous) >= delta_up)
-                                : (delta_down > 0 && (previous - current) >= delta_down);
-}
-
-static bool chr_int16_delta_percent(int16_t current,
-                                    int16_t previous,
-                                    uint16_t delta_up,
-                                    uint16_t delta_down)
-{
-    if (!previous) {
-        return true;
-    }
-
-    uint16_t trigger;
-    uint16_t difference;
-
-    if (previous > current) {
-        trigger = delta_down;
-        difference = previous - current;
-    } else {
-        trigger = delta_up;
-        difference = current - previous;
-    }
-
-    uint16_t diff_percentage = 100 * ((100 * difference) / previous);
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Unitless trigger: current: %d, previous: %d, delta up: %d, delta down: %d, diff percentage: %d",
-        current, previous, delta_up, delta_down, diff_percentage);
-
-    return trigger > 0 && diff_percentage >= trigger;
-}
-
-static bool chr_int16_delta_trigger_fast(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    if (p->trigger_type) {
-        return chr_int16_delta_percent(*(int16_t *)p->p_current_value,
-                                       *(int16_t *)p->p_previous_value,
-                                       *(uint16_t *)p->p_trigger_delta_up,
-                                       *(uint16_t *)p->p_trigger_delta_down);
-    } else {
-        return chr_int16_delta_value(*(int16_t *)p->p_current_value,
-                                     *(int16_t *)p->p_previous_value,
-                                     *(uint16_t *)p->p_trigger_delta_up,
-                                     *(uint16_t *)p->p_trigger_delta_down);
-    }
-}
-#endif /* SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_ENABLE */
-
-
-#if SENSOR_PRESENT_DEVICE_INPUT_POWER_ENABLE
-static bool chr_uint24_in_fast_region(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    /* uint32 value */
-    uint32_t value = *(uint32_t *)p->p_current_value & 0x00ffffff;
-    uint32_t fast_cadence_low = *(uint32_t *)p->p_fast_cadence_low & 0x00ffffff;
-    uint32_t fast_cadence_high = *(uint32_t *)p->p_fast_cadence_high & 0x00ffffff;
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "UINT24 In Fast Region: value: %u, low: %u, high: %u, in_fast_region: %d\n",
-        value, fast_cadence_low, fast_cadence_high,
-        (fast_cadence_high >= fast_cadence_low)
-            ? (value >= fast_cadence_low) && (value <= fast_cadence_high)
-            : (value > fast_cadence_low) || (value < fast_cadence_high));
-
-    /* @tagMeshMdlSp Section 4.1.3 */
-    return  (fast_cadence_high >= fast_cadence_low)
-        ? (value >= fast_cadence_low) && (value <= fast_cadence_high)
-        : (value > fast_cadence_low) || (value < fast_cadence_high);
-}
-
-
-static bool chr_uint24_delta_value(uint32_t current,
-                                   uint32_t previous,
-                                   uint32_t delta_up,
-                                   uint32_t delta_down)
-{
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Formatted trigger: current: %d, previous: %d, delta up: %d, delta down: %d, diff: %d\n",
-        current, previous, delta_up, delta_down, current > previous ? current - previous : previous - current);
-
-    return (current > previous) ? (delta_up > 0 && (current - previous) >= delta_up)
-                                : (delta_down > 0 && (previous - current) >= delta_down);
-}
-
-static bool chr_uint24_delta_percent(uint32_t current,
-                                     uint32_t previous,
-                                     uint16_t delta_up,
-                                     uint16_t delta_down)
-{
-    if (!previous) {
-        return true;
-    }
-
-    uint16_t trigger;
-    uint32_t difference;
-
-    if (previous > current) {
-        trigger = delta_down;
-        difference = previous - current;
-    } else {
-        trigger = delta_up;
-        difference = current - previous;
-    }
-
-    uint16_t diff_percentage = 100 * ((100 * difference) / previous);
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Unitless trigger: current: %u, previous: %u, delta up: %u, delta down: %u, diff percentage: %u",
-        current, previous, delta_up, delta_down, diff_percentage);
-
-    return trigger > 0 && diff_percentage >= trigger;
-}
-
-static bool chr_uint24_delta_trigger_fast(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    if (p->trigger_type) {
-        return chr_uint24_delta_percent(*(uint32_t *)p->p_current_value & 0x00ffffff,
-                                        *(uint32_t *)p->p_previous_value & 0x00ffffff,
-                                        *(uint16_t *)p->p_trigger_delta_up,
-                                        *(uint16_t *)p->p_trigger_delta_down);
-    } else {
-        return chr_uint24_delta_value(*(uint32_t *)p->p_current_value & 0x00ffffff,
-                                      *(uint32_t *)p->p_previous_value & 0x00ffffff,
-                                      *(uint32_t *)p->p_trigger_delta_up,
-                                      *(uint32_t *)p->p_trigger_delta_down);
-    }
-}
-#endif /* SENSOR_PRESENT_DEVICE_INPUT_POWER_ENABLE */
-
-
-#if SENSOR_PRECISE_TOTAL_DEVICE_ENERGY_USE_ENABLE || SENSOR_PRESSURE_ENABLE || SENSOR_VENDOR_VOLUME_COMSUMPTION_ENABLE
-static bool chr_uint32_in_fast_region(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    /* uint32 value */
-    uint32_t value = *(uint32_t *)p->p_current_value;
-    uint32_t fast_cadence_low = *(uint32_t *)p->p_fast_cadence_low;
-    uint32_t fast_cadence_high = *(uint32_t *)p->p_fast_cadence_high;
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "UINT32 In Fast Region: value: %u, low: %u, high: %u, in_fast_region: %d\n",
-        value, fast_cadence_low, fast_cadence_high,
-        (fast_cadence_high >= fast_cadence_low)
-            ? (value >= fast_cadence_low) && (value <= fast_cadence_high)
-            : (value > fast_cadence_low) || (value < fast_cadence_high));
-
-    /* @tagMeshMdlSp Section 4.1.3 */
-    return  (fast_cadence_high >= fast_cadence_low)
-        ? (value >= fast_cadence_low) && (value <= fast_cadence_high)
-        : (value > fast_cadence_low) || (value < fast_cadence_high);
-}
-
-
-static bool chr_uint32_delta_value(uint32_t current,
-                                   uint32_t previous,
-                                   uint32_t delta_up,
-                                   uint32_t delta_down)
-{
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Formatted trigger: current: %u, previous: %u, delta up: %u, delta down: %u, diff: %u\n",
-        current, previous, delta_up, delta_down, current > previous ? current - previous : previous - current);
-
-    return (current > previous) ? (delta_up > 0 && (current - previous) >= delta_up)
-                                : (delta_down > 0 && (previous - current) >= delta_down);
-}
-
-static bool chr_uint32_delta_percent(uint32_t current,
-                                     uint32_t previous,
-                                     uint16_t delta_up,
-                                     uint16_t delta_down)
-{
-    if (!previous) {
-        return true;
-    }
-
-    uint16_t trigger;
-    uint32_t difference;
-
-    if (previous > current) {
-        trigger = delta_down;
-        difference = previous - current;
-    } else {
-        trigger = delta_up;
-        difference = current - previous;
-    }
-
-    uint16_t diff_percentage = 100 * ((100 * difference) / previous);
-
-    __LOG(LOG_SRC_APP, LOG_LEVEL_DBG1,
-        "Unitless trigger: current: %u, previous: %u, delta up: %u, delta down: %u, diff percentage: %u",
-        current, previous, delta_up, delta_down, diff_percentage);
-
-    return trigger > 0 && diff_percentage >= trigger;
-}
-
-static bool chr_uint32_delta_trigger_fast(sensor_cadence_t * p)
-{
-    NRF_MESH_ASSERT(p);
-
-    if (p->trigger_type) {
-        return chr_uint32_delta_percent(*(uint32_t *)p->p_current_value,
-                                        *(uint32_t *)p->p_previous_value,
-                                        *(uint16_t *)p->p_trigger_delta_up,
-                                        *(uint16_t *)p->p_trigger_delta_down);
-    } else {
-        return chr_uint32_delta_value(*(uint32_t *)p->p_current_value,
-                                      *(uint32_t *)p->p_previous_value,
-                                      *(uint32_t *)p->p_trigger_delta_up,
-                                      *(uint32_t *)p->p_trigger_delta_down);
-    }
-}
-#endif /* uint32_t */
-
-
 static uint16_t mpid_a_value_marshall(sensor_cadence_t * p, uint8_t * buffer, uint16_t buffer_bytes)
 {
     /* @tagMeshMdlSp section 4.2.14 Sensor Status defines the marshalled data format.
@@ -923,6 +383,21 @@ static uint8_t * cadence_serialize(sensor_cadence_t * p, uint8_t * p_buffer)
     return p_buffer;
 }
 
+/* Compiles the cadence instance's current settings into its evaluator.
+ */
+static void cadence_compile(sensor_cadence_t * p)
+{
+    uint8_t buffer[SERIALIZED_CADENCE_SCALAR_BYTES + 4 * SENSOR_CADENCE_VALUE_BYTES_MAX];
+
+    NRF_MESH_ASSERT(cadence_serialized_bytes(p) <= sizeof(buffer));
+    (void) cadence_serialize(p, buffer);
+    NRF_MESH_ERROR_CHECK(sensor_cadence_compile(&p->eval,
+                                                p->range_value_bytes_allocated,
+                                                value_is_signed_get(p->property_id),
+                                                &buffer[sizeof(uint16_t)],
+                                                cadence_serialized_bytes(p) - sizeof(uint16_t)));
+}
+
 static void sensor_last_published_set(sensor_cadence_t * p)
 {
     memcpy(p->p_previous_value, p->p_current_value, p->range_value_bytes_allocated);
@@ -1085,10 +560,9 @@ static bool cadence_restart(sensor_cadence_t * p, uint64_t publish_period_us)
      * 4.1.3.2), Status Trigger Delta Down (see Section 4.1.3.3), and the Status Trigger Delta Up
      * (see Section 4.1.3.4).
      */
-    if (publish_period_us > 0 && p->fast_period_exponent > 0 && !model_timer_is_running(&p->timer) && p->in_fast_region(p))
+    if (publish_period_us > 0 && p->fast_period_exponent > 0 && !model_timer_is_running(&p->timer)
+        && (sensor_cadence_evaluate(&p->eval, p->p_current_value, p->p_previous_value) & SENSOR_CADENCE_FLAG_FAST_REGION))
     {
-        uint64_t period_us = publish_period_us >> p->fast_period_exponent;
-        uint64_t min_us;
         uint32_t status;
 
         /* @tagMeshMdlSp Section 4.1.3.5:
@@ -1096,10 +570,7 @@ static bool cadence_restart(sensor_cadence_t * p, uint64_t publish_period_us)
          * between publishing two consecutive Sensor Status messages. The value is represented as 2^n
          * milliseconds."
          */
-        if (period_us < (min_us = MS_TO_US(1ull << p->min_interval_exponent)))
-        {
-            period_us = min_us;
-        }
+        uint64_t period_us = sensor_cadence_fast_period_us_get(&p->eval, publish_period_us);
 
         p->timer.timeout_rtc_ticks = (period_us < m_minimum_publish_interval)
                                    ? MODEL_TIMER_TIMEOUT_MIN_TICKS
@@ -1267,6 +738,7 @@ static inline sensor_cadence_t * cadence_create(app_sensor_server_t * p_server,
     p->fast_period_exponent  = 0;
     p->trigger_type          = 0;
     p->min_interval_exponent = 10;      /* 2^10ms = 512ms */
+    cadence_compile(p);
 
     p->p_server = p_server;
     p->timer.p_timer_id = &p_server->p_cadence_timer_ids[property_index];
@@ -1490,167 +962,20 @@ void sensor_initialize(app_sensor_server_t *p_server)
     for (uint8_t i = 0; i < (uint8_t) p_server->p_sensor_property_array[0]; i++)
     {
         uint16_t property_id;
-        sensor_cadence_t * p;     /* The cadence instance */
 
-        switch ((property_id = p_server->p_sensor_property_array[i + 1]))
+        /* Cadence instances are created for the supported property IDs only.
+         */
+        property_id = p_server->p_sensor_property_array[i + 1];
+        if (range_vector_bytes_get(property_id) != 0)
         {
-#ifdef SENSOR_MOTION_SENSED_ENABLE
-            case SENSOR_MOTION_SENSED_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint8_in_fast_region;
-                p->delta_trigger_fast = chr_uint8_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_MOTION_SENSED_ENABLE */
-
-#ifdef SENSOR_PRESENCE_DETECT_ENABLE
-            case SENSOR_PRESENCE_DETECT_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint8_in_fast_region;
-                p->delta_trigger_fast = chr_uint8_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENCE_DETECT_ENABLE */
-
-#ifdef SENSOR_PRESENT_AMBIENT_TEMPERATURE_ENABLE
-            case SENSOR_PRESENT_AMBIENT_TEMPERATURE_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_int8_in_fast_region;
-                p->delta_trigger_fast = chr_int8_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENT_AMBIENT_TEMPERATURE_ENABLE */
-
-#if SENSOR_PRESENT_DEVICE_INPUT_POWER_ENABLE
-            case SENSOR_PRESENT_DEVICE_INPUT_POWER_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint24_in_fast_region;
-                p->delta_trigger_fast = chr_uint24_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENT_DEVICE_INPUT_POWER_ENABLE */
-
-#if SENSOR_PRESENT_INPUT_CURRENT_ENABLE
-            case SENSOR_PRESENT_INPUT_CURRENT_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint16_in_fast_region;
-                p->delta_trigger_fast = chr_uint16_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENT_INPUT_CURRENT_ENABLE */
-
-#ifdef SENSOR_PRESENT_INPUT_VOLTAGE_ENABLE
-            case SENSOR_PRESENT_INPUT_VOLTAGE_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint16_in_fast_region;
-                p->delta_trigger_fast = chr_uint16_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENT_INPUT_VOLTAGE_ENABLE */
-
-#ifdef SENSOR_DESIRED_AMBIENT_TEMPERATURE_ENABLE
-            case SENSOR_DESIRED_AMBIENT_TEMPERATURE_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_int8_in_fast_region;
-                p->delta_trigger_fast = chr_int8_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_DESIRED_AMBIENT_TEMPERATURE_ENABLE */
-
-#ifdef SENSOR_PRECISE_TOTAL_DEVICE_ENERGY_USE_ENABLE
-            case SENSOR_PRECISE_TOTAL_DEVICE_ENERGY_USE_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint32_in_fast_region;
-                p->delta_trigger_fast = chr_uint32_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRECISE_TOTAL_DEVICE_ENERGY_USE_ENABLE */
-
-#if SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_ENABLE
-            case SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_int16_in_fast_region;
-                p->delta_trigger_fast = chr_int16_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRECISE_PRESENT_AMBIENT_TEMPERATURE_ENABLE */
-
-#if SENSOR_PRESENT_AMBIENT_RELATIVE_HUMIDITY_ENABLE
-            case SENSOR_PRESENT_AMBIENT_RELATIVE_HUMIDITY_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint16_in_fast_region;
-                p->delta_trigger_fast = chr_uint16_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENT_AMBIENT_RELATIVE_HUMIDITY_ENABLE */
-
-#if SENSOR_PRESENT_INDOOR_RELATIVE_HUMIDITY_ENABLE
-            case SENSOR_PRESENT_INDOOR_RELATIVE_HUMIDITY_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint16_in_fast_region;
-                p->delta_trigger_fast = chr_uint16_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENT_INDOOR_RELATIVE_HUMIDITY_ENABLE */
-
-#if SENSOR_PRESENT_OUTDOOR_RELATIVE_HUMIDITY_ENABLE
-            case SENSOR_PRESENT_OUTDOOR_RELATIVE_HUMIDITY_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint16_in_fast_region;
-                p->delta_trigger_fast = chr_uint16_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESENT_OUTDOOR_RELATIVE_HUMIDITY_ENABLE */
-
-#ifdef SENSOR_PRESSURE_ENABLE
-            case SENSOR_PRESSURE_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint32_in_fast_region;
-                p->delta_trigger_fast = chr_uint32_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_PRESSURE_ENABLE */
-
-#ifdef SENSOR_VENDOR_VOLUME_COMSUMPTION_ENABLE
-            case SENSOR_VENDOR_VOLUME_CONSUMPTION_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint32_in_fast_region;
-                p->delta_trigger_fast = chr_uint32_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_VENDOR_VOLUME_COMSUMPTION_ENABLE */
-
-#ifdef SENSOR_VENDOR_LEAK_DETECT_ENABLE
-            case SENSOR_VENDOR_LEAK_DETECT_PROPERTY_ID:
-            {
-                p = cadence_create(p_server, i);
-                p->in_fast_region     = chr_uint8_in_fast_region;
-                p->delta_trigger_fast = chr_uint8_delta_trigger_fast;
-                break;
-            }
-#endif /* SENSOR_VENDOR_LEAK_DETECT_ENABLE */
-
-            default :
-            {
-                __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR,
-                      "ERR: property id 0x%04x (%d) not supported \n",
-                      property_id,
-                      property_id);
-            }
+            (void) cadence_create(p_server, i);
+        }
+        else
+        {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR,
+                  "ERR: property id 0x%04x (%d) not supported \n",
+                  property_id,
+                  property_id);
         }
     }
 
@@ -1767,7 +1092,7 @@ uint32_t sensor_status_publish(app_sensor_server_t * p_server, uint16_t property
 
     (void) cadence_restart(p, publish_period_us);
 
-    if (!p->delta_trigger_fast(p))
+    if (!(sensor_cadence_evaluate(&p->eval, p->p_current_value, p->p_previous_value) & SENSOR_CADENCE_FLAG_DELTA_TRIGGER))
     {
         return NRF_SUCCESS;
     }
@@ -37,8 +37,6 @@
 
 #include "app_transition.h"
 
-#include <stdlib.h>
-
 #include "sdk_config.h"
 #include "example_common.h"
 #include "fsm_assistant.h"
@@ -199,43 +197,20 @@ static void a_transition_start(void * p_data)
 {
     app_transition_t * p_transition = (app_transition_t *) p_data;
 
-    /* Calculate required delta factors required for level change. */
-    uint32_t abs_delta;
-    uint64_t transition_time_us;
-    uint64_t transition_step_us;
-    uint64_t min_transition_step_us;
-
-    // abort ongoing transition if there is any
-    model_timer_abort(&p_transition->timer);
     p_transition->ongoing_params = p_transition->requested_params;
     app_transition_params_t * p_params = &p_transition->ongoing_params;
 
-    abs_delta = abs(p_params->required_delta);
+    NRF_MESH_ASSERT_DEBUG(p_params->required_delta != 0);
 
-    NRF_MESH_ASSERT_DEBUG(abs_delta > 0);
-
-    transition_time_us = MS_TO_US((uint64_t) p_params->transition_time_ms);
-    transition_step_us = transition_time_us/abs_delta;
-    min_transition_step_us = MS_TO_US((uint64_t) p_params->minimum_step_ms);
-    if (transition_step_us < min_transition_step_us)
-    {
-        transition_step_us = min_transition_step_us;
-    }
-
-    if (transition_step_us < MS_TO_US(MODEL_TIMER_PERIOD_MS_GET(MODEL_TIMER_TIMEOUT_MIN_TICKS)))
-    {
-        /* We cannot fire timer more frequently than MODEL_TIMER_TIMEOUT_MIN_TICKS, thus
-        increment present level in suitable steps. */
-        p_transition->timer.timeout_rtc_ticks = MODEL_TIMER_TIMEOUT_MIN_TICKS;
-    }
-    else
+    /* The engine replaces the ongoing transition on the channel, if there is any. */
+    const model_transition_params_t engine_params =
     {
-        /* Perform level transition using time steps corresponding to one step change. */
-        p_transition->timer.timeout_rtc_ticks = MODEL_TIMER_TICKS_GET_US(transition_step_us);
-    }
-
-    p_transition->timer.mode = MODEL_TIMER_MODE_REPEATED;
-    uint32_t status = model_timer_schedule(&p_transition->timer);
+        .delta = p_params->required_delta,
+        .transition_time_ms = p_params->transition_time_ms,
+        .minimum_step_ms = p_params->minimum_step_ms,
+        .is_move = (p_params->transition_type == APP_TRANSITION_TYPE_MOVE_SET)
+    };
+    uint32_t status = model_transition_engine_start(&p_transition->channel, &engine_params);
 
     if ((NRF_SUCCESS == status) && p_transition->transition_start_cb)
     {
@@ -255,7 +230,7 @@ static void a_transition_tick(void * p_data)
 
 static void transition_complete_common(app_transition_t * p_transition)
 {
-    model_timer_abort(&p_transition->timer);
+    model_transition_engine_abort(&p_transition->channel);
     app_transition_params_t * p_params = &p_transition->ongoing_params;
     p_params->transition_time_ms = 0;
 
@@ -287,7 +262,7 @@ static void a_abort(void * p_data)
     p_transition->delay_ms = 0;
     p_transition->ongoing_params.transition_time_ms = 0;
     timer_sch_abort(&p_transition->delay_timer);
-    model_timer_abort(&p_transition->timer);
+    model_transition_engine_abort(&p_transition->channel);
 }
 
 static bool g_set_delay(void * p_data)
@@ -315,7 +290,7 @@ static bool g_transition_complete(void * p_data)
     app_transition_params_t * p_params = &p_transition->ongoing_params;
 
     return (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET &&
-           (MODEL_TIMER_PERIOD_MS_GET(model_timer_elapsed_ticks_get(&p_transition->timer)) >= p_params->transition_time_ms));
+            !model_transition_engine_is_active(&p_transition->channel));
 }
 
 static void delay_cb(timestamp_t timestamp, void * p_context)
@@ -327,9 +302,11 @@ static void delay_cb(timestamp_t timestamp, void * p_context)
     fsm_event_post(&p_transition->fsm, E_DELAY_EXPIRED, p_transition);
 }
 
-static void transition_timer_cb(void * p_context)
+static void transition_channel_cb(model_transition_channel_t * p_channel, int32_t value, bool is_complete)
 {
-    app_transition_t * p_transition = (app_transition_t *) p_context;
+    (void)value;
+    (void)is_complete;
+    app_transition_t * p_transition = (app_transition_t *) p_channel->p_context;
 
     fsm_event_post(&p_transition->fsm, E_TIMEOUT, p_transition);
 }
@@ -347,19 +324,55 @@ void app_transition_abort(app_transition_t *p_transition)
     fsm_event_post(&p_transition->fsm, E_ABORT, p_transition);
 }
 
+bool app_transition_retarget(app_transition_t * p_transition, int32_t required_delta)
+{
+    NRF_MESH_ASSERT(p_transition != NULL);
+    app_transition_params_t * p_params = &p_transition->requested_params;
+
+    if (p_transition->delay_ms > 0 ||
+        p_transition->ongoing_params.transition_type == APP_TRANSITION_TYPE_MOVE_SET ||
+        p_params->transition_type == APP_TRANSITION_TYPE_MOVE_SET ||
+        !model_transition_engine_is_active(&p_transition->channel) ||
+        p_params->transition_time_ms == 0 ||
+        p_params->transition_time_ms == MODEL_TRANSITION_TIME_UNKNOWN ||
+        required_delta == 0)
+    {
+        return false;
+    }
+
+    const model_transition_params_t engine_params =
+    {
+        .delta = required_delta,
+        .transition_time_ms = p_params->transition_time_ms,
+        .minimum_step_ms = p_params->minimum_step_ms,
+        .is_move = false
+    };
+
+    if (model_transition_engine_start(&p_transition->channel, &engine_params) != NRF_SUCCESS)
+    {
+        return false;
+    }
+
+    /* The state machine stays in progress, only the parameters of the ongoing transition change. */
+    p_transition->ongoing_params = *p_params;
+    p_transition->ongoing_params.required_delta = required_delta;
+
+    return true;
+}
+
 uint32_t app_transition_remaining_time_get(app_transition_t * p_transition)
 {
     NRF_MESH_ASSERT(p_transition != NULL);
 
     app_transition_params_t * p_params = &p_transition->ongoing_params;
-    return (p_params->transition_time_ms - MODEL_TIMER_PERIOD_MS_GET(model_timer_elapsed_ticks_get(&p_transition->timer)));
+    return (p_params->transition_time_ms - model_transition_engine_elapsed_ms_get(&p_transition->channel));
 }
 
 uint32_t app_transition_elapsed_time_get(app_transition_t * p_transition)
 {
     NRF_MESH_ASSERT(p_transition != NULL);
 
-    return (MODEL_TIMER_PERIOD_MS_GET(model_timer_elapsed_ticks_get(&p_transition->timer)));
+    return model_transition_engine_elapsed_ms_get(&p_transition->channel);
 }
 
 bool app_transition_time_complete_check(app_transition_t * p_transition)
@@ -372,18 +385,15 @@ bool app_transition_time_complete_check(app_transition_t * p_transition)
 
 uint32_t app_transition_init(app_transition_t * p_transition)
 {
-    uint32_t value;
-
     NRF_MESH_ASSERT(p_transition != NULL);
 
     p_transition->delay_timer.p_context = p_transition;
     p_transition->delay_timer.cb = delay_cb;
 
-    p_transition->timer.p_context = p_transition;
-    p_transition->timer.cb = transition_timer_cb;
-    value =  model_timer_create(&p_transition->timer);
+    p_transition->channel.p_context = p_transition;
+    p_transition->channel.cb = transition_channel_cb;
 
     fsm_init(&p_transition->fsm, &m_fsm_descriptor);
 
-    return value;
+    return NRF_SUCCESS;
 }
@@ -111,6 +111,20 @@ static void conn_params_error_handler(uint32_t nrf_error)
 }
 #endif
 
+#if MESH_FEATURE_GATT_ENABLED
+void ble_gatts_hvn_queue_cfg_set(uint32_t ram_start)
+{
+#if MESH_GATT_HVN_TX_QUEUE_SIZE != BLE_GATTS_HVN_TX_QUEUE_SIZE_DEFAULT
+    /* Let the SoftDevice queue several notifications per connection event. */
+    ble_cfg_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.conn_cfg.conn_cfg_tag = MESH_SOFTDEVICE_CONN_CFG_TAG;
+    cfg.conn_cfg.params.gatts_conn_cfg.hvn_tx_queue_size = MESH_GATT_HVN_TX_QUEUE_SIZE;
+    APP_ERROR_CHECK(sd_ble_cfg_set(BLE_CONN_CFG_GATTS, &cfg, ram_start));
+#endif
+}
+#endif
+
 void ble_stack_init(void)
 {
     uint32_t err_code = nrf_sdh_enable_request();
@@ -132,6 +146,8 @@ void ble_stack_init(void)
     cfg.gap_cfg.device_name_cfg.max_len     = strlen(GAP_DEVICE_NAME);
     APP_ERROR_CHECK(sd_ble_cfg_set(BLE_GAP_CFG_DEVICE_NAME, &cfg, ram_start));
 
+    ble_gatts_hvn_queue_cfg_set(ram_start);
+
     /* Enable BLE stack. */
     err_code = nrf_sdh_ble_enable(&ram_start);
     APP_ERROR_CHECK(err_code);
@@ -24,6 +24,7 @@
 #include "nrf_sdh.h"
 #include "nrf_sdh_ble.h"
 #include "mesh_adv.h"
+#include "ble_softdevice_support.h"
 #include "nrf_mesh_prov_bearer_gatt.h"
 #include "nrf_mesh_gatt.h"
 #include "proxy.h"
@@ -117,6 +118,8 @@ static void sd_state_evt_handler(nrf_sdh_state_evt_t state, void * p_context)
             cfg.gap_cfg.device_name_cfg.max_len     = strlen(GAP_DEVICE_NAME);
             APP_ERROR_CHECK(sd_ble_cfg_set(BLE_GAP_CFG_DEVICE_NAME, &cfg, ram_start));
 
+            ble_gatts_hvn_queue_cfg_set(ram_start);
+
             err_code = nrf_sdh_ble_enable(&ram_start);
             APP_ERROR_CHECK(err_code);
 
@@ -183,7 +183,9 @@ static void app_model_init(void)
 
     /* Instantiate scene server and register onoff server to have scene support */
     ERROR_CHECK(app_scene_model_init(&m_scene_server_0, APP_ONOFF_ELEMENT_INDEX));
-    ERROR_CHECK(app_scene_model_add(&m_scene_server_0, &m_onoff_server_0.scene_if));
+    ERROR_CHECK(app_scene_snapshot_model_add(&m_scene_server_0, &m_onoff_server_0.scene_snapshot));
+    /* Scenes stored before the OnOff state moved to snapshots are recalled from its old entries. */
+    ERROR_CHECK(app_scene_legacy_model_add(&m_scene_server_0, &m_onoff_server_0.scene_if));
     ERROR_CHECK(app_onoff_scene_context_set(&m_onoff_server_0, &m_scene_server_0));
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "App Scene Model Handle: %d\n", m_scene_server_0.scene_setup_server.model_handle);
 #endif
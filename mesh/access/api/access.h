@@ -332,6 +332,22 @@ typedef enum
     ACCESS_PUBLISH_RESOLUTION_MAX = ACCESS_PUBLISH_RESOLUTION_10MIN
 } access_publish_resolution_t;
 
+/**
+ * Trace of the publications sent in one publish timer tick.
+ *
+ * Each publication is a separate access message with its own sequence number and nonce, as
+ * required by the specification.
+ */
+typedef struct
+{
+    /** Number of publications queued for transmission. */
+    uint16_t publications;
+    /** Number of publications that failed. */
+    uint16_t failed;
+    /** Total length of the published access payloads (opcode and parameters), in bytes. */
+    uint32_t payload_bytes;
+} access_publish_trace_t;
+
 /**
  * @}
  */
@@ -406,6 +422,35 @@ uint32_t access_model_add(const access_model_add_params_t * p_model_params,
  */
 uint32_t access_model_publish(access_model_handle_t handle, const access_message_tx_t * p_message);
 
+/**
+ * Publishes an access layer message with the given TTL instead of the publish TTL of the model.
+ *
+ * The TTL applies to this message and its re-transmissions only, the publication state of the model
+ * is not changed. Otherwise the message is published as with @ref access_model_publish.
+ *
+ * @param[in] handle    Access handle for the model that wants to send data.
+ * @param[in] p_message Access layer TX message parameter structure.
+ * @param[in] ttl       TTL of the message, up to @ref NRF_MESH_TTL_MAX.
+ *
+ * @retval NRF_SUCCESS              Successfully queued packet for transmission.
+ * @retval NRF_ERROR_NULL           NULL pointer supplied to function.
+ * @retval NRF_ERROR_INVALID_PARAM  Invalid TTL, model not bound to appkey, publish address not set
+ *                                  or wrong opcode format.
+ * @retval NRF_ERROR_NO_MEM         Not enough memory available for message.
+ * @retval NRF_ERROR_NOT_FOUND      Invalid model handle or model not bound to element.
+ * @retval NRF_ERROR_INVALID_ADDR   The element index is greater than the number of local unicast
+ *                                  addresses stored by the @ref DEVICE_STATE_MANAGER.
+ * @retval NRF_ERROR_INVALID_LENGTH Attempted to send message larger than @ref ACCESS_MESSAGE_LENGTH_MAX.
+ * @retval NRF_ERROR_FORBIDDEN      Failed to allocate a sequence number from network.
+ * @retval NRF_ERROR_INVALID_STATE  There's already a segmented packet that is
+ *                                  being to sent to this destination. Wait for
+ *                                  the transmission to finish before sending
+ *                                  new segmented packets.
+ */
+uint32_t access_model_publish_with_ttl(access_model_handle_t handle,
+                                       const access_message_tx_t * p_message,
+                                       uint8_t ttl);
+
 /**
  * Replies to an access layer message.
  *
@@ -439,6 +484,98 @@ uint32_t access_model_reply(access_model_handle_t handle,
                             const access_message_rx_t * p_message,
                             const access_message_tx_t * p_reply);
 
+/**
+ * Reserves space for a publication, so that the model can serialize its parameters in place.
+ *
+ * Works like @ref access_model_publish, except that the message parameters are not copied from
+ * @c p_message->p_buffer. Instead, @c p_message->length bytes are reserved and returned through
+ * @p pp_params. The model writes its parameters there and calls @ref access_model_tx_commit to
+ * send the message, or @ref access_model_tx_discard to drop it.
+ *
+ * Unsegmented messages are written directly into the network buffer and encrypted in place, which
+ * saves two copies and the intermediate heap allocation. Messages that have to be segmented are
+ * staged in a heap buffer and sent like in @ref access_model_publish.
+ *
+ * @note Only one message can be reserved at a time, and it must be committed or discarded before
+ * returning to the mesh event loop.
+ *
+ * @param[in]  handle    Access handle for the model that wants to send data.
+ * @param[in]  p_message Access layer TX message parameter structure. @c p_buffer is ignored.
+ * @param[out] pp_params Returns a pointer to where the message parameters should be written.
+ *
+ * @retval NRF_SUCCESS              Successfully reserved the message.
+ * @retval NRF_ERROR_NULL           NULL pointer supplied to function.
+ * @retval NRF_ERROR_BUSY           Another message is already reserved.
+ * @retval NRF_ERROR_NO_MEM         Not enough memory available for message.
+ * @retval NRF_ERROR_NOT_FOUND      Invalid model handle or model not bound to element.
+ * @retval NRF_ERROR_INVALID_ADDR   The element index is greater than the number of local unicast
+ *                                  addresses stored by the @ref DEVICE_STATE_MANAGER.
+ * @retval NRF_ERROR_INVALID_PARAM  Model not bound to appkey, publish address not set or wrong
+ *                                  opcode format.
+ * @retval NRF_ERROR_INVALID_LENGTH Attempted to send message larger than @ref ACCESS_MESSAGE_LENGTH_MAX.
+ * @retval NRF_ERROR_FORBIDDEN      Failed to allocate a sequence number from network.
+ */
+uint32_t access_model_publish_reserve(access_model_handle_t handle,
+                                      const access_message_tx_t * p_message,
+                                      uint8_t ** pp_params);
+
+/**
+ * Reserves space for a reply, so that the model can serialize its parameters in place.
+ *
+ * Works like @ref access_model_reply, with the in-place semantics of
+ * @ref access_model_publish_reserve.
+ *
+ * @param[in]  handle    Access handle for the model that wants to send data.
+ * @param[in]  p_message Incoming message that the model is replying to.
+ * @param[in]  p_reply   The reply parameters. @c p_buffer is ignored.
+ * @param[out] pp_params Returns a pointer to where the reply parameters should be written.
+ *
+ * @retval NRF_SUCCESS              Successfully reserved the reply.
+ * @retval NRF_ERROR_NULL           NULL pointer supplied to function.
+ * @retval NRF_ERROR_BUSY           Another message is already reserved.
+ * @retval NRF_ERROR_NO_MEM         Not enough memory available for message.
+ * @retval NRF_ERROR_NOT_FOUND      Invalid model handle or model not bound to element.
+ * @retval NRF_ERROR_INVALID_PARAM  Model not bound to appkey or wrong opcode format.
+ * @retval NRF_ERROR_INVALID_LENGTH Attempted to send message larger than @ref ACCESS_MESSAGE_LENGTH_MAX.
+ * @retval NRF_ERROR_FORBIDDEN      Failed to allocate a sequence number from network.
+ */
+uint32_t access_model_reply_reserve(access_model_handle_t handle,
+                                    const access_message_rx_t * p_message,
+                                    const access_message_tx_t * p_reply,
+                                    uint8_t ** pp_params);
+
+/**
+ * Sends the message reserved with @ref access_model_publish_reserve or
+ * @ref access_model_reply_reserve.
+ *
+ * @param[in] handle Access handle for the model that reserved the message.
+ *
+ * @retval NRF_SUCCESS             Successfully queued packet for transmission.
+ * @retval NRF_ERROR_INVALID_STATE The model has no reserved message.
+ * @retval NRF_ERROR_NO_MEM        Not enough memory available to store the publication for
+ *                                 retransmission. The message was dropped.
+ * @returns Other return values from @ref access_model_publish for segmented messages.
+ */
+uint32_t access_model_tx_commit(access_model_handle_t handle);
+
+/**
+ * Drops the message reserved with @ref access_model_publish_reserve or
+ * @ref access_model_reply_reserve.
+ *
+ * @param[in] handle Access handle for the model that reserved the message.
+ *
+ * @retval NRF_SUCCESS             Successfully dropped the message.
+ * @retval NRF_ERROR_INVALID_STATE The model has no reserved message.
+ */
+uint32_t access_model_tx_discard(access_model_handle_t handle);
+
+/**
+ * Gets the trace of the last publish timer tick that triggered periodic publications.
+ *
+ * @param[out] p_trace Pointer to the structure to copy the trace to.
+ */
+void access_publish_trace_get(access_publish_trace_t * p_trace);
+
 /**
  * Returns the element index for the model handle
  *
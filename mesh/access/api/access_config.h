@@ -103,6 +103,24 @@ uint8_t access_default_ttl_get(void);
  */
 uint32_t access_model_publish_address_set(access_model_handle_t handle,
                                           dsm_handle_t address_handle);
+
+/**
+ * Sends the publications of the given model to another address, without changing its publish address.
+ *
+ * The override is not stored in flash, and is not reported as the publish address of the model. It
+ * applies to all messages published by the model, including retransmissions of acknowledged
+ * messages, until it is cleared.
+ *
+ * @param[in]  handle                   Access model handle.
+ * @param[in]  address_handle           Address to publish to, or @ref DSM_HANDLE_INVALID to clear the
+ *                                      override and publish to the publish address again.
+ *
+ * @retval     NRF_SUCCESS              Successfully set or cleared the override.
+ * @retval     NRF_ERROR_NOT_FOUND      Access handle invalid.
+ * @retval     NRF_ERROR_INVALID_PARAM  Invalid address handle.
+ */
+uint32_t access_model_publish_address_override_set(access_model_handle_t handle,
+                                                   dsm_handle_t address_handle);
 /**
  * Stops the publication with the resetting of states for the given model.
  *
@@ -458,6 +476,20 @@ uint32_t access_model_subscription_list_dealloc(access_model_handle_t handle);
  */
 uint32_t access_model_subscription_lists_share(access_model_handle_t owner, access_model_handle_t other);
 
+/**
+ * Gets the configuration version of a model.
+ *
+ * The version changes every time the publication, subscription or application key binding state
+ * of the model changes, including changes to a subscription list it shares with other models.
+ * Versions are never reused, so data derived from the configuration of a model can be cached and
+ * reused as long as its version stays the same.
+ *
+ * @param[in] handle Access model handle.
+ *
+ * @returns The configuration version of the model, or 0 if the handle is invalid.
+ */
+uint32_t access_model_config_version_get(access_model_handle_t handle);
+
 /** @} */
 
 /**
@@ -533,6 +565,17 @@ uint32_t access_element_vendor_model_count_get(uint16_t element_index, uint8_t *
  */
 uint32_t access_element_models_get(uint16_t element_index, access_model_handle_t * p_models, uint16_t * p_count);
 
+/**
+ * Gets the version of the element and model composition.
+ *
+ * The version changes every time a model is added or an element location changes. Data derived
+ * from the composition, such as the composition data page, can be cached and reused as long as
+ * the version stays the same.
+ *
+ * @returns The current composition version.
+ */
+uint32_t access_composition_version_get(void);
+
 /** @} */
 
 /**
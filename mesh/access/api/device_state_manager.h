@@ -652,6 +652,17 @@ uint32_t dsm_appkey_update(dsm_handle_t app_handle, const uint8_t * p_key);
  */
 uint32_t dsm_appkey_delete(dsm_handle_t app_handle);
 
+/**
+ * Gets the version of the application key set.
+ *
+ * The version changes every time an application key is added or removed, so that data derived from
+ * the application key handles, such as the key indexes bound to a model, can be cached and reused as
+ * long as the version stays the same.
+ *
+ * @returns The current application key version.
+ */
+uint32_t dsm_appkey_version_get(void);
+
 /**
  * Retrieves all the application key indices of the stored application keys of a specific subnetwork.
  *
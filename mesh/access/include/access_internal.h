@@ -64,6 +64,8 @@
 #define ACCESS_PACKET_OPCODE_FORMAT_3BYTE  (0xC0)
 /** Invalid opcode format. */
 #define ACCESS_OPCODE_INVALID              (0x7F)
+/** TTL parameter value for sending with the publish TTL of the model. */
+#define ACCESS_TTL_USE_PUBLISH             (0xFE)
 
 /* Internal state defines used for tracking the state of an instance. */
 #define ACCESS_INTERNAL_STATE_ALLOCATED   (1 << 0)
@@ -145,6 +147,10 @@ typedef struct
     void  * p_args;
     /** Used for tracking a model instance: see the defines ACCESS_INTERNAL_STATE_**. */
     uint8_t internal_state;
+    /** Model configuration version, see @ref access_model_config_version_get. */
+    uint32_t config_version;
+    /** Address handle used instead of the publish address, see @ref access_model_publish_address_override_set. */
+    dsm_handle_t publish_address_override;
 } access_common_t;
 
 typedef struct
@@ -172,6 +178,7 @@ void access_incoming_handle(const access_message_rx_t * p_message);
  *
  * @param[in] handle             Access handle of the model that wants to send data.
  * @param[in] p_tx_message       Message to be published.
+ * @param[in] ttl                TTL of the message, or @ref ACCESS_TTL_USE_PUBLISH.
  * @param[in] p_access_payload   Access payload containing the access
  *                               message and the opcode.
  * @param[in] access_payload_len Access payload length.
@@ -188,8 +195,23 @@ void access_incoming_handle(const access_message_rx_t * p_message);
  */
 uint32_t access_packet_tx(access_model_handle_t handle,
                           const access_message_tx_t * p_tx_message,
+                          uint8_t ttl,
                           const uint8_t *p_access_payload,
                           uint16_t access_payload_len);
 
+/**
+ * Starts tracing a publish timer tick.
+ *
+ * Publications are still sent individually. The publications sent until
+ * @ref access_publish_trace_end is called are only counted in the publication trace.
+ */
+void access_publish_trace_begin(void);
+
+/**
+ * Stops tracing the publish timer tick started with @ref access_publish_trace_begin and stores
+ * its trace.
+ */
+void access_publish_trace_end(void);
+
 /** @} */
 #endif /* ACCESS_INTERNAL_H__ */
@@ -63,6 +63,7 @@ void access_publish_retransmission_init(void);
  * @param[in] model_handle              Access handle of the model that sent data.
  * @param[in] p_publication_retransmit  Retransmit parameters of the model.
  * @param[in] p_tx_message              Parameter structure of the access layer TX message.
+ * @param[in] ttl                       TTL of the message, or @ref ACCESS_TTL_USE_PUBLISH.
  * @param[in] p_access_payload          Access payload to be re-transmitted
                                         containing the access message and the opcode.
  * @param[in] access_payload_len        Access payload length.
@@ -71,6 +72,7 @@ void access_publish_retransmission_init(void);
 void access_publish_retransmission_message_add(access_model_handle_t model_handle,
                                                const access_publish_retransmit_t *p_publication_retransmit,
                                                const access_message_tx_t *p_tx_message,
+                                               uint8_t ttl,
                                                const uint8_t *p_access_payload,
                                                uint16_t access_payload_len);
 
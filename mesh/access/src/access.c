@@ -57,6 +57,8 @@
 #include "mesh_mem.h"
 #include "device_state_manager.h"
 #include "log.h"
+#include "internal_event.h"
+#include "mesh_metrics_internal.h"
 #include "bitfield.h"
 #include "timer.h"
 #include "toolchain.h"
@@ -73,6 +75,32 @@ typedef struct
     uint8_t is_restoring_ended : 1;
 } local_access_status_t;
 
+/** Access message reserved with @ref access_model_publish_reserve or @ref access_model_reply_reserve. */
+typedef struct
+{
+    /** Model owning the reservation, or @ref ACCESS_HANDLE_INVALID if there is none. */
+    access_model_handle_t handle;
+    /** Whether the message is a publication, which may have to be retransmitted. */
+    bool is_publication;
+    /** Whether the payload is written directly into a network buffer. */
+    bool is_in_place;
+    /** Copy of the message parameters, with @c p_buffer pointing at the reserved parameters. */
+    access_message_tx_t tx_message;
+    /** Network parameters resolved at reservation time. */
+    nrf_mesh_tx_params_t tx_params;
+    /** Access payload (opcode and parameters). Heap allocated if @c is_in_place is false. */
+    uint8_t * p_payload;
+} access_tx_reservation_t;
+
+/** Publish tick trace state. */
+typedef struct
+{
+    /** Whether a publish tick is being traced. */
+    bool active;
+    /** Trace of the current publish tick. */
+    access_publish_trace_t trace;
+} publish_trace_t;
+
 /*lint -e415 -e416 Lint fails to understand the boundary checking used for handles in this module (MBTLE-1831). */
 
 /** Access model pool. @ref ACCESS_MODEL_COUNT is set by user at compile time. */
@@ -93,6 +121,21 @@ static uint8_t m_default_ttl = ACCESS_DEFAULT_TTL;
 /** Set of the global flags to keep track of the access layer changes.*/
 static local_access_status_t m_status;
 
+/** Outstanding zero-copy TX reservation. */
+static access_tx_reservation_t m_tx_reservation = {.handle = ACCESS_HANDLE_INVALID};
+
+/** Trace of the publish tick in progress. */
+static publish_trace_t m_publish_trace;
+
+/** Trace of the last publish tick that triggered publications. */
+static access_publish_trace_t m_last_publish_trace;
+
+/** Version of the element and model composition, see @ref access_composition_version_get. */
+static uint32_t m_composition_version;
+
+/** Last model configuration version handed out, see @ref access_model_config_version_get. */
+static uint32_t m_model_config_version;
+
 /* ********** Static asserts ********** */
 
 NRF_MESH_STATIC_ASSERT(ACCESS_MODEL_COUNT > 0);
@@ -242,6 +285,20 @@ static inline bool model_handle_valid_and_allocated(access_model_handle_t handle
     return (handle < ACCESS_MODEL_COUNT && ACCESS_INTERNAL_STATE_IS_ALLOCATED(m_model_pool[handle].internal_state));
 }
 
+static inline dsm_handle_t publish_address_handle_get(access_model_handle_t handle)
+{
+    return (m_model_pool[handle].publish_address_override != DSM_HANDLE_INVALID) ?
+            m_model_pool[handle].publish_address_override :
+            m_model_pool[handle].model_info.publish_address_handle;
+}
+
+static inline uint8_t publish_ttl_get(access_model_handle_t handle)
+{
+    return (m_model_pool[handle].model_info.publish_ttl == ACCESS_TTL_USE_DEFAULT) ?
+            m_default_ttl :
+            m_model_pool[handle].model_info.publish_ttl;
+}
+
 static void mesh_msg_handle(const nrf_mesh_evt_message_t * p_evt)
 {
     NRF_MESH_ASSERT(p_evt != NULL);
@@ -315,7 +372,7 @@ static bool check_tx_params(access_model_handle_t handle, const access_message_t
     }
     else if ((p_rx_message == NULL &&
              (m_model_pool[handle].model_info.publish_appkey_handle  == DSM_HANDLE_INVALID ||
-              m_model_pool[handle].model_info.publish_address_handle == DSM_HANDLE_INVALID)) ||
+              publish_address_handle_get(handle) == DSM_HANDLE_INVALID)) ||
               !is_valid_opcode(p_tx_message->opcode))
     {
         *p_status = NRF_ERROR_INVALID_PARAM;
@@ -328,11 +385,30 @@ static bool check_tx_params(access_model_handle_t handle, const access_message_t
     return (NRF_SUCCESS == *p_status);
 }
 
-static uint32_t packet_tx(access_model_handle_t handle,
-                          const access_message_tx_t * p_tx_message,
-                          const access_message_rx_t * p_rx_message,
-                          const uint8_t *p_access_payload,
-                          uint16_t access_payload_len)
+static void publish_trace_account(uint32_t status, uint16_t payload_length)
+{
+    if (!m_publish_trace.active)
+    {
+        return;
+    }
+
+    if (status == NRF_SUCCESS)
+    {
+        m_publish_trace.trace.publications++;
+        m_publish_trace.trace.payload_bytes += payload_length;
+    }
+    else
+    {
+        m_publish_trace.trace.failed++;
+    }
+}
+
+static uint32_t tx_params_build(access_model_handle_t handle,
+                                const access_message_tx_t * p_tx_message,
+                                const access_message_rx_t * p_rx_message,
+                                uint8_t ttl,
+                                uint16_t access_payload_len,
+                                nrf_mesh_tx_params_t * p_tx_params)
 {
     uint32_t status = NRF_SUCCESS;
 
@@ -357,7 +433,7 @@ static uint32_t packet_tx(access_model_handle_t handle,
     else
     {
         appkey_handle = m_model_pool[handle].model_info.publish_appkey_handle;
-        if (dsm_address_get(m_model_pool[handle].model_info.publish_address_handle, &dst_address) != NRF_SUCCESS)
+        if (dsm_address_get(publish_address_handle_get(handle), &dst_address) != NRF_SUCCESS)
         {
             return NRF_ERROR_NOT_FOUND;
         }
@@ -367,32 +443,22 @@ static uint32_t packet_tx(access_model_handle_t handle,
         }
     }
 
-    uint8_t ttl;
     if (p_rx_message != NULL && p_rx_message->meta_data.ttl == 0)
     {
         ttl = 0;
     }
-    else if (m_model_pool[handle].model_info.publish_ttl == ACCESS_TTL_USE_DEFAULT)
-    {
-        ttl = m_default_ttl;
-    }
-    else
+    else if (ttl == ACCESS_TTL_USE_PUBLISH)
     {
-        ttl = m_model_pool[handle].model_info.publish_ttl;
+        ttl = publish_ttl_get(handle);
     }
 
-
-    NRF_MESH_ASSERT_DEBUG(p_access_payload != NULL);
-    NRF_MESH_ASSERT_DEBUG(access_payload_len != 0);
-
-    nrf_mesh_tx_params_t tx_params;
-    memset(&tx_params, 0, sizeof(tx_params));
+    memset(p_tx_params, 0, sizeof(nrf_mesh_tx_params_t));
 
 #if MESH_FEATURE_LPN_ENABLED
     status = NRF_ERROR_NOT_FOUND;
     if (m_model_pool[handle].model_info.friendship_credential_flag)
     {
-        status = dsm_tx_friendship_secmat_get(subnet_handle, appkey_handle, &tx_params.security_material);
+        status = dsm_tx_friendship_secmat_get(subnet_handle, appkey_handle, &p_tx_params->security_material);
     }
 
     /* @tagMeshSp section 4.2.2.4:
@@ -402,22 +468,43 @@ static uint32_t packet_tx(access_model_handle_t handle,
     if (NRF_ERROR_NOT_FOUND == status)
 #endif
     {
-        status = dsm_tx_secmat_get(subnet_handle, appkey_handle, &tx_params.security_material);
+        status = dsm_tx_secmat_get(subnet_handle, appkey_handle, &p_tx_params->security_material);
+    }
+
+    if (status != NRF_SUCCESS)
+    {
+        return status;
     }
 
+    p_tx_params->dst = dst_address;
+    p_tx_params->src = src_address;
+    p_tx_params->ttl = ttl;
+    p_tx_params->force_segmented = p_tx_message->force_segmented;
+    p_tx_params->transmic_size = p_tx_message->transmic_size;
+    p_tx_params->data_len = access_payload_len;
+    p_tx_params->tx_token = p_tx_message->access_token;
+
+    return NRF_SUCCESS;
+}
+
+static uint32_t packet_tx(access_model_handle_t handle,
+                          const access_message_tx_t * p_tx_message,
+                          const access_message_rx_t * p_rx_message,
+                          uint8_t ttl,
+                          const uint8_t *p_access_payload,
+                          uint16_t access_payload_len)
+{
+    NRF_MESH_ASSERT_DEBUG(p_access_payload != NULL);
+    NRF_MESH_ASSERT_DEBUG(access_payload_len != 0);
+
+    nrf_mesh_tx_params_t tx_params;
+    uint32_t status = tx_params_build(handle, p_tx_message, p_rx_message, ttl, access_payload_len, &tx_params);
     if (status != NRF_SUCCESS)
     {
         return status;
     }
 
-    tx_params.dst = dst_address;
-    tx_params.src = src_address;
-    tx_params.ttl = ttl;
-    tx_params.force_segmented = p_tx_message->force_segmented;
-    tx_params.transmic_size = p_tx_message->transmic_size;
     tx_params.p_data = p_access_payload;
-    tx_params.data_len = access_payload_len;
-    tx_params.tx_token = p_tx_message->access_token;
 
     status = nrf_mesh_packet_send(&tx_params, NULL);
     if (status == NRF_SUCCESS)
@@ -432,6 +519,7 @@ static uint32_t packet_tx(access_model_handle_t handle,
 static uint32_t packet_alloc_and_tx(access_model_handle_t handle,
                                     const access_message_tx_t * p_tx_message,
                                     const access_message_rx_t * p_rx_message,
+                                    uint8_t ttl,
                                     uint8_t **pp_access_payload,
                                     uint16_t *p_access_payload_len)
 {
@@ -456,7 +544,7 @@ static uint32_t packet_alloc_and_tx(access_model_handle_t handle,
     opcode_set(p_tx_message->opcode, p_payload);
     memcpy(&p_payload[opcode_length], p_tx_message->p_buffer, p_tx_message->length);
 
-    status = packet_tx(handle, p_tx_message, p_rx_message, p_payload, payload_length);
+    status = packet_tx(handle, p_tx_message, p_rx_message, ttl, p_payload, payload_length);
     if (NRF_SUCCESS != status || NULL == pp_access_payload || NULL == p_access_payload_len)
     {
         mesh_mem_free(p_payload);
@@ -469,6 +557,118 @@ static uint32_t packet_alloc_and_tx(access_model_handle_t handle,
     return NRF_SUCCESS;
 }
 
+static uint32_t packet_reserve(access_model_handle_t handle,
+                               const access_message_tx_t * p_tx_message,
+                               const access_message_rx_t * p_rx_message,
+                               uint8_t ** pp_params)
+{
+    uint32_t status;
+
+    if (!check_tx_params(handle, p_tx_message, p_rx_message, &status))
+    {
+        return status;
+    }
+    else if (m_tx_reservation.handle != ACCESS_HANDLE_INVALID)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    uint16_t opcode_length = access_utils_opcode_size_get(p_tx_message->opcode);
+    uint16_t payload_length = opcode_length + p_tx_message->length;
+
+    status = tx_params_build(handle, p_tx_message, p_rx_message, ACCESS_TTL_USE_PUBLISH, payload_length,
+                             &m_tx_reservation.tx_params);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    status = nrf_mesh_packet_reserve(&m_tx_reservation.tx_params, &m_tx_reservation.p_payload);
+    m_tx_reservation.is_in_place = (status == NRF_SUCCESS);
+    if (status == NRF_ERROR_INVALID_LENGTH)
+    {
+        /* Segmented messages are staged in a heap buffer and sent through the regular path. */
+        m_tx_reservation.p_payload = (uint8_t *) mesh_mem_alloc(payload_length);
+        status = (m_tx_reservation.p_payload == NULL) ? NRF_ERROR_NO_MEM : NRF_SUCCESS;
+    }
+
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    opcode_set(p_tx_message->opcode, m_tx_reservation.p_payload);
+
+    m_tx_reservation.handle = handle;
+    m_tx_reservation.is_publication = (p_rx_message == NULL);
+    m_tx_reservation.tx_message = *p_tx_message;
+    m_tx_reservation.tx_message.p_buffer = &m_tx_reservation.p_payload[opcode_length];
+    m_tx_reservation.tx_params.p_data = m_tx_reservation.p_payload;
+
+    *pp_params = &m_tx_reservation.p_payload[opcode_length];
+    return NRF_SUCCESS;
+}
+
+static uint32_t reserved_packet_commit(void)
+{
+    access_model_handle_t handle = m_tx_reservation.handle;
+    const uint8_t * p_payload = m_tx_reservation.p_payload;
+    uint16_t payload_length = (uint16_t) m_tx_reservation.tx_params.data_len;
+    uint8_t * p_retransmit_payload = NULL;
+    uint32_t status = NRF_SUCCESS;
+
+    __LOG(LOG_SRC_ACCESS, LOG_LEVEL_DBG1, "TX: [aop: 0x%04x] \n", m_tx_reservation.tx_message.opcode.opcode);
+    __LOG_XB(LOG_SRC_ACCESS, LOG_LEVEL_DBG1, "TX: Msg", p_payload, payload_length);
+
+    if (m_tx_reservation.is_publication &&
+        m_model_pool[handle].model_info.publication_retransmit.count > 0)
+    {
+        if (m_tx_reservation.is_in_place)
+        {
+            /* The in-place payload is encrypted on commit, keep the plaintext for retransmissions. */
+            p_retransmit_payload = (uint8_t *) mesh_mem_alloc(payload_length);
+            if (p_retransmit_payload == NULL)
+            {
+                nrf_mesh_packet_discard();
+                return NRF_ERROR_NO_MEM;
+            }
+            memcpy(p_retransmit_payload, p_payload, payload_length);
+        }
+        else
+        {
+            p_retransmit_payload = m_tx_reservation.p_payload;
+        }
+    }
+
+    if (m_tx_reservation.is_in_place)
+    {
+        nrf_mesh_packet_commit();
+    }
+    else
+    {
+        status = nrf_mesh_packet_send(&m_tx_reservation.tx_params, NULL);
+        if (status != NRF_SUCCESS || p_retransmit_payload == NULL)
+        {
+            mesh_mem_free(m_tx_reservation.p_payload);
+            return status;
+        }
+    }
+
+    if (p_retransmit_payload != NULL)
+    {
+        /* The retransmission module only needs the message header, the payload is passed separately. */
+        m_tx_reservation.tx_message.p_buffer = &p_retransmit_payload[payload_length - m_tx_reservation.tx_message.length];
+        access_publish_retransmission_message_add(handle,
+                                                  &m_model_pool[handle].model_info.publication_retransmit,
+                                                  &m_tx_reservation.tx_message,
+                                                  ACCESS_TTL_USE_PUBLISH,
+                                                  p_retransmit_payload,
+                                                  payload_length);
+    }
+
+    return NRF_SUCCESS;
+}
+
 static void access_state_clear(void)
 {
     memset(&m_model_pool[0], 0, sizeof(m_model_pool));
@@ -481,8 +681,31 @@ static void access_state_clear(void)
         m_model_pool[i].model_info.subscription_pool_index = ACCESS_SUBSCRIPTION_LIST_COUNT;
         m_model_pool[i].model_info.element_index = ACCESS_ELEMENT_INDEX_INVALID;
         m_model_pool[i].publish_divisor = 1;
+        m_model_pool[i].config_version = ++m_model_config_version;
+        m_model_pool[i].publish_address_override = DSM_HANDLE_INVALID;
     }
     m_default_ttl = ACCESS_DEFAULT_TTL;
+    m_tx_reservation.handle = ACCESS_HANDLE_INVALID;
+    memset(&m_publish_trace, 0, sizeof(m_publish_trace));
+    memset(&m_last_publish_trace, 0, sizeof(m_last_publish_trace));
+    m_composition_version++;
+}
+
+static void model_config_changed(access_model_handle_t handle)
+{
+    m_model_pool[handle].config_version = ++m_model_config_version;
+}
+
+static void sublist_config_changed(uint16_t index)
+{
+    /* A subscription list can be shared by several models. */
+    for (access_model_handle_t i = 0; i < ACCESS_MODEL_COUNT; ++i)
+    {
+        if (m_model_pool[i].model_info.subscription_pool_index == index)
+        {
+            model_config_changed(i);
+        }
+    }
 }
 
 static bool model_subscribes_to_addr(const access_common_t * p_model, dsm_handle_t address_handle)
@@ -661,6 +884,7 @@ static uint32_t subscriptions_setter(mesh_config_entry_id_t id, const void * p_e
 
         ACCESS_INTERNAL_STATE_INVALIDATED_CLR(m_subscription_list_pool[idx].internal_state);
         ACCESS_INTERNAL_STATE_REFRESHED_CLR(m_subscription_list_pool[idx].internal_state);
+        sublist_config_changed(idx);
     }
 
     return NRF_SUCCESS;
@@ -740,6 +964,7 @@ static uint32_t models_setter(mesh_config_entry_id_t id, const void * p_entry)
 
         ACCESS_INTERNAL_STATE_INVALIDATED_CLR(m_model_pool[idx].internal_state);
         ACCESS_INTERNAL_STATE_REFRESHED_CLR(m_model_pool[idx].internal_state);
+        model_config_changed(idx);
     }
 
     return NRF_SUCCESS;
@@ -823,6 +1048,8 @@ MESH_CONFIG_FILE(m_access_file, MESH_OPT_ACCESS_FILE_ID, MESH_CONFIG_STRATEGY_CO
 
 static void model_store(access_model_handle_t handle)
 {
+    model_config_changed(handle);
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_REFRESHED_SET(m_model_pool[handle].internal_state);
@@ -837,6 +1064,8 @@ static void model_store(access_model_handle_t handle)
 
 static void element_store(uint16_t index)
 {
+    m_composition_version++;
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_REFRESHED_SET(m_element_pool[index].internal_state);
@@ -851,6 +1080,8 @@ static void element_store(uint16_t index)
 
 static void sublist_store(uint16_t index)
 {
+    sublist_config_changed(index);
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_REFRESHED_SET(m_subscription_list_pool[index].internal_state);
@@ -872,6 +1103,8 @@ static void sublist_store(uint16_t index)
 
 static void sublist_invalidate(uint16_t index)
 {
+    sublist_config_changed(index);
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_INVALIDATED_SET(m_subscription_list_pool[index].internal_state);
@@ -1039,6 +1272,35 @@ uint32_t access_load_config_apply(void)
     return NRF_SUCCESS;
 }
 
+#if MESH_METRICS_ENABLE
+static void rx_to_access_latency_add(const nrf_mesh_rx_metadata_t * p_core_metadata, timestamp_t now)
+{
+    if (p_core_metadata == NULL)
+    {
+        return;
+    }
+
+    switch (p_core_metadata->source)
+    {
+        case NRF_MESH_RX_SOURCE_SCANNER:
+            mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_RX_TO_ACCESS,
+                                     TIMER_DIFF(now, p_core_metadata->params.scanner.timestamp));
+            break;
+        case NRF_MESH_RX_SOURCE_INSTABURST:
+            mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_RX_TO_ACCESS,
+                                     TIMER_DIFF(now, p_core_metadata->params.instaburst.timestamp));
+            break;
+        case NRF_MESH_RX_SOURCE_GATT:
+            mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_RX_TO_ACCESS,
+                                     TIMER_DIFF(now, p_core_metadata->params.gatt.timestamp));
+            break;
+        default:
+            /* Loopback packets are not timestamped. */
+            break;
+    }
+}
+#endif
+
 /* ********** Private API ********** */
 void access_incoming_handle(const access_message_rx_t * p_message)
 {
@@ -1046,6 +1308,14 @@ void access_incoming_handle(const access_message_rx_t * p_message)
 
     if (nrf_mesh_is_address_rx(p_dst))
     {
+        __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_ACCESS_DISPATCH);
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_ACCESS_RX);
+        __MESH_METRICS_TIME_START(dispatch_start);
+#if MESH_METRICS_ENABLE
+        rx_to_access_latency_add(p_message->meta_data.p_core_metadata, dispatch_start);
+        bool is_handled = false;
+#endif
+
         uint16_t element_index;
         dsm_handle_t address_handle = DSM_HANDLE_INVALID;
         bool is_element_message = is_element_rx_address(p_dst, &element_index);
@@ -1080,13 +1350,27 @@ void access_incoming_handle(const access_message_rx_t * p_message)
                     access_reliable_message_rx_cb(i, p_message, p_model->p_args);
                 }
                 p_model->p_opcode_handlers[opcode_index].handler(i, p_message, p_model->p_args);
+                __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_ACCESS_DELIVERED);
+#if MESH_METRICS_ENABLE
+                is_handled = true;
+#endif
             }
         }
+
+#if MESH_METRICS_ENABLE
+        if (!is_handled)
+        {
+            mesh_metrics_count(MESH_METRICS_COUNTER_ACCESS_UNHANDLED);
+        }
+#endif
+        __MESH_METRICS_TIME_END(MESH_METRICS_HISTOGRAM_ACCESS_DISPATCH, dispatch_start);
+        __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_ACCESS_DISPATCH, 0);
     }
 }
 
 uint32_t access_packet_tx(access_model_handle_t handle,
                           const access_message_tx_t * p_tx_message,
+                          uint8_t ttl,
                           const uint8_t *p_access_payload,
                           uint16_t access_payload_len)
 {
@@ -1100,10 +1384,33 @@ uint32_t access_packet_tx(access_model_handle_t handle,
         return status;
     }
 
-    return packet_tx(handle, p_tx_message, NULL, p_access_payload,
+    return packet_tx(handle, p_tx_message, NULL, ttl, p_access_payload,
                      access_payload_len);
 }
 
+void access_publish_trace_begin(void)
+{
+    memset(&m_publish_trace, 0, sizeof(m_publish_trace));
+    m_publish_trace.active = true;
+}
+
+void access_publish_trace_end(void)
+{
+    if (!m_publish_trace.active)
+    {
+        return;
+    }
+
+    if (m_publish_trace.trace.publications > 0 || m_publish_trace.trace.failed > 0)
+    {
+        m_last_publish_trace = m_publish_trace.trace;
+        __LOG(LOG_SRC_ACCESS, LOG_LEVEL_DBG1, "Publish tick: %u sent, %u failed, %u bytes\n",
+              m_last_publish_trace.publications, m_last_publish_trace.failed, m_last_publish_trace.payload_bytes);
+    }
+
+    memset(&m_publish_trace, 0, sizeof(m_publish_trace));
+}
+
 /* ********** Public API ********** */
 void access_clear(void)
 {
@@ -1172,6 +1479,7 @@ uint32_t access_model_add(const access_model_add_params_t * p_model_params,
         m_model_pool[*p_model_handle].model_info.model_id.company_id = p_model_params->model_id.company_id;
         m_model_pool[*p_model_handle].model_info.publish_ttl = ACCESS_TTL_USE_DEFAULT;
         increment_model_count(p_model_params->element_index, p_model_params->model_id.company_id);
+        m_composition_version++;
         ACCESS_INTERNAL_STATE_ALLOCATED_SET(m_model_pool[*p_model_handle].internal_state);
         model_store(*p_model_handle);
     }
@@ -1186,19 +1494,14 @@ uint32_t access_model_add(const access_model_add_params_t * p_model_params,
     return NRF_SUCCESS;
 }
 
-uint32_t access_model_publish(access_model_handle_t handle, const access_message_tx_t * p_message)
+static uint32_t publish(access_model_handle_t handle, const access_message_tx_t * p_message, uint8_t ttl)
 {
     uint32_t status;
-
-    if (p_message == NULL)
-    {
-        return NRF_ERROR_NULL;
-    }
-
     uint16_t payload_length = 0;
     uint8_t *p_payload;
 
-    status = packet_alloc_and_tx(handle, p_message, NULL, &p_payload, &payload_length);
+    status = packet_alloc_and_tx(handle, p_message, NULL, ttl, &p_payload, &payload_length);
+    publish_trace_account(status, payload_length);
     if (NRF_SUCCESS != status)
     {
         return status;
@@ -1209,6 +1512,7 @@ uint32_t access_model_publish(access_model_handle_t handle, const access_message
         access_publish_retransmission_message_add(handle,
                                                   &m_model_pool[handle].model_info.publication_retransmit,
                                                   p_message,
+                                                  ttl,
                                                   p_payload,
                                                   payload_length);
     }
@@ -1219,6 +1523,32 @@ uint32_t access_model_publish(access_model_handle_t handle, const access_message
     return NRF_SUCCESS;
 }
 
+uint32_t access_model_publish(access_model_handle_t handle, const access_message_tx_t * p_message)
+{
+    if (p_message == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    return publish(handle, p_message, ACCESS_TTL_USE_PUBLISH);
+}
+
+uint32_t access_model_publish_with_ttl(access_model_handle_t handle,
+                                       const access_message_tx_t * p_message,
+                                       uint8_t ttl)
+{
+    if (p_message == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    else if (NRF_MESH_TTL_MAX < ttl)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    return publish(handle, p_message, ttl);
+}
+
 uint32_t access_model_reply(access_model_handle_t handle,
                             const access_message_rx_t * p_message,
                             const access_message_tx_t * p_reply)
@@ -1228,7 +1558,73 @@ uint32_t access_model_reply(access_model_handle_t handle,
         return NRF_ERROR_NULL;
     }
 
-    return packet_alloc_and_tx(handle, p_reply, p_message, NULL, NULL);
+    return packet_alloc_and_tx(handle, p_reply, p_message, ACCESS_TTL_USE_PUBLISH, NULL, NULL);
+}
+
+uint32_t access_model_publish_reserve(access_model_handle_t handle,
+                                      const access_message_tx_t * p_message,
+                                      uint8_t ** pp_params)
+{
+    if (p_message == NULL || pp_params == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    uint32_t status = packet_reserve(handle, p_message, NULL, pp_params);
+    if (status != NRF_SUCCESS)
+    {
+        publish_trace_account(status, 0);
+    }
+    return status;
+}
+
+uint32_t access_model_reply_reserve(access_model_handle_t handle,
+                                    const access_message_rx_t * p_message,
+                                    const access_message_tx_t * p_reply,
+                                    uint8_t ** pp_params)
+{
+    if (p_message == NULL || p_reply == NULL || pp_params == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    return packet_reserve(handle, p_reply, p_message, pp_params);
+}
+
+uint32_t access_model_tx_commit(access_model_handle_t handle)
+{
+    if (handle == ACCESS_HANDLE_INVALID || handle != m_tx_reservation.handle)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    uint32_t status = reserved_packet_commit();
+    if (m_tx_reservation.is_publication)
+    {
+        publish_trace_account(status, (uint16_t) m_tx_reservation.tx_params.data_len);
+    }
+    m_tx_reservation.handle = ACCESS_HANDLE_INVALID;
+    return status;
+}
+
+uint32_t access_model_tx_discard(access_model_handle_t handle)
+{
+    if (handle == ACCESS_HANDLE_INVALID || handle != m_tx_reservation.handle)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (m_tx_reservation.is_in_place)
+    {
+        nrf_mesh_packet_discard();
+    }
+    else
+    {
+        mesh_mem_free(m_tx_reservation.p_payload);
+    }
+
+    m_tx_reservation.handle = ACCESS_HANDLE_INVALID;
+    return NRF_SUCCESS;
 }
 
 uint32_t access_model_element_index_get(access_model_handle_t handle, uint16_t * p_element_index)
@@ -1271,6 +1667,23 @@ uint32_t access_model_publish_address_set(access_model_handle_t handle, dsm_hand
     }
 }
 
+uint32_t access_model_publish_address_override_set(access_model_handle_t handle, dsm_handle_t address_handle)
+{
+    if (!model_handle_valid_and_allocated(handle))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+    else if (DSM_ADDR_MAX <= address_handle && DSM_HANDLE_INVALID != address_handle)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        m_model_pool[handle].publish_address_override = address_handle;
+        return NRF_SUCCESS;
+    }
+}
+
 uint32_t access_model_publish_address_get(access_model_handle_t handle, dsm_handle_t * p_address_handle)
 {
     if (NULL == p_address_handle)
@@ -1512,6 +1925,16 @@ uint32_t access_model_subscription_lists_share(access_model_handle_t owner, acce
     return NRF_ERROR_INVALID_STATE;
 }
 
+uint32_t access_model_config_version_get(access_model_handle_t handle)
+{
+    if (!model_handle_valid_and_allocated(handle))
+    {
+        return 0;
+    }
+
+    return m_model_pool[handle].config_version;
+}
+
 uint32_t access_model_subscription_add(access_model_handle_t handle, dsm_handle_t address_handle)
 {
     if (!model_handle_valid_and_allocated(handle))
@@ -1735,6 +2158,12 @@ uint8_t access_default_ttl_get(void)
     return m_default_ttl;
 }
 
+void access_publish_trace_get(access_publish_trace_t * p_trace)
+{
+    NRF_MESH_ASSERT(p_trace != NULL);
+    *p_trace = m_last_publish_trace;
+}
+
 uint32_t access_model_publish_friendship_credential_flag_set(access_model_handle_t handle, bool flag)
 {
     if (!model_handle_valid_and_allocated(handle))
@@ -1959,6 +2388,11 @@ uint32_t access_element_models_get(uint16_t element_index, access_model_handle_t
     }
 }
 
+uint32_t access_composition_version_get(void)
+{
+    return m_composition_version;
+}
+
 uint32_t access_model_p_args_get(access_model_handle_t handle, void ** pp_args)
 {
     if (NULL == pp_args)
@@ -42,6 +42,7 @@
 
 #include "access.h"
 #include "access_config.h"
+#include "access_internal.h"
 
 #include "bearer_event.h"
 #include "nrf_mesh_assert.h"
@@ -248,6 +249,9 @@ static void schedule_publication_timer(void)
 
 static void trigger_publication_timers(void)
 {
+    /* Publications triggered in the same tick are traced together. */
+    access_publish_trace_begin();
+
     while (mp_publication_list != NULL && (mp_publication_list->target == m_publish_timer_counter || TIMER_OLDER_THAN(mp_publication_list->target, m_publish_timer_counter)))
     {
         access_model_handle_t handle = mp_publication_list->model_handle;
@@ -264,6 +268,7 @@ static void trigger_publication_timers(void)
         add_to_publication_list(p_pubstate);
     }
 
+    access_publish_trace_end();
     schedule_publication_timer();
 }
 
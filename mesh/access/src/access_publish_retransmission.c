@@ -64,6 +64,7 @@
 typedef struct
 {
     access_message_tx_t tx_message;
+    uint8_t ttl;
     const uint8_t *p_access_payload;
     uint16_t access_payload_length;
     timestamp_t next_timeout_us;
@@ -99,7 +100,7 @@ static void retransmissions_timer_cb(timestamp_t timestamp, void * p_context)
         }
         else if (TIMER_OLDER_THAN(m_retr.pool[i].next_timeout_us, future))
         {
-            uint32_t status = access_packet_tx(i, &m_retr.pool[i].tx_message,
+            uint32_t status = access_packet_tx(i, &m_retr.pool[i].tx_message, m_retr.pool[i].ttl,
                                                m_retr.pool[i].p_access_payload,
                                                m_retr.pool[i].access_payload_length);
             switch (status)
@@ -170,12 +171,14 @@ static uint16_t get_next_timeout_index(void)
 static void message_add(access_model_handle_t model_handle,
                         const access_publish_retransmit_t *p_publication_retransmit,
                         const access_message_tx_t *p_tx_message,
+                        uint8_t ttl,
                         const uint8_t *p_access_payload,
                         uint16_t access_payload_len)
 {
     timestamp_t time_now = timer_now();
 
     m_retr.pool[model_handle].tx_message = *p_tx_message;
+    m_retr.pool[model_handle].ttl = ttl;
     m_retr.pool[model_handle].p_access_payload = p_access_payload;
     m_retr.pool[model_handle].access_payload_length = access_payload_len;
     m_retr.pool[model_handle].retransmits_left = p_publication_retransmit->count;
@@ -228,6 +231,7 @@ void access_publish_retransmission_init(void)
 void access_publish_retransmission_message_add(access_model_handle_t model_handle,
                                                const access_publish_retransmit_t *p_publish_retransmit,
                                                const access_message_tx_t *p_tx_message,
+                                               uint8_t ttl,
                                                const uint8_t *p_access_payload,
                                                uint16_t access_payload_len)
 {
@@ -243,7 +247,7 @@ void access_publish_retransmission_message_add(access_model_handle_t model_handl
         message_remove(model_handle);
     }
 
-    message_add(model_handle, p_publish_retransmit, p_tx_message,
+    message_add(model_handle, p_publish_retransmit, p_tx_message, ttl,
                 p_access_payload, access_payload_len);
 
     reschedule_next(model_handle);
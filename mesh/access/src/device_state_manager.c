@@ -228,6 +228,9 @@ static uint32_t m_subnet_allocated[BITFIELD_BLOCK_COUNT(DSM_SUBNET_MAX)];
 static uint32_t m_appkey_allocated[BITFIELD_BLOCK_COUNT(DSM_APP_MAX)];
 static uint32_t m_devkey_allocated[BITFIELD_BLOCK_COUNT(DSM_DEVICE_MAX)];
 
+/** Application key version, see @ref dsm_appkey_version_get. */
+static uint32_t m_appkey_version;
+
 /** Set of the global flags to keep track of the dsm changes.*/
 static local_dsm_status_t m_status;
 
@@ -966,6 +969,7 @@ static void appkey_set(mesh_key_index_t app_key_index, dsm_handle_t subnet_handl
     m_appkeys[handle].app_key_index = app_key_index;
     m_appkeys[handle].subnet_handle = subnet_handle;
     bitfield_set(m_appkey_allocated, handle);
+    m_appkey_version++;
 }
 
 static void devkey_set(uint16_t key_owner, dsm_handle_t subnet_handle, const uint8_t * p_key, dsm_handle_t handle)
@@ -1819,6 +1823,7 @@ void dsm_clear(void)
     bitfield_clear_all(m_subnet_allocated, BITFIELD_BLOCK_COUNT(DSM_SUBNET_MAX));
     bitfield_clear_all(m_appkey_allocated, BITFIELD_BLOCK_COUNT(DSM_APP_MAX));
     bitfield_clear_all(m_devkey_allocated, BITFIELD_BLOCK_COUNT(DSM_DEVICE_MAX));
+    m_appkey_version++;
 
 #if (MESH_FEATURE_LPN_ENABLED || MESH_FEATURE_FRIEND_ENABLED)
     for (uint32_t i = 0; i < ARRAY_SIZE(m_friendships); i++)
@@ -2720,10 +2725,16 @@ uint32_t dsm_appkey_delete(dsm_handle_t app_handle)
     else
     {
         dsm_entry_invalidate(MESH_OPT_DSM_APPKEYS_RECORD, app_handle, m_appkey_allocated);
+        m_appkey_version++;
         return NRF_SUCCESS;
     }
 }
 
+uint32_t dsm_appkey_version_get(void)
+{
+    return m_appkey_version;
+}
+
 uint32_t dsm_appkey_get_all(dsm_handle_t subnet_handle, mesh_key_index_t * p_key_list, uint32_t * p_count)
 {
     if (NULL == p_key_list || NULL == p_count )
@@ -44,6 +44,7 @@
 #include "nrf.h"
 #include "scanner.h"
 #include "debug_pins.h"
+#include "internal_event.h"
 /*****************************************************************************
 * Local defines
 *****************************************************************************/
@@ -168,6 +169,7 @@ static void end_handle(void)
 #endif
 
     DEBUG_PIN_BEARER_HANDLER_OFF(DEBUG_PIN_BEARER_HANDLER_ACTION);
+    __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_BEARER_ACTION, 0);
     mp_action = NULL;
     if (m_stopped)
     {
@@ -194,6 +196,7 @@ static void action_start(bearer_action_t* p_action)
     mp_action->debug.event_count++;
 #endif
     DEBUG_PIN_BEARER_HANDLER_ON(DEBUG_PIN_BEARER_HANDLER_ACTION);
+    __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_BEARER_ACTION);
 
     m_in_callback = true;
     mp_action->start_cb(time_now, mp_action->p_args);
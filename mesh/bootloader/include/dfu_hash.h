@@ -0,0 +1,90 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef DFU_HASH_H__
+#define DFU_HASH_H__
+
+#include <stdint.h>
+#include "sha256.h"
+
+/**
+ * Streaming SHA-256 over a DFU bank.
+ *
+ * The bank is hashed front to back as the received part of it grows, so only the part that
+ * arrived last has to be hashed when the transfer is verified. The caller tells the module how
+ * much of the bank is contiguous from the start, and out-of-order data after a gap is picked up
+ * once the gap is filled.
+ */
+
+/** Streaming hash context. */
+typedef struct
+{
+    sha256_context_t    context;
+    const uint8_t*      p_data;     /**< Start of the data to hash. */
+    uint32_t            length;     /**< Total length of the data to hash. */
+    uint32_t            offset;     /**< Number of bytes hashed so far. */
+} dfu_hash_t;
+
+/**
+ * Start hashing a block of data.
+ *
+ * @param[out] p_hash Streaming hash context.
+ * @param[in] p_context SHA-256 context to continue from, with any header already hashed.
+ * @param[in] p_data Start of the data to hash.
+ * @param[in] length Length of the data to hash.
+ */
+void dfu_hash_start(dfu_hash_t* p_hash, const sha256_context_t* p_context, const uint8_t* p_data, uint32_t length);
+
+/**
+ * Hash more of the data.
+ *
+ * @param[in,out] p_hash Streaming hash context.
+ * @param[in] available Number of bytes from the start of the data that are in place.
+ * @param[in] step_max Largest number of bytes to hash in this call, to bound the time spent.
+ *
+ * @returns The number of bytes hashed.
+ */
+uint32_t dfu_hash_update(dfu_hash_t* p_hash, uint32_t available, uint32_t step_max);
+
+/**
+ * Hash the rest of the data, and get the resulting SHA-256 context.
+ *
+ * @param[in,out] p_hash Streaming hash context.
+ * @param[out] p_context SHA-256 context after all the data, ready to be finalized.
+ */
+void dfu_hash_finish(dfu_hash_t* p_hash, sha256_context_t* p_context);
+
+#endif /* DFU_HASH_H__ */
@@ -0,0 +1,139 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef DFU_MISSING_H__
+#define DFU_MISSING_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Full-image tracking of missing DFU segments.
+ *
+ * Missing segments are stored as a sorted list of runs of consecutive segments, so the memory
+ * usage depends on the number of gaps in the transfer, not on the size of the image. Segments
+ * after the highest received segment are implicitly missing, and don't occupy a run.
+ */
+
+/** Largest number of separate gaps that can be tracked at the same time. */
+#ifndef DFU_MISSING_RUNS_MAX
+#define DFU_MISSING_RUNS_MAX    (32)
+#endif
+
+/** A run of consecutive missing segments. */
+typedef struct
+{
+    uint16_t segment;   /**< First missing segment in the run. */
+    uint16_t count;     /**< Number of missing segments in the run. */
+} dfu_missing_run_t;
+
+/** Missing segment tracking context. */
+typedef struct
+{
+    dfu_missing_run_t   runs[DFU_MISSING_RUNS_MAX];
+    uint16_t            run_count;
+    uint16_t            segment_count;  /**< Number of segments in the transfer. */
+    uint16_t            segment_max;    /**< Highest received segment, or 0 if none. */
+} dfu_missing_t;
+
+/**
+ * Initialize the tracking context for a new transfer. Segment indexes start at 1.
+ *
+ * @param[out] p_missing Tracking context.
+ * @param[in] segment_count Number of segments in the transfer.
+ */
+void dfu_missing_init(dfu_missing_t* p_missing, uint16_t segment_count);
+
+/**
+ * Mark a segment as received.
+ *
+ * @param[in,out] p_missing Tracking context.
+ * @param[in] segment Received segment.
+ *
+ * @retval NRF_SUCCESS The segment was missing, and is now marked as received.
+ * @retval NRF_ERROR_INVALID_PARAM The segment is outside the transfer.
+ * @retval NRF_ERROR_INVALID_STATE The segment has already been received.
+ * @retval NRF_ERROR_NO_MEM Receiving the segment would create a new gap, and all runs are in use.
+ * The segment stays missing, and must be requested again.
+ */
+uint32_t dfu_missing_segment_rx(dfu_missing_t* p_missing, uint16_t segment);
+
+/**
+ * Check whether a segment is missing.
+ *
+ * @param[in] p_missing Tracking context.
+ * @param[in] segment Segment to check.
+ *
+ * @returns Whether the segment is part of the transfer and has not been received.
+ */
+bool dfu_missing_is_missing(const dfu_missing_t* p_missing, uint16_t segment);
+
+/**
+ * Get the missing segments, oldest first.
+ *
+ * @param[in] p_missing Tracking context.
+ * @param[in] segment_limit Highest segment to report.
+ * @param[in] count_max Largest segment count to report in a single range.
+ * @param[out] p_ranges Array to store the missing ranges in.
+ * @param[in] range_count Number of entries in @p p_ranges.
+ *
+ * @returns The number of ranges stored in @p p_ranges.
+ */
+uint32_t dfu_missing_ranges_get(const dfu_missing_t* p_missing,
+                                uint16_t segment_limit,
+                                uint16_t count_max,
+                                dfu_missing_run_t* p_ranges,
+                                uint32_t range_count);
+
+/**
+ * Get the number of segments received without gaps from the start of the transfer.
+ *
+ * @param[in] p_missing Tracking context.
+ *
+ * @returns The highest segment that has been received along with all the segments before it.
+ */
+uint16_t dfu_missing_prefix_get(const dfu_missing_t* p_missing);
+
+/**
+ * Get the number of missing segments, including the segments not seen yet.
+ *
+ * @param[in] p_missing Tracking context.
+ *
+ * @returns The number of segments left in the transfer.
+ */
+uint32_t dfu_missing_count_get(const dfu_missing_t* p_missing);
+
+#endif /* DFU_MISSING_H__ */
@@ -51,6 +51,11 @@
 #define DFU_PACKET_LEN_DATA         (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_t))
 #define DFU_PACKET_LEN_DATA_REQ     (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_req_t))
 #define DFU_PACKET_LEN_DATA_RSP     (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_rsp_t))
+#define DFU_PACKET_LEN_DATA_REQ_RANGE(range_count) (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_req_range_t) - \
+                                                    (DFU_PACKET_REQ_RANGES_MAX - (range_count)) * sizeof(dfu_packet_segment_range_t))
+
+/** Largest number of segment ranges in a single data request, limited by the size of a data packet. */
+#define DFU_PACKET_REQ_RANGES_MAX   (5)
 
 #define DFU_PACKET_ADV_OVERHEAD     (1 /* adv_type */ + 2 /* UUID */) /* overhead inside adv data */
 #define DFU_PACKET_OVERHEAD         (MESH_PACKET_BLE_OVERHEAD + 1 + DFU_PACKET_ADV_OVERHEAD) /* dfu packet total overhead */
@@ -108,6 +113,24 @@ typedef struct __attribute((packed))
     uint32_t transaction_id;
 } dfu_packet_data_req_t;
 
+/** Range of segments in a DFU data request */
+typedef struct __attribute((packed))
+{
+    uint16_t segment;
+    uint8_t count;
+} dfu_packet_segment_range_t;
+
+/** DFU data request packet payload with segment ranges.
+ *
+ * Shares its packet type and first fields with @ref dfu_packet_data_req_t, so that nodes that don't
+ * know about the ranges treat it as a request for the first segment. */
+typedef struct __attribute((packed))
+{
+    uint16_t segment; /* first requested segment, same as ranges[0].segment */
+    uint32_t transaction_id;
+    dfu_packet_segment_range_t ranges[DFU_PACKET_REQ_RANGES_MAX];
+} dfu_packet_data_req_range_t;
+
 /** DFU data response packet payload */
 typedef struct __attribute((packed))
 {
@@ -127,6 +150,7 @@ typedef struct __attribute((packed))
         dfu_packet_start_t    start;
         dfu_packet_data_t     data;
         dfu_packet_data_req_t req_data;
+        dfu_packet_data_req_range_t req_range;
         dfu_packet_data_rsp_t rsp_data;
     } payload;
 } dfu_packet_t;
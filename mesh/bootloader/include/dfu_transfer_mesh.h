@@ -40,6 +40,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "sha256.h"
+#include "dfu_missing.h"
 
 void dfu_transfer_init(void);
 
@@ -53,11 +54,42 @@ uint32_t dfu_transfer_data(uint32_t p_addr, uint8_t* p_data, uint16_t length);
 
 bool dfu_transfer_has_entry(uint32_t* p_addr, uint8_t* p_out_buffer, uint16_t len);
 
-bool dfu_transfer_get_oldest_missing_entry(
-        uint32_t* p_start_addr,
-        uint32_t** pp_entry,
-        uint32_t* p_len);
+/**
+ * Get the missing segments of the ongoing transfer, oldest first.
+ *
+ * @param[in] segment_limit Highest segment to report.
+ * @param[out] p_ranges Array to store the missing ranges in.
+ * @param[in] range_count Number of entries in @p p_ranges.
+ * @param[in] count_max Largest segment count to report in a single range.
+ *
+ * @returns The number of ranges stored in @p p_ranges.
+ */
+uint32_t dfu_transfer_missing_ranges_get(uint16_t segment_limit,
+        dfu_missing_run_t* p_ranges,
+        uint32_t range_count,
+        uint16_t count_max);
+
+/**
+ * Start hashing the transfer data as it arrives.
+ *
+ * The data is hashed in order as soon as it's received without gaps and written to flash, so
+ * only the tail of the transfer is left to hash when it's verified.
+ *
+ * @param[in] p_hash_context SHA-256 context to continue from, with the transfer header already hashed.
+ *
+ * @retval NRF_SUCCESS The hashing was started.
+ * @retval NRF_ERROR_INVALID_STATE No transfer in progress.
+ */
+uint32_t dfu_transfer_sha256_start(const sha256_context_t* p_hash_context);
 
+/**
+ * Hash the rest of the transfer data, and get the resulting SHA-256 context.
+ *
+ * @param[out] p_hash_context SHA-256 context after all the transfer data, ready to be finalized.
+ *
+ * @retval NRF_SUCCESS The context was stored in @p p_hash_context.
+ * @retval NRF_ERROR_INVALID_STATE No transfer in progress, or the hashing was never started.
+ */
 uint32_t dfu_transfer_sha256(sha256_context_t* p_hash_context);
 
 void dfu_transfer_end(void);
@@ -0,0 +1,77 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include "dfu_hash.h"
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void dfu_hash_start(dfu_hash_t* p_hash, const sha256_context_t* p_context, const uint8_t* p_data, uint32_t length)
+{
+    memcpy(&p_hash->context, p_context, sizeof(sha256_context_t));
+    p_hash->p_data = p_data;
+    p_hash->length = length;
+    p_hash->offset = 0;
+}
+
+uint32_t dfu_hash_update(dfu_hash_t* p_hash, uint32_t available, uint32_t step_max)
+{
+    if (available > p_hash->length)
+    {
+        available = p_hash->length;
+    }
+    if (available <= p_hash->offset)
+    {
+        return 0;
+    }
+
+    uint32_t step = available - p_hash->offset;
+    if (step > step_max)
+    {
+        step = step_max;
+    }
+    (void) sha256_update(&p_hash->context, &p_hash->p_data[p_hash->offset], step);
+    p_hash->offset += step;
+    return step;
+}
+
+void dfu_hash_finish(dfu_hash_t* p_hash, sha256_context_t* p_context)
+{
+    (void) dfu_hash_update(p_hash, p_hash->length, p_hash->length);
+    memcpy(p_context, &p_hash->context, sizeof(sha256_context_t));
+}
@@ -80,6 +80,8 @@
 #define REQ_RX_COUNT_RETRY              (8)
 
 #define DATA_REQ_SEGMENT_NONE           (0)
+#define DATA_REQ_RANGE_COUNT_MAX        (UINT8_MAX)
+#define DATA_REQ_RSP_COUNT_MAX          (4) /**< Most segments to serve for a single range request. */
 
 #define LOST_START_EDGE                 (10)
 
@@ -102,16 +104,17 @@ typedef struct
     uint32_t*       p_start_addr;
     uint32_t*       p_bank_addr;
     uint32_t*       p_indicated_start_addr;
-    uint32_t*       p_last_requested_entry;
     uint32_t        length;
     uint32_t        signature_length;
     uint8_t         signature[DFU_SIGNATURE_LEN];
     uint8_t         signature_bitmap;
     uint16_t        segments_remaining;
     uint16_t        segment_count;
+    uint16_t        segment_rx_max;
     fwid_union_t    target_fwid_union;
     bool            segment_is_valid_after_transfer;
     bool            flood;
+    bool            relay_bank_checked;
 } transaction_t;
 
 typedef struct
@@ -302,29 +305,14 @@ static uint32_t packet_tx_dynamic(dfu_packet_t* p_packet,
     return status;
 }
 
-static bool signature_check(void)
+/* Hashes the transfer header the signature is computed over, ahead of the transfer data. */
+static void signature_header_hash(sha256_context_t* p_hash_context, uint32_t indicated_start_addr, uint32_t length)
 {
-    __LOG("Verifying signature... ");
-    /* if we don't have a public key we will accept all firmware upgrades. */
-    if (m_bl_info_pointers.p_ecdsa_public_key == NULL)
-    {
-        __LOG("No key (THAT'S OKAY THOUGH)\n");
-        return true;
-    }
-
-    /* if we have a key, but the transfer isn't signed, we will fail */
-    if (m_transaction.signature_length == 0)
-    {
-        __LOG("No signature (FAILURE)\n");
-        return false;
-    }
-
-    uint8_t hash[uECC_BYTES];
     sha256_context_t hash_context;
     (void) sha256_init(&hash_context);
     (void) sha256_update(&hash_context, (uint8_t*) &m_transaction.type, 1);
-    (void) sha256_update(&hash_context, (uint8_t*) &m_transaction.p_indicated_start_addr, 4);
-    (void) sha256_update(&hash_context, (uint8_t*) &m_transaction.length, 4);
+    (void) sha256_update(&hash_context, (uint8_t*) &indicated_start_addr, 4);
+    (void) sha256_update(&hash_context, (uint8_t*) &length, 4);
     uint8_t padding = 0;
     (void) sha256_update(&hash_context, &padding, 1);
 
@@ -343,13 +331,58 @@ static bool signature_check(void)
             break;
     }
 
-    (void) dfu_transfer_sha256(&hash_context);
+    *p_hash_context = hash_context;
+}
+
+static bool signature_verify(sha256_context_t* p_hash_context, const uint8_t* p_signature)
+{
+    uint8_t hash[uECC_BYTES];
 #if NORDIC_SDK_VERSION >= 11
-    (void) sha256_final(&hash_context, hash, false);
+    (void) sha256_final(p_hash_context, hash, false);
 #else
-    (void) sha256_final(&hash_context, hash);
+    (void) sha256_final(p_hash_context, hash);
 #endif
-    bool success = (bool) (uECC_verify(m_bl_info_pointers.p_ecdsa_public_key, hash, m_transaction.signature));
+    return (bool) (uECC_verify(m_bl_info_pointers.p_ecdsa_public_key, hash, p_signature));
+}
+
+/* The transfer data is hashed as it arrives, on top of the transfer header. */
+static void signature_hash_start(void)
+{
+    if (m_bl_info_pointers.p_ecdsa_public_key == NULL)
+    {
+        return;
+    }
+
+    sha256_context_t hash_context;
+    signature_header_hash(&hash_context, (uint32_t) m_transaction.p_indicated_start_addr, m_transaction.length);
+    (void) dfu_transfer_sha256_start(&hash_context);
+}
+
+static bool signature_check(void)
+{
+    __LOG("Verifying signature... ");
+    /* if we don't have a public key we will accept all firmware upgrades. */
+    if (m_bl_info_pointers.p_ecdsa_public_key == NULL)
+    {
+        __LOG("No key (THAT'S OKAY THOUGH)\n");
+        return true;
+    }
+
+    /* if we have a key, but the transfer isn't signed, we will fail */
+    if (m_transaction.signature_length == 0)
+    {
+        __LOG("No signature (FAILURE)\n");
+        return false;
+    }
+
+    /* Only the tail of the transfer is left to hash. */
+    sha256_context_t hash_context;
+    if (dfu_transfer_sha256(&hash_context) != NRF_SUCCESS)
+    {
+        __LOG("No hash (FAILURE)\n");
+        return false;
+    }
+    bool success = signature_verify(&hash_context, m_transaction.signature);
 
     if (success)
     {
@@ -510,6 +543,7 @@ static void start_req(dfu_type_t type, fwid_union_t* p_fwid)
     m_transaction.segment_is_valid_after_transfer = false;
     m_transaction.signature_length = 0;
     m_transaction.transaction_id = 0;
+    m_transaction.relay_bank_checked = false;
     m_transaction.type = type;
     fwid_union_cpy(&m_transaction.target_fwid_union, p_fwid, type);
     SET_STATE(DFU_STATE_DFU_REQ);
@@ -638,6 +672,8 @@ static void start_target(void)
                 m_transaction.length,
                 m_transaction.segment_is_valid_after_transfer) == NRF_SUCCESS)
     {
+        signature_hash_start();
+
         bl_evt_t abort_evt;
         abort_evt.type = BL_EVT_TYPE_TX_ABORT;
         abort_evt.params.tx.abort.tx_slot = TX_SLOT_BEACON;
@@ -681,44 +717,198 @@ static uint32_t notify_state_packet(dfu_packet_t* p_packet)
 }
 
 /* check whether we've lost any entries, and request them */
-static void request_missing_data(uint16_t prev_segment)
+static void request_missing_data(void)
 {
-    uint32_t* p_req_entry = NULL;
-    uint32_t req_entry_len = 0;
-
-    if (dfu_transfer_get_oldest_missing_entry(
-                m_transaction.p_last_requested_entry,
-                &p_req_entry,
-                &req_entry_len) &&
-            (
-             /* don't request the previous packet yet */
-             (ADDR_SEGMENT(p_req_entry, m_transaction.p_start_addr) < (uint32_t)(prev_segment - 1)) ||
-             (m_transaction.segment_count == prev_segment)
-            )
-       )
+    /* don't request the newest packet yet, unless we've got the last one */
+    uint16_t segment_limit = m_transaction.segment_rx_max;
+    if (m_transaction.segment_count != segment_limit)
     {
-        dfu_packet_t req_packet;
-        req_packet.packet_type = DFU_PACKET_TYPE_DATA_REQ;
-        req_packet.payload.req_data.segment = ADDR_SEGMENT(p_req_entry, m_transaction.p_start_addr);
-        req_packet.payload.req_data.transaction_id = m_transaction.transaction_id;
+        if (segment_limit < 3)
+        {
+            return;
+        }
+        segment_limit -= 2;
+    }
 
-        /* Use beacon slot */
-        bl_evt_t tx_evt;
-        tx_evt.type = BL_EVT_TYPE_TX_RADIO;
-        tx_evt.params.tx.radio.p_dfu_packet = &req_packet;
+    dfu_missing_run_t ranges[DFU_PACKET_REQ_RANGES_MAX];
+    uint32_t range_count = dfu_transfer_missing_ranges_get(segment_limit,
+                                                           ranges,
+                                                           DFU_PACKET_REQ_RANGES_MAX,
+                                                           DATA_REQ_RANGE_COUNT_MAX);
+    if (range_count == 0)
+    {
+        return;
+    }
+
+    /* The ranges extend a regular data request for the first missing segment, so that relays and
+     * sources that don't know about them still answer that one. */
+    dfu_packet_t req_packet;
+    req_packet.packet_type = DFU_PACKET_TYPE_DATA_REQ;
+    req_packet.payload.req_range.segment = ranges[0].segment;
+    req_packet.payload.req_range.transaction_id = m_transaction.transaction_id;
+    for (uint32_t i = 0; i < range_count; ++i)
+    {
+        req_packet.payload.req_range.ranges[i].segment = ranges[i].segment;
+        req_packet.payload.req_range.ranges[i].count = (uint8_t) ranges[i].count;
+    }
+
+    /* Use beacon slot */
+    bl_evt_t tx_evt;
+    tx_evt.type = BL_EVT_TYPE_TX_RADIO;
+    tx_evt.params.tx.radio.p_dfu_packet = &req_packet;
+    if (range_count == 1 && ranges[0].count == 1)
+    {
         tx_evt.params.tx.radio.length = DFU_PACKET_LEN_DATA_REQ;
-        tx_evt.params.tx.radio.interval_type = TX_INTERVAL_TYPE_REQ;
-        tx_evt.params.tx.radio.tx_count = TX_REPEATS_REQ;
-        tx_evt.params.tx.radio.tx_slot = TX_SLOT_BEACON;
-        uint32_t status = bootloader_evt_send(&tx_evt);
-        if (status == NRF_SUCCESS)
+    }
+    else
+    {
+        tx_evt.params.tx.radio.length = DFU_PACKET_LEN_DATA_REQ_RANGE(range_count);
+    }
+    tx_evt.params.tx.radio.interval_type = TX_INTERVAL_TYPE_REQ;
+    tx_evt.params.tx.radio.tx_count = TX_REPEATS_REQ;
+    tx_evt.params.tx.radio.tx_slot = TX_SLOT_BEACON;
+    uint32_t status = bootloader_evt_send(&tx_evt);
+    if (status == NRF_SUCCESS)
+    {
+        m_data_req_segment = req_packet.payload.req_range.segment;
+        __LOG("TX REQ FOR %u RANGES FROM 0x%x\n", range_count, m_data_req_segment);
+    }
+}
+
+/* Get the contents of a segment of the current transfer, if we have it. */
+static bool segment_data_get(uint16_t segment, uint8_t* p_out)
+{
+    if (m_state == DFU_STATE_RELAY)
+    {
+        /* Relays can only serve segments from a finished copy of the same firmware in their bank. */
+        if (m_transaction.p_bank_addr == NULL || segment == 0 ||
+            (uint32_t) (segment - 1) * SEGMENT_LENGTH >= m_transaction.length)
         {
-            m_transaction.p_last_requested_entry = (uint32_t*) p_req_entry;
-            m_data_req_segment = req_packet.payload.req_data.segment;
-            __LOG("TX REQ FOR 0x%x\n", m_data_req_segment);
+            return false;
+        }
+        memcpy(p_out, (uint32_t*) SEGMENT_ADDR(segment, m_transaction.p_bank_addr), SEGMENT_LENGTH);
+        return true;
+    }
+
+    return dfu_transfer_has_entry((uint32_t*) SEGMENT_ADDR(segment, m_transaction.p_start_addr),
+                                  p_out, SEGMENT_LENGTH);
+}
+
+/* Send a data response for a requested segment, unless we've served it recently. */
+static uint32_t segment_serve(uint16_t segment)
+{
+    uint32_t status;
+    req_cache_entry_t* p_req_entry = NULL;
+    /* check that we haven't served this request recently. */
+    for (uint32_t i = 0; i < REQ_CACHE_SIZE; ++i)
+    {
+        if (m_req_cache[i].segment == segment)
+        {
+            if (m_req_cache[i].rx_count++ < REQ_RX_COUNT_RETRY)
+            {
+                return NRF_ERROR_BUSY;
+            }
+            p_req_entry = &m_req_cache[i];
+            break;
         }
     }
+    /* serve request */
+    dfu_packet_t dfu_rsp;
+    if (segment_data_get(segment, dfu_rsp.payload.rsp_data.data))
+    {
+        dfu_rsp.packet_type = DFU_PACKET_TYPE_DATA_RSP;
+        dfu_rsp.payload.rsp_data.segment = segment;
+        dfu_rsp.payload.rsp_data.transaction_id = m_transaction.transaction_id;
+
+        status = packet_tx_dynamic(&dfu_rsp, DFU_PACKET_LEN_DATA_RSP, TX_INTERVAL_TYPE_RSP, TX_REPEATS_RSP);
+    }
+    else
+    {
+        status = NRF_ERROR_NOT_FOUND;
+    }
+
+    /* log our attempt at responding */
+    if ((status == NRF_SUCCESS) && (p_req_entry == NULL))
+    {
+        p_req_entry = &m_req_cache[(m_req_index++) & (REQ_CACHE_SIZE - 1)];
+        p_req_entry->segment = segment;
+    }
+
+    /* Check that p_req_enry is not NULL, if status is not NRF_SUCCESS. If status is
+       NRF_SUCCESS, p_req_entry will always be set. */
+    if (p_req_entry != NULL)
+    {
+        p_req_entry->rx_count = 0;
+    }
+    return status;
 }
+
+/* Find a finished copy of the relayed firmware in our own bank, to serve requests from. The bank
+ * is only used if its firmware ID and version match the transfer, and its contents hash to its
+ * signature over the header of this transfer. Unsigned banks are never served, as there's nothing
+ * to check their contents against. */
+static void relay_bank_find(const dfu_packet_t* p_packet)
+{
+    /* Whatever was set by dfu_mesh_req() is not part of this transfer. */
+    m_transaction.p_bank_addr = NULL;
+
+    /* The transfer header is only known from the start packet. */
+    if (p_packet->payload.start.segment != 0)
+    {
+        return;
+    }
+
+    /* The outcome holds for the rest of the transaction, retransmitted start packets don't
+     * need to hash the bank again. */
+    m_transaction.relay_bank_checked = true;
+
+    if (p_packet->payload.start.signature_length == 0 ||
+        m_bl_info_pointers.p_ecdsa_public_key == NULL)
+    {
+        return;
+    }
+
+    bl_info_type_t bank_type;
+    switch (m_transaction.type)
+    {
+        case DFU_TYPE_APP:
+            bank_type = BL_INFO_TYPE_BANK_APP;
+            break;
+        case DFU_TYPE_SD:
+            bank_type = BL_INFO_TYPE_BANK_SD;
+            break;
+        case DFU_TYPE_BOOTLOADER:
+            bank_type = BL_INFO_TYPE_BANK_BL;
+            break;
+        default:
+            return;
+    }
+
+    uint32_t length = p_packet->payload.start.length * 4;
+    bl_info_entry_t* p_bank_entry = bootloader_info_entry_get(bank_type);
+    if (p_bank_entry == NULL ||
+        p_bank_entry->bank.state != BL_INFO_BANK_STATE_IDLE ||
+        !p_bank_entry->bank.has_signature ||
+        p_bank_entry->bank.length != length ||
+        !fwid_union_cmp(&p_bank_entry->bank.fwid, &m_transaction.target_fwid_union, m_transaction.type))
+    {
+        return;
+    }
+
+    sha256_context_t hash_context;
+    signature_header_hash(&hash_context, p_packet->payload.start.start_address, length);
+    (void) sha256_update(&hash_context, (uint8_t*) p_bank_entry->bank.p_bank_addr, length);
+    if (!signature_verify(&hash_context, p_bank_entry->bank.signature))
+    {
+        __LOG("Bank at 0x%x doesn't match the relayed transfer\n", p_bank_entry->bank.p_bank_addr);
+        return;
+    }
+
+    __LOG("Relaying from bank at 0x%x\n", p_bank_entry->bank.p_bank_addr);
+    m_transaction.p_bank_addr = p_bank_entry->bank.p_bank_addr;
+    m_transaction.length = length;
+}
+
 /*************** Packet handlers ******************/
 static uint32_t target_rx_start(dfu_packet_t* p_packet, bool* p_do_relay)
 {
@@ -754,7 +944,7 @@ static uint32_t target_rx_start(dfu_packet_t* p_packet, bool* p_do_relay)
     m_transaction.length                            = p_packet->payload.start.length * 4;
     m_transaction.signature_length                  = p_packet->payload.start.signature_length;
     m_transaction.segment_is_valid_after_transfer   = p_packet->payload.start.last;
-    m_transaction.p_last_requested_entry            = NULL;
+    m_transaction.segment_rx_max                    = 0;
     m_transaction.signature_bitmap                  = 0;
 
     /* Reset all transfer specific caches. */
@@ -891,6 +1081,12 @@ static uint32_t target_rx_data(dfu_packet_t* p_packet, uint16_t length, bool* p_
         }
     }
 
+    /* Segments dropped for lack of gap tracking space are requested again later. */
+    if ((error_code == NRF_SUCCESS || error_code == NRF_ERROR_NO_MEM) &&
+        p_packet->payload.data.segment > m_transaction.segment_rx_max)
+    {
+        m_transaction.segment_rx_max = p_packet->payload.data.segment;
+    }
     if (error_code != NRF_SUCCESS)
     {
         return error_code;
@@ -900,7 +1096,7 @@ static uint32_t target_rx_data(dfu_packet_t* p_packet, uint16_t length, bool* p_
     *p_do_relay = true;
     if (m_data_req_segment == DATA_REQ_SEGMENT_NONE)
     {
-        request_missing_data(p_packet->payload.data.segment);
+        request_missing_data();
     }
     return error_code;
 }
@@ -970,6 +1166,7 @@ static uint32_t handle_data_packet(dfu_packet_t* p_packet, uint16_t length)
             }
             SET_STATE(DFU_STATE_RELAY);
             (void) tx_abort(TX_SLOT_BEACON);
+            relay_bank_find(p_packet);
 
             bl_evt_t relay_evt;
             relay_evt.type = BL_EVT_TYPE_DFU_START;
@@ -985,6 +1182,10 @@ static uint32_t handle_data_packet(dfu_packet_t* p_packet, uint16_t length)
             if (p_packet->payload.data.segment == 0)
             {
                 m_transaction.segment_count = segment_count_from_start_packet(p_packet);
+                if (!m_transaction.relay_bank_checked)
+                {
+                    relay_bank_find(p_packet);
+                }
             }
             send_progress_event(p_packet->payload.data.segment, m_transaction.segment_count);
             do_relay = true;
@@ -1147,6 +1348,11 @@ static uint32_t handle_data_req_packet(dfu_packet_t* p_packet)
             {
                 status = NRF_SUCCESS;
             }
+            else if (segment_serve(p_packet->payload.req_data.segment) != NRF_ERROR_NOT_FOUND)
+            {
+                /* served from our own bank */
+                status = NRF_SUCCESS;
+            }
             else
             {
                 status = relay_packet(p_packet, DFU_PACKET_LEN_DATA_REQ);
@@ -1162,57 +1368,82 @@ static uint32_t handle_data_req_packet(dfu_packet_t* p_packet)
         }
         else /* In transfer */
         {
-            req_cache_entry_t* p_req_entry = NULL;
-            /* check that we haven't served this request recently. */
-            for (uint32_t i = 0; i < REQ_CACHE_SIZE; ++i)
+            status = segment_serve(p_packet->payload.req_data.segment);
+            if (status == NRF_ERROR_BUSY)
             {
-                if (m_req_cache[i].segment == p_packet->payload.req_data.segment)
-                {
-                    if (m_req_cache[i].rx_count++ < REQ_RX_COUNT_RETRY)
-                    {
-                        return NRF_SUCCESS;
-                    }
-                    p_req_entry = &m_req_cache[i];
-                    break;
-                }
+                status = NRF_SUCCESS;
             }
-            /* serve request */
-            dfu_packet_t dfu_rsp;
-            if (
-                dfu_transfer_has_entry(
-                    (uint32_t*) SEGMENT_ADDR(p_packet->payload.req_data.segment, m_transaction.p_start_addr),
-                    dfu_rsp.payload.rsp_data.data, SEGMENT_LENGTH)
-               )
-            {
-                dfu_rsp.packet_type = DFU_PACKET_TYPE_DATA_RSP;
-                dfu_rsp.payload.rsp_data.segment = p_packet->payload.req_data.segment;
-                dfu_rsp.payload.rsp_data.transaction_id = p_packet->payload.req_data.transaction_id;
+        }
+    }
+    else
+    {
+        status = NRF_ERROR_INVALID_DATA;
+    }
+    return status;
+}
 
-                status = packet_tx_dynamic(&dfu_rsp, DFU_PACKET_LEN_DATA_RSP, TX_INTERVAL_TYPE_RSP, TX_REPEATS_RSP);
-            }
-            else
-            {
-                status = NRF_ERROR_NOT_FOUND;
-            }
+static uint32_t handle_data_req_range_packet(dfu_packet_t* p_packet, uint16_t length)
+{
+    if (p_packet->payload.req_range.transaction_id != m_transaction.transaction_id)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+    if (length < DFU_PACKET_LEN_DATA_REQ_RANGE(1) ||
+        length > DFU_PACKET_LEN_DATA_REQ_RANGE(DFU_PACKET_REQ_RANGES_MAX))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    uint32_t range_count = (length - DFU_PACKET_LEN_DATA_REQ_RANGE(0)) / sizeof(dfu_packet_segment_range_t);
+    __LOG("RX data REQ for %u ranges from #%u\n", range_count, p_packet->payload.req_range.segment);
+
+    if (m_state == DFU_STATE_RELAY && packet_in_cache(p_packet))
+    {
+        return NRF_SUCCESS;
+    }
 
-            /* log our attempt at responding */
-            if ((status == NRF_SUCCESS) && (p_req_entry == NULL))
+    /* Serve what we can, oldest segments first. */
+    uint32_t served = 0;
+    bool is_missing = false;
+    for (uint32_t i = 0; i < range_count && served < DATA_REQ_RSP_COUNT_MAX; ++i)
+    {
+        const dfu_packet_segment_range_t* p_range = &p_packet->payload.req_range.ranges[i];
+        for (uint32_t j = 0; j < p_range->count && served < DATA_REQ_RSP_COUNT_MAX; ++j)
+        {
+            uint32_t status = segment_serve(p_range->segment + j);
+            if (status == NRF_SUCCESS)
             {
-                p_req_entry = &m_req_cache[(m_req_index++) & (REQ_CACHE_SIZE - 1)];
-                p_req_entry->segment = p_packet->payload.req_data.segment;
+                served++;
             }
-
-            /* Check that p_req_enry is not NULL, if status is not NRF_SUCCESS. If status is 
-               NRF_SUCCESS, p_req_entry will always be set. */
-            if (p_req_entry != NULL)
+            else if (status == NRF_ERROR_NOT_FOUND)
             {
-                p_req_entry->rx_count = 0;
+                is_missing = true;
             }
         }
     }
-    else
+
+    /* Relays pass on the request if they couldn't serve all of it. */
+    uint32_t status = NRF_SUCCESS;
+    if (m_state == DFU_STATE_RELAY && (is_missing || served == DATA_REQ_RSP_COUNT_MAX))
     {
-        status = NRF_ERROR_INVALID_DATA;
+        status = relay_packet(p_packet, length);
+
+#if RBC_MESH_SERIAL
+        /* The serial host only knows single segment requests. */
+        const dfu_packet_segment_range_t* p_range = &p_packet->payload.req_range.ranges[0];
+        for (uint32_t j = 0; j < p_range->count && j < DATA_REQ_RSP_COUNT_MAX; ++j)
+        {
+            dfu_packet_t req_packet;
+            req_packet.packet_type = DFU_PACKET_TYPE_DATA_REQ;
+            req_packet.payload.req_data.segment = p_range->segment + j;
+            req_packet.payload.req_data.transaction_id = p_packet->payload.req_range.transaction_id;
+
+            bl_evt_t tx_evt;
+            tx_evt.type = BL_EVT_TYPE_TX_SERIAL;
+            tx_evt.params.tx.serial.p_dfu_packet = &req_packet;
+            tx_evt.params.tx.serial.length = DFU_PACKET_LEN_DATA_REQ;
+            (void) bootloader_evt_send(&tx_evt);
+        }
+#endif
     }
     return status;
 }
@@ -1322,6 +1553,7 @@ uint32_t dfu_mesh_relay(dfu_type_t type, fwid_union_t* p_fwid, uint32_t transact
     SET_STATE(DFU_STATE_RELAY_CANDIDATE);
     m_transaction.type = type;
     m_transaction.transaction_id = transaction_id;
+    m_transaction.relay_bank_checked = false;
     fwid_union_cpy(
             &m_transaction.target_fwid_union,
             p_fwid,
@@ -1361,7 +1593,14 @@ uint32_t dfu_mesh_rx(dfu_packet_t* p_packet, uint16_t length, bool from_serial)
             break;
 
         case DFU_PACKET_TYPE_DATA_REQ:
-            status = handle_data_req_packet(p_packet);
+            if (length > DFU_PACKET_LEN_DATA_REQ)
+            {
+                status = handle_data_req_range_packet(p_packet, length);
+            }
+            else
+            {
+                status = handle_data_req_packet(p_packet);
+            }
             break;
 
         case DFU_PACKET_TYPE_DATA_RSP:
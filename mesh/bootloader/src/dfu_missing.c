@@ -0,0 +1,214 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include "dfu_missing.h"
+#include "nrf_error.h"
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/** Find the run containing the given segment, or return -1. */
+static int32_t run_find(const dfu_missing_t* p_missing, uint16_t segment)
+{
+    uint32_t low = 0;
+    uint32_t high = p_missing->run_count;
+    while (low < high)
+    {
+        uint32_t mid = (low + high) / 2;
+        const dfu_missing_run_t* p_run = &p_missing->runs[mid];
+        if (segment < p_run->segment)
+        {
+            high = mid;
+        }
+        else if ((uint32_t) segment >= (uint32_t) p_run->segment + p_run->count)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            return (int32_t) mid;
+        }
+    }
+    return -1;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void dfu_missing_init(dfu_missing_t* p_missing, uint16_t segment_count)
+{
+    memset(p_missing, 0, sizeof(dfu_missing_t));
+    p_missing->segment_count = segment_count;
+}
+
+uint32_t dfu_missing_segment_rx(dfu_missing_t* p_missing, uint16_t segment)
+{
+    if (segment == 0 || segment > p_missing->segment_count)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (segment > p_missing->segment_max)
+    {
+        if (segment > p_missing->segment_max + 1)
+        {
+            /* Everything we skipped is a new gap at the end of the list. */
+            if (p_missing->run_count == DFU_MISSING_RUNS_MAX)
+            {
+                return NRF_ERROR_NO_MEM;
+            }
+            dfu_missing_run_t* p_run = &p_missing->runs[p_missing->run_count++];
+            p_run->segment = p_missing->segment_max + 1;
+            p_run->count = segment - p_missing->segment_max - 1;
+        }
+        p_missing->segment_max = segment;
+        return NRF_SUCCESS;
+    }
+
+    int32_t index = run_find(p_missing, segment);
+    if (index < 0)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    dfu_missing_run_t* p_run = &p_missing->runs[index];
+    uint16_t run_last = p_run->segment + p_run->count - 1;
+    uint32_t runs_after = p_missing->run_count - (uint32_t) index - 1;
+
+    if (p_run->count == 1)
+    {
+        memmove(p_run, p_run + 1, runs_after * sizeof(dfu_missing_run_t));
+        p_missing->run_count--;
+    }
+    else if (segment == p_run->segment)
+    {
+        p_run->segment++;
+        p_run->count--;
+    }
+    else if (segment == run_last)
+    {
+        p_run->count--;
+    }
+    else
+    {
+        /* Split the run in two around the received segment. */
+        if (p_missing->run_count == DFU_MISSING_RUNS_MAX)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+        memmove(p_run + 2, p_run + 1, runs_after * sizeof(dfu_missing_run_t));
+        p_run[1].segment = segment + 1;
+        p_run[1].count = run_last - segment;
+        p_run->count = segment - p_run->segment;
+        p_missing->run_count++;
+    }
+    return NRF_SUCCESS;
+}
+
+bool dfu_missing_is_missing(const dfu_missing_t* p_missing, uint16_t segment)
+{
+    if (segment == 0 || segment > p_missing->segment_count)
+    {
+        return false;
+    }
+    if (segment > p_missing->segment_max)
+    {
+        return true;
+    }
+    return (run_find(p_missing, segment) >= 0);
+}
+
+uint32_t dfu_missing_ranges_get(const dfu_missing_t* p_missing,
+                                uint16_t segment_limit,
+                                uint16_t count_max,
+                                dfu_missing_run_t* p_ranges,
+                                uint32_t range_count)
+{
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < p_missing->run_count && found < range_count; ++i)
+    {
+        const dfu_missing_run_t* p_run = &p_missing->runs[i];
+        if (p_run->segment > segment_limit)
+        {
+            return found;
+        }
+        uint16_t count = p_run->count;
+        if (count > segment_limit - p_run->segment + 1)
+        {
+            count = segment_limit - p_run->segment + 1;
+        }
+        if (count > count_max)
+        {
+            count = count_max;
+        }
+        p_ranges[found].segment = p_run->segment;
+        p_ranges[found].count = count;
+        found++;
+    }
+
+    /* The segments after the highest received segment are not part of any run. */
+    uint16_t last = (p_missing->segment_count < segment_limit) ? p_missing->segment_count : segment_limit;
+    if (found < range_count && last > p_missing->segment_max)
+    {
+        uint16_t count = last - p_missing->segment_max;
+        p_ranges[found].segment = p_missing->segment_max + 1;
+        p_ranges[found].count = (count > count_max) ? count_max : count;
+        found++;
+    }
+    return found;
+}
+
+uint16_t dfu_missing_prefix_get(const dfu_missing_t* p_missing)
+{
+    if (p_missing->run_count > 0)
+    {
+        return p_missing->runs[0].segment - 1;
+    }
+    return p_missing->segment_max;
+}
+
+uint32_t dfu_missing_count_get(const dfu_missing_t* p_missing)
+{
+    uint32_t count = p_missing->segment_count - p_missing->segment_max;
+    for (uint32_t i = 0; i < p_missing->run_count; ++i)
+    {
+        count += p_missing->runs[i].count;
+    }
+    return count;
+}
@@ -37,6 +37,8 @@
 
 #include <string.h>
 #include "dfu_transfer_mesh.h"
+#include "dfu_missing.h"
+#include "dfu_hash.h"
 #include "dfu_types_mesh.h"
 #include "dfu_mesh.h"
 #include "nrf.h"
@@ -50,25 +52,26 @@
 * Local defines
 *****************************************************************************/
 #define INVALID_SEGMENT_INDEX   (0xFFFF)
-#define MISSING_BITFIELD_WIDTH  (64ULL)
+/* Most data to hash per flash write, so the hash can catch up after a gap without stalling the radio. */
+#define HASH_STEP_MAX           (SEGMENT_LENGTH * 8)
 
 /*****************************************************************************
 * Local typedefs
 *****************************************************************************/
 
-typedef uint64_t bitfield_t;
-
 typedef struct
 {
     uint32_t*       p_start_addr;
     uint32_t*       p_bank_addr;
     uint16_t        segment_count;
     bool            final_transfer;
+    bool            in_progress;
     uint32_t        size;
-    bitfield_t      missing_segments;
+    dfu_missing_t   missing;
     uint8_t         write_buffer[SEGMENT_LENGTH];
-    uint16_t        segment_max;
     uint16_t        segment_prev;
+    bool            hash_started;
+    dfu_hash_t      hash;
 } dfu_transfer_t;
 
 /*****************************************************************************
@@ -82,21 +85,15 @@ static dfu_transfer_t m_transfer;
 
 static void transfer_abort(dfu_end_t end_reason)
 {
-    m_transfer.segment_max = INVALID_SEGMENT_INDEX;
+    m_transfer.in_progress = false;
     send_end_evt(end_reason);
 }
 
-static bool segment_is_missing(uint16_t segment)
+/* Hash the part of the bank that has been received without gaps, and is in flash. */
+static void hash_update(uint32_t step_max)
 {
-    if (segment > m_transfer.segment_max)
-    {
-        return true;
-    }
-    if ((m_transfer.segment_max - segment) > (uint16_t)MISSING_BITFIELD_WIDTH)
-    {
-        return false;
-    }
-    return !!((1ULL << (m_transfer.segment_max - segment)) & m_transfer.missing_segments);
+    uint32_t available = dfu_missing_prefix_get(&m_transfer.missing) * SEGMENT_LENGTH;
+    (void) dfu_hash_update(&m_transfer.hash, available, step_max);
 }
 
 /*****************************************************************************
@@ -105,7 +102,6 @@ static bool segment_is_missing(uint16_t segment)
 void dfu_transfer_init(void)
 {
     memset(&m_transfer, 0, sizeof(dfu_transfer_t));
-    m_transfer.segment_max = INVALID_SEGMENT_INDEX;
 }
 
 uint32_t dfu_transfer_start(
@@ -115,7 +111,8 @@ uint32_t dfu_transfer_start(
         bool final_transfer)
 {
     dfu_transfer_init();
-    uint16_t segment_count = (((size + (uint32_t) p_start_addr) & 0xFFFFFFF0) - ((uint32_t) p_start_addr & 0xFFFFFFF0)) / 16;
+    /* Count the last segment, even if it's not full. */
+    uint16_t segment_count = (((size + (uint32_t) p_start_addr + SEGMENT_LENGTH - 1) & 0xFFFFFFF0) - ((uint32_t) p_start_addr & 0xFFFFFFF0)) / 16;
 
     if (PAGE_OFFSET(p_start_addr) != 0 ||
         PAGE_OFFSET(p_bank_addr) != 0)
@@ -140,15 +137,15 @@ uint32_t dfu_transfer_start(
     m_transfer.segment_count = segment_count;
     m_transfer.final_transfer = final_transfer;
     m_transfer.size = size;
-    m_transfer.missing_segments = 0;
+    dfu_missing_init(&m_transfer.missing, segment_count);
     m_transfer.segment_prev = INVALID_SEGMENT_INDEX;
-    m_transfer.segment_max = 0;
+    m_transfer.in_progress = true;
     return status;
 }
 
 uint32_t dfu_transfer_data(uint32_t p_addr, uint8_t* p_data, uint16_t length)
 {
-    if (m_transfer.segment_max == INVALID_SEGMENT_INDEX)
+    if (!m_transfer.in_progress)
     {
         return NRF_ERROR_INVALID_STATE;
     }
@@ -170,33 +167,11 @@ uint32_t dfu_transfer_data(uint32_t p_addr, uint8_t* p_data, uint16_t length)
 
     uint16_t segment = ADDR_SEGMENT(p_addr, m_transfer.p_start_addr);
 
-    if (!segment_is_missing(segment))
-    {
-        return NRF_ERROR_INVALID_STATE;
-    }
-
-    if (segment > m_transfer.segment_max)
-    {
-        /* Ensure that we don't shift out any set bits: Mask the shift on the
-         * MSB side (ie only look at the part that will overflow), and check
-         * whether there are any bits set in that section. */
-        uint16_t segment_offset = segment - m_transfer.segment_max;
-        bitfield_t shift_mask = (1ULL << segment_offset) - 1ULL;
-        if (m_transfer.missing_segments & (shift_mask << (MISSING_BITFIELD_WIDTH - segment_offset)))
-        {
-            transfer_abort(DFU_END_ERROR_PACKET_LOSS);
-            return NRF_ERROR_NOT_FOUND;
-        }
-        /* Offset the bitfield to match the new segment_max, and set all bits
-         * that we skipped to 1, as they're considered missing. */
-        m_transfer.missing_segments = (m_transfer.missing_segments << segment_offset) | shift_mask;
-        m_transfer.missing_segments &= ~1ULL; /* The newest segment isn't missing. */
-        m_transfer.segment_max = segment;
-    }
-    else
+    /* If the segment would open a gap we can't track, it's dropped and requested again later. */
+    uint32_t status = dfu_missing_segment_rx(&m_transfer.missing, segment);
+    if (status != NRF_SUCCESS)
     {
-        uint16_t segment_offset = m_transfer.segment_max - segment;
-        m_transfer.missing_segments &= ~((bitfield_t)1 << segment_offset);
+        return status;
     }
 
     m_transfer.segment_prev = segment;
@@ -215,62 +190,59 @@ uint32_t dfu_transfer_data(uint32_t p_addr, uint8_t* p_data, uint16_t length)
 
 bool dfu_transfer_has_entry(uint32_t* p_addr, uint8_t* p_out_buffer, uint16_t len)
 {
-    if (m_transfer.segment_max == INVALID_SEGMENT_INDEX)
+    if (!m_transfer.in_progress)
     {
         return false;
     }
     uint16_t segment = ADDR_SEGMENT(p_addr, m_transfer.p_start_addr);
-    if (segment > m_transfer.segment_max)
+    if (segment == 0 || segment > m_transfer.segment_count ||
+        dfu_missing_is_missing(&m_transfer.missing, segment))
     {
         return false;
     }
-    if (!segment_is_missing(segment))
+    if (p_out_buffer && len)
     {
-        if (p_out_buffer && len)
-        {
-            uint32_t* p_storage_addr = (uint32_t*) SEGMENT_ADDR(segment, m_transfer.p_bank_addr);
-            memcpy(p_out_buffer, p_storage_addr, len);
-        }
-        return true;
+        uint32_t* p_storage_addr = (uint32_t*) SEGMENT_ADDR(segment, m_transfer.p_bank_addr);
+        memcpy(p_out_buffer, p_storage_addr, len);
     }
-    return false;
+    return true;
 }
 
-bool dfu_transfer_get_oldest_missing_entry(
-        uint32_t* p_start_addr,
-        uint32_t** pp_entry,
-        uint32_t* p_len)
+uint32_t dfu_transfer_missing_ranges_get(uint16_t segment_limit,
+        dfu_missing_run_t* p_ranges,
+        uint32_t range_count,
+        uint16_t count_max)
 {
-    if (m_transfer.segment_max == INVALID_SEGMENT_INDEX)
+    if (!m_transfer.in_progress)
     {
-        return false;
+        return 0;
     }
-    for (int32_t i = 63; i >= 0; i--)
+    return dfu_missing_ranges_get(&m_transfer.missing, segment_limit, count_max, p_ranges, range_count);
+}
+
+uint32_t dfu_transfer_sha256_start(const sha256_context_t* p_hash_context)
+{
+    if (!m_transfer.in_progress)
     {
-        if (m_transfer.missing_segments & (1ULL << i))
-        {
-            uint16_t segment = m_transfer.segment_max - i;
-            uint32_t addr = SEGMENT_ADDR(segment, m_transfer.p_start_addr);
-            if (addr >= (uint32_t) p_start_addr)
-            {
-                *pp_entry = (uint32_t*) addr;
-                *p_len = SEGMENT_LENGTH;
-                return true;
-            }
-        }
+        return NRF_ERROR_INVALID_STATE;
+    }
+    dfu_hash_start(&m_transfer.hash, p_hash_context, (uint8_t*) m_transfer.p_bank_addr, m_transfer.size);
+    m_transfer.hash_started = true;
+    if (m_transfer.segment_prev == INVALID_SEGMENT_INDEX)
+    {
+        hash_update(HASH_STEP_MAX);
     }
-    return false;
+    return NRF_SUCCESS;
 }
 
 uint32_t dfu_transfer_sha256(sha256_context_t* p_hash_context)
 {
-    if (m_transfer.segment_max == INVALID_SEGMENT_INDEX)
+    if (!m_transfer.in_progress || !m_transfer.hash_started)
     {
         return NRF_ERROR_INVALID_STATE;
     }
-    return sha256_update(p_hash_context,
-                  (uint8_t*) m_transfer.p_bank_addr,
-                  m_transfer.size);
+    dfu_hash_finish(&m_transfer.hash, p_hash_context);
+    return NRF_SUCCESS;
 }
 
 void dfu_transfer_end(void)
@@ -283,6 +255,10 @@ void dfu_transfer_flash_write_complete(uint8_t* p_write_src)
     if (p_write_src == m_transfer.write_buffer)
     {
         m_transfer.segment_prev = INVALID_SEGMENT_INDEX;
+        if (m_transfer.hash_started)
+        {
+            hash_update(HASH_STEP_MAX);
+        }
     }
 }
 
@@ -86,6 +86,9 @@ void mesh_config_clear(void);
 /**
  * Store all power-down state.
  *
+ * Emits @ref NRF_MESH_EVT_CONFIG_POWER_DOWN before the dirty entries are processed, so that modules
+ * holding deferred entry values can set them and have them stored along with the power-down state.
+ *
  * @note The configuration data is not safely stored until the mesh config module goes out of the busy
  * state, as indicated by @ref mesh_config_is_busy or the @ref NRF_MESH_EVT_CONFIG_STABLE event.
  */
@@ -126,6 +129,24 @@ uint32_t mesh_config_power_down_time_get(void);
  */
 void mesh_config_file_clear(uint16_t file_id);
 
+/**
+ * Start a batch of entry changes.
+ *
+ * Entries set or deleted during the batch are marked dirty, but not handed to the backend until the
+ * batch ends. Changing many entries in a batch costs one pass over the dirty entries rather than one
+ * per change, and an entry changed more than once in the batch is only stored once.
+ *
+ * Batches may be nested, the entries are stored when the outermost batch ends. Power-down storage
+ * is not deferred by a batch.
+ */
+void mesh_config_batch_begin(void);
+
+/**
+ * End a batch of entry changes started with @ref mesh_config_batch_begin, and store the entries
+ * changed in it.
+ */
+void mesh_config_batch_end(void);
+
 /** @} */
 
 #endif /* MESH_CONFIG_H__ */
@@ -298,6 +298,24 @@ bool mesh_config_entry_available_id(mesh_config_entry_id_t * p_id);
  */
 uint32_t mesh_config_entry_set(mesh_config_entry_id_t id, const void * p_entry);
 
+/**
+ * Set an entry value without storing it.
+ *
+ * Passes the value to the state owner, which validates and applies it, exactly like
+ * @ref mesh_config_entry_set, but the entry is not marked as dirty. The value is only written to
+ * persistent storage once it is passed to @ref mesh_config_entry_set, allowing callers to defer the
+ * flash write while still getting the result of the validation right away.
+ *
+ * @param[in] id      Entry ID to set the value of.
+ * @param[in] p_entry Entry data to set for the given entry ID.
+ *
+ * @retval NRF_SUCCESS The value was successfully set.
+ * @retval NRF_ERROR_NULL A parameter is NULL.
+ * @retval NRF_ERROR_NOT_FOUND The given ID is unknown.
+ * @retval NRF_ERROR_INVALID_DATA the state owner has determined that the data in @p p_entry is invalid.
+ */
+uint32_t mesh_config_entry_set_deferred(mesh_config_entry_id_t id, const void * p_entry);
+
 /**
  * Get an entry value.
  *
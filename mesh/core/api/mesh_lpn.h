@@ -87,6 +87,22 @@
 #define MESH_LPN_POLL_SEPARATION_INTERVAL_MS 50
 #endif
 
+/** Adapt the interval between polling sessions to the traffic.
+ *
+ * When enabled, the poll interval drops to @ref MESH_LPN_POLL_INTERVAL_MIN_MS after a session that
+ * delivered data, and doubles after each session that found the Friend Queue empty. The interval set
+ * with @ref mesh_lpn_poll_interval_set is the longest interval. When disabled, the LPN always
+ * polls at the interval set with @ref mesh_lpn_poll_interval_set.
+ */
+#ifndef MESH_LPN_ADAPTIVE_POLL_ENABLED
+#define MESH_LPN_ADAPTIVE_POLL_ENABLED 0
+#endif
+
+/** The shortest interval between two polling sessions with @ref MESH_LPN_ADAPTIVE_POLL_ENABLED. */
+#ifndef MESH_LPN_POLL_INTERVAL_MIN_MS
+#define MESH_LPN_POLL_INTERVAL_MIN_MS 1000
+#endif
+
 
 /** Parameters of the Friend node Criteria field. */
 typedef struct
@@ -223,6 +239,9 @@ uint32_t mesh_lpn_friend_poll(uint32_t delay_ms);
  * @note The new poll interval will change after the next poll. To poll immediately, use the API
  *       mesh_lpn_friend_poll().
  *
+ * @note With @ref MESH_LPN_ADAPTIVE_POLL_ENABLED, this is the longest interval between two polling
+ *       sessions.
+ *
  * @retval NRF_SUCCESS             Successfully set the new poll interval.
  * @retval NRF_ERROR_INVALID_PARAM The provided `poll_interval_ms` is out of range for the current poll
  *                                 timeout, receive delay, and Receive Window.
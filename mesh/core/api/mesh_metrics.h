@@ -0,0 +1,132 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MESH_METRICS_H__
+#define MESH_METRICS_H__
+
+#include <stdint.h>
+#include "nrf_mesh_config_core.h"
+
+/**
+ * @defgroup MESH_METRICS Packet pipeline metrics
+ * @ingroup NRF_MESH
+ * Counters and latency histograms for each stage of the packet pipeline.
+ *
+ * The counters follow a packet from the bearer, through the network and transport layers, to the
+ * access layer, and count the packets dropped at each stage. The histograms record the processing
+ * time of the stages in log2 buckets of microseconds. The metrics are collected when
+ * @ref MESH_METRICS_ENABLE is set.
+ * @{
+ */
+
+/** Packet pipeline counters. */
+typedef enum
+{
+    MESH_METRICS_COUNTER_NET_RX,               /**< Network PDUs received from the bearers. */
+    MESH_METRICS_COUNTER_NET_DEOBFUSCATED,     /**< Network headers deobfuscated, once per candidate network key. */
+    MESH_METRICS_COUNTER_NET_CACHE_DROPPED,    /**< Network PDUs dropped by the message cache. */
+    MESH_METRICS_COUNTER_NET_DECRYPTED,        /**< Network PDUs authenticated with one of the network keys. */
+    MESH_METRICS_COUNTER_NET_DECRYPT_FAILED,   /**< Network PDUs that could not be authenticated, or were dropped by the message cache. */
+    MESH_METRICS_COUNTER_NET_RELAYED,          /**< Network PDUs relayed. */
+    MESH_METRICS_COUNTER_NET_RELAY_FAILED,     /**< Network PDUs that should have been relayed, but no TX buffer was available. */
+    MESH_METRICS_COUNTER_TRS_REPLAY_DROPPED,   /**< Transport PDUs dropped by the replay protection cache. */
+    MESH_METRICS_COUNTER_TRS_ADDRESS_DROPPED,  /**< Transport PDUs dropped as they were not addressed to this node or its Low Power nodes. */
+    MESH_METRICS_COUNTER_TRS_DECRYPTED,        /**< Upper transport access PDUs decrypted. */
+    MESH_METRICS_COUNTER_TRS_DECRYPT_FAILED,   /**< Upper transport access PDUs that could not be decrypted. */
+    MESH_METRICS_COUNTER_ACCESS_RX,            /**< Access messages to one of the addresses of this node. */
+    MESH_METRICS_COUNTER_ACCESS_DELIVERED,     /**< Access messages passed to a model, once per model. */
+    MESH_METRICS_COUNTER_ACCESS_UNHANDLED,     /**< Access messages not handled by any model. */
+    MESH_METRICS_COUNTER_TX_ALLOCATED,         /**< Network PDUs allocated for TX on at least one bearer. */
+    MESH_METRICS_COUNTER_TX_ALLOC_FAILED,      /**< Network PDUs that could not be allocated on any bearer. */
+    MESH_METRICS_COUNTER_TX_DISCARDED,         /**< Allocated network PDUs discarded before they were sent. */
+    MESH_METRICS_COUNTER_TX_COMPLETE,          /**< Network PDU transmissions completed, once per bearer. */
+    MESH_METRICS_COUNTER_NET_PDU_DROPPED,      /**< Network PDUs dropped before decryption as copies of an already processed PDU. */
+    MESH_METRICS_COUNTER_COUNT                 /**< Number of counters. */
+} mesh_metrics_counter_t;
+
+/** Packet pipeline latency histograms. */
+typedef enum
+{
+    MESH_METRICS_HISTOGRAM_NET_DECRYPT,        /**< Network PDU deobfuscation and decryption time. */
+    MESH_METRICS_HISTOGRAM_TRS_DECRYPT,        /**< Upper transport access PDU decryption time. */
+    MESH_METRICS_HISTOGRAM_ACCESS_DISPATCH,    /**< Access message dispatch time, including the model handlers. */
+    MESH_METRICS_HISTOGRAM_RX_TO_ACCESS,       /**< Time from receiving the last packet of a message on air to dispatching it to the models. */
+    MESH_METRICS_HISTOGRAM_COUNT               /**< Number of histograms. */
+} mesh_metrics_histogram_t;
+
+/** Latency histogram. */
+typedef struct
+{
+    uint32_t count;                                         /**< Number of samples. */
+    uint32_t max_us;                                        /**< Longest sample, in microseconds. */
+    uint32_t sum_us;                                        /**< Sum of all samples, in microseconds. Saturates at @c UINT32_MAX. */
+    uint32_t buckets[MESH_METRICS_HISTOGRAM_BUCKET_COUNT];  /**< Sample count for each log2 bucket, see @ref MESH_METRICS_HISTOGRAM_BUCKET_COUNT. */
+} mesh_metrics_histogram_data_t;
+
+/**
+ * Gets the packet pipeline counters.
+ *
+ * @param[out] p_counters Array of @ref MESH_METRICS_COUNTER_COUNT counters to fill, indexed by
+ *                        @ref mesh_metrics_counter_t. The counters saturate at @c UINT32_MAX.
+ *
+ * @retval NRF_SUCCESS              The counters were copied.
+ * @retval NRF_ERROR_NULL           The counter array was NULL.
+ * @retval NRF_ERROR_NOT_SUPPORTED  The metrics are not enabled, see @ref MESH_METRICS_ENABLE.
+ */
+uint32_t mesh_metrics_counters_get(uint32_t * p_counters);
+
+/**
+ * Gets a latency histogram.
+ *
+ * @param[in]  histogram   Histogram to get.
+ * @param[out] p_data      Histogram data to fill.
+ *
+ * @retval NRF_SUCCESS              The histogram was copied.
+ * @retval NRF_ERROR_NULL           The histogram data pointer was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  Unknown histogram.
+ * @retval NRF_ERROR_NOT_SUPPORTED  The metrics are not enabled, see @ref MESH_METRICS_ENABLE.
+ */
+uint32_t mesh_metrics_histogram_get(mesh_metrics_histogram_t histogram, mesh_metrics_histogram_data_t * p_data);
+
+/**
+ * Clears all counters and histograms.
+ */
+void mesh_metrics_clear(void);
+
+/** @} end of MESH_METRICS */
+
+#endif /* MESH_METRICS_H__ */
@@ -537,6 +537,44 @@ uint32_t nrf_mesh_disable(void);
 uint32_t nrf_mesh_packet_send(const nrf_mesh_tx_params_t * p_params,
                               uint32_t * const p_packet_reference);
 
+/**
+ * Reserves an unsegmented mesh packet, so that the caller can write its payload in place.
+ *
+ * The payload is written directly into the network buffer and encrypted in place by
+ * @ref nrf_mesh_packet_commit, saving the intermediate copies done by @ref nrf_mesh_packet_send.
+ * Only one packet can be reserved at a time, and the reservation must be committed or discarded
+ * before returning from the calling context.
+ *
+ * @note The @c p_data field of @p p_params is ignored, @c data_len is the number of bytes to
+ * reserve.
+ *
+ * @param[in]  p_params   Pointer to a structure containing the parameters for the message to send.
+ * @param[out] pp_payload Returns a pointer to where @c p_params->data_len bytes of payload should
+ *                        be written.
+ *
+ * @retval NRF_SUCCESS              The packet was successfully reserved.
+ * @retval NRF_ERROR_NULL           A required parameter was @c NULL.
+ * @retval NRF_ERROR_BUSY           Another packet is already reserved.
+ * @retval NRF_ERROR_INVALID_LENGTH The message has to be segmented. Use @ref nrf_mesh_packet_send
+ *                                  instead.
+ * @retval NRF_ERROR_NO_MEM         A packet buffer could not be allocated for the packet.
+ * @retval NRF_ERROR_INVALID_ADDR   The source address is not a unicast address, or the destination
+ *                                  is invalid.
+ * @retval NRF_ERROR_INVALID_PARAM  TTL was larger than NRF_MESH_TTL_MAX.
+ * @retval NRF_ERROR_FORBIDDEN      Failed to allocate a sequence number from network.
+ */
+uint32_t nrf_mesh_packet_reserve(const nrf_mesh_tx_params_t * p_params, uint8_t ** pp_payload);
+
+/**
+ * Encrypts and queues the packet reserved with @ref nrf_mesh_packet_reserve for transmission.
+ */
+void nrf_mesh_packet_commit(void);
+
+/**
+ * Releases the packet reserved with @ref nrf_mesh_packet_reserve without sending it.
+ */
+void nrf_mesh_packet_discard(void);
+
 /**
  * Runs the mesh packet processing process.
  *
@@ -187,13 +187,36 @@
 #define INTERNAL_EVT_ENABLE 0
 #endif
 
-/** Internal event buffer size. */
+/** Enable tracing of internal events and layer processing spans, see @ref internal_event_trace_read(). */
+#ifndef INTERNAL_EVENT_TRACE_ENABLE
+#define INTERNAL_EVENT_TRACE_ENABLE 0
+#endif
+
+/** Internal event buffer size, in trace records. Must be a power of two. */
 #ifndef INTERNAL_EVENT_BUFFER_SIZE
-#define INTERNAL_EVENT_BUFFER_SIZE 32
+#define INTERNAL_EVENT_BUFFER_SIZE 128
 #endif
 
 /** @} end of MESH_CONFIG_INTERNAL */
 
+/**
+ * @defgroup MESH_CONFIG_METRICS Packet pipeline metrics configuration
+ * @{
+ */
+
+/** Enable the packet pipeline counters and latency histograms, see @ref MESH_METRICS. */
+#ifndef MESH_METRICS_ENABLE
+#define MESH_METRICS_ENABLE 0
+#endif
+
+/** Number of buckets in each latency histogram. Bucket @c n counts latencies from
+ * 2^n to 2^(n+1)-1 microseconds, the last bucket counts all longer latencies. */
+#ifndef MESH_METRICS_HISTOGRAM_BUCKET_COUNT
+#define MESH_METRICS_HISTOGRAM_BUCKET_COUNT 20
+#endif
+
+/** @} end of MESH_CONFIG_METRICS */
+
 /**
  * @defgroup MESH_CONFIG_LOG Log module configuration
  * @{
@@ -219,6 +242,26 @@
 #define LOG_ENABLE_RTT 1
 #endif
 
+/** Enable the deferred binary log backend, see @ref log_callback_deferred(). */
+#ifndef LOG_ENABLE_DEFERRED
+#define LOG_ENABLE_DEFERRED 0
+#endif
+
+/** Size of the deferred log record buffer in bytes. Must be a power of two. */
+#ifndef LOG_DEFERRED_BUFFER_SIZE
+#define LOG_DEFERRED_BUFFER_SIZE 2048
+#endif
+
+/** Maximum number of argument bytes stored in one deferred log record. Arguments beyond it are dropped. */
+#ifndef LOG_DEFERRED_ARGS_SIZE_MAX
+#define LOG_DEFERRED_ARGS_SIZE_MAX 64
+#endif
+
+/** Maximum number of characters stored for a string argument in a deferred log record. */
+#ifndef LOG_DEFERRED_STRING_LEN_MAX
+#define LOG_DEFERRED_STRING_LEN_MAX 16
+#endif
+
 /** The default callback function to use. */
 #ifndef LOG_CALLBACK_DEFAULT
 #if defined(NRF51) || defined(NRF52_SERIES)
@@ -240,6 +283,17 @@
 #define MSG_CACHE_ENTRY_COUNT 32
 #endif
 
+/**
+ * Number of network PDU fingerprints in cache.
+ *
+ * Exact copies of an encrypted network PDU, e.g. the same PDU received both on the advertising
+ * bearer and through a GATT proxy connection, are dropped on their fingerprint before any
+ * network layer AES operations are done.
+ */
+#ifndef MSG_CACHE_PDU_ENTRY_COUNT
+#define MSG_CACHE_PDU_ENTRY_COUNT 16
+#endif
+
 /** @} end of MESH_CONFIG_MSG_CACHE */
 
 /**
@@ -517,6 +571,27 @@
 #ifndef MESH_GATT_PROXY_BEACON_CACHE_SIZE
 #define MESH_GATT_PROXY_BEACON_CACHE_SIZE 8
 #endif
+
+/**
+ * Number of maximum length proxy PDUs the Mesh GATT TX buffer holds, per connection.
+ *
+ * The buffer is shared by PDUs of all lengths, so it holds more short PDUs, such as status
+ * messages, than this.
+ */
+#ifndef MESH_GATT_TX_PACKET_COUNT
+#define MESH_GATT_TX_PACKET_COUNT 3
+#endif
+
+/**
+ * Number of notifications the SoftDevice queues per connection.
+ *
+ * With the SoftDevice default of one, at most one notification is sent per connection event. A
+ * larger queue lets a burst of proxy PDUs, or the segments of a long PDU, go out in the same
+ * connection event, at the cost of SoftDevice RAM. Set by the example BLE stack initialization.
+ */
+#ifndef MESH_GATT_HVN_TX_QUEUE_SIZE
+#define MESH_GATT_HVN_TX_QUEUE_SIZE 1
+#endif
 /** @} end of MESH_CONFIG_GATT */
 
 /**
@@ -125,6 +125,9 @@ typedef enum
     NRF_MESH_EVT_FRIEND_REQUEST,
     /** The mesh stack completed and stopped all activities and ready to power off. */
     NRF_MESH_EVT_READY_TO_POWER_OFF,
+    /** The mesh config module has started storing power-down state. Entries set while handling
+     * this event are stored through the emergency cache. */
+    NRF_MESH_EVT_CONFIG_POWER_DOWN,
 } nrf_mesh_evt_type_t;
 
 /**
@@ -41,6 +41,8 @@
 #include "nrf_mesh_config_core.h"
 #include "nrf_mesh_assert.h"
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <nrf_error.h>
 #include "log.h"
 #include "utils.h"
@@ -71,6 +73,11 @@ typedef enum
     INTERNAL_EVENT_GATT_PROV_PDU_IGNORED, /**< Invalid provisioning PDU was ignored. */
     INTERNAL_EVENT_FRIEND_PACKET_QUEUED,  /**< Packet to LPN is queued on Friend node. */
     INTERNAL_EVENT_NET_BEACON_TX,         /**< Network beacon is transmitted. */
+    INTERNAL_EVENT_NET_DECRYPT,           /**< Network layer packet decryption span. */
+    INTERNAL_EVENT_TRS_DECRYPT,           /**< Upper transport layer packet decryption span. */
+    INTERNAL_EVENT_ACCESS_DISPATCH,       /**< Access layer message dispatch span. */
+    INTERNAL_EVENT_FLASH_OP,              /**< Flash operation span, with the operation type as state. */
+    INTERNAL_EVENT_BEARER_ACTION,         /**< Bearer action span. */
 
     /** @internal Largest number in the enum. */
     INTERNAL_EVENT__LAST
@@ -112,6 +119,29 @@ typedef struct
     uint8_t * p_packet;
 } internal_event_t;
 
+/** Internal event trace record phases. */
+typedef enum
+{
+    INTERNAL_EVENT_TRACE_PHASE_INSTANT, /**< Single internal event. */
+    INTERNAL_EVENT_TRACE_PHASE_BEGIN,   /**< Start of a processing span. */
+    INTERNAL_EVENT_TRACE_PHASE_END      /**< End of a processing span. */
+} internal_event_trace_phase_t;
+
+/** Internal event trace record. */
+typedef struct __attribute((packed))
+{
+    /** Timestamp, in ticks of @ref internal_event_trace_timestamp_hz_get(). */
+    uint32_t timestamp;
+    /** Type of internal event, see @ref internal_event_type_t. */
+    uint8_t type;
+    /** Record phase, see @ref internal_event_trace_phase_t. */
+    uint8_t phase;
+    /** State information, as in @ref internal_event_t. */
+    uint8_t state;
+    /** Size of the packet the event refers to, or 0. */
+    uint8_t packet_size;
+} internal_event_trace_record_t;
+
 /**
  * Callback function for inline handling of internal events.
  *
@@ -140,6 +170,50 @@ void internal_event_init(internal_event_report_cb_t report_cb);
  */
 uint32_t internal_event_push(internal_event_t * p_event);
 
+/**
+ * Starts or stops recording trace records.
+ *
+ * While enabled, internal events and the begin and end of the processing spans are recorded
+ * with a timestamp into a ring of @ref INTERNAL_EVENT_BUFFER_SIZE records. On nRF52 the
+ * timestamps are taken from the CPU cycle counter, elsewhere from the mesh timer.
+ *
+ * @param[in] enable Whether to record trace records.
+ */
+void internal_event_trace_enable(bool enable);
+
+/**
+ * Records an internal event trace record, if tracing is enabled.
+ *
+ * The record is written with interrupts masked, and may be pushed from any interrupt priority.
+ *
+ * @param[in] type        Type of internal event.
+ * @param[in] phase       Record phase.
+ * @param[in] state       State information about the event.
+ * @param[in] packet_size Size of the packet the event refers to, or 0.
+ */
+void internal_event_trace_push(internal_event_type_t type, internal_event_trace_phase_t phase,
+                               uint8_t state, uint8_t packet_size);
+
+/**
+ * Reads the oldest trace records and frees them from the ring.
+ *
+ * Must only be called from one context.
+ *
+ * @param[out] p_records  Array to copy the records into.
+ * @param[in]  max_count  Number of records that fit in @p p_records.
+ * @param[out] p_dropped  Number of records dropped on a full ring since the last read.
+ *
+ * @returns Number of records copied into @p p_records.
+ */
+uint32_t internal_event_trace_read(internal_event_trace_record_t * p_records, uint32_t max_count, uint32_t * p_dropped);
+
+/**
+ * Gets the frequency of the trace record timestamps.
+ *
+ * @returns Timestamp ticks per second.
+ */
+uint32_t internal_event_trace_timestamp_hz_get(void);
+
 /**
  * Pushes an internal event to the callback function provided at the initialization.
  *
@@ -167,9 +241,28 @@ uint32_t internal_event_push(internal_event_t * p_event);
             __LOG(LOG_SRC_INTERNAL, LOG_LEVEL_WARN, "Unable to push the internal event to the callback function [er%d]", RESULT); \
         }                                                               \
     } while (0)
+#elif INTERNAL_EVENT_TRACE_ENABLE
+#define __INTERNAL_EVENT_PUSH(EVENT_TYPE, ADDATA, PACKET_SIZE, P_PACKET)   \
+    internal_event_trace_push((EVENT_TYPE), INTERNAL_EVENT_TRACE_PHASE_INSTANT, (ADDATA), (PACKET_SIZE))
 #else
 #define __INTERNAL_EVENT_PUSH(...)
 
 #endif  /* defined(INTERNAL_EVT_ENABLE) */
+
+/**
+ * Marks the start and end of a processing span in the trace.
+ *
+ * @param[in] EVENT_TYPE  Type of the span.
+ * @param[in] STATE       State information at the end of the span.
+ */
+#if INTERNAL_EVENT_TRACE_ENABLE
+#define __INTERNAL_EVENT_SPAN_BEGIN(EVENT_TYPE) \
+    internal_event_trace_push((EVENT_TYPE), INTERNAL_EVENT_TRACE_PHASE_BEGIN, 0, 0)
+#define __INTERNAL_EVENT_SPAN_END(EVENT_TYPE, STATE) \
+    internal_event_trace_push((EVENT_TYPE), INTERNAL_EVENT_TRACE_PHASE_END, (STATE), 0)
+#else
+#define __INTERNAL_EVENT_SPAN_BEGIN(...)
+#define __INTERNAL_EVENT_SPAN_END(...)
+#endif  /* INTERNAL_EVENT_TRACE_ENABLE */
 /** @} */
 #endif  /* INTERNAL_EVENT_H__ */
@@ -68,6 +68,11 @@
  *   [Python Log Viewer](https://pythonhosted.org/logview).
  * * **Standard output**: Provides output to `stdout` when running on host. This is
  *   used when `log_callback_stdout` is passed to `__LOG_INIT()`.
+ * * **Deferred**: stores a compact binary record per log call instead of formatting
+ *   the message, see @ref log_callback_deferred(). The records are read out with
+ *   `log_deferred_read()` and rendered on the host by
+ *   `tools/log_decode/log_decode.py`. This is used when `log_callback_deferred` is
+ *   passed to `__LOG_INIT()` and @ref LOG_ENABLE_DEFERRED is set.
  * @{
  */
 
@@ -165,6 +170,59 @@ void log_callback_stdout(uint32_t dbg_level, const char * p_filename, uint16_t l
     uint32_t timestamp, const char * format, va_list arguments);
 #endif
 
+#if LOG_ENABLE_DEFERRED
+/**
+ * @defgroup LOG_DEFERRED Deferred log record format
+ * A deferred log record is a sequence of little endian 32-bit words:
+ * * Header: bits 0-7 record length in words, bits 8-9 record type, bits 10-11 number of
+ *   padding bytes after the arguments, bits 12-15 log level, bits 16-31 line number.
+ * * Timestamp, as given by log_timestamp_get().
+ * * Address of the format string, or of the message string for hex dumps.
+ * * Address of the file name string.
+ * * Arguments, in the order of the format string conversions: 4 bytes for @c int sized
+ *   conversions, 8 bytes for @c long, @c long @c long, @c size_t, pointer and floating
+ *   point conversions, and a length byte followed by at most @ref LOG_DEFERRED_STRING_LEN_MAX
+ *   characters for strings. A hex dump stores the dumped length as one byte, followed by
+ *   the array bytes.
+ *
+ * A drop record consists of the header and the number of records dropped since the last
+ * read. The string addresses are resolved from the firmware image by the host decoder.
+ * @{
+ */
+
+#define LOG_DEFERRED_RECORD_TYPE_PRINTF  (0) /**< printf-style log record. */
+#define LOG_DEFERRED_RECORD_TYPE_HEXDUMP (1) /**< Hex dump record, from @ref __LOG_XB. */
+#define LOG_DEFERRED_RECORD_TYPE_DROP    (2) /**< Count of records dropped on a full buffer. */
+
+/** @} */
+
+/**
+ * Callback function storing deferred binary log records.
+ *
+ * The message is not formatted. The callback copies the timestamp, the string addresses and
+ * the raw arguments into a record buffer of @ref LOG_DEFERRED_BUFFER_SIZE bytes, which makes
+ * it cheap enough to log from time critical code. Records that do not fit in the buffer are
+ * dropped and counted.
+ */
+void log_callback_deferred(uint32_t dbg_level, const char * p_filename, uint16_t line,
+    uint32_t timestamp, const char * format, va_list arguments);
+
+/**
+ * Reads complete deferred log records.
+ *
+ * Only whole records are read, and the read records are freed from the record buffer. The
+ * function must not be called from more than one context at a time, and is meant to be called
+ * from the main loop to pass the records on over RTT or UART.
+ *
+ * @param[out] p_buffer Buffer to copy the records into.
+ * @param[in]  length   Length of the buffer in bytes, should fit the largest record of
+ *                      16 + @ref LOG_DEFERRED_ARGS_SIZE_MAX bytes.
+ *
+ * @return Number of bytes copied into @p p_buffer.
+ */
+uint32_t log_deferred_read(uint8_t * p_buffer, uint32_t length);
+#endif
+
 /**
  * Initializes the logging module.
  *
@@ -243,6 +301,21 @@ void __attribute((format(printf, 5, 6))) log_printf(
 void log_vprintf(uint32_t dbg_level, const char * p_filename, uint16_t line, uint32_t timestamp,
     const char * format, va_list arguments);
 
+/**
+ * Prints an array with a message.
+ * This function is used by the @ref __LOG_XB macro.
+ *
+ * @param[in] dbg_level    The debugging level to print the message as.
+ * @param[in] p_filename   Name of the file in which the log call originated.
+ * @param[in] line         Line number for where the log function was called.
+ * @param[in] timestamp    Timestamp for when the log function was called.
+ * @param[in] p_msg        Message string.
+ * @param[in] p_array      Pointer to array.
+ * @param[in] array_len    Length of array (in bytes), at most @ref LOG_ARRAY_LEN_MAX bytes are printed.
+ */
+void log_xb_printf(uint32_t dbg_level, const char * p_filename, uint16_t line, uint32_t timestamp,
+    const char * p_msg, const uint8_t * p_array, uint32_t array_len);
+
 /**
  * Initializes the logging framework.
  * @param[in] msk      Log mask
@@ -274,18 +347,8 @@ void log_vprintf(uint32_t dbg_level, const char * p_filename, uint16_t line, uin
 #define __LOG_XB(source, level, msg, array, array_len)                      \
     if ((source & g_log_dbg_msk) && (level <= g_log_dbg_lvl))               \
     {                                                                       \
-        unsigned _array_len = array_len;                                    \
-        _array_len = MIN(_array_len, LOG_ARRAY_LEN_MAX);                    \
-        char array_text[LOG_ARRAY_LEN_MAX * 2 + 1];                         \
-        for(unsigned _i = 0; _i < _array_len; ++_i)                         \
-        {                                                                   \
-            extern const char * g_log_hex_digits;                           \
-            const uint8_t array_elem = (array)[_i];                         \
-            array_text[_i * 2] = g_log_hex_digits[(array_elem >> 4) & 0xf]; \
-            array_text[_i * 2 + 1] = g_log_hex_digits[array_elem & 0xf];    \
-        }                                                                   \
-        array_text[_array_len * 2] = 0;                                     \
-        log_printf(level, __FILENAME__, __LINE__, log_timestamp_get(), "%s: %s\n", msg, array_text); \
+        log_xb_printf(level, __FILENAME__, __LINE__, log_timestamp_get(),   \
+                      msg, (const uint8_t *) (array), array_len);           \
     }
 
 #else
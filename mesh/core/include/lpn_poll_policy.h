@@ -0,0 +1,106 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LPN_POLL_POLICY_H__
+#define LPN_POLL_POLICY_H__
+
+#include <stdint.h>
+
+/**
+ * @internal
+ * @defgroup LPN_POLL_POLICY LPN poll policy
+ * Picks the interval between two polling sessions of the Low Power node.
+ *
+ * A polling session starts with a Friend Poll and lasts until the Friend replies with a Friend
+ * Update with the MD field set to 0. Within a session, the LPN keeps polling every
+ * @ref MESH_LPN_POLL_SEPARATION_INTERVAL_MS. Once the session is finished, the next one starts after
+ * the shortest interval if the session delivered any data, and after twice the previous interval if
+ * the Friend Queue was empty, never exceeding the longest interval.
+ * @{
+ */
+
+/** Poll policy state. */
+typedef struct
+{
+    /** Interval until the next polling session. */
+    uint32_t interval_ms;
+    /** Interval used after a session that delivered data. */
+    uint32_t interval_min_ms;
+    /** Longest interval, the interval is fixed to it if it is below @p interval_min_ms. */
+    uint32_t interval_max_ms;
+    /** Number of replies to Friend Polls in the ongoing session. */
+    uint32_t rx_count;
+} lpn_poll_policy_t;
+
+/**
+ * Initializes the poll policy and starts with the shortest interval.
+ *
+ * @param[out] p_policy        Policy to initialize.
+ * @param[in]  interval_min_ms Interval used after a session that delivered data.
+ * @param[in]  interval_max_ms Longest interval between two sessions.
+ */
+void lpn_poll_policy_init(lpn_poll_policy_t * p_policy, uint32_t interval_min_ms, uint32_t interval_max_ms);
+
+/**
+ * Changes the longest interval between two sessions.
+ *
+ * @param[in,out] p_policy        Policy to update.
+ * @param[in]     interval_max_ms Longest interval between two sessions.
+ */
+void lpn_poll_policy_max_set(lpn_poll_policy_t * p_policy, uint32_t interval_max_ms);
+
+/**
+ * Counts a reply to a Friend Poll in the ongoing session.
+ *
+ * @param[in,out] p_policy Policy to update.
+ */
+void lpn_poll_policy_rx(lpn_poll_policy_t * p_policy);
+
+/**
+ * Finishes the ongoing session.
+ *
+ * A session with a single reply only got the final Friend Update, and found the Friend Queue empty.
+ *
+ * @param[in,out] p_policy Policy to update.
+ *
+ * @returns Interval until the next polling session.
+ */
+uint32_t lpn_poll_policy_session_end(lpn_poll_policy_t * p_policy);
+
+/** @} */
+
+#endif /* LPN_POLL_POLICY_H__ */
@@ -39,6 +39,7 @@
 #define MESH_LPN_INTERNAL_H__
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "transport.h"
 #include "net_packet.h"
 
@@ -91,6 +92,18 @@ uint32_t mesh_lpn_subman_add(uint16_t address);
  */
 uint32_t mesh_lpn_subman_remove(uint16_t address);
 
+/**
+ * Builds the Subscription List Add/Remove message pushed with @ref mesh_lpn_subman_data_push.
+ *
+ * The LPN calls this right before sending the message, so that the additions and removals made in
+ * the meantime are coalesced into it. Calling it again for the same message has no effect.
+ *
+ * @retval true  The message is ready to be sent.
+ * @retval false The pending changes cancelled each other out, and the message has been cleared
+ *               with @ref mesh_lpn_subman_data_clear.
+ */
+bool mesh_lpn_subman_data_prepare(void);
+
 /**
  * @} end of MESH_LPN_INTERNAL_SUBMAN
  */
@@ -115,7 +128,8 @@ uint32_t mesh_lpn_subman_remove(uint16_t address);
  * @param[in] p_trs_ctrl_pkt    Pointer to the transport_control_packet_t structure with the following
  *                              members populated: @ref transport_control_packet_t::opcode,
  *                              @ref transport_control_packet_t::p_data, and
- *                              @ref transport_control_packet_t::data_len
+ *                              @ref transport_control_packet_t::data_len, or set to be populated by
+ *                              @ref mesh_lpn_subman_data_prepare before the message is sent.
  *
  */
 void mesh_lpn_subman_data_push(transport_control_packet_t * p_trs_ctrl_pkt);
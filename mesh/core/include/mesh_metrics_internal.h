@@ -0,0 +1,84 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MESH_METRICS_INTERNAL_H__
+#define MESH_METRICS_INTERNAL_H__
+
+#include <stdint.h>
+#include "mesh_metrics.h"
+#include "timer.h"
+
+/**
+ * @internal
+ * @defgroup MESH_METRICS_INTERNAL Packet pipeline metrics internal API
+ * @ingroup MESH_METRICS
+ * Recording interface for the stack layers. The macros compile to nothing when
+ * @ref MESH_METRICS_ENABLE is 0.
+ * @{
+ */
+
+#if MESH_METRICS_ENABLE
+/** Increments a pipeline counter. */
+#define __MESH_METRICS_COUNT(COUNTER) mesh_metrics_count(COUNTER)
+/** Declares a local variable holding the start time of a histogram sample. */
+#define __MESH_METRICS_TIME_START(NAME) const timestamp_t NAME = timer_now()
+/** Records the time since @p START in a histogram. */
+#define __MESH_METRICS_TIME_END(HISTOGRAM, START) mesh_metrics_latency_add(HISTOGRAM, TIMER_DIFF(timer_now(), START))
+#else
+#define __MESH_METRICS_COUNT(COUNTER)
+#define __MESH_METRICS_TIME_START(NAME)
+#define __MESH_METRICS_TIME_END(HISTOGRAM, START)
+#endif
+
+/**
+ * Increments a pipeline counter.
+ *
+ * @param[in] counter Counter to increment.
+ */
+void mesh_metrics_count(mesh_metrics_counter_t counter);
+
+/**
+ * Adds a sample to a latency histogram.
+ *
+ * @param[in] histogram  Histogram to add the sample to.
+ * @param[in] latency_us Sample, in microseconds.
+ */
+void mesh_metrics_latency_add(mesh_metrics_histogram_t histogram, uint32_t latency_us);
+
+/** @} end of MESH_METRICS_INTERNAL */
+
+#endif /* MESH_METRICS_INTERNAL_H__ */
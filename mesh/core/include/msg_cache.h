@@ -75,6 +75,28 @@ bool msg_cache_entry_exists(uint16_t src_addr, uint32_t sequence_number);
  */
 void msg_cache_entry_add(uint16_t src, uint32_t seq);
 
+/**
+ * Check whether the given encrypted network PDU already exists in the message cache.
+ *
+ * The PDU is looked up on a fingerprint of its obfuscated contents and its IVI and NID octet, so
+ * that exact copies can be dropped before the network header is deobfuscated and decrypted.
+ *
+ * @param[in] p_pdu   Encrypted network PDU, as received from the bearer.
+ * @param[in] pdu_len Length of the network PDU.
+ *
+ * @return Returns @c true if the specified PDU is in the message cache,
+ *         or @c false otherwise.
+ */
+bool msg_cache_pdu_exists(const uint8_t * p_pdu, uint32_t pdu_len);
+
+/**
+ * Add the fingerprint of the given encrypted network PDU to the message cache.
+ *
+ * @param[in] p_pdu   Encrypted network PDU, as received from the bearer.
+ * @param[in] pdu_len Length of the network PDU.
+ */
+void msg_cache_pdu_add(const uint8_t * p_pdu, uint32_t pdu_len);
+
 /**
  * Clears all entries from the message cache.
  */
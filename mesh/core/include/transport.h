@@ -213,6 +213,40 @@ uint32_t transport_addr_to_short(nrf_mesh_address_t * p_addr, uint16_t * p_short
  */
 uint32_t transport_tx(const nrf_mesh_tx_params_t * p_params, uint32_t * const p_packet_reference);
 
+/**
+ * Reserves an unsegmented access packet in the network buffer, for the caller to fill in place.
+ *
+ * The caller writes @c p_params->data_len bytes of upper transport payload to the returned
+ * location, and passes the packet on with @ref transport_tx_commit, which encrypts the payload in
+ * place. The @c p_data field of @p p_params is ignored. Only one reservation can be outstanding at
+ * a time, and it must be committed or discarded before returning to the mesh event loop.
+ *
+ * @param[in]  p_params   Message parameters.
+ * @param[out] pp_payload Returns a pointer to where the upper transport payload should be written.
+ *
+ * @retval NRF_SUCCESS              The packet was successfully reserved.
+ * @retval NRF_ERROR_NULL           Null-pointer supplied.
+ * @retval NRF_ERROR_BUSY           Another reservation is outstanding.
+ * @retval NRF_ERROR_INVALID_LENGTH The packet must be segmented, use @ref transport_tx instead.
+ * @retval NRF_ERROR_INVALID_ADDR   Invalid address supplied.
+ * @retval NRF_ERROR_INVALID_PARAM  One or more of the given parameters are out of bounds.
+ * @retval NRF_ERROR_NO_MEM         Insufficient amount of available memory.
+ * @retval NRF_ERROR_FORBIDDEN      Failed to allocate a sequence number from network.
+ */
+uint32_t transport_tx_reserve(const nrf_mesh_tx_params_t * p_params, uint8_t ** pp_payload);
+
+/**
+ * Encrypts the packet reserved with @ref transport_tx_reserve in place and sends it.
+ */
+void transport_tx_commit(void);
+
+/**
+ * Releases the packet reserved with @ref transport_tx_reserve without sending it.
+ *
+ * @note The sequence number allocated for the packet is not reused.
+ */
+void transport_tx_discard(void);
+
 /**
  * Transmit a transport control message.
  *
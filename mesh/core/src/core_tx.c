@@ -40,6 +40,7 @@
 #include "nordic_common.h"
 #include "list.h"
 #include "log.h"
+#include "mesh_metrics_internal.h"
 
 NRF_MESH_STATIC_ASSERT(sizeof(core_tx_bearer_bitmap_t) * 8 >= CORE_TX_BEARER_COUNT_MAX);
 /*****************************************************************************
@@ -134,9 +135,14 @@ core_tx_bearer_bitmap_t core_tx_packet_alloc(const core_tx_alloc_params_t * p_pa
 
     if (m_packet.bearer_bitmap != 0)
     {
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TX_ALLOCATED);
         m_packet.length = p_params->net_packet_len;
         *pp_packet = m_packet.buffer.pdu;
     }
+    else
+    {
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TX_ALLOC_FAILED);
+    }
     return m_packet.bearer_bitmap;
 }
 
@@ -159,6 +165,7 @@ void core_tx_packet_send(void)
 void core_tx_packet_discard(void)
 {
     NRF_MESH_ASSERT(m_packet.bearer_bitmap != 0);
+    __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TX_DISCARDED);
 
     LIST_FOREACH(p_iterator, mp_bearers)
     {
@@ -198,6 +205,7 @@ void core_tx_complete(core_tx_bearer_t * p_bearer,
                       nrf_mesh_tx_token_t token)
 {
     NRF_MESH_ASSERT(p_bearer);
+    __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TX_COMPLETE);
 
     if (m_tx_complete_callback)
     {
@@ -36,10 +36,111 @@
  */
 #include <string.h>
 #include "internal_event.h"
+#include "toolchain.h"
+#include "timer.h"
+#if !defined(HOST)
+#include "nrf.h"
+#endif
 
 /* The internal_event_type_t must fit inside a single byte, to make sure it can go into a packet. */
 NRF_MESH_STATIC_ASSERT(INTERNAL_EVENT__LAST <= 0xFF);
 
+#if INTERNAL_EVENT_TRACE_ENABLE
+
+NRF_MESH_STATIC_ASSERT(IS_POWER_OF_2(INTERNAL_EVENT_BUFFER_SIZE));
+
+/* Trace records are pushed from several interrupt priorities, each record is written with interrupts
+ * masked. The reader only moves the tail, and copies records out without masking interrupts. */
+static struct
+{
+    internal_event_trace_record_t records[INTERNAL_EVENT_BUFFER_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    uint32_t dropped;
+    bool enabled;
+} m_trace;
+
+static inline uint32_t trace_timestamp_get(void)
+{
+#if defined(NRF52_SERIES) && !defined(HOST)
+    return DWT->CYCCNT;
+#else
+    return timer_now();
+#endif
+}
+
+void internal_event_trace_enable(bool enable)
+{
+#if defined(NRF52_SERIES) && !defined(HOST)
+    if (enable)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+    m_trace.enabled = enable;
+}
+
+void internal_event_trace_push(internal_event_type_t type, internal_event_trace_phase_t phase,
+                               uint8_t state, uint8_t packet_size)
+{
+    if (!m_trace.enabled)
+    {
+        return;
+    }
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    if (m_trace.head - m_trace.tail < INTERNAL_EVENT_BUFFER_SIZE)
+    {
+        internal_event_trace_record_t * p_record = &m_trace.records[m_trace.head & (INTERNAL_EVENT_BUFFER_SIZE - 1)];
+        p_record->timestamp = trace_timestamp_get();
+        p_record->type = type;
+        p_record->phase = phase;
+        p_record->state = state;
+        p_record->packet_size = packet_size;
+        m_trace.head++;
+    }
+    else
+    {
+        m_trace.dropped++;
+    }
+    _ENABLE_IRQS(was_masked);
+}
+
+uint32_t internal_event_trace_read(internal_event_trace_record_t * p_records, uint32_t max_count, uint32_t * p_dropped)
+{
+    NRF_MESH_ASSERT(p_records != NULL && p_dropped != NULL);
+
+    uint32_t tail = m_trace.tail;
+    uint32_t count = MIN(m_trace.head - tail, max_count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        p_records[i] = m_trace.records[(tail + i) & (INTERNAL_EVENT_BUFFER_SIZE - 1)];
+    }
+    m_trace.tail = tail + count;
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    *p_dropped = m_trace.dropped;
+    m_trace.dropped = 0;
+    _ENABLE_IRQS(was_masked);
+
+    return count;
+}
+
+uint32_t internal_event_trace_timestamp_hz_get(void)
+{
+#if defined(NRF52_SERIES) && !defined(HOST)
+    return SystemCoreClock;
+#else
+    return 1000000;
+#endif
+}
+
+#endif  /* INTERNAL_EVENT_TRACE_ENABLE */
+
 #if INTERNAL_EVT_ENABLE
 
 static internal_event_report_cb_t m_report_cb;
@@ -56,6 +157,11 @@ void internal_event_init(internal_event_report_cb_t report_cb)
 uint32_t internal_event_push(internal_event_t * p_event)
 {
     uint32_t status;
+
+#if INTERNAL_EVENT_TRACE_ENABLE
+    internal_event_trace_push(p_event->type, INTERNAL_EVENT_TRACE_PHASE_INSTANT, p_event->state.value, p_event->packet_size);
+#endif
+
     if (m_internal_event_initialized == false)
     {
         status = NRF_ERROR_NOT_SUPPORTED;
@@ -42,6 +42,12 @@
 #if defined(HOST)
 #include <stdio.h>
 #endif
+#if LOG_ENABLE_DEFERRED
+#include <stdbool.h>
+#include <string.h>
+#include "toolchain.h"
+#include "nrf_mesh_assert.h"
+#endif
 
 #if NRF_MESH_LOG_ENABLE
 
@@ -83,6 +89,348 @@ void log_callback_stdout(uint32_t dbg_level, const char * p_filename, uint16_t l
 }
 #endif
 
+#if LOG_ENABLE_DEFERRED
+/* Deferred records live in a ring of words. A record is reserved with interrupts masked for a
+ * handful of instructions, filled outside of the critical section, and committed by writing its
+ * non-zero header last. The reader copies committed records in order and zeroes the freed words,
+ * so an uncommitted record reads as a zero header and holds back the records behind it. */
+
+#define RECORD_HEADER_WORDS     (4)
+#define RECORD_LEN_WORDS_MAX    (0xFF)
+#define RECORD_TYPE_PAD         (3)
+#define RING_WORDS              (LOG_DEFERRED_BUFFER_SIZE / sizeof(uint32_t))
+#define RING_MASK               (RING_WORDS - 1)
+
+#if defined(HOST)
+#define LOG_MEMORY_BARRIER()    __sync_synchronize()
+#else
+#define LOG_MEMORY_BARRIER()    __DMB()
+#endif
+
+NRF_MESH_STATIC_ASSERT((LOG_DEFERRED_BUFFER_SIZE & (LOG_DEFERRED_BUFFER_SIZE - 1)) == 0);
+NRF_MESH_STATIC_ASSERT(LOG_DEFERRED_BUFFER_SIZE >= 4 * (RECORD_HEADER_WORDS * sizeof(uint32_t) + LOG_DEFERRED_ARGS_SIZE_MAX));
+NRF_MESH_STATIC_ASSERT(RECORD_HEADER_WORDS + (LOG_DEFERRED_ARGS_SIZE_MAX + 3) / 4 <= RECORD_LEN_WORDS_MAX);
+NRF_MESH_STATIC_ASSERT(LOG_DEFERRED_STRING_LEN_MAX <= UINT8_MAX);
+
+static uint32_t m_ring[RING_WORDS];
+static volatile uint32_t m_ring_head;
+static volatile uint32_t m_ring_tail;
+static volatile uint32_t m_ring_dropped;
+
+static inline uint32_t record_header(uint32_t len_words, uint32_t type, uint32_t padding,
+                                     uint32_t dbg_level, uint16_t line)
+{
+    return len_words | (type << 8) | (padding << 10) | ((dbg_level & 0x0F) << 12) | ((uint32_t) line << 16);
+}
+
+static uint32_t * ring_reserve(uint32_t len_words)
+{
+    uint32_t * p_record = NULL;
+    uint32_t was_masked;
+
+    _DISABLE_IRQS(was_masked);
+    uint32_t head = m_ring_head;
+    uint32_t free_words = RING_WORDS - (head - m_ring_tail);
+    uint32_t contiguous = RING_WORDS - (head & RING_MASK);
+
+    if (contiguous < len_words && free_words >= contiguous + len_words)
+    {
+        /* Records are contiguous, skip the end of the ring. */
+        m_ring[head & RING_MASK] = record_header(0, RECORD_TYPE_PAD, 0, 0, 0);
+        head += contiguous;
+        free_words -= contiguous;
+        contiguous = RING_WORDS;
+    }
+
+    if (len_words <= contiguous && len_words <= free_words)
+    {
+        p_record = &m_ring[head & RING_MASK];
+        m_ring_head = head + len_words;
+    }
+    else
+    {
+        m_ring_dropped++;
+    }
+    _ENABLE_IRQS(was_masked);
+
+    return p_record;
+}
+
+static void record_store(uint32_t type, uint32_t dbg_level, const char * p_filename, uint16_t line,
+    uint32_t timestamp, const char * p_string, const uint8_t * p_args, uint32_t args_len)
+{
+    uint32_t len_words = RECORD_HEADER_WORDS + (args_len + 3) / 4;
+    uint32_t * p_record = ring_reserve(len_words);
+    if (p_record == NULL)
+    {
+        return;
+    }
+
+    p_record[1] = timestamp;
+    p_record[2] = (uint32_t) (uintptr_t) p_string;
+    p_record[3] = (uint32_t) (uintptr_t) p_filename;
+    memcpy(&p_record[RECORD_HEADER_WORDS], p_args, args_len);
+
+    uint32_t padding = (len_words - RECORD_HEADER_WORDS) * sizeof(uint32_t) - args_len;
+    LOG_MEMORY_BARRIER();
+    *(volatile uint32_t *) p_record = record_header(len_words, type, padding, dbg_level, line);
+}
+
+static bool arg_put(uint8_t * p_args, uint32_t * p_args_len, const void * p_value, uint32_t size)
+{
+    if (*p_args_len + size > LOG_DEFERRED_ARGS_SIZE_MAX)
+    {
+        return false;
+    }
+    memcpy(&p_args[*p_args_len], p_value, size);
+    *p_args_len += size;
+    return true;
+}
+
+static bool string_arg_put(uint8_t * p_args, uint32_t * p_args_len, const char * p_string)
+{
+    if (p_string == NULL)
+    {
+        p_string = "(null)";
+    }
+
+    uint8_t length = 0;
+    while (length < LOG_DEFERRED_STRING_LEN_MAX && p_string[length] != '\0')
+    {
+        length++;
+    }
+
+    if (*p_args_len + 1 + length > LOG_DEFERRED_ARGS_SIZE_MAX)
+    {
+        return false;
+    }
+
+    p_args[(*p_args_len)++] = length;
+    return arg_put(p_args, p_args_len, p_string, length);
+}
+
+/* Walks the conversions of the format string and stores their raw arguments. Stops at the first
+ * argument that does not fit, the decoder marks the missing arguments. */
+static uint32_t args_store(uint8_t * p_args, const char * p_format, va_list * p_arguments)
+{
+    uint32_t args_len = 0;
+    bool fits = true;
+
+    while (fits && *p_format != '\0')
+    {
+        if (*p_format++ != '%')
+        {
+            continue;
+        }
+
+        while (*p_format != '\0' && strchr("-+ #0", *p_format) != NULL)
+        {
+            p_format++;
+        }
+
+        /* Width and precision, either of which may be given as an argument. */
+        for (uint32_t i = 0; i < 2 && fits; ++i)
+        {
+            if (i == 1)
+            {
+                if (*p_format != '.')
+                {
+                    break;
+                }
+                p_format++;
+            }
+
+            if (*p_format == '*')
+            {
+                int value = va_arg(*p_arguments, int);
+                fits = arg_put(p_args, &args_len, &value, sizeof(value));
+                p_format++;
+            }
+            while (*p_format >= '0' && *p_format <= '9')
+            {
+                p_format++;
+            }
+        }
+
+        char length = '\0';
+        while (*p_format != '\0' && strchr("hljztL", *p_format) != NULL)
+        {
+            /* "ll" is stored as 'q' */
+            length = (length == 'l' && *p_format == 'l') ? 'q' : *p_format;
+            p_format++;
+        }
+
+        switch (*p_format)
+        {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            {
+                bool is_signed = (*p_format == 'd' || *p_format == 'i');
+                if (length == '\0' || length == 'h')
+                {
+                    int32_t value = va_arg(*p_arguments, int);
+                    fits = arg_put(p_args, &args_len, &value, sizeof(value));
+                }
+                else
+                {
+                    int64_t value;
+                    switch (length)
+                    {
+                        case 'l':
+                            value = is_signed ? (int64_t) va_arg(*p_arguments, long) : (int64_t) va_arg(*p_arguments, unsigned long);
+                            break;
+                        case 'j':
+                            value = (int64_t) va_arg(*p_arguments, intmax_t);
+                            break;
+                        case 'z':
+                            value = (int64_t) va_arg(*p_arguments, size_t);
+                            break;
+                        case 't':
+                            value = (int64_t) va_arg(*p_arguments, ptrdiff_t);
+                            break;
+                        default:
+                            value = (int64_t) va_arg(*p_arguments, long long);
+                            break;
+                    }
+                    fits = arg_put(p_args, &args_len, &value, sizeof(value));
+                }
+                break;
+            }
+
+            case 'c':
+            {
+                int32_t value = va_arg(*p_arguments, int);
+                fits = arg_put(p_args, &args_len, &value, sizeof(value));
+                break;
+            }
+
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+            {
+                double value = (length == 'L') ? (double) va_arg(*p_arguments, long double) : va_arg(*p_arguments, double);
+                fits = arg_put(p_args, &args_len, &value, sizeof(value));
+                break;
+            }
+
+            case 's':
+                fits = string_arg_put(p_args, &args_len, va_arg(*p_arguments, const char *));
+                break;
+
+            case 'p':
+            {
+                uint64_t value = (uintptr_t) va_arg(*p_arguments, void *);
+                fits = arg_put(p_args, &args_len, &value, sizeof(value));
+                break;
+            }
+
+            case 'n':
+                (void) va_arg(*p_arguments, void *);
+                break;
+
+            case '%':
+                break;
+
+            default:
+                /* Unknown conversion, the remaining arguments cannot be walked. */
+                return args_len;
+        }
+        p_format++;
+    }
+
+    return args_len;
+}
+
+void log_callback_deferred(uint32_t dbg_level, const char * p_filename, uint16_t line,
+    uint32_t timestamp, const char * format, va_list arguments)
+{
+    uint8_t args[LOG_DEFERRED_ARGS_SIZE_MAX];
+    va_list arguments_copy;
+
+    va_copy(arguments_copy, arguments);
+    uint32_t args_len = args_store(args, format, &arguments_copy);
+    va_end(arguments_copy);
+
+    record_store(LOG_DEFERRED_RECORD_TYPE_PRINTF, dbg_level, p_filename, line, timestamp, format, args, args_len);
+}
+
+static void log_deferred_hexdump(uint32_t dbg_level, const char * p_filename, uint16_t line,
+    uint32_t timestamp, const char * p_msg, const uint8_t * p_array, uint32_t array_len)
+{
+    uint8_t args[LOG_DEFERRED_ARGS_SIZE_MAX];
+    uint32_t stored_len = MIN(array_len, LOG_DEFERRED_ARGS_SIZE_MAX - 1);
+
+    args[0] = (uint8_t) array_len;
+    memcpy(&args[1], p_array, stored_len);
+
+    record_store(LOG_DEFERRED_RECORD_TYPE_HEXDUMP, dbg_level, p_filename, line, timestamp, p_msg, args, stored_len + 1);
+}
+
+uint32_t log_deferred_read(uint8_t * p_buffer, uint32_t length)
+{
+    uint32_t count = 0;
+
+    if (m_ring_dropped > 0 && length >= 2 * sizeof(uint32_t))
+    {
+        uint32_t was_masked;
+        uint32_t drop_record[2];
+
+        _DISABLE_IRQS(was_masked);
+        drop_record[1] = m_ring_dropped;
+        m_ring_dropped = 0;
+        _ENABLE_IRQS(was_masked);
+
+        drop_record[0] = record_header(ARRAY_SIZE(drop_record), LOG_DEFERRED_RECORD_TYPE_DROP, 0, 0, 0);
+        memcpy(p_buffer, drop_record, sizeof(drop_record));
+        count = sizeof(drop_record);
+    }
+
+    uint32_t tail = m_ring_tail;
+    while (tail != m_ring_head)
+    {
+        uint32_t * p_record = &m_ring[tail & RING_MASK];
+        uint32_t header = *(volatile uint32_t *) p_record;
+        uint32_t len_words;
+
+        if (header == 0)
+        {
+            /* Reserved, but not committed yet. */
+            break;
+        }
+        else if (((header >> 8) & 0x03) == RECORD_TYPE_PAD)
+        {
+            len_words = RING_WORDS - (tail & RING_MASK);
+        }
+        else
+        {
+            len_words = header & RECORD_LEN_WORDS_MAX;
+            if (count + len_words * sizeof(uint32_t) > length)
+            {
+                break;
+            }
+            memcpy(&p_buffer[count], p_record, len_words * sizeof(uint32_t));
+            count += len_words * sizeof(uint32_t);
+        }
+
+        memset(p_record, 0, len_words * sizeof(uint32_t));
+        LOG_MEMORY_BARRIER();
+        tail += len_words;
+        m_ring_tail = tail;
+    }
+
+    return count;
+}
+#endif
+
 void log_init(uint32_t mask, uint32_t level, log_callback_t callback)
 {
     g_log_dbg_msk = mask;
@@ -114,4 +462,27 @@ void log_vprintf(uint32_t dbg_level, const char * p_filename, uint16_t line,
     }
 }
 
+void log_xb_printf(uint32_t dbg_level, const char * p_filename, uint16_t line, uint32_t timestamp,
+    const char * p_msg, const uint8_t * p_array, uint32_t array_len)
+{
+    array_len = MIN(array_len, LOG_ARRAY_LEN_MAX);
+
+#if LOG_ENABLE_DEFERRED
+    if (m_log_callback == log_callback_deferred)
+    {
+        log_deferred_hexdump(dbg_level, p_filename, line, timestamp, p_msg, p_array, array_len);
+        return;
+    }
+#endif
+
+    char array_text[LOG_ARRAY_LEN_MAX * 2 + 1];
+    for (uint32_t i = 0; i < array_len; ++i)
+    {
+        array_text[i * 2] = g_log_hex_digits[(p_array[i] >> 4) & 0xf];
+        array_text[i * 2 + 1] = g_log_hex_digits[p_array[i] & 0xf];
+    }
+    array_text[array_len * 2] = 0;
+    log_printf(dbg_level, p_filename, line, timestamp, "%s: %s\n", p_msg, array_text);
+}
+
 #endif
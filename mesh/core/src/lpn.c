@@ -38,6 +38,7 @@
 #include "mesh_lpn.h"
 #include "mesh_friendship_types.h"
 #include "mesh_lpn_internal.h"
+#include "lpn_poll_policy.h"
 
 #include "fsm.h"
 #include "fsm_assistant.h"
@@ -64,6 +65,13 @@
 
 #define TIMER_JITTER_US (280)
 
+#if MESH_LPN_ADAPTIVE_POLL_ENABLED
+#define POLL_INTERVAL_MIN_MS MESH_LPN_POLL_INTERVAL_MIN_MS
+#else
+/* Above any poll interval, the policy keeps polling at the interval set by the application. */
+#define POLL_INTERVAL_MIN_MS UINT32_MAX
+#endif
+
 #define FRIEND_REQUEST_RSSI_FACTOR_PACK(PKT, VAL) packet_mesh_trs_control_friend_request_rssi_factor_set(PKT, VAL)
 #define FRIEND_REQUEST_RX_WINDOW_FACTOR_PACK(PKT, VAL) packet_mesh_trs_control_friend_request_receive_window_factor_set(PKT, VAL)
 #define FRIEND_REQUEST_MIN_QUEUE_SIZE_LOG_PACK(PKT, VAL) packet_mesh_trs_control_friend_request_min_queue_size_log_set(PKT, VAL)
@@ -189,6 +197,7 @@ typedef struct
     uint8_t             poll_attempts_count;
     uint8_t             frndreq_attempts_count;
     long_timer_t        timeout_scheduler;
+    lpn_poll_policy_t   poll_policy;
     transport_control_packet_t * p_subman_data;
 } lpn_t;
 
@@ -498,7 +507,8 @@ static void a_friendship_established_notify(void * p_data)
 
     // schedule the first poll after friendship establishing
     // entry point to the regular polling
-    NRF_MESH_ERROR_CHECK(mesh_lpn_friend_poll(m_lpn.poll_interval_ms));
+    lpn_poll_policy_init(&m_lpn.poll_policy, POLL_INTERVAL_MIN_MS, m_lpn.poll_interval_ms);
+    NRF_MESH_ERROR_CHECK(mesh_lpn_friend_poll(m_lpn.poll_policy.interval_ms));
 
     evt.type = NRF_MESH_EVT_FRIENDSHIP_ESTABLISHED;
     p_establish->role = NRF_MESH_FRIENDSHIP_ROLE_LPN;
@@ -534,7 +544,7 @@ static void a_polling_finished_notify(void * p_data)
 
     // lpn fulfilled session with friend completely
     // schedule the next session and go to sleep
-    NRF_MESH_ERROR_CHECK(mesh_lpn_friend_poll(m_lpn.poll_interval_ms));
+    NRF_MESH_ERROR_CHECK(mesh_lpn_friend_poll(lpn_poll_policy_session_end(&m_lpn.poll_policy)));
 }
 
 static void a_offer_received_notify(void * p_data)
@@ -613,7 +623,7 @@ static bool g_is_subman_data(void * p_data)
 {
     (void)p_data;
 
-    return m_lpn.p_subman_data != NULL;
+    return m_lpn.p_subman_data != NULL && mesh_lpn_subman_data_prepare();
 }
 
 static bool g_is_offer_suitable(void * p_data)
@@ -998,6 +1008,7 @@ uint32_t mesh_lpn_poll_interval_set(uint32_t poll_interval_ms)
     }
 
     m_lpn.poll_interval_ms = poll_interval_ms;
+    lpn_poll_policy_max_set(&m_lpn.poll_policy, poll_interval_ms);
 
     return NRF_SUCCESS;
 }
@@ -1033,6 +1044,7 @@ void mesh_lpn_rx_notify(const network_packet_metadata_t * p_net_metadata)
     if (m_lpn.p_subman_data == NULL)
     {
         m_lpn.fsn++;
+        lpn_poll_policy_rx(&m_lpn.poll_policy);
     }
 
     fsm_transac_data_t data =
@@ -0,0 +1,94 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "lpn_poll_policy.h"
+
+#include <stddef.h>
+
+#include "nrf_mesh_assert.h"
+#include "nordic_common.h"
+
+/* The final Friend Update is the only reply in a session that found the Friend Queue empty. */
+#define EMPTY_SESSION_RX_COUNT  (1)
+
+static uint32_t interval_floor_get(const lpn_poll_policy_t * p_policy)
+{
+    return MIN(p_policy->interval_min_ms, p_policy->interval_max_ms);
+}
+
+void lpn_poll_policy_init(lpn_poll_policy_t * p_policy, uint32_t interval_min_ms, uint32_t interval_max_ms)
+{
+    NRF_MESH_ASSERT(p_policy != NULL);
+
+    p_policy->interval_min_ms = interval_min_ms;
+    p_policy->interval_max_ms = interval_max_ms;
+    p_policy->interval_ms = interval_floor_get(p_policy);
+    p_policy->rx_count = 0;
+}
+
+void lpn_poll_policy_max_set(lpn_poll_policy_t * p_policy, uint32_t interval_max_ms)
+{
+    p_policy->interval_max_ms = interval_max_ms;
+    p_policy->interval_ms = MAX(p_policy->interval_ms, interval_floor_get(p_policy));
+    p_policy->interval_ms = MIN(p_policy->interval_ms, interval_max_ms);
+}
+
+void lpn_poll_policy_rx(lpn_poll_policy_t * p_policy)
+{
+    p_policy->rx_count++;
+}
+
+uint32_t lpn_poll_policy_session_end(lpn_poll_policy_t * p_policy)
+{
+    if (p_policy->rx_count > EMPTY_SESSION_RX_COUNT)
+    {
+        /* Traffic tends to come in bursts, come back soon. */
+        p_policy->interval_ms = interval_floor_get(p_policy);
+    }
+    else if (p_policy->interval_ms > p_policy->interval_max_ms / 2)
+    {
+        p_policy->interval_ms = p_policy->interval_max_ms;
+    }
+    else
+    {
+        p_policy->interval_ms = MAX(2 * p_policy->interval_ms, interval_floor_get(p_policy));
+    }
+
+    p_policy->rx_count = 0;
+
+    return p_policy->interval_ms;
+}
@@ -72,6 +72,8 @@ static bool m_is_emergency_cache_exist;
 /* Counter of entities that are in progress with hw part. */
 static uint32_t m_entry_in_progress_cnt;
 static uint32_t m_file_in_progress_cnt;
+/* Nesting depth of entry change batches. Dirty entries are not processed while in a batch. */
+static uint32_t m_batch_depth;
 
 #if PERSISTENT_STORAGE == 0
 static bearer_event_flag_t m_bearer_event_flag;
@@ -166,6 +168,11 @@ static void dirty_entries_process(void)
         return;
     }
 
+    if (m_batch_depth != 0 && !m_is_emergency_action)
+    { /* the entries are processed at the end of the batch. */
+        return;
+    }
+
     FOR_EACH_ENTRY(p_params)
     {
         const mesh_config_file_params_t * p_file = file_params_find(p_params->p_id->file);
@@ -428,6 +435,7 @@ void mesh_config_init(void)
 {
     m_entry_in_progress_cnt = 0;
     m_file_in_progress_cnt = 0;
+    m_batch_depth = 0;
     m_is_emergency_action = false;
     m_is_emergency_cache_exist = false;
 
@@ -467,6 +475,10 @@ void mesh_config_power_down(void)
 {
     m_is_emergency_action = true;
     mesh_config_backend_power_down();
+
+    nrf_mesh_evt_t power_down_evt = {.type = NRF_MESH_EVT_CONFIG_POWER_DOWN};
+    event_handle(&power_down_evt);
+
     dirty_entries_process();
 
     if (!mesh_config_is_busy())
@@ -515,6 +527,29 @@ uint32_t mesh_config_entry_set(mesh_config_entry_id_t id, const void * p_entry)
     }
 }
 
+uint32_t mesh_config_entry_set_deferred(mesh_config_entry_id_t id, const void * p_entry)
+{
+    if (p_entry == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    const mesh_config_entry_params_t * p_params = entry_params_find(id);
+    if (p_params == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    uint32_t status = p_params->callbacks.setter(id, p_entry);
+    if (status == NRF_SUCCESS)
+    {
+        /* Not marked as dirty, the entry is stored by the next mesh_config_entry_set(). */
+        *entry_flags_get(p_params, id) |= MESH_CONFIG_ENTRY_FLAG_ACTIVE;
+    }
+
+    return status;
+}
+
 uint32_t mesh_config_entry_get(mesh_config_entry_id_t id, void * p_entry)
 {
     if (p_entry == NULL)
@@ -569,6 +604,21 @@ uint32_t mesh_config_entry_delete(mesh_config_entry_id_t id)
     return NRF_ERROR_NOT_FOUND;
 }
 
+void mesh_config_batch_begin(void)
+{
+    m_batch_depth++;
+}
+
+void mesh_config_batch_end(void)
+{
+    NRF_MESH_ASSERT(m_batch_depth > 0);
+    m_batch_depth--;
+    if (m_batch_depth == 0)
+    {
+        dirty_entries_process();
+    }
+}
+
 uint32_t mesh_config_power_down_time_get(void)
 {
     return mesh_config_backend_power_down_time_get();
@@ -49,6 +49,7 @@
 #include "msqueue.h"
 #include "bearer_handler.h"
 #include "hal.h"
+#include "internal_event.h"
 
 /*****************************************************************************
 * Local defines
@@ -292,7 +293,9 @@ static void flash_op_start(ts_timestamp_t start_time, void * p_args)
        bearer action we therefore try to execute several chunks of this operation. */
     for (;;)
     {
+        __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_FLASH_OP);
         bool operation_done = execute_next_operation_chunk(p_user, p_op, available_time - elapsed_time);
+        __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_FLASH_OP, p_op->type);
         if (operation_done)
         {
             bearer_handler_action_end();
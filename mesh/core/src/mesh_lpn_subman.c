@@ -63,6 +63,9 @@
  * - Subscription manager can handle address removals or additions only when friendship is established.
  * - Adding a duplicate address to already added/synced address results in success.
  * - Removing a non-existent address results in success.
+ * - The Subscription List Add/Remove message is built right before the LPN sends it, so that the
+ * changes made while waiting for the LPN to send it are coalesced into it. An addition and a removal
+ * of the same address that were not sent cancel each other out.
  */
 
 #define LPN_SUBMAN_PDU_RETRY_COUNT                  (2)
@@ -114,6 +117,7 @@ static transport_control_packet_t m_transport_ctrl_pkt;
 /* Module flags */
 static bool m_address_sync_in_progress;
 static bool m_established_received;
+static bool m_pdu_build_pending;
 
 /***** Internal functions *****/
 
@@ -151,6 +155,11 @@ static inline bool is_entry_for_rem(uint16_t index)
     return (m_addr_list[index].flag == SUBMAN_FLAG_REMOVE_PENDING);
 }
 
+static inline bool is_entry_add_pending(uint16_t index)
+{
+    return (m_addr_list[index].flag == SUBMAN_FLAG_ADD_PENDING);
+}
+
 static inline void mark_entry_for_add(uint16_t index)
 {
     m_addr_list[index].flag = SUBMAN_FLAG_ADD_PENDING;
@@ -217,17 +226,52 @@ static bool subman_next_pdu_create(transport_control_opcode_t opcode)
    return (packet_addr_index > 0);
 }
 
-static void pdu_send_if_not_sending_but_established(transport_control_opcode_t opcode)
+static bool subman_sync_needed(void)
 {
-    if (!m_address_sync_in_progress && m_established_received)
+    for (int32_t i = 0; i < LPN_SUBMAN_ADDRESS_LIST_SIZE; i++)
     {
-        if (subman_next_pdu_create(opcode))
+        if (entry_is_used_not_synced(i))
         {
-            m_address_sync_in_progress = true;
-            mesh_lpn_subman_data_push(&m_transport_ctrl_pkt);
-            m_pdu_retry_cnt = 0;
+            return true;
         }
     }
+
+    return false;
+}
+
+static bool subman_pdu_build(void)
+{
+    /* Always finish pending removals first, so that friend (and this module) will have space
+     * for new subscriptions.
+     */
+    return (subman_next_pdu_create(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_REMOVE) ||
+            subman_next_pdu_create(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_ADD));
+}
+
+/* Queues the next transaction, its PDU is built in mesh_lpn_subman_data_prepare(). */
+static bool subman_next_pdu_push(void)
+{
+    if (!subman_sync_needed())
+    {
+        return false;
+    }
+
+    /* Reserve the transaction number, so that a late confirm for the previous one is detected. */
+    TRANSACTION_NUMBER_SET(&m_transport_pdu, m_current_transaction_number);
+    m_address_sync_in_progress = true;
+    m_pdu_build_pending = true;
+    m_pdu_retry_cnt = 0;
+    mesh_lpn_subman_data_push(&m_transport_ctrl_pkt);
+
+    return true;
+}
+
+static void pdu_send_if_not_sending_but_established(void)
+{
+    if (!m_address_sync_in_progress && m_established_received)
+    {
+        (void) subman_next_pdu_push();
+    }
 }
 
 /* Event handler for processing friendship events. */
@@ -242,11 +286,9 @@ static void subman_lpn_event_handler(const nrf_mesh_evt_t * p_evt)
             }
 
             /* Send out first subscription add message */
-            if (m_address_sync_in_progress == false && subman_next_pdu_create(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_ADD))
+            if (m_address_sync_in_progress == false)
             {
-                m_address_sync_in_progress = true;
-                mesh_lpn_subman_data_push(&m_transport_ctrl_pkt);
-                m_pdu_retry_cnt = 0;
+                (void) subman_next_pdu_push();
             }
             m_established_received = true;
             break;
@@ -265,6 +307,7 @@ static void subman_lpn_event_handler(const nrf_mesh_evt_t * p_evt)
             m_current_transaction_number = 0;
             m_address_sync_in_progress = false;
             m_established_received = false;
+            m_pdu_build_pending = false;
             break;
 
         default:
@@ -311,22 +354,8 @@ static void subman_friend_subscription_confirm_handle(const transport_control_pa
         return;
     }
 
-    /* Always finish pending removals first, so that friend (and this module) will have space
-     * for new subscriptions.
-     */
-    bool pdu_available = subman_next_pdu_create(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_REMOVE);
-    if (!pdu_available)
-    {
-        pdu_available = subman_next_pdu_create(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_ADD);
-    }
-
     /* Send out next Subscription Add/Remove message */
-    if (pdu_available)
-    {
-        mesh_lpn_subman_data_push(&m_transport_ctrl_pkt);
-        m_pdu_retry_cnt = 0;
-    }
-    else
+    if (!subman_next_pdu_push())
     {
         m_address_sync_in_progress = false;
     }
@@ -353,7 +382,8 @@ uint32_t mesh_lpn_subman_add(uint16_t address)
     {
         if (is_entry_for_rem(index))
         {
-            mark_entry_for_add(index);
+            /* Removals are cleared once sent, the Friend still has this address. */
+            mark_entry_locked(index);
         }
 
         return NRF_SUCCESS;
@@ -364,7 +394,7 @@ uint32_t mesh_lpn_subman_add(uint16_t address)
         if (!entry_is_used(i))
         {
             entry_addr_set_for_add(i, address);
-            pdu_send_if_not_sending_but_established(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_ADD);
+            pdu_send_if_not_sending_but_established();
 
             return NRF_SUCCESS;
         }
@@ -395,13 +425,41 @@ uint32_t mesh_lpn_subman_remove(uint16_t address)
             return NRF_SUCCESS;
         }
 
+        if (is_entry_add_pending(index))
+        {
+            /* The addition has not been sent, the Friend never had this address. */
+            entry_clear_all(index);
+            return NRF_SUCCESS;
+        }
+
         mark_entry_for_rem(index);
-        pdu_send_if_not_sending_but_established(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_REMOVE);
+        pdu_send_if_not_sending_but_established();
     }
 
     return NRF_SUCCESS;
 }
 
+bool mesh_lpn_subman_data_prepare(void)
+{
+    if (!m_pdu_build_pending)
+    {
+        return true;
+    }
+
+    m_pdu_build_pending = false;
+
+    if (subman_pdu_build())
+    {
+        return true;
+    }
+
+    /* All pending changes cancelled each other out. */
+    mesh_lpn_subman_data_clear();
+    m_address_sync_in_progress = false;
+
+    return false;
+}
+
 void mesh_lpn_subman_init(void)
 {
     m_current_transaction_number = 0;
@@ -0,0 +1,181 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mesh_metrics.h"
+#include "mesh_metrics_internal.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "toolchain.h"
+#include "utils.h"
+#include "nordic_common.h"
+
+#if MESH_METRICS_ENABLE
+
+NRF_MESH_STATIC_ASSERT(MESH_METRICS_HISTOGRAM_BUCKET_COUNT > 0 && MESH_METRICS_HISTOGRAM_BUCKET_COUNT <= 32);
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+static uint32_t m_counters[MESH_METRICS_COUNTER_COUNT];
+static mesh_metrics_histogram_data_t m_histograms[MESH_METRICS_HISTOGRAM_COUNT];
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static inline void saturating_add(uint32_t * p_value, uint32_t addend)
+{
+    *p_value = (*p_value > UINT32_MAX - addend) ? UINT32_MAX : *p_value + addend;
+}
+
+static inline uint32_t bucket_get(uint32_t latency_us)
+{
+    uint32_t bucket = (latency_us == 0) ? 0 : log2_get(latency_us);
+    return MIN(bucket, MESH_METRICS_HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+/*****************************************************************************
+* Internal interface
+*****************************************************************************/
+void mesh_metrics_count(mesh_metrics_counter_t counter)
+{
+    NRF_MESH_ASSERT_DEBUG(counter < MESH_METRICS_COUNTER_COUNT);
+
+    /* The layers run at different IRQ priorities. */
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    saturating_add(&m_counters[counter], 1);
+    _ENABLE_IRQS(was_masked);
+}
+
+void mesh_metrics_latency_add(mesh_metrics_histogram_t histogram, uint32_t latency_us)
+{
+    NRF_MESH_ASSERT_DEBUG(histogram < MESH_METRICS_HISTOGRAM_COUNT);
+
+    mesh_metrics_histogram_data_t * p_histogram = &m_histograms[histogram];
+    uint32_t bucket = bucket_get(latency_us);
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    saturating_add(&p_histogram->count, 1);
+    saturating_add(&p_histogram->sum_us, latency_us);
+    saturating_add(&p_histogram->buckets[bucket], 1);
+    if (latency_us > p_histogram->max_us)
+    {
+        p_histogram->max_us = latency_us;
+    }
+    _ENABLE_IRQS(was_masked);
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+uint32_t mesh_metrics_counters_get(uint32_t * p_counters)
+{
+    if (p_counters == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    memcpy(p_counters, m_counters, sizeof(m_counters));
+    _ENABLE_IRQS(was_masked);
+    return NRF_SUCCESS;
+}
+
+uint32_t mesh_metrics_histogram_get(mesh_metrics_histogram_t histogram, mesh_metrics_histogram_data_t * p_data)
+{
+    if (p_data == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    if (histogram >= MESH_METRICS_HISTOGRAM_COUNT)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    *p_data = m_histograms[histogram];
+    _ENABLE_IRQS(was_masked);
+    return NRF_SUCCESS;
+}
+
+void mesh_metrics_clear(void)
+{
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    memset(m_counters, 0, sizeof(m_counters));
+    memset(m_histograms, 0, sizeof(m_histograms));
+    _ENABLE_IRQS(was_masked);
+}
+
+#else
+
+void mesh_metrics_count(mesh_metrics_counter_t counter)
+{
+    UNUSED_PARAMETER(counter);
+}
+
+void mesh_metrics_latency_add(mesh_metrics_histogram_t histogram, uint32_t latency_us)
+{
+    UNUSED_PARAMETER(histogram);
+    UNUSED_PARAMETER(latency_us);
+}
+
+uint32_t mesh_metrics_counters_get(uint32_t * p_counters)
+{
+    UNUSED_PARAMETER(p_counters);
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t mesh_metrics_histogram_get(mesh_metrics_histogram_t histogram, mesh_metrics_histogram_data_t * p_data)
+{
+    UNUSED_PARAMETER(histogram);
+    UNUSED_PARAMETER(p_data);
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+void mesh_metrics_clear(void)
+{
+}
+
+#endif /* MESH_METRICS_ENABLE */
@@ -41,6 +41,17 @@
 #include "nrf_error.h"
 
 #include "log.h"
+#include "nrf_mesh_assert.h"
+
+/*****************************************************************************
+* Local defines
+*****************************************************************************/
+/** FNV-1a offset basis. */
+#define PDU_FINGERPRINT_OFFSET_BASIS    (0x811C9DC5UL)
+/** FNV-1a prime. */
+#define PDU_FINGERPRINT_PRIME           (0x01000193UL)
+
+NRF_MESH_STATIC_ASSERT(MSG_CACHE_PDU_ENTRY_COUNT > 0);
 
 /*****************************************************************************
 * Local type definitions
@@ -53,6 +64,14 @@ typedef struct
     uint32_t seq;    /**< Sequence number from the packet header. */
 } msg_cache_entry_t;
 
+/** Cache entry for the network PDU cache. An entry with zero length is not in use. */
+typedef struct
+{
+    uint32_t fingerprint; /**< Hash of the complete encrypted network PDU. */
+    uint8_t ivi_nid;      /**< First octet of the network PDU, holding the IVI and NID fields. */
+    uint8_t len;          /**< Length of the network PDU. */
+} msg_cache_pdu_entry_t;
+
 /*****************************************************************************
 * Static globals
 *****************************************************************************/
@@ -62,6 +81,35 @@ static msg_cache_entry_t m_msg_cache[MSG_CACHE_ENTRY_COUNT];
 /** Message cache head index */
 static uint32_t m_msg_cache_head = 0;
 
+/** Network PDU cache buffer */
+static msg_cache_pdu_entry_t m_pdu_cache[MSG_CACHE_PDU_ENTRY_COUNT];
+
+/** Network PDU cache head index */
+static uint32_t m_pdu_cache_head = 0;
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static uint32_t pdu_fingerprint_get(const uint8_t * p_pdu, uint32_t pdu_len)
+{
+    uint32_t hash = PDU_FINGERPRINT_OFFSET_BASIS;
+    for (uint32_t i = 0; i < pdu_len; ++i)
+    {
+        hash = (hash ^ p_pdu[i]) * PDU_FINGERPRINT_PRIME;
+    }
+    return hash;
+}
+
+static void pdu_cache_clear(void)
+{
+    for (uint32_t i = 0; i < MSG_CACHE_PDU_ENTRY_COUNT; ++i)
+    {
+        m_pdu_cache[i].len = 0;
+    }
+
+    m_pdu_cache_head = 0;
+}
+
 /*****************************************************************************
 * Interface functions
 *****************************************************************************/
@@ -75,6 +123,7 @@ void msg_cache_init(void)
     }
 
     m_msg_cache_head = 0;
+    pdu_cache_clear();
 }
 
 bool msg_cache_entry_exists(uint16_t src_addr, uint32_t sequence_number)
@@ -115,11 +164,68 @@ void msg_cache_entry_add(uint16_t src, uint32_t seq)
     }
 }
 
+bool msg_cache_pdu_exists(const uint8_t * p_pdu, uint32_t pdu_len)
+{
+    NRF_MESH_ASSERT(p_pdu != NULL);
+
+    if (pdu_len == 0 || pdu_len > UINT8_MAX)
+    {
+        return false;
+    }
+
+    const uint32_t fingerprint = pdu_fingerprint_get(p_pdu, pdu_len);
+
+    /* Search backwards from head, a copy from the other bearer is most likely recent. */
+    uint32_t entry_index = m_pdu_cache_head;
+    for (uint32_t i = 0; i < MSG_CACHE_PDU_ENTRY_COUNT; ++i)
+    {
+        if (entry_index-- == 0) /* compare before subtraction */
+        {
+            entry_index = MSG_CACHE_PDU_ENTRY_COUNT - 1;
+        }
+
+        if (m_pdu_cache[entry_index].len == 0)
+        {
+            return false; /* Gone past the last valid entry. */
+        }
+
+        if (m_pdu_cache[entry_index].fingerprint == fingerprint &&
+            m_pdu_cache[entry_index].len == pdu_len &&
+            m_pdu_cache[entry_index].ivi_nid == p_pdu[0])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void msg_cache_pdu_add(const uint8_t * p_pdu, uint32_t pdu_len)
+{
+    NRF_MESH_ASSERT(p_pdu != NULL);
+
+    if (pdu_len == 0 || pdu_len > UINT8_MAX)
+    {
+        return;
+    }
+
+    m_pdu_cache[m_pdu_cache_head].fingerprint = pdu_fingerprint_get(p_pdu, pdu_len);
+    m_pdu_cache[m_pdu_cache_head].ivi_nid = p_pdu[0];
+    m_pdu_cache[m_pdu_cache_head].len = (uint8_t) pdu_len;
+
+    if ((++m_pdu_cache_head) == MSG_CACHE_PDU_ENTRY_COUNT)
+    {
+        m_pdu_cache_head = 0;
+    }
+}
+
 void msg_cache_clear(void)
 {
     for (uint32_t i = 0; i < MSG_CACHE_ENTRY_COUNT; ++i)
     {
         m_msg_cache[i].allocated = 0;
     }
+
+    pdu_cache_clear();
 }
 
@@ -36,6 +36,7 @@
  */
 #include "net_packet.h"
 #include "internal_event.h"
+#include "mesh_metrics_internal.h"
 #include "nrf_mesh_utils.h"
 #include "nrf_mesh_externs.h"
 #include "msg_cache.h"
@@ -133,6 +134,7 @@ static inline bool deobfuscated_header_is_valid(const network_packet_metadata_t
     if (msg_cache_entry_exists(p_net_metadata->src, p_net_metadata->internal.sequence_number))
     {
         __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED, PACKET_DROPPED_NETWORK_CACHE, net_packet_len, p_net_packet);
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_CACHE_DROPPED);
         return false;
     }
 
@@ -204,6 +206,7 @@ static bool try_decrypt(network_packet_metadata_t * p_net_metadata,
     p_net_metadata->p_security_material = p_secmat;
 
     header_deobfuscate(p_net_metadata, p_net_encrypted_packet, p_net_decrypted_packet);
+    __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_DEOBFUSCATED);
 
     deobfuscated_header_fields_get(p_net_metadata, p_net_decrypted_packet);
 
@@ -52,6 +52,7 @@
 #include "net_state.h"
 #include "utils.h"
 #include "internal_event.h"
+#include "mesh_metrics_internal.h"
 #include "nrf_mesh_utils.h"
 #include "nrf_mesh_externs.h"
 #include "packet_mesh.h"
@@ -167,9 +168,11 @@ static uint32_t packet_relay(network_packet_metadata_t *    p_net_metadata,
         memcpy(buffer.p_payload, p_net_payload, payload_len);
         network_packet_send(&buffer);
         __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_RELAYED, 0, payload_len, p_net_payload);
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_RELAYED);
     }
     else
     {
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_RELAY_FAILED);
         __LOG(LOG_SRC_NETWORK, LOG_LEVEL_WARN, "Unable to allocate memory for relay packet.\n");
     }
 
@@ -328,6 +331,17 @@ uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, co
     const packet_mesh_net_packet_t * p_net_packet = (const packet_mesh_net_packet_t *) p_packet;
     uint32_t status = NRF_SUCCESS;
 
+    __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_RX);
+
+    /* The same PDU is commonly heard on more than one bearer, e.g. from the advertiser and from a
+     * proxy client. Drop exact copies before spending any AES operations on them. */
+    if (msg_cache_pdu_exists(p_packet, net_packet_len))
+    {
+        __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED, PACKET_DROPPED_NETWORK_CACHE, net_packet_len, p_packet);
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_PDU_DROPPED);
+        return NRF_SUCCESS;
+    }
+
     /* Create a target buffer to decrypt into, don't have to allocate a new packet. */
     packet_mesh_net_packet_t net_decrypted_packet;
 
@@ -338,13 +352,22 @@ uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, co
 
     __LOG_XB(LOG_SRC_NETWORK, LOG_LEVEL_DBG1, "  Net RX (enc)", p_packet, net_packet_len);
     network_packet_metadata_t net_metadata;
+    __MESH_METRICS_TIME_START(decrypt_start);
+    __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_NET_DECRYPT);
     status = net_packet_decrypt(&net_metadata,
                                 net_packet_len,
                                 p_net_packet,
                                 &net_decrypted_packet,
                                 NET_PACKET_KIND_TRANSPORT);
-    if ((status == NRF_SUCCESS) && metadata_is_valid(&net_metadata))
+    __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_NET_DECRYPT, status);
+    __MESH_METRICS_TIME_END(MESH_METRICS_HISTOGRAM_NET_DECRYPT, decrypt_start);
+    if (status != NRF_SUCCESS)
+    {
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_DECRYPT_FAILED);
+    }
+    else if (metadata_is_valid(&net_metadata))
     {
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_NET_DECRYPTED);
         __LOG_XB(LOG_SRC_NETWORK, LOG_LEVEL_DBG1, "Net RX (unenc)", &net_decrypted_packet.pdu[0], net_packet_len);
         NRF_MESH_ASSERT(net_metadata.p_security_material != NULL);
 
@@ -387,12 +410,14 @@ uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, co
             if (packet_relay(&net_metadata, p_net_payload, payload_len, p_rx_metadata) == NRF_SUCCESS)
             {
                 msg_cache_entry_add(net_metadata.src, net_metadata.internal.sequence_number);
+                msg_cache_pdu_add(p_packet, net_packet_len);
             }
         }
         else
 #endif
         {
             msg_cache_entry_add(net_metadata.src, net_metadata.internal.sequence_number);
+            msg_cache_pdu_add(p_packet, net_packet_len);
         }
 
     }
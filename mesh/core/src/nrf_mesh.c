@@ -429,6 +429,21 @@ uint32_t nrf_mesh_packet_send(const nrf_mesh_tx_params_t * p_params,
     return transport_tx(p_params, p_packet_reference);
 }
 
+uint32_t nrf_mesh_packet_reserve(const nrf_mesh_tx_params_t * p_params, uint8_t ** pp_payload)
+{
+    return transport_tx_reserve(p_params, pp_payload);
+}
+
+void nrf_mesh_packet_commit(void)
+{
+    transport_tx_commit();
+}
+
+void nrf_mesh_packet_discard(void)
+{
+    transport_tx_discard();
+}
+
 bool nrf_mesh_process(void)
 {
     return bearer_event_handler();
@@ -53,6 +53,7 @@
 #include "net_state.h"
 #include "replay_cache.h"
 #include "internal_event.h"
+#include "mesh_metrics_internal.h"
 #include "timer_scheduler.h"
 #include "bearer_event.h"
 #include "toolchain.h"
@@ -223,6 +224,16 @@ typedef struct
     const transport_control_packet_handler_t * p_handlers; /**< List of opcodes and their handler functions. */
     uint32_t handler_count; /**< Number of handlers. */
 } control_packet_consumer_t;
+
+/** Unsegmented access packet reserved in place with @ref transport_tx_reserve. */
+typedef struct
+{
+    bool active;                          /**< Whether the reservation is outstanding. */
+    transport_packet_metadata_t metadata; /**< Metadata for the reserved packet. */
+    network_tx_packet_buffer_t net_buf;   /**< Network buffer holding the reserved packet. */
+    uint8_t * p_payload;                  /**< Upper transport payload inside @c net_buf. */
+    uint32_t payload_len;                 /**< Reserved payload length, excluding the MIC. */
+} trs_tx_reservation_t;
 /********************
  * Static variables *
  ********************/
@@ -240,6 +251,8 @@ static bearer_event_flag_t m_sar_process_flag;
 
 static control_packet_consumer_t m_control_packet_consumers[TRANSPORT_CONTROL_PACKET_CONSUMERS_MAX];
 static uint32_t m_control_packet_consumer_count;
+
+static trs_tx_reservation_t m_tx_reservation;
 /********************
  * Static functions *
  ********************/
@@ -863,6 +876,7 @@ static trs_sar_ctx_t * sar_rx_ctx_get(const transport_packet_metadata_t * p_meta
                                   PACKET_DROPPED_REPLAY_CACHE,
                                   sizeof(uint32_t),
                                   p_metadata->net.internal.sequence_number);
+            __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TRS_REPLAY_DROPPED);
         }
 
         return NULL;
@@ -1763,9 +1777,15 @@ static void upper_transport_access_packet_in(const uint8_t * p_upper_trs_packet,
 {
     uint8_t decrypt_buffer[TRANSPORT_SAR_PACKET_MAX_SIZE(false)]; /* 382 bytes! */
 
+    __MESH_METRICS_TIME_START(decrypt_start);
+    __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_TRS_DECRYPT);
     uint32_t status = upper_trs_packet_decrypt(p_metadata, p_upper_trs_packet, upper_trs_packet_len, decrypt_buffer);
+    __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_TRS_DECRYPT, status);
+    __MESH_METRICS_TIME_END(MESH_METRICS_HISTOGRAM_TRS_DECRYPT, decrypt_start);
     if (status == NRF_SUCCESS)
     {
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TRS_DECRYPTED);
+
         /* This message has passed all checks and can be added to the replay list. */
         if (replay_list_add(p_metadata) == NRF_SUCCESS)
         {
@@ -1793,6 +1813,7 @@ static void upper_transport_access_packet_in(const uint8_t * p_upper_trs_packet,
     else
     {
         __LOG(LOG_SRC_TRANSPORT, LOG_LEVEL_DBG2, "Could not decrypt transport layer data.\n");
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TRS_DECRYPT_FAILED);
 
         __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED,
                                 (p_metadata->type.access.using_app_key ? PACKET_DROPPED_INVALID_APPKEY
@@ -1896,6 +1917,7 @@ static uint32_t upper_transport_tx(transport_packet_metadata_t * p_metadata, con
 void transport_init(void)
 {
     memset(&m_trs_sar_sessions[0], 0, sizeof(m_trs_sar_sessions));
+    memset(&m_tx_reservation, 0, sizeof(m_tx_reservation));
 
     replay_cache_init();
 
@@ -1989,6 +2011,7 @@ uint32_t transport_packet_in(const packet_mesh_trs_packet_t * p_packet,
                                   PACKET_DROPPED_REPLAY_CACHE,
                                   sizeof(uint32_t),
                                   &p_net_metadata->internal.sequence_number);
+            __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TRS_REPLAY_DROPPED);
 
             return status;
         }
@@ -2000,6 +2023,7 @@ uint32_t transport_packet_in(const packet_mesh_trs_packet_t * p_packet,
                               PACKET_DROPPED_UNKNOWN_ADDRESS,
                               trs_packet_len,
                               p_packet);
+        __MESH_METRICS_COUNT(MESH_METRICS_COUNTER_TRS_ADDRESS_DROPPED);
         return status;
     }
 
@@ -2038,6 +2062,75 @@ uint32_t transport_tx(const nrf_mesh_tx_params_t * p_params, uint32_t * const p_
     return upper_transport_tx(&metadata, p_params->p_data, p_params->data_len);
 }
 
+uint32_t transport_tx_reserve(const nrf_mesh_tx_params_t * p_params, uint8_t ** pp_payload)
+{
+    if (p_params == NULL ||
+        pp_payload == NULL ||
+        p_params->security_material.p_app == NULL ||
+        p_params->security_material.p_net == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (m_tx_reservation.active)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    transport_metadata_from_tx_params(&m_tx_reservation.metadata, p_params);
+
+    /* Segmented packets are encrypted into the SAR buffer and resent from there, so they gain
+     * nothing from being written in place. */
+    if (m_tx_reservation.metadata.segmented ||
+        p_params->data_len + m_tx_reservation.metadata.mic_size > TRANSPORT_UNSEG_PDU_LEN(false))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    uint32_t status = transport_metadata_validate(&m_tx_reservation.metadata);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    status = upper_trs_packet_alloc(&m_tx_reservation.metadata,
+                                    &m_tx_reservation.net_buf,
+                                    p_params->data_len + m_tx_reservation.metadata.mic_size,
+                                    &m_tx_reservation.p_payload);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    trs_packet_header_build(&m_tx_reservation.metadata,
+                            (packet_mesh_trs_packet_t *) m_tx_reservation.net_buf.p_payload);
+    m_tx_reservation.payload_len = p_params->data_len;
+    m_tx_reservation.active = true;
+
+    *pp_payload = m_tx_reservation.p_payload;
+    return NRF_SUCCESS;
+}
+
+void transport_tx_commit(void)
+{
+    NRF_MESH_ASSERT(m_tx_reservation.active);
+
+    upper_trs_packet_encrypt(m_tx_reservation.p_payload,
+                             m_tx_reservation.p_payload,
+                             m_tx_reservation.payload_len,
+                             &m_tx_reservation.metadata);
+    network_packet_send(&m_tx_reservation.net_buf);
+    m_tx_reservation.active = false;
+}
+
+void transport_tx_discard(void)
+{
+    NRF_MESH_ASSERT(m_tx_reservation.active);
+
+    network_packet_discard(&m_tx_reservation.net_buf);
+    m_tx_reservation.active = false;
+}
+
 uint32_t transport_control_tx(const transport_control_packet_t * p_params, nrf_mesh_tx_token_t tx_token)
 {
     if (p_params == NULL ||
@@ -65,6 +65,26 @@
 #define NRF_MESH_DFU_DATA_TRANSFER_TIMEOUT_US           (600000000UL)
 #endif
 
+/** Number of transfers the distribution scheduler can relay at the same time. */
+#ifndef NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX
+#define NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX         (4)
+#endif
+
+/** Number of recently relayed segments kept for answering data requests, shared by all distributed transfers. */
+#ifndef NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE
+#define NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE            (32)
+#endif
+
+/** Number of packets each distributed transfer can have waiting for transmission. */
+#ifndef NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE
+#define NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE            (8)
+#endif
+
+/** Time between transmissions from the distribution scheduler. */
+#ifndef NRF_MESH_DFU_DISTRIBUTION_TX_INTERVAL_US
+#define NRF_MESH_DFU_DISTRIBUTION_TX_INTERVAL_US        (20000)
+#endif
+
 /** @} end of NRF_MESH_CONFIG_DFU */
 
 #endif  /* NRF_MESH_CONFIG_DFU_H__ */
@@ -196,6 +196,49 @@ uint32_t nrf_mesh_dfu_request(nrf_mesh_dfu_type_t type,
 uint32_t nrf_mesh_dfu_relay(nrf_mesh_dfu_type_t type,
         const nrf_mesh_fwid_t* p_fwid);
 
+/**
+ * Relay a transfer alongside the one handled by the bootloader.
+ *
+ * The bootloader relays at most one transfer at a time. Further transfers with other FWIDs, such
+ * as softdevice or bootloader images going to other devices in the same maintenance window, can
+ * be relayed by the application side distribution scheduler. The transfers share the
+ * transmissions in proportion to their priority, and data requests for recently relayed
+ * segments are answered from a cache.
+ *
+ * @note Don't add the transfer that the bootloader is relaying with @ref nrf_mesh_dfu_relay(),
+ * as it would be relayed twice.
+ *
+ * @param[in] type DFU type of the transfer.
+ * @param[in] p_fwid Firmware ID of the transfer.
+ * @param[in] priority Share of the transmissions relative to the other distributed transfers,
+ * from 1 to 16.
+ *
+ * @retval NRF_SUCCESS The transfer will be relayed once its state beacon is received.
+ * @retval NRF_ERROR_NULL The FWID pointer provided was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM The DFU type or the priority is invalid.
+ * @retval NRF_ERROR_INVALID_STATE The DFU module has not been initialized, or the transfer is
+ * already being relayed.
+ * @retval NRF_ERROR_NO_MEM @ref NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX transfers are already
+ * being relayed.
+ */
+uint32_t nrf_mesh_dfu_distribution_add(nrf_mesh_dfu_type_t type,
+        const nrf_mesh_fwid_t* p_fwid,
+        uint8_t priority);
+
+/**
+ * Stop relaying a transfer added with @ref nrf_mesh_dfu_distribution_add().
+ *
+ * @param[in] type DFU type of the transfer.
+ * @param[in] p_fwid Firmware ID of the transfer.
+ *
+ * @retval NRF_SUCCESS The transfer is no longer relayed.
+ * @retval NRF_ERROR_NULL The FWID pointer provided was NULL.
+ * @retval NRF_ERROR_INVALID_STATE The DFU module has not been initialized.
+ * @retval NRF_ERROR_NOT_FOUND The transfer wasn't being relayed.
+ */
+uint32_t nrf_mesh_dfu_distribution_remove(nrf_mesh_dfu_type_t type,
+        const nrf_mesh_fwid_t* p_fwid);
+
 /**
  * Abort the ongoing DFU operation.
  *
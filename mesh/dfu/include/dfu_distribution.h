@@ -0,0 +1,152 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef DFU_DISTRIBUTION_H__
+#define DFU_DISTRIBUTION_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_mesh_config_dfu.h"
+#include "nrf_mesh_dfu_types.h"
+#include "dfu_types_internal.h"
+
+/**
+ * @defgroup DFU_DISTRIBUTION DFU distribution scheduler
+ * @ingroup NRF_MESH_DFU
+ * Relays several DFU transfers at the same time from the application.
+ *
+ * The bootloader relays at most one transfer. The distribution scheduler relays additional
+ * transfers with distinct FWIDs, such as application, softdevice and bootloader images going to
+ * different groups of devices at the same time. Each transfer has its own transmit queue, and the
+ * transmissions are shared between the transfers in proportion to their priority. Recently
+ * relayed segments are cached, so data requests for them can be answered on the spot instead of
+ * travelling back to the source.
+ *
+ * @internal
+ * @{
+ */
+
+/** Lowest distribution priority. */
+#define DFU_DISTRIBUTION_PRIORITY_MIN   (1)
+/** Highest distribution priority. */
+#define DFU_DISTRIBUTION_PRIORITY_MAX   (16)
+
+/** Statistics for a distributed transfer. */
+typedef struct
+{
+    uint32_t tx_count;          /**< Number of packets transmitted. */
+    uint32_t relay_count;       /**< Number of data packets queued for relaying. */
+    uint32_t cache_hits;        /**< Number of requested segments answered from the cache. */
+    uint32_t cache_misses;      /**< Number of requested segments not in the cache. */
+    uint32_t drop_count;        /**< Number of packets dropped because the transmit queue was full. */
+} dfu_distribution_stats_t;
+
+/**
+ * Initialize the distribution scheduler, forgetting all transfers.
+ */
+void dfu_distribution_init(void);
+
+/**
+ * Start relaying a transfer.
+ *
+ * The transaction ID of the transfer is picked up from the state beacons for the given FWID.
+ *
+ * @param[in] type DFU type of the transfer.
+ * @param[in] p_fwid Firmware ID of the transfer.
+ * @param[in] priority Share of the transmissions relative to the other transfers, between
+ * @ref DFU_DISTRIBUTION_PRIORITY_MIN and @ref DFU_DISTRIBUTION_PRIORITY_MAX.
+ *
+ * @retval NRF_SUCCESS The transfer will be relayed.
+ * @retval NRF_ERROR_NULL The FWID pointer was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM The type or priority is invalid.
+ * @retval NRF_ERROR_INVALID_STATE The transfer is already being relayed.
+ * @retval NRF_ERROR_NO_MEM @ref NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX transfers are already
+ * being relayed.
+ */
+uint32_t dfu_distribution_add(nrf_mesh_dfu_type_t type, const nrf_mesh_fwid_t * p_fwid, uint8_t priority);
+
+/**
+ * Stop relaying a transfer, dropping its queued packets and cached segments.
+ *
+ * @param[in] type DFU type of the transfer.
+ * @param[in] p_fwid Firmware ID of the transfer.
+ *
+ * @retval NRF_SUCCESS The transfer is no longer relayed.
+ * @retval NRF_ERROR_NULL The FWID pointer was NULL.
+ * @retval NRF_ERROR_NOT_FOUND The transfer wasn't being relayed.
+ */
+uint32_t dfu_distribution_remove(nrf_mesh_dfu_type_t type, const nrf_mesh_fwid_t * p_fwid);
+
+/**
+ * Process an incoming DFU packet.
+ *
+ * Packets that don't belong to a distributed transfer are ignored.
+ *
+ * @param[in] p_packet Incoming DFU packet.
+ * @param[in] length Length of the packet.
+ *
+ * @returns Whether there are packets waiting for transmission.
+ */
+bool dfu_distribution_rx(const nrf_mesh_dfu_packet_t * p_packet, uint32_t length);
+
+/**
+ * Get the next packet to transmit.
+ *
+ * @param[out] p_packet Packet to transmit.
+ * @param[out] p_length Length of the packet.
+ *
+ * @returns Whether a packet was stored in @p p_packet.
+ */
+bool dfu_distribution_tx_get(nrf_mesh_dfu_packet_t * p_packet, uint32_t * p_length);
+
+/**
+ * Get the statistics for a distributed transfer.
+ *
+ * @param[in] type DFU type of the transfer.
+ * @param[in] p_fwid Firmware ID of the transfer.
+ * @param[out] p_stats Statistics for the transfer.
+ *
+ * @retval NRF_SUCCESS The statistics were stored in @p p_stats.
+ * @retval NRF_ERROR_NULL A pointer was NULL.
+ * @retval NRF_ERROR_NOT_FOUND The transfer isn't being relayed.
+ */
+uint32_t dfu_distribution_stats_get(nrf_mesh_dfu_type_t type,
+                                    const nrf_mesh_fwid_t * p_fwid,
+                                    dfu_distribution_stats_t * p_stats);
+
+/** @} */
+
+#endif /* DFU_DISTRIBUTION_H__ */
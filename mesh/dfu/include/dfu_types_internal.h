@@ -96,11 +96,15 @@ typedef struct bl_cmd bl_cmd_t; /**< Forward declaration of @c bl_cmd_t from bl_
 /** START packet packet length */
 #define DFU_PACKET_LEN_START        (2 + 2 + 4 + 4 + 4 + 2 + 1)
 /** DATA packet packet length */
-#define DFU_PACKET_LEN_DATA         (2 + 2 + 4 + SEGMENT_LENGTH)
+#define DFU_PACKET_LEN_DATA         (2 + 2 + 4 + NRF_MESH_DFU_SEGMENT_LENGTH)
 /** DATA REQUEST packet packet length */
 #define DFU_PACKET_LEN_DATA_REQ     (2 + 2 + 4)
+/** Largest number of segment ranges appended to a DATA REQUEST packet */
+#define DFU_PACKET_REQ_RANGES_MAX   (5)
+/** DATA REQUEST packet packet length with the given number of appended ranges */
+#define DFU_PACKET_LEN_DATA_REQ_RANGE(range_count) (2 + 2 + 4 + 3 * (range_count))
 /** DATA RESPONSE packet packet length */
-#define DFU_PACKET_LEN_DATA_RSP     (2 + 2 + 4 + SEGMENT_LENGTH)
+#define DFU_PACKET_LEN_DATA_RSP     (2 + 2 + 4 + NRF_MESH_DFU_SEGMENT_LENGTH)
 /** RELAY REQUEST packet packet length */
 #define DFU_PACKET_LEN_RELAY_REQ    (2 + 2 + 4 + BLE_GAP_ADDR_LEN)
 
@@ -187,6 +191,18 @@ typedef struct __attribute((packed))
             uint16_t segment;                                    /**< Segment ID being requested. */
             uint32_t transaction_id;                             /**< Transaction ID the request is done for. */
         } req_data;
+        /** Data request packet parameters, with the optional segment ranges. */
+        struct __attribute((packed))
+        {
+            uint16_t segment;                                    /**< First segment being requested. */
+            uint32_t transaction_id;                             /**< Transaction ID the request is done for. */
+            /** Ranges of missing segments, oldest first. */
+            struct __attribute((packed))
+            {
+                uint16_t segment;                                /**< First segment in the range. */
+                uint8_t count;                                   /**< Number of segments in the range. */
+            } ranges[DFU_PACKET_REQ_RANGES_MAX];
+        } req_range;
         /** Data response packet parameters. */
         struct __attribute((packed))
         {
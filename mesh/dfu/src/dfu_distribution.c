@@ -0,0 +1,565 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dfu_distribution.h"
+
+#include <string.h>
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "log.h"
+
+/*****************************************************************************
+* Local defines
+*****************************************************************************/
+#define DATA_TX_REPEATS         (3)         /**< Number of transmissions of relayed data, same as the bootloader. */
+#define RSP_TX_REPEATS          (3)         /**< Number of transmissions of data responses, same as the bootloader. */
+#define REQ_TX_REPEATS          (1)         /**< Number of transmissions of relayed data requests. */
+#define RSP_COUNT_MAX           (4)         /**< Largest number of segments to answer for a single range request. */
+#define REQ_RX_COUNT_RETRY      (8)         /**< Number of repeated requests to ignore before handling the same request again. */
+#define STRIDE_BASE             (0x10000UL) /**< Pass increment for a transfer with priority 1. */
+
+#define DATA_HEADER_LEN         (DFU_PACKET_LEN_DATA - NRF_MESH_DFU_SEGMENT_LENGTH)
+#define STATE_HEADER_LEN        (2 + 1 + 1 + 4)
+
+/** Whether pass @p a comes before pass @p b, allowing for wrap-around. */
+#define PASS_BEFORE(a, b)       ((int32_t) ((a) - (b)) < 0)
+
+NRF_MESH_STATIC_ASSERT(NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE <= UINT8_MAX);
+NRF_MESH_STATIC_ASSERT(STRIDE_BASE / DFU_DISTRIBUTION_PRIORITY_MAX > 0);
+
+/*****************************************************************************
+* Local typedefs
+*****************************************************************************/
+/** Packet waiting for transmission. */
+typedef struct
+{
+    nrf_mesh_dfu_packet_t packet;
+    uint8_t length;
+    uint8_t repeats;        /**< Remaining transmissions. */
+} queue_entry_t;
+
+/** Distributed transfer. */
+typedef struct
+{
+    bool in_use;
+    nrf_mesh_dfu_type_t type;
+    nrf_mesh_fwid_t fwid;
+    uint32_t transaction_id;    /**< Transaction ID picked up from the state beacons, or 0 if unknown. */
+    uint32_t stride;            /**< Pass increment per transmission, smaller for higher priorities. */
+    uint32_t pass;              /**< Virtual time of the next transmission. */
+    queue_entry_t queue[NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE];
+    uint8_t queue_head;
+    uint8_t queue_count;
+    dfu_distribution_stats_t stats;
+} transfer_t;
+
+/** Recently relayed segment. */
+typedef struct
+{
+    uint32_t transaction_id;
+    uint16_t segment;
+    uint8_t length;
+    uint8_t data[NRF_MESH_DFU_SEGMENT_LENGTH];
+} segment_entry_t;
+
+/** Recently handled request. */
+typedef struct
+{
+    uint32_t transaction_id;
+    uint16_t segment;
+    uint8_t rx_count;
+} req_entry_t;
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+static transfer_t       m_transfers[NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX];
+static segment_entry_t  m_segments[NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE];
+static uint32_t         m_segment_head;
+static req_entry_t      m_rsp_cache[DFU_DATA_RSP_CACHE_SIZE];   /**< Requests we've answered. */
+static uint32_t         m_rsp_head;
+static req_entry_t      m_req_cache[DFU_DATA_REQ_CACHE_SIZE];   /**< Requests we've relayed. */
+static uint32_t         m_req_head;
+static uint32_t         m_pass_now;     /**< Pass of the most recent transmission. */
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static uint32_t fwid_len_get(nrf_mesh_dfu_type_t type)
+{
+    switch (type)
+    {
+        case NRF_MESH_DFU_TYPE_APPLICATION:
+            return DFU_FWID_LEN_APP;
+        case NRF_MESH_DFU_TYPE_BOOTLOADER:
+            return DFU_FWID_LEN_BL;
+        case NRF_MESH_DFU_TYPE_SOFTDEVICE:
+            return DFU_FWID_LEN_SD;
+        default:
+            return 0;
+    }
+}
+
+static transfer_t * transfer_find(nrf_mesh_dfu_type_t type, const nrf_mesh_fwid_t * p_fwid)
+{
+    uint32_t fwid_len = fwid_len_get(type);
+    for (uint32_t i = 0; i < NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX; ++i)
+    {
+        if (m_transfers[i].in_use &&
+            m_transfers[i].type == type &&
+            memcmp(&m_transfers[i].fwid, p_fwid, fwid_len) == 0)
+        {
+            return &m_transfers[i];
+        }
+    }
+    return NULL;
+}
+
+static transfer_t * transfer_find_by_tid(uint32_t transaction_id)
+{
+    if (transaction_id == 0)
+    {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX; ++i)
+    {
+        if (m_transfers[i].in_use && m_transfers[i].transaction_id == transaction_id)
+        {
+            return &m_transfers[i];
+        }
+    }
+    return NULL;
+}
+
+static void transaction_forget(uint32_t transaction_id)
+{
+    for (uint32_t i = 0; i < NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE; ++i)
+    {
+        if (m_segments[i].transaction_id == transaction_id)
+        {
+            m_segments[i].transaction_id = 0;
+        }
+    }
+    for (uint32_t i = 0; i < DFU_DATA_RSP_CACHE_SIZE; ++i)
+    {
+        if (m_rsp_cache[i].transaction_id == transaction_id)
+        {
+            m_rsp_cache[i].transaction_id = 0;
+        }
+    }
+    for (uint32_t i = 0; i < DFU_DATA_REQ_CACHE_SIZE; ++i)
+    {
+        if (m_req_cache[i].transaction_id == transaction_id)
+        {
+            m_req_cache[i].transaction_id = 0;
+        }
+    }
+}
+
+static const segment_entry_t * segment_find(uint32_t transaction_id, uint16_t segment)
+{
+    for (uint32_t i = 0; i < NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE; ++i)
+    {
+        if (m_segments[i].transaction_id == transaction_id && m_segments[i].segment == segment)
+        {
+            return &m_segments[i];
+        }
+    }
+    return NULL;
+}
+
+static void segment_put(uint32_t transaction_id, uint16_t segment, const uint8_t * p_data, uint32_t length)
+{
+    segment_entry_t * p_entry = &m_segments[m_segment_head];
+    m_segment_head = (m_segment_head + 1) % NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE;
+    p_entry->transaction_id = transaction_id;
+    p_entry->segment = segment;
+    p_entry->length = (uint8_t) length;
+    memcpy(p_entry->data, p_data, length);
+}
+
+/**
+ * Check whether the same request has been handled recently. Like the bootloader, repeated
+ * requests are only handled again after @ref REQ_RX_COUNT_RETRY of them have been ignored.
+ */
+static bool req_is_recent(req_entry_t * p_cache, uint32_t size, uint32_t transaction_id, uint16_t segment)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        if (p_cache[i].transaction_id == transaction_id && p_cache[i].segment == segment)
+        {
+            if (p_cache[i].rx_count < REQ_RX_COUNT_RETRY)
+            {
+                p_cache[i].rx_count++;
+                return true;
+            }
+            p_cache[i].rx_count = 0;
+            return false;
+        }
+    }
+    return false;
+}
+
+static void req_put(req_entry_t * p_cache, uint32_t size, uint32_t * p_head, uint32_t transaction_id, uint16_t segment)
+{
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        if (p_cache[i].transaction_id == transaction_id && p_cache[i].segment == segment)
+        {
+            return;
+        }
+    }
+    req_entry_t * p_entry = &p_cache[*p_head];
+    *p_head = (*p_head + 1) % size;
+    p_entry->transaction_id = transaction_id;
+    p_entry->segment = segment;
+    p_entry->rx_count = 0;
+}
+
+static bool queue_push(transfer_t * p_transfer, const nrf_mesh_dfu_packet_t * p_packet, uint32_t length, uint8_t repeats)
+{
+    if (p_transfer->queue_count == NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE)
+    {
+        p_transfer->stats.drop_count++;
+        return false;
+    }
+    if (p_transfer->queue_count == 0 && PASS_BEFORE(p_transfer->pass, m_pass_now))
+    {
+        /* Idle transfers don't save up transmissions for later. */
+        p_transfer->pass = m_pass_now;
+    }
+    queue_entry_t * p_entry = &p_transfer->queue[(p_transfer->queue_head + p_transfer->queue_count) % NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE];
+    memcpy(&p_entry->packet, p_packet, length);
+    p_entry->length = (uint8_t) length;
+    p_entry->repeats = repeats;
+    p_transfer->queue_count++;
+    return true;
+}
+
+static bool segment_serve(transfer_t * p_transfer, uint16_t segment)
+{
+    const segment_entry_t * p_entry = segment_find(p_transfer->transaction_id, segment);
+    if (p_entry == NULL)
+    {
+        p_transfer->stats.cache_misses++;
+        return false;
+    }
+    p_transfer->stats.cache_hits++;
+
+    if (!req_is_recent(m_rsp_cache, DFU_DATA_RSP_CACHE_SIZE, p_transfer->transaction_id, segment))
+    {
+        nrf_mesh_dfu_packet_t rsp;
+        rsp.packet_type = DFU_PACKET_TYPE_DATA_RSP;
+        rsp.payload.rsp_data.segment = segment;
+        rsp.payload.rsp_data.transaction_id = p_transfer->transaction_id;
+        memcpy(rsp.payload.rsp_data.data, p_entry->data, p_entry->length);
+        if (queue_push(p_transfer, &rsp, DATA_HEADER_LEN + p_entry->length, RSP_TX_REPEATS))
+        {
+            req_put(m_rsp_cache, DFU_DATA_RSP_CACHE_SIZE, &m_rsp_head, p_transfer->transaction_id, segment);
+        }
+    }
+    return true;
+}
+
+static void req_relay(transfer_t * p_transfer, const nrf_mesh_dfu_packet_t * p_packet, uint32_t length, uint16_t segment)
+{
+    if (!req_is_recent(m_req_cache, DFU_DATA_REQ_CACHE_SIZE, p_transfer->transaction_id, segment) &&
+        queue_push(p_transfer, p_packet, length, REQ_TX_REPEATS))
+    {
+        req_put(m_req_cache, DFU_DATA_REQ_CACHE_SIZE, &m_req_head, p_transfer->transaction_id, segment);
+    }
+}
+
+static void state_rx(const nrf_mesh_dfu_packet_t * p_packet, uint32_t length)
+{
+    nrf_mesh_dfu_type_t type = (nrf_mesh_dfu_type_t) p_packet->payload.state.dfu_type;
+    uint32_t fwid_len = fwid_len_get(type);
+    if (fwid_len == 0 || length < STATE_HEADER_LEN + fwid_len)
+    {
+        return;
+    }
+
+    transfer_t * p_transfer = transfer_find(type, &p_packet->payload.state.fwid);
+    uint32_t transaction_id = p_packet->payload.state.transaction_id;
+    if (p_transfer != NULL && transaction_id != 0 && transaction_id != p_transfer->transaction_id)
+    {
+        __LOG(LOG_SRC_DFU, LOG_LEVEL_INFO, "Distributing transaction 0x%08x\n", transaction_id);
+        transaction_forget(p_transfer->transaction_id);
+        p_transfer->transaction_id = transaction_id;
+    }
+}
+
+static void data_rx(const nrf_mesh_dfu_packet_t * p_packet, uint32_t length)
+{
+    if (length < DATA_HEADER_LEN || length > DFU_PACKET_LEN_DATA)
+    {
+        return;
+    }
+    transfer_t * p_transfer = transfer_find_by_tid(p_packet->payload.data.transaction_id);
+    if (p_transfer == NULL ||
+        segment_find(p_transfer->transaction_id, p_packet->payload.data.segment) != NULL)
+    {
+        /* Not ours, or relayed already. */
+        return;
+    }
+
+    segment_put(p_transfer->transaction_id,
+                p_packet->payload.data.segment,
+                p_packet->payload.data.data,
+                length - DATA_HEADER_LEN);
+    if (queue_push(p_transfer, p_packet, length, DATA_TX_REPEATS))
+    {
+        p_transfer->stats.relay_count++;
+    }
+}
+
+static void data_req_rx(const nrf_mesh_dfu_packet_t * p_packet, uint32_t length)
+{
+    if (length < DFU_PACKET_LEN_DATA_REQ)
+    {
+        return;
+    }
+    transfer_t * p_transfer = transfer_find_by_tid(p_packet->payload.req_data.transaction_id);
+    if (p_transfer != NULL && !segment_serve(p_transfer, p_packet->payload.req_data.segment))
+    {
+        req_relay(p_transfer, p_packet, DFU_PACKET_LEN_DATA_REQ, p_packet->payload.req_data.segment);
+    }
+}
+
+static void data_req_range_rx(const nrf_mesh_dfu_packet_t * p_packet, uint32_t length)
+{
+    if (length < DFU_PACKET_LEN_DATA_REQ_RANGE(1) ||
+        length > DFU_PACKET_LEN_DATA_REQ_RANGE(DFU_PACKET_REQ_RANGES_MAX))
+    {
+        return;
+    }
+    transfer_t * p_transfer = transfer_find_by_tid(p_packet->payload.req_range.transaction_id);
+    if (p_transfer == NULL)
+    {
+        return;
+    }
+
+    uint32_t range_count = (length - DFU_PACKET_LEN_DATA_REQ_RANGE(0)) / 3;
+    uint32_t served = 0;
+    bool is_missing = false;
+    for (uint32_t i = 0; i < range_count && served < RSP_COUNT_MAX; ++i)
+    {
+        for (uint32_t j = 0; j < p_packet->payload.req_range.ranges[i].count && served < RSP_COUNT_MAX; ++j)
+        {
+            if (segment_serve(p_transfer, p_packet->payload.req_range.ranges[i].segment + j))
+            {
+                served++;
+            }
+            else
+            {
+                is_missing = true;
+            }
+        }
+    }
+
+    /* Pass the request on if someone closer to the source has to answer the rest. */
+    if (is_missing || served == RSP_COUNT_MAX)
+    {
+        req_relay(p_transfer, p_packet, length, p_packet->payload.req_range.segment);
+    }
+}
+
+static bool tx_pending(void)
+{
+    for (uint32_t i = 0; i < NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX; ++i)
+    {
+        if (m_transfers[i].in_use && m_transfers[i].queue_count > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void dfu_distribution_init(void)
+{
+    memset(m_transfers, 0, sizeof(m_transfers));
+    memset(m_segments, 0, sizeof(m_segments));
+    memset(m_rsp_cache, 0, sizeof(m_rsp_cache));
+    memset(m_req_cache, 0, sizeof(m_req_cache));
+    m_segment_head = 0;
+    m_rsp_head = 0;
+    m_req_head = 0;
+    m_pass_now = 0;
+}
+
+uint32_t dfu_distribution_add(nrf_mesh_dfu_type_t type, const nrf_mesh_fwid_t * p_fwid, uint8_t priority)
+{
+    if (p_fwid == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    if (fwid_len_get(type) == 0 ||
+        priority < DFU_DISTRIBUTION_PRIORITY_MIN ||
+        priority > DFU_DISTRIBUTION_PRIORITY_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (transfer_find(type, p_fwid) != NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    for (uint32_t i = 0; i < NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX; ++i)
+    {
+        transfer_t * p_transfer = &m_transfers[i];
+        if (!p_transfer->in_use)
+        {
+            memset(p_transfer, 0, sizeof(transfer_t));
+            p_transfer->in_use = true;
+            p_transfer->type = type;
+            p_transfer->fwid = *p_fwid;
+            p_transfer->stride = STRIDE_BASE / priority;
+            p_transfer->pass = m_pass_now;
+            return NRF_SUCCESS;
+        }
+    }
+    return NRF_ERROR_NO_MEM;
+}
+
+uint32_t dfu_distribution_remove(nrf_mesh_dfu_type_t type, const nrf_mesh_fwid_t * p_fwid)
+{
+    if (p_fwid == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    transfer_t * p_transfer = transfer_find(type, p_fwid);
+    if (p_transfer == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+    if (p_transfer->transaction_id != 0)
+    {
+        transaction_forget(p_transfer->transaction_id);
+    }
+    p_transfer->in_use = false;
+    return NRF_SUCCESS;
+}
+
+bool dfu_distribution_rx(const nrf_mesh_dfu_packet_t * p_packet, uint32_t length)
+{
+    NRF_MESH_ASSERT(p_packet != NULL);
+    switch (p_packet->packet_type)
+    {
+        case DFU_PACKET_TYPE_STATE:
+            state_rx(p_packet, length);
+            break;
+        case DFU_PACKET_TYPE_DATA:
+        case DFU_PACKET_TYPE_DATA_RSP:
+            data_rx(p_packet, length);
+            break;
+        case DFU_PACKET_TYPE_DATA_REQ:
+            if (length > DFU_PACKET_LEN_DATA_REQ)
+            {
+                data_req_range_rx(p_packet, length);
+            }
+            else
+            {
+                data_req_rx(p_packet, length);
+            }
+            break;
+        default:
+            break;
+    }
+    return tx_pending();
+}
+
+bool dfu_distribution_tx_get(nrf_mesh_dfu_packet_t * p_packet, uint32_t * p_length)
+{
+    NRF_MESH_ASSERT(p_packet != NULL && p_length != NULL);
+
+    /* Stride scheduling: the transfer that is furthest behind in virtual time goes next. */
+    transfer_t * p_next = NULL;
+    for (uint32_t i = 0; i < NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX; ++i)
+    {
+        transfer_t * p_transfer = &m_transfers[i];
+        if (p_transfer->in_use && p_transfer->queue_count > 0 &&
+            (p_next == NULL || PASS_BEFORE(p_transfer->pass, p_next->pass)))
+        {
+            p_next = p_transfer;
+        }
+    }
+    if (p_next == NULL)
+    {
+        return false;
+    }
+
+    queue_entry_t * p_entry = &p_next->queue[p_next->queue_head];
+    memcpy(p_packet, &p_entry->packet, p_entry->length);
+    *p_length = p_entry->length;
+
+    /* Repeats go to the back of the queue, so they're interleaved with the other packets. */
+    p_entry->repeats--;
+    queue_entry_t entry = *p_entry;
+    p_next->queue_head = (p_next->queue_head + 1) % NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE;
+    p_next->queue_count--;
+    if (entry.repeats > 0)
+    {
+        p_next->queue[(p_next->queue_head + p_next->queue_count) % NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE] = entry;
+        p_next->queue_count++;
+    }
+
+    m_pass_now = p_next->pass;
+    p_next->pass += p_next->stride;
+    p_next->stats.tx_count++;
+    return true;
+}
+
+uint32_t dfu_distribution_stats_get(nrf_mesh_dfu_type_t type,
+                                    const nrf_mesh_fwid_t * p_fwid,
+                                    dfu_distribution_stats_t * p_stats)
+{
+    if (p_fwid == NULL || p_stats == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    const transfer_t * p_transfer = transfer_find(type, p_fwid);
+    if (p_transfer == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+    *p_stats = p_transfer->stats;
+    return NRF_SUCCESS;
+}
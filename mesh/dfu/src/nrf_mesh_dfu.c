@@ -41,6 +41,7 @@
 #include "timeslot.h"
 #include "nrf_mesh_dfu_types.h"
 #include "dfu_types_internal.h"
+#include "dfu_distribution.h"
 #include "toolchain.h"
 #include "event.h"
 #include "bl_if.h"
@@ -113,6 +114,7 @@ typedef struct
 bl_if_cmd_handler_t                  m_cmd_handler;            /**< Command handler in shared code space, non-static for unit testing purposes. */
 static timer_event_t                 m_timer_evt;              /**< Timer event for scheduler. */
 static timer_event_t                 m_tx_timer_evt;           /**< TX event for scheduler. */
+static timer_event_t                 m_distribution_timer_evt; /**< TX event for the distribution scheduler. */
 static dfu_tx_t                      m_tx_slots[NRF_MESH_DFU_TX_SLOTS]; /**< TX slots for concurrent transmits. */
 static prng_t                        m_prng;                   /**< PRNG for time delays. */
 static fwid_t*                       mp_curr_fwid;             /**< Current Firmware IDs. */
@@ -320,6 +322,22 @@ static void tx_timeout(uint32_t timestamp, void* p_context)
     timer_sch_reschedule(&m_tx_timer_evt, next_timeout);
 }
 
+static void distribution_tx_timeout(uint32_t timestamp, void* p_context)
+{
+    if (!m_broadcast.active)
+    {
+        nrf_mesh_dfu_packet_t dfu_packet;
+        uint32_t length;
+        if (!dfu_distribution_tx_get(&dfu_packet, &length))
+        {
+            /* Nothing left to send, the next received packet restarts the timer. */
+            return;
+        }
+        (void) transmit_dfu_packet(&dfu_packet, length);
+    }
+    timer_sch_reschedule(&m_distribution_timer_evt, timestamp + NRF_MESH_DFU_DISTRIBUTION_TX_INTERVAL_US);
+}
+
 static void abort_timeout(uint32_t timestamp, void* p_context)
 {
     __LOG(LOG_SRC_DFU, LOG_LEVEL_INFO, "ABORT Timeout fired @%d\n", timestamp);
@@ -706,6 +724,11 @@ uint32_t nrf_mesh_dfu_init(void)
     m_tx_timer_evt.interval  = 0;
     m_tx_timer_evt.p_context = NULL;
     m_tx_timer_evt.p_next    = NULL;
+    m_distribution_timer_evt.cb        = distribution_tx_timeout;
+    m_distribution_timer_evt.interval  = 0;
+    m_distribution_timer_evt.p_context = NULL;
+    m_distribution_timer_evt.p_next    = NULL;
+    dfu_distribution_init();
 
     bl_cmd_t init_cmd =
     {
@@ -804,6 +827,13 @@ uint32_t nrf_mesh_dfu_rx(const uint8_t * p_packet,
         return NRF_ERROR_INVALID_ADDR;
     }
 
+    /* The distributed transfers don't touch flash, and keep going during flash operations. */
+    if (dfu_distribution_rx(p_dfu_packet, length) &&
+        !timer_sch_is_scheduled(&m_distribution_timer_evt))
+    {
+        timer_sch_reschedule(&m_distribution_timer_evt, timer_now() + NRF_MESH_DFU_DISTRIBUTION_TX_INTERVAL_US);
+    }
+
     if (mesh_flash_in_progress())
     {
         return NRF_ERROR_BUSY;
@@ -884,6 +914,27 @@ uint32_t nrf_mesh_dfu_relay(nrf_mesh_dfu_type_t type,
     return error_code;
 }
 
+uint32_t nrf_mesh_dfu_distribution_add(nrf_mesh_dfu_type_t type,
+        const nrf_mesh_fwid_t* p_fwid,
+        uint8_t priority)
+{
+    if (m_transfer_state.state == NRF_MESH_DFU_STATE_UNINITIALIZED)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    return dfu_distribution_add(type, p_fwid, priority);
+}
+
+uint32_t nrf_mesh_dfu_distribution_remove(nrf_mesh_dfu_type_t type,
+        const nrf_mesh_fwid_t* p_fwid)
+{
+    if (m_transfer_state.state == NRF_MESH_DFU_STATE_UNINITIALIZED)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    return dfu_distribution_remove(type, p_fwid);
+}
+
 uint32_t nrf_mesh_dfu_abort(void)
 {
     if (m_transfer_state.state == NRF_MESH_DFU_STATE_UNINITIALIZED)
@@ -42,6 +42,7 @@
 #include "packet_buffer.h"
 #include "utils.h"
 #include "sdk_config.h"
+#include "nrf_mesh_config_core.h"
 
 /**
  * @defgroup MESH_GATT Generic GATT interface for Mesh
@@ -58,7 +59,7 @@
 #define MESH_GATT_MTU_SIZE_MAX       (69)
 #define MESH_GATT_PACKET_MAX_SIZE    (MESH_GATT_PROXY_PDU_MAX_SIZE - 1)
 #define MESH_GATT_TX_BUFFER_SIZE     ALIGN_VAL(MESH_GATT_PACKET_MAX_SIZE + \
-                                               sizeof(packet_buffer_packet_t), WORD_SIZE)*3
+                                               sizeof(packet_buffer_packet_t), WORD_SIZE)*MESH_GATT_TX_PACKET_COUNT
 
 #if NRF_SDH_BLE_GATT_MAX_MTU_SIZE != MESH_GATT_MTU_SIZE_MAX
 #warning An MTU size of 69 octets is recommended.
@@ -137,6 +138,21 @@ typedef struct
     uint8_t offset;
 } mesh_gatt_transaction_t;
 
+/** Notification statistics of a Mesh GATT connection. */
+typedef struct
+{
+    /** Number of proxy PDUs sent. */
+    uint32_t pdus;
+    /** Number of notifications sent, at least one per proxy PDU. */
+    uint32_t notifications;
+    /** Number of times a notification was held back because the SoftDevice queue was full. */
+    uint32_t queue_full;
+    /** Number of notification TX complete events, at most one per connection event. */
+    uint32_t tx_complete_events;
+    /** Largest number of notifications reported by one TX complete event. */
+    uint16_t notifications_per_event_max;
+} mesh_gatt_tx_stats_t;
+
 /** Mesh GATT connection context structure. */
 typedef struct
 {
@@ -150,6 +166,7 @@ typedef struct
         uint8_t packet_buffer_data[MESH_GATT_TX_BUFFER_SIZE];
         mesh_gatt_transaction_t transaction;
         bool tx_complete_process;
+        mesh_gatt_tx_stats_t stats;
     } tx;
     struct
     {
@@ -243,6 +260,18 @@ void mesh_gatt_packet_discard(uint16_t conn_index, const uint8_t * p_packet);
  */
 bool mesh_gatt_packet_is_pending(uint16_t conn_index);
 
+/**
+ * Gets the notification statistics of the given Mesh GATT connection.
+ *
+ * The statistics are cleared when the connection is established. The number of notifications per
+ * proxy PDU shows how often PDUs are segmented at the negotiated MTU, and the number of
+ * notifications per TX complete event shows how many notifications are sent per connection event.
+ *
+ * @param[in]  conn_index Connection index.
+ * @param[out] p_stats    Statistics of the connection.
+ */
+void mesh_gatt_tx_stats_get(uint16_t conn_index, mesh_gatt_tx_stats_t * p_stats);
+
 /**
  * Disconnects the given Mesh GATT connection.
  *
@@ -187,12 +187,20 @@ static void mesh_gatt_pdu_send(mesh_gatt_connection_t * p_conn)
     else if (err_code == NRF_ERROR_RESOURCES)
     {
         /* Try again at the next TX_COMPLETE. */
+        p_conn->tx.stats.queue_full++;
     }
     else
     {
         /* If we are able to send, we should have sent the full length. */
         NRF_MESH_ASSERT(err_code == NRF_SUCCESS && hvx_length == length);
 
+        p_conn->tx.stats.notifications++;
+        if (sar_type == PROXY_SAR_TYPE_COMPLETE ||
+            sar_type == PROXY_SAR_TYPE_LAST_SEGMENT)
+        {
+            p_conn->tx.stats.pdus++;
+        }
+
         /* Next offset starts at the final byte of the previous packet. */
         uint8_t next_offset = p_conn->tx.transaction.offset + length - sizeof(mesh_gatt_proxy_pdu_t);
 
@@ -551,6 +559,7 @@ static void connect_evt_handle(const ble_evt_t * p_ble_evt)
                            m_gatt.connections[conn_index].tx.packet_buffer_data,
                            sizeof(m_gatt.connections[conn_index].tx.packet_buffer_data));
         m_gatt.connections[conn_index].tx.tx_complete_process = false;
+        memset(&m_gatt.connections[conn_index].tx.stats, 0, sizeof(mesh_gatt_tx_stats_t));
         mesh_gatt_evt_t evt;
         evt.type = MESH_GATT_EVT_TYPE_CONNECTED;
         evt.conn_index = conn_index;
@@ -743,6 +752,14 @@ bool mesh_gatt_packet_is_pending(uint16_t conn_index)
     return (!packet_buffer_is_empty(&m_gatt.connections[conn_index].tx.packet_buffer));
 }
 
+void mesh_gatt_tx_stats_get(uint16_t conn_index, mesh_gatt_tx_stats_t * p_stats)
+{
+    NRF_MESH_ASSERT(conn_index < MESH_GATT_CONNECTION_COUNT_MAX);
+    NRF_MESH_ASSERT(p_stats != NULL);
+
+    *p_stats = m_gatt.connections[conn_index].tx.stats;
+}
+
 uint32_t mesh_gatt_disconnect(uint16_t conn_index)
 {
     NRF_MESH_ASSERT(conn_index < MESH_GATT_CONNECTION_COUNT_MAX);
@@ -797,6 +814,12 @@ void mesh_gatt_on_ble_evt(const ble_evt_t * p_ble_evt, void * p_context)
                 uint16_t conn_index = conn_handle_to_index(p_ble_evt->evt.gatts_evt.conn_handle);
                 if (conn_index != MESH_GATT_CONN_INDEX_INVALID)
                 {
+                    mesh_gatt_tx_stats_t * p_stats = &m_gatt.connections[conn_index].tx.stats;
+                    p_stats->tx_complete_events++;
+                    p_stats->notifications_per_event_max =
+                        MAX(p_stats->notifications_per_event_max,
+                            p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count);
+
                     /* TX complete is already sent if current packet is NULL, and no fresh PDU was
                        available. */
                     if (m_gatt.connections[conn_index].tx.transaction.p_curr_packet == NULL)
@@ -101,6 +101,18 @@
 
 /** @} end of NRF_MESH_CONFIG_PROV_BEARER */
 
+/**
+ * Use the built-in P-256 implementation instead of micro-ecc for the provisioning keys and ECDH.
+ *
+ * The built-in implementation generates keys with a precomputed table of generator multiples,
+ * and calculates the shared secret in constant time with a signed fixed-window ladder over the
+ * odd multiples of the peer's public key (4-bit windows). It is faster than micro-ecc at the cost
+ * of about 2 kB of flash for the table.
+ */
+#ifndef NRF_MESH_PROV_ECC_P256_ENABLE
+#define NRF_MESH_PROV_ECC_P256_ENABLE 0
+#endif
+
 /**
  * @defgroup MESH_CONFIG_PROVISIONEE Provisionee configuration
  * @{
@@ -113,6 +125,43 @@
 
 /** @} end of MESH_CONFIG_PROVISIONEE */
 
+/**
+ * @defgroup MESH_CONFIG_PROVISIONER Provisioner configuration
+ * @{
+ */
+
+/** Number of concurrent PB-ADV links used by the provisioning queue, see @ref NRF_MESH_PROV_QUEUE. */
+#ifndef NRF_MESH_PROV_QUEUE_LINK_COUNT
+#define NRF_MESH_PROV_QUEUE_LINK_COUNT 4
+#endif
+
+/** Number of devices that can wait in the provisioning queue for a free link. */
+#ifndef NRF_MESH_PROV_QUEUE_LENGTH
+#define NRF_MESH_PROV_QUEUE_LENGTH 16
+#endif
+
+/**
+ * Minimum time between two links opened by the provisioning queue.
+ *
+ * Spreads the transactions and the retransmissions of the concurrent links over time, so that
+ * they do not all compete for the advertiser and the CPU at the same moments.
+ */
+#ifndef NRF_MESH_PROV_QUEUE_LINK_OPEN_SPACING_US
+#define NRF_MESH_PROV_QUEUE_LINK_OPEN_SPACING_US 250000
+#endif
+
+/**
+ * Number of precomputed P-256 keypairs kept by the provisioning queue.
+ *
+ * Each provisioning session takes a fresh keypair from the pool, which is refilled in the
+ * background.
+ */
+#ifndef NRF_MESH_PROV_KEYPOOL_SIZE
+#define NRF_MESH_PROV_KEYPOOL_SIZE NRF_MESH_PROV_QUEUE_LINK_COUNT
+#endif
+
+/** @} end of MESH_CONFIG_PROVISIONER */
+
 /** @} end of NRF_MESH_CONFIG_PROV */
 
 #endif
@@ -0,0 +1,136 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NRF_MESH_PROV_QUEUE_H__
+#define NRF_MESH_PROV_QUEUE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nrf_mesh_config_prov.h"
+#include "nrf_mesh_prov.h"
+
+/**
+ * @defgroup NRF_MESH_PROV_QUEUE Provisioning queue
+ * @ingroup NRF_MESH_PROV
+ * Provisions a list of devices over several concurrent PB-ADV links.
+ *
+ * The queue owns @ref NRF_MESH_PROV_QUEUE_LINK_COUNT provisioning contexts, each with its own
+ * PB-ADV bearer. Devices added to the queue are provisioned in order as soon as a link is free,
+ * with a new keypair for every session taken from a pool of precomputed keypairs. New links are
+ * opened at least @ref NRF_MESH_PROV_QUEUE_LINK_OPEN_SPACING_US apart. The application generates
+ * the keypairs by calling @ref nrf_mesh_prov_queue_process() from its main loop.
+ *
+ * All provisioning events of the links are passed to the event handler given to
+ * @ref nrf_mesh_prov_queue_init(). The application must answer the events with the context
+ * pointer of the event, in the same way as for a single provisioning context. A link is reused
+ * for the next device once its @ref NRF_MESH_PROV_EVT_LINK_CLOSED event has been handled.
+ * @{
+ */
+
+/**
+ * Initializes the provisioning queue.
+ *
+ * @param[in] p_caps        Pointer to a structure containing the provisioner's out-of-band
+ *                          authentication capabilities.
+ * @param[in] event_handler Event handler callback function for the events of all links.
+ *
+ * @retval NRF_SUCCESS             The queue was successfully initialized.
+ * @retval NRF_ERROR_NULL          One or more parameters were NULL.
+ * @retval NRF_ERROR_INVALID_STATE Initialization was attempted while devices were being provisioned.
+ */
+uint32_t nrf_mesh_prov_queue_init(const nrf_mesh_prov_oob_caps_t * p_caps,
+                                  nrf_mesh_prov_evt_handler_cb_t   event_handler);
+
+/**
+ * Adds a device to the provisioning queue.
+ *
+ * @param[in] p_target_uuid        Device UUID of the device that is to be provisioned.
+ * @param[in] attention_duration_s Time in seconds during which the device will identify itself
+ *                                 using any means it can.
+ * @param[in] p_data               Pointer to a structure containing the provisioning data for the
+ *                                 device.
+ *
+ * @retval NRF_SUCCESS             The device was added to the queue.
+ * @retval NRF_ERROR_NULL          One or more parameters were NULL.
+ * @retval NRF_ERROR_INVALID_STATE The queue has not been initialized.
+ * @retval NRF_ERROR_INVALID_DATA  The provisioning data failed some boundary conditions.
+ * @retval NRF_ERROR_FORBIDDEN     The device is already queued or being provisioned.
+ * @retval NRF_ERROR_NO_MEM        The queue is full.
+ */
+uint32_t nrf_mesh_prov_queue_add(const uint8_t *                           p_target_uuid,
+                                 uint8_t                                   attention_duration_s,
+                                 const nrf_mesh_prov_provisioning_data_t * p_data);
+
+/**
+ * Removes all devices waiting for a free link from the queue.
+ *
+ * Devices that are being provisioned are not affected.
+ */
+void nrf_mesh_prov_queue_clear(void);
+
+/**
+ * Gets the number of devices waiting for a free link.
+ *
+ * @returns The number of queued devices.
+ */
+uint32_t nrf_mesh_prov_queue_pending_count_get(void);
+
+/**
+ * Fills the keypair pool, one keypair per call.
+ *
+ * A keypair generation takes a long time, so it runs from the main loop instead of holding up the
+ * mesh event processing.
+ *
+ * @note This function must be called from the main loop, also when the mesh is running in
+ *       @ref NRF_MESH_IRQ_PRIORITY_THREAD.
+ *
+ * @retval true  The keypair pool is full. It is safe to go to sleep by calling sd_app_evt_wait().
+ * @retval false The keypair pool needs more keypairs.
+ */
+bool nrf_mesh_prov_queue_process(void);
+
+/**
+ * Gets the number of links with an ongoing provisioning session.
+ *
+ * @returns The number of active links.
+ */
+uint32_t nrf_mesh_prov_queue_active_count_get(void);
+
+/** @} */
+
+#endif /* NRF_MESH_PROV_QUEUE_H__ */
@@ -0,0 +1,117 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROV_ECC_P256_H__
+#define PROV_ECC_P256_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "prov_utils.h"
+
+/**
+ * @defgroup PROV_ECC_P256 P-256 backend
+ * @ingroup PROV_UTILS
+ * Built-in NIST P-256 implementation for the provisioning keys and ECDH.
+ *
+ * Public keys are calculated with a fixed-base comb over a precomputed table of generator
+ * multiples. The whole table is read and a point addition is calculated for every column of the
+ * comb, so the private key does not select the memory accesses or the number of additions.
+ * Shared secrets are calculated with a regular signed window recoding of the private key, where
+ * every digit is odd and non-zero, so the same doublings and additions are done for every key. The
+ * table of odd multiples is read in full for every digit.
+ *
+ * All keys are in the big-endian format of the provisioning PDUs.
+ * @{
+ */
+
+/**
+ * Calculates the public key of a private key.
+ *
+ * @param[in]  p_private Private key, @ref NRF_MESH_PROV_PRIVKEY_SIZE bytes.
+ * @param[out] p_public  Public key, @ref NRF_MESH_PROV_PUBKEY_SIZE bytes.
+ *
+ * @retval NRF_SUCCESS             The public key was calculated.
+ * @retval NRF_ERROR_INVALID_PARAM The private key is not in the range [1, n - 1].
+ */
+uint32_t prov_ecc_p256_public_key_calculate(const uint8_t * p_private, uint8_t * p_public);
+
+/**
+ * Generates a new keypair with a private key from the random number generator.
+ *
+ * @param[out] p_public  Public key, @ref NRF_MESH_PROV_PUBKEY_SIZE bytes.
+ * @param[out] p_private Private key, @ref NRF_MESH_PROV_PRIVKEY_SIZE bytes.
+ *
+ * @retval NRF_SUCCESS        The keys were generated.
+ * @retval NRF_ERROR_INTERNAL The random number generator did not produce a valid private key.
+ */
+uint32_t prov_ecc_p256_keys_generate(uint8_t * p_public, uint8_t * p_private);
+
+/**
+ * Calculates the ECDH shared secret, the X coordinate of the private key times the peer public key.
+ *
+ * @param[in]  p_peer_public   Public key of the peer, @ref NRF_MESH_PROV_PUBKEY_SIZE bytes.
+ * @param[in]  p_private       Own private key, @ref NRF_MESH_PROV_PRIVKEY_SIZE bytes.
+ * @param[out] p_shared_secret Shared secret, @ref NRF_MESH_ECDH_SHARED_SECRET_SIZE bytes.
+ *
+ * @retval NRF_SUCCESS        The shared secret was calculated.
+ * @retval NRF_ERROR_INTERNAL The peer public key or the private key is invalid.
+ */
+uint32_t prov_ecc_p256_shared_secret_calculate(const uint8_t * p_peer_public,
+                                               const uint8_t * p_private,
+                                               uint8_t * p_shared_secret);
+
+/**
+ * Checks whether a public key is a point on the curve.
+ *
+ * @param[in] p_public Public key, @ref NRF_MESH_PROV_PUBKEY_SIZE bytes.
+ *
+ * @retval true  The public key is valid.
+ * @retval false The public key is invalid.
+ */
+bool prov_ecc_p256_public_key_is_valid(const uint8_t * p_public);
+
+/**
+ * Gets the backend interface of the P-256 implementation, see @ref prov_utils_ecc_backend_set().
+ *
+ * @returns Pointer to the backend interface.
+ */
+const prov_utils_ecc_backend_t * prov_ecc_p256_backend_get(void);
+
+/** @} */
+
+#endif /* PROV_ECC_P256_H__ */
@@ -0,0 +1,107 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROV_KEYPOOL_H__
+#define PROV_KEYPOOL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nrf_mesh_config_prov.h"
+
+/**
+ * @defgroup PROV_KEYPOOL Provisioning keypair pool
+ * @ingroup MESH_PROV
+ * Keeps a pool of precomputed P-256 keypairs for provisioning sessions.
+ *
+ * Generating a keypair takes a large part of the CPU time a provisioner spends on a session. The
+ * pool generates the keypairs ahead of time, so that a new session can start without waiting for
+ * the key generation. The keypairs are generated in @ref prov_keypool_refill(), which runs in the
+ * main loop, so that the bearer event handler is never held up for a whole key generation.
+ * @{
+ */
+
+/**
+ * Keypair available callback.
+ *
+ * Called from the bearer event context when a keypair has been added to an empty pool.
+ */
+typedef void (*prov_keypool_available_cb_t)(void);
+
+/**
+ * Initializes the keypair pool.
+ *
+ * The pool is filled by @ref prov_keypool_refill() from then on.
+ *
+ * @param[in] available_cb Function to call when a keypair becomes available, or NULL.
+ */
+void prov_keypool_init(prov_keypool_available_cb_t available_cb);
+
+/**
+ * Generates one keypair for the pool, if it is not full.
+ *
+ * @note Must be called from the main loop, at a lower priority than the bearer event handler.
+ *
+ * @retval true  The pool is full, or the pool has not been initialized.
+ * @retval false The pool needs more keypairs, call again.
+ */
+bool prov_keypool_refill(void);
+
+/**
+ * Takes a keypair from the pool.
+ *
+ * The keypair is removed from the pool, and is never handed out again.
+ *
+ * @param[out] p_public  Pointer to where the public key is stored.
+ * @param[out] p_private Pointer to where the private key is stored.
+ *
+ * @retval NRF_SUCCESS         A keypair was taken from the pool.
+ * @retval NRF_ERROR_NULL      One or more parameters were NULL.
+ * @retval NRF_ERROR_NOT_FOUND The pool is empty.
+ */
+uint32_t prov_keypool_get(uint8_t * p_public, uint8_t * p_private);
+
+/**
+ * Gets the number of keypairs in the pool.
+ *
+ * @returns The number of keypairs ready for use.
+ */
+uint32_t prov_keypool_count_get(void);
+
+/** @} */
+
+#endif /* PROV_KEYPOOL_H__ */
@@ -62,6 +62,36 @@
 /** Offset into the provisioning confirmation input array where the contents of the start PDU is copied. */
 #define PROV_CONFIRM_INPUTS_START_OFFSET    (PROV_CONFIRM_INPUTS_CAPS_OFFSET + sizeof(prov_pdu_caps_t) - 1)
 
+/**
+ * ECC backend for the provisioning keys and the ECDH shared secret.
+ *
+ * Keys are in the big-endian format of the provisioning PDUs: the private key is a
+ * @ref NRF_MESH_PROV_PRIVKEY_SIZE byte scalar, and the public key is the X and Y coordinates of
+ * the point, @ref NRF_MESH_PROV_PUBKEY_SIZE bytes in total.
+ */
+typedef struct
+{
+    /** Generates a new keypair, see @ref prov_utils_keys_generate(). */
+    uint32_t (*keys_generate)(uint8_t * p_public, uint8_t * p_private);
+    /** Calculates the shared secret for a validated peer public key and the own private key.
+     * Returns @c NRF_SUCCESS, or @c NRF_ERROR_INTERNAL if the secret could not be calculated. */
+    uint32_t (*shared_secret_calculate)(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared_secret);
+    /** Checks whether the public key is a point on the curve. */
+    bool (*public_key_is_valid)(const uint8_t * p_public);
+} prov_utils_ecc_backend_t;
+
+/**
+ * Sets the ECC backend used by the provisioning.
+ *
+ * By default, the provisioning uses micro-ecc, or the built-in P-256 implementation if
+ * @ref NRF_MESH_PROV_ECC_P256_ENABLE is set.
+ *
+ * @param[in] p_backend Backend to use, or @c NULL to restore the default backend. The backend
+ *                      must stay valid while it is in use, and must not be changed during a
+ *                      provisioning session.
+ */
+void prov_utils_ecc_backend_set(const prov_utils_ecc_backend_t * p_backend);
+
 /**
  * Sets provisioning options.
  *
@@ -113,7 +143,7 @@ void prov_utils_authentication_values_derive(const nrf_mesh_prov_ctx_t * p_ctx,
  *
  * @retval NRF_SUCCESS             The keys were successfully generated.
  * @retval NRF_ERROR_INTERNAL      An error occured while generating the keys.
- * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without uECC support,
+ * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without an ECC backend,
  *                                 making the required functionality unavailable.
  */
 uint32_t prov_utils_keys_generate(uint8_t * p_public, uint8_t * p_private);
@@ -140,7 +170,7 @@ void prov_utils_derive_keys(const nrf_mesh_prov_ctx_t * p_ctx,
  * @retval NRF_SUCCESS             The shared secret was successfully derived.
  * @retval NRF_ERROR_INTERNAL      The shared secret could not be calculated; this is likely to happen if the public
  *                                 key received from the peer node is not valid.
- * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without uECC support,
+ * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without an ECC backend,
  *                                 making the required functionality unavailable.
  */
 uint32_t prov_utils_calculate_shared_secret(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_shared_secret);
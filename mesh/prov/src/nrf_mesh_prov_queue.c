@@ -0,0 +1,327 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "nrf_mesh_prov_queue.h"
+
+#include "nrf_mesh_config_prov.h"
+
+#if MESH_FEATURE_PB_ADV_ENABLED
+
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "nrf_mesh_prov.h"
+#include "nrf_mesh_prov_bearer_adv.h"
+#include "prov_keypool.h"
+#include "provisioning.h"
+#include "timer.h"
+#include "timer_scheduler.h"
+#include "utils.h"
+#include "log.h"
+
+/*****************************************************************************
+* Local type definitions
+*****************************************************************************/
+/** Device waiting for a free link. */
+typedef struct
+{
+    uint8_t uuid[NRF_MESH_UUID_SIZE];
+    uint8_t attention_duration_s;
+    nrf_mesh_prov_provisioning_data_t data;
+} queue_entry_t;
+
+/** Provisioning link, with its own context, bearer and keypair. */
+typedef struct
+{
+    nrf_mesh_prov_ctx_t ctx;
+    nrf_mesh_prov_bearer_adv_t bearer_adv;
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+    uint8_t uuid[NRF_MESH_UUID_SIZE]; /**< Device being provisioned, valid when @c active. */
+    bool has_keys;                    /**< The keypair has not been used in a session yet. */
+    bool active;
+} queue_link_t;
+
+NRF_MESH_STATIC_ASSERT(NRF_MESH_PROV_QUEUE_LINK_COUNT > 0);
+NRF_MESH_STATIC_ASSERT(NRF_MESH_PROV_QUEUE_LENGTH > 0);
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+static queue_link_t m_links[NRF_MESH_PROV_QUEUE_LINK_COUNT];
+static queue_entry_t m_queue[NRF_MESH_PROV_QUEUE_LENGTH];
+static uint32_t m_queue_head;
+static uint32_t m_queue_count;
+
+static nrf_mesh_prov_evt_handler_cb_t m_event_handler;
+static timer_event_t m_link_open_timer;
+static timestamp_t m_next_link_open;
+static bool m_initialized;
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static void link_open_schedule(void)
+{
+    timestamp_t now = timer_now();
+    timer_sch_reschedule(&m_link_open_timer,
+                         TIMER_OLDER_THAN(now, m_next_link_open) ? m_next_link_open : now);
+}
+
+static queue_link_t * free_link_get(void)
+{
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        if (!m_links[i].active)
+        {
+            return &m_links[i];
+        }
+    }
+    return NULL;
+}
+
+static bool uuid_is_busy(const uint8_t * p_uuid)
+{
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        if (m_links[i].active && memcmp(m_links[i].uuid, p_uuid, NRF_MESH_UUID_SIZE) == 0)
+        {
+            return true;
+        }
+    }
+
+    for (uint32_t i = 0; i < m_queue_count; ++i)
+    {
+        const queue_entry_t * p_entry = &m_queue[(m_queue_head + i) % NRF_MESH_PROV_QUEUE_LENGTH];
+        if (memcmp(p_entry->uuid, p_uuid, NRF_MESH_UUID_SIZE) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Opens links for the queued devices, one link per link open spacing. */
+static void links_start(timestamp_t timestamp, void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    while (m_queue_count > 0)
+    {
+        queue_link_t * p_link = free_link_get();
+        if (p_link == NULL)
+        {
+            /* Continued when a link is closed. */
+            return;
+        }
+
+        if (TIMER_OLDER_THAN(timestamp, m_next_link_open))
+        {
+            timer_sch_reschedule(&m_link_open_timer, m_next_link_open);
+            return;
+        }
+
+        if (!p_link->has_keys)
+        {
+            if (prov_keypool_get(p_link->public_key, p_link->private_key) != NRF_SUCCESS)
+            {
+                /* Continued when the pool has a keypair. */
+                return;
+            }
+            p_link->has_keys = true;
+        }
+
+        const queue_entry_t * p_entry = &m_queue[m_queue_head];
+        uint32_t status = nrf_mesh_prov_provision(&p_link->ctx,
+                                                  p_entry->uuid,
+                                                  p_entry->attention_duration_s,
+                                                  &p_entry->data,
+                                                  NRF_MESH_PROV_BEARER_ADV);
+        m_next_link_open = timestamp + NRF_MESH_PROV_QUEUE_LINK_OPEN_SPACING_US;
+
+        if (status != NRF_SUCCESS)
+        {
+            /* Most likely out of advertiser buffers, try again later with the same keys. */
+            __LOG(LOG_SRC_PROV, LOG_LEVEL_WARN, "Provisioning queue link open failed: %u\n", status);
+            timer_sch_reschedule(&m_link_open_timer, m_next_link_open);
+            return;
+        }
+
+        memcpy(p_link->uuid, p_entry->uuid, NRF_MESH_UUID_SIZE);
+        p_link->has_keys = false;
+        p_link->active = true;
+
+        m_queue_head = (m_queue_head + 1) % NRF_MESH_PROV_QUEUE_LENGTH;
+        m_queue_count--;
+    }
+}
+
+static void keypool_available_cb(void)
+{
+    if (m_queue_count > 0)
+    {
+        link_open_schedule();
+    }
+}
+
+static void prov_evt_handler(const nrf_mesh_prov_evt_t * p_evt)
+{
+    m_event_handler(p_evt);
+
+    if (p_evt->type == NRF_MESH_PROV_EVT_LINK_CLOSED)
+    {
+        queue_link_t * p_link = PARENT_BY_FIELD_GET(queue_link_t, ctx, p_evt->params.link_closed.p_context);
+        NRF_MESH_ASSERT(p_link >= &m_links[0] && p_link < &m_links[NRF_MESH_PROV_QUEUE_LINK_COUNT]);
+        p_link->active = false;
+
+        /* The bearer is still unwinding the link close, reuse the link from the timer instead. */
+        if (m_queue_count > 0)
+        {
+            link_open_schedule();
+        }
+    }
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+uint32_t nrf_mesh_prov_queue_init(const nrf_mesh_prov_oob_caps_t * p_caps,
+                                  nrf_mesh_prov_evt_handler_cb_t   event_handler)
+{
+    if (p_caps == NULL || event_handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    else if (nrf_mesh_prov_queue_active_count_get() > 0)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        NRF_MESH_ERROR_CHECK(nrf_mesh_prov_init(&m_links[i].ctx,
+                                                m_links[i].public_key,
+                                                m_links[i].private_key,
+                                                p_caps,
+                                                prov_evt_handler));
+        if (!m_initialized)
+        {
+            NRF_MESH_ERROR_CHECK(nrf_mesh_prov_bearer_add(&m_links[i].ctx,
+                                                          nrf_mesh_prov_bearer_adv_interface_get(&m_links[i].bearer_adv)));
+        }
+    }
+
+    m_event_handler = event_handler;
+    m_link_open_timer.cb = links_start;
+    m_link_open_timer.p_context = NULL;
+    m_link_open_timer.interval = 0;
+    m_next_link_open = timer_now();
+    m_queue_head = 0;
+    m_queue_count = 0;
+    m_initialized = true;
+
+    prov_keypool_init(keypool_available_cb);
+    return NRF_SUCCESS;
+}
+
+uint32_t nrf_mesh_prov_queue_add(const uint8_t *                           p_target_uuid,
+                                 uint8_t                                   attention_duration_s,
+                                 const nrf_mesh_prov_provisioning_data_t * p_data)
+{
+    if (p_target_uuid == NULL || p_data == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    else if (!m_initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    else if (!prov_data_is_valid(p_data))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+    else if (uuid_is_busy(p_target_uuid))
+    {
+        return NRF_ERROR_FORBIDDEN;
+    }
+    else if (m_queue_count == NRF_MESH_PROV_QUEUE_LENGTH)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    queue_entry_t * p_entry = &m_queue[(m_queue_head + m_queue_count) % NRF_MESH_PROV_QUEUE_LENGTH];
+    memcpy(p_entry->uuid, p_target_uuid, NRF_MESH_UUID_SIZE);
+    p_entry->attention_duration_s = attention_duration_s;
+    p_entry->data = *p_data;
+    m_queue_count++;
+
+    link_open_schedule();
+    return NRF_SUCCESS;
+}
+
+void nrf_mesh_prov_queue_clear(void)
+{
+    m_queue_count = 0;
+}
+
+uint32_t nrf_mesh_prov_queue_pending_count_get(void)
+{
+    return m_queue_count;
+}
+
+bool nrf_mesh_prov_queue_process(void)
+{
+    return prov_keypool_refill();
+}
+
+uint32_t nrf_mesh_prov_queue_active_count_get(void)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        if (m_links[i].active)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+#endif /* MESH_FEATURE_PB_ADV_ENABLED */
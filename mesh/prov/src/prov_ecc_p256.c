@@ -0,0 +1,940 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "prov_ecc_p256.h"
+
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "nrf_mesh_prov_types.h"
+#include "rand.h"
+
+/*****************************************************************************
+* Local defines
+*****************************************************************************/
+/** Number of 32-bit words in a field element or a scalar. */
+#define WORDS                   (8)
+/** Number of bytes in a field element or a scalar. */
+#define BYTES                   (32)
+/** Number of bits in a scalar. */
+#define SCALAR_BITS             (256)
+
+/** Number of teeth of the comb, the comb table has 2^teeth - 1 points. */
+#define COMB_TEETH              (5)
+/** Distance between the teeth of the comb, in bits. */
+#define COMB_SPACING            ((SCALAR_BITS + COMB_TEETH - 1) / COMB_TEETH)
+#define COMB_TABLE_SIZE         ((1u << COMB_TEETH) - 1)
+
+/** Width of the signed window digits, the table has the odd multiples P, 3P, ..., (2^width - 1)P. */
+#define WINDOW_WIDTH            (4)
+#define WINDOW_TABLE_SIZE       (1u << (WINDOW_WIDTH - 1))
+/** Number of window digits below the top digit, which is always 1. */
+#define WINDOW_DIGITS           ((SCALAR_BITS + WINDOW_WIDTH - 1) / WINDOW_WIDTH)
+
+/** Number of random private keys to try before giving up on the random number generator. */
+#define KEYGEN_ATTEMPTS_MAX     (64)
+
+/*****************************************************************************
+* Local typedefs
+*****************************************************************************/
+/** Point in affine coordinates. */
+typedef struct
+{
+    uint32_t x[WORDS];
+    uint32_t y[WORDS];
+} affine_t;
+
+/** Point in Jacobian coordinates, (X / Z^2, Y / Z^3). Z is 0 for the point at infinity. */
+typedef struct
+{
+    uint32_t x[WORDS];
+    uint32_t y[WORDS];
+    uint32_t z[WORDS];
+} jacobian_t;
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+/* Field elements and scalars are stored as little-endian 32-bit words. */
+
+/** Field prime, p = 2^256 - 2^224 + 2^192 + 2^96 - 1. */
+static const uint32_t m_p[WORDS] =
+    {0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff};
+
+/** Group order. */
+static const uint32_t m_n[WORDS] =
+    {0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 0xffffffff, 0xffffffff, 0x00000000, 0xffffffff};
+
+/** Curve coefficient b, the curve is y^2 = x^3 - 3x + b. */
+static const uint32_t m_b[WORDS] =
+    {0x27d2604b, 0x3bce3c3e, 0xcc53b0f6, 0x651d06b0, 0x769886bc, 0xb3ebbd55, 0xaa3a93e7, 0x5ac635d8};
+
+/**
+ * Comb table, entry i - 1 is the sum of 2^(COMB_SPACING * j) * G for all bits j set in i. The
+ * first entry is the generator G.
+ */
+static const affine_t m_comb_table[COMB_TABLE_SIZE] =
+{
+    {{0xd898c296, 0xf4a13945, 0x2deb33a0, 0x77037d81,
+      0x63a440f2, 0xf8bce6e5, 0xe12c4247, 0x6b17d1f2},
+     {0x37bf51f5, 0xcbb64068, 0x6b315ece, 0x2bce3357,
+      0x7c0f9e16, 0x8ee7eb4a, 0xfe1a7f9b, 0x4fe342e2}},
+    {{0x071e5c83, 0xeea6bc92, 0x8542a0be, 0x8bd27f19,
+      0x2a58e5b1, 0x20a845b7, 0x5026d73f, 0x54ccc941},
+     {0x140916a1, 0xcfd08ef7, 0x5d8ee496, 0x929e0bcc,
+      0xdad2bf22, 0x3a8f8715, 0xb4514532, 0x1c433f45}},
+    {{0x04bac870, 0xf7d24bb7, 0x3a23c6ab, 0x593a09a0,
+      0xf94c9d1d, 0xdfcc2358, 0x297bed02, 0x3cfa0f87},
+     {0x40f26940, 0xce98a30b, 0x0248a8af, 0x62121c0d,
+      0x8309af9b, 0xa758aa80, 0x70be12c6, 0xe4e37694}},
+    {{0x3ecca7e0, 0xc739a5ea, 0x6743333e, 0xa7d2c98f,
+      0x224d9428, 0x0fef6335, 0x5c792a0c, 0x7ef2ee3c},
+     {0x552ac094, 0x302b22dd, 0xdfbd3d20, 0x81b21450,
+      0xd5e609db, 0xa4f67f51, 0x30acc011, 0xafb68627}},
+    {{0x86ef7d7d, 0xdd37e3ff, 0x088b86db, 0xf6d77c27,
+      0x254c5491, 0x28fe9a4f, 0x6df0fd5e, 0xd6690337},
+     {0xaddad596, 0x9ff04992, 0x9e4373f9, 0xf3d1a7af,
+      0xdf074167, 0xa13e9578, 0xe6d13d22, 0x20e2a53c}},
+    {{0xb0879605, 0xd7b86aee, 0xbe3c7265, 0xa424ec2d,
+      0x12f01e9e, 0x276203c2, 0xb77e46e9, 0xb666fac5},
+     {0x3bf0c52d, 0xf431bb1a, 0x726cd8b6, 0xef46a44a,
+      0xee3de5a9, 0xeb5abc19, 0x90246904, 0x38aaa380}},
+    {{0x525d6abf, 0xaebfd735, 0x96bea25a, 0xc302f8f4,
+      0x544920a4, 0xdb82b3ea, 0x02eadb2e, 0x621c75d1},
+     {0x9ef485f0, 0x8939dc4c, 0x57c46d63, 0x225d03d8,
+      0x522d7f70, 0x4fdac96f, 0xb4fa649d, 0xd7c4a4fe}},
+    {{0x943e832a, 0x9c762ef1, 0x1786df70, 0x07e50ab0,
+      0x2589f18e, 0x90f573a8, 0xa7c2a51a, 0x0d2bf28b},
+     {0x5b20d37c, 0x48263af1, 0x60551446, 0x27ec9db9,
+      0x94b4e7ed, 0x7087a10a, 0x13bd00ac, 0x0cac3f43}},
+    {{0xc0b9372a, 0x8bc659aa, 0xedd9583f, 0xf7659958,
+      0x8c267d88, 0x9f05f94a, 0xc99a739d, 0x00dc46e7},
+     {0xdf55d0f2, 0x4af50a00, 0x8156bf6a, 0xb5eb202d,
+      0x5228c111, 0x40d1e3ab, 0x45793424, 0x0312a557}},
+    {{0x9e6486e0, 0x9d90cda8, 0x1c7522c0, 0xc8a820bd,
+      0x08dcd7ab, 0x867c5580, 0x882a7892, 0x3c510ce2},
+     {0x646d54c6, 0x0e283334, 0xeda4e046, 0x33392776,
+      0x5ba997b0, 0xc3a7fc08, 0x5acf053f, 0xd35e620f}},
+    {{0x7eb8cfee, 0x8d9692f7, 0x0d8c013d, 0x05e3f223,
+      0x84e32e59, 0x76347a52, 0x15b0a1e5, 0x3c53e290},
+     {0xfae798d4, 0x538b7da5, 0x00d23591, 0x1b9f1bd1,
+      0x9a08693f, 0x11a9f072, 0x140efeb3, 0xd30e7cda}},
+    {{0x4dd6c004, 0x81dec926, 0xdad210d5, 0xbfed14fe,
+      0xb96b9911, 0x39f9ff69, 0x29c2024d, 0x02fd7b73},
+     {0x715d29fc, 0x50cfceb8, 0x0c236311, 0xb682b999,
+      0xc7797831, 0x00f34add, 0x59927df3, 0x42ebd3cb}},
+    {{0xf8e8f683, 0x6dfcf787, 0x3f7fbe90, 0x13d72b7a,
+      0x2df232cf, 0xfd426d94, 0x5fe39aad, 0xed84bb42},
+     {0x732995fc, 0x023e67a1, 0x355430e3, 0x67dd0a8e,
+      0x97a1d703, 0x0cf83b61, 0x583c33f2, 0xa3233455}},
+    {{0x68142904, 0x27014ab4, 0x00cfa617, 0xfb500882,
+      0x7009b958, 0x6745ff87, 0xd449242d, 0x9e9889bc},
+     {0x575616c8, 0x035b613b, 0x138e99e2, 0x00855156,
+      0x292e6aa0, 0x94c0d24b, 0x7e79b3a2, 0xd9ba5b68}},
+    {{0x5f165d99, 0xcebbbc7b, 0x8a4eee61, 0x50cc51c1,
+      0x1b4d0d1f, 0xb31d2353, 0x66382ada, 0x95e18452},
+     {0x0a839b5b, 0xacad4f81, 0x4142ff0f, 0xa0a2a96e,
+      0x1f4fa12f, 0x3eaa8289, 0x6b0fb8f3, 0x68d68c8f}},
+    {{0x839bb85f, 0x320f09c3, 0xa050e62c, 0x0101fb06,
+      0x9ad53458, 0x557582c9, 0x1666432b, 0x55d5398d},
+     {0x4fed936f, 0xf7f63118, 0x1833d9e1, 0xd90d6a7f,
+      0x8ebaa72a, 0x059c6a9e, 0x49ff8e2d, 0x576e2290}},
+    {{0x51bbb3f1, 0x9311a269, 0x8d0f4f65, 0xe80f26bd,
+      0x6beccbb9, 0x9d3dc334, 0x101e5de4, 0x54e244d5},
+     {0xf1b19e28, 0xb3ad4c6e, 0x58c2e3b7, 0x4334fbc0,
+      0x35df9c25, 0x19bd4107, 0xec106eb6, 0xd6bbec0e}},
+    {{0xe5046dc5, 0x788251c7, 0xf179327b, 0x12839b95,
+      0x4a8cb46e, 0xf1c05d98, 0x3c00736b, 0x443737cd},
+     {0x12cd8fe5, 0xa760a456, 0x0817bdd9, 0x797489de,
+      0xf42c23e8, 0xc56eb80a, 0xe6fe7af5, 0x83719dd7}},
+    {{0x3fefcfc8, 0xe8881a83, 0xb9b5290b, 0xaea3c9e0,
+      0x771e4688, 0x10b37ecd, 0xd4d021b6, 0xee0816a3},
+     {0xb3a8caa1, 0x8e9929bf, 0xc105f2d1, 0x48915dcf,
+      0xdb49019f, 0x3a5fdf82, 0xad9006e1, 0xc4a438e3}},
+    {{0x87de4b29, 0x5db9620f, 0xd91ecb2e, 0xd7420c18,
+      0x32acf105, 0x301ba1b2, 0x7853a937, 0xdb96bb0c},
+     {0xc359ac34, 0xd84bfef6, 0x64852a1d, 0xab80cef0,
+      0xb9da1717, 0x3fbee4d3, 0x7a13222c, 0xb325074e}},
+    {{0xe83ad2c9, 0x5d6dc503, 0xaed035be, 0xca9f7a1d,
+      0xcbd21e33, 0x552788ac, 0xe09cb9f0, 0x8699dd31},
+     {0x329bf961, 0x38584196, 0xb82a5af9, 0x4cb20e96,
+      0xc72c78c1, 0x24199908, 0xe92859b7, 0x16e65484}},
+    {{0x052fde29, 0x6a201c4b, 0x0031dbb4, 0x6c897123,
+      0x16c1da96, 0x4a759982, 0x2cc67214, 0xeec0b975},
+     {0x812c864e, 0xb908b9f1, 0x8439f6ba, 0x367fb66a,
+      0xf966f329, 0x789d664b, 0xf7f1d283, 0xe02af770}},
+    {{0xdb3038dd, 0xa20a2c70, 0xe99d5c7c, 0x5f0b46d5,
+      0x4b600b83, 0xc9b97d37, 0x3df3245e, 0x186c7f79},
+     {0x4f1ce57f, 0x2af72460, 0x91e2d8ed, 0x9249897f,
+      0x8d2ea797, 0x8139b36a, 0x9ab58913, 0x9c428db8}},
+    {{0x6471aaa0, 0xb4a196fb, 0x1b6b9730, 0xdcbab650,
+      0x295b57d2, 0x7afccc8a, 0x4e33a65d, 0xee2280f4},
+     {0x890fcd12, 0xc47a0803, 0x82604f6b, 0x4e98a98d,
+      0xed5fbbd2, 0x0d598f06, 0xa6a1eb84, 0xce46ec91}},
+    {{0x4be6458d, 0x1f1e4f3f, 0x595e6547, 0x5f72cc22,
+      0x271a93f1, 0x5bc5341e, 0x58a5f263, 0xc62e155c},
+     {0x58ba7ff4, 0x5f6f845a, 0x7e36a6ad, 0x67e1f7dc,
+      0xeeaa4d04, 0xd33a7657, 0x18267e4e, 0xff9f2322}},
+    {{0x4a53789f, 0xd369f11f, 0x3696b437, 0xc7876fb6,
+      0x0baba29a, 0xa0e8f0a7, 0x32f6e514, 0xa0318a5f},
+     {0x11775a08, 0x5c4a43d1, 0x362eebb1, 0x418c507c,
+      0x09a325aa, 0xfd08903f, 0xf0eebb3a, 0xf320b8fc}},
+    {{0xc7644c1d, 0xe33f0255, 0xbb9002d8, 0x4030ecc3,
+      0xf4646f9f, 0xa4486916, 0x959c44fa, 0x5e677d0c},
+     {0xd88b9144, 0xe2e7d7d0, 0x6248f91f, 0x5d93a86f,
+      0x02993aea, 0xe33d0bd5, 0x3100d31e, 0x449f0ce6}},
+    {{0x73cf2678, 0x3fcd925a, 0xa6d0afc7, 0x34ca923b,
+      0x3067791f, 0x9011091d, 0x5a7941e4, 0x8c568874},
+     {0xfc339800, 0x34d37180, 0x595c51f4, 0x7744316b,
+      0xe88c6420, 0xf2ddb693, 0x5bad14d2, 0xfb3a48b1}},
+    {{0xfdaab256, 0x52df1588, 0x3127354c, 0x68c0cd44,
+      0xa591f853, 0x2a849471, 0x93d0cb92, 0xe4da88e9},
+     {0x1639c624, 0x6d1ea35d, 0x263707ba, 0x60fe2a36,
+      0xd0f3bc51, 0x97fc50de, 0x10062e80, 0xf7fa4d15}},
+    {{0x024c168d, 0xc429a113, 0x3feaa272, 0xb6c935fb,
+      0xe639ec09, 0xb58a6071, 0xf9c13de7, 0x4b59253a},
+     {0xfbfb8955, 0x6d2d68f2, 0x50723fe2, 0xf0064c12,
+      0x01f185f5, 0xe85d7820, 0x7fa79c93, 0xaa0307bf}},
+    {{0x5b696527, 0x2e75a266, 0x5a00169c, 0x1a2530b0,
+      0x4286fb42, 0x76c4c180, 0x8e831d5b, 0x825f0194},
+     {0xef703739, 0xdbf0a11f, 0xce5b106a, 0x106f9bc4,
+      0x24111150, 0x61794c4f, 0xbc723a17, 0x435872fe}},
+};
+
+/*****************************************************************************
+* Field arithmetic
+*****************************************************************************/
+static void fe_from_bytes(uint32_t * p_r, const uint8_t * p_bytes)
+{
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        const uint8_t * p_word = &p_bytes[BYTES - 4 * (i + 1)];
+        p_r[i] = ((uint32_t) p_word[0] << 24) | ((uint32_t) p_word[1] << 16) |
+                 ((uint32_t) p_word[2] << 8) | (uint32_t) p_word[3];
+    }
+}
+
+static void fe_to_bytes(uint8_t * p_bytes, const uint32_t * p_a)
+{
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        uint8_t * p_word = &p_bytes[BYTES - 4 * (i + 1)];
+        p_word[0] = (uint8_t) (p_a[i] >> 24);
+        p_word[1] = (uint8_t) (p_a[i] >> 16);
+        p_word[2] = (uint8_t) (p_a[i] >> 8);
+        p_word[3] = (uint8_t) p_a[i];
+    }
+}
+
+static bool fe_is_zero(const uint32_t * p_a)
+{
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        bits |= p_a[i];
+    }
+    return (bits == 0);
+}
+
+/* Returns all ones if a is zero, and zero otherwise. */
+static uint32_t fe_zero_mask(const uint32_t * p_a)
+{
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        bits |= p_a[i];
+    }
+    return ((bits | (0u - bits)) >> 31) - 1;
+}
+
+/* Returns whether a < b. */
+static bool vli_less_than(const uint32_t * p_a, const uint32_t * p_b)
+{
+    uint32_t borrow = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        uint64_t diff = (uint64_t) p_a[i] - p_b[i] - borrow;
+        borrow = (uint32_t) (diff >> 32) & 1;
+    }
+    return (borrow != 0);
+}
+
+/* Subtracts p from r if r, with the carry out of it, is at least p. */
+static void fe_reduce_once(uint32_t * p_r, uint32_t carry)
+{
+    uint32_t t[WORDS];
+    uint32_t borrow = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        uint64_t diff = (uint64_t) p_r[i] - m_p[i] - borrow;
+        t[i] = (uint32_t) diff;
+        borrow = (uint32_t) (diff >> 32) & 1;
+    }
+
+    /* Keep the difference if there was a carry out of r, or if r >= p. */
+    uint32_t mask = 0u - ((carry | (borrow ^ 1)) & 1);
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        p_r[i] = (t[i] & mask) | (p_r[i] & ~mask);
+    }
+}
+
+static void fe_add(uint32_t * p_r, const uint32_t * p_a, const uint32_t * p_b)
+{
+    uint32_t carry = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        uint64_t sum = (uint64_t) p_a[i] + p_b[i] + carry;
+        p_r[i] = (uint32_t) sum;
+        carry = (uint32_t) (sum >> 32);
+    }
+    fe_reduce_once(p_r, carry);
+}
+
+static void fe_sub(uint32_t * p_r, const uint32_t * p_a, const uint32_t * p_b)
+{
+    uint32_t borrow = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        uint64_t diff = (uint64_t) p_a[i] - p_b[i] - borrow;
+        p_r[i] = (uint32_t) diff;
+        borrow = (uint32_t) (diff >> 32) & 1;
+    }
+
+    /* Add p back on underflow */
+    uint32_t mask = 0u - borrow;
+    uint32_t carry = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        uint64_t sum = (uint64_t) p_r[i] + (m_p[i] & mask) + carry;
+        p_r[i] = (uint32_t) sum;
+        carry = (uint32_t) (sum >> 32);
+    }
+}
+
+/* Reduces a 512-bit product modulo p, with the fast reduction for the NIST P-256 prime. */
+static void fe_reduce(uint32_t * p_r, const uint32_t * p_c)
+{
+    int64_t acc[WORDS];
+    acc[0] = (int64_t) p_c[0] + p_c[8] + p_c[9] - p_c[11] - p_c[12] - p_c[13] - p_c[14];
+    acc[1] = (int64_t) p_c[1] + p_c[9] + p_c[10] - p_c[12] - p_c[13] - p_c[14] - p_c[15];
+    acc[2] = (int64_t) p_c[2] + p_c[10] + p_c[11] - p_c[13] - p_c[14] - p_c[15];
+    acc[3] = (int64_t) p_c[3] + 2 * ((int64_t) p_c[11] + p_c[12]) + p_c[13] - p_c[15] - p_c[8] - p_c[9];
+    acc[4] = (int64_t) p_c[4] + 2 * ((int64_t) p_c[12] + p_c[13]) + p_c[14] - p_c[9] - p_c[10];
+    acc[5] = (int64_t) p_c[5] + 2 * ((int64_t) p_c[13] + p_c[14]) + p_c[15] - p_c[10] - p_c[11];
+    acc[6] = (int64_t) p_c[6] + 3 * (int64_t) p_c[14] + 2 * (int64_t) p_c[15] + p_c[13] - p_c[8] - p_c[9];
+    acc[7] = (int64_t) p_c[7] + 3 * (int64_t) p_c[15] + p_c[8] - p_c[10] - p_c[11] - p_c[12] - p_c[13];
+
+    int64_t carry = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        carry += acc[i];
+        p_r[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+
+    /* Fold the carry back in, 2^256 = 2^224 - 2^192 - 2^96 + 1 (mod p) */
+    while (carry != 0)
+    {
+        int64_t fold = carry;
+        carry = 0;
+        for (uint32_t i = 0; i < WORDS; ++i)
+        {
+            carry += p_r[i];
+            if (i == 0 || i == 7)
+            {
+                carry += fold;
+            }
+            else if (i == 3 || i == 6)
+            {
+                carry -= fold;
+            }
+            p_r[i] = (uint32_t) carry;
+            carry >>= 32;
+        }
+    }
+
+    fe_reduce_once(p_r, 0);
+}
+
+static void fe_mul(uint32_t * p_r, const uint32_t * p_a, const uint32_t * p_b)
+{
+    uint32_t product[2 * WORDS];
+    uint64_t carry;
+
+    memset(product, 0, sizeof(product));
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        carry = 0;
+        for (uint32_t j = 0; j < WORDS; ++j)
+        {
+            carry += (uint64_t) p_a[i] * p_b[j] + product[i + j];
+            product[i + j] = (uint32_t) carry;
+            carry >>= 32;
+        }
+        product[i + WORDS] = (uint32_t) carry;
+    }
+
+    fe_reduce(p_r, product);
+}
+
+static void fe_sqr(uint32_t * p_r, const uint32_t * p_a)
+{
+    uint32_t product[2 * WORDS];
+    uint64_t carry;
+
+    /* Cross products a[i] * a[j] for i < j, once */
+    memset(product, 0, sizeof(product));
+    for (uint32_t i = 0; i < WORDS - 1; ++i)
+    {
+        carry = 0;
+        for (uint32_t j = i + 1; j < WORDS; ++j)
+        {
+            carry += (uint64_t) p_a[i] * p_a[j] + product[i + j];
+            product[i + j] = (uint32_t) carry;
+            carry >>= 32;
+        }
+        product[i + WORDS] = (uint32_t) carry;
+    }
+
+    /* Doubled, plus the squares a[i]^2 */
+    uint32_t top = 0;
+    carry = 0;
+    for (uint32_t i = 0; i < 2 * WORDS; ++i)
+    {
+        uint32_t doubled = (product[i] << 1) | top;
+        top = product[i] >> 31;
+        uint64_t square = (uint64_t) p_a[i / 2] * p_a[i / 2];
+        carry += doubled + ((i & 1) ? (square >> 32) : (uint32_t) square);
+        product[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+
+    fe_reduce(p_r, product);
+}
+
+/* Squares a n times. */
+static void fe_sqr_n(uint32_t * p_r, const uint32_t * p_a, uint32_t n)
+{
+    fe_sqr(p_r, p_a);
+    for (uint32_t i = 1; i < n; ++i)
+    {
+        fe_sqr(p_r, p_r);
+    }
+}
+
+/* Inverts a by raising it to p - 2. */
+static void fe_inv(uint32_t * p_r, const uint32_t * p_a)
+{
+    /* xN = a^(2^N - 1) */
+    uint32_t x2[WORDS], x3[WORDS], x6[WORDS], x12[WORDS], x15[WORDS], x30[WORDS], x32[WORDS];
+    uint32_t t[WORDS];
+
+    fe_sqr(t, p_a);
+    fe_mul(x2, t, p_a);
+    fe_sqr(t, x2);
+    fe_mul(x3, t, p_a);
+    fe_sqr_n(t, x3, 3);
+    fe_mul(x6, t, x3);
+    fe_sqr_n(t, x6, 6);
+    fe_mul(x12, t, x6);
+    fe_sqr_n(t, x12, 3);
+    fe_mul(x15, t, x3);
+    fe_sqr_n(t, x15, 15);
+    fe_mul(x30, t, x15);
+    fe_sqr_n(t, x30, 2);
+    fe_mul(x32, t, x2);
+
+    /* p - 2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd */
+    fe_sqr_n(t, x32, 32);
+    fe_mul(t, t, p_a);
+    fe_sqr_n(t, t, 128);
+    fe_mul(t, t, x32);
+    fe_sqr_n(t, t, 32);
+    fe_mul(t, t, x32);
+    fe_sqr_n(t, t, 30);
+    fe_mul(t, t, x30);
+    fe_sqr_n(t, t, 2);
+    fe_mul(p_r, t, p_a);
+}
+
+/* Sets r to a if mask is all ones, keeps r if mask is zero. */
+static void fe_cmov(uint32_t * p_r, const uint32_t * p_a, uint32_t mask)
+{
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        p_r[i] = (p_a[i] & mask) | (p_r[i] & ~mask);
+    }
+}
+
+/*****************************************************************************
+* Point arithmetic
+*****************************************************************************/
+static void point_lift(jacobian_t * p_r, const affine_t * p_a)
+{
+    memcpy(p_r->x, p_a->x, sizeof(p_r->x));
+    memcpy(p_r->y, p_a->y, sizeof(p_r->y));
+    memset(p_r->z, 0, sizeof(p_r->z));
+    p_r->z[0] = 1;
+}
+
+static bool point_is_infinity(const jacobian_t * p_a)
+{
+    return fe_is_zero(p_a->z);
+}
+
+/* r = 2a, with the doubling formula for a = -3 (dbl-2001-b). */
+static void point_double(jacobian_t * p_r, const jacobian_t * p_a)
+{
+    uint32_t delta[WORDS], gamma[WORDS], beta[WORDS], alpha[WORDS], t[WORDS], u[WORDS];
+
+    fe_sqr(delta, p_a->z);
+    fe_sqr(gamma, p_a->y);
+    fe_mul(beta, p_a->x, gamma);
+
+    /* alpha = 3 * (X - delta) * (X + delta) */
+    fe_sub(t, p_a->x, delta);
+    fe_add(u, p_a->x, delta);
+    fe_mul(t, t, u);
+    fe_add(alpha, t, t);
+    fe_add(alpha, alpha, t);
+
+    /* Z3 = (Y + Z)^2 - gamma - delta */
+    fe_add(t, p_a->y, p_a->z);
+    fe_sqr(t, t);
+    fe_sub(t, t, gamma);
+    fe_sub(p_r->z, t, delta);
+
+    /* X3 = alpha^2 - 8 * beta */
+    fe_add(beta, beta, beta);
+    fe_add(beta, beta, beta);
+    fe_sqr(t, alpha);
+    fe_add(u, beta, beta);
+    fe_sub(p_r->x, t, u);
+
+    /* Y3 = alpha * (4 * beta - X3) - 8 * gamma^2 */
+    fe_sub(t, beta, p_r->x);
+    fe_mul(t, alpha, t);
+    fe_sqr(gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_sub(p_r->y, t, gamma);
+}
+
+/* r = a + b, with the mixed addition formula (madd-2007-bl) and without branches. a must not be the
+ * point at infinity. Gives the point at infinity for a = -b, and returns all ones for a = b, where
+ * the result is not valid. */
+static uint32_t point_add_mixed_ct(jacobian_t * p_r, const jacobian_t * p_a, const affine_t * p_b)
+{
+    uint32_t z1z1[WORDS], h[WORDS], hh[WORDS], i[WORDS], j[WORDS], r[WORDS], v[WORDS], t[WORDS];
+    jacobian_t sum;
+
+    fe_sqr(z1z1, p_a->z);
+    fe_mul(h, p_b->x, z1z1);
+    fe_sub(h, h, p_a->x);
+
+    /* r = 2 * (Y2 * Z1^3 - Y1) */
+    fe_mul(t, p_a->z, z1z1);
+    fe_mul(t, t, p_b->y);
+    fe_sub(t, t, p_a->y);
+    fe_add(r, t, t);
+
+    uint32_t is_double = fe_zero_mask(h) & fe_zero_mask(r);
+
+    fe_sqr(hh, h);
+    fe_add(i, hh, hh);
+    fe_add(i, i, i);
+    fe_mul(j, h, i);
+    fe_mul(v, p_a->x, i);
+
+    /* X3 = r^2 - J - 2 * V */
+    fe_sqr(sum.x, r);
+    fe_sub(sum.x, sum.x, j);
+    fe_sub(sum.x, sum.x, v);
+    fe_sub(sum.x, sum.x, v);
+
+    /* Y3 = r * (V - X3) - 2 * Y1 * J */
+    fe_sub(t, v, sum.x);
+    fe_mul(sum.y, r, t);
+    fe_mul(t, p_a->y, j);
+    fe_sub(sum.y, sum.y, t);
+    fe_sub(sum.y, sum.y, t);
+
+    /* Z3 = (Z1 + H)^2 - Z1Z1 - HH, which is 0 for H = 0 */
+    fe_add(t, p_a->z, h);
+    fe_sqr(t, t);
+    fe_sub(t, t, z1z1);
+    fe_sub(sum.z, t, hh);
+
+    *p_r = sum;
+    return is_double;
+}
+
+/* r = a + b. a must not be the point at infinity. */
+static void point_add_mixed(jacobian_t * p_r, const jacobian_t * p_a, const affine_t * p_b)
+{
+    jacobian_t a = *p_a;
+    if (point_add_mixed_ct(p_r, &a, p_b))
+    {
+        point_double(p_r, &a);
+    }
+}
+
+static void point_to_affine(affine_t * p_r, const jacobian_t * p_a, const uint32_t * p_z_inv)
+{
+    uint32_t t[WORDS];
+    fe_sqr(t, p_z_inv);
+    fe_mul(p_r->x, p_a->x, t);
+    fe_mul(t, t, p_z_inv);
+    fe_mul(p_r->y, p_a->y, t);
+}
+
+/* Converts several points to affine coordinates with a single inversion. */
+static void points_to_affine(affine_t * p_r, const jacobian_t * p_a, uint32_t count)
+{
+    uint32_t prefix[WINDOW_TABLE_SIZE][WORDS];
+    uint32_t inv[WORDS], z_inv[WORDS];
+
+    NRF_MESH_ASSERT(count > 0 && count <= WINDOW_TABLE_SIZE);
+
+    memcpy(prefix[0], p_a[0].z, sizeof(prefix[0]));
+    for (uint32_t k = 1; k < count; ++k)
+    {
+        fe_mul(prefix[k], prefix[k - 1], p_a[k].z);
+    }
+
+    fe_inv(inv, prefix[count - 1]);
+    for (uint32_t k = count - 1; k > 0; --k)
+    {
+        fe_mul(z_inv, inv, prefix[k - 1]);
+        fe_mul(inv, inv, p_a[k].z);
+        point_to_affine(&p_r[k], &p_a[k], z_inv);
+    }
+    point_to_affine(&p_r[0], &p_a[0], inv);
+}
+
+static bool point_is_on_curve(const affine_t * p_a)
+{
+    uint32_t lhs[WORDS], rhs[WORDS], t[WORDS];
+
+    if (!vli_less_than(p_a->x, m_p) || !vli_less_than(p_a->y, m_p))
+    {
+        return false;
+    }
+
+    fe_sqr(lhs, p_a->y);
+
+    /* x^3 - 3x + b */
+    fe_sqr(rhs, p_a->x);
+    fe_mul(rhs, rhs, p_a->x);
+    fe_add(t, p_a->x, p_a->x);
+    fe_add(t, t, p_a->x);
+    fe_sub(rhs, rhs, t);
+    fe_add(rhs, rhs, m_b);
+
+    return (memcmp(lhs, rhs, sizeof(lhs)) == 0);
+}
+
+/*****************************************************************************
+* Scalar multiplication
+*****************************************************************************/
+static bool scalar_is_valid(const uint32_t * p_k)
+{
+    return (!fe_is_zero(p_k) && vli_less_than(p_k, m_n));
+}
+
+static uint32_t scalar_bit_get(const uint32_t * p_k, uint32_t bit)
+{
+    return (bit < SCALAR_BITS) ? ((p_k[bit / 32] >> (bit % 32)) & 1) : 0;
+}
+
+/* Copies the comb table entry for the index to r, reading every entry. Index 0 gives the first entry. */
+static void comb_entry_select(affine_t * p_r, uint32_t index)
+{
+    *p_r = m_comb_table[0];
+    for (uint32_t k = 1; k < COMB_TABLE_SIZE; ++k)
+    {
+        /* All ones if the entry is the one at the index */
+        uint32_t mask = 0u - (((((k + 1) ^ index) - 1) >> 31) & 1);
+        fe_cmov(p_r->x, m_comb_table[k].x, mask);
+        fe_cmov(p_r->y, m_comb_table[k].y, mask);
+    }
+}
+
+/* r = kG with the fixed-base comb. The key dependent steps are done for every column. */
+static void point_mul_base(affine_t * p_r, const uint32_t * p_k)
+{
+    jacobian_t acc;
+    jacobian_t sum;
+    jacobian_t lifted;
+    affine_t entry;
+    uint32_t acc_is_infinity = 0xffffffff;
+    uint32_t z_inv[WORDS];
+
+    memset(&acc, 0, sizeof(acc));
+
+    for (int32_t column = COMB_SPACING - 1; column >= 0; --column)
+    {
+        point_double(&acc, &acc);
+
+        uint32_t index = 0;
+        for (uint32_t tooth = 0; tooth < COMB_TEETH; ++tooth)
+        {
+            index |= scalar_bit_get(p_k, tooth * COMB_SPACING + (uint32_t) column) << tooth;
+        }
+
+        comb_entry_select(&entry, index);
+        point_lift(&lifted, &entry);
+        point_add_mixed(&sum, &acc, &entry);
+
+        /* The sum is only valid when the accumulator is not the point at infinity */
+        uint32_t use_entry = acc_is_infinity;
+        fe_cmov(sum.x, lifted.x, use_entry);
+        fe_cmov(sum.y, lifted.y, use_entry);
+        fe_cmov(sum.z, lifted.z, use_entry);
+
+        /* Nothing is added for a zero index */
+        uint32_t add = 0u - ((index | (0u - index)) >> 31);
+        fe_cmov(acc.x, sum.x, add);
+        fe_cmov(acc.y, sum.y, add);
+        fe_cmov(acc.z, sum.z, add);
+        acc_is_infinity &= ~add;
+    }
+
+    /* Not reached for valid scalars, k < n */
+    NRF_MESH_ASSERT(!point_is_infinity(&acc));
+
+    fe_inv(z_inv, acc.z);
+    point_to_affine(p_r, &acc, z_inv);
+}
+
+/* Copies the entry for the index from a table of odd multiples to r, reading every entry. */
+static void window_entry_select(affine_t * p_r, const affine_t * p_table, uint32_t index)
+{
+    *p_r = p_table[0];
+    for (uint32_t k = 1; k < WINDOW_TABLE_SIZE; ++k)
+    {
+        /* All ones if the entry is the one at the index */
+        uint32_t mask = 0u - ((((k ^ index) - 1) >> 31) & 1);
+        fe_cmov(p_r->x, p_table[k].x, mask);
+        fe_cmov(p_r->y, p_table[k].y, mask);
+    }
+}
+
+/*
+ * Gets the table entry for a signed window digit of the odd scalar k.
+ *
+ * The digits are d_i = (((k >> (w * i)) mod 2^(w + 1)) | 1) - 2^w. They are odd, so none of them are
+ * zero, and k = sum(d_i * 2^(w * i)) + 2^(w * WINDOW_DIGITS).
+ */
+static void window_digit_entry_get(affine_t * p_r, const affine_t * p_table, const uint32_t * p_k, uint32_t digit)
+{
+    uint32_t window = 1;
+    for (uint32_t bit = 1; bit <= WINDOW_WIDTH; ++bit)
+    {
+        window |= scalar_bit_get(p_k, digit * WINDOW_WIDTH + bit) << bit;
+    }
+
+    /* The entry for |d| is at |d| / 2, the digit is negative if the top window bit is clear */
+    uint32_t negate = 0u - (((window >> WINDOW_WIDTH) & 1) ^ 1);
+    uint32_t index = ((window >> 1) & (WINDOW_TABLE_SIZE - 1)) ^ (negate & (WINDOW_TABLE_SIZE - 1));
+    window_entry_select(p_r, p_table, index);
+
+    uint32_t neg_y[WORDS];
+    fe_sub(neg_y, m_p, p_r->y);
+    fe_cmov(p_r->y, neg_y, negate);
+}
+
+/* r = kP with a regular signed window of k. Every digit is non-zero, so the same doublings and
+ * additions are done for every scalar, and the table entries are selected without branches. */
+static bool point_mul(affine_t * p_r, const affine_t * p_point, const uint32_t * p_k)
+{
+    jacobian_t odd_multiples[WINDOW_TABLE_SIZE];
+    affine_t table[WINDOW_TABLE_SIZE];
+    affine_t twice;
+    affine_t entry;
+    jacobian_t acc;
+    jacobian_t sum;
+    uint32_t k[WORDS];
+    uint32_t t[WORDS];
+    uint32_t z_inv[WORDS];
+
+    /* Table of P, 3P, 5P, ... */
+    point_lift(&odd_multiples[0], p_point);
+    point_double(&acc, &odd_multiples[0]);
+    fe_inv(z_inv, acc.z);
+    point_to_affine(&twice, &acc, z_inv);
+    for (uint32_t i = 1; i < WINDOW_TABLE_SIZE; ++i)
+    {
+        point_add_mixed(&odd_multiples[i], &odd_multiples[i - 1], &twice);
+    }
+    points_to_affine(table, odd_multiples, WINDOW_TABLE_SIZE);
+
+    /* The digits need an odd scalar, use n - k for an even k and negate the result: kP = -(n - k)P */
+    uint32_t borrow = 0;
+    for (uint32_t i = 0; i < WORDS; ++i)
+    {
+        uint64_t diff = (uint64_t) m_n[i] - p_k[i] - borrow;
+        t[i] = (uint32_t) diff;
+        borrow = (uint32_t) (diff >> 32) & 1;
+    }
+    uint32_t negate = (p_k[0] & 1) - 1;
+    memcpy(k, p_k, sizeof(k));
+    fe_cmov(k, t, negate);
+
+    /* The top digit is 1 */
+    point_lift(&acc, &table[0]);
+    for (int32_t digit = WINDOW_DIGITS - 1; digit >= 0; --digit)
+    {
+        for (uint32_t i = 0; i < WINDOW_WIDTH; ++i)
+        {
+            point_double(&acc, &acc);
+        }
+
+        window_digit_entry_get(&entry, table, k, (uint32_t) digit);
+
+        uint32_t is_double = point_add_mixed_ct(&sum, &acc, &entry);
+
+        /* Before the last digit the accumulator is (16 * m)P with m < n / 16, so only the last
+         * addition can have the entry as its other operand. */
+        if (digit == 0)
+        {
+            point_double(&acc, &acc);
+            fe_cmov(sum.x, acc.x, is_double);
+            fe_cmov(sum.y, acc.y, is_double);
+            fe_cmov(sum.z, acc.z, is_double);
+        }
+        acc = sum;
+    }
+
+    memset(k, 0, sizeof(k));
+
+    /* Not reached for valid scalars and points on the curve */
+    if (point_is_infinity(&acc))
+    {
+        return false;
+    }
+
+    fe_inv(z_inv, acc.z);
+    point_to_affine(p_r, &acc, z_inv);
+
+    fe_sub(t, m_p, p_r->y);
+    fe_cmov(p_r->y, t, negate);
+    return true;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+uint32_t prov_ecc_p256_public_key_calculate(const uint8_t * p_private, uint8_t * p_public)
+{
+    uint32_t k[WORDS];
+    affine_t point;
+
+    fe_from_bytes(k, p_private);
+    if (!scalar_is_valid(k))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    point_mul_base(&point, k);
+    fe_to_bytes(&p_public[0], point.x);
+    fe_to_bytes(&p_public[BYTES], point.y);
+
+    memset(k, 0, sizeof(k));
+    return NRF_SUCCESS;
+}
+
+uint32_t prov_ecc_p256_keys_generate(uint8_t * p_public, uint8_t * p_private)
+{
+    for (uint32_t i = 0; i < KEYGEN_ATTEMPTS_MAX; ++i)
+    {
+        rand_hw_rng_get(p_private, NRF_MESH_PROV_PRIVKEY_SIZE);
+        if (prov_ecc_p256_public_key_calculate(p_private, p_public) == NRF_SUCCESS)
+        {
+            return NRF_SUCCESS;
+        }
+    }
+
+    return NRF_ERROR_INTERNAL;
+}
+
+uint32_t prov_ecc_p256_shared_secret_calculate(const uint8_t * p_peer_public,
+                                               const uint8_t * p_private,
+                                               uint8_t * p_shared_secret)
+{
+    uint32_t k[WORDS];
+    affine_t peer;
+    affine_t shared;
+
+    fe_from_bytes(peer.x, &p_peer_public[0]);
+    fe_from_bytes(peer.y, &p_peer_public[BYTES]);
+    fe_from_bytes(k, p_private);
+
+    uint32_t status = NRF_ERROR_INTERNAL;
+    if (point_is_on_curve(&peer) && scalar_is_valid(k) && point_mul(&shared, &peer, k))
+    {
+        fe_to_bytes(p_shared_secret, shared.x);
+        status = NRF_SUCCESS;
+    }
+
+    memset(k, 0, sizeof(k));
+    return status;
+}
+
+bool prov_ecc_p256_public_key_is_valid(const uint8_t * p_public)
+{
+    affine_t point;
+    fe_from_bytes(point.x, &p_public[0]);
+    fe_from_bytes(point.y, &p_public[BYTES]);
+    return point_is_on_curve(&point);
+}
+
+const prov_utils_ecc_backend_t * prov_ecc_p256_backend_get(void)
+{
+    static const prov_utils_ecc_backend_t backend =
+    {
+        .keys_generate = prov_ecc_p256_keys_generate,
+        .shared_secret_calculate = prov_ecc_p256_shared_secret_calculate,
+        .public_key_is_valid = prov_ecc_p256_public_key_is_valid
+    };
+    return &backend;
+}
@@ -0,0 +1,156 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "prov_keypool.h"
+
+#include "nrf_error.h"
+#include "nrf_mesh.h"
+#include "nrf_mesh_assert.h"
+#include "bearer_event.h"
+#include "prov_utils.h"
+#include "toolchain.h"
+#include "log.h"
+
+/*****************************************************************************
+* Local type definitions
+*****************************************************************************/
+typedef struct
+{
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+} keypair_t;
+
+NRF_MESH_STATIC_ASSERT(NRF_MESH_PROV_KEYPOOL_SIZE > 0);
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+static keypair_t m_keypairs[NRF_MESH_PROV_KEYPOOL_SIZE];
+static uint32_t m_count;
+static prov_keypool_available_cb_t m_available_cb;
+static bearer_event_flag_t m_available_flag = BEARER_EVENT_FLAG_INVALID;
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+/* Passes the available keypair on in the bearer event context, where the pool users run. */
+static bool available_notify(void)
+{
+    if (m_available_cb != NULL)
+    {
+        m_available_cb();
+    }
+    return true;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void prov_keypool_init(prov_keypool_available_cb_t available_cb)
+{
+    if (m_available_flag == BEARER_EVENT_FLAG_INVALID)
+    {
+        m_available_flag = bearer_event_flag_add(available_notify);
+    }
+
+    m_available_cb = available_cb;
+}
+
+bool prov_keypool_refill(void)
+{
+    if (m_available_flag == BEARER_EVENT_FLAG_INVALID || m_count == NRF_MESH_PROV_KEYPOOL_SIZE)
+    {
+        return true;
+    }
+
+    /* Generate outside of the pool, a keypair may be taken while this is running. */
+    keypair_t keypair;
+    uint32_t status = prov_utils_keys_generate(keypair.public_key, keypair.private_key);
+    if (status != NRF_SUCCESS)
+    {
+        __LOG(LOG_SRC_PROV, LOG_LEVEL_ERROR, "Keypair generation failed: %u\n", status);
+        return true;
+    }
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    NRF_MESH_ASSERT(m_count < NRF_MESH_PROV_KEYPOOL_SIZE);
+    m_keypairs[m_count] = keypair;
+    uint32_t count = ++m_count;
+    _ENABLE_IRQS(was_masked);
+
+    memset(&keypair, 0, sizeof(keypair));
+
+    if (count == 1)
+    {
+        bearer_event_flag_set(m_available_flag);
+    }
+
+    return (count == NRF_MESH_PROV_KEYPOOL_SIZE);
+}
+
+uint32_t prov_keypool_get(uint8_t * p_public, uint8_t * p_private)
+{
+    if (p_public == NULL || p_private == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    uint32_t status = NRF_ERROR_NOT_FOUND;
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    if (m_count > 0)
+    {
+        m_count--;
+        memcpy(p_public, m_keypairs[m_count].public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+        memcpy(p_private, m_keypairs[m_count].private_key, NRF_MESH_PROV_PRIVKEY_SIZE);
+        memset(&m_keypairs[m_count], 0, sizeof(m_keypairs[m_count]));
+        status = NRF_SUCCESS;
+    }
+    _ENABLE_IRQS(was_masked);
+
+    return status;
+}
+
+uint32_t prov_keypool_count_get(void)
+{
+    return m_count;
+}
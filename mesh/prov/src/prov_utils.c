@@ -48,6 +48,10 @@
 #include "uECC.h"
 #include "mesh_config.h"
 #include "mesh_opt_prov.h"
+#include "nrf_mesh_config_prov.h"
+#if NRF_MESH_PROV_ECC_P256_ENABLE
+#include "prov_ecc_p256.h"
+#endif
 
 #define CONFIRMATION_KEY_INFO        (const uint8_t *) "prck"
 #define CONFIRMATION_KEY_INFO_LENGTH 4
@@ -108,6 +112,61 @@ MESH_CONFIG_ENTRY(ecdh_offloading,
                   ecdh_deleter,
                   true);
 
+/*****************************************************************************
+ * micro-ecc backend
+ *****************************************************************************/
+#if !NRF_MESH_PROV_ECC_P256_ENABLE
+static uint32_t uecc_keys_generate(uint8_t * p_public, uint8_t * p_private)
+{
+#if NRF_MESH_UECC_ENABLE
+    return uECC_make_key(p_public, p_private, uECC_secp256r1()) == 1 ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+static uint32_t uecc_shared_secret_calculate(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared_secret)
+{
+#if NRF_MESH_UECC_ENABLE
+    if (!uECC_shared_secret(p_peer_public, p_private, p_shared_secret, uECC_secp256r1()))
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+static bool uecc_public_key_is_valid(const uint8_t * p_public)
+{
+    return uECC_valid_public_key(p_public, uECC_secp256r1());
+}
+
+static const prov_utils_ecc_backend_t m_uecc_backend =
+{
+    .keys_generate = uecc_keys_generate,
+    .shared_secret_calculate = uecc_shared_secret_calculate,
+    .public_key_is_valid = uecc_public_key_is_valid
+};
+#endif
+
+static const prov_utils_ecc_backend_t * mp_ecc_backend;
+
+static const prov_utils_ecc_backend_t * ecc_backend_get(void)
+{
+    if (mp_ecc_backend != NULL)
+    {
+        return mp_ecc_backend;
+    }
+#if NRF_MESH_PROV_ECC_P256_ENABLE
+    return prov_ecc_p256_backend_get();
+#else
+    return &m_uecc_backend;
+#endif
+}
+
 static void create_confirmation_salt(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_confirmation_salt)
 {
     /* ConfirmationInputs = AES-CMAC(AES-CMAC(
@@ -166,6 +225,11 @@ static void oob_gen_alphanumeric(uint8_t * p_auth_value, uint8_t characters)
 }
 
 
+void prov_utils_ecc_backend_set(const prov_utils_ecc_backend_t * p_backend)
+{
+    mp_ecc_backend = p_backend;
+}
+
 uint32_t prov_utils_opt_set(nrf_mesh_opt_id_t id, const nrf_mesh_opt_t * p_opt)
 {
     if (id == NRF_MESH_OPT_PROV_ECDH_OFFLOADING)
@@ -225,11 +289,7 @@ void prov_utils_authentication_values_derive(const nrf_mesh_prov_ctx_t * p_ctx,
 
 uint32_t prov_utils_keys_generate(uint8_t * p_public, uint8_t * p_private)
 {
-#if NRF_MESH_UECC_ENABLE
-    return uECC_make_key(p_public, p_private, uECC_secp256r1()) == 1 ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
-#else
-    return NRF_ERROR_NOT_SUPPORTED;
-#endif
+    return ecc_backend_get()->keys_generate(p_public, p_private);
 }
 
 void prov_utils_derive_keys(const nrf_mesh_prov_ctx_t * p_ctx,
@@ -281,24 +341,15 @@ void prov_utils_derive_keys(const nrf_mesh_prov_ctx_t * p_ctx,
 
 bool prov_utils_is_valid_public_key(const uint8_t * p_public_key)
 {
-    return uECC_valid_public_key(p_public_key, uECC_secp256r1());
+    return ecc_backend_get()->public_key_is_valid(p_public_key);
 }
 
 uint32_t prov_utils_calculate_shared_secret(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_shared_secret)
 {
-#if NRF_MESH_UECC_ENABLE
     /* We should have validated the public key before this point. */
     NRF_MESH_ASSERT_DEBUG(prov_utils_is_valid_public_key(p_ctx->peer_public_key));
 
-    if (!uECC_shared_secret(p_ctx->peer_public_key, p_ctx->p_private_key, p_shared_secret, uECC_secp256r1()))
-    {
-        return NRF_ERROR_INTERNAL;
-    }
-
-    return NRF_SUCCESS;
-#else
-    return NRF_ERROR_NOT_SUPPORTED;
-#endif
+    return ecc_backend_get()->shared_secret_calculate(p_ctx->peer_public_key, p_ctx->p_private_key, p_shared_secret);
 }
 
 void prov_utils_generate_oob_data(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_auth_value)
@@ -52,6 +52,32 @@
 #define NRF_MESH_SERIAL_BEACON_SLOTS 1
 #endif
 
+/**
+ * Send queued packets back to back.
+ *
+ * When enabled, the UART transmit interrupt starts the next queued packet as soon as the current
+ * one is done, instead of stopping the transmitter and waiting for the bearer event handler to
+ * restart it. This removes the idle gap between packets, and lets the host keep several commands
+ * in flight.
+ */
+#ifndef NRF_MESH_SERIAL_TX_BURST
+#define NRF_MESH_SERIAL_TX_BURST 0
+#endif
+
+/**
+ * Number of maximum length packets that fit in the serial receive buffer. Must be at least 2.
+ */
+#ifndef NRF_MESH_SERIAL_RX_PACKET_COUNT
+#define NRF_MESH_SERIAL_RX_PACKET_COUNT 2
+#endif
+
+/**
+ * Number of maximum length packets that fit in the serial transmit buffer. Must be at least 2.
+ */
+#ifndef NRF_MESH_SERIAL_TX_PACKET_COUNT
+#define NRF_MESH_SERIAL_TX_PACKET_COUNT 2
+#endif
+
 /** @} end of NRF_MESH_CONFIG_SERIAL */
 
 
@@ -68,6 +68,10 @@
 #define SERIAL_OPCODE_CMD_DEVICE_BEACON_PARAMS_GET            (0x13) /**< Params: @ref serial_cmd_device_beacon_params_get_t */
 #define SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_GET        (0x14) /**< Params: None. */
 #define SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_CLEAR      (0x15) /**< Params: None. */
+#define SERIAL_OPCODE_CMD_DEVICE_INTERNAL_EVENTS_TRACE_READ   (0x16) /**< Params: @ref serial_cmd_device_internal_events_trace_read_t */
+#define SERIAL_OPCODE_CMD_DEVICE_METRICS_COUNTERS_GET         (0x17) /**< Params: None. */
+#define SERIAL_OPCODE_CMD_DEVICE_METRICS_HISTOGRAM_GET        (0x18) /**< Params: @ref serial_cmd_device_metrics_histogram_get_t */
+#define SERIAL_OPCODE_CMD_DEVICE_METRICS_CLEAR                (0x19) /**< Params: None. */
 
 #define SERIAL_OPCODE_CMD_RANGE_DEVICE_END                    (0x1F) /**< DEVICE range end. */
 
@@ -155,6 +159,10 @@
 #define SERIAL_OPCODE_CMD_MESH_CONFIG_SERVER_BIND             (0xAD) /**< Params: @ref serial_cmd_mesh_config_server_devkey_bind_t */
 #define SERIAL_OPCODE_CMD_MESH_NET_STATE_SET                  (0xAE) /**< Params: @ref serial_cmd_mesh_net_state_set_t */
 #define SERIAL_OPCODE_CMD_MESH_NET_STATE_GET                  (0xAF) /**< Params: None. */
+#define SERIAL_OPCODE_CMD_MESH_APPKEY_ADD_BATCH               (0xB0) /**< Params: @ref serial_cmd_mesh_appkey_add_batch_t */
+#define SERIAL_OPCODE_CMD_MESH_DEVKEY_ADD_BATCH               (0xB1) /**< Params: @ref serial_cmd_mesh_devkey_add_batch_t */
+#define SERIAL_OPCODE_CMD_MESH_ADDR_SUBSCRIPTION_ADD_BATCH    (0xB2) /**< Params: @ref serial_cmd_mesh_addr_add_batch_t */
+#define SERIAL_OPCODE_CMD_MESH_ADDR_PUBLICATION_ADD_BATCH     (0xB3) /**< Params: @ref serial_cmd_mesh_addr_add_batch_t */
 #define SERIAL_OPCODE_CMD_RANGE_MESH_END                      (0xBF) /**< MESH range end. */
 
 #define SERIAL_OPCODE_CMD_RANGE_DFU_START                     (0xD0) /**< DFU range start. */
@@ -189,7 +197,9 @@
 #define SERIAL_OPCODE_CMD_ACCESS_MODEL_ID_GET                 (0xF2) /**< Params: @ref serial_cmd_access_model_handle_t */
 #define SERIAL_OPCODE_CMD_ACCESS_HANDLE_GET                   (0xF3) /**< Params: @ref serial_cmd_access_handle_get_t */
 #define SERIAL_OPCODE_CMD_ACCESS_ELEM_MODELS_GET              (0xF4) /**< Params: @ref serial_cmd_access_element_index_t */
-#define SERIAL_OPCODE_CMD_RANGE_ACCESS_END                    (0xF4) /**< End of ACCESS command range. */
+#define SERIAL_OPCODE_CMD_ACCESS_MODEL_SUBS_ADD_BATCH         (0xF5) /**< Params: @ref serial_cmd_access_handle_pair_batch_t */
+#define SERIAL_OPCODE_CMD_ACCESS_MODEL_APP_BIND_BATCH         (0xF6) /**< Params: @ref serial_cmd_access_handle_pair_batch_t */
+#define SERIAL_OPCODE_CMD_RANGE_ACCESS_END                    (0xF6) /**< End of ACCESS command range. */
 
 #define SERIAL_OPCODE_CMD_RANGE_MODEL_SPECIFIC_START          (0xFC) /**< Start of MODEL specific command range. */
 #define SERIAL_OPCODE_CMD_MODEL_SPECIFIC_MODELS_GET           (0xFC) /**< Params: None. */
@@ -235,6 +245,18 @@ typedef struct __attribute((packed))
     uint8_t beacon_slot; /**< Slot number of the beacon to get the parameters of. */
 } serial_cmd_device_beacon_params_get_t;
 
+/** Internal events trace read cmd parameters. */
+typedef struct __attribute((packed))
+{
+    uint8_t enable; /**< Set to 1 to keep recording trace records, or 0 to stop recording after this read. */
+} serial_cmd_device_internal_events_trace_read_t;
+
+/** Metrics histogram get cmd parameters. */
+typedef struct __attribute((packed))
+{
+    uint8_t histogram; /**< Histogram to get, see @ref mesh_metrics_histogram_t. */
+} serial_cmd_device_metrics_histogram_get_t;
+
 /** Union of all device command parameters. */
 typedef union __attribute((packed))
 {
@@ -243,6 +265,8 @@ typedef union __attribute((packed))
     serial_cmd_device_beacon_stop_t beacon_stop; /**< Beacon stop parameters. */
     serial_cmd_device_beacon_params_set_t beacon_params_set; /**< Beacon params set parameters. */
     serial_cmd_device_beacon_params_get_t beacon_params_get; /**< Beacon params get parameters. */
+    serial_cmd_device_internal_events_trace_read_t internal_events_trace_read; /**< Internal events trace read parameters. */
+    serial_cmd_device_metrics_histogram_get_t metrics_histogram_get; /**< Metrics histogram get parameters. */
 } serial_cmd_device_t;
 
 /************** Config commands **************/
@@ -518,6 +542,31 @@ typedef struct __attribute((packed))
     uint32_t  next_seqnum_block; /**< The first sequence number block which is not yet allocated. */
 } serial_cmd_mesh_net_state_set_t;
 
+/** Maximum number of keys in a batched appkey or devkey add command. */
+#define SERIAL_CMD_MESH_KEY_ADD_BATCH_COUNT_MAX     (NRF_MESH_SERIAL_PAYLOAD_MAXLEN / sizeof(serial_cmd_mesh_devkey_add_t))
+/** Maximum number of addresses in a batched address add command, limited by the handle list in the response. */
+#define SERIAL_CMD_MESH_ADDR_ADD_BATCH_COUNT_MAX    ((NRF_MESH_SERIAL_PAYLOAD_MAXLEN - sizeof(uint16_t)) / sizeof(uint16_t))
+
+NRF_MESH_STATIC_ASSERT(sizeof(serial_cmd_mesh_appkey_add_t) == sizeof(serial_cmd_mesh_devkey_add_t));
+
+/** Mesh appkey add batch command parameters. */
+typedef struct __attribute((packed))
+{
+    serial_cmd_mesh_appkey_add_t appkeys[SERIAL_CMD_MESH_KEY_ADD_BATCH_COUNT_MAX]; /**< Appkeys to add, the number of appkeys is given by the command length. */
+} serial_cmd_mesh_appkey_add_batch_t;
+
+/** Mesh devkey add batch command parameters. */
+typedef struct __attribute((packed))
+{
+    serial_cmd_mesh_devkey_add_t devkeys[SERIAL_CMD_MESH_KEY_ADD_BATCH_COUNT_MAX]; /**< Devkeys to add, the number of devkeys is given by the command length. */
+} serial_cmd_mesh_devkey_add_batch_t;
+
+/** Mesh address subscription or publication add batch command parameters. */
+typedef struct __attribute((packed))
+{
+    uint16_t addresses[SERIAL_CMD_MESH_ADDR_ADD_BATCH_COUNT_MAX]; /**< Addresses to add, the number of addresses is given by the command length. */
+} serial_cmd_mesh_addr_add_batch_t;
+
 /** Mesh command parameters. */
 typedef union __attribute((packed))
 {
@@ -549,6 +598,10 @@ typedef union __attribute((packed))
     serial_cmd_mesh_packet_send_t                   packet_send;                   /**< Packet send parameters. */
     serial_cmd_mesh_config_server_devkey_bind_t     config_server_devkey_bind;     /**< Configuration Server: device key bind parameters. */
     serial_cmd_mesh_net_state_set_t                 net_state_set;                 /**< Net state set parameters */
+
+    serial_cmd_mesh_appkey_add_batch_t              appkey_add_batch;              /**< Appkey add batch parameters. */
+    serial_cmd_mesh_devkey_add_batch_t              devkey_add_batch;              /**< Devkey add batch parameters. */
+    serial_cmd_mesh_addr_add_batch_t                addr_add_batch;                /**< Subscription or publication address add batch parameters. */
 } serial_cmd_mesh_t;
 
 /* **** PB-MESH Client **** */
@@ -678,6 +731,12 @@ typedef struct __attribute((packed))
     uint16_t element_index;               /**< Index of the addressed element. */
 } serial_cmd_access_element_index_t;
 
+/** Used by the batched access commands that work on a list of model and address or appkey handles. */
+typedef struct __attribute((packed))
+{
+    serial_cmd_access_handle_pair_t pairs[NRF_MESH_SERIAL_PAYLOAD_MAXLEN / sizeof(serial_cmd_access_handle_pair_t)]; /**< Handle pairs, the number of pairs is given by the command length. */
+} serial_cmd_access_handle_pair_batch_t;
+
 /** Used for initializing one of the available models */
 typedef struct __attribute((packed))
 {
@@ -699,6 +758,7 @@ NRF_MESH_STATIC_ASSERT(sizeof(serial_cmd_model_specific_command_t) == NRF_MESH_S
 typedef union __attribute((packed))
 {
     serial_cmd_access_handle_pair_t       handle_pair;
+    serial_cmd_access_handle_pair_batch_t handle_pair_batch;
     serial_cmd_access_model_handle_t      model_handle;
     serial_cmd_access_element_loc_set_t   elem_loc;
     serial_cmd_access_model_pub_ttl_set_t model_ttl;
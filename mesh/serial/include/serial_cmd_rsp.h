@@ -46,6 +46,8 @@
 #include "nrf_mesh_prov.h"
 #include "access.h"
 #include "device_state_manager.h"
+#include "internal_event.h"
+#include "mesh_metrics.h"
 
 
 /**
@@ -69,6 +71,33 @@ typedef struct __attribute((packed))
     uint32_t alloc_fail_count;  /**< Number of failed serial packet allocations. */
 } serial_evt_cmd_rsp_data_housekeeping_t;
 
+/** Overhead of the internal events trace read response, before the records start. */
+#define SERIAL_EVT_CMD_RSP_DATA_INTERNAL_EVENTS_TRACE_OVERHEAD (8)
+/** Max number of records in one internal events trace read response. */
+#define SERIAL_EVT_CMD_RSP_DATA_INTERNAL_EVENTS_TRACE_RECORDS_MAX \
+    ((SERIAL_EVT_CMD_RSP_DATA_MAXLEN - SERIAL_EVT_CMD_RSP_DATA_INTERNAL_EVENTS_TRACE_OVERHEAD) / sizeof(internal_event_trace_record_t))
+
+/** Internal events trace records. */
+typedef struct __attribute((packed))
+{
+    uint32_t timestamp_hz; /**< Frequency of the record timestamps, in Hz. */
+    uint32_t dropped_count; /**< Number of records dropped on a full trace buffer since the previous read. */
+    internal_event_trace_record_t records[SERIAL_EVT_CMD_RSP_DATA_INTERNAL_EVENTS_TRACE_RECORDS_MAX]; /**< Oldest trace records, in order. */
+} serial_evt_cmd_rsp_data_internal_events_trace_read_t;
+
+/** Packet pipeline counters. */
+typedef struct __attribute((packed))
+{
+    uint32_t counters[MESH_METRICS_COUNTER_COUNT]; /**< Counter values, indexed by @ref mesh_metrics_counter_t. */
+} serial_evt_cmd_rsp_data_metrics_counters_t;
+
+/** Packet pipeline latency histogram. */
+typedef struct __attribute((packed))
+{
+    uint8_t histogram; /**< Histogram ID, see @ref mesh_metrics_histogram_t. */
+    mesh_metrics_histogram_data_t data; /**< Histogram data. */
+} serial_evt_cmd_rsp_data_metrics_histogram_t;
+
 /** Subnetwork access response data */
 typedef struct __attribute((packed))
 {
@@ -129,6 +158,12 @@ typedef struct __attribute((packed))
     uint16_t address_handles[SERIAL_EVT_CMD_RSP_DATA_MAXLEN / sizeof(uint16_t)]; /**< List of all address handles known by the device, not including local unicast addresses. */
 } serial_evt_cmd_rsp_data_addr_list_t;
 
+/** Handle list response data, for the batched add commands */
+typedef struct __attribute((packed))
+{
+    uint16_t handles[SERIAL_EVT_CMD_RSP_DATA_MAXLEN / sizeof(uint16_t)]; /**< Handles of the added items, in the order of the command. */
+} serial_evt_cmd_rsp_data_handle_list_t;
+
 /** Command response data with a list size. */
 typedef struct __attribute((packed))
 {
@@ -287,6 +322,12 @@ typedef struct __attribute((packed))
     access_model_handle_t model_handle;  /**< Handle of the initialized model. */
 } serial_evt_cmd_rsp_data_model_init_t;
 
+/** Command response to the batched access commands, also sent when the batch fails. */
+typedef struct __attribute((packed))
+{
+    uint8_t count; /**< Number of handle pairs applied, in the order of the command. */
+} serial_evt_cmd_rsp_data_access_batch_t;
+
 /** Command response to @ref SERIAL_OPCODE_CMD_MODEL_SPECIFIC_COMMAND from the model addressed. */
 typedef struct __attribute((packed))
 {
@@ -317,6 +358,9 @@ typedef struct __attribute((packed))
     union __attribute((packed))
     {
         serial_evt_cmd_rsp_data_housekeeping_t         hk_data;        /**< Housekeeping data response. */
+        serial_evt_cmd_rsp_data_internal_events_trace_read_t internal_events_trace; /**< Internal events trace records. */
+        serial_evt_cmd_rsp_data_metrics_counters_t     metrics_counters; /**< Packet pipeline counters. */
+        serial_evt_cmd_rsp_data_metrics_histogram_t    metrics_histogram; /**< Packet pipeline latency histogram. */
         serial_evt_cmd_rsp_data_subnet_t               subnet;         /**< Subnet response. */
         serial_evt_cmd_rsp_data_subnet_list_t          subnet_list;    /**< List of all subnet key indexes. */
         serial_evt_cmd_rsp_data_appkey_t               appkey;         /**< Appkey response. */
@@ -324,6 +368,7 @@ typedef struct __attribute((packed))
         serial_evt_cmd_rsp_data_devkey_t               devkey;         /**< Devkey response. */
         serial_evt_cmd_rsp_data_addr_local_unicast_t   local_unicast;  /**< Local unicast addresses. */
         serial_evt_cmd_rsp_data_addr_t                 addr;           /**< Address response. */
+        serial_evt_cmd_rsp_data_handle_list_t          handle_list;    /**< Handles of the items added by a batch. */
         serial_evt_cmd_rsp_data_list_size_t            list_size;      /**< List size. */
         serial_evt_cmd_rsp_data_adv_addr_t             adv_addr;       /**< Advertisement address. */
         serial_evt_cmd_rsp_data_prov_ctx_t             prov_ctx;       /**< Provisioning context. */
@@ -346,6 +391,7 @@ typedef struct __attribute((packed))
         serial_evt_cmd_rsp_data_elem_models_get_t      model_handles;  /**< Element's list of model handles. */
         serial_evt_cmd_rsp_data_models_get_t           model_ids;      /**< All the available models.*/
         serial_evt_cmd_rsp_data_model_init_t           model_init;     /**< Reserved handle for the initialized model instance. */
+        serial_evt_cmd_rsp_data_access_batch_t         access_batch;   /**< Number of handle pairs applied by a batch. */
         serial_evt_cmd_rsp_data_packet_send_t          packet_send;    /**< Information about the sent packet. */
         serial_evt_cmd_rsp_data_net_state_get_t        net_state_get;  /**< Net state. */
 
@@ -45,6 +45,7 @@
 #include "nrf_error.h"
 
 #include "nrf_mesh_serial.h"
+#include "nrf_mesh_config_serial.h"
 #include "nrf_mesh_assert.h"
 #include "serial.h"
 #include "serial_evt.h"
@@ -71,10 +72,12 @@ typedef enum
 
 /********** Static variables **********/
 
-/* Buffers must be word-aligned, and also be able to fit two instances of the largest possible
+/* Buffers must be word-aligned, and also be able to fit at least two instances of the largest possible
  * packet, to avoid it locking up if the head is in the middle of the buffer. */
-#define RX_BUFFER_SIZE (2 * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE))
-#define TX_BUFFER_SIZE (2 * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE))
+NRF_MESH_STATIC_ASSERT(NRF_MESH_SERIAL_RX_PACKET_COUNT >= 2);
+NRF_MESH_STATIC_ASSERT(NRF_MESH_SERIAL_TX_PACKET_COUNT >= 2);
+#define RX_BUFFER_SIZE (NRF_MESH_SERIAL_RX_PACKET_COUNT * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE))
+#define TX_BUFFER_SIZE (NRF_MESH_SERIAL_TX_PACKET_COUNT * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE))
 
 static uint8_t m_tx_buffer[TX_BUFFER_SIZE];
 static packet_buffer_t m_tx_packet_buf;
@@ -97,6 +100,8 @@ NRF_MESH_STATIC_ASSERT(offsetof(serial_packet_t, length) == 0);
 
 /********** Static Functions **********/
 
+static void tx_packet_done(void);
+
 static void schedule_transmit(void)
 {
     bearer_event_flag_set(m_event_flag);
@@ -209,10 +214,7 @@ static inline void char_tx_simple(void)
         m_cur_tx_packet_index++;
         packet_buffer_free(&m_tx_packet_buf, mp_current_tx_packet);
         mp_current_tx_packet = NULL;
-        serial_uart_tx_stop();
-        m_serial_state = SERIAL_STATE_IDLE;
-        /* send next packet */
-        schedule_transmit();
+        tx_packet_done();
     }
     else if (m_cur_tx_packet_index < p_serial_packet->length + SERIAL_PACKET_LENGTH_OVERHEAD)
     { /* Send the next byte in line */
@@ -359,6 +361,46 @@ static inline void char_rx_with_slip_encoding(uint16_t * p_rx_index, uint8_t byt
 }
 #endif
 
+#if NRF_MESH_SERIAL_TX_BURST
+/**
+ * Starts the next packet in the TX buffer from the UART interrupt, without stopping the
+ * transmitter in between.
+ *
+ * @return @c true if a packet was started, or @c false if there was nothing to send.
+ */
+static bool tx_packet_next_start(void)
+{
+    if (NRF_SUCCESS != packet_buffer_pop(&m_tx_packet_buf, &mp_current_tx_packet))
+    {
+        return false;
+    }
+
+    uint8_t value = mp_current_tx_packet->packet[0];
+    m_cur_tx_packet_index = 1;
+#ifdef SERIAL_SLIP_ENCODING
+    /* The END byte of the previous packet also marks the start of this one. */
+    slip_encoding_get(&value, &m_tx_slip_byte);
+#endif
+    serial_uart_byte_send(value);
+    return true;
+}
+#endif
+
+/** Called from the UART interrupt when the last byte of a packet has been sent. */
+static void tx_packet_done(void)
+{
+#if NRF_MESH_SERIAL_TX_BURST
+    if (tx_packet_next_start())
+    {
+        return;
+    }
+#endif
+    serial_uart_tx_stop();
+    m_serial_state = SERIAL_STATE_IDLE;
+    /* send next packet */
+    schedule_transmit();
+}
+
 static void char_rx(uint8_t c)
 {
     static uint16_t rx_index = 0;
@@ -383,10 +425,8 @@ static void char_tx(void)
     NRF_MESH_ASSERT(m_serial_state != SERIAL_STATE_IDLE);
     if (NULL == mp_current_tx_packet)
     {
-        /* We have nothing to send. */
-        serial_uart_tx_stop();
-        m_serial_state = SERIAL_STATE_IDLE;
-        schedule_transmit();
+        /* We have nothing more to send from the current packet. */
+        tx_packet_done();
     }
     else
     {
@@ -48,6 +48,7 @@
 #include "serial_handler_common.h"
 #include "access_config.h"
 #include "access.h"
+#include "mesh_config.h"
 
 /*****************************************************************************
  * Static asserts: make sure that our assumptions on packet sizes are true
@@ -56,6 +57,7 @@ NRF_MESH_STATIC_ASSERT(sizeof(access_model_id_t) == sizeof(uint32_t));
 NRF_MESH_STATIC_ASSERT(sizeof(dsm_handle_t) == sizeof(uint16_t));
 NRF_MESH_STATIC_ASSERT(sizeof(access_model_handle_t) == sizeof(uint16_t));
 NRF_MESH_STATIC_ASSERT(ACCESS_PUBLISH_RESOLUTION_MAX <= UINT8_MAX);
+NRF_MESH_STATIC_ASSERT(sizeof(serial_cmd_access_handle_pair_batch_t) / sizeof(serial_cmd_access_handle_pair_t) <= UINT8_MAX);
 
 
 /*****************************************************************************
@@ -274,6 +276,49 @@ static void elem_models_get(const serial_packet_t * p_cmd)
     }
 }
 
+/* Applies the handle pairs of a batch in order, and stops at the first pair that fails. Binding and
+ * subscribing are idempotent, so a failed batch can be sent again once the failing pair is fixed. */
+static void handle_pair_batch_apply(const serial_packet_t * p_cmd,
+                                    uint32_t (*apply)(access_model_handle_t, dsm_handle_t))
+{
+    uint32_t length = p_cmd->length - SERIAL_PACKET_LENGTH_OVERHEAD;
+    if (length % sizeof(serial_cmd_access_handle_pair_t) != 0)
+    {
+        (void) serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0);
+        return;
+    }
+
+    const serial_cmd_access_t * p_access_msg = &p_cmd->payload.cmd.access;
+    uint32_t count = length / sizeof(serial_cmd_access_handle_pair_t);
+    uint32_t status = NRF_SUCCESS;
+    serial_evt_cmd_rsp_data_access_batch_t response = {0};
+
+    /* The models changed by the batch are stored together when it ends. */
+    mesh_config_batch_begin();
+    while (response.count < count && status == NRF_SUCCESS)
+    {
+        status = apply(p_access_msg->handle_pair_batch.pairs[response.count].model_handle,
+                       p_access_msg->handle_pair_batch.pairs[response.count].dsm_handle);
+        if (status == NRF_SUCCESS)
+        {
+            response.count++;
+        }
+    }
+    mesh_config_batch_end();
+
+    (void) serial_cmd_rsp_send(p_cmd->opcode, serial_translate_error(status), (uint8_t *) &response, sizeof(response));
+}
+
+static void model_subs_add_batch(const serial_packet_t * p_cmd)
+{
+    handle_pair_batch_apply(p_cmd, access_model_subscription_add);
+}
+
+static void model_app_bind_batch(const serial_packet_t * p_cmd)
+{
+    handle_pair_batch_apply(p_cmd, access_model_application_bind);
+}
+
 /*****************************************************************************
  * Callback table to be used with serial_handler_common_rx
  *****************************************************************************/
@@ -285,6 +330,7 @@ static void elem_models_get(const serial_packet_t * p_cmd)
 #define ELEMENT_LOC_SET_T_SIZE   sizeof(serial_cmd_access_element_loc_set_t)
 #define ELEMENT_INDEX_T_SIZE     sizeof(serial_cmd_access_element_index_t)
 #define HANDLE_GET_T_SIZE        sizeof(serial_cmd_access_handle_get_t)
+#define HANDLE_PAIR_BATCH_EXTRA  (sizeof(serial_cmd_access_handle_pair_batch_t) - HANDLE_PAIR_T_SIZE)
 
 /* Serial command handler lookup table. */
 static const serial_handler_common_opcode_to_fp_map_t m_cmd_handlers[] =
@@ -309,7 +355,9 @@ static const serial_handler_common_opcode_to_fp_map_t m_cmd_handlers[] =
     {SERIAL_OPCODE_CMD_ACCESS_ELEM_VENDOR_MODEL_COUNT_GET, ELEMENT_INDEX_T_SIZE,     0, elem_vendor_model_cnt_get},
     {SERIAL_OPCODE_CMD_ACCESS_MODEL_ID_GET,                MODEL_HANDLE_T_SIZE,      0, model_id_get},
     {SERIAL_OPCODE_CMD_ACCESS_HANDLE_GET,                  HANDLE_GET_T_SIZE,        0, handle_get},
-    {SERIAL_OPCODE_CMD_ACCESS_ELEM_MODELS_GET,             ELEMENT_INDEX_T_SIZE,     0, elem_models_get}
+    {SERIAL_OPCODE_CMD_ACCESS_ELEM_MODELS_GET,             ELEMENT_INDEX_T_SIZE,     0, elem_models_get},
+    {SERIAL_OPCODE_CMD_ACCESS_MODEL_SUBS_ADD_BATCH,        HANDLE_PAIR_T_SIZE,       HANDLE_PAIR_BATCH_EXTRA, model_subs_add_batch},
+    {SERIAL_OPCODE_CMD_ACCESS_MODEL_APP_BIND_BATCH,        HANDLE_PAIR_T_SIZE,       HANDLE_PAIR_BATCH_EXTRA, model_app_bind_batch}
 };
 
 void serial_handler_access_rx(const serial_packet_t* p_cmd)
@@ -49,6 +49,7 @@
 #include "nrf_mesh_dfu.h"
 #include "hal.h"
 #include "advertiser.h"
+#include "mesh_metrics.h"
 
 #define BEACON_START_CMD_DATA_OVERHEAD  (sizeof(serial_cmd_device_beacon_start_t) - BLE_ADV_PACKET_PAYLOAD_MAX_LENGTH)
 #define BEACON_INTERVAL_RANDOMIZE_INTERVAL_MS   (10)
@@ -142,6 +143,28 @@ static void handle_cmd_device_internal_events_report(const serial_packet_t * p_c
 #endif
 }
 
+static void handle_cmd_device_internal_events_trace_read(const serial_packet_t * p_cmd)
+{
+#if INTERNAL_EVENT_TRACE_ENABLE
+    serial_evt_cmd_rsp_data_internal_events_trace_read_t rsp;
+    uint32_t dropped_count;
+
+    internal_event_trace_enable(p_cmd->payload.cmd.device.internal_events_trace_read.enable != 0);
+    uint32_t count = internal_event_trace_read(rsp.records, ARRAY_SIZE(rsp.records), &dropped_count);
+    rsp.timestamp_hz = internal_event_trace_timestamp_hz_get();
+    rsp.dropped_count = dropped_count;
+    serial_cmd_rsp_send(p_cmd->opcode,
+            SERIAL_STATUS_SUCCESS,
+            (const uint8_t *) &rsp,
+            SERIAL_EVT_CMD_RSP_DATA_INTERNAL_EVENTS_TRACE_OVERHEAD + count * sizeof(internal_event_trace_record_t));
+#else
+    serial_cmd_rsp_send(p_cmd->opcode,
+            SERIAL_STATUS_ERROR_CMD_UNKNOWN,
+            NULL,
+            0);
+#endif
+}
+
 static void handle_cmd_device_serial_version_get(const serial_packet_t * p_cmd)
 {
     serial_evt_cmd_rsp_data_serial_version_t rsp;
@@ -281,6 +304,52 @@ static void handle_cmd_hk_data_clear(const serial_packet_t * p_cmd)
     serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, NULL, 0);
 }
 
+static void handle_cmd_metrics_counters_get(const serial_packet_t * p_cmd)
+{
+#if MESH_METRICS_ENABLE
+    uint32_t counters[MESH_METRICS_COUNTER_COUNT];
+    NRF_MESH_ERROR_CHECK(mesh_metrics_counters_get(counters));
+
+    serial_evt_cmd_rsp_data_metrics_counters_t rsp;
+    memcpy(rsp.counters, counters, sizeof(rsp.counters));
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, (const uint8_t *) &rsp, sizeof(rsp));
+#else
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_CMD_UNKNOWN, NULL, 0);
+#endif
+}
+
+static void handle_cmd_metrics_histogram_get(const serial_packet_t * p_cmd)
+{
+#if MESH_METRICS_ENABLE
+    mesh_metrics_histogram_data_t data;
+    uint8_t histogram = p_cmd->payload.cmd.device.metrics_histogram_get.histogram;
+    uint32_t status = mesh_metrics_histogram_get((mesh_metrics_histogram_t) histogram, &data);
+    if (status == NRF_SUCCESS)
+    {
+        /* The response data is packed, copy the histogram in. */
+        serial_evt_cmd_rsp_data_metrics_histogram_t rsp;
+        rsp.histogram = histogram;
+        memcpy(&rsp.data, &data, sizeof(rsp.data));
+        serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, (const uint8_t *) &rsp, sizeof(rsp));
+    }
+    else
+    {
+        serial_cmd_rsp_send(p_cmd->opcode, serial_translate_error(status), NULL, 0);
+    }
+#else
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_CMD_UNKNOWN, NULL, 0);
+#endif
+}
+
+static void handle_cmd_metrics_clear(const serial_packet_t * p_cmd)
+{
+#if MESH_METRICS_ENABLE
+    mesh_metrics_clear();
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, NULL, 0);
+#else
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_CMD_UNKNOWN, NULL, 0);
+#endif
+}
 
 /* Serial command handler lookup table. */
 static const serial_handler_common_opcode_to_fp_map_t m_cmd_handlers[] =
@@ -296,6 +365,10 @@ static const serial_handler_common_opcode_to_fp_map_t m_cmd_handlers[] =
     {SERIAL_OPCODE_CMD_DEVICE_BEACON_PARAMS_GET,       sizeof(serial_cmd_device_beacon_params_get_t),                  0, handle_cmd_device_beacon_params_get},
     {SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_GET,   0,                                                              0, handle_cmd_hk_data_get},
     {SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_CLEAR, 0,                                                              0, handle_cmd_hk_data_clear},
+    {SERIAL_OPCODE_CMD_DEVICE_INTERNAL_EVENTS_TRACE_READ, sizeof(serial_cmd_device_internal_events_trace_read_t),   0, handle_cmd_device_internal_events_trace_read},
+    {SERIAL_OPCODE_CMD_DEVICE_METRICS_COUNTERS_GET,    0,                                                              0, handle_cmd_metrics_counters_get},
+    {SERIAL_OPCODE_CMD_DEVICE_METRICS_HISTOGRAM_GET,   sizeof(serial_cmd_device_metrics_histogram_get_t),              0, handle_cmd_metrics_histogram_get},
+    {SERIAL_OPCODE_CMD_DEVICE_METRICS_CLEAR,           0,                                                              0, handle_cmd_metrics_clear},
 };
 
 /*****************************************************************************
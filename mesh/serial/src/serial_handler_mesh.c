@@ -52,6 +52,7 @@
 #include "hal.h"
 #include "mesh_stack.h"
 #include "mesh_opt_net_state.h"
+#include "mesh_config.h"
 #include "mesh_config_entry.h"
 #include "mesh_config_listener.h"
 
@@ -61,10 +62,18 @@
  * commands must change types. */
 NRF_MESH_STATIC_ASSERT(sizeof(uint16_t) == sizeof(dsm_handle_t));
 
+/* Every item added by a batch must fit its handle in the response. */
+NRF_MESH_STATIC_ASSERT(SERIAL_CMD_MESH_KEY_ADD_BATCH_COUNT_MAX <= SERIAL_EVT_CMD_RSP_DATA_MAXLEN / sizeof(uint16_t));
+NRF_MESH_STATIC_ASSERT(SERIAL_CMD_MESH_ADDR_ADD_BATCH_COUNT_MAX <= SERIAL_EVT_CMD_RSP_DATA_MAXLEN / sizeof(uint16_t));
+
 /*****************************************************************************
 * Local typedefs
 *****************************************************************************/
 typedef void (*mesh_serial_cmd_handler_cb_t)(const serial_packet_t* p_cmd);
+/** Adds item @p index of a batch command. */
+typedef uint32_t (*batch_item_add_cb_t)(const serial_packet_t * p_cmd, uint32_t index, dsm_handle_t * p_handle);
+/** Removes an item added by a batch command. */
+typedef uint32_t (*batch_item_remove_cb_t)(dsm_handle_t handle);
 typedef struct
 {
     uint8_t opcode;
@@ -488,6 +497,104 @@ static void handle_net_state_get(const serial_packet_t * p_cmd)
     serial_handler_common_cmd_rsp_nodata_on_error(p_cmd->opcode, status, (uint8_t *)&rsp, sizeof(rsp));
 }
 
+/**
+ * Adds all items of a batch command, or none of them.
+ *
+ * The DSM entries are stored with a single pass over the dirty config entries once the batch is
+ * done. If an item fails, the items added before it are removed again, and only the error status
+ * is returned.
+ */
+static void batch_handle(const serial_packet_t * p_cmd,
+                         uint32_t item_size,
+                         batch_item_add_cb_t add_cb,
+                         batch_item_remove_cb_t remove_cb)
+{
+    uint32_t length = p_cmd->length - SERIAL_PACKET_LENGTH_OVERHEAD;
+    if (length % item_size != 0)
+    {
+        serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0);
+        return;
+    }
+
+    serial_evt_cmd_rsp_data_handle_list_t rsp;
+    /* Can not use response directly because taking address of packed member of 'struct <anonymous>'
+       may result in an unaligned pointer value. */
+    dsm_handle_t handles[ARRAY_SIZE(rsp.handles)];
+    uint32_t count = length / item_size;
+    uint32_t added = 0;
+    uint32_t status = NRF_SUCCESS;
+
+    mesh_config_batch_begin();
+    while (added < count)
+    {
+        status = add_cb(p_cmd, added, &handles[added]);
+        if (status != NRF_SUCCESS)
+        {
+            break;
+        }
+        added++;
+    }
+
+    if (status != NRF_SUCCESS)
+    {
+        while (added > 0)
+        {
+            added--;
+            NRF_MESH_ERROR_CHECK(remove_cb(handles[added]));
+        }
+    }
+    mesh_config_batch_end();
+
+    memcpy((uint16_t *) rsp.handles, handles, sizeof(dsm_handle_t) * added);
+    serial_handler_common_cmd_rsp_nodata_on_error(p_cmd->opcode, status, (uint8_t *) &rsp, sizeof(dsm_handle_t) * added);
+}
+
+static uint32_t appkey_batch_item_add(const serial_packet_t * p_cmd, uint32_t index, dsm_handle_t * p_handle)
+{
+    return dsm_appkey_add(p_cmd->payload.cmd.mesh.appkey_add_batch.appkeys[index].app_key_index,
+            p_cmd->payload.cmd.mesh.appkey_add_batch.appkeys[index].subnet_handle,
+            p_cmd->payload.cmd.mesh.appkey_add_batch.appkeys[index].key,
+            p_handle);
+}
+
+static uint32_t devkey_batch_item_add(const serial_packet_t * p_cmd, uint32_t index, dsm_handle_t * p_handle)
+{
+    return dsm_devkey_add(p_cmd->payload.cmd.mesh.devkey_add_batch.devkeys[index].owner_addr,
+            p_cmd->payload.cmd.mesh.devkey_add_batch.devkeys[index].subnet_handle,
+            p_cmd->payload.cmd.mesh.devkey_add_batch.devkeys[index].key,
+            p_handle);
+}
+
+static uint32_t addr_subscription_batch_item_add(const serial_packet_t * p_cmd, uint32_t index, dsm_handle_t * p_handle)
+{
+    return dsm_address_subscription_add(p_cmd->payload.cmd.mesh.addr_add_batch.addresses[index], p_handle);
+}
+
+static uint32_t addr_publication_batch_item_add(const serial_packet_t * p_cmd, uint32_t index, dsm_handle_t * p_handle)
+{
+    return dsm_address_publish_add(p_cmd->payload.cmd.mesh.addr_add_batch.addresses[index], p_handle);
+}
+
+static void handle_cmd_appkey_add_batch(const serial_packet_t * p_cmd)
+{
+    batch_handle(p_cmd, sizeof(serial_cmd_mesh_appkey_add_t), appkey_batch_item_add, dsm_appkey_delete);
+}
+
+static void handle_cmd_devkey_add_batch(const serial_packet_t * p_cmd)
+{
+    batch_handle(p_cmd, sizeof(serial_cmd_mesh_devkey_add_t), devkey_batch_item_add, dsm_devkey_delete);
+}
+
+static void handle_cmd_addr_subscription_add_batch(const serial_packet_t * p_cmd)
+{
+    batch_handle(p_cmd, sizeof(uint16_t), addr_subscription_batch_item_add, dsm_address_subscription_remove);
+}
+
+static void handle_cmd_addr_publication_add_batch(const serial_packet_t * p_cmd)
+{
+    batch_handle(p_cmd, sizeof(uint16_t), addr_publication_batch_item_add, dsm_address_publish_remove);
+}
+
 /*****************************************************************************
 * Static functions
 *****************************************************************************/
@@ -527,7 +634,11 @@ static const mesh_serial_cmd_handler_t m_handlers[] =
     {SERIAL_OPCODE_CMD_MESH_STATE_CLEAR,                    0,                                                       0,  handle_cmd_clear},
     {SERIAL_OPCODE_CMD_MESH_CONFIG_SERVER_BIND,             sizeof(serial_cmd_mesh_config_server_devkey_bind_t),     0,  handle_config_devkey_bind},
     {SERIAL_OPCODE_CMD_MESH_NET_STATE_SET,                  sizeof(serial_cmd_mesh_net_state_set_t),                 0,  handle_net_state_set},
-    {SERIAL_OPCODE_CMD_MESH_NET_STATE_GET,                  0,                                                       0,  handle_net_state_get}
+    {SERIAL_OPCODE_CMD_MESH_NET_STATE_GET,                  0,                                                       0,  handle_net_state_get},
+    {SERIAL_OPCODE_CMD_MESH_APPKEY_ADD_BATCH,               sizeof(serial_cmd_mesh_appkey_add_t),                    sizeof(serial_cmd_mesh_appkey_add_batch_t) - sizeof(serial_cmd_mesh_appkey_add_t), handle_cmd_appkey_add_batch},
+    {SERIAL_OPCODE_CMD_MESH_DEVKEY_ADD_BATCH,               sizeof(serial_cmd_mesh_devkey_add_t),                    sizeof(serial_cmd_mesh_devkey_add_batch_t) - sizeof(serial_cmd_mesh_devkey_add_t), handle_cmd_devkey_add_batch},
+    {SERIAL_OPCODE_CMD_MESH_ADDR_SUBSCRIPTION_ADD_BATCH,    sizeof(uint16_t),                                        sizeof(serial_cmd_mesh_addr_add_batch_t) - sizeof(uint16_t),                       handle_cmd_addr_subscription_add_batch},
+    {SERIAL_OPCODE_CMD_MESH_ADDR_PUBLICATION_ADD_BATCH,     sizeof(uint16_t),                                        sizeof(serial_cmd_mesh_addr_add_batch_t) - sizeof(uint16_t),                       handle_cmd_addr_publication_add_batch}
 };
 
 static void mesh_config_listener_cb(mesh_config_change_reason_t reason, mesh_config_entry_id_t id, const void * p_entry)
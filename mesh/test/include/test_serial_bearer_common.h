@@ -45,6 +45,7 @@
 #include <stdlib.h>
 
 #include "nrf_mesh_serial.h"
+#include "nrf_mesh_config_serial.h"
 #include "serial_bearer.h"
 #include "test_assert.h"
 
@@ -200,10 +200,10 @@ void setUp(void)
         test_data[i] = i % 80;  /* Modulo with a number lower than the slip bytes. */
     }
 
-    packet_buffer_init_Expect(NULL, NULL, 2 * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE));
+    packet_buffer_init_Expect(NULL, NULL, NRF_MESH_SERIAL_TX_PACKET_COUNT * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE));
     packet_buffer_init_IgnoreArg_p_pool();
     packet_buffer_init_IgnoreArg_p_buffer();
-    packet_buffer_init_Expect(NULL, NULL, 2 * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE));
+    packet_buffer_init_Expect(NULL, NULL, NRF_MESH_SERIAL_RX_PACKET_COUNT * ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), WORD_SIZE));
     packet_buffer_init_IgnoreArg_p_pool();
     packet_buffer_init_IgnoreArg_p_buffer();
     serial_uart_receive_set_Expect(true);
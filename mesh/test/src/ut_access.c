@@ -38,6 +38,8 @@
 #include <unity.h>
 #include <cmock.h>
 #include <string.h>
+#include <stdio.h>
+#include <time.h>
 
 #include "utils.h"
 #include "test_assert.h"
@@ -85,6 +87,8 @@
 
 #define ALLOC_BUFFER_SIZE (380)
 
+#define BENCHMARK_MESSAGES (200000)
+
 #define FLASH_TEST_VECTOR_INSTANCE(MODEL_ID, ELEMENT_INDEX, P_SUB_ADDRS, NO_SUB_ADDRS, SUB_SHARE_IDX,\
                                    PUB_HANDLE, PUB_PERIOD, P_APPKEYS, NO_APPKEYS, PUB_APPKEY, TTL, CRED) \
     {\
@@ -232,6 +236,7 @@ dsm_local_unicast_address_t local_addresses = {ELEMENT_ADDRESS_START, ACCESS_ELE
 
 static uint32_t m_dsm_tx_friendship_secmat_get_retval = NRF_SUCCESS;
 static uint16_t m_sub_list_dealloc_index;
+static uint8_t m_expected_retransmission_ttl;
 
 MOCK_QUEUE_DEF(access_publish_retransmission_message_add_mock, access_publish_retransmit_t, NULL);
 MOCK_QUEUE_DEF(mesh_mem_free_mock, uintptr_t, NULL);
@@ -642,6 +647,34 @@ static uint32_t packet_tx_stub(const nrf_mesh_tx_params_t * p_tx_params, uint32_
     return NRF_SUCCESS;
 }
 
+static uint32_t packet_reserve_segmented_stub(const nrf_mesh_tx_params_t * p_tx_params, uint8_t ** pp_payload, int num_calls)
+{
+    return NRF_ERROR_INVALID_LENGTH;
+}
+
+static uint8_t m_reserved_packet[NRF_MESH_UNSEG_PAYLOAD_SIZE_MAX];
+static tx_evt_t m_reserved_tx_evt;
+
+static uint32_t packet_reserve_stub(const nrf_mesh_tx_params_t * p_tx_params, uint8_t ** pp_payload, int num_calls)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, fifo_pop(&m_tx_fifo, &m_reserved_tx_evt));
+    TEST_ASSERT_EQUAL(m_reserved_tx_evt.length, p_tx_params->data_len);
+    TEST_ASSERT_TRUE(p_tx_params->data_len <= sizeof(m_reserved_packet));
+    TEST_ASSERT_EQUAL_HEX16(m_reserved_tx_evt.src, p_tx_params->src);
+    TEST_ASSERT_EQUAL_HEX16(m_reserved_tx_evt.dst, p_tx_params->dst.value);
+    TEST_ASSERT_EQUAL_HEX16(m_reserved_tx_evt.ttl, p_tx_params->ttl);
+    memset(m_reserved_packet, 0, sizeof(m_reserved_packet));
+    *pp_payload = m_reserved_packet;
+    nrf_mesh_packet_reserve_StubWithCallback(NULL);
+    return NRF_SUCCESS;
+}
+
+static void packet_commit_stub(int num_calls)
+{
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_reserved_tx_evt.p_data, m_reserved_packet, m_reserved_tx_evt.length);
+    nrf_mesh_packet_commit_StubWithCallback(NULL);
+}
+
 static uint32_t address_get_stub(dsm_handle_t handle, nrf_mesh_address_t * p_address, int num_calls)
 {
     if (handle < ACCESS_ELEMENT_COUNT + ACCESS_MODEL_COUNT + SUBSCRIPTION_ADDRESS_COUNT)
@@ -668,6 +701,7 @@ static void retransmission_Expect(access_model_handle_t model_handle)
 static void access_publish_retransmission_message_add_stub(access_model_handle_t model_handle,
                                                            const access_publish_retransmit_t *p_publish_retransmit,
                                                            const access_message_tx_t *p_tx_message,
+                                                           uint8_t ttl,
                                                            const uint8_t *p_access_payload,
                                                            uint16_t access_payload_length,
                                                            int num_calls)
@@ -680,6 +714,8 @@ static void access_publish_retransmission_message_add_stub(access_model_handle_t
     access_publish_retransmit_t expected_publish_retransmit;
     access_publish_retransmission_message_add_mock_Consume(&expected_publish_retransmit);
 
+    TEST_ASSERT_EQUAL(m_expected_retransmission_ttl, ttl);
+
     TEST_ASSERT_EQUAL_MEMORY(&expected_publish_retransmit,
                              p_publish_retransmit,
                              sizeof(access_publish_retransmit_t));
@@ -713,6 +749,57 @@ void mesh_mem_free_mock(void * ptr, int num_calls)
     free(ptr);
 }
 
+static uint64_t time_ns_get(void)
+{
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+}
+
+/* Stand-in for the network buffer the transport encrypts into. */
+static uint8_t m_benchmark_network_pdu[NRF_MESH_UNSEG_PAYLOAD_SIZE_MAX];
+
+static void * benchmark_mem_alloc(size_t size, int num_calls)
+{
+    return malloc(size);
+}
+
+static void benchmark_mem_free(void * ptr, int num_calls)
+{
+    free(ptr);
+}
+
+static void benchmark_local_unicast_addresses_get(dsm_local_unicast_address_t * p_address, int num_calls)
+{
+    *p_address = local_addresses;
+}
+
+static uint32_t benchmark_tx_secmat_get(dsm_handle_t subnet_handle,
+                                        dsm_handle_t app_handle,
+                                        nrf_mesh_secmat_t * p_secmat,
+                                        int num_calls)
+{
+    memset(p_secmat, 0, sizeof(nrf_mesh_secmat_t));
+    return NRF_SUCCESS;
+}
+
+static uint32_t benchmark_packet_send(const nrf_mesh_tx_params_t * p_tx_params, uint32_t * const p_ref, int num_calls)
+{
+    /* The regular path copies the access payload into the network buffer before encrypting it. */
+    memcpy(m_benchmark_network_pdu, p_tx_params->p_data, p_tx_params->data_len);
+    return NRF_SUCCESS;
+}
+
+static uint32_t benchmark_packet_reserve(const nrf_mesh_tx_params_t * p_tx_params, uint8_t ** pp_payload, int num_calls)
+{
+    *pp_payload = m_benchmark_network_pdu;
+    return NRF_SUCCESS;
+}
+
+static void benchmark_packet_commit(int num_calls)
+{
+}
+
 static void publish_timeout_cb(access_model_handle_t handle, void * p_args)
 {
 }
@@ -1050,6 +1137,7 @@ void setUp(void)
     proxy_mock_Init();
     mesh_mem_mock_Init();
     access_publish_retransmission_message_add_mock_Init();
+    m_expected_retransmission_ttl = ACCESS_TTL_USE_PUBLISH;
     mesh_mem_free_mock_Init();
     nrf_mesh_externs_mock_Init();
 
@@ -1473,7 +1561,7 @@ static uint32_t access_packet_tx_publication_cb(access_model_handle_t handle,
     opcode_raw_write(p_tx_message->opcode, payload);
     memcpy(&payload[opcode_length], p_tx_message->p_buffer, p_tx_message->length);
 
-    return access_packet_tx(handle, p_tx_message, payload, payload_length);
+    return access_packet_tx(handle, p_tx_message, ACCESS_TTL_USE_PUBLISH, payload, payload_length);
 }
 
 void test_access_model_publish(void)
@@ -1487,6 +1575,301 @@ void test_access_model_publish(void)
     publication_tests(access_model_publish_publication_cb, true);
 }
 
+static uint32_t access_model_publish_reserve_publication_cb(access_model_handle_t handle,
+                                                            access_message_tx_t *p_tx_message)
+{
+    uint8_t * p_params;
+    uint32_t status = access_model_publish_reserve(handle, p_tx_message, &p_params);
+    if (status == NRF_SUCCESS)
+    {
+        memcpy(p_params, p_tx_message->p_buffer, p_tx_message->length);
+        status = access_model_tx_commit(handle);
+    }
+    return status;
+}
+
+void test_access_model_publish_reserve(void)
+{
+    access_message_tx_t message;
+    uint8_t * p_params;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_model_publish_reserve(0, NULL, &p_params));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_model_publish_reserve(0, &message, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, access_model_tx_commit(0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, access_model_tx_discard(0));
+
+    message.length = ACCESS_MESSAGE_LENGTH_MAX;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, access_model_publish_reserve(0, &message, &p_params));
+
+    /* Messages that have to be segmented are staged on the heap and sent the regular way. */
+    nrf_mesh_packet_reserve_StubWithCallback(packet_reserve_segmented_stub);
+    publication_tests(access_model_publish_reserve_publication_cb, true);
+    nrf_mesh_packet_reserve_StubWithCallback(NULL);
+}
+
+void test_access_model_publish_reserve_in_place(void)
+{
+    build_device_setup(ACCESS_ELEMENT_COUNT, ACCESS_MODEL_COUNT);
+
+    const uint8_t data[] = {0x01, 0x02, 0x03};
+    access_message_tx_t message;
+    message.opcode.opcode = 0x8123;
+    message.opcode.company_id = ACCESS_COMPANY_ID_NONE;
+    message.p_buffer = NULL;
+    message.length = sizeof(data);
+    message.force_segmented = false;
+    message.transmic_size = NRF_MESH_TRANSMIC_SIZE_DEFAULT;
+
+    uint8_t expected_data[sizeof(data) + sizeof(uint32_t)];
+    uint32_t length = opcode_raw_write(message.opcode, expected_data);
+    memcpy(&expected_data[length], data, sizeof(data));
+    length += sizeof(data);
+
+    /* The parameters are written straight into the reserved packet, and the plaintext is kept for
+     * the publish retransmissions. */
+    expect_tx(expected_data, length, ELEMENT_ADDRESS_START, PUBLISH_ADDRESS_START,
+              expected_tx_ttl_get(0), 0, DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    nrf_mesh_packet_send_StubWithCallback(NULL);
+    nrf_mesh_packet_reserve_StubWithCallback(packet_reserve_stub);
+    nrf_mesh_packet_commit_StubWithCallback(packet_commit_stub);
+    retransmission_Expect(0);
+
+    uint8_t * p_params;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_reserve(0, &message, &p_params));
+    TEST_ASSERT_EQUAL_PTR(&m_reserved_packet[2], p_params);
+    TEST_ASSERT_EQUAL(NRF_ERROR_BUSY, access_model_publish_reserve(1, &message, &p_params));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, access_model_tx_commit(1));
+
+    memcpy(p_params, data, sizeof(data));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_tx_commit(0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, access_model_tx_commit(0));
+
+    /* Discarding releases the reserved packet without sending it. */
+    expect_tx(expected_data, length, ELEMENT_ADDRESS_START, PUBLISH_ADDRESS_START,
+              expected_tx_ttl_get(0), 0, DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    nrf_mesh_packet_send_StubWithCallback(NULL);
+    nrf_mesh_packet_reserve_StubWithCallback(packet_reserve_stub);
+    nrf_mesh_packet_discard_Expect();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_reserve(0, &message, &p_params));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_tx_discard(0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, access_model_tx_discard(0));
+}
+
+void test_access_publish_trace(void)
+{
+    build_device_setup(ACCESS_ELEMENT_COUNT, ACCESS_MODEL_COUNT);
+
+    const access_publish_retransmit_t no_retransmit = {.count = 0, .interval_steps = 0};
+    for (access_model_handle_t i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_retransmit_set(i, no_retransmit));
+    }
+
+    /* Models 0 and 1 publish to the same address, model 2 to another address. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_address_set(1, ACCESS_ELEMENT_COUNT));
+
+    const uint8_t data[] = {0x01, 0x02, 0x03};
+    access_message_tx_t message;
+    message.opcode.opcode = 0x8123;
+    message.opcode.company_id = ACCESS_COMPANY_ID_NONE;
+    message.p_buffer = data;
+    message.length = sizeof(data);
+    message.force_segmented = false;
+    message.transmic_size = NRF_MESH_TRANSMIC_SIZE_DEFAULT;
+
+    uint8_t expected_data[sizeof(data) + sizeof(uint32_t)];
+    uint32_t length = opcode_raw_write(message.opcode, expected_data);
+    memcpy(&expected_data[length], data, sizeof(data));
+    length += sizeof(data);
+
+    const uint16_t src[] = {ELEMENT_ADDRESS_START,
+                            ELEMENT_ADDRESS_START + 1 * ACCESS_ELEMENT_COUNT / ACCESS_MODEL_COUNT,
+                            ELEMENT_ADDRESS_START + 2 * ACCESS_ELEMENT_COUNT / ACCESS_MODEL_COUNT};
+
+    access_publish_trace_t trace;
+    access_publish_trace_begin();
+
+    expect_tx(expected_data, length, src[0], PUBLISH_ADDRESS_START, expected_tx_ttl_get(0), 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(0, &message));
+
+    expect_tx(expected_data, length, src[1], PUBLISH_ADDRESS_START, expected_tx_ttl_get(1), 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(1, &message));
+
+    expect_tx(expected_data, length, src[2], PUBLISH_ADDRESS_START + 2, expected_tx_ttl_get(2), 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(2, &message));
+
+    message.opcode.opcode = 0x7f;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, access_model_publish(0, &message));
+    message.opcode.opcode = 0x8123;
+
+    access_publish_trace_end();
+
+    access_publish_trace_get(&trace);
+    TEST_ASSERT_EQUAL(3, trace.publications);
+    TEST_ASSERT_EQUAL(1, trace.failed);
+    TEST_ASSERT_EQUAL(3 * length, trace.payload_bytes);
+
+    /* Publications outside of a traced tick are not counted, the trace of the last tick is kept. */
+    expect_tx(expected_data, length, src[1], PUBLISH_ADDRESS_START, expected_tx_ttl_get(1), 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(1, &message));
+
+    access_publish_trace_get(&trace);
+    TEST_ASSERT_EQUAL(3, trace.publications);
+
+    /* A tick without publications does not overwrite the trace. */
+    access_publish_trace_begin();
+    access_publish_trace_end();
+    access_publish_trace_get(&trace);
+    TEST_ASSERT_EQUAL(3, trace.publications);
+}
+
+void test_access_model_publish_address_override(void)
+{
+    build_device_setup(ACCESS_ELEMENT_COUNT, ACCESS_MODEL_COUNT);
+
+    const access_publish_retransmit_t no_retransmit = {.count = 0, .interval_steps = 0};
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_retransmit_set(0, no_retransmit));
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, access_model_publish_address_override_set(ACCESS_MODEL_COUNT, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, access_model_publish_address_override_set(0, DSM_ADDR_MAX));
+
+    const uint8_t data[] = {0x01, 0x02, 0x03};
+    access_message_tx_t message;
+    message.opcode.opcode = 0x8123;
+    message.opcode.company_id = ACCESS_COMPANY_ID_NONE;
+    message.p_buffer = data;
+    message.length = sizeof(data);
+    message.force_segmented = false;
+    message.transmic_size = NRF_MESH_TRANSMIC_SIZE_DEFAULT;
+
+    uint8_t expected_data[sizeof(data) + sizeof(uint32_t)];
+    uint32_t length = opcode_raw_write(message.opcode, expected_data);
+    memcpy(&expected_data[length], data, sizeof(data));
+    length += sizeof(data);
+
+    /* The publications go to the override, while the publish address is left as it is. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_address_override_set(0, ACCESS_ELEMENT_COUNT + 2));
+    dsm_handle_t address_handle;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_address_get(0, &address_handle));
+    TEST_ASSERT_EQUAL(ACCESS_ELEMENT_COUNT, address_handle);
+
+    expect_tx(expected_data, length, ELEMENT_ADDRESS_START, PUBLISH_ADDRESS_START + 2, expected_tx_ttl_get(0), 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(0, &message));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_address_override_set(0, DSM_HANDLE_INVALID));
+    expect_tx(expected_data, length, ELEMENT_ADDRESS_START, PUBLISH_ADDRESS_START, expected_tx_ttl_get(0), 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(0, &message));
+}
+
+void test_access_model_publish_with_ttl(void)
+{
+    const uint8_t data[] = {0x01, 0x02, 0x03};
+    access_message_tx_t message;
+    message.opcode.opcode = 0x8123;
+    message.opcode.company_id = ACCESS_COMPANY_ID_NONE;
+    message.p_buffer = data;
+    message.length = sizeof(data);
+    message.force_segmented = false;
+    message.transmic_size = NRF_MESH_TRANSMIC_SIZE_DEFAULT;
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_model_publish_with_ttl(0, NULL, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, access_model_publish_with_ttl(0, &message, NRF_MESH_TTL_MAX + 1));
+
+    build_device_setup(ACCESS_ELEMENT_COUNT, ACCESS_MODEL_COUNT);
+
+    const access_model_handle_t handle = 0;
+    const uint16_t src = ELEMENT_ADDRESS_START;
+    m_expected_model_info[handle].model_info.publish_ttl = 5;
+    model_change_wrapper(handle, NULL);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_ttl_set(handle, 5));
+
+    uint8_t expected_data[sizeof(data) + sizeof(uint32_t)];
+    uint32_t length = opcode_raw_write(message.opcode, expected_data);
+    memcpy(&expected_data[length], data, sizeof(data));
+    length += sizeof(data);
+
+    /* The message and its retransmissions use the given TTL, the publication state is left as it is. */
+    m_expected_retransmission_ttl = 0;
+    expect_tx(expected_data, length, src, PUBLISH_ADDRESS_START + handle, 0, 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    retransmission_Expect(handle);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_with_ttl(handle, &message, 0));
+
+    uint8_t publish_ttl;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_ttl_get(handle, &publish_ttl));
+    TEST_ASSERT_EQUAL(5, publish_ttl);
+
+    m_expected_retransmission_ttl = ACCESS_TTL_USE_PUBLISH;
+    expect_tx(expected_data, length, src, PUBLISH_ADDRESS_START + handle, expected_tx_ttl_get(handle), 0,
+              DSM_HANDLE_INVALID, TX_SECMAT_TYPE_MASTER);
+    retransmission_Expect(handle);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(handle, &message));
+}
+
+void test_benchmark(void)
+{
+    build_device_setup(ACCESS_ELEMENT_COUNT, ACCESS_MODEL_COUNT);
+
+    const access_publish_retransmit_t no_retransmit = {.count = 0, .interval_steps = 0};
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_retransmit_set(0, no_retransmit));
+
+    mesh_mem_alloc_StubWithCallback(benchmark_mem_alloc);
+    mesh_mem_free_StubWithCallback(benchmark_mem_free);
+    dsm_local_unicast_addresses_get_StubWithCallback(benchmark_local_unicast_addresses_get);
+    dsm_address_get_StubWithCallback(address_get_stub);
+    dsm_tx_secmat_get_StubWithCallback(benchmark_tx_secmat_get);
+    nrf_mesh_packet_send_StubWithCallback(benchmark_packet_send);
+    nrf_mesh_packet_reserve_StubWithCallback(benchmark_packet_reserve);
+    nrf_mesh_packet_commit_StubWithCallback(benchmark_packet_commit);
+
+    /* A typical model status message: the parameters are serialized into a stack buffer before
+     * publishing, or straight into the reserved network buffer. */
+    const uint16_t lengths[] = {1, 4, NRF_MESH_UNSEG_PAYLOAD_SIZE_MAX - 2};
+    access_message_tx_t message;
+    message.opcode.opcode = 0x8204;
+    message.opcode.company_id = ACCESS_COMPANY_ID_NONE;
+    message.force_segmented = false;
+    message.transmic_size = NRF_MESH_TRANSMIC_SIZE_DEFAULT;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(lengths); ++i)
+    {
+        message.length = lengths[i];
+
+        uint64_t start_ns = time_ns_get();
+        for (uint32_t j = 0; j < BENCHMARK_MESSAGES; ++j)
+        {
+            uint8_t params[NRF_MESH_UNSEG_PAYLOAD_SIZE_MAX];
+            memset(params, (uint8_t) j, message.length);
+            message.p_buffer = params;
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish(0, &message));
+        }
+        uint64_t copy_ns = time_ns_get() - start_ns;
+
+        start_ns = time_ns_get();
+        for (uint32_t j = 0; j < BENCHMARK_MESSAGES; ++j)
+        {
+            uint8_t * p_params;
+            message.p_buffer = NULL;
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_reserve(0, &message, &p_params));
+            memset(p_params, (uint8_t) j, message.length);
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_tx_commit(0));
+        }
+        uint64_t in_place_ns = time_ns_get() - start_ns;
+
+        TEST_ASSERT_EQUAL_HEX8((uint8_t) (BENCHMARK_MESSAGES - 1), m_benchmark_network_pdu[2]);
+        printf("access tx: %2u byte params: publish %4u ns, reserve/commit %4u ns per message\n",
+               message.length,
+               (uint32_t) (copy_ns / BENCHMARK_MESSAGES),
+               (uint32_t) (in_place_ns / BENCHMARK_MESSAGES));
+    }
+}
+
 void test_access_packet_tx(void)
 {
     const uint8_t data[] = "Hello, World";
@@ -1499,9 +1882,9 @@ void test_access_packet_tx(void)
     message.force_segmented = false;
     message.transmic_size = NRF_MESH_TRANSMIC_SIZE_DEFAULT;
 
-    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_packet_tx(0, NULL, data, sizeof(data)));
-    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_packet_tx(0, &message, NULL, sizeof(data)));
-    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_packet_tx(0, &message, data, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_packet_tx(0, NULL, ACCESS_TTL_USE_PUBLISH, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_packet_tx(0, &message, ACCESS_TTL_USE_PUBLISH, NULL, sizeof(data)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, access_packet_tx(0, &message, ACCESS_TTL_USE_PUBLISH, data, 0));
 
     message.length = ACCESS_MESSAGE_LENGTH_MAX;
     TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, access_model_publish(0, &message));
@@ -1742,6 +2125,39 @@ void test_error_conditions(void)
     send_msg(opcode, data, sizeof(data), ADDRESS_COUNT-1, DSM_APP_MAX + DSM_DEVICE_MAX-1);
 }
 
+void test_model_config_version(void)
+{
+    build_device_setup(ACCESS_ELEMENT_COUNT, ACCESS_MODEL_COUNT);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_subscription_lists_share(ACCESS_MODEL_COUNT-2, ACCESS_MODEL_COUNT-1));
+
+    TEST_ASSERT_EQUAL(0, access_model_config_version_get(ACCESS_MODEL_COUNT));
+
+    uint32_t versions[ACCESS_MODEL_COUNT];
+    for (access_model_handle_t i = 0; i < ACCESS_MODEL_COUNT; ++i)
+    {
+        versions[i] = access_model_config_version_get(i);
+        TEST_ASSERT_NOT_EQUAL(0, versions[i]);
+    }
+
+    /* A binding change only changes the version of the bound model. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_application_bind(0, 1));
+    TEST_ASSERT_NOT_EQUAL(versions[0], access_model_config_version_get(0));
+    for (access_model_handle_t i = 1; i < ACCESS_MODEL_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL(versions[i], access_model_config_version_get(i));
+    }
+    versions[0] = access_model_config_version_get(0);
+
+    /* A change to a shared subscription list changes the version of every model sharing it. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_subscription_add(ACCESS_MODEL_COUNT-1, ACCESS_ELEMENT_COUNT));
+    TEST_ASSERT_NOT_EQUAL(versions[ACCESS_MODEL_COUNT-2], access_model_config_version_get(ACCESS_MODEL_COUNT-2));
+    TEST_ASSERT_NOT_EQUAL(versions[ACCESS_MODEL_COUNT-1], access_model_config_version_get(ACCESS_MODEL_COUNT-1));
+    for (access_model_handle_t i = 0; i < ACCESS_MODEL_COUNT-2; ++i)
+    {
+        TEST_ASSERT_EQUAL(versions[i], access_model_config_version_get(i));
+    }
+}
+
 void test_settergetter(void)
 {
     dsm_handle_t address_handle = 0;
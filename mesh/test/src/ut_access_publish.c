@@ -47,6 +47,7 @@
 
 #include "access_config.h"
 #include "access_publish.h"
+#include "access_internal.h"
 
 /*******************************************************************************
  * Static Variables
@@ -60,6 +61,9 @@ static timestamp_t m_current_timestamp;
 static timer_event_t * mp_scheduled_event = NULL;
 static uint32_t timer_sch_reschedule_mock_called;
 
+static bool m_publish_trace_active;
+static uint32_t m_publish_trace_publications;
+
 /*******************************************************************************
  * Helper Functions // Mocks // Callbacks
  *******************************************************************************/
@@ -107,6 +111,10 @@ static void timer_sch_schedule_mock_trigger(void)
 
 static void publish_timeout_cb(access_model_handle_t handle, void * p_args)
 {
+    /* All publications of a tick are triggered while the tick is traced. */
+    TEST_ASSERT_TRUE(m_publish_trace_active);
+    ++m_publish_trace_publications;
+
     ++m_publish_timeout_cb_called;
     m_publish_timeout_cb_handle = handle;
 }
@@ -116,6 +124,19 @@ uint32_t access_model_p_args_get(access_model_handle_t handle, void ** pp_args)
     return NRF_SUCCESS;
 }
 
+void access_publish_trace_begin(void)
+{
+    TEST_ASSERT_FALSE(m_publish_trace_active);
+    m_publish_trace_active = true;
+    m_publish_trace_publications = 0;
+}
+
+void access_publish_trace_end(void)
+{
+    TEST_ASSERT_TRUE(m_publish_trace_active);
+    m_publish_trace_active = false;
+}
+
 /*******************************************************************************
  * Test Setup
  *******************************************************************************/
@@ -130,6 +151,8 @@ void setUp(void)
     m_current_timestamp = 0;
     mp_scheduled_event = NULL;
     timer_sch_reschedule_mock_called = 0;
+    m_publish_trace_active = false;
+    m_publish_trace_publications = 0;
 
     access_publish_init();
 }
@@ -238,10 +261,12 @@ void test_periodic_publishing_multimodel(void)
 
             TEST_ASSERT_NOT_NULL(mp_scheduled_event);
 
-            /* Trigger the publishing event: */
+            /* Trigger the publishing event, both models publish in the same traced tick: */
             m_publish_timeout_cb_called = 0;
             timer_sch_schedule_mock_trigger();
             TEST_ASSERT_EQUAL(2, m_publish_timeout_cb_called);
+            TEST_ASSERT_EQUAL(2, m_publish_trace_publications);
+            TEST_ASSERT_FALSE(m_publish_trace_active);
             TEST_ASSERT_NOT_NULL(mp_scheduled_event);
         }
     }
@@ -96,6 +96,7 @@
 typedef struct
 {
     access_message_tx_t tx_message;
+    uint8_t ttl;
     uint8_t *p_access_payload;
     uint16_t access_payload_length;
     bool is_expected;
@@ -122,6 +123,7 @@ timestamp_t timer_now()
 
 static uint32_t access_packet_tx_mock(access_model_handle_t handle,
                                       const access_message_tx_t * p_tx_message,
+                                      uint8_t ttl,
                                       const uint8_t *p_access_payload,
                                       uint16_t access_payload_length,
                                       int num_calls)
@@ -137,6 +139,8 @@ static uint32_t access_packet_tx_mock(access_model_handle_t handle,
                              p_tx_message,
                              sizeof(access_message_tx_t));
 
+    TEST_ASSERT_EQUAL(m_expected_msgs_to_be_published[handle].ttl, ttl);
+
     TEST_ASSERT_EQUAL(m_expected_msgs_to_be_published[handle].access_payload_length,
                       access_payload_length);
 
@@ -179,8 +183,10 @@ static timestamp_t add_message(access_model_handle_t model_handle,
         EXPECT(timer_sch_reschedule_mock, 1);
     }
 
+    /* Each message keeps its own TTL, use the handle to tell them apart */
     access_publish_retransmission_message_add(model_handle, p_publish_retransmit,
                                               p_tx_message,
+                                              (uint8_t) model_handle,
                                               (uint8_t *) p_tx_message->p_buffer,
                                               p_tx_message->length);
 
@@ -191,6 +197,7 @@ static timestamp_t add_message(access_model_handle_t model_handle,
 
     /* Store allocated pointer in the tx_message */
     m_expected_msgs_to_be_published[model_handle].tx_message = *p_tx_message;
+    m_expected_msgs_to_be_published[model_handle].ttl = (uint8_t) model_handle;
     m_expected_msgs_to_be_published[model_handle].p_access_payload = (uint8_t*) p_tx_message->p_buffer;
     m_expected_msgs_to_be_published[model_handle].access_payload_length = p_tx_message->length;
     m_expected_msgs_to_be_published[model_handle].is_expected = true;
@@ -258,28 +265,28 @@ void test_fail_on_add_message(void)
 
     TEST_NRF_MESH_ASSERT_EXPECT(access_publish_retransmission_message_add(
                                     ACCESS_MODEL_COUNT, &publish_retransmit,
-                                    &tx_message, (uint8_t*) tx_message.p_buffer,
+                                    &tx_message, ACCESS_TTL_USE_PUBLISH, (uint8_t*) tx_message.p_buffer,
                                     tx_message.length));
     TEST_NRF_MESH_ASSERT_EXPECT(access_publish_retransmission_message_add(
-                                    0, NULL, &tx_message,
+                                    0, NULL, &tx_message, ACCESS_TTL_USE_PUBLISH,
                                     (uint8_t*) tx_message.p_buffer,
                                     tx_message.length));
     TEST_NRF_MESH_ASSERT_EXPECT(access_publish_retransmission_message_add(
-                                    0, &publish_retransmit, NULL,
+                                    0, &publish_retransmit, NULL, ACCESS_TTL_USE_PUBLISH,
                                     (uint8_t*) tx_message.p_buffer,
                                     tx_message.length));
     TEST_NRF_MESH_ASSERT_EXPECT(access_publish_retransmission_message_add(
-                                    0, &publish_retransmit, &tx_message,
+                                    0, &publish_retransmit, &tx_message, ACCESS_TTL_USE_PUBLISH,
                                     NULL,
                                     tx_message.length));
     TEST_NRF_MESH_ASSERT_EXPECT(access_publish_retransmission_message_add(
-                                    0, &publish_retransmit, &tx_message,
+                                    0, &publish_retransmit, &tx_message, ACCESS_TTL_USE_PUBLISH,
                                     (uint8_t*) tx_message.p_buffer,
                                     0));
 
     publish_retransmit.count = 0;
     TEST_NRF_MESH_ASSERT_EXPECT(access_publish_retransmission_message_add(
-                                    0, &publish_retransmit, &tx_message,
+                                    0, &publish_retransmit, &tx_message, ACCESS_TTL_USE_PUBLISH,
                                     (uint8_t*) tx_message.p_buffer,
                                     tx_message.length));
 }
@@ -2270,6 +2270,7 @@ void test_sig_model_subscription_get(void)
 
     dsm_handle_t subscriptions[] = { 1, 22, 882, 31771 };
     uint16_t subscription_count = ARRAY_SIZE(subscriptions);
+    access_model_config_version_get_ExpectAndReturn(model_handle, 1);
     access_model_subscriptions_get_StubWithCallback(access_model_subscriptions_get_mock);
     ACCESS_MODEL_SUBSCRIPTIONS_GET_MOCK_SETUP(model_handle, subscriptions,
                                               subscription_count, NRF_SUCCESS);
@@ -2328,6 +2329,7 @@ void test_vendor_model_subscription_get(void)
 
     dsm_handle_t subscriptions[] = { 1, 22, 882, 31771 };
     uint16_t subscription_count = ARRAY_SIZE(subscriptions);
+    access_model_config_version_get_ExpectAndReturn(model_handle, 1);
     access_model_subscriptions_get_StubWithCallback(access_model_subscriptions_get_mock);
     ACCESS_MODEL_SUBSCRIPTIONS_GET_MOCK_SETUP(model_handle, subscriptions,
                                               subscription_count, NRF_SUCCESS);
@@ -2380,6 +2382,8 @@ void test_sig_model_app_get(void)
 
     dsm_handle_t appkey_handles[] = { 1, 2, 3, 4, 5 };
     uint16_t appkey_handle_count = ARRAY_SIZE(appkey_handles);
+    access_model_config_version_get_ExpectAndReturn(model_handle, 1);
+    dsm_appkey_version_get_ExpectAndReturn(1);
     access_model_applications_get_StubWithCallback(access_model_applications_get_mock);
     ACCESS_MODEL_APPLICATIONS_GET_MOCK_SETUP(model_handle, appkey_handles, appkey_handle_count, NRF_SUCCESS);
 
@@ -2413,6 +2417,82 @@ void test_sig_model_app_get(void)
     TEST_ASSERT_EQUAL_MEMORY(appkey_indexes_packed, p_reply->key_indexes, sizeof(appkey_indexes_packed));
 }
 
+void test_model_app_get_cached(void)
+{
+    config_server_evt_t evt;
+    memset(&evt, 0, sizeof(config_server_evt_t));
+    evt.type = CONFIG_SERVER_EVT_SIG_MODEL_APP_GET;
+    const config_msg_model_app_get_t message =
+    {
+        .element_address = 0x1111,
+        .model_id.sig.model_id = 0x2222
+    };
+
+    uint16_t element_index = 7;
+    const access_model_handle_t model_handles[] = { 0x2ffa, 0x2ffb };
+
+    dsm_handle_t appkey_handles[] = { 1, 2 };
+    uint16_t appkey_handle_count = ARRAY_SIZE(appkey_handles);
+    access_model_applications_get_StubWithCallback(access_model_applications_get_mock);
+
+    mesh_key_index_t appkey_indexes[] = { 11, 12 };
+    const uint8_t appkey_indexes_packed[] = { 0x0b, 0xc0, 0x00 };
+
+    /* Requests for a model are served from its cached list until the configuration of that model or
+     * the application keys change. A configuration change of another model does not drop the list. */
+    const struct
+    {
+        uint32_t model;
+        uint32_t model_version;
+        uint32_t appkey_version;
+        bool is_cached;
+    } requests[] =
+    {
+        { 0, 1, 1, false },
+        { 0, 1, 1, true },
+        { 1, 5, 1, false },
+        { 0, 1, 1, true },
+        { 0, 1, 2, false },
+        { 0, 6, 2, false },
+        { 1, 5, 2, false },
+        { 1, 5, 2, true },
+    };
+    for (uint32_t request = 0; request < ARRAY_SIZE(requests); ++request)
+    {
+        access_model_handle_t model_handle = model_handles[requests[request].model];
+        evt.params.model_app_get.model_handle = model_handle;
+
+        EXPECT_DSM_LOCAL_UNICAST_ADDRESSES_GET(message.element_address, element_index);
+        access_handle_get_ExpectAnyArgsAndReturn(NRF_SUCCESS);
+        access_handle_get_ReturnThruPtr_p_handle(&model_handle);
+        access_model_config_version_get_ExpectAndReturn(model_handle, requests[request].model_version);
+        dsm_appkey_version_get_ExpectAndReturn(requests[request].appkey_version);
+
+        if (!requests[request].is_cached)
+        {
+            ACCESS_MODEL_APPLICATIONS_GET_MOCK_SETUP(model_handle, appkey_handles, appkey_handle_count, NRF_SUCCESS);
+            for (uint16_t i = 0; i < appkey_handle_count; ++i)
+            {
+                dsm_appkey_handle_to_appkey_index_ExpectAndReturn(appkey_handles[i], NULL, NRF_SUCCESS);
+                dsm_appkey_handle_to_appkey_index_IgnoreArg_p_index();
+                dsm_appkey_handle_to_appkey_index_ReturnThruPtr_p_index(&appkey_indexes[i]);
+            }
+        }
+
+        config_server_evt_mock_Expect(&evt);
+        m_previous_reply_received = false;
+        send_message(CONFIG_OPCODE_SIG_MODEL_APP_GET, (const uint8_t *) &message, sizeof(message) - sizeof(uint16_t));
+
+        TEST_ASSERT_TRUE(m_previous_reply_received);
+        VERIFY_REPLY_OPCODE(CONFIG_OPCODE_SIG_MODEL_APP_LIST);
+        TEST_ASSERT_EQUAL(sizeof(config_msg_sig_model_app_list_t) + sizeof(appkey_indexes_packed), m_previous_reply.length);
+
+        const config_msg_sig_model_app_list_t * p_reply = (const config_msg_sig_model_app_list_t *) m_previous_reply.p_buffer;
+        TEST_ASSERT_EQUAL(ACCESS_STATUS_SUCCESS, p_reply->status);
+        TEST_ASSERT_EQUAL_MEMORY(appkey_indexes_packed, p_reply->key_indexes, sizeof(appkey_indexes_packed));
+    }
+}
+
 void test_vendor_model_app_get(void)
 {
     config_server_evt_t evt;
@@ -2440,6 +2520,8 @@ void test_vendor_model_app_get(void)
 
     dsm_handle_t appkey_handles[] = { 1, 2, 3, 4, 5 };
     uint16_t appkey_handle_count = ARRAY_SIZE(appkey_handles);
+    access_model_config_version_get_ExpectAndReturn(model_handle, 1);
+    dsm_appkey_version_get_ExpectAndReturn(1);
     access_model_applications_get_StubWithCallback(access_model_applications_get_mock);
     ACCESS_MODEL_APPLICATIONS_GET_MOCK_SETUP(model_handle, appkey_handles, appkey_handle_count, NRF_SUCCESS);
 
@@ -1570,10 +1570,13 @@ void test_net(void)
     /* Bind one app and one devkey to net[1] */
     uint8_t dummy_key[NRF_MESH_KEY_SIZE] = {};
     dsm_handle_t app_handle;
+    uint32_t appkey_version = dsm_appkey_version_get();
     nrf_mesh_keygen_aid_IgnoreAndReturn(NRF_SUCCESS);
     persist_expect_appkey(dummy_key, 0, net[1].handle, true);
     TEST_ASSERT_EQUAL(NRF_SUCCESS, dsm_appkey_add(0, net[1].handle, dummy_key, &app_handle));
     check_stored_appkey(dummy_key, NULL, 0, net[1].handle, app_handle,false);
+    TEST_ASSERT_NOT_EQUAL(appkey_version, dsm_appkey_version_get());
+    appkey_version = dsm_appkey_version_get();
     dsm_handle_t devkey_handle;
     persist_expect_devkey(dummy_key, 0x0001, net[1].handle, true);
     TEST_ASSERT_EQUAL(NRF_SUCCESS, dsm_devkey_add(0x0001, net[1].handle, dummy_key, &devkey_handle));
@@ -1587,6 +1590,7 @@ void test_net(void)
     /* Delete the app */
     persist_invalidate_expect(app_handle + MESH_OPT_DSM_APPKEYS_RECORD);
     TEST_ASSERT_EQUAL(NRF_SUCCESS, dsm_appkey_delete(app_handle));
+    TEST_ASSERT_NOT_EQUAL(appkey_version, dsm_appkey_version_get());
     /* Delete the devkey */
     persist_invalidate_expect(devkey_handle - DSM_APP_MAX + MESH_OPT_DSM_DEVKEYS_RECORD);
     TEST_ASSERT_EQUAL(NRF_SUCCESS, dsm_devkey_delete(devkey_handle));
@@ -0,0 +1,392 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dfu_distribution.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+
+#define TID_APP             (0x11111111)
+#define TID_SD              (0x22222222)
+#define TID_BL              (0x33333333)
+#define DATA_TX_REPEATS     (3)
+#define REQ_RX_COUNT_RETRY  (8)
+
+static const nrf_mesh_fwid_t m_fwid_app = {.application = {.company_id = 0x59, .app_id = 1, .app_version = 2}};
+static const nrf_mesh_fwid_t m_fwid_sd = {.softdevice = 0x00A8};
+static const nrf_mesh_fwid_t m_fwid_bl = {.bootloader = {.bl_id = 1, .bl_version = 2}};
+
+void setUp(void)
+{
+    dfu_distribution_init();
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+
+static uint32_t fwid_len(nrf_mesh_dfu_type_t type)
+{
+    switch (type)
+    {
+        case NRF_MESH_DFU_TYPE_APPLICATION:
+            return DFU_FWID_LEN_APP;
+        case NRF_MESH_DFU_TYPE_BOOTLOADER:
+            return DFU_FWID_LEN_BL;
+        default:
+            return DFU_FWID_LEN_SD;
+    }
+}
+
+static bool state_rx(nrf_mesh_dfu_type_t type, const nrf_mesh_fwid_t * p_fwid, uint32_t tid)
+{
+    nrf_mesh_dfu_packet_t packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.packet_type = DFU_PACKET_TYPE_STATE;
+    packet.payload.state.dfu_type = type;
+    packet.payload.state.transaction_id = tid;
+    packet.payload.state.fwid = *p_fwid;
+    return dfu_distribution_rx(&packet, 2 + 1 + 1 + 4 + fwid_len(type));
+}
+
+static void transfer_add(nrf_mesh_dfu_type_t type, const nrf_mesh_fwid_t * p_fwid, uint32_t tid, uint8_t priority)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_add(type, p_fwid, priority));
+    (void) state_rx(type, p_fwid, tid);
+}
+
+static bool data_rx(uint16_t packet_type, uint32_t tid, uint16_t segment)
+{
+    nrf_mesh_dfu_packet_t packet;
+    packet.packet_type = packet_type;
+    packet.payload.data.segment = segment;
+    packet.payload.data.transaction_id = tid;
+    for (uint32_t i = 0; i < NRF_MESH_DFU_SEGMENT_LENGTH; ++i)
+    {
+        packet.payload.data.data[i] = (uint8_t) (segment + i);
+    }
+    return dfu_distribution_rx(&packet, DFU_PACKET_LEN_DATA);
+}
+
+static bool req_rx(uint32_t tid, uint16_t segment)
+{
+    nrf_mesh_dfu_packet_t packet;
+    packet.packet_type = DFU_PACKET_TYPE_DATA_REQ;
+    packet.payload.req_data.segment = segment;
+    packet.payload.req_data.transaction_id = tid;
+    return dfu_distribution_rx(&packet, DFU_PACKET_LEN_DATA_REQ);
+}
+
+static void tx_expect(uint16_t packet_type, uint32_t tid, uint16_t segment)
+{
+    nrf_mesh_dfu_packet_t packet;
+    uint32_t length;
+    TEST_ASSERT_TRUE(dfu_distribution_tx_get(&packet, &length));
+    TEST_ASSERT_EQUAL_HEX16(packet_type, packet.packet_type);
+    TEST_ASSERT_EQUAL_HEX32(tid, packet.payload.data.transaction_id);
+    TEST_ASSERT_EQUAL(segment, packet.payload.data.segment);
+    if (packet_type == DFU_PACKET_TYPE_DATA || packet_type == DFU_PACKET_TYPE_DATA_RSP)
+    {
+        TEST_ASSERT_EQUAL(DFU_PACKET_LEN_DATA, length);
+        TEST_ASSERT_EQUAL_HEX8(segment, packet.payload.data.data[0]);
+    }
+}
+
+static uint32_t tx_flush(void)
+{
+    nrf_mesh_dfu_packet_t packet;
+    uint32_t length;
+    uint32_t count = 0;
+    while (dfu_distribution_tx_get(&packet, &length))
+    {
+        count++;
+    }
+    return count;
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_add_remove(void)
+{
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, dfu_distribution_add(NRF_MESH_DFU_TYPE_APPLICATION, NULL, 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, dfu_distribution_add(NRF_MESH_DFU_TYPE_BL_INFO, &m_fwid_app, 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, dfu_distribution_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, dfu_distribution_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, DFU_DISTRIBUTION_PRIORITY_MAX + 1));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, dfu_distribution_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, 2));
+
+    /* Same type with another FWID is another transfer. */
+    nrf_mesh_fwid_t fwid = m_fwid_app;
+    for (uint32_t i = 1; i < NRF_MESH_DFU_DISTRIBUTION_TRANSFERS_MAX; ++i)
+    {
+        fwid.application.app_version++;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_add(NRF_MESH_DFU_TYPE_APPLICATION, &fwid, 1));
+    }
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, dfu_distribution_add(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd, 1));
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, dfu_distribution_remove(NRF_MESH_DFU_TYPE_APPLICATION, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, dfu_distribution_remove(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_remove(NRF_MESH_DFU_TYPE_APPLICATION, &fwid));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, dfu_distribution_remove(NRF_MESH_DFU_TYPE_APPLICATION, &fwid));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_add(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd, 1));
+
+    dfu_distribution_stats_t stats;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, dfu_distribution_stats_get(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, dfu_distribution_stats_get(NRF_MESH_DFU_TYPE_BOOTLOADER, &m_fwid_bl, &stats));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_stats_get(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd, &stats));
+}
+
+void test_relay(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, 1));
+
+    /* The transaction ID isn't known before the state beacon. */
+    TEST_ASSERT_FALSE(data_rx(DFU_PACKET_TYPE_DATA, TID_APP, 1));
+    /* Beacons for other transfers are ignored. */
+    TEST_ASSERT_FALSE(state_rx(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd, TID_SD));
+    TEST_ASSERT_FALSE(data_rx(DFU_PACKET_TYPE_DATA, TID_SD, 1));
+    TEST_ASSERT_FALSE(state_rx(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, TID_APP));
+
+    TEST_ASSERT_TRUE(data_rx(DFU_PACKET_TYPE_DATA, TID_APP, 1));
+    /* Duplicates aren't relayed again. */
+    TEST_ASSERT_TRUE(data_rx(DFU_PACKET_TYPE_DATA, TID_APP, 1));
+    TEST_ASSERT_TRUE(data_rx(DFU_PACKET_TYPE_DATA_RSP, TID_APP, 2));
+
+    /* Repeats are interleaved. */
+    for (uint32_t i = 0; i < DATA_TX_REPEATS; ++i)
+    {
+        tx_expect(DFU_PACKET_TYPE_DATA, TID_APP, 1);
+        tx_expect(DFU_PACKET_TYPE_DATA_RSP, TID_APP, 2);
+    }
+    TEST_ASSERT_EQUAL(0, tx_flush());
+
+    dfu_distribution_stats_t stats;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_stats_get(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, &stats));
+    TEST_ASSERT_EQUAL(2, stats.relay_count);
+    TEST_ASSERT_EQUAL(2 * DATA_TX_REPEATS, stats.tx_count);
+
+    /* A new transaction for the same FWID replaces the old one. */
+    TEST_ASSERT_FALSE(state_rx(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, TID_APP + 1));
+    TEST_ASSERT_FALSE(data_rx(DFU_PACKET_TYPE_DATA, TID_APP, 3));
+    TEST_ASSERT_TRUE(data_rx(DFU_PACKET_TYPE_DATA, TID_APP + 1, 1));
+    tx_expect(DFU_PACKET_TYPE_DATA, TID_APP + 1, 1);
+
+    /* Removing the transfer drops its queue. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_remove(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app));
+    TEST_ASSERT_EQUAL(0, tx_flush());
+}
+
+void test_queue_full(void)
+{
+    transfer_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, TID_APP, 1);
+    for (uint16_t segment = 1; segment <= NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE + 2; ++segment)
+    {
+        TEST_ASSERT_TRUE(data_rx(DFU_PACKET_TYPE_DATA, TID_APP, segment));
+    }
+    dfu_distribution_stats_t stats;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_stats_get(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, &stats));
+    TEST_ASSERT_EQUAL(NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE, stats.relay_count);
+    TEST_ASSERT_EQUAL(2, stats.drop_count);
+    TEST_ASSERT_EQUAL(NRF_MESH_DFU_DISTRIBUTION_QUEUE_SIZE * DATA_TX_REPEATS, tx_flush());
+}
+
+void test_requests(void)
+{
+    transfer_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, TID_APP, 1);
+    (void) data_rx(DFU_PACKET_TYPE_DATA, TID_APP, 10);
+    (void) tx_flush();
+
+    /* Cached segments are answered, the rest is passed on. */
+    TEST_ASSERT_TRUE(req_rx(TID_APP, 10));
+    for (uint32_t i = 0; i < DATA_TX_REPEATS; ++i)
+    {
+        tx_expect(DFU_PACKET_TYPE_DATA_RSP, TID_APP, 10);
+    }
+    TEST_ASSERT_EQUAL(0, tx_flush());
+    TEST_ASSERT_TRUE(req_rx(TID_APP, 9));
+    tx_expect(DFU_PACKET_TYPE_DATA_REQ, TID_APP, 9);
+    TEST_ASSERT_EQUAL(0, tx_flush());
+
+    /* Repeated requests are only handled again after a while. */
+    for (uint32_t i = 0; i < REQ_RX_COUNT_RETRY; ++i)
+    {
+        TEST_ASSERT_FALSE(req_rx(TID_APP, 10));
+        TEST_ASSERT_FALSE(req_rx(TID_APP, 9));
+    }
+    TEST_ASSERT_TRUE(req_rx(TID_APP, 10));
+    TEST_ASSERT_EQUAL(DATA_TX_REPEATS, tx_flush());
+    TEST_ASSERT_TRUE(req_rx(TID_APP, 9));
+    TEST_ASSERT_EQUAL(1, tx_flush());
+
+    /* Data requests with ranges: up to 4 segments are answered. Since more might be missing, the request is passed on. */
+    for (uint16_t segment = 20; segment < 30; ++segment)
+    {
+        (void) data_rx(DFU_PACKET_TYPE_DATA, TID_APP, segment);
+    }
+    (void) tx_flush();
+    nrf_mesh_dfu_packet_t packet;
+    packet.packet_type = DFU_PACKET_TYPE_DATA_REQ;
+    packet.payload.req_range.segment = 20;
+    packet.payload.req_range.transaction_id = TID_APP;
+    packet.payload.req_range.ranges[0].segment = 20;
+    packet.payload.req_range.ranges[0].count = 2;
+    packet.payload.req_range.ranges[1].segment = 25;
+    packet.payload.req_range.ranges[1].count = 5;
+    TEST_ASSERT_TRUE(dfu_distribution_rx(&packet, DFU_PACKET_LEN_DATA_REQ_RANGE(2)));
+    tx_expect(DFU_PACKET_TYPE_DATA_RSP, TID_APP, 20);
+    tx_expect(DFU_PACKET_TYPE_DATA_RSP, TID_APP, 21);
+    tx_expect(DFU_PACKET_TYPE_DATA_RSP, TID_APP, 25);
+    tx_expect(DFU_PACKET_TYPE_DATA_RSP, TID_APP, 26);
+    tx_expect(DFU_PACKET_TYPE_DATA_REQ, TID_APP, 20);
+    TEST_ASSERT_EQUAL(4 * DATA_TX_REPEATS - 4, tx_flush());
+
+    /* Everything requested is answered, nothing to pass on. */
+    packet.payload.req_range.segment = 22;
+    packet.payload.req_range.ranges[0].segment = 22;
+    packet.payload.req_range.ranges[0].count = 3;
+    TEST_ASSERT_TRUE(dfu_distribution_rx(&packet, DFU_PACKET_LEN_DATA_REQ_RANGE(1)));
+    TEST_ASSERT_EQUAL(3 * DATA_TX_REPEATS, tx_flush());
+
+    /* Malformed requests are ignored. */
+    TEST_ASSERT_FALSE(dfu_distribution_rx(&packet, DFU_PACKET_LEN_DATA_REQ_RANGE(1) - 1));
+    TEST_ASSERT_FALSE(dfu_distribution_rx(&packet, DFU_PACKET_LEN_DATA_REQ_RANGE(DFU_PACKET_REQ_RANGES_MAX + 1)));
+}
+
+void test_fairness(void)
+{
+    transfer_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, TID_APP, 4);
+    transfer_add(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd, TID_SD, 2);
+    transfer_add(NRF_MESH_DFU_TYPE_BOOTLOADER, &m_fwid_bl, TID_BL, 1);
+
+    static const uint32_t tids[] = {TID_APP, TID_SD, TID_BL};
+    uint16_t next_segment[3] = {1, 1, 1};
+    uint32_t tx_counts[3] = {0};
+
+    /* All three sources keep their queues full. */
+    const uint32_t tx_total = 7000;
+    for (uint32_t i = 0; i < tx_total; ++i)
+    {
+        for (uint32_t t = 0; t < 3; ++t)
+        {
+            (void) data_rx(DFU_PACKET_TYPE_DATA, tids[t], next_segment[t]++);
+        }
+        nrf_mesh_dfu_packet_t packet;
+        uint32_t length;
+        TEST_ASSERT_TRUE(dfu_distribution_tx_get(&packet, &length));
+        for (uint32_t t = 0; t < 3; ++t)
+        {
+            if (packet.payload.data.transaction_id == tids[t])
+            {
+                tx_counts[t]++;
+            }
+        }
+    }
+    printf("dfu_distribution: airtime share for priority 4/2/1: %u/%u/%u of %u\n",
+           tx_counts[0], tx_counts[1], tx_counts[2], tx_total);
+    TEST_ASSERT_UINT32_WITHIN(4, 4000, tx_counts[0]);
+    TEST_ASSERT_UINT32_WITHIN(4, 2000, tx_counts[1]);
+    TEST_ASSERT_UINT32_WITHIN(4, 1000, tx_counts[2]);
+
+    /* A transfer that was idle doesn't get to catch up on the airtime it didn't use. */
+    (void) tx_flush();
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        (void) data_rx(DFU_PACKET_TYPE_DATA, TID_BL, next_segment[2]++);
+        (void) tx_flush();
+    }
+    memset(tx_counts, 0, sizeof(tx_counts));
+    for (uint32_t i = 0; i < 70; ++i)
+    {
+        (void) data_rx(DFU_PACKET_TYPE_DATA, TID_APP, next_segment[0]++);
+        (void) data_rx(DFU_PACKET_TYPE_DATA, TID_BL, next_segment[2]++);
+        nrf_mesh_dfu_packet_t packet;
+        uint32_t length;
+        TEST_ASSERT_TRUE(dfu_distribution_tx_get(&packet, &length));
+        tx_counts[packet.payload.data.transaction_id == TID_APP ? 0 : 2]++;
+    }
+    TEST_ASSERT_UINT32_WITHIN(2, 56, tx_counts[0]);
+    TEST_ASSERT_UINT32_WITHIN(2, 14, tx_counts[2]);
+}
+
+void test_cache_hit_rate(void)
+{
+    transfer_add(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, TID_APP, 1);
+    transfer_add(NRF_MESH_DFU_TYPE_SOFTDEVICE, &m_fwid_sd, TID_SD, 1);
+
+    /* Both transfers stream data, and targets ask for segments they lost a little while ago. */
+    uint32_t rand_state = 0x5EED;
+    uint32_t requests = 0;
+    const uint32_t lag_max = NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE;
+    for (uint16_t segment = 1; segment <= 2000; ++segment)
+    {
+        (void) data_rx(DFU_PACKET_TYPE_DATA, TID_APP, segment);
+        (void) data_rx(DFU_PACKET_TYPE_DATA, TID_SD, segment);
+        (void) tx_flush();
+
+        rand_state = rand_state * 1103515245u + 12345u;
+        uint32_t lag = 1 + ((rand_state >> 16) % lag_max);
+        if ((rand_state >> 8) % 4 == 0 && lag < segment)
+        {
+            (void) req_rx(TID_APP, segment - lag);
+            (void) tx_flush();
+            requests++;
+        }
+    }
+
+    dfu_distribution_stats_t stats;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_distribution_stats_get(NRF_MESH_DFU_TYPE_APPLICATION, &m_fwid_app, &stats));
+    TEST_ASSERT_EQUAL(requests, stats.cache_hits + stats.cache_misses);
+    uint32_t hit_rate = (stats.cache_hits * 100) / requests;
+    printf("dfu_distribution: %u requests, %u%% answered from a %u segment cache shared by 2 transfers\n",
+           requests, hit_rate, NRF_MESH_DFU_DISTRIBUTION_CACHE_SIZE);
+    /* Half of the cache holds segments of each transfer. */
+    TEST_ASSERT_UINT32_WITHIN(5, 50, hit_rate);
+}
@@ -0,0 +1,282 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dfu_hash.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "dfu_missing.h"
+#include "nrf_error.h"
+
+#define SEGMENT_LENGTH      (16)
+#define SEGMENT_COUNT       (300)
+/* The last segment is only half full. */
+#define IMAGE_LENGTH        (SEGMENT_COUNT * SEGMENT_LENGTH - SEGMENT_LENGTH / 2)
+#define HEADER_LENGTH       (14)
+#define HASH_STEP_MAX       (SEGMENT_LENGTH * 8)
+#define DIGEST_LENGTH       (16)
+
+static uint8_t m_image[IMAGE_LENGTH];
+static uint8_t m_bank[IMAGE_LENGTH];
+static uint8_t m_header[HEADER_LENGTH];
+static uint32_t m_rand_state;
+
+void setUp(void)
+{
+    m_rand_state = 0x5EED;
+    for (uint32_t i = 0; i < IMAGE_LENGTH; ++i)
+    {
+        m_image[i] = (uint8_t) (i * 7 + (i >> 8));
+    }
+    for (uint32_t i = 0; i < HEADER_LENGTH; ++i)
+    {
+        m_header[i] = (uint8_t) (0xA0 + i);
+    }
+    /* Erased flash */
+    memset(m_bank, 0xFF, sizeof(m_bank));
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* SHA-256 replacement
+*****************************************************************************/
+
+/* The digest only has to depend on the order and content of all the bytes hashed, not on how the
+ * updates are split up, so a 64 bit FNV-1a stands in for SHA-256. */
+typedef struct
+{
+    uint64_t state;
+    uint64_t length;
+} fake_hash_t;
+
+ret_code_t sha256_init(sha256_context_t * p_ctx)
+{
+    fake_hash_t hash = {.state = 0xCBF29CE484222325ull, .length = 0};
+    memset(p_ctx, 0, sizeof(sha256_context_t));
+    memcpy(p_ctx, &hash, sizeof(hash));
+    return NRF_SUCCESS;
+}
+
+ret_code_t sha256_update(sha256_context_t * p_ctx, const uint8_t * p_data, const size_t len)
+{
+    fake_hash_t hash;
+    memcpy(&hash, p_ctx, sizeof(hash));
+    for (size_t i = 0; i < len; ++i)
+    {
+        hash.state = (hash.state ^ p_data[i]) * 0x100000001B3ull;
+    }
+    hash.length += len;
+    memcpy(p_ctx, &hash, sizeof(hash));
+    return NRF_SUCCESS;
+}
+
+ret_code_t sha256_final(sha256_context_t * p_ctx, uint8_t * p_hash, uint8_t le)
+{
+    fake_hash_t hash;
+    memcpy(&hash, p_ctx, sizeof(hash));
+    memcpy(&p_hash[0], &hash.state, sizeof(hash.state));
+    memcpy(&p_hash[8], &hash.length, sizeof(hash.length));
+    return NRF_SUCCESS;
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+
+static uint32_t rand_get(void)
+{
+    m_rand_state = m_rand_state * 1103515245u + 12345u;
+    return (m_rand_state >> 16) & 0x7FFF;
+}
+
+static void header_hash(sha256_context_t * p_ctx)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_init(p_ctx));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_update(p_ctx, m_header, HEADER_LENGTH));
+}
+
+static void one_shot_digest(uint8_t * p_digest)
+{
+    sha256_context_t ctx;
+    header_hash(&ctx);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_update(&ctx, m_image, IMAGE_LENGTH));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, p_digest, false));
+}
+
+/** Same as dfu_transfer_data() followed by a flash write complete. */
+static uint32_t segment_rx(dfu_missing_t * p_missing, dfu_hash_t * p_hash, uint16_t segment)
+{
+    uint32_t status = dfu_missing_segment_rx(p_missing, segment);
+    if (status == NRF_SUCCESS)
+    {
+        uint32_t offset = (segment - 1) * SEGMENT_LENGTH;
+        uint32_t length = (offset + SEGMENT_LENGTH > IMAGE_LENGTH) ? IMAGE_LENGTH - offset : SEGMENT_LENGTH;
+        memcpy(&m_bank[offset], &m_image[offset], length);
+        (void) dfu_hash_update(p_hash, dfu_missing_prefix_get(p_missing) * SEGMENT_LENGTH, HASH_STEP_MAX);
+        /* Never hash data that isn't in place yet */
+        TEST_ASSERT_TRUE(p_hash->offset <= dfu_missing_prefix_get(p_missing) * SEGMENT_LENGTH);
+    }
+    return status;
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_update(void)
+{
+    dfu_hash_t hash;
+    sha256_context_t ctx;
+    header_hash(&ctx);
+    dfu_hash_start(&hash, &ctx, m_image, IMAGE_LENGTH);
+    TEST_ASSERT_EQUAL(0, hash.offset);
+
+    TEST_ASSERT_EQUAL(0, dfu_hash_update(&hash, 0, HASH_STEP_MAX));
+    TEST_ASSERT_EQUAL(32, dfu_hash_update(&hash, 32, HASH_STEP_MAX));
+    TEST_ASSERT_EQUAL(0, dfu_hash_update(&hash, 32, HASH_STEP_MAX));
+    TEST_ASSERT_EQUAL(0, dfu_hash_update(&hash, 16, HASH_STEP_MAX));
+    /* Bounded by the step size */
+    TEST_ASSERT_EQUAL(HASH_STEP_MAX, dfu_hash_update(&hash, 1024, HASH_STEP_MAX));
+    TEST_ASSERT_EQUAL(32 + HASH_STEP_MAX, hash.offset);
+    /* Bounded by the length */
+    TEST_ASSERT_EQUAL(IMAGE_LENGTH - hash.offset, dfu_hash_update(&hash, IMAGE_LENGTH + 100, IMAGE_LENGTH));
+    TEST_ASSERT_EQUAL(IMAGE_LENGTH, hash.offset);
+    TEST_ASSERT_EQUAL(0, dfu_hash_update(&hash, IMAGE_LENGTH + 100, IMAGE_LENGTH));
+
+    uint8_t expected[DIGEST_LENGTH];
+    uint8_t digest[DIGEST_LENGTH];
+    one_shot_digest(expected);
+    dfu_hash_finish(&hash, &ctx);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, digest, false));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, digest, DIGEST_LENGTH);
+}
+
+void test_finish_hashes_tail(void)
+{
+    dfu_hash_t hash;
+    sha256_context_t ctx;
+    header_hash(&ctx);
+    dfu_hash_start(&hash, &ctx, m_image, IMAGE_LENGTH);
+    (void) dfu_hash_update(&hash, 100, HASH_STEP_MAX);
+
+    uint8_t expected[DIGEST_LENGTH];
+    uint8_t digest[DIGEST_LENGTH];
+    one_shot_digest(expected);
+    dfu_hash_finish(&hash, &ctx);
+    TEST_ASSERT_EQUAL(IMAGE_LENGTH, hash.offset);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, digest, false));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, digest, DIGEST_LENGTH);
+}
+
+void test_shuffled_segments(void)
+{
+    uint8_t expected[DIGEST_LENGTH];
+    one_shot_digest(expected);
+
+    /* From fully shuffled to mostly in order with short local reordering */
+    static const uint32_t windows[] = {SEGMENT_COUNT, 64, 8, 1};
+    for (uint32_t w = 0; w < sizeof(windows) / sizeof(windows[0]); ++w)
+    {
+        setUp();
+
+        uint16_t order[SEGMENT_COUNT];
+        for (uint32_t i = 0; i < SEGMENT_COUNT; ++i)
+        {
+            order[i] = (uint16_t) (i + 1);
+        }
+        for (uint32_t i = 0; i < SEGMENT_COUNT; ++i)
+        {
+            uint32_t span = windows[w];
+            if (span > SEGMENT_COUNT - i)
+            {
+                span = SEGMENT_COUNT - i;
+            }
+            uint32_t j = i + rand_get() % span;
+            uint16_t temp = order[i];
+            order[i] = order[j];
+            order[j] = temp;
+        }
+
+        dfu_missing_t missing;
+        dfu_hash_t hash;
+        sha256_context_t ctx;
+        dfu_missing_init(&missing, SEGMENT_COUNT);
+        header_hash(&ctx);
+        dfu_hash_start(&hash, &ctx, m_bank, IMAGE_LENGTH);
+
+        /* Segments dropped for lack of runs come around again, as they would after a request. */
+        uint32_t remaining = SEGMENT_COUNT;
+        while (remaining > 0)
+        {
+            uint32_t dropped = 0;
+            for (uint32_t i = 0; i < remaining; ++i)
+            {
+                uint32_t status = segment_rx(&missing, &hash, order[i]);
+                if (status == NRF_ERROR_NO_MEM)
+                {
+                    order[dropped++] = order[i];
+                }
+                else
+                {
+                    TEST_ASSERT_EQUAL(NRF_SUCCESS, status);
+                }
+            }
+            remaining = dropped;
+        }
+        TEST_ASSERT_EQUAL(0, dfu_missing_count_get(&missing));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(m_image, m_bank, IMAGE_LENGTH);
+
+        if (windows[w] == 1)
+        {
+            /* In order, only the final segment is left to hash at the end. */
+            TEST_ASSERT_TRUE(IMAGE_LENGTH - hash.offset <= SEGMENT_LENGTH);
+        }
+
+        uint8_t digest[DIGEST_LENGTH];
+        dfu_hash_finish(&hash, &ctx);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, digest, false));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, digest, DIGEST_LENGTH);
+    }
+}
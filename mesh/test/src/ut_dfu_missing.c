@@ -0,0 +1,536 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dfu_missing.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+
+/* Host simulation of a DFU transfer over a chain of nodes, see test_transfer_simulation(). */
+#define SIM_SEGMENTS            (2048)
+#define SIM_NODES_MAX           (8)
+#define SIM_QUEUE_SIZE          (64)    /**< Packets beyond this are dropped, as on a saturated radio. */
+#define SIM_TX_REPEATS          (3)     /**< Same as TX_REPEATS_DATA and TX_REPEATS_RSP. */
+#define SIM_DATA_INTERVAL       (6)     /**< Slots between new segments from the source. */
+#define SIM_REQ_INTERVAL        (16)    /**< Slots between request transmissions. */
+#define SIM_SUPPRESS_SLOTS      (64)    /**< Stands in for the request and packet caches. */
+#define SIM_REQ_RANGES_MAX      (5)     /**< Same as DFU_PACKET_REQ_RANGES_MAX. */
+#define SIM_RSP_COUNT_MAX       (4)     /**< Same as DATA_REQ_RSP_COUNT_MAX. */
+#define SIM_STALL_SLOTS         (512)   /**< Slots without new data before a target asks for the tail. */
+#define SIM_SLOTS_MAX           (2000000)
+#define SIM_SLOT_NEVER          (UINT32_MAX)
+
+typedef enum
+{
+    SIM_PACKET_DATA,
+    SIM_PACKET_REQ
+} sim_packet_type_t;
+
+typedef struct
+{
+    sim_packet_type_t type;
+    uint16_t segment;
+    uint8_t range_count;
+    dfu_missing_run_t ranges[SIM_REQ_RANGES_MAX];
+} sim_packet_t;
+
+typedef struct
+{
+    bool is_target;
+    bool has_image;
+    dfu_missing_t missing;
+    uint16_t rx_max;
+    uint32_t rx_slot;
+    uint32_t done_slot;
+    uint32_t served_slot[SIM_SEGMENTS + 1];
+    uint32_t forwarded_slot[SIM_SEGMENTS + 1];
+    uint32_t req_forwarded_slot[SIM_SEGMENTS + 1];
+    sim_packet_t queue[SIM_QUEUE_SIZE];
+    uint32_t queue_head;
+    uint32_t queue_count;
+} sim_node_t;
+
+typedef struct
+{
+    const char * p_name;
+    uint32_t node_count;            /**< Including the source. */
+    uint32_t loss_percent;          /**< Loss on every link. */
+    bool is_batched;                /**< Range requests instead of single segment requests. */
+    bool relays_are_targets;        /**< Intermediate nodes are targets, or relays only. */
+    bool relays_have_image;         /**< Relays have a finished copy of the image in their bank. */
+} sim_scenario_t;
+
+typedef struct
+{
+    uint32_t node;
+    sim_packet_t packet;
+} sim_delivery_t;
+
+static sim_node_t m_nodes[SIM_NODES_MAX];
+static sim_delivery_t m_inbox[SIM_NODES_MAX * 4];
+static uint32_t m_inbox_count;
+static uint32_t m_rand_state;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Simulation
+*****************************************************************************/
+
+static uint32_t sim_rand(void)
+{
+    /* Fixed LCG, so the results are the same on every host. */
+    m_rand_state = m_rand_state * 1103515245u + 12345u;
+    return (m_rand_state >> 16) & 0x7FFF;
+}
+
+static void sim_enqueue(sim_node_t * p_node, const sim_packet_t * p_packet, uint32_t repeats)
+{
+    for (uint32_t i = 0; i < repeats && p_node->queue_count < SIM_QUEUE_SIZE; ++i)
+    {
+        p_node->queue[(p_node->queue_head + p_node->queue_count++) % SIM_QUEUE_SIZE] = *p_packet;
+    }
+}
+
+static void sim_broadcast(const sim_scenario_t * p_scenario, uint32_t from, const sim_packet_t * p_packet)
+{
+    for (int32_t offset = -1; offset <= 1; offset += 2)
+    {
+        int32_t to = (int32_t) from + offset;
+        if (to < 0 || to >= (int32_t) p_scenario->node_count)
+        {
+            continue;
+        }
+        if ((sim_rand() % 100) >= p_scenario->loss_percent)
+        {
+            TEST_ASSERT_TRUE(m_inbox_count < sizeof(m_inbox) / sizeof(m_inbox[0]));
+            m_inbox[m_inbox_count].node = (uint32_t) to;
+            m_inbox[m_inbox_count].packet = *p_packet;
+            m_inbox_count++;
+        }
+    }
+}
+
+static bool sim_node_has_segment(const sim_node_t * p_node, uint16_t segment)
+{
+    return p_node->has_image ||
+           (p_node->is_target && !dfu_missing_is_missing(&p_node->missing, segment));
+}
+
+static bool sim_slot_recent(uint32_t slot, uint32_t now)
+{
+    return (slot != SIM_SLOT_NEVER && now - slot < SIM_SUPPRESS_SLOTS);
+}
+
+static void sim_data_rx(const sim_scenario_t * p_scenario, uint32_t index, const sim_packet_t * p_packet, uint32_t now)
+{
+    sim_node_t * p_node = &m_nodes[index];
+    bool is_last = (index == p_scenario->node_count - 1);
+
+    if (p_node->is_target)
+    {
+        uint32_t status = dfu_missing_segment_rx(&p_node->missing, p_packet->segment);
+        if ((status == NRF_SUCCESS || status == NRF_ERROR_NO_MEM) && p_packet->segment > p_node->rx_max)
+        {
+            p_node->rx_max = p_packet->segment;
+        }
+        if (status == NRF_SUCCESS)
+        {
+            p_node->rx_slot = now;
+        }
+        if (status == NRF_SUCCESS && !is_last)
+        {
+            sim_enqueue(p_node, p_packet, SIM_TX_REPEATS);
+        }
+    }
+    else if (index != 0 && !sim_slot_recent(p_node->forwarded_slot[p_packet->segment], now))
+    {
+        p_node->forwarded_slot[p_packet->segment] = now;
+        sim_enqueue(p_node, p_packet, SIM_TX_REPEATS);
+    }
+}
+
+static void sim_req_rx(const sim_scenario_t * p_scenario, uint32_t index, const sim_packet_t * p_packet, uint32_t now)
+{
+    sim_node_t * p_node = &m_nodes[index];
+    uint32_t rsp_count_max = p_scenario->is_batched ? SIM_RSP_COUNT_MAX : 1;
+    uint32_t served = 0;
+    bool is_missing = false;
+
+    for (uint32_t i = 0; i < p_packet->range_count && served < rsp_count_max; ++i)
+    {
+        for (uint32_t j = 0; j < p_packet->ranges[i].count && served < rsp_count_max; ++j)
+        {
+            uint16_t segment = p_packet->ranges[i].segment + j;
+            if (!sim_node_has_segment(p_node, segment))
+            {
+                is_missing = true;
+            }
+            else if (!sim_slot_recent(p_node->served_slot[segment], now))
+            {
+                p_node->served_slot[segment] = now;
+                sim_packet_t rsp = {.type = SIM_PACKET_DATA, .segment = segment};
+                sim_enqueue(p_node, &rsp, SIM_TX_REPEATS);
+                served++;
+            }
+        }
+    }
+
+    /* Only relays pass requests on. */
+    if (index != 0 && !p_node->is_target && (is_missing || served == rsp_count_max) &&
+        !sim_slot_recent(p_node->req_forwarded_slot[p_packet->segment], now))
+    {
+        p_node->req_forwarded_slot[p_packet->segment] = now;
+        sim_enqueue(p_node, p_packet, 1);
+    }
+}
+
+static void sim_req_tx(const sim_scenario_t * p_scenario, uint32_t index, uint32_t now)
+{
+    sim_node_t * p_node = &m_nodes[index];
+
+    /* Same limit as request_missing_data(). A real target that lost the final segments only
+     * recovers through the state timeout, the simulation lets it ask for the tail instead. */
+    uint16_t segment_limit = p_node->rx_max;
+    if (now - p_node->rx_slot > SIM_STALL_SLOTS)
+    {
+        segment_limit = SIM_SEGMENTS;
+    }
+    else if (segment_limit != SIM_SEGMENTS)
+    {
+        if (segment_limit < 3)
+        {
+            return;
+        }
+        segment_limit -= 2;
+    }
+
+    sim_packet_t req = {.type = SIM_PACKET_REQ};
+    req.range_count = dfu_missing_ranges_get(&p_node->missing,
+                                             segment_limit,
+                                             p_scenario->is_batched ? UINT8_MAX : 1,
+                                             req.ranges,
+                                             p_scenario->is_batched ? SIM_REQ_RANGES_MAX : 1);
+    if (req.range_count > 0)
+    {
+        req.segment = req.ranges[0].segment;
+        /* Requests go out on the beacon slot, next to the data slots. */
+        sim_broadcast(p_scenario, index, &req);
+    }
+}
+
+/** Runs the scenario, and returns the number of slots until all targets had the full image. */
+static uint32_t sim_run(const sim_scenario_t * p_scenario)
+{
+    TEST_ASSERT_TRUE(p_scenario->node_count <= SIM_NODES_MAX);
+    memset(m_nodes, 0, sizeof(m_nodes));
+    m_rand_state = 0x5EED;
+
+    for (uint32_t i = 0; i < p_scenario->node_count; ++i)
+    {
+        sim_node_t * p_node = &m_nodes[i];
+        bool is_last = (i == p_scenario->node_count - 1);
+        p_node->is_target = (i != 0) && (is_last || p_scenario->relays_are_targets);
+        p_node->has_image = (i == 0) || (!p_node->is_target && p_scenario->relays_have_image);
+        p_node->done_slot = SIM_SLOT_NEVER;
+        dfu_missing_init(&p_node->missing, SIM_SEGMENTS);
+        memset(p_node->served_slot, 0xFF, sizeof(p_node->served_slot));
+        memset(p_node->forwarded_slot, 0xFF, sizeof(p_node->forwarded_slot));
+        memset(p_node->req_forwarded_slot, 0xFF, sizeof(p_node->req_forwarded_slot));
+    }
+
+    uint16_t next_segment = 1;
+    for (uint32_t slot = 0; slot < SIM_SLOTS_MAX; ++slot)
+    {
+        /* The source leaves some airtime for repairs between the segments. */
+        if ((slot % SIM_DATA_INTERVAL) == 0 && next_segment <= SIM_SEGMENTS)
+        {
+            sim_packet_t data = {.type = SIM_PACKET_DATA, .segment = next_segment++};
+            sim_enqueue(&m_nodes[0], &data, SIM_TX_REPEATS);
+        }
+
+        m_inbox_count = 0;
+        for (uint32_t i = 0; i < p_scenario->node_count; ++i)
+        {
+            sim_node_t * p_node = &m_nodes[i];
+            if (p_node->queue_count > 0)
+            {
+                sim_packet_t packet = p_node->queue[p_node->queue_head];
+                p_node->queue_head = (p_node->queue_head + 1) % SIM_QUEUE_SIZE;
+                p_node->queue_count--;
+                sim_broadcast(p_scenario, i, &packet);
+            }
+            if (p_node->is_target && (slot % SIM_REQ_INTERVAL) == (i % SIM_REQ_INTERVAL))
+            {
+                sim_req_tx(p_scenario, i, slot);
+            }
+        }
+
+        for (uint32_t i = 0; i < m_inbox_count; ++i)
+        {
+            if (m_inbox[i].packet.type == SIM_PACKET_DATA)
+            {
+                sim_data_rx(p_scenario, m_inbox[i].node, &m_inbox[i].packet, slot);
+            }
+            else
+            {
+                sim_req_rx(p_scenario, m_inbox[i].node, &m_inbox[i].packet, slot);
+            }
+        }
+
+        bool is_done = true;
+        for (uint32_t i = 0; i < p_scenario->node_count; ++i)
+        {
+            sim_node_t * p_node = &m_nodes[i];
+            if (p_node->is_target && p_node->done_slot == SIM_SLOT_NEVER)
+            {
+                if (dfu_missing_count_get(&p_node->missing) == 0)
+                {
+                    p_node->done_slot = slot;
+                }
+                else
+                {
+                    is_done = false;
+                }
+            }
+        }
+        if (is_done)
+        {
+            return slot + 1;
+        }
+    }
+    return SIM_SLOT_NEVER;
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_in_order(void)
+{
+    dfu_missing_t missing;
+    dfu_missing_init(&missing, 100);
+    TEST_ASSERT_EQUAL(100, dfu_missing_count_get(&missing));
+    TEST_ASSERT_FALSE(dfu_missing_is_missing(&missing, 0));
+    TEST_ASSERT_FALSE(dfu_missing_is_missing(&missing, 101));
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, dfu_missing_segment_rx(&missing, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, dfu_missing_segment_rx(&missing, 101));
+
+    for (uint16_t segment = 1; segment <= 100; ++segment)
+    {
+        TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, segment));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, segment));
+        TEST_ASSERT_FALSE(dfu_missing_is_missing(&missing, segment));
+        TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, dfu_missing_segment_rx(&missing, segment));
+        TEST_ASSERT_EQUAL(100 - segment, dfu_missing_count_get(&missing));
+        TEST_ASSERT_EQUAL(segment, dfu_missing_prefix_get(&missing));
+    }
+    /* In-order reception never takes up a run. */
+    TEST_ASSERT_EQUAL(0, missing.run_count);
+}
+
+void test_gaps(void)
+{
+    dfu_missing_t missing;
+    dfu_missing_init(&missing, 1000);
+
+    /* Lose 2-4 and 10-19 */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 1));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 5));
+    for (uint16_t segment = 6; segment < 10; ++segment)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, segment));
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 20));
+    TEST_ASSERT_EQUAL(2, missing.run_count);
+    TEST_ASSERT_EQUAL(1000 - 20 + 3 + 10, dfu_missing_count_get(&missing));
+    TEST_ASSERT_EQUAL(1, dfu_missing_prefix_get(&missing));
+
+    /* Far behind the newest segment, the gaps are still tracked. */
+    for (uint16_t segment = 21; segment <= 900; ++segment)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, segment));
+    }
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 2));
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 4));
+    TEST_ASSERT_FALSE(dfu_missing_is_missing(&missing, 5));
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 10));
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 19));
+    TEST_ASSERT_FALSE(dfu_missing_is_missing(&missing, 20));
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 901));
+
+    /* Edges shrink the run, the middle splits it. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 2));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 19));
+    TEST_ASSERT_EQUAL(2, missing.run_count);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 15));
+    TEST_ASSERT_EQUAL(3, missing.run_count);
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 14));
+    TEST_ASSERT_FALSE(dfu_missing_is_missing(&missing, 15));
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 16));
+
+    /* Filling a run removes it. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 3));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 4));
+    TEST_ASSERT_EQUAL(2, missing.run_count);
+    TEST_ASSERT_EQUAL(9, dfu_missing_prefix_get(&missing));
+    TEST_ASSERT_EQUAL(10, missing.runs[0].segment);
+    TEST_ASSERT_EQUAL(5, missing.runs[0].count);
+    TEST_ASSERT_EQUAL(16, missing.runs[1].segment);
+    TEST_ASSERT_EQUAL(3, missing.runs[1].count);
+    TEST_ASSERT_EQUAL(100 + 5 + 3, dfu_missing_count_get(&missing));
+}
+
+void test_runs_full(void)
+{
+    dfu_missing_t missing;
+    dfu_missing_init(&missing, 1000);
+
+    /* Lose every other segment, until all runs are in use. */
+    uint16_t segment = 2;
+    for (uint32_t i = 0; i < DFU_MISSING_RUNS_MAX; ++i, segment += 2)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, segment));
+    }
+    TEST_ASSERT_EQUAL(DFU_MISSING_RUNS_MAX, missing.run_count);
+
+    /* New gaps can't be tracked, so the segment is dropped. */
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, dfu_missing_segment_rx(&missing, segment));
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, segment));
+    /* Continuing in order is fine. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, segment - 1));
+
+    /* Splitting is refused as well, but shrinking is fine. */
+    dfu_missing_init(&missing, 1000);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 10));
+    segment = 12;
+    for (uint32_t i = 1; i < DFU_MISSING_RUNS_MAX; ++i, segment += 2)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, segment));
+    }
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, dfu_missing_segment_rx(&missing, 5));
+    TEST_ASSERT_TRUE(dfu_missing_is_missing(&missing, 5));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 1));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 9));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 11));
+    TEST_ASSERT_EQUAL(DFU_MISSING_RUNS_MAX - 1, missing.run_count);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 5));
+}
+
+void test_ranges_get(void)
+{
+    dfu_missing_t missing;
+    dfu_missing_run_t ranges[4];
+    dfu_missing_init(&missing, 1000);
+
+    TEST_ASSERT_EQUAL(0, dfu_missing_ranges_get(&missing, 0, UINT8_MAX, ranges, 4));
+    /* Segments after the newest received one are reported up to the limit. */
+    TEST_ASSERT_EQUAL(1, dfu_missing_ranges_get(&missing, 3, UINT8_MAX, ranges, 4));
+    TEST_ASSERT_EQUAL(1, ranges[0].segment);
+    TEST_ASSERT_EQUAL(3, ranges[0].count);
+
+    /* Missing: 1, 3-302, 304-310, 312 and up */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 2));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 303));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, dfu_missing_segment_rx(&missing, 311));
+
+    TEST_ASSERT_EQUAL(3, dfu_missing_ranges_get(&missing, 309, UINT8_MAX, ranges, 4));
+    TEST_ASSERT_EQUAL(1, ranges[0].segment);
+    TEST_ASSERT_EQUAL(1, ranges[0].count);
+    TEST_ASSERT_EQUAL(3, ranges[1].segment);
+    TEST_ASSERT_EQUAL(UINT8_MAX, ranges[1].count);
+    TEST_ASSERT_EQUAL(304, ranges[2].segment);
+    TEST_ASSERT_EQUAL(6, ranges[2].count);
+
+    TEST_ASSERT_EQUAL(4, dfu_missing_ranges_get(&missing, 2000, UINT8_MAX, ranges, 4));
+    TEST_ASSERT_EQUAL(304, ranges[2].segment);
+    TEST_ASSERT_EQUAL(7, ranges[2].count);
+    TEST_ASSERT_EQUAL(312, ranges[3].segment);
+    TEST_ASSERT_EQUAL(UINT8_MAX, ranges[3].count);
+
+    /* Single segment requests */
+    TEST_ASSERT_EQUAL(2, dfu_missing_ranges_get(&missing, 2000, 1, ranges, 2));
+    TEST_ASSERT_EQUAL(1, ranges[0].segment);
+    TEST_ASSERT_EQUAL(1, ranges[0].count);
+    TEST_ASSERT_EQUAL(3, ranges[1].segment);
+    TEST_ASSERT_EQUAL(1, ranges[1].count);
+}
+
+void test_transfer_simulation(void)
+{
+    static const sim_scenario_t scenarios[] =
+    {
+        {"single, 4 hops, 10% loss",        5, 10, false, true,  false},
+        {"ranges, 4 hops, 10% loss",        5, 10, true,  true,  false},
+        {"single, 4 hops, 30% loss",        5, 30, false, true,  false},
+        {"ranges, 4 hops, 30% loss",        5, 30, true,  true,  false},
+        {"single, 6 relays, 20% loss",      8, 20, false, false, false},
+        {"ranges, 6 relays, 20% loss",      8, 20, true,  false, false},
+        {"ranges, 6 relays w/bank, 20%",    8, 20, true,  false, true},
+    };
+    uint32_t slots[sizeof(scenarios) / sizeof(scenarios[0])];
+
+    printf("dfu_missing: %u segments, slots until all targets are done:\n", SIM_SEGMENTS);
+    for (uint32_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); ++i)
+    {
+        slots[i] = sim_run(&scenarios[i]);
+        TEST_ASSERT_TRUE_MESSAGE(slots[i] != SIM_SLOT_NEVER, scenarios[i].p_name);
+        printf("dfu_missing: %-32s %8u\n", scenarios[i].p_name, slots[i]);
+    }
+
+    /* When every hop is a target, repairs come from the neighbours and keep up with the source. */
+    TEST_ASSERT_TRUE(slots[1] <= slots[0]);
+    TEST_ASSERT_TRUE(slots[3] <= slots[2]);
+    /* Through relays, every request is a round trip to the source, so batching pays off. */
+    TEST_ASSERT_TRUE(slots[5] < slots[4]);
+    /* Relays serving from their bank cut the round trips to the source. */
+    TEST_ASSERT_TRUE(slots[6] <= slots[5]);
+}
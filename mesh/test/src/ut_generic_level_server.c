@@ -39,6 +39,7 @@
 #include "generic_level_messages.h"
 
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #include <unity.h>
@@ -140,7 +141,8 @@ static uint32_t access_model_add_mock(const access_model_add_params_t * p_init_p
     do { \
         TEST_ASSERT_FALSE(m_publish_expected); \
         m_publish_expected = true; \
-        access_model_publish_StubWithCallback(access_model_publish_mock);\
+        access_model_publish_reserve_StubWithCallback(access_model_publish_reserve_mock); \
+        access_model_tx_commit_StubWithCallback(access_model_tx_commit_mock); \
         m_publish_expected_handle = x_handle; \
         m_publish_expected_opcode = GENERIC_LEVEL_OPCODE_STATUS; \
         static generic_level_status_msg_pkt_t expected_data; \
@@ -194,7 +196,8 @@ static uint32_t access_model_publish_mock(access_model_handle_t handle, const ac
         expected_data.remaining_time = model_transition_time_encode(x_expected_data.remaining_time_ms);\
         mp_reply_expected_data = (void *) &expected_data; \
         m_reply_expected_data_length = x_expected_data_length; \
-        access_model_reply_StubWithCallback(access_model_reply_mock); \
+        access_model_reply_reserve_StubWithCallback(access_model_reply_reserve_mock); \
+        access_model_tx_commit_StubWithCallback(access_model_tx_commit_mock); \
     } while(0)
 
 static bool m_reply_expected;
@@ -221,6 +224,48 @@ static uint32_t access_model_reply_mock(access_model_handle_t handle, const acce
     return NRF_SUCCESS;
 }
 
+/* Status messages are serialized in place: the reserve stubs hand out a local buffer, and the
+ * commit stub checks it with the publish/reply mocks above. */
+static uint8_t m_reserved_params[ACCESS_MESSAGE_LENGTH_MAX];
+static access_message_tx_t m_reserved_message;
+static const access_message_rx_t * mp_reserved_rx_message;
+
+static uint32_t access_model_publish_reserve_mock(access_model_handle_t handle, const access_message_tx_t * p_message,
+        uint8_t ** pp_params, int count)
+{
+    TEST_ASSERT_NOT_NULL(p_message);
+    TEST_ASSERT_NOT_NULL(pp_params);
+
+    m_reserved_message = *p_message;
+    m_reserved_message.p_buffer = m_reserved_params;
+    mp_reserved_rx_message = NULL;
+    *pp_params = m_reserved_params;
+    return NRF_SUCCESS;
+}
+
+static uint32_t access_model_reply_reserve_mock(access_model_handle_t handle, const access_message_rx_t * p_message,
+        const access_message_tx_t * p_reply, uint8_t ** pp_params, int count)
+{
+    TEST_ASSERT_NOT_NULL(p_message);
+    TEST_ASSERT_NOT_NULL(pp_params);
+
+    (void) access_model_publish_reserve_mock(handle, p_reply, pp_params, count);
+    mp_reserved_rx_message = p_message;
+    return NRF_SUCCESS;
+}
+
+static uint32_t access_model_tx_commit_mock(access_model_handle_t handle, int count)
+{
+    if (mp_reserved_rx_message == NULL)
+    {
+        return access_model_publish_mock(handle, &m_reserved_message, count);
+    }
+    else
+    {
+        return access_model_reply_mock(handle, mp_reserved_rx_message, &m_reserved_message, count);
+    }
+}
+
 /***** Helper functions *****/
 static void helper_call_opcode_handler(access_model_handle_t handle, const access_message_rx_t * p_message, void * p_args)
 {
@@ -392,6 +437,203 @@ static void level_server_get_cb(const generic_level_server_t * p_self,
     *p_out = m_test_status;
 }
 
+/******** Dimmer stream simulation ********/
+/* The scheduler stubs run the model timers on a simulated clock, and the application callbacks
+ * apply the level changes like the level behaviour module does: a delta of a new transaction is
+ * applied to the present level, a delta of the same transaction to the initial level of it. */
+#define SIM_TIMERS_MAX        (4)
+
+static timestamp_t m_sim_now;
+static timer_event_t * mp_sim_timers[SIM_TIMERS_MAX];
+
+static struct
+{
+    int32_t level;
+    int32_t initial_level;
+    uint32_t state_writes;
+    uint32_t publications;
+    uint32_t replies;
+    int16_t published_level;
+} m_sim;
+
+static timestamp_t sim_timer_now_stub(int count)
+{
+    return m_sim_now;
+}
+
+static void sim_timer_sch_reschedule_stub(timer_event_t * p_timer_evt, timestamp_t new_timeout, int count)
+{
+    uint32_t free_index = SIM_TIMERS_MAX;
+    for (uint32_t i = 0; i < SIM_TIMERS_MAX; i++)
+    {
+        if (mp_sim_timers[i] == p_timer_evt)
+        {
+            free_index = i;
+            break;
+        }
+        if (mp_sim_timers[i] == NULL && free_index == SIM_TIMERS_MAX)
+        {
+            free_index = i;
+        }
+    }
+    TEST_ASSERT_TRUE(free_index < SIM_TIMERS_MAX);
+
+    mp_sim_timers[free_index] = p_timer_evt;
+    p_timer_evt->timestamp = new_timeout;
+    p_timer_evt->state = TIMER_EVENT_STATE_ADDED;
+}
+
+static void sim_timer_sch_abort_stub(timer_event_t * p_timer_evt, int count)
+{
+    p_timer_evt->state = TIMER_EVENT_STATE_UNUSED;
+}
+
+static bool sim_timer_sch_is_scheduled_stub(const timer_event_t * p_timer_evt, int count)
+{
+    return p_timer_evt->state != TIMER_EVENT_STATE_UNUSED;
+}
+
+static uint32_t sim_tx_commit_stub(access_model_handle_t handle, int count)
+{
+    TEST_ASSERT_EQUAL(GENERIC_LEVEL_OPCODE_STATUS, m_reserved_message.opcode.opcode);
+
+    if (mp_reserved_rx_message == NULL)
+    {
+        m_sim.publications++;
+        m_sim.published_level = ((const generic_level_status_msg_pkt_t *) m_reserved_params)->present_level;
+    }
+    else
+    {
+        m_sim.replies++;
+    }
+    return NRF_SUCCESS;
+}
+
+static void sim_level_publish(const generic_level_server_t * p_self, generic_level_status_params_t * p_out)
+{
+    generic_level_status_params_t status = {0};
+    status.present_level = (int16_t) m_sim.level;
+    status.target_level = (int16_t) m_sim.level;
+
+    /* Acknowledged messages are answered with a reply instead. */
+    if (p_out != NULL)
+    {
+        *p_out = status;
+    }
+    else
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, generic_level_server_status_publish((generic_level_server_t *) p_self, &status));
+    }
+}
+
+static void sim_delta_set_cb(const generic_level_server_t * p_self,
+                             const access_message_rx_meta_t * p_meta,
+                             const generic_level_delta_set_params_t * p_in,
+                             const model_transition_t * p_in_transition,
+                             generic_level_status_params_t * p_out)
+{
+    TEST_ASSERT_NOT_NULL(p_meta);
+
+    if (model_transaction_is_new((tid_tracker_t *) &p_self->tid_tracker))
+    {
+        m_sim.initial_level = m_sim.level;
+    }
+    m_sim.level = m_sim.initial_level + p_in->delta_level;
+    m_sim.state_writes++;
+    sim_level_publish(p_self, p_out);
+}
+
+static void sim_move_set_cb(const generic_level_server_t * p_self,
+                            const access_message_rx_meta_t * p_meta,
+                            const generic_level_move_set_params_t * p_in,
+                            const model_transition_t * p_in_transition,
+                            generic_level_status_params_t * p_out)
+{
+    TEST_ASSERT_NOT_NULL(p_meta);
+
+    m_sim.level += p_in->move_level;
+    m_sim.state_writes++;
+    sim_level_publish(p_self, p_out);
+}
+
+static void sim_run_until(timestamp_t end)
+{
+    for (timestamp_t now = m_sim_now; TIMER_OLDER_THAN(now, end + 1); now += MS_TO_US(1))
+    {
+        m_sim_now = now;
+        for (uint32_t i = 0; i < SIM_TIMERS_MAX; i++)
+        {
+            timer_event_t * p_evt = mp_sim_timers[i];
+            if (p_evt != NULL && p_evt->state == TIMER_EVENT_STATE_ADDED && !TIMER_OLDER_THAN(now, p_evt->timestamp))
+            {
+                p_evt->state = TIMER_EVENT_STATE_IN_CALLBACK;
+                p_evt->cb(now, p_evt->p_context);
+                if (p_evt->state == TIMER_EVENT_STATE_IN_CALLBACK)
+                {
+                    p_evt->state = TIMER_EVENT_STATE_UNUSED;
+                }
+            }
+        }
+    }
+}
+
+static void sim_init(uint32_t coalesce_interval_ms, uint32_t publish_interval_min_ms)
+{
+    memset(&m_sim, 0, sizeof(m_sim));
+    memset(mp_sim_timers, 0, sizeof(mp_sim_timers));
+    memset(&m_server, 0, sizeof(m_server));
+    m_sim_now = 0;
+
+    helper_init_model_context_and_expectations();
+    m_server_cbs.level_cbs.delta_set_cb = sim_delta_set_cb;
+    m_server_cbs.level_cbs.move_set_cb = sim_move_set_cb;
+    m_server.settings.coalesce_interval_ms = coalesce_interval_ms;
+    m_server.settings.publish_interval_min_ms = publish_interval_min_ms;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, generic_level_server_init(&m_server, TEST_ELEMENT_INDEX));
+
+    timer_now_StubWithCallback(sim_timer_now_stub);
+    timer_sch_reschedule_StubWithCallback(sim_timer_sch_reschedule_stub);
+    timer_sch_abort_StubWithCallback(sim_timer_sch_abort_stub);
+    timer_sch_is_scheduled_StubWithCallback(sim_timer_sch_is_scheduled_stub);
+    access_model_publish_reserve_StubWithCallback(access_model_publish_reserve_mock);
+    access_model_reply_reserve_StubWithCallback(access_model_reply_reserve_mock);
+    access_model_tx_commit_StubWithCallback(sim_tx_commit_stub);
+}
+
+/* Replays a dimmer turned for five seconds: an unacknowledged Delta Set every 20 ms, with a new
+ * transaction every 25 messages, each message carrying the cumulative delta of its transaction.
+ * Returns the expected final level. */
+static int32_t sim_dimmer_stream_replay(uint32_t * p_messages)
+{
+    const uint32_t messages = 250;
+    const uint32_t transaction_length = 25;
+    const int32_t step = 64;
+    access_message_rx_t request_msg;
+    generic_level_delta_set_msg_pkt_t pkt;
+    int32_t expected_level = 0;
+
+    for (uint32_t i = 0; i < messages; i++)
+    {
+        sim_run_until(MS_TO_US(20) * i);
+
+        pkt.tid = (uint8_t)(i / transaction_length);
+        pkt.delta_level = step * (int32_t)(i % transaction_length + 1);
+        ACCESS_MESSAGE_RX(request_msg, pkt, GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED, GENERIC_LEVEL_DELTA_SET_MINLEN);
+        helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+
+        if (i % transaction_length == transaction_length - 1)
+        {
+            expected_level += pkt.delta_level;
+        }
+    }
+
+    /* Let the held back message and publication through. */
+    sim_run_until(m_sim_now + MS_TO_US(1000));
+
+    *p_messages = messages;
+    return expected_level;
+}
+
 /******** Setup and Tear Down ********/
 void setUp(void)
 {
@@ -1110,3 +1352,140 @@ void test_handle_get(void)
 
     helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
 }
+
+void test_status_publish_rate_limit(void)
+{
+    sim_init(0, 250);
+    generic_level_status_params_t status = {0};
+
+    /* The first publication goes out immediately. */
+    status.present_level = 1;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, generic_level_server_status_publish(&m_server, &status));
+    TEST_ASSERT_EQUAL(1, m_sim.publications);
+
+    /* Publications within the interval are held back, and the last one is sent when it is due. */
+    sim_run_until(MS_TO_US(100));
+    status.present_level = 2;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, generic_level_server_status_publish(&m_server, &status));
+    status.present_level = 3;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, generic_level_server_status_publish(&m_server, &status));
+    TEST_ASSERT_EQUAL(1, m_sim.publications);
+
+    sim_run_until(MS_TO_US(249));
+    TEST_ASSERT_EQUAL(1, m_sim.publications);
+    sim_run_until(MS_TO_US(250));
+    TEST_ASSERT_EQUAL(2, m_sim.publications);
+    TEST_ASSERT_EQUAL(3, m_sim.published_level);
+
+    /* Nothing is held back, so nothing is sent at the end of the next interval. */
+    sim_run_until(MS_TO_US(1000));
+    TEST_ASSERT_EQUAL(2, m_sim.publications);
+
+    /* After a quiet interval, the publication goes out immediately again. */
+    status.present_level = 4;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, generic_level_server_status_publish(&m_server, &status));
+    TEST_ASSERT_EQUAL(3, m_sim.publications);
+    TEST_ASSERT_EQUAL(4, m_sim.published_level);
+}
+
+void test_delta_set_coalescing(void)
+{
+    access_message_rx_t request_msg;
+    generic_level_delta_set_msg_pkt_t pkt;
+    generic_level_move_set_msg_pkt_t move_pkt;
+
+    sim_init(100, 0);
+
+    /* The first message of a stream is passed on immediately. */
+    pkt.tid = 1;
+    pkt.delta_level = 100;
+    ACCESS_MESSAGE_RX(request_msg, pkt, GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED, GENERIC_LEVEL_DELTA_SET_MINLEN);
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    TEST_ASSERT_EQUAL(1, m_sim.state_writes);
+    TEST_ASSERT_EQUAL(100, m_sim.level);
+
+    /* Within the window, the same transaction and two new ones are merged into one delta of the
+     * first transaction. */
+    sim_run_until(MS_TO_US(20));
+    pkt.delta_level = 200;
+    ACCESS_MESSAGE_RX(request_msg, pkt, GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED, GENERIC_LEVEL_DELTA_SET_MINLEN);
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    pkt.tid = 2;
+    pkt.delta_level = -50;
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    pkt.tid = 3;
+    pkt.delta_level = 10;
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    pkt.delta_level = 30;
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    TEST_ASSERT_EQUAL(1, m_sim.state_writes);
+
+    sim_run_until(MS_TO_US(100));
+    TEST_ASSERT_EQUAL(2, m_sim.state_writes);
+    TEST_ASSERT_EQUAL(200 - 50 + 30, m_sim.level);
+
+    /* The window ends without a held back message, the next transaction starts from the present
+     * level. */
+    sim_run_until(MS_TO_US(300));
+    pkt.tid = 4;
+    pkt.delta_level = 5;
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    TEST_ASSERT_EQUAL(3, m_sim.state_writes);
+    TEST_ASSERT_EQUAL(185, m_sim.level);
+
+    /* A Move Set replaces the held back delta only after passing it on. */
+    pkt.delta_level = 15;
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    move_pkt.tid = 5;
+    move_pkt.move_level = 1000;
+    ACCESS_MESSAGE_RX(request_msg, move_pkt, GENERIC_LEVEL_OPCODE_MOVE_SET_UNACKNOWLEDGED, GENERIC_LEVEL_MOVE_SET_MINLEN);
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    TEST_ASSERT_EQUAL(4, m_sim.state_writes);
+    TEST_ASSERT_EQUAL(195, m_sim.level);
+
+    /* An acknowledged message passes the held back move on before it is handled. */
+    pkt.tid = 6;
+    pkt.delta_level = 1;
+    ACCESS_MESSAGE_RX(request_msg, pkt, GENERIC_LEVEL_OPCODE_DELTA_SET, GENERIC_LEVEL_DELTA_SET_MINLEN);
+    helper_call_opcode_handler(m_server.model_handle, &request_msg, &m_server);
+    TEST_ASSERT_EQUAL(6, m_sim.state_writes);
+    TEST_ASSERT_EQUAL(1196, m_sim.level);
+    TEST_ASSERT_EQUAL(1, m_sim.replies);
+
+    /* Nothing is held back anymore. */
+    sim_run_until(MS_TO_US(1000));
+    TEST_ASSERT_EQUAL(6, m_sim.state_writes);
+}
+
+void test_dimmer_stream_replay(void)
+{
+    uint32_t messages;
+    int32_t expected_level;
+    uint32_t plain_writes;
+    uint32_t plain_publications;
+
+    /* Every message changes the state and publishes it. */
+    sim_init(0, 0);
+    expected_level = sim_dimmer_stream_replay(&messages);
+    TEST_ASSERT_EQUAL(expected_level, m_sim.level);
+    TEST_ASSERT_EQUAL(expected_level, m_sim.published_level);
+    TEST_ASSERT_EQUAL(messages, m_sim.state_writes);
+    TEST_ASSERT_EQUAL(messages, m_sim.publications);
+    plain_writes = m_sim.state_writes;
+    plain_publications = m_sim.publications;
+
+    /* The coalesced stream reaches the same level with a state change per window and a publication
+     * per publish interval. */
+    sim_init(GENERIC_LEVEL_SERVER_COALESCE_INTERVAL_MS, GENERIC_LEVEL_SERVER_PUBLISH_INTERVAL_MIN_MS);
+    expected_level = sim_dimmer_stream_replay(&messages);
+    TEST_ASSERT_EQUAL(expected_level, m_sim.level);
+    TEST_ASSERT_EQUAL(expected_level, m_sim.published_level);
+
+    uint32_t stream_ms = messages * 20;
+    TEST_ASSERT_TRUE(m_sim.state_writes <= stream_ms / GENERIC_LEVEL_SERVER_COALESCE_INTERVAL_MS + 2);
+    TEST_ASSERT_TRUE(m_sim.publications <= stream_ms / GENERIC_LEVEL_SERVER_PUBLISH_INTERVAL_MIN_MS + 2);
+
+    printf("Dimmer stream of %u Delta Set messages at 50 Hz: %u state writes and %u publications, "
+           "coalesced: %u state writes and %u publications\n",
+           messages, plain_writes, plain_publications, m_sim.state_writes, m_sim.publications);
+}
@@ -127,7 +127,8 @@ static uint32_t access_model_add_mock(const access_model_add_params_t * p_init_p
     do { \
         TEST_ASSERT_FALSE(m_publish_expected); \
         m_publish_expected = true; \
-        access_model_publish_StubWithCallback(access_model_publish_mock);\
+        access_model_publish_reserve_StubWithCallback(access_model_publish_reserve_mock); \
+        access_model_tx_commit_StubWithCallback(access_model_tx_commit_mock); \
         m_publish_expected_handle = x_handle; \
         m_publish_expected_opcode = GENERIC_ONOFF_OPCODE_STATUS; \
         static generic_onoff_status_msg_pkt_t expected_data; \
@@ -181,7 +182,8 @@ static uint32_t access_model_publish_mock(access_model_handle_t handle, const ac
         expected_data.remaining_time = model_transition_time_encode(x_expected_data.remaining_time_ms);\
         mp_reply_expected_data = (void *) &expected_data; \
         m_reply_expected_data_length = x_expected_data_length; \
-        access_model_reply_StubWithCallback(access_model_reply_mock); \
+        access_model_reply_reserve_StubWithCallback(access_model_reply_reserve_mock); \
+        access_model_tx_commit_StubWithCallback(access_model_tx_commit_mock); \
     } while(0)
 
 static bool m_reply_expected;
@@ -208,6 +210,48 @@ static uint32_t access_model_reply_mock(access_model_handle_t handle, const acce
     return NRF_SUCCESS;
 }
 
+/* Status messages are serialized in place: the reserve stubs hand out a local buffer, and the
+ * commit stub checks it with the publish/reply mocks above. */
+static uint8_t m_reserved_params[ACCESS_MESSAGE_LENGTH_MAX];
+static access_message_tx_t m_reserved_message;
+static const access_message_rx_t * mp_reserved_rx_message;
+
+static uint32_t access_model_publish_reserve_mock(access_model_handle_t handle, const access_message_tx_t * p_message,
+        uint8_t ** pp_params, int count)
+{
+    TEST_ASSERT_NOT_NULL(p_message);
+    TEST_ASSERT_NOT_NULL(pp_params);
+
+    m_reserved_message = *p_message;
+    m_reserved_message.p_buffer = m_reserved_params;
+    mp_reserved_rx_message = NULL;
+    *pp_params = m_reserved_params;
+    return NRF_SUCCESS;
+}
+
+static uint32_t access_model_reply_reserve_mock(access_model_handle_t handle, const access_message_rx_t * p_message,
+        const access_message_tx_t * p_reply, uint8_t ** pp_params, int count)
+{
+    TEST_ASSERT_NOT_NULL(p_message);
+    TEST_ASSERT_NOT_NULL(pp_params);
+
+    (void) access_model_publish_reserve_mock(handle, p_reply, pp_params, count);
+    mp_reserved_rx_message = p_message;
+    return NRF_SUCCESS;
+}
+
+static uint32_t access_model_tx_commit_mock(access_model_handle_t handle, int count)
+{
+    if (mp_reserved_rx_message == NULL)
+    {
+        return access_model_publish_mock(handle, &m_reserved_message, count);
+    }
+    else
+    {
+        return access_model_reply_mock(handle, mp_reserved_rx_message, &m_reserved_message, count);
+    }
+}
+
 /***** Helper functions *****/
 static void helper_call_opcode_handler(access_model_handle_t handle, const access_message_rx_t * p_message, void * p_args)
 {
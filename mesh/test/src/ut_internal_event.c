@@ -0,0 +1,140 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "internal_event.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "timer_mock.h"
+
+static timestamp_t m_time_now;
+
+static timestamp_t timer_now_cb(int cmock_num_calls)
+{
+    return m_time_now++;
+}
+
+void setUp(void)
+{
+    timer_mock_Init();
+    timer_now_StubWithCallback(timer_now_cb);
+    m_time_now = 1000;
+
+    internal_event_trace_record_t records[INTERNAL_EVENT_BUFFER_SIZE];
+    uint32_t dropped;
+    internal_event_trace_enable(true);
+    (void) internal_event_trace_read(records, INTERNAL_EVENT_BUFFER_SIZE, &dropped);
+}
+
+void tearDown(void)
+{
+    internal_event_trace_enable(false);
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_spans_and_events(void)
+{
+    uint8_t packet[29];
+
+    __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_NET_DECRYPT);
+    __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_NET_DECRYPT, NRF_SUCCESS);
+    __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED, PACKET_DROPPED_REPLAY_CACHE, sizeof(packet), packet);
+    __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_FLASH_OP);
+    __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_FLASH_OP, 2);
+
+    internal_event_trace_record_t records[8];
+    uint32_t dropped;
+    TEST_ASSERT_EQUAL(5, internal_event_trace_read(records, ARRAY_SIZE(records), &dropped));
+    TEST_ASSERT_EQUAL(0, dropped);
+
+    const internal_event_trace_record_t expected[] =
+    {
+        {1000, INTERNAL_EVENT_NET_DECRYPT, INTERNAL_EVENT_TRACE_PHASE_BEGIN, 0, 0},
+        {1001, INTERNAL_EVENT_NET_DECRYPT, INTERNAL_EVENT_TRACE_PHASE_END, NRF_SUCCESS, 0},
+        {1002, INTERNAL_EVENT_PACKET_DROPPED, INTERNAL_EVENT_TRACE_PHASE_INSTANT, PACKET_DROPPED_REPLAY_CACHE, sizeof(packet)},
+        {1003, INTERNAL_EVENT_FLASH_OP, INTERNAL_EVENT_TRACE_PHASE_BEGIN, 0, 0},
+        {1004, INTERNAL_EVENT_FLASH_OP, INTERNAL_EVENT_TRACE_PHASE_END, 2, 0},
+    };
+    TEST_ASSERT_EQUAL_MEMORY(expected, records, sizeof(expected));
+    TEST_ASSERT_EQUAL(1000000, internal_event_trace_timestamp_hz_get());
+}
+
+void test_disabled(void)
+{
+    internal_event_trace_enable(false);
+    __INTERNAL_EVENT_SPAN_BEGIN(INTERNAL_EVENT_BEARER_ACTION);
+    __INTERNAL_EVENT_SPAN_END(INTERNAL_EVENT_BEARER_ACTION, 0);
+
+    internal_event_trace_record_t records[4];
+    uint32_t dropped;
+    TEST_ASSERT_EQUAL(0, internal_event_trace_read(records, ARRAY_SIZE(records), &dropped));
+    TEST_ASSERT_EQUAL(0, dropped);
+}
+
+void test_full_ring(void)
+{
+    internal_event_trace_record_t records[INTERNAL_EVENT_BUFFER_SIZE];
+    uint32_t dropped;
+
+    for (uint32_t round = 0; round < 3; ++round)
+    {
+        /* The newest records are dropped on a full ring. */
+        for (uint32_t i = 0; i < INTERNAL_EVENT_BUFFER_SIZE + 5; ++i)
+        {
+            internal_event_trace_push(INTERNAL_EVENT_ACCESS_DISPATCH, INTERNAL_EVENT_TRACE_PHASE_INSTANT, i, 0);
+        }
+
+        /* Partial reads keep the order. */
+        TEST_ASSERT_EQUAL(3, internal_event_trace_read(records, 3, &dropped));
+        TEST_ASSERT_EQUAL(5, dropped);
+        TEST_ASSERT_EQUAL(INTERNAL_EVENT_BUFFER_SIZE - 3, internal_event_trace_read(records, INTERNAL_EVENT_BUFFER_SIZE, &dropped));
+        TEST_ASSERT_EQUAL(0, dropped);
+        for (uint32_t i = 0; i < INTERNAL_EVENT_BUFFER_SIZE - 3; ++i)
+        {
+            TEST_ASSERT_EQUAL(i + 3, records[i].state);
+        }
+        TEST_ASSERT_EQUAL(0, internal_event_trace_read(records, INTERNAL_EVENT_BUFFER_SIZE, &dropped));
+    }
+}
@@ -0,0 +1,575 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "light_lc_light_pi.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+#include "light_lightness_utils.h"
+#include "light_lc_state_utils.h"
+#include "light_lc_server_property_constants.h"
+
+#include "timer_scheduler_mock.h"
+#include "timer_mock.h"
+
+#define INSTANCES_MAX           (8)
+#define STEPS                   (2000)
+#define BENCHMARK_TICKS         (100000)
+
+/* Illuminance values are in 0.01 lux. */
+#define SETPOINT_ILLUMINANCE    (15000)
+/* Illuminance the light adds to the room at full linear lightness. */
+#define LAMP_ILLUMINANCE_MAX    (20000)
+
+typedef struct
+{
+    light_lc_setup_server_t server;
+    float kiu;
+    float kid;
+    float kpu;
+    float kpd;
+    uint8_t accuracy;
+    uint32_t ambient;
+    uint32_t luxlevel_out;
+    uint16_t actual;
+    uint32_t actual_set_count;
+} test_instance_t;
+
+/* The integer regulator that was in place before the fixed point one, kept for comparing outputs. */
+typedef struct
+{
+    int32_t integral;
+} reference_regulator_t;
+
+static test_instance_t m_instances[INSTANCES_MAX];
+static timer_event_t * mp_timer;
+static bool m_timer_scheduled;
+static timestamp_t m_now;
+static uint32_t m_property_get_count;
+
+/*****************************************************************************
+* Mock functions
+*****************************************************************************/
+static test_instance_t * instance_get(const light_lc_setup_server_t * p_s_server)
+{
+    return PARENT_BY_FIELD_GET(test_instance_t, server, p_s_server);
+}
+
+static uint32_t float_word_get(float value)
+{
+    uint32_t word;
+    memcpy(&word, &value, sizeof(word));
+    return word;
+}
+
+uint32_t light_lc_state_utils_property_get(light_lc_setup_server_t * p_s_server, uint16_t property_id)
+{
+    test_instance_t * p_instance = instance_get(p_s_server);
+
+    m_property_get_count++;
+    switch (property_id)
+    {
+        case LIGHT_LC_SERVER_REGULATOR_KIU_PID:
+            return float_word_get(p_instance->kiu);
+        case LIGHT_LC_SERVER_REGULATOR_KID_PID:
+            return float_word_get(p_instance->kid);
+        case LIGHT_LC_SERVER_REGULATOR_KPU_PID:
+            return float_word_get(p_instance->kpu);
+        case LIGHT_LC_SERVER_REGULATOR_KPD_PID:
+            return float_word_get(p_instance->kpd);
+        case LIGHT_LC_SERVER_REGULATOR_ACCURACY_PID:
+            return p_instance->accuracy;
+        default:
+            TEST_FAIL_MESSAGE("Unexpected property");
+            return 0;
+    }
+}
+
+bool light_lc_state_utils_server_control_is_disabled(light_lc_setup_server_t * p_s_server)
+{
+    return false;
+}
+
+uint32_t light_lc_state_utils_lightness_out_get(light_lc_setup_server_t * p_s_server)
+{
+    return 0;
+}
+
+bool light_lc_state_utils_ambient_luxlevel_is_valid(light_lc_setup_server_t * p_s_server)
+{
+    return true;
+}
+
+uint32_t light_lc_state_utils_ambient_luxlevel_get(light_lc_setup_server_t * p_s_server)
+{
+    return instance_get(p_s_server)->ambient;
+}
+
+uint32_t light_lc_state_utils_luxlevel_out_get(light_lc_setup_server_t * p_s_server)
+{
+    return instance_get(p_s_server)->luxlevel_out;
+}
+
+static void actual_get_cb(const light_lc_setup_server_t * p_s_server, uint16_t * p_actual_lightness)
+{
+    *p_actual_lightness = instance_get(p_s_server)->actual;
+}
+
+static void actual_set_cb(const light_lc_setup_server_t * p_s_server, uint16_t actual_lightness)
+{
+    test_instance_t * p_instance = instance_get(p_s_server);
+
+    p_instance->actual = actual_lightness;
+    p_instance->actual_set_count++;
+}
+
+static const light_lc_setup_server_callbacks_t m_callbacks =
+{
+    .light_lc_cbs =
+    {
+        .light_lc_actual_set_cb = actual_set_cb,
+        .light_lc_actual_get_cb = actual_get_cb
+    }
+};
+
+static timestamp_t timer_now_cb(int num_calls)
+{
+    return m_now;
+}
+
+static void timer_sch_reschedule_cb(timer_event_t * p_timer, timestamp_t new_timestamp, int num_calls)
+{
+    TEST_ASSERT_TRUE(mp_timer == NULL || mp_timer == p_timer);
+    TEST_ASSERT_NOT_NULL(p_timer->cb);
+    mp_timer = p_timer;
+    mp_timer->timestamp = new_timestamp;
+    m_timer_scheduled = true;
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+/* The regulator step as it was before the coefficients were cached in fixed point. */
+static void reference_update(reference_regulator_t * p_reference, test_instance_t * p_instance, uint32_t interval_ms)
+{
+    light_lc_setup_server_t * p_s_server = &p_instance->server;
+    uint16_t actual;
+    float coefficient;
+
+    p_s_server->settings.p_callbacks->light_lc_cbs.light_lc_actual_get_cb(p_s_server, &actual);
+    uint16_t current_linear = light_lightness_utils_actual_to_linear(actual);
+    uint32_t ambient = light_lc_state_utils_ambient_luxlevel_get(p_s_server);
+    uint32_t luxlevel_out = light_lc_state_utils_luxlevel_out_get(p_s_server);
+    uint8_t accuracy = light_lc_state_utils_property_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_ACCURACY_PID);
+    int32_t e = (int64_t) ROUNDED_DIV((int64_t) luxlevel_out - (int64_t) ambient, 100);
+    uint32_t d = (accuracy * (ROUNDED_DIV(luxlevel_out, 100)) / 2) / 2 / 100;
+    int32_t u;
+    int32_t l;
+
+    uint32_t word = light_lc_state_utils_property_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KIU_PID);
+    memcpy(&coefficient, &word, sizeof(coefficient));
+    uint32_t k_iu = (uint32_t) (coefficient * 100);
+    word = light_lc_state_utils_property_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KID_PID);
+    memcpy(&coefficient, &word, sizeof(coefficient));
+    uint32_t k_id = (uint32_t) (coefficient * 100);
+    word = light_lc_state_utils_property_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KPU_PID);
+    memcpy(&coefficient, &word, sizeof(coefficient));
+    uint32_t k_pu = (uint32_t) (coefficient * 100);
+    word = light_lc_state_utils_property_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KPD_PID);
+    memcpy(&coefficient, &word, sizeof(coefficient));
+    uint32_t k_pd = (uint32_t) (coefficient * 100);
+
+    if (e > (int32_t) d)
+    {
+        u = e - d;
+    }
+    else if (e < (int32_t) (0 - d))
+    {
+        u = e + d;
+    }
+    else
+    {
+        u = 0;
+    }
+
+    if (u >= 0)
+    {
+        p_reference->integral += ((int64_t) u * (int64_t) interval_ms * (int64_t) k_iu / 1000) / 100;
+        l = p_reference->integral + ((int64_t) u * (int64_t) k_pu) / 100;
+    }
+    else
+    {
+        p_reference->integral += ((int64_t) u * (int64_t) interval_ms * (int64_t) k_id / 1000) / 100;
+        l = p_reference->integral + ((int64_t) u * (int64_t) k_pd) / 100;
+    }
+    p_reference->integral = MAX(MIN(65535, p_reference->integral), 0);
+
+    int32_t diff = l / LIGHT_LC_LIGHT_PI_CONVERSION_DIVISOR;
+    int32_t computed = MAX(MIN((int32_t) current_linear + diff, UINT16_MAX), 0);
+
+    if (computed != current_linear)
+    {
+        p_s_server->settings.p_callbacks->light_lc_cbs.light_lc_actual_set_cb(p_s_server,
+                                                                             light_lightness_utils_linear_to_actual(computed));
+    }
+}
+
+/* The room: daylight plus what the light adds at its current linear lightness. */
+static void ambient_update(test_instance_t * p_instance, uint32_t daylight)
+{
+    uint16_t linear = light_lightness_utils_actual_to_linear(p_instance->actual);
+    p_instance->ambient = daylight + (uint32_t) (((uint64_t) linear * LAMP_ILLUMINANCE_MAX) / UINT16_MAX);
+}
+
+/* Daylight slowly rising, with a cloud passing over half way. */
+static uint32_t daylight_get(uint32_t step)
+{
+    uint32_t daylight = step * 5;
+    if (step > STEPS / 2 && step < STEPS / 2 + 100)
+    {
+        daylight /= 4;
+    }
+    return daylight;
+}
+
+static void instance_init(test_instance_t * p_instance, float kiu, float kid, float kpu, float kpd)
+{
+    memset(p_instance, 0, sizeof(test_instance_t));
+    p_instance->server.settings.p_callbacks = &m_callbacks;
+    p_instance->kiu = kiu;
+    p_instance->kid = kid;
+    p_instance->kpu = kpu;
+    p_instance->kpd = kpd;
+    p_instance->accuracy = 2;
+    p_instance->luxlevel_out = SETPOINT_ILLUMINANCE;
+}
+
+static void tick(void)
+{
+    TEST_ASSERT_TRUE(m_timer_scheduled);
+    m_now = mp_timer->timestamp;
+    mp_timer->timestamp += mp_timer->interval;
+    mp_timer->cb(m_now, mp_timer->p_context);
+}
+
+static uint64_t time_ns_get(void)
+{
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    timer_scheduler_mock_Init();
+    timer_mock_Init();
+
+    timer_now_StubWithCallback(timer_now_cb);
+    timer_sch_reschedule_StubWithCallback(timer_sch_reschedule_cb);
+
+    light_lc_light_pi_reset();
+    mp_timer = NULL;
+    m_timer_scheduled = false;
+    m_now = 0x1000;
+    m_property_get_count = 0;
+
+    for (uint32_t i = 0; i < INSTANCES_MAX; i++)
+    {
+        instance_init(&m_instances[i], 250.0f, 25.0f, 80.0f, 80.0f);
+    }
+}
+
+void tearDown(void)
+{
+    timer_scheduler_mock_Verify();
+    timer_scheduler_mock_Destroy();
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_start(void)
+{
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, light_lc_light_pi_start(NULL));
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    /* All instances share a single tick. */
+    for (uint32_t i = 0; i < INSTANCES_MAX; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&m_instances[i].server));
+        TEST_ASSERT_TRUE(m_timer_scheduled);
+        TEST_ASSERT_EQUAL(MS_TO_US(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS), mp_timer->interval);
+        TEST_ASSERT_EQUAL(m_now + MS_TO_US(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS), mp_timer->timestamp);
+    }
+
+    /* Starting an instance twice doesn't add it twice. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&m_instances[0].server));
+
+    for (uint32_t i = 0; i < INSTANCES_MAX; i++)
+    {
+        m_instances[i].ambient = SETPOINT_ILLUMINANCE / 2;
+    }
+    tick();
+    for (uint32_t i = 0; i < INSTANCES_MAX; i++)
+    {
+        TEST_ASSERT_EQUAL(1, m_instances[i].actual_set_count);
+    }
+
+    /* Properties are only read when the coefficients are cached. */
+    TEST_ASSERT_EQUAL((INSTANCES_MAX + 1) * 5, m_property_get_count);
+}
+
+void test_interval_set(void)
+{
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, light_lc_light_pi_interval_set(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MIN_MS - 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, light_lc_light_pi_interval_set(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MAX_MS + 1));
+
+    /* Nothing to schedule without instances. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_interval_set(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MAX_MS));
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&m_instances[0].server));
+    TEST_ASSERT_EQUAL(25u << 16, m_instances[0].server.light_pi.kiu_dt);
+    TEST_ASSERT_EQUAL(5u << 15, m_instances[0].server.light_pi.kid_dt);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_interval_set(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MIN_MS));
+    TEST_ASSERT_EQUAL(MS_TO_US(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MIN_MS), mp_timer->interval);
+    TEST_ASSERT_EQUAL(m_now + MS_TO_US(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MIN_MS), mp_timer->timestamp);
+    TEST_ASSERT_EQUAL(5u << 15, m_instances[0].server.light_pi.kiu_dt);
+    TEST_ASSERT_EQUAL(1u << 14, m_instances[0].server.light_pi.kid_dt);
+
+    /* The proportional coefficients don't depend on the interval. */
+    TEST_ASSERT_EQUAL(80u << 16, m_instances[0].server.light_pi.kpu);
+    TEST_ASSERT_EQUAL(80u << 16, m_instances[0].server.light_pi.kpd);
+}
+
+void test_coefficients_update(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&m_instances[0].server));
+
+    /* Fractions are kept, invalid values disable the term. */
+    m_instances[0].kiu = 0.5f;
+    m_instances[0].kid = -1.0f;
+    m_instances[0].kpu = NAN;
+    m_instances[0].kpd = 1e9f;
+    m_instances[0].accuracy = 10;
+    light_lc_light_pi_coefficients_update(&m_instances[0].server);
+
+    TEST_ASSERT_EQUAL(1u << 15, m_instances[0].server.light_pi.kiu);
+    TEST_ASSERT_EQUAL(0, m_instances[0].server.light_pi.kid);
+    TEST_ASSERT_EQUAL(0, m_instances[0].server.light_pi.kpu);
+    TEST_ASSERT_EQUAL(UINT32_MAX - UINT16_MAX, m_instances[0].server.light_pi.kpd);
+    TEST_ASSERT_EQUAL(10, m_instances[0].server.light_pi.accuracy);
+}
+
+void test_instances_independent(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&m_instances[0].server));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&m_instances[1].server));
+
+    /* A dark room and a bright room: only the dark one builds up an integral term. */
+    m_instances[0].ambient = 0;
+    m_instances[1].ambient = SETPOINT_ILLUMINANCE * 2;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        tick();
+    }
+
+    TEST_ASSERT_EQUAL(10 * 25 * 150u << 16, m_instances[0].server.light_pi.integral);
+    TEST_ASSERT_EQUAL(0, m_instances[1].server.light_pi.integral);
+    TEST_ASSERT_EQUAL(0, m_instances[1].actual);
+    TEST_ASSERT_NOT_EQUAL(0, m_instances[0].actual);
+}
+
+void test_matches_integer_path(void)
+{
+    /* With coefficients that scale to whole numbers over the summation interval, the integer
+     * regulator made no rounding errors, and the fixed point one must give the same output. */
+    const float coefficients[][4] =
+    {
+        {250.0f, 20.0f, 80.0f, 80.0f},
+        {100.0f, 100.0f, 12.0f, 1.0f},
+        {1000.0f, 0.0f, 1000.0f, 0.0f},
+    };
+
+    for (uint32_t c = 0; c < ARRAY_SIZE(coefficients); c++)
+    {
+        setUp();
+        test_instance_t * p_instance = &m_instances[0];
+        test_instance_t * p_expected = &m_instances[1];
+        reference_regulator_t reference = {0};
+
+        instance_init(p_instance, coefficients[c][0], coefficients[c][1], coefficients[c][2], coefficients[c][3]);
+        instance_init(p_expected, coefficients[c][0], coefficients[c][1], coefficients[c][2], coefficients[c][3]);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&p_instance->server));
+
+        for (uint32_t step = 0; step < STEPS; step++)
+        {
+            ambient_update(p_instance, daylight_get(step));
+            ambient_update(p_expected, daylight_get(step));
+            tick();
+            reference_update(&reference, p_expected, LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS);
+
+            TEST_ASSERT_EQUAL(p_expected->actual, p_instance->actual);
+            TEST_ASSERT_EQUAL(p_expected->actual_set_count, p_instance->actual_set_count);
+            TEST_ASSERT_EQUAL((uint32_t) reference.integral << 16, p_instance->server.light_pi.integral);
+        }
+        tearDown();
+    }
+}
+
+void test_fractional_coefficients(void)
+{
+    /* The integer regulator truncated the integral step every tick, and the coefficients to two
+     * decimals. The fixed point regulator must stay at least as close to the exact regulator. */
+    const float coefficients[][4] =
+    {
+        {250.0f, 25.0f, 80.0f, 80.0f},
+        {3.333f, 0.777f, 1.015f, 0.5f},
+        {12.34f, 5.678f, 9.1011f, 12.13f},
+    };
+    const uint16_t actual = 0x8000;
+    const uint32_t interval_ms = 30;
+
+    for (uint32_t c = 0; c < ARRAY_SIZE(coefficients); c++)
+    {
+        setUp();
+        test_instance_t * p_instance = &m_instances[0];
+        test_instance_t * p_expected = &m_instances[1];
+        reference_regulator_t reference = {0};
+        double exact_integral = 0;
+        double max_error = 0;
+        double max_reference_error = 0;
+
+        instance_init(p_instance, coefficients[c][0], coefficients[c][1], coefficients[c][2], coefficients[c][3]);
+        instance_init(p_expected, coefficients[c][0], coefficients[c][1], coefficients[c][2], coefficients[c][3]);
+        p_instance->accuracy = 0;
+        p_expected->accuracy = 0;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_interval_set(interval_ms));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&p_instance->server));
+
+        /* Open loop: the lightness is held, so the outputs only depend on the regulator. */
+        for (uint32_t step = 0; step < STEPS; step++)
+        {
+            uint32_t ambient = (step % 200 < 100) ? SETPOINT_ILLUMINANCE - 300 + step : SETPOINT_ILLUMINANCE + 4000;
+            p_instance->ambient = ambient;
+            p_expected->ambient = ambient;
+            p_instance->actual = actual;
+            p_expected->actual = actual;
+
+            tick();
+            reference_update(&reference, p_expected, interval_ms);
+
+            int32_t u = (int32_t) ROUNDED_DIV((int64_t) SETPOINT_ILLUMINANCE - (int64_t) ambient, 100);
+            exact_integral += u * (double) (u >= 0 ? coefficients[c][0] : coefficients[c][1]) * interval_ms / 1000.0;
+            double exact_output = exact_integral + u * (double) (u >= 0 ? coefficients[c][2] : coefficients[c][3]);
+            exact_integral = MAX(MIN(exact_integral, 65535.0), 0.0);
+
+            double exact_linear = MAX(MIN(light_lightness_utils_actual_to_linear(actual) +
+                                          trunc(trunc(exact_output) / LIGHT_LC_LIGHT_PI_CONVERSION_DIVISOR), UINT16_MAX), 0);
+            double linear = light_lightness_utils_actual_to_linear(p_instance->actual);
+            double reference_linear = light_lightness_utils_actual_to_linear(p_expected->actual);
+
+            max_error = MAX(max_error, fabs(linear - exact_linear));
+            max_reference_error = MAX(max_reference_error, fabs(reference_linear - exact_linear));
+        }
+
+        printf("Coefficients %u: max lightness error %.0f fixed point, %.0f integer\n",
+               c, max_error, max_reference_error);
+        /* One step of the lightness conversion, from the coefficients' 16 bit fractions. */
+        TEST_ASSERT_TRUE(max_error <= 2);
+        TEST_ASSERT_TRUE(max_error <= max_reference_error);
+        tearDown();
+    }
+}
+
+void test_tick_cost(void)
+{
+    reference_regulator_t references[INSTANCES_MAX] = {{0}};
+
+    for (uint32_t i = 0; i < INSTANCES_MAX; i++)
+    {
+        instance_init(&m_instances[i], 12.5f, 2.5f, 8.0f, 8.0f);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, light_lc_light_pi_start(&m_instances[i].server));
+    }
+
+    uint64_t start_ns = time_ns_get();
+    for (uint32_t t = 0; t < BENCHMARK_TICKS; t++)
+    {
+        for (uint32_t i = 0; i < INSTANCES_MAX; i++)
+        {
+            m_instances[i].ambient = SETPOINT_ILLUMINANCE + (int32_t) (t % 64) * 10 - 320;
+        }
+        tick();
+    }
+    uint64_t duration_ns = time_ns_get() - start_ns;
+
+    /* The coefficients are never read from the properties by the tick. */
+    TEST_ASSERT_EQUAL(INSTANCES_MAX * 5, m_property_get_count);
+
+    /* The same load on the integer regulator, which read and converted its coefficients every step. */
+    uint64_t reference_start_ns = time_ns_get();
+    for (uint32_t t = 0; t < BENCHMARK_TICKS; t++)
+    {
+        for (uint32_t i = 0; i < INSTANCES_MAX; i++)
+        {
+            m_instances[i].ambient = SETPOINT_ILLUMINANCE + (int32_t) (t % 64) * 10 - 320;
+            reference_update(&references[i], &m_instances[i], LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS);
+        }
+    }
+    uint64_t reference_duration_ns = time_ns_get() - reference_start_ns;
+
+    printf("Regulator tick, %u instances: %llu ns fixed point, %llu ns integer with coefficient reads\n",
+           INSTANCES_MAX,
+           (unsigned long long) (duration_ns / BENCHMARK_TICKS),
+           (unsigned long long) (reference_duration_ns / BENCHMARK_TICKS));
+}
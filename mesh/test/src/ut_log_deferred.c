@@ -0,0 +1,346 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "log.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "utils.h"
+
+#define RECORD_HEADER_SIZE      (16)
+#define RING_WORDS              (LOG_DEFERRED_BUFFER_SIZE / sizeof(uint32_t))
+#define BENCHMARK_CALLS         (200000)
+#define BENCHMARK_READ_INTERVAL (4)
+
+typedef struct
+{
+    uint32_t len_words;
+    uint32_t type;
+    uint32_t padding;
+    uint32_t level;
+    uint16_t line;
+    uint32_t timestamp;
+    uint32_t string;
+    uint32_t filename;
+    const uint8_t * p_args;
+    uint32_t args_len;
+} record_t;
+
+static uint8_t m_read_buffer[LOG_DEFERRED_BUFFER_SIZE];
+static char m_format_buffer[256];
+
+static void deferred_log(uint32_t level, uint16_t line, const char * p_format, ...)
+{
+    va_list arguments;
+    va_start(arguments, p_format);
+    log_callback_deferred(level, "file.c", line, 1234, p_format, arguments);
+    va_end(arguments);
+}
+
+static uint32_t word_get(const uint8_t * p_data)
+{
+    uint32_t value;
+    memcpy(&value, p_data, sizeof(value));
+    return value;
+}
+
+static const uint8_t * record_parse(const uint8_t * p_data, record_t * p_record)
+{
+    uint32_t header = word_get(p_data);
+
+    p_record->len_words = header & 0xFF;
+    p_record->type = (header >> 8) & 0x03;
+    p_record->padding = (header >> 10) & 0x03;
+    p_record->level = (header >> 12) & 0x0F;
+    p_record->line = header >> 16;
+    if (p_record->type == LOG_DEFERRED_RECORD_TYPE_DROP)
+    {
+        p_record->timestamp = word_get(&p_data[4]);
+        p_record->args_len = 0;
+    }
+    else
+    {
+        p_record->timestamp = word_get(&p_data[4]);
+        p_record->string = word_get(&p_data[8]);
+        p_record->filename = word_get(&p_data[12]);
+        p_record->p_args = &p_data[RECORD_HEADER_SIZE];
+        p_record->args_len = p_record->len_words * sizeof(uint32_t) - RECORD_HEADER_SIZE - p_record->padding;
+    }
+    return &p_data[p_record->len_words * sizeof(uint32_t)];
+}
+
+static uint32_t read_all(void)
+{
+    uint32_t total = 0;
+    uint32_t count;
+    do
+    {
+        count = log_deferred_read(&m_read_buffer[total], sizeof(m_read_buffer) - total);
+        total += count;
+    } while (count > 0 && total < sizeof(m_read_buffer));
+    return total;
+}
+
+static void formatting_callback(uint32_t dbg_level, const char * p_filename, uint16_t line,
+    uint32_t timestamp, const char * format, va_list arguments)
+{
+    /* The cost of the synchronous backends, formatting the message at the call site. */
+    int len = snprintf(m_format_buffer, sizeof(m_format_buffer), "<t: %10u>, %s, %4d, ", timestamp, p_filename, line);
+    (void) vsnprintf(&m_format_buffer[len], sizeof(m_format_buffer) - len, format, arguments);
+}
+
+static uint64_t time_ns_get(void)
+{
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+void setUp(void)
+{
+    log_init(LOG_SRC_TEST, LOG_LEVEL_INFO, log_callback_deferred);
+    while (log_deferred_read(m_read_buffer, sizeof(m_read_buffer)) > 0)
+    {
+    }
+}
+
+void tearDown(void)
+{
+    log_init(LOG_MSK_DEFAULT, LOG_LEVEL_DEFAULT, LOG_CALLBACK_DEFAULT);
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_printf_record(void)
+{
+    static const char format[] = "%d %5u %s %llx %c %.*f %p %%\n";
+    int local;
+
+    deferred_log(LOG_LEVEL_INFO, 321, format, -5, 7u, "hello", 0x1122334455667788ull, 'z', 2, 1.5, (void *) &local);
+    uint32_t len = log_deferred_read(m_read_buffer, sizeof(m_read_buffer));
+
+    record_t record;
+    TEST_ASSERT_EQUAL_PTR(&m_read_buffer[len], record_parse(m_read_buffer, &record));
+    TEST_ASSERT_EQUAL(LOG_DEFERRED_RECORD_TYPE_PRINTF, record.type);
+    TEST_ASSERT_EQUAL(LOG_LEVEL_INFO, record.level);
+    TEST_ASSERT_EQUAL(321, record.line);
+    TEST_ASSERT_EQUAL(1234, record.timestamp);
+    TEST_ASSERT_EQUAL_HEX32((uint32_t) (uintptr_t) format, record.string);
+
+    int32_t value32;
+    int64_t value64;
+    double value_double;
+    const uint8_t * p_arg = record.p_args;
+
+    memcpy(&value32, p_arg, 4);
+    TEST_ASSERT_EQUAL(-5, value32);
+    memcpy(&value32, p_arg + 4, 4);
+    TEST_ASSERT_EQUAL(7, value32);
+    p_arg += 8;
+    TEST_ASSERT_EQUAL(5, p_arg[0]);
+    TEST_ASSERT_EQUAL_MEMORY("hello", &p_arg[1], 5);
+    p_arg += 6;
+    memcpy(&value64, p_arg, 8);
+    TEST_ASSERT_TRUE(value64 == 0x1122334455667788ll);
+    memcpy(&value32, p_arg + 8, 4);
+    TEST_ASSERT_EQUAL('z', value32);
+    memcpy(&value32, p_arg + 12, 4);
+    TEST_ASSERT_EQUAL(2, value32);
+    memcpy(&value_double, p_arg + 16, 8);
+    TEST_ASSERT_TRUE(value_double == 1.5);
+    memcpy(&value64, p_arg + 24, 8);
+    TEST_ASSERT_TRUE(value64 == (int64_t) (uintptr_t) &local);
+    TEST_ASSERT_EQUAL(46, record.args_len);
+}
+
+void test_filtering(void)
+{
+    __LOG(LOG_SRC_TEST, LOG_LEVEL_DBG1, "filtered by level %u\n", 1);
+    __LOG(LOG_SRC_BEARER, LOG_LEVEL_ERROR, "filtered by source %u\n", 2);
+    TEST_ASSERT_EQUAL(0, log_deferred_read(m_read_buffer, sizeof(m_read_buffer)));
+
+    __LOG(LOG_SRC_TEST, LOG_LEVEL_WARN, "passed %u\n", 3);
+    uint32_t len = log_deferred_read(m_read_buffer, sizeof(m_read_buffer));
+    TEST_ASSERT_EQUAL(RECORD_HEADER_SIZE + 4, len);
+
+    record_t record;
+    (void) record_parse(m_read_buffer, &record);
+    TEST_ASSERT_EQUAL(LOG_LEVEL_WARN, record.level);
+    TEST_ASSERT_EQUAL(3, word_get(record.p_args));
+}
+
+void test_hexdump(void)
+{
+    uint8_t data[100];
+    for (uint32_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = i;
+    }
+
+    __LOG_XB(LOG_SRC_TEST, LOG_LEVEL_INFO, "data", data, sizeof(data));
+    (void) log_deferred_read(m_read_buffer, sizeof(m_read_buffer));
+
+    record_t record;
+    (void) record_parse(m_read_buffer, &record);
+    TEST_ASSERT_EQUAL(LOG_DEFERRED_RECORD_TYPE_HEXDUMP, record.type);
+    TEST_ASSERT_EQUAL(LOG_DEFERRED_ARGS_SIZE_MAX, record.args_len);
+    TEST_ASSERT_EQUAL(sizeof(data), record.p_args[0]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, &record.p_args[1], LOG_DEFERRED_ARGS_SIZE_MAX - 1);
+}
+
+void test_truncation(void)
+{
+    deferred_log(LOG_LEVEL_INFO, 1, "%s\n", "a string longer than the limit");
+    (void) log_deferred_read(m_read_buffer, sizeof(m_read_buffer));
+
+    record_t record;
+    (void) record_parse(m_read_buffer, &record);
+    TEST_ASSERT_EQUAL(1 + LOG_DEFERRED_STRING_LEN_MAX, record.args_len);
+    TEST_ASSERT_EQUAL(LOG_DEFERRED_STRING_LEN_MAX, record.p_args[0]);
+
+    /* Arguments are stored up to the first one that does not fit. */
+    deferred_log(LOG_LEVEL_INFO, 2, "%llu %llu %llu %llu %llu %llu %llu %llu %u %llu\n",
+                 1ull, 2ull, 3ull, 4ull, 5ull, 6ull, 7ull, 8ull, 9u, 10ull);
+    (void) log_deferred_read(m_read_buffer, sizeof(m_read_buffer));
+    (void) record_parse(m_read_buffer, &record);
+    TEST_ASSERT_EQUAL(LOG_DEFERRED_ARGS_SIZE_MAX, record.args_len);
+}
+
+void test_wrap_and_drop(void)
+{
+    /* Records of 6 words do not divide the ring, so the writes wrap at different offsets. */
+    const uint32_t record_words = 6;
+    const uint32_t fitting = RING_WORDS / record_words;
+    uint32_t next = 0;
+
+    for (uint32_t round = 0; round < 5; ++round)
+    {
+        for (uint32_t i = 0; i < fitting + 3; ++i)
+        {
+            deferred_log(LOG_LEVEL_INFO, next + i, "%llu\n", (unsigned long long) (next + i));
+        }
+
+        uint32_t len = read_all();
+        const uint8_t * p_data = m_read_buffer;
+        record_t record;
+
+        /* The ring is full after the records that fit before and after the wrap padding. */
+        p_data = record_parse(p_data, &record);
+        TEST_ASSERT_EQUAL(LOG_DEFERRED_RECORD_TYPE_DROP, record.type);
+        uint32_t dropped = record.timestamp;
+        TEST_ASSERT_TRUE(dropped >= 3);
+
+        uint32_t stored = 0;
+        while (p_data < &m_read_buffer[len])
+        {
+            p_data = record_parse(p_data, &record);
+            TEST_ASSERT_EQUAL(LOG_DEFERRED_RECORD_TYPE_PRINTF, record.type);
+            TEST_ASSERT_EQUAL(record_words, record.len_words);
+            TEST_ASSERT_EQUAL((uint16_t) (next + stored), record.line);
+            stored++;
+        }
+        TEST_ASSERT_EQUAL(fitting + 3, stored + dropped);
+        TEST_ASSERT_TRUE(stored >= fitting - 1);
+        next += fitting + 3;
+
+        /* A partially filled ring is read out without drops. */
+        deferred_log(LOG_LEVEL_INFO, 1, "%llu\n", 0ull);
+        TEST_ASSERT_EQUAL(record_words * sizeof(uint32_t), log_deferred_read(m_read_buffer, sizeof(m_read_buffer)));
+    }
+}
+
+void test_read_whole_records(void)
+{
+    deferred_log(LOG_LEVEL_INFO, 1, "%u\n", 1u);
+    deferred_log(LOG_LEVEL_INFO, 2, "%u\n", 2u);
+
+    /* The buffer fits one and a half records. */
+    TEST_ASSERT_EQUAL(RECORD_HEADER_SIZE + 4, log_deferred_read(m_read_buffer, 30));
+    TEST_ASSERT_EQUAL(RECORD_HEADER_SIZE + 4, log_deferred_read(m_read_buffer, 30));
+
+    record_t record;
+    (void) record_parse(m_read_buffer, &record);
+    TEST_ASSERT_EQUAL(2, record.line);
+    TEST_ASSERT_EQUAL(0, log_deferred_read(m_read_buffer, 30));
+}
+
+void test_benchmark(void)
+{
+    uint8_t data[16] = {0};
+    uint64_t start;
+    uint64_t deferred_ns = 0;
+    uint64_t read_ns = 0;
+
+    /* Typical hot path log lines: a few integers, and a packet dump. */
+    log_set_callback(formatting_callback);
+    start = time_ns_get();
+    for (uint32_t i = 0; i < BENCHMARK_CALLS; ++i)
+    {
+        __LOG(LOG_SRC_TEST, LOG_LEVEL_INFO, "RX src 0x%04x, seq %u, ttl %u, rssi %d\n", i & 0xFFFF, i, 5u, -70);
+        __LOG_XB(LOG_SRC_TEST, LOG_LEVEL_INFO, "Packet", data, sizeof(data));
+    }
+    uint64_t formatted_ns = time_ns_get() - start;
+
+    log_set_callback(log_callback_deferred);
+    for (uint32_t i = 0; i < BENCHMARK_CALLS; i += BENCHMARK_READ_INTERVAL)
+    {
+        start = time_ns_get();
+        for (uint32_t j = i; j < i + BENCHMARK_READ_INTERVAL; ++j)
+        {
+            __LOG(LOG_SRC_TEST, LOG_LEVEL_INFO, "RX src 0x%04x, seq %u, ttl %u, rssi %d\n", j & 0xFFFF, j, 5u, -70);
+            __LOG_XB(LOG_SRC_TEST, LOG_LEVEL_INFO, "Packet", data, sizeof(data));
+        }
+        uint64_t logged = time_ns_get();
+        /* 4 integers in 8 words, and 17 bytes of hex dump in 9 words. */
+        TEST_ASSERT_EQUAL(BENCHMARK_READ_INTERVAL * (8 + 9) * sizeof(uint32_t), read_all());
+        deferred_ns += logged - start;
+        read_ns += time_ns_get() - logged;
+    }
+
+    printf("Log call, %u printf + %u hex dump calls: %llu ns per call formatted, %llu ns per call deferred, %llu ns per call read out\n",
+           BENCHMARK_CALLS, BENCHMARK_CALLS,
+           (unsigned long long) (formatted_ns / (2 * BENCHMARK_CALLS)),
+           (unsigned long long) (deferred_ns / (2 * BENCHMARK_CALLS)),
+           (unsigned long long) (read_ns / (2 * BENCHMARK_CALLS)));
+}
@@ -79,5 +79,10 @@ void tearDown(void)
 void mesh_lpn_subman_init(void)
 {}
 
+bool mesh_lpn_subman_data_prepare(void)
+{
+    return true;
+}
+
 void test_stub(void)
 {}
@@ -0,0 +1,314 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unity.h>
+#include <cmock.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "lpn_poll_policy.h"
+#include "utils.h"
+#include "mesh_lpn.h"
+
+/* Friendship used by the tests: PollTimeout 30 s, ReceiveDelay 100 ms and ReceiveWindow 100 ms. */
+#define POLL_TIMEOUT_MS         30000
+#define RECEIVE_DELAY_MS        100
+#define RECEIVE_WINDOW_MS       100
+#define INTERVAL_MAX_MS         (POLL_TIMEOUT_MS - (RECEIVE_DELAY_MS + RECEIVE_WINDOW_MS) * (MESH_LPN_POLL_RETRY_COUNT + 1))
+#define INTERVAL_MIN_MS         1000
+
+/* Radio model of a single Friend Poll: the poll goes out on all advertising channels, and the LPN
+ * scans from the start of the Receive Window until the reply comes. */
+#define SIM_POLL_TX_US          1200
+#define SIM_REPLY_DELAY_MS      10
+#define SIM_POLL_RADIO_ON_US    (SIM_POLL_TX_US + SIM_REPLY_DELAY_MS * 1000)
+#define SIM_DURATION_MS         (60 * 60 * 1000)
+#define SIM_MESSAGES_MAX        2048
+
+typedef struct
+{
+    const char * p_name;
+    /* Messages arriving in the Friend Queue every period_ms, burst_size at a time spaced by spacing_ms. */
+    uint32_t period_ms;
+    uint32_t burst_size;
+    uint32_t spacing_ms;
+} traffic_profile_t;
+
+typedef struct
+{
+    uint32_t radio_on_ms;
+    uint32_t polls;
+    uint32_t delivered;
+    uint32_t latency_avg_ms;
+    uint32_t latency_max_ms;
+} sim_result_t;
+
+typedef enum
+{
+    PROFILE_IDLE,
+    PROFILE_PERIODIC,
+    PROFILE_BURST,
+    PROFILE_SESSION,
+    PROFILE_BUSY,
+    PROFILE_COUNT
+} profile_t;
+
+static const traffic_profile_t m_profiles[PROFILE_COUNT] =
+{
+    [PROFILE_IDLE]     = {"idle",     0,              0,  0},
+    [PROFILE_PERIODIC] = {"periodic", 60 * 1000,      1,  0},
+    [PROFILE_BURST]    = {"burst",    5 * 60 * 1000,  10, 100},
+    [PROFILE_SESSION]  = {"session",  10 * 60 * 1000, 20, 1500},
+    [PROFILE_BUSY]     = {"busy",     3 * 1000,       1,  0},
+};
+
+static uint32_t m_arrivals[SIM_MESSAGES_MAX];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+
+static uint32_t arrivals_generate(const traffic_profile_t * p_profile)
+{
+    uint32_t count = 0;
+
+    if (p_profile->period_ms == 0)
+    {
+        return 0;
+    }
+
+    /* Keep the first burst off the start of the friendship. */
+    for (uint32_t t = p_profile->period_ms / 2; t < SIM_DURATION_MS; t += p_profile->period_ms)
+    {
+        for (uint32_t i = 0; i < p_profile->burst_size; i++)
+        {
+            TEST_ASSERT_TRUE(count < SIM_MESSAGES_MAX);
+            m_arrivals[count++] = t + i * p_profile->spacing_ms;
+        }
+    }
+
+    return count;
+}
+
+/* Runs the LPN polling sessions the same way the LPN does: within a session a new Friend Poll is
+ * sent MESH_LPN_POLL_SEPARATION_INTERVAL_MS after each reply, and the session ends with a Friend
+ * Update with MD set to 0 once the Friend Queue is empty. */
+static sim_result_t simulate(const traffic_profile_t * p_profile, uint32_t interval_min_ms, uint32_t interval_max_ms)
+{
+    sim_result_t result = {0};
+    lpn_poll_policy_t policy;
+    uint32_t count = arrivals_generate(p_profile);
+    uint32_t next = 0;
+    uint64_t radio_on_us = 0;
+    uint64_t latency_sum_ms = 0;
+
+    lpn_poll_policy_init(&policy, interval_min_ms, interval_max_ms);
+    uint32_t now = policy.interval_ms;
+
+    while (now < SIM_DURATION_MS)
+    {
+        uint32_t reply_time = now + RECEIVE_DELAY_MS + SIM_REPLY_DELAY_MS;
+
+        result.polls++;
+        radio_on_us += SIM_POLL_RADIO_ON_US;
+        lpn_poll_policy_rx(&policy);
+
+        if (next < count && m_arrivals[next] <= now)
+        {
+            uint32_t latency = reply_time - m_arrivals[next++];
+
+            latency_sum_ms += latency;
+            result.latency_max_ms = (latency > result.latency_max_ms) ? latency : result.latency_max_ms;
+            result.delivered++;
+            now = reply_time + MESH_LPN_POLL_SEPARATION_INTERVAL_MS;
+        }
+        else
+        {
+            now = reply_time + lpn_poll_policy_session_end(&policy);
+        }
+    }
+
+    result.radio_on_ms = (uint32_t) (radio_on_us / 1000);
+    result.latency_avg_ms = (result.delivered > 0) ? (uint32_t) (latency_sum_ms / result.delivered) : 0;
+
+    return result;
+}
+
+static void result_print(const char * p_profile, const char * p_policy, const sim_result_t * p_result)
+{
+    printf("%-9s %-15s radio-on %6u ms/h, %5u polls, %4u msgs, latency avg %6u ms, max %6u ms\n",
+           p_profile, p_policy, p_result->radio_on_ms, p_result->polls, p_result->delivered,
+           p_result->latency_avg_ms, p_result->latency_max_ms);
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_init(void)
+{
+    lpn_poll_policy_t policy;
+
+    lpn_poll_policy_init(&policy, INTERVAL_MIN_MS, INTERVAL_MAX_MS);
+    TEST_ASSERT_EQUAL(INTERVAL_MIN_MS, policy.interval_ms);
+    TEST_ASSERT_EQUAL(0, policy.rx_count);
+
+    /* Shortest interval above the longest one, the interval is fixed. */
+    lpn_poll_policy_init(&policy, UINT32_MAX, INTERVAL_MAX_MS);
+    TEST_ASSERT_EQUAL(INTERVAL_MAX_MS, policy.interval_ms);
+}
+
+void test_empty_sessions_back_off(void)
+{
+    const uint32_t expected[] = {2000, 4000, 8000, 16000, INTERVAL_MAX_MS, INTERVAL_MAX_MS};
+    lpn_poll_policy_t policy;
+
+    lpn_poll_policy_init(&policy, INTERVAL_MIN_MS, INTERVAL_MAX_MS);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(expected); i++)
+    {
+        /* Only the final Friend Update. */
+        lpn_poll_policy_rx(&policy);
+        TEST_ASSERT_EQUAL(expected[i], lpn_poll_policy_session_end(&policy));
+    }
+
+    /* No reply at all counts as empty as well. */
+    TEST_ASSERT_EQUAL(INTERVAL_MAX_MS, lpn_poll_policy_session_end(&policy));
+
+    /* The doubling doesn't overflow. */
+    lpn_poll_policy_init(&policy, 0x90000000, UINT32_MAX);
+    TEST_ASSERT_EQUAL(UINT32_MAX, lpn_poll_policy_session_end(&policy));
+}
+
+void test_data_session_shortens(void)
+{
+    lpn_poll_policy_t policy;
+
+    lpn_poll_policy_init(&policy, INTERVAL_MIN_MS, INTERVAL_MAX_MS);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        (void) lpn_poll_policy_session_end(&policy);
+    }
+    TEST_ASSERT_EQUAL(INTERVAL_MAX_MS, policy.interval_ms);
+
+    /* A message and the final Friend Update. */
+    lpn_poll_policy_rx(&policy);
+    lpn_poll_policy_rx(&policy);
+    TEST_ASSERT_EQUAL(INTERVAL_MIN_MS, lpn_poll_policy_session_end(&policy));
+    TEST_ASSERT_EQUAL(0, policy.rx_count);
+
+    lpn_poll_policy_rx(&policy);
+    TEST_ASSERT_EQUAL(2 * INTERVAL_MIN_MS, lpn_poll_policy_session_end(&policy));
+}
+
+void test_max_set(void)
+{
+    lpn_poll_policy_t policy;
+
+    lpn_poll_policy_init(&policy, INTERVAL_MIN_MS, INTERVAL_MAX_MS);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        (void) lpn_poll_policy_session_end(&policy);
+    }
+
+    lpn_poll_policy_max_set(&policy, 5000);
+    TEST_ASSERT_EQUAL(5000, policy.interval_ms);
+    TEST_ASSERT_EQUAL(5000, lpn_poll_policy_session_end(&policy));
+
+    /* Below the shortest interval, the interval is fixed to the longest one. */
+    lpn_poll_policy_max_set(&policy, 500);
+    TEST_ASSERT_EQUAL(500, policy.interval_ms);
+    lpn_poll_policy_rx(&policy);
+    lpn_poll_policy_rx(&policy);
+    TEST_ASSERT_EQUAL(500, lpn_poll_policy_session_end(&policy));
+
+    lpn_poll_policy_max_set(&policy, INTERVAL_MAX_MS);
+    TEST_ASSERT_EQUAL(INTERVAL_MIN_MS, policy.interval_ms);
+
+    /* The fixed interval follows the longest interval both ways. */
+    lpn_poll_policy_init(&policy, UINT32_MAX, INTERVAL_MAX_MS);
+    lpn_poll_policy_max_set(&policy, 2000);
+    lpn_poll_policy_rx(&policy);
+    lpn_poll_policy_rx(&policy);
+    TEST_ASSERT_EQUAL(2000, lpn_poll_policy_session_end(&policy));
+    lpn_poll_policy_max_set(&policy, INTERVAL_MAX_MS);
+    TEST_ASSERT_EQUAL(INTERVAL_MAX_MS, lpn_poll_policy_session_end(&policy));
+}
+
+void test_traffic_simulation(void)
+{
+    printf("PollTimeout %u ms, poll interval %u..%u ms, %u us radio-on per poll\n",
+           POLL_TIMEOUT_MS, INTERVAL_MIN_MS, INTERVAL_MAX_MS, SIM_POLL_RADIO_ON_US);
+
+    sim_result_t fixed_long[PROFILE_COUNT];
+    sim_result_t fixed_short[PROFILE_COUNT];
+    sim_result_t adaptive[PROFILE_COUNT];
+
+    for (uint32_t i = 0; i < PROFILE_COUNT; i++)
+    {
+        const traffic_profile_t * p_profile = &m_profiles[i];
+
+        /* The fixed intervals are what the LPN does with MESH_LPN_ADAPTIVE_POLL_ENABLED set to 0. */
+        fixed_long[i] = simulate(p_profile, UINT32_MAX, INTERVAL_MAX_MS);
+        fixed_short[i] = simulate(p_profile, UINT32_MAX, INTERVAL_MIN_MS);
+        adaptive[i] = simulate(p_profile, INTERVAL_MIN_MS, INTERVAL_MAX_MS);
+
+        result_print(p_profile->p_name, "fixed long", &fixed_long[i]);
+        result_print(p_profile->p_name, "fixed short", &fixed_short[i]);
+        result_print(p_profile->p_name, "adaptive", &adaptive[i]);
+
+        /* Never more radio-on time than polling at the shortest interval all the time. */
+        TEST_ASSERT_TRUE(adaptive[i].radio_on_ms < fixed_short[i].radio_on_ms);
+    }
+
+    /* Without traffic, the interval settles at the longest one. */
+    TEST_ASSERT_TRUE(adaptive[PROFILE_IDLE].radio_on_ms * 10 < fixed_long[PROFILE_IDLE].radio_on_ms * 11);
+
+    /* Traffic that keeps coming for a while is picked up at close to the shortest interval. */
+    TEST_ASSERT_TRUE(adaptive[PROFILE_SESSION].latency_avg_ms * 2 < fixed_long[PROFILE_SESSION].latency_avg_ms);
+    TEST_ASSERT_TRUE(adaptive[PROFILE_BUSY].latency_avg_ms * 4 < fixed_long[PROFILE_BUSY].latency_avg_ms);
+    TEST_ASSERT_TRUE(adaptive[PROFILE_SESSION].radio_on_ms * 4 < fixed_short[PROFILE_SESSION].radio_on_ms);
+}
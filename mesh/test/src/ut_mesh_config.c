@@ -91,6 +91,8 @@ MOCK_QUEUE_DEF(listener, listener_params_t, NULL);
 mesh_config_file_params_t mesh_config_files[NRF_SECTION_ENTRIES];
 mesh_config_entry_params_t mesh_config_entries[NRF_SECTION_ENTRIES];
 mesh_config_listener_t mesh_config_entry_listeners[NRF_SECTION_ENTRIES];
+
+static const nrf_mesh_evt_t m_power_down_evt = {.type = NRF_MESH_EVT_CONFIG_POWER_DOWN};
 static entry_t m_entries[NRF_SECTION_ENTRIES + EXTRA_ENTRIES];
 static entry_t m_load_entries[NRF_SECTION_ENTRIES];
 static uint8_t m_load_ec_items[(sizeof(emergency_cache_item_t) + sizeof(entry_t)) * NRF_SECTION_ENTRIES];
@@ -258,6 +260,7 @@ static void event_handler(const nrf_mesh_evt_t * p_evt, int calls)
                               p_evt->params.config_load_failure.reason);
             break;
         case NRF_MESH_EVT_CONFIG_STABLE:
+        case NRF_MESH_EVT_CONFIG_POWER_DOWN:
             break;
         case NRF_MESH_EVT_CONFIG_STORAGE_FAILURE:
             TEST_ASSERT_EQUAL(expect.params.config_storage_failure.id.file,
@@ -887,8 +890,9 @@ void test_power_down(void)
     mesh_config_files[0].strategy = MESH_CONFIG_STRATEGY_ON_POWER_DOWN;
 
     /* mesh_config_power_down shall cause NRF_MESH_EVT_CONFIG_STABLE in any case (even if there is no data for storage) */
-    config_evt_Expect(&stable_evt);
     mesh_config_backend_power_down_Expect();
+    config_evt_Expect(&m_power_down_evt);
+    config_evt_Expect(&stable_evt);
     mesh_config_power_down();
 
     /* Dirty power down, do the action! */
@@ -900,6 +904,7 @@ void test_power_down(void)
                                                        NRF_SUCCESS);
     TEST_ASSERT_FALSE(mesh_config_is_busy());
     mesh_config_backend_power_down_Expect();
+    config_evt_Expect(&m_power_down_evt);
     mesh_config_power_down();
     TEST_ASSERT_TRUE(mesh_config_is_busy());
 
@@ -928,6 +933,7 @@ void test_power_down(void)
                                                        sizeof(entry_t),
                                                        NRF_SUCCESS);
     mesh_config_backend_power_down_Expect();
+    config_evt_Expect(&m_power_down_evt);
     mesh_config_power_down();
 
     mesh_config_entries[NRF_SECTION_ENTRIES - 1].p_state[0] &= ~MESH_CONFIG_ENTRY_FLAG_DIRTY;
@@ -937,6 +943,7 @@ void test_power_down(void)
     mesh_config_entries[0].p_state[0] = MESH_CONFIG_ENTRY_FLAG_DIRTY; // no longer active
     mesh_config_backend_erase_ExpectAndReturn(*mesh_config_entries[0].p_id, NRF_SUCCESS);
     mesh_config_backend_power_down_Expect();
+    config_evt_Expect(&m_power_down_evt);
     mesh_config_power_down();
 
     /* Entries from files with MESH_CONFIG_STRATEGY_CONTINUOUS should go to the emergency cache. */
@@ -944,6 +951,7 @@ void test_power_down(void)
     mesh_config_entries[0].p_state[0] = MESH_CONFIG_ENTRY_FLAG_DIRTY | MESH_CONFIG_ENTRY_FLAG_ACTIVE;
     emergency_cache_item_store_ExpectAndReturn(&mesh_config_entries[0], *mesh_config_entries[0].p_id, NRF_SUCCESS);
     mesh_config_backend_power_down_Expect();
+    config_evt_Expect(&m_power_down_evt);
     mesh_config_power_down();
 }
 
@@ -1222,6 +1230,7 @@ void test_backend_cb_after_emrgency_item_storing(void)
     emergency_cache_item_t * p_cache_item = (emergency_cache_item_t *)ec_item;
     p_cache_item->id = *mesh_config_entries[0].p_id;
     mesh_config_backend_power_down_Expect();
+    config_evt_Expect(&m_power_down_evt);
     mesh_config_power_down();
     TEST_ASSERT_EQUAL(MESH_CONFIG_ENTRY_FLAG_ACTIVE | MESH_CONFIG_ENTRY_FLAG_BUSY, mesh_config_entries[0].p_state[0]);
 
@@ -1272,6 +1281,7 @@ void test_backend_cb_failed_writing_after_power_down(void)
     TEST_ASSERT_TRUE(mesh_config_is_busy());
 
     mesh_config_backend_power_down_Expect();
+    config_evt_Expect(&m_power_down_evt);
     mesh_config_power_down();
     TEST_ASSERT_TRUE(mesh_config_is_busy());
 
@@ -1310,3 +1320,100 @@ void test_smart_strategy_power_down_file_cleaning(void)
 
     mesh_config_load();
 }
+
+void test_batch(void)
+{
+    entry_t entry = {1, 2};
+    entry_set_params_t expect_params = {.id = TEST_ENTRY(0), .entry = entry, .return_value = NRF_SUCCESS};
+
+    mesh_config_batch_begin();
+    mesh_config_batch_begin();
+
+    /* Changes in the batch only mark the entries dirty: */
+    entry_set_Expect(&expect_params);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(TEST_ENTRY(0), &entry));
+
+    entry.var1 = 3;
+    expect_params.entry = entry;
+    entry_set_Expect(&expect_params);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(TEST_ENTRY(0), &entry));
+
+    expect_params.id = TEST_ENTRY(1);
+    entry_set_Expect(&expect_params);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(TEST_ENTRY(1), &entry));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_delete(TEST_ENTRY(1)));
+
+    expect_params.id = TEST_ENTRY(3);
+    entry_set_Expect(&expect_params);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(TEST_ENTRY(3), &entry));
+
+    TEST_ASSERT_EQUAL_HEX8(MESH_CONFIG_ENTRY_FLAG_ACTIVE | MESH_CONFIG_ENTRY_FLAG_DIRTY, mesh_config_entries[0].p_state[0]);
+    TEST_ASSERT_EQUAL_HEX8(MESH_CONFIG_ENTRY_FLAG_DIRTY, mesh_config_entries[1].p_state[0]);
+    TEST_ASSERT_EQUAL_HEX8(MESH_CONFIG_ENTRY_FLAG_ACTIVE | MESH_CONFIG_ENTRY_FLAG_DIRTY, mesh_config_entries[3].p_state[0]);
+
+    /* Ending a nested batch doesn't store anything: */
+    mesh_config_batch_end();
+    TEST_ASSERT_EQUAL_HEX8(MESH_CONFIG_ENTRY_FLAG_ACTIVE | MESH_CONFIG_ENTRY_FLAG_DIRTY, mesh_config_entries[0].p_state[0]);
+
+    /* Ending the outermost batch stores the final value of each entry once: */
+    mesh_config_backend_store_ExpectWithArrayAndReturn(TEST_ENTRY(0),
+                                                       (const uint8_t *) &entry,
+                                                       sizeof(entry),
+                                                       sizeof(entry),
+                                                       NRF_SUCCESS);
+    mesh_config_backend_erase_ExpectAndReturn(TEST_ENTRY(1), NRF_ERROR_NOT_FOUND);
+    mesh_config_backend_store_ExpectWithArrayAndReturn(TEST_ENTRY(3),
+                                                       (const uint8_t *) &entry,
+                                                       sizeof(entry),
+                                                       sizeof(entry),
+                                                       NRF_SUCCESS);
+    mesh_config_batch_end();
+
+    TEST_ASSERT_EQUAL_HEX8(MESH_CONFIG_ENTRY_FLAG_ACTIVE | MESH_CONFIG_ENTRY_FLAG_BUSY, mesh_config_entries[0].p_state[0]);
+    TEST_ASSERT_EQUAL_HEX8(0, mesh_config_entries[1].p_state[0]);
+    TEST_ASSERT_EQUAL_HEX8(MESH_CONFIG_ENTRY_FLAG_ACTIVE | MESH_CONFIG_ENTRY_FLAG_BUSY, mesh_config_entries[3].p_state[0]);
+
+    mesh_config_backend_evt_t backend_evt = {.type = MESH_CONFIG_BACKEND_EVT_TYPE_STORE_COMPLETE, .id = TEST_ENTRY(0)};
+    m_backend_evt_cb(&backend_evt);
+
+    nrf_mesh_evt_t stable_evt = {.type = NRF_MESH_EVT_CONFIG_STABLE};
+    config_evt_Expect(&stable_evt);
+    backend_evt.id = TEST_ENTRY(3);
+    m_backend_evt_cb(&backend_evt);
+
+    /* Unbalanced end: */
+    TEST_NRF_MESH_ASSERT_EXPECT(mesh_config_batch_end());
+}
+
+void test_set_deferred(void)
+{
+    entry_t entry = {1, 2};
+    entry_set_params_t expect_params = {.id = TEST_ENTRY(0), .entry = entry, .return_value = NRF_ERROR_INVALID_DATA};
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, mesh_config_entry_set_deferred(TEST_ENTRY(0), NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      mesh_config_entry_set_deferred(TEST_ENTRY(NRF_SECTION_ENTRIES + EXTRA_ENTRIES), &entry));
+
+    /* Rejected by the state owner: */
+    entry_set_Expect(&expect_params);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, mesh_config_entry_set_deferred(TEST_ENTRY(0), &entry));
+    TEST_ASSERT_EQUAL_HEX8(0, mesh_config_entries[0].p_state[0]);
+
+    /* Applied, but not stored: */
+    expect_params.return_value = NRF_SUCCESS;
+    entry_set_Expect(&expect_params);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set_deferred(TEST_ENTRY(0), &entry));
+    TEST_ASSERT_EQUAL_HEX8(MESH_CONFIG_ENTRY_FLAG_ACTIVE, mesh_config_entries[0].p_state[0]);
+    TEST_ASSERT_EQUAL(entry.var1, m_entries[0].var1);
+    TEST_ASSERT_EQUAL(entry.var2, m_entries[0].var2);
+    TEST_ASSERT_FALSE(mesh_config_is_busy());
+
+    /* Stored on the next regular set: */
+    entry_set_Expect(&expect_params);
+    mesh_config_backend_store_ExpectWithArrayAndReturn(TEST_ENTRY(0),
+                                                       (const uint8_t *) &entry,
+                                                       sizeof(entry),
+                                                       sizeof(entry),
+                                                       NRF_SUCCESS);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(TEST_ENTRY(0), &entry));
+}
@@ -150,16 +150,21 @@ static void rx_timeout_event_trigger(uint16_t conn_index)
     m_gatt.connections[conn_index].rx.timeout_event.cb(0, &m_gatt.connections[conn_index]);
 }
 
-static void tx_complete_evt_send(void)
+static void tx_complete_evt_count_send(uint8_t count)
 {
     ble_evt_t ble_evt;
     ble_evt.header.evt_id = BLE_GATTS_EVT_HVN_TX_COMPLETE;
     ble_evt.header.evt_len = sizeof(ble_gatts_evt_hvn_tx_complete_t);
     ble_evt.evt.gatts_evt.conn_handle = 0;
-    ble_evt.evt.gatts_evt.params.hvn_tx_complete.count = 1;
+    ble_evt.evt.gatts_evt.params.hvn_tx_complete.count = count;
     mesh_gatt_on_ble_evt(&ble_evt, &m_gatt);
 }
 
+static void tx_complete_evt_send(void)
+{
+    tx_complete_evt_count_send(1);
+}
+
 static void expected_pdu_check(const uint8_t * p_pdu, uint16_t length)
 {
     TEST_ASSERT_MESSAGE(packet_buffer_can_pop(&m_pdu_buffer), "Could not pop from expected PDU buffer");
@@ -758,3 +763,77 @@ void test_disconnect_on_too_long_message(void)
                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
 }
+
+void test_tx_stats(void)
+{
+    test_gatt_init();
+
+    connected_evt_expect();
+    connect(0);
+
+    mesh_gatt_tx_stats_t stats;
+    mesh_gatt_tx_stats_get(0, &stats);
+    TEST_ASSERT_EACH_EQUAL_UINT8(0, (const uint8_t *) &stats, sizeof(stats));
+
+    sd_ble_gatts_hvx_StubWithCallback(sd_ble_gatts_hvx_cb);
+
+    /* A short PDU goes out in a single notification. */
+    const uint8_t PDU[] = {0xca, 0xfe, 0xba, 0xbe};
+    uint8_t * p_packet = mesh_gatt_packet_alloc(0, MESH_GATT_PDU_TYPE_PROV_PDU, sizeof(PDU), TX_TOKEN);
+    memcpy(p_packet, PDU, sizeof(PDU));
+    EXPECT_PDU({MESH_GATT_PDU_TYPE_PROV_PDU, 0xca, 0xfe, 0xba, 0xbe});
+    helper_bearer_event_flag_set_expect(m_flag);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_gatt_packet_send(0, p_packet));
+
+    /* A long PDU is queued behind it, and is segmented at the default MTU. */
+    const uint8_t PROXY_PDU[65] = {SAMPLE_DATA_SEGMENT_1,
+                                   SAMPLE_DATA_SEGMENT_2,
+                                   SAMPLE_DATA_SEGMENT_3,
+                                   SAMPLE_DATA_SEGMENT_4};
+    p_packet = mesh_gatt_packet_alloc(0, MESH_GATT_PDU_TYPE_PROV_PDU, sizeof(PROXY_PDU), TX_TOKEN);
+    memcpy(p_packet, PROXY_PDU, sizeof(PROXY_PDU));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_gatt_packet_send(0, p_packet));
+
+    /* The first segment finds the SoftDevice queue full. */
+    EXPECT_PDU({0x43, SAMPLE_DATA_SEGMENT_1});
+    tx_complete_evt_expect();
+    m_hvx_return = NRF_ERROR_RESOURCES;
+    helper_bearer_event_trigger();
+
+    /* All segments are sent without waiting for the notifications to complete. */
+    EXPECT_PDU({0x43, SAMPLE_DATA_SEGMENT_1});
+    EXPECT_PDU({0x83, SAMPLE_DATA_SEGMENT_2});
+    EXPECT_PDU({0x83, SAMPLE_DATA_SEGMENT_3});
+    EXPECT_PDU({0xc3, SAMPLE_DATA_SEGMENT_4});
+    helper_bearer_event_flag_set_expect(m_flag);
+    tx_complete_evt_send();
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        helper_bearer_event_flag_set_expect(m_flag);
+        helper_bearer_event_trigger();
+    }
+    tx_complete_evt_expect();
+    helper_bearer_event_trigger();
+    TEST_ASSERT_FALSE(mesh_gatt_packet_is_pending(0));
+
+    /* With a SoftDevice queue of more than one notification, they complete in the same connection event. */
+    tx_complete_evt_count_send(4);
+
+    mesh_gatt_tx_stats_get(0, &stats);
+    TEST_ASSERT_EQUAL(2, stats.pdus);
+    TEST_ASSERT_EQUAL(5, stats.notifications);
+    TEST_ASSERT_EQUAL(1, stats.queue_full);
+    TEST_ASSERT_EQUAL(2, stats.tx_complete_events);
+    TEST_ASSERT_EQUAL(4, stats.notifications_per_event_max);
+
+    /* The statistics are cleared for a new connection. */
+    disconnected_evt_expect();
+    disconnect(0);
+    connected_evt_expect();
+    connect(0);
+    mesh_gatt_tx_stats_get(0, &stats);
+    TEST_ASSERT_EACH_EQUAL_UINT8(0, (const uint8_t *) &stats, sizeof(stats));
+
+    TEST_NRF_MESH_ASSERT_EXPECT(mesh_gatt_tx_stats_get(NRF_SDH_BLE_TOTAL_LINK_COUNT, &stats));
+    TEST_NRF_MESH_ASSERT_EXPECT(mesh_gatt_tx_stats_get(0, NULL));
+}
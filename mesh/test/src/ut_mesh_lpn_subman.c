@@ -76,6 +76,8 @@ static nrf_mesh_evt_handler_cb_t m_evt_handler_cb;
 static transport_control_packet_handler_t m_transport_opcode_handler;
 static uint8_t m_exp_transaction_number;
 static bool m_skip_transaction_number_test;
+static bool m_defer_prepare;
+static uint32_t m_data_clear_cnt;
 static bool m_test_in_friendship;    /* 0: Not in friendship, 1: In friendship */
 static uint16_t m_test_sublist_size;
 
@@ -239,27 +241,39 @@ void nrf_mesh_evt_handler_add(nrf_mesh_evt_handler_t * p_handler_params)
     m_evt_handler_cb = p_handler_params->evt_cb;
 }
 
-void mesh_lpn_subman_data_push(transport_control_packet_t * p_trs_ctrl_pkt)
+static void helper_pdu_sent_check(void)
 {
-    mp_module_pkt_t = p_trs_ctrl_pkt;
     /* Check addresses and tag them in the test address list */
-    friend_sublist_add_rem_msg_t * p_pdu = (friend_sublist_add_rem_msg_t *) p_trs_ctrl_pkt->p_data;
-    for (uint32_t i = 0; i < p_trs_ctrl_pkt->data_len/2; i++)
+    friend_sublist_add_rem_msg_t * p_pdu = (friend_sublist_add_rem_msg_t *) mp_module_pkt_t->p_data;
+    for (uint32_t i = 0; i < mp_module_pkt_t->data_len/2; i++)
     {
-        helper_tag_test_address(BE2LE16(p_pdu->addr_list[i]), p_trs_ctrl_pkt->opcode);
+        helper_tag_test_address(BE2LE16(p_pdu->addr_list[i]), mp_module_pkt_t->opcode);
     }
 
-    TEST_ASSERT_TRUE(m_test_exp_confirm_cnt >=0);
-    m_test_exp_confirm_cnt++;
     if (!m_skip_transaction_number_test)
     {
         TEST_ASSERT_EQUAL(m_exp_transaction_number, p_pdu->transaction_number);
     }
 }
 
-void mesh_lpn_subman_data_clear(void)
+void mesh_lpn_subman_data_push(transport_control_packet_t * p_trs_ctrl_pkt)
 {
+    mp_module_pkt_t = p_trs_ctrl_pkt;
 
+    TEST_ASSERT_TRUE(m_test_exp_confirm_cnt >=0);
+    m_test_exp_confirm_cnt++;
+
+    /* Unless deferred by the test, the LPN sends the message right away. */
+    if (!m_defer_prepare)
+    {
+        TEST_ASSERT_TRUE(mesh_lpn_subman_data_prepare());
+        helper_pdu_sent_check();
+    }
+}
+
+void mesh_lpn_subman_data_clear(void)
+{
+    m_data_clear_cnt++;
 }
 
 uint16_t mesh_lpn_friend_subscription_size_get(void)
@@ -295,6 +309,8 @@ void setUp(void)
     mesh_lpn_mock_Init();
 
     helper_test_init();
+    m_defer_prepare = false;
+    m_data_clear_cnt = 0;
 }
 
 void tearDown(void)
@@ -566,3 +582,57 @@ void test_mix_add_remove(void)
     helper_untag_add_address_from_pdu();
     helper_trigger_confirm_rx();
 }
+
+void test_coalesce(void)
+{
+    uint32_t i;
+
+    helper_trigger_event(NRF_MESH_EVT_FRIENDSHIP_TERMINATED);
+    helper_trigger_event(NRF_MESH_EVT_FRIENDSHIP_ESTABLISHED);
+
+    /* Test: Changes made before the LPN sends the message go into it */
+    m_defer_prepare = true;
+    for (i = 0; i < PACKET_MESH_TRS_CONTROL_FRIEND_SUBLIST_ADD_REMOVE_ADDRESS_LIST_MAX_COUNT; i++)
+    {
+        mesh_lpn_subman_add_call(i);
+    }
+    TEST_ASSERT_EQUAL(1, helper_pending_confirm_cnt_get());
+
+    /* Test: continue: An addition that was not sent is cancelled by a removal */
+    mesh_lpn_subman_add_call(i);
+    mesh_lpn_subman_remove_call(i);
+
+    TEST_ASSERT_TRUE(mesh_lpn_subman_data_prepare());
+    TEST_ASSERT_EQUAL(TRANSPORT_CONTROL_OPCODE_FRIEND_SUBSCRIPTION_LIST_ADD, mp_module_pkt_t->opcode);
+    TEST_ASSERT_EQUAL(PACKET_MESH_TRS_CONTROL_FRIEND_SUBLIST_ADD_REMOVE_SIZE, mp_module_pkt_t->data_len);
+    helper_pdu_sent_check();
+    for (i = 0; i < PACKET_MESH_TRS_CONTROL_FRIEND_SUBLIST_ADD_REMOVE_ADDRESS_LIST_MAX_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(m_test_addr_list[i].sent);
+    }
+
+    /* Test: continue: Retransmissions don't rebuild the message */
+    TEST_ASSERT_TRUE(mesh_lpn_subman_data_prepare());
+    TEST_ASSERT_EQUAL(PACKET_MESH_TRS_CONTROL_FRIEND_SUBLIST_ADD_REMOVE_SIZE, mp_module_pkt_t->data_len);
+
+    /* Test: continue: Nothing left after the confirm */
+    helper_trigger_confirm_rx();
+    TEST_ASSERT_EQUAL(0, helper_pending_confirm_cnt_get());
+
+    /* Test: continue: A removal of a sent address that is added back before sending is dropped */
+    mesh_lpn_subman_remove_call(0);
+    TEST_ASSERT_EQUAL(1, helper_pending_confirm_cnt_get());
+    mesh_lpn_subman_add_call_keep_sent(0);
+    m_data_clear_cnt = 0;
+    TEST_ASSERT_FALSE(mesh_lpn_subman_data_prepare());
+    TEST_ASSERT_EQUAL(1, m_data_clear_cnt);
+    m_test_exp_confirm_cnt--;
+
+    /* Test: continue: The next change starts a new transaction with the same transaction number */
+    m_defer_prepare = false;
+    mesh_lpn_subman_remove_call(1);
+    helper_trigger_confirm_rx();
+    TEST_ASSERT_EQUAL(0, helper_pending_confirm_cnt_get());
+
+    helper_trigger_event(NRF_MESH_EVT_FRIENDSHIP_TERMINATED);
+}
@@ -0,0 +1,161 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mesh_metrics.h"
+#include "mesh_metrics_internal.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+
+void setUp(void)
+{
+    mesh_metrics_clear();
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_counters(void)
+{
+    uint32_t counters[MESH_METRICS_COUNTER_COUNT];
+    uint32_t expected[MESH_METRICS_COUNTER_COUNT];
+    memset(expected, 0, sizeof(expected));
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, mesh_metrics_counters_get(NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_counters_get(counters));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, counters, MESH_METRICS_COUNTER_COUNT);
+
+    for (uint32_t i = 0; i < MESH_METRICS_COUNTER_COUNT; ++i)
+    {
+        for (uint32_t j = 0; j <= i; ++j)
+        {
+            mesh_metrics_count((mesh_metrics_counter_t) i);
+        }
+        expected[i] = i + 1;
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_counters_get(counters));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, counters, MESH_METRICS_COUNTER_COUNT);
+
+    mesh_metrics_clear();
+    memset(expected, 0, sizeof(expected));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_counters_get(counters));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, counters, MESH_METRICS_COUNTER_COUNT);
+}
+
+void test_histogram_buckets(void)
+{
+    const struct
+    {
+        uint32_t latency_us;
+        uint32_t bucket;
+    } samples[] =
+    {
+        {0, 0},
+        {1, 0},
+        {2, 1},
+        {3, 1},
+        {4, 2},
+        {1023, 9},
+        {1024, 10},
+        {(1u << (MESH_METRICS_HISTOGRAM_BUCKET_COUNT - 1)) - 1, MESH_METRICS_HISTOGRAM_BUCKET_COUNT - 2},
+        {1u << (MESH_METRICS_HISTOGRAM_BUCKET_COUNT - 1), MESH_METRICS_HISTOGRAM_BUCKET_COUNT - 1},
+        {UINT32_MAX, MESH_METRICS_HISTOGRAM_BUCKET_COUNT - 1},
+    };
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(samples); ++i)
+    {
+        mesh_metrics_clear();
+        mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_ACCESS_DISPATCH, samples[i].latency_us);
+
+        mesh_metrics_histogram_data_t data;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_histogram_get(MESH_METRICS_HISTOGRAM_ACCESS_DISPATCH, &data));
+        TEST_ASSERT_EQUAL(1, data.count);
+        TEST_ASSERT_EQUAL(samples[i].latency_us, data.max_us);
+        TEST_ASSERT_EQUAL(samples[i].latency_us, data.sum_us);
+        for (uint32_t j = 0; j < MESH_METRICS_HISTOGRAM_BUCKET_COUNT; ++j)
+        {
+            TEST_ASSERT_EQUAL_MESSAGE((j == samples[i].bucket) ? 1 : 0, data.buckets[j], "Wrong bucket");
+        }
+    }
+}
+
+void test_histogram_stats(void)
+{
+    mesh_metrics_histogram_data_t data;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, mesh_metrics_histogram_get(MESH_METRICS_HISTOGRAM_NET_DECRYPT, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, mesh_metrics_histogram_get(MESH_METRICS_HISTOGRAM_COUNT, &data));
+
+    mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_NET_DECRYPT, 100);
+    mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_NET_DECRYPT, 300);
+    mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_NET_DECRYPT, 200);
+    mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_TRS_DECRYPT, 5000);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_histogram_get(MESH_METRICS_HISTOGRAM_NET_DECRYPT, &data));
+    TEST_ASSERT_EQUAL(3, data.count);
+    TEST_ASSERT_EQUAL(300, data.max_us);
+    TEST_ASSERT_EQUAL(600, data.sum_us);
+    TEST_ASSERT_EQUAL(1, data.buckets[6]);
+    TEST_ASSERT_EQUAL(1, data.buckets[7]);
+    TEST_ASSERT_EQUAL(1, data.buckets[8]);
+
+    /* The sum saturates. */
+    mesh_metrics_latency_add(MESH_METRICS_HISTOGRAM_NET_DECRYPT, UINT32_MAX - 100);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_histogram_get(MESH_METRICS_HISTOGRAM_NET_DECRYPT, &data));
+    TEST_ASSERT_EQUAL(4, data.count);
+    TEST_ASSERT_EQUAL(UINT32_MAX - 100, data.max_us);
+    TEST_ASSERT_EQUAL(UINT32_MAX, data.sum_us);
+
+    /* Other histograms are separate. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_histogram_get(MESH_METRICS_HISTOGRAM_TRS_DECRYPT, &data));
+    TEST_ASSERT_EQUAL(1, data.count);
+    TEST_ASSERT_EQUAL(5000, data.sum_us);
+
+    mesh_metrics_clear();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_metrics_histogram_get(MESH_METRICS_HISTOGRAM_NET_DECRYPT, &data));
+    TEST_ASSERT_EQUAL(0, data.count);
+    TEST_ASSERT_EQUAL(0, data.max_us);
+}
@@ -47,6 +47,7 @@
 
 #include "access.h"
 
+#include "access_mock.h"
 #include "timer_scheduler_mock.h"
 #include "timer_mock.h"
 #include "app_timer_mock.h"
@@ -128,12 +129,15 @@ static void helper_timer_cb_trigger(void)
 /******** Setup and Tear Down ********/
 void setUp(void)
 {
+    access_mock_Init();
     timer_scheduler_mock_Init();
     timer_mock_Init();
 }
 
 void tearDown(void)
 {
+    access_mock_Verify();
+    access_mock_Destroy();
     timer_scheduler_mock_Verify();
     timer_scheduler_mock_Destroy();
     timer_mock_Verify();
@@ -457,3 +461,21 @@ void test_model_timer_is_running(void)
 {
     /* This is implicitly tested as a part of other functionality tests */
 }
+
+void test_model_tx_reserve(void)
+{
+    access_message_rx_t rx_msg;
+    access_message_tx_t tx_msg;
+    uint8_t * p_params;
+
+    memset(&rx_msg, 0, sizeof(rx_msg));
+    memset(&tx_msg, 0, sizeof(tx_msg));
+
+    /* Without an incoming message, the status is published. */
+    access_model_publish_reserve_ExpectAndReturn(1, &tx_msg, &p_params, NRF_SUCCESS);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, model_tx_reserve(1, NULL, &tx_msg, &p_params));
+
+    /* With an incoming message, the status is a reply. Errors are passed through. */
+    access_model_reply_reserve_ExpectAndReturn(1, &rx_msg, &tx_msg, &p_params, NRF_ERROR_NO_MEM);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, model_tx_reserve(1, &rx_msg, &tx_msg, &p_params));
+}
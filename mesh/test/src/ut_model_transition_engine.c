@@ -0,0 +1,445 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "model_transition_engine.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+#include "test_assert.h"
+
+#include "timer_scheduler_mock.h"
+#include "timer_mock.h"
+
+#define CHANNELS_MAX            (64)
+#define BENCHMARK_DELTA         (0xFFFF)
+#define BENCHMARK_TIME_MS       (10000)
+
+typedef struct
+{
+    model_transition_channel_t channel;
+    uint32_t step_count;
+    int32_t value;
+    bool is_complete;
+} test_channel_t;
+
+static timer_event_t * mp_timer;
+static bool m_timer_scheduled;
+static timestamp_t m_now;
+static uint32_t m_timer_reschedules;
+static uint32_t m_timer_timeouts;
+
+static test_channel_t m_channels[CHANNELS_MAX];
+
+/*****************************************************************************
+* Mock functions
+*****************************************************************************/
+static timestamp_t timer_now_cb(int num_calls)
+{
+    return m_now;
+}
+
+static void timer_sch_reschedule_cb(timer_event_t * p_timer, timestamp_t new_timestamp, int num_calls)
+{
+    TEST_ASSERT_TRUE(mp_timer == NULL || mp_timer == p_timer);
+    TEST_ASSERT_NOT_NULL(p_timer->cb);
+    TEST_ASSERT_EQUAL(0, p_timer->interval);
+    mp_timer = p_timer;
+    mp_timer->timestamp = new_timestamp;
+    m_timer_scheduled = true;
+    m_timer_reschedules++;
+}
+
+static void timer_sch_abort_cb(timer_event_t * p_timer, int num_calls)
+{
+    m_timer_scheduled = false;
+}
+
+static bool timer_sch_is_scheduled_cb(const timer_event_t * p_timer, int num_calls)
+{
+    return m_timer_scheduled;
+}
+
+static void channel_cb(model_transition_channel_t * p_channel, int32_t value, bool is_complete)
+{
+    test_channel_t * p_test = PARENT_BY_FIELD_GET(test_channel_t, channel, p_channel);
+
+    TEST_ASSERT_FALSE(p_test->is_complete);
+    TEST_ASSERT_EQUAL(is_complete, !model_transition_engine_is_active(p_channel));
+    p_test->step_count++;
+    p_test->value = value;
+    p_test->is_complete = is_complete;
+}
+
+static void channel_abort_cb(model_transition_channel_t * p_channel, int32_t value, bool is_complete)
+{
+    channel_cb(p_channel, value, is_complete);
+
+    /* Stop the channel after it, which is the one started right before it. */
+    model_transition_engine_abort(&(PARENT_BY_FIELD_GET(test_channel_t, channel, p_channel) - 1)->channel);
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+/* Moves the clock forward, firing the engine timer on its way when it's due. */
+static void clock_set(timestamp_t time)
+{
+    while (m_timer_scheduled && !TIMER_OLDER_THAN(time, mp_timer->timestamp))
+    {
+        m_now = mp_timer->timestamp;
+        m_timer_scheduled = false;
+        m_timer_timeouts++;
+        mp_timer->cb(m_now, mp_timer->p_context);
+    }
+    m_now = time;
+}
+
+/* Moves the clock forward in steps that stay within the timestamp range. */
+static void clock_advance_ms(uint32_t time_ms)
+{
+    while (time_ms > 60000)
+    {
+        clock_set(m_now + MS_TO_US(60000));
+        time_ms -= 60000;
+    }
+    clock_set(m_now + MS_TO_US(time_ms));
+}
+
+static void channel_start(uint32_t index, int32_t delta, uint32_t time_ms, uint32_t minimum_step_ms, bool is_move)
+{
+    model_transition_params_t params =
+    {
+        .delta = delta,
+        .transition_time_ms = time_ms,
+        .minimum_step_ms = minimum_step_ms,
+        .is_move = is_move
+    };
+
+    m_channels[index].step_count = 0;
+    m_channels[index].value = 0;
+    m_channels[index].is_complete = false;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, model_transition_engine_start(&m_channels[index].channel, &params));
+    TEST_ASSERT_TRUE(model_transition_engine_is_active(&m_channels[index].channel));
+}
+
+static uint64_t time_ns_get(void)
+{
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    timer_scheduler_mock_Init();
+    timer_mock_Init();
+
+    timer_now_StubWithCallback(timer_now_cb);
+    timer_sch_reschedule_StubWithCallback(timer_sch_reschedule_cb);
+    timer_sch_abort_StubWithCallback(timer_sch_abort_cb);
+    timer_sch_is_scheduled_StubWithCallback(timer_sch_is_scheduled_cb);
+
+    m_now = 0x1000;
+    m_timer_reschedules = 0;
+    m_timer_timeouts = 0;
+
+    memset(m_channels, 0, sizeof(m_channels));
+    for (uint32_t i = 0; i < CHANNELS_MAX; i++)
+    {
+        m_channels[i].channel.cb = channel_cb;
+    }
+}
+
+void tearDown(void)
+{
+    for (uint32_t i = 0; i < CHANNELS_MAX; i++)
+    {
+        model_transition_engine_abort(&m_channels[i].channel);
+    }
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    timer_scheduler_mock_Verify();
+    timer_scheduler_mock_Destroy();
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_invalid_params(void)
+{
+    model_transition_params_t params = {.delta = 1, .transition_time_ms = 1};
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, model_transition_engine_start(NULL, &params));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, model_transition_engine_start(&m_channels[0].channel, NULL));
+    m_channels[0].channel.cb = NULL;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, model_transition_engine_start(&m_channels[0].channel, &params));
+    m_channels[0].channel.cb = channel_cb;
+
+    params.delta = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, model_transition_engine_start(&m_channels[0].channel, &params));
+    params.delta = 1;
+    params.transition_time_ms = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, model_transition_engine_start(&m_channels[0].channel, &params));
+    params.transition_time_ms = UINT32_MAX;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, model_transition_engine_start(&m_channels[0].channel, &params));
+
+    TEST_ASSERT_FALSE(model_transition_engine_is_active(&m_channels[0].channel));
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+}
+
+void test_transition(void)
+{
+    const struct
+    {
+        int32_t delta;
+        uint32_t time_ms;
+        uint32_t minimum_step_ms;
+        uint32_t expected_steps;
+    } vector[] =
+    {
+        /* One step per value change when the steps are long enough: */
+        {100, 1000, 5, 100},
+        {-7, 1001, 5, 7},
+        /* Limited by the minimum step time: */
+        {10000, 2000, 5, 400},
+        {INT32_MIN, 1000, 0, 1000 / MODEL_TRANSITION_ENGINE_TICK_MIN_MS},
+        {INT32_MAX, 1000, 20, 50},
+        /* Long transitions step at least every minute: */
+        {1, 10 * 60 * 60 * 1000, 0, 600},
+    };
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(vector); i++)
+    {
+        channel_start(0, vector[i].delta, vector[i].time_ms, vector[i].minimum_step_ms, false);
+
+        clock_advance_ms(vector[i].time_ms / 2);
+        TEST_ASSERT_UINT32_WITHIN(1, vector[i].time_ms / 2, model_transition_engine_elapsed_ms_get(&m_channels[0].channel));
+
+        /* Not done until the very end: */
+        clock_advance_ms(vector[i].time_ms - vector[i].time_ms / 2 - 1);
+        clock_set(m_now + MS_TO_US(1) - 1);
+        TEST_ASSERT_FALSE(m_channels[0].is_complete);
+        TEST_ASSERT_EQUAL(vector[i].expected_steps - 1, m_channels[0].step_count);
+
+        clock_set(m_now + 1);
+        TEST_ASSERT_TRUE(m_channels[0].is_complete);
+        TEST_ASSERT_EQUAL(vector[i].expected_steps, m_channels[0].step_count);
+        TEST_ASSERT_EQUAL(vector[i].delta, m_channels[0].value);
+        TEST_ASSERT_EQUAL(0, model_transition_engine_elapsed_ms_get(&m_channels[0].channel));
+        TEST_ASSERT_FALSE(m_timer_scheduled);
+    }
+}
+
+void test_transition_linear(void)
+{
+    /* Every intermediate value is within one of the exact linear interpolation. */
+    timestamp_t start = m_now;
+    channel_start(0, -1234, 777, 3, false);
+
+    while (!m_channels[0].is_complete)
+    {
+        clock_set(mp_timer->timestamp);
+        int64_t expected = (-1234ll * (int64_t) (m_now - start)) / MS_TO_US(777ll);
+        TEST_ASSERT_INT_WITHIN(1, expected, m_channels[0].value);
+    }
+}
+
+void test_move(void)
+{
+    channel_start(0, 300, 1000, 5, true);
+
+    for (uint32_t i = 1; i <= 5; i++)
+    {
+        clock_set(m_now + MS_TO_US(1000));
+        TEST_ASSERT_FALSE(m_channels[0].is_complete);
+        TEST_ASSERT_EQUAL(300 * i, m_channels[0].value);
+        TEST_ASSERT_EQUAL(1000 * i, model_transition_engine_elapsed_ms_get(&m_channels[0].channel));
+    }
+    TEST_ASSERT_EQUAL(5 * 200, m_channels[0].step_count);
+
+    model_transition_engine_abort(&m_channels[0].channel);
+    TEST_ASSERT_FALSE(model_transition_engine_is_active(&m_channels[0].channel));
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+    clock_set(m_now + MS_TO_US(1000));
+    TEST_ASSERT_EQUAL(5 * 200, m_channels[0].step_count);
+}
+
+void test_restart(void)
+{
+    channel_start(0, 1000, 1000, 5, false);
+    clock_set(m_now + MS_TO_US(500));
+    TEST_ASSERT_EQUAL(500, m_channels[0].value);
+
+    /* Restarting resets the value and the timing. */
+    timestamp_t start = m_now;
+    channel_start(0, -10, 100, 5, false);
+    clock_set(start + MS_TO_US(100));
+    TEST_ASSERT_TRUE(m_channels[0].is_complete);
+    TEST_ASSERT_EQUAL(-10, m_channels[0].value);
+    TEST_ASSERT_EQUAL(10, m_channels[0].step_count);
+}
+
+void test_follower(void)
+{
+    /* A channel following the larger of two values, as for the CTL temperature and delta UV: */
+    timestamp_t start = m_now;
+    channel_start(0, 19200, 2000, 5, false);
+
+    model_transition_follower_t temperature32;
+    model_transition_follower_t delta_uv;
+    model_transition_engine_follower_start(&temperature32, &m_channels[0].channel, 19200 * 65535);
+    model_transition_engine_follower_start(&delta_uv, &m_channels[0].channel, -321);
+    TEST_ASSERT_EQUAL(0, model_transition_engine_follower_value_get(&delta_uv, &m_channels[0].channel));
+
+    /* Every intermediate value is within one step of the exact linear interpolation, also when
+     * some steps were not read: */
+    uint32_t reads = 0;
+    while (!m_channels[0].is_complete)
+    {
+        clock_set(mp_timer->timestamp);
+        if ((m_channels[0].step_count % 3) == 0)
+        {
+            int64_t elapsed_us = m_now - start;
+            int64_t expected = (19200ll * 65535 * elapsed_us) / MS_TO_US(2000ll);
+            TEST_ASSERT_INT_WITHIN(65535 * 48, expected,
+                                   model_transition_engine_follower_value_get(&temperature32, &m_channels[0].channel));
+            expected = (-321ll * elapsed_us) / MS_TO_US(2000ll);
+            TEST_ASSERT_INT_WITHIN(1, expected, model_transition_engine_follower_value_get(&delta_uv, &m_channels[0].channel));
+            reads++;
+        }
+    }
+    TEST_ASSERT_TRUE(reads > 100);
+
+    /* Exact at the end: */
+    TEST_ASSERT_EQUAL(19200 * 65535, model_transition_engine_follower_value_get(&temperature32, &m_channels[0].channel));
+    TEST_ASSERT_EQUAL(-321, model_transition_engine_follower_value_get(&delta_uv, &m_channels[0].channel));
+
+    /* Following a move is not supported: */
+    channel_start(0, 100, 1000, 5, true);
+    TEST_NRF_MESH_ASSERT_EXPECT(model_transition_engine_follower_start(&delta_uv, &m_channels[0].channel, 10));
+}
+
+void test_shared_timer(void)
+{
+    /* Channels with the same step interval wake up together, whatever their deltas are. */
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        channel_start(i, 1000 + i * 100, 1000, 20, false);
+    }
+
+    clock_set(m_now + MS_TO_US(1000));
+    TEST_ASSERT_EQUAL(1000 / 20, m_timer_timeouts);
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        TEST_ASSERT_TRUE(m_channels[i].is_complete);
+        TEST_ASSERT_EQUAL(1000 + i * 100, m_channels[i].value);
+        TEST_ASSERT_EQUAL(1000 / 20, m_channels[i].step_count);
+    }
+
+    /* Ticks closer than MODEL_TRANSITION_ENGINE_COALESCE_US are merged. */
+    m_timer_timeouts = 0;
+    channel_start(0, 10, 100, 10, false);
+    clock_set(m_now + MODEL_TRANSITION_ENGINE_COALESCE_US / 2);
+    channel_start(1, 10, 100, 10, false);
+    clock_set(m_now + MS_TO_US(100));
+    TEST_ASSERT_EQUAL(10, m_timer_timeouts);
+    TEST_ASSERT_TRUE(m_channels[0].is_complete);
+    TEST_ASSERT_TRUE(m_channels[1].is_complete);
+}
+
+void test_abort_from_callback(void)
+{
+    channel_start(0, 10, 100, 10, false);
+    m_channels[1].channel.cb = channel_abort_cb;
+    channel_start(1, 10, 100, 10, false);
+
+    /* Channel 1 is processed first, and stops channel 0 before its turn. */
+    clock_set(m_now + MS_TO_US(10));
+    TEST_ASSERT_EQUAL(1, m_channels[1].step_count);
+    TEST_ASSERT_EQUAL(0, m_channels[0].step_count);
+    TEST_ASSERT_FALSE(model_transition_engine_is_active(&m_channels[0].channel));
+
+    clock_set(m_now + MS_TO_US(90));
+    TEST_ASSERT_TRUE(m_channels[1].is_complete);
+    TEST_ASSERT_EQUAL(0, m_channels[0].step_count);
+}
+
+/* Measures the engine cost per timer tick with a varying number of concurrent transitions. Each
+ * channel steps at the minimum interval, so every tick steps every channel. */
+void test_benchmark_tick(void)
+{
+    const uint32_t channel_counts[] = {1, 16, 64};
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(channel_counts); i++)
+    {
+        for (uint32_t j = 0; j < channel_counts[i]; j++)
+        {
+            channel_start(j, BENCHMARK_DELTA - j, BENCHMARK_TIME_MS, 0, false);
+        }
+
+        m_timer_timeouts = 0;
+        uint64_t start_ns = time_ns_get();
+        clock_set(m_now + MS_TO_US(BENCHMARK_TIME_MS));
+        uint64_t duration_ns = time_ns_get() - start_ns;
+
+        TEST_ASSERT_EQUAL(BENCHMARK_TIME_MS / MODEL_TRANSITION_ENGINE_TICK_MIN_MS, m_timer_timeouts);
+        for (uint32_t j = 0; j < channel_counts[i]; j++)
+        {
+            TEST_ASSERT_TRUE(m_channels[j].is_complete);
+            TEST_ASSERT_EQUAL(BENCHMARK_DELTA - j, m_channels[j].value);
+        }
+
+        printf("model_transition_engine: %2u channels: %5u ns per tick, %4u ns per channel step\n",
+               channel_counts[i],
+               (uint32_t) (duration_ns / m_timer_timeouts),
+               (uint32_t) (duration_ns / (m_timer_timeouts * channel_counts[i])));
+    }
+}
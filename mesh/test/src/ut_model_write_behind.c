@@ -0,0 +1,344 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "model_write_behind.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "utils.h"
+#include "timer.h"
+
+#include "mesh_config_entry_mock.h"
+#include "nrf_mesh_events_mock.h"
+#include "timer_scheduler_mock.h"
+#include "timer_mock.h"
+
+#define TEST_FILE_ID            (0x0010)
+#define TEST_RECORD_BASE        (0x2500)
+#define TEST_ENTRY_COUNT        (MODEL_WRITE_BEHIND_SLOT_COUNT + 1)
+#define TEST_ENTRY(i)           ((mesh_config_entry_id_t) {TEST_FILE_ID, TEST_RECORD_BASE + (i)})
+
+#define TRANSITION_STEPS        (100)
+
+/* Level rejected by the test entry setter. */
+#define LEVEL_INVALID           (INT16_MIN)
+
+static nrf_mesh_evt_handler_t * mp_evt_handler;
+static timer_event_t * mp_timer;
+static bool m_timer_scheduled;
+static timestamp_t m_now;
+
+/* State owner copy of the test entries. */
+static int16_t m_applied[TEST_ENTRY_COUNT];
+/* Persistent copy of the test entries, and the number of writes to it. */
+static int16_t m_stored[TEST_ENTRY_COUNT];
+static uint32_t m_write_count;
+
+/*****************************************************************************
+* Mock functions
+*****************************************************************************/
+static timestamp_t timer_now_cb(int num_calls)
+{
+    return m_now;
+}
+
+static void timer_sch_reschedule_cb(timer_event_t * p_timer, timestamp_t new_timestamp, int num_calls)
+{
+    TEST_ASSERT_NOT_NULL(p_timer->cb);
+    TEST_ASSERT_EQUAL(0, p_timer->interval);
+    mp_timer = p_timer;
+    mp_timer->timestamp = new_timestamp;
+    m_timer_scheduled = true;
+}
+
+static void timer_sch_abort_cb(timer_event_t * p_timer, int num_calls)
+{
+    m_timer_scheduled = false;
+}
+
+static bool timer_sch_is_scheduled_cb(const timer_event_t * p_timer, int num_calls)
+{
+    return m_timer_scheduled;
+}
+
+static void nrf_mesh_evt_handler_add_cb(nrf_mesh_evt_handler_t * p_handler, int num_calls)
+{
+    mp_evt_handler = p_handler;
+}
+
+static uint32_t mesh_config_entry_set_deferred_cb(mesh_config_entry_id_t id, const void * p_entry, int num_calls)
+{
+    TEST_ASSERT_EQUAL(TEST_FILE_ID, id.file);
+    TEST_ASSERT_TRUE(id.record - TEST_RECORD_BASE < TEST_ENTRY_COUNT);
+    if (*(const int16_t *) p_entry == LEVEL_INVALID)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+    m_applied[id.record - TEST_RECORD_BASE] = *(const int16_t *) p_entry;
+    return NRF_SUCCESS;
+}
+
+static uint32_t mesh_config_entry_set_cb(mesh_config_entry_id_t id, const void * p_entry, int num_calls)
+{
+    uint32_t status = mesh_config_entry_set_deferred_cb(id, p_entry, num_calls);
+    if (status == NRF_SUCCESS)
+    {
+        m_stored[id.record - TEST_RECORD_BASE] = *(const int16_t *) p_entry;
+        m_write_count++;
+    }
+    return status;
+}
+
+static uint32_t mesh_config_entry_get_cb(mesh_config_entry_id_t id, void * p_entry, int num_calls)
+{
+    TEST_ASSERT_EQUAL(TEST_FILE_ID, id.file);
+    TEST_ASSERT_TRUE(id.record - TEST_RECORD_BASE < TEST_ENTRY_COUNT);
+    *(int16_t *) p_entry = m_applied[id.record - TEST_RECORD_BASE];
+    return NRF_SUCCESS;
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+/* Moves the clock forward, firing the write-behind timer on its way if it's due. */
+static void clock_set(timestamp_t time)
+{
+    while (m_timer_scheduled && !TIMER_OLDER_THAN(time, mp_timer->timestamp))
+    {
+        m_now = mp_timer->timestamp;
+        m_timer_scheduled = false;
+        mp_timer->cb(m_now, mp_timer->p_context);
+    }
+    m_now = time;
+}
+
+static void level_set(uint32_t entry, int16_t level)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, model_write_behind_set(TEST_ENTRY(entry), &level, sizeof(level)));
+}
+
+/* Runs a linear level transition, setting the level once per step. */
+static void level_transition_run(int16_t start, int16_t target, uint32_t step_time_us)
+{
+    for (uint32_t i = 1; i <= TRANSITION_STEPS; i++)
+    {
+        clock_set(m_now + step_time_us);
+        level_set(0, start + (int16_t) (((int32_t) (target - start) * (int32_t) i) / TRANSITION_STEPS));
+    }
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    mesh_config_entry_mock_Init();
+    nrf_mesh_events_mock_Init();
+    timer_scheduler_mock_Init();
+    timer_mock_Init();
+
+    timer_now_StubWithCallback(timer_now_cb);
+    timer_sch_reschedule_StubWithCallback(timer_sch_reschedule_cb);
+    timer_sch_abort_StubWithCallback(timer_sch_abort_cb);
+    timer_sch_is_scheduled_StubWithCallback(timer_sch_is_scheduled_cb);
+    mesh_config_entry_set_StubWithCallback(mesh_config_entry_set_cb);
+    mesh_config_entry_set_deferred_StubWithCallback(mesh_config_entry_set_deferred_cb);
+    mesh_config_entry_get_StubWithCallback(mesh_config_entry_get_cb);
+    nrf_mesh_evt_handler_add_StubWithCallback(nrf_mesh_evt_handler_add_cb);
+
+    mp_evt_handler = NULL;
+    mp_timer = NULL;
+    m_timer_scheduled = false;
+    m_now = 1000;
+    memset(m_applied, 0, sizeof(m_applied));
+    memset(m_stored, 0, sizeof(m_stored));
+    m_write_count = 0;
+
+    model_write_behind_init();
+    TEST_ASSERT_NOT_NULL(mp_evt_handler);
+}
+
+void tearDown(void)
+{
+    mesh_config_entry_mock_Verify();
+    mesh_config_entry_mock_Destroy();
+    nrf_mesh_events_mock_Verify();
+    nrf_mesh_events_mock_Destroy();
+    timer_scheduler_mock_Verify();
+    timer_scheduler_mock_Destroy();
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_level_transition(void)
+{
+    /* 100 steps over 2 seconds: a direct write per step would store the level 100 times. Deferred,
+     * only the final level is stored, once the level has been stable for the debounce delay. */
+    level_transition_run(0, 10000, MS_TO_US(20));
+    TEST_ASSERT_EQUAL(0, m_write_count);
+    TEST_ASSERT_EQUAL(10000, m_applied[0]);
+
+    int16_t level;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, model_write_behind_get(TEST_ENTRY(0), &level, sizeof(level)));
+    TEST_ASSERT_EQUAL(10000, level);
+
+    clock_set(m_now + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MS) - 1);
+    TEST_ASSERT_EQUAL(0, m_write_count);
+    clock_set(m_now + 1);
+    TEST_ASSERT_EQUAL(1, m_write_count);
+    TEST_ASSERT_EQUAL(10000, m_stored[0]);
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+}
+
+void test_level_transition_slow(void)
+{
+    /* 100 steps over 10 seconds: with the default delays, the level is written once when it has
+     * been held back for MODEL_WRITE_BEHIND_DELAY_MAX_MS, and once after it settles. */
+    level_transition_run(0, -10000, MS_TO_US(100));
+    clock_set(m_now + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MAX_MS));
+
+    TEST_ASSERT_EQUAL(2, m_write_count);
+    TEST_ASSERT_EQUAL(-10000, m_stored[0]);
+}
+
+void test_unchanged_value(void)
+{
+    /* Setting the stored value again doesn't allocate anything. */
+    level_set(0, 0);
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    /* Returning to the stored value still writes once, as the pending value has to be replaced. */
+    level_set(0, 100);
+    level_set(0, 100);
+    level_set(0, 0);
+    clock_set(m_now + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MS));
+    TEST_ASSERT_EQUAL(1, m_write_count);
+    TEST_ASSERT_EQUAL(0, m_stored[0]);
+}
+
+void test_slots_exhausted(void)
+{
+    for (uint32_t i = 0; i < MODEL_WRITE_BEHIND_SLOT_COUNT; i++)
+    {
+        level_set(i, 1);
+    }
+    TEST_ASSERT_EQUAL(0, m_write_count);
+
+    /* No slot left, goes directly to mesh config: */
+    level_set(MODEL_WRITE_BEHIND_SLOT_COUNT, 1);
+    TEST_ASSERT_EQUAL(1, m_write_count);
+    TEST_ASSERT_EQUAL(1, m_stored[MODEL_WRITE_BEHIND_SLOT_COUNT]);
+
+    clock_set(m_now + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MS));
+    TEST_ASSERT_EQUAL(TEST_ENTRY_COUNT, m_write_count);
+
+    uint64_t too_large = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH,
+                      model_write_behind_set(TEST_ENTRY(0), &too_large, MODEL_WRITE_BEHIND_VALUE_SIZE_MAX + 1));
+}
+
+void test_flush_and_clear(void)
+{
+    level_set(0, 10);
+    level_set(1, 20);
+    model_write_behind_flush();
+    TEST_ASSERT_EQUAL(2, m_write_count);
+    TEST_ASSERT_EQUAL(10, m_stored[0]);
+    TEST_ASSERT_EQUAL(20, m_stored[1]);
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    /* Cleared values are never written, and reads fall back to the state owner. */
+    level_set(0, 30);
+    model_write_behind_clear();
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    int16_t level;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, model_write_behind_get(TEST_ENTRY(0), &level, sizeof(level)));
+    TEST_ASSERT_EQUAL(30, level);
+    clock_set(m_now + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MAX_MS));
+    TEST_ASSERT_EQUAL(2, m_write_count);
+    TEST_ASSERT_EQUAL(10, m_stored[0]);
+}
+
+void test_invalid_value(void)
+{
+    int16_t level = LEVEL_INVALID;
+
+    /* The setter rejects the value right away, and no slot is taken for it. */
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, model_write_behind_set(TEST_ENTRY(0), &level, sizeof(level)));
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+    TEST_ASSERT_EQUAL(0, m_applied[0]);
+
+    /* A rejected value doesn't replace the pending one. */
+    level_set(0, 10);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, model_write_behind_set(TEST_ENTRY(0), &level, sizeof(level)));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, model_write_behind_get(TEST_ENTRY(0), &level, sizeof(level)));
+    TEST_ASSERT_EQUAL(10, level);
+    TEST_ASSERT_EQUAL(10, m_applied[0]);
+
+    clock_set(m_now + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MS));
+    TEST_ASSERT_EQUAL(1, m_write_count);
+    TEST_ASSERT_EQUAL(10, m_stored[0]);
+}
+
+void test_power_down(void)
+{
+    level_transition_run(0, 5000, MS_TO_US(20));
+    TEST_ASSERT_EQUAL(0, m_write_count);
+
+    /* The timer scheduler is stopped before mesh config powers down, so the pending value must be
+     * written from the power-down event. */
+    nrf_mesh_evt_t evt = {.type = NRF_MESH_EVT_CONFIG_POWER_DOWN};
+    mp_evt_handler->evt_cb(&evt);
+    TEST_ASSERT_EQUAL(1, m_write_count);
+    TEST_ASSERT_EQUAL(5000, m_stored[0]);
+
+    /* Later changes are written directly, and don't touch the timer scheduler. */
+    timer_sch_reschedule_StubWithCallback(NULL);
+    timer_sch_abort_StubWithCallback(NULL);
+    level_set(0, 6000);
+    TEST_ASSERT_EQUAL(2, m_write_count);
+    model_write_behind_flush();
+    model_write_behind_clear();
+}
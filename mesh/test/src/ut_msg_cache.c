@@ -181,3 +181,117 @@ void test_clear(void)
     msg_cache_clear();
     TEST_ASSERT_EQUAL(false, msg_cache_entry_exists(src, seq));
 }
+
+/********************************************/
+
+#define TEST_PDU_LEN    (29)
+
+static void pdu_build(uint8_t * p_pdu, uint32_t index)
+{
+    for (uint32_t i = 0; i < TEST_PDU_LEN; ++i)
+    {
+        p_pdu[i] = (uint8_t) (index * 31 + i * 7);
+    }
+}
+
+void test_pdu_cache_add(void)
+{
+    uint8_t pdu[TEST_PDU_LEN];
+    pdu_build(pdu, 0);
+
+    TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+    msg_cache_pdu_add(pdu, TEST_PDU_LEN);
+    TEST_ASSERT_TRUE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+
+    /* Same contents with another IVI and NID */
+    pdu[0] ^= 0x01;
+    TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+    pdu[0] ^= 0x01;
+
+    /* Any other octet changed, e.g. the obfuscated TTL after a relay hop */
+    pdu[1] ^= 0x01;
+    TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+    pdu[1] ^= 0x01;
+
+    /* Shorter PDU with the same start */
+    TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN - 1));
+    TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, 0));
+
+    /* Both caches are independent */
+    TEST_ASSERT_TRUE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+    TEST_ASSERT_FALSE(msg_cache_entry_exists(0x0000, 0));
+}
+
+void test_pdu_cache_interleaved_bearers(void)
+{
+    /* The same PDUs arrive on the advertising bearer and from a proxy client, in a different order
+     * and with the advertiser retransmitting some of them. Only the first copy of each PDU should
+     * get through to decryption. */
+    static const uint8_t adv_stream[] = {0, 1, 0, 2, 3, 1, 4, 2, 5};
+    static const uint8_t gatt_stream[] = {1, 0, 3, 2, 5, 4, 6, 6, 0};
+    bool processed[7] = {false};
+    uint32_t decrypt_count = 0;
+    uint32_t dropped_count = 0;
+
+    for (uint32_t i = 0; i < sizeof(adv_stream) + sizeof(gatt_stream); ++i)
+    {
+        const uint8_t * p_stream = (i & 1) ? gatt_stream : adv_stream;
+        uint32_t index = p_stream[i / 2];
+        uint8_t pdu[TEST_PDU_LEN];
+        pdu_build(pdu, index);
+
+        if (msg_cache_pdu_exists(pdu, TEST_PDU_LEN))
+        {
+            TEST_ASSERT_TRUE(processed[index]);
+            dropped_count++;
+        }
+        else
+        {
+            TEST_ASSERT_FALSE(processed[index]);
+            processed[index] = true;
+            decrypt_count++;
+            msg_cache_pdu_add(pdu, TEST_PDU_LEN);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(7, decrypt_count);
+    TEST_ASSERT_EQUAL(sizeof(adv_stream) + sizeof(gatt_stream) - 7, dropped_count);
+}
+
+void test_pdu_cache_overflow(void)
+{
+    uint8_t pdu[TEST_PDU_LEN];
+
+    for (uint32_t i = 0; i < MSG_CACHE_PDU_ENTRY_COUNT; ++i)
+    {
+        pdu_build(pdu, i);
+        TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+        msg_cache_pdu_add(pdu, TEST_PDU_LEN);
+    }
+
+    for (uint32_t i = 0; i < MSG_CACHE_PDU_ENTRY_COUNT; ++i)
+    {
+        pdu_build(pdu, i);
+        TEST_ASSERT_TRUE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+    }
+
+    /* overflow */
+    pdu_build(pdu, MSG_CACHE_PDU_ENTRY_COUNT);
+    msg_cache_pdu_add(pdu, TEST_PDU_LEN);
+    TEST_ASSERT_TRUE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+
+    /* first entry should no longer be valid */
+    pdu_build(pdu, 0);
+    TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+}
+
+void test_pdu_cache_clear(void)
+{
+    uint8_t pdu[TEST_PDU_LEN];
+    pdu_build(pdu, 0);
+
+    msg_cache_pdu_add(pdu, TEST_PDU_LEN);
+    TEST_ASSERT_TRUE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+    msg_cache_clear();
+    TEST_ASSERT_FALSE(msg_cache_pdu_exists(pdu, TEST_PDU_LEN));
+}
@@ -112,6 +112,8 @@ void setUp(void)
     mesh_lpn_mock_Init();
 
     core_tx_packet_alloc_StubWithCallback(core_tx_packet_alloc_mock);
+    msg_cache_pdu_exists_IgnoreAndReturn(false);
+    msg_cache_pdu_add_Ignore();
 }
 
 void tearDown(void)
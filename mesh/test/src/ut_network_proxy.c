@@ -250,7 +250,9 @@ static void network_packet_in_Trigger(nrf_mesh_rx_source_t source)
     nrf_mesh_rx_address_get_ExpectAnyArgsAndReturn(false); // for src
     nrf_mesh_rx_address_get_ExpectAnyArgsAndReturn(false); // for dst
 
+    msg_cache_pdu_exists_ExpectAndReturn(net_packet.pdu, 18, false);
     msg_cache_entry_add_ExpectAnyArgs();
+    msg_cache_pdu_add_Expect(net_packet.pdu, 18);
 
     network_packet_in(net_packet.pdu, 18, &rx_meta);
 
@@ -259,6 +261,24 @@ static void network_packet_in_Trigger(nrf_mesh_rx_source_t source)
     bearer_selector_mock_queue_Verify();
 }
 
+static void network_packet_in_duplicate_Trigger(nrf_mesh_rx_source_t source)
+{
+    packet_mesh_net_packet_t net_packet;
+    memset(&net_packet, 0xAB, sizeof(net_packet));
+
+    nrf_mesh_rx_metadata_t rx_meta;
+    rx_meta.source = source;
+
+    /* Nothing but the cache lookup is expected, the copy must not reach decryption. */
+    msg_cache_pdu_exists_ExpectAndReturn(net_packet.pdu, 18, true);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, network_packet_in(net_packet.pdu, 18, &rx_meta));
+
+    net_packet_decrypt_mock_queue_Verify();
+    net_metadata_mock_queue_Verify();
+    bearer_selector_mock_queue_Verify();
+}
+
 /*****************************************************************************
 * Test functions
 *****************************************************************************/
@@ -291,3 +311,21 @@ void test_relay_from_proxy(void)
     proxy_is_enabled_IgnoreAndReturn(false);
     network_packet_in_Trigger(NRF_MESH_RX_SOURCE_GATT);
 }
+
+void test_duplicates_across_bearers(void)
+{
+    core_tx_bearer_selector_t bearer_selector = CORE_TX_BEARER_TYPE_ALLOW_ALL & ~CORE_TX_BEARER_TYPE_LOCAL;
+    proxy_is_enabled_IgnoreAndReturn(true);
+
+    /* Advertiser first, then the proxy client and the advertiser retransmission */
+    relay_Expect(bearer_selector);
+    network_packet_in_Trigger(NRF_MESH_RX_SOURCE_SCANNER);
+    network_packet_in_duplicate_Trigger(NRF_MESH_RX_SOURCE_GATT);
+    network_packet_in_duplicate_Trigger(NRF_MESH_RX_SOURCE_SCANNER);
+
+    /* Proxy client first, then the advertiser and the proxy client again */
+    relay_Expect(bearer_selector);
+    network_packet_in_Trigger(NRF_MESH_RX_SOURCE_GATT);
+    network_packet_in_duplicate_Trigger(NRF_MESH_RX_SOURCE_SCANNER);
+    network_packet_in_duplicate_Trigger(NRF_MESH_RX_SOURCE_GATT);
+}
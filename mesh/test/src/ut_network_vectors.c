@@ -424,6 +424,9 @@ void setUp(void)
     net_state_init_Expect();
     net_beacon_init_Expect();
     network_init(&init_params);
+
+    msg_cache_pdu_exists_IgnoreAndReturn(false);
+    msg_cache_pdu_add_Ignore();
 }
 
 void tearDown(void)
@@ -0,0 +1,554 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_mesh_prov_queue.h"
+#include "prov_keypool.h"
+#include "test_assert.h"
+#include "utils.h"
+
+#include "nrf_mesh_prov_mock.h"
+#include "nrf_mesh_prov_bearer_adv_mock.h"
+#include "nrf_mesh_utils_mock.h"
+#include "prov_utils_mock.h"
+#include "bearer_event_mock.h"
+#include "timer_mock.h"
+#include "timer_scheduler_mock.h"
+
+#define TEST_FLAG 5
+
+/* Simulated provisioning timing. The CPU is shared by all links, the protocol time is spent on air. */
+#define SIM_KEYGEN_US       400000  /**< P-256 keypair generation. */
+#define SIM_ECDH_US         400000  /**< Shared secret calculation. */
+#define SIM_ECDH_AT_US     1000000  /**< Session time until the public keys have been exchanged. */
+#define SIM_FINISH_US      2000000  /**< Session time from the shared secret to the link close. */
+#define SIM_DEVICE_COUNT   NRF_MESH_PROV_QUEUE_LENGTH
+
+typedef enum
+{
+    SESSION_IDLE,
+    SESSION_KEY_EXCHANGE,
+    SESSION_FINISHING,
+} session_state_t;
+
+typedef struct
+{
+    nrf_mesh_prov_ctx_t * p_ctx;
+    session_state_t state;
+    timestamp_t next_at;
+    uint8_t uuid[NRF_MESH_UUID_SIZE];
+} session_t;
+
+static nrf_mesh_prov_evt_handler_cb_t m_prov_evt_handler;
+static nrf_mesh_prov_ctx_t * mp_contexts[NRF_MESH_PROV_QUEUE_LINK_COUNT];
+static uint32_t m_context_count;
+static bearer_event_flag_callback_t m_available_flag_cb;
+static bool m_available_pending;
+static timer_event_t * mp_timer;
+static bool m_timer_scheduled;
+static timestamp_t m_timer_at;
+static timestamp_t m_now;
+static uint32_t m_keys_generated;
+static session_t m_sessions[NRF_MESH_PROV_QUEUE_LINK_COUNT];
+static uint32_t m_link_closed_events;
+static nrf_mesh_prov_provisioning_data_t m_prov_data;
+
+/*****************************************************************************
+* Mocked functions
+*****************************************************************************/
+static uint32_t nrf_mesh_prov_init_cb(nrf_mesh_prov_ctx_t * p_ctx,
+                                      const uint8_t * p_public_key,
+                                      const uint8_t * p_private_key,
+                                      const nrf_mesh_prov_oob_caps_t * p_caps,
+                                      nrf_mesh_prov_evt_handler_cb_t event_handler,
+                                      int calls)
+{
+    TEST_ASSERT_NOT_NULL(p_public_key);
+    TEST_ASSERT_NOT_NULL(p_private_key);
+    m_prov_evt_handler = event_handler;
+    if (m_context_count < NRF_MESH_PROV_QUEUE_LINK_COUNT)
+    {
+        mp_contexts[m_context_count++] = p_ctx;
+    }
+    return NRF_SUCCESS;
+}
+
+static bearer_event_flag_t bearer_event_flag_add_cb(bearer_event_flag_callback_t cb, int calls)
+{
+    m_available_flag_cb = cb;
+    return TEST_FLAG;
+}
+
+static void bearer_event_flag_set_cb(bearer_event_flag_t flag, int calls)
+{
+    TEST_ASSERT_EQUAL(TEST_FLAG, flag);
+    m_available_pending = true;
+}
+
+static timestamp_t timer_now_cb(int calls)
+{
+    return m_now;
+}
+
+static void timer_sch_reschedule_cb(timer_event_t * p_timer_evt, timestamp_t new_timestamp, int calls)
+{
+    mp_timer = p_timer_evt;
+    m_timer_scheduled = true;
+    m_timer_at = new_timestamp;
+}
+
+static uint32_t prov_utils_keys_generate_cb(uint8_t * p_public, uint8_t * p_private, int calls)
+{
+    /* Blocks the CPU */
+    m_now += SIM_KEYGEN_US;
+    m_keys_generated++;
+    return NRF_SUCCESS;
+}
+
+static session_t * session_get(const nrf_mesh_prov_ctx_t * p_ctx)
+{
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        if (m_sessions[i].p_ctx == p_ctx)
+        {
+            return &m_sessions[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t nrf_mesh_prov_provision_cb(nrf_mesh_prov_ctx_t * p_ctx,
+                                           const uint8_t * p_target_uuid,
+                                           uint8_t attention_duration_s,
+                                           const nrf_mesh_prov_provisioning_data_t * p_data,
+                                           nrf_mesh_prov_bearer_type_t bearer,
+                                           int calls)
+{
+    TEST_ASSERT_EQUAL(NRF_MESH_PROV_BEARER_ADV, bearer);
+    session_t * p_session = session_get(p_ctx);
+    TEST_ASSERT_NOT_NULL(p_session);
+    TEST_ASSERT_EQUAL(SESSION_IDLE, p_session->state);
+
+    /* The links must not share a device */
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        if (m_sessions[i].state != SESSION_IDLE)
+        {
+            TEST_ASSERT_FALSE(memcmp(m_sessions[i].uuid, p_target_uuid, NRF_MESH_UUID_SIZE) == 0);
+        }
+    }
+
+    memcpy(p_session->uuid, p_target_uuid, NRF_MESH_UUID_SIZE);
+    p_session->state = SESSION_KEY_EXCHANGE;
+    p_session->next_at = m_now + SIM_ECDH_AT_US;
+    return NRF_SUCCESS;
+}
+
+static void app_evt_handler(const nrf_mesh_prov_evt_t * p_evt)
+{
+    if (p_evt->type == NRF_MESH_PROV_EVT_LINK_CLOSED)
+    {
+        m_link_closed_events++;
+    }
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static void uuid_set(uint8_t * p_uuid, uint32_t device)
+{
+    memset(p_uuid, 0, NRF_MESH_UUID_SIZE);
+    memcpy(p_uuid, &device, sizeof(device));
+}
+
+static void link_close(nrf_mesh_prov_ctx_t * p_ctx)
+{
+    session_get(p_ctx)->state = SESSION_IDLE;
+
+    nrf_mesh_prov_evt_t evt;
+    evt.type = NRF_MESH_PROV_EVT_LINK_CLOSED;
+    evt.params.link_closed.p_context = p_ctx;
+    evt.params.link_closed.close_reason = NRF_MESH_PROV_LINK_CLOSE_REASON_SUCCESS;
+    m_prov_evt_handler(&evt);
+}
+
+static timestamp_t max_time(timestamp_t a, timestamp_t b)
+{
+    return TIMER_OLDER_THAN(a, b) ? b : a;
+}
+
+/* Runs one main loop iteration, followed by the bearer event it may have triggered. */
+static bool main_loop_run(void)
+{
+    bool done = nrf_mesh_prov_queue_process();
+    if (m_available_pending)
+    {
+        m_available_pending = false;
+        TEST_ASSERT_TRUE(m_available_flag_cb());
+    }
+    return done;
+}
+
+/* Runs the simulated provisioner until all sessions are done, returns the time it took. */
+static timestamp_t simulation_run(uint32_t device_count)
+{
+    timestamp_t start = m_now;
+    uint32_t completed = 0;
+
+    while (completed < device_count)
+    {
+        /* Earliest pending event, events that are due run when the CPU is free again */
+        enum { EVT_NONE, EVT_TIMER, EVT_REFILL, EVT_SESSION } evt = EVT_NONE;
+        timestamp_t evt_at = 0;
+        session_t * p_session = NULL;
+
+        if (m_timer_scheduled)
+        {
+            evt = EVT_TIMER;
+            evt_at = max_time(m_timer_at, m_now);
+        }
+        for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+        {
+            if (m_sessions[i].state != SESSION_IDLE &&
+                (evt == EVT_NONE || TIMER_OLDER_THAN(max_time(m_sessions[i].next_at, m_now), evt_at)))
+            {
+                evt = EVT_SESSION;
+                evt_at = max_time(m_sessions[i].next_at, m_now);
+                p_session = &m_sessions[i];
+            }
+        }
+        /* The keypool refill runs in the main loop, whenever nothing else is due */
+        if (prov_keypool_count_get() < NRF_MESH_PROV_KEYPOOL_SIZE &&
+            (evt == EVT_NONE || TIMER_OLDER_THAN(m_now, evt_at)))
+        {
+            evt = EVT_REFILL;
+            evt_at = m_now;
+        }
+        TEST_ASSERT_MESSAGE(evt != EVT_NONE, "Provisioning stalled");
+        m_now = evt_at;
+
+        switch (evt)
+        {
+            case EVT_TIMER:
+                m_timer_scheduled = false;
+                mp_timer->cb(m_now, mp_timer->p_context);
+                break;
+
+            case EVT_REFILL:
+                (void) main_loop_run();
+                break;
+
+            case EVT_SESSION:
+                if (p_session->state == SESSION_KEY_EXCHANGE)
+                {
+                    /* Blocks the CPU */
+                    m_now += SIM_ECDH_US;
+                    p_session->state = SESSION_FINISHING;
+                    p_session->next_at = m_now + SIM_FINISH_US;
+                }
+                else
+                {
+                    completed++;
+                    link_close(p_session->p_ctx);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return m_now - start;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    nrf_mesh_prov_mock_Init();
+    nrf_mesh_prov_bearer_adv_mock_Init();
+    nrf_mesh_utils_mock_Init();
+    prov_utils_mock_Init();
+    bearer_event_mock_Init();
+    timer_mock_Init();
+    timer_scheduler_mock_Init();
+
+    nrf_mesh_prov_init_StubWithCallback(nrf_mesh_prov_init_cb);
+    nrf_mesh_prov_bearer_add_IgnoreAndReturn(NRF_SUCCESS);
+    nrf_mesh_prov_bearer_adv_interface_get_IgnoreAndReturn(NULL);
+    nrf_mesh_address_type_get_IgnoreAndReturn(NRF_MESH_ADDRESS_TYPE_UNICAST);
+    bearer_event_flag_add_StubWithCallback(bearer_event_flag_add_cb);
+    bearer_event_flag_set_StubWithCallback(bearer_event_flag_set_cb);
+    timer_now_StubWithCallback(timer_now_cb);
+    timer_sch_reschedule_StubWithCallback(timer_sch_reschedule_cb);
+    prov_utils_keys_generate_StubWithCallback(prov_utils_keys_generate_cb);
+    nrf_mesh_prov_provision_StubWithCallback(nrf_mesh_prov_provision_cb);
+
+    m_now = 1000;
+    m_timer_scheduled = false;
+    m_available_pending = false;
+    m_keys_generated = 0;
+    m_link_closed_events = 0;
+    m_context_count = 0;
+
+    nrf_mesh_prov_oob_caps_t caps = NRF_MESH_PROV_OOB_CAPS_DEFAULT(1);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_init(&caps, app_evt_handler));
+    TEST_ASSERT_EQUAL(NRF_MESH_PROV_QUEUE_LINK_COUNT, m_context_count);
+    TEST_ASSERT_NOT_NULL(m_available_flag_cb);
+
+    memset(m_sessions, 0, sizeof(m_sessions));
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        m_sessions[i].p_ctx = mp_contexts[i];
+    }
+
+    memset(&m_prov_data, 0, sizeof(m_prov_data));
+    m_prov_data.address = 0x0100;
+}
+
+void tearDown(void)
+{
+    /* The module state is static, leave no links behind for the next test */
+    nrf_mesh_prov_queue_clear();
+    for (uint32_t i = 0; i < m_context_count; ++i)
+    {
+        link_close(mp_contexts[i]);
+    }
+
+    /* Leave an empty keypool */
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+    while (prov_keypool_get(public_key, private_key) == NRF_SUCCESS)
+    {
+    }
+
+    nrf_mesh_prov_mock_Verify();
+    nrf_mesh_prov_mock_Destroy();
+    nrf_mesh_prov_bearer_adv_mock_Verify();
+    nrf_mesh_prov_bearer_adv_mock_Destroy();
+    nrf_mesh_utils_mock_Verify();
+    nrf_mesh_utils_mock_Destroy();
+    prov_utils_mock_Verify();
+    prov_utils_mock_Destroy();
+    bearer_event_mock_Verify();
+    bearer_event_mock_Destroy();
+    timer_mock_Verify();
+    timer_mock_Destroy();
+    timer_scheduler_mock_Verify();
+    timer_scheduler_mock_Destroy();
+}
+
+/*****************************************************************************
+* Test functions
+*****************************************************************************/
+void test_init(void)
+{
+    nrf_mesh_prov_oob_caps_t caps = NRF_MESH_PROV_OOB_CAPS_DEFAULT(1);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, nrf_mesh_prov_queue_init(NULL, app_evt_handler));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, nrf_mesh_prov_queue_init(&caps, NULL));
+
+    /* No reinitialization while provisioning */
+    uint8_t uuid[NRF_MESH_UUID_SIZE];
+    uuid_set(uuid, 0);
+    (void) main_loop_run();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(1, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, nrf_mesh_prov_queue_init(&caps, app_evt_handler));
+
+    link_close(m_sessions[0].p_ctx);
+    TEST_ASSERT_EQUAL(1, m_link_closed_events);
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_init(&caps, app_evt_handler));
+}
+
+void test_add(void)
+{
+    uint8_t uuid[NRF_MESH_UUID_SIZE];
+    uuid_set(uuid, 0);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, nrf_mesh_prov_queue_add(NULL, 0, &m_prov_data));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, nrf_mesh_prov_queue_add(uuid, 0, NULL));
+
+    nrf_mesh_prov_provisioning_data_t data = m_prov_data;
+    data.netkey_index = NRF_MESH_GLOBAL_KEY_INDEX_MAX + 1;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, nrf_mesh_prov_queue_add(uuid, 0, &data));
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LENGTH; ++i)
+    {
+        uuid_set(uuid, i);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+        TEST_ASSERT_TRUE(m_timer_scheduled);
+        TEST_ASSERT_EQUAL(m_now, m_timer_at);
+    }
+    TEST_ASSERT_EQUAL(NRF_MESH_PROV_QUEUE_LENGTH, nrf_mesh_prov_queue_pending_count_get());
+
+    /* Duplicates are rejected before the queue is found full */
+    TEST_ASSERT_EQUAL(NRF_ERROR_FORBIDDEN, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+    uuid_set(uuid, NRF_MESH_PROV_QUEUE_LENGTH);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+
+    nrf_mesh_prov_queue_clear();
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_pending_count_get());
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+}
+
+void test_link_open(void)
+{
+    uint8_t uuid[NRF_MESH_UUID_SIZE];
+
+    for (uint32_t i = 0; i < NRF_MESH_PROV_QUEUE_LINK_COUNT + 1; ++i)
+    {
+        uuid_set(uuid, i);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+    }
+
+    /* Nothing happens without keys */
+    m_timer_scheduled = false;
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    /* The first keypair starts the queue */
+    TEST_ASSERT_FALSE(main_loop_run());
+    TEST_ASSERT_TRUE(m_timer_scheduled);
+    m_timer_scheduled = false;
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(1, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_EQUAL(NRF_MESH_PROV_QUEUE_LINK_COUNT, nrf_mesh_prov_queue_pending_count_get());
+
+    /* A device in the active list is still a duplicate */
+    uuid_set(uuid, 0);
+    TEST_ASSERT_EQUAL(NRF_ERROR_FORBIDDEN, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+
+    /* The next link waits for the link open spacing, even with keys available */
+    timestamp_t link_open_time = m_now;
+    while (!main_loop_run())
+    {
+    }
+    m_now = link_open_time;
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(1, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_TRUE(m_timer_scheduled);
+
+    for (uint32_t i = 2; i <= NRF_MESH_PROV_QUEUE_LINK_COUNT; ++i)
+    {
+        m_now = m_timer_at;
+        m_timer_scheduled = false;
+        mp_timer->cb(m_now, mp_timer->p_context);
+        TEST_ASSERT_EQUAL(i, nrf_mesh_prov_queue_active_count_get());
+    }
+
+    /* All links are busy, the last device waits for a link close */
+    m_now += NRF_MESH_PROV_QUEUE_LINK_OPEN_SPACING_US;
+    m_timer_scheduled = false;
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(1, nrf_mesh_prov_queue_pending_count_get());
+    TEST_ASSERT_FALSE(m_timer_scheduled);
+
+    link_close(m_sessions[1].p_ctx);
+    TEST_ASSERT_TRUE(m_timer_scheduled);
+    TEST_ASSERT_EQUAL(m_now, m_timer_at);
+    TEST_ASSERT_EQUAL(NRF_MESH_PROV_QUEUE_LINK_COUNT - 1, nrf_mesh_prov_queue_active_count_get());
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(NRF_MESH_PROV_QUEUE_LINK_COUNT, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_pending_count_get());
+}
+
+void test_link_open_failed(void)
+{
+    uint8_t uuid[NRF_MESH_UUID_SIZE];
+    uuid_set(uuid, 0);
+    TEST_ASSERT_FALSE(main_loop_run());
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+
+    /* The device stays in the queue, and the link keeps its keypair */
+    nrf_mesh_prov_provision_StubWithCallback(NULL);
+    nrf_mesh_prov_provision_ExpectAnyArgsAndReturn(NRF_ERROR_NO_MEM);
+    m_timer_scheduled = false;
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_EQUAL(1, nrf_mesh_prov_queue_pending_count_get());
+    TEST_ASSERT_EQUAL(0, prov_keypool_count_get());
+    TEST_ASSERT_TRUE(m_timer_scheduled);
+    TEST_ASSERT_EQUAL(m_now + NRF_MESH_PROV_QUEUE_LINK_OPEN_SPACING_US, m_timer_at);
+
+    nrf_mesh_prov_provision_StubWithCallback(nrf_mesh_prov_provision_cb);
+    m_now = m_timer_at;
+    mp_timer->cb(m_now, mp_timer->p_context);
+    TEST_ASSERT_EQUAL(1, nrf_mesh_prov_queue_active_count_get());
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_pending_count_get());
+}
+
+/* Provisions a population of devices with the simulated timing, and compares the throughput to
+ * provisioning the same devices one at a time with keys generated for each session. */
+void test_population(void)
+{
+    uint8_t uuid[NRF_MESH_UUID_SIZE];
+    for (uint32_t i = 0; i < SIM_DEVICE_COUNT; ++i)
+    {
+        uuid_set(uuid, 0x1000 + i);
+        m_prov_data.address = 0x0100 + i;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_mesh_prov_queue_add(uuid, 0, &m_prov_data));
+    }
+
+    timestamp_t elapsed = simulation_run(SIM_DEVICE_COUNT);
+
+    TEST_ASSERT_EQUAL(SIM_DEVICE_COUNT, m_link_closed_events);
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_pending_count_get());
+    TEST_ASSERT_EQUAL(0, nrf_mesh_prov_queue_active_count_get());
+    /* A fresh keypair for every session */
+    TEST_ASSERT_TRUE(m_keys_generated >= SIM_DEVICE_COUNT);
+
+    uint64_t sequential_us = (uint64_t)SIM_DEVICE_COUNT *
+                             (SIM_KEYGEN_US + SIM_ECDH_AT_US + SIM_ECDH_US + SIM_FINISH_US);
+    uint32_t sequential_per_minute = (uint32_t)(60000000ull * SIM_DEVICE_COUNT / sequential_us);
+    uint32_t queue_per_minute = (uint32_t)(60000000ull * SIM_DEVICE_COUNT / elapsed);
+    printf("Provisioned %u devices in %u ms: %u devices per minute, %u devices per minute sequentially\n",
+           SIM_DEVICE_COUNT, elapsed / 1000, queue_per_minute, sequential_per_minute);
+
+    /* Bounded by the shared CPU time for the keys and the shared secrets */
+    TEST_ASSERT_TRUE(queue_per_minute <= 60000000ull / (SIM_KEYGEN_US + SIM_ECDH_US));
+    TEST_ASSERT_TRUE(queue_per_minute >= 2 * sequential_per_minute);
+}
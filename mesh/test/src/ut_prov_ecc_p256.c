@@ -0,0 +1,382 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "prov_ecc_p256.h"
+#include "nrf_mesh_prov_types.h"
+#include "uECC.h"
+#include "test_assert.h"
+
+#include "rand_mock.h"
+
+#define RANDOM_KEY_COUNT    (64)
+#define BENCHMARK_ROUNDS    (32)
+
+/* Sample data from @tagMeshSp section 8.7, in the big-endian PDU format */
+static const uint8_t m_provisioner_private[] =
+{
+    0x06, 0xa5, 0x16, 0x69, 0x3c, 0x9a, 0xa3, 0x1a, 0x60, 0x84, 0x54, 0x5d, 0x0c, 0x5d, 0xb6, 0x41,
+    0xb4, 0x85, 0x72, 0xb9, 0x72, 0x03, 0xdd, 0xff, 0xb7, 0xac, 0x73, 0xf7, 0xd0, 0x45, 0x76, 0x63
+};
+static const uint8_t m_provisioner_public[] =
+{
+    0x2c, 0x31, 0xa4, 0x7b, 0x57, 0x79, 0x80, 0x9e, 0xf4, 0x4c, 0xb5, 0xea, 0xaf, 0x5c, 0x3e, 0x43,
+    0xd5, 0xf8, 0xfa, 0xad, 0x4a, 0x87, 0x94, 0xcb, 0x98, 0x7e, 0x9b, 0x03, 0x74, 0x5c, 0x78, 0xdd,
+    0x91, 0x95, 0x12, 0x18, 0x38, 0x98, 0xdf, 0xbe, 0xcd, 0x52, 0xe2, 0x40, 0x8e, 0x43, 0x87, 0x1f,
+    0xd0, 0x21, 0x10, 0x91, 0x17, 0xbd, 0x3e, 0xd4, 0xea, 0xf8, 0x43, 0x77, 0x43, 0x71, 0x5d, 0x4f
+};
+static const uint8_t m_provisionee_private[] =
+{
+    0x52, 0x9a, 0xa0, 0x67, 0x0d, 0x72, 0xcd, 0x64, 0x97, 0x50, 0x2e, 0xd4, 0x73, 0x50, 0x2b, 0x03,
+    0x7e, 0x88, 0x03, 0xb5, 0xc6, 0x08, 0x29, 0xa5, 0xa3, 0xca, 0xa2, 0x19, 0x50, 0x55, 0x30, 0xba
+};
+static const uint8_t m_provisionee_public[] =
+{
+    0xf4, 0x65, 0xe4, 0x3f, 0xf2, 0x3d, 0x3f, 0x1b, 0x9d, 0xc7, 0xdf, 0xc0, 0x4d, 0xa8, 0x75, 0x81,
+    0x84, 0xdb, 0xc9, 0x66, 0x20, 0x47, 0x96, 0xec, 0xcf, 0x0d, 0x6c, 0xf5, 0xe1, 0x65, 0x00, 0xcc,
+    0x02, 0x01, 0xd0, 0x48, 0xbc, 0xbb, 0xd8, 0x99, 0xee, 0xef, 0xc4, 0x24, 0x16, 0x4e, 0x33, 0xc2,
+    0x01, 0xc2, 0xb0, 0x10, 0xca, 0x6b, 0x4d, 0x43, 0xa8, 0xa1, 0x55, 0xca, 0xd8, 0xec, 0xb2, 0x79
+};
+static const uint8_t m_shared_secret[] =
+{
+    0xab, 0x85, 0x84, 0x3a, 0x2f, 0x6d, 0x88, 0x3f, 0x62, 0xe5, 0x68, 0x4b, 0x38, 0xe3, 0x07, 0x33,
+    0x5f, 0xe6, 0xe1, 0x94, 0x5e, 0xcd, 0x19, 0x60, 0x41, 0x05, 0xc6, 0xf2, 0x32, 0x21, 0xeb, 0x69
+};
+
+/* Generator point and group order of P-256 */
+static const uint8_t m_generator[] =
+{
+    0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+    0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96,
+    0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+    0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce, 0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5
+};
+static const uint8_t m_order[] =
+{
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51
+};
+
+static uint32_t m_prng_state;
+static const uint8_t * mp_rand_data;
+static uint32_t m_rand_data_len;
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static uint8_t prng_byte(void)
+{
+    /* xorshift32, repeatable random keys */
+    m_prng_state ^= m_prng_state << 13;
+    m_prng_state ^= m_prng_state >> 17;
+    m_prng_state ^= m_prng_state << 5;
+    return (uint8_t) m_prng_state;
+}
+
+static void random_private_key_get(uint8_t * p_private)
+{
+    do
+    {
+        for (uint32_t i = 0; i < NRF_MESH_PROV_PRIVKEY_SIZE; ++i)
+        {
+            p_private[i] = prng_byte();
+        }
+    } while (memcmp(p_private, m_order, NRF_MESH_PROV_PRIVKEY_SIZE) >= 0);
+}
+
+static void rand_hw_rng_get_cb(uint8_t * p_result, uint16_t len, int calls)
+{
+    TEST_ASSERT_TRUE(m_rand_data_len >= len);
+    memcpy(p_result, mp_rand_data, len);
+    mp_rand_data += len;
+    m_rand_data_len -= len;
+}
+
+static uint32_t elapsed_us_get(clock_t start)
+{
+    return (uint32_t) ((uint64_t) (clock() - start) * 1000000 / CLOCKS_PER_SEC);
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    rand_mock_Init();
+    m_prng_state = 0x2545f491;
+}
+
+void tearDown(void)
+{
+    rand_mock_Verify();
+    rand_mock_Destroy();
+}
+
+/*****************************************************************************
+* Test functions
+*****************************************************************************/
+void test_sample_data(void)
+{
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t secret[NRF_MESH_ECDH_SHARED_SECRET_SIZE];
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(m_provisioner_private, public_key));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_provisioner_public, public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(m_provisionee_private, public_key));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_provisionee_public, public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+
+    TEST_ASSERT_TRUE(prov_ecc_p256_public_key_is_valid(m_provisioner_public));
+    TEST_ASSERT_TRUE(prov_ecc_p256_public_key_is_valid(m_provisionee_public));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_shared_secret_calculate(m_provisionee_public, m_provisioner_private, secret));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_shared_secret, secret, NRF_MESH_ECDH_SHARED_SECRET_SIZE);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_shared_secret_calculate(m_provisioner_public, m_provisionee_private, secret));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_shared_secret, secret, NRF_MESH_ECDH_SHARED_SECRET_SIZE);
+}
+
+void test_private_key_range(void)
+{
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t expected[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t secret[NRF_MESH_ECDH_SHARED_SECRET_SIZE];
+
+    /* 1 * G */
+    memset(private_key, 0, sizeof(private_key));
+    private_key[NRF_MESH_PROV_PRIVKEY_SIZE - 1] = 1;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(private_key, public_key));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_generator, public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_shared_secret_calculate(m_provisioner_public, private_key, secret));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_provisioner_public, secret, NRF_MESH_ECDH_SHARED_SECRET_SIZE);
+
+    /* Small multiples, against micro-ecc */
+    for (uint32_t k = 2; k < 40; ++k)
+    {
+        private_key[NRF_MESH_PROV_PRIVKEY_SIZE - 1] = (uint8_t) k;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(private_key, public_key));
+        TEST_ASSERT_EQUAL(1, uECC_compute_public_key(private_key, expected, uECC_secp256r1()));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+    }
+
+    /* (n - 1) * G = -G, which micro-ecc does not calculate */
+    static const uint8_t negated_generator_y[] =
+    {
+        0xb0, 0x1c, 0xbd, 0x1c, 0x01, 0xe5, 0x80, 0x65, 0x71, 0x18, 0x14, 0xb5, 0x83, 0xf0, 0x61, 0xe9,
+        0xd4, 0x31, 0xcc, 0xa9, 0x94, 0xce, 0xa1, 0x31, 0x34, 0x49, 0xbf, 0x97, 0xc8, 0x40, 0xae, 0x0a
+    };
+    memcpy(private_key, m_order, sizeof(private_key));
+    private_key[NRF_MESH_PROV_PRIVKEY_SIZE - 1]--;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(private_key, public_key));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_generator, public_key, NRF_MESH_PROV_PUBKEY_SIZE / 2);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(negated_generator_y, &public_key[NRF_MESH_PROV_PUBKEY_SIZE / 2], NRF_MESH_PROV_PUBKEY_SIZE / 2);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_shared_secret_calculate(m_generator, private_key, secret));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_generator, secret, NRF_MESH_ECDH_SHARED_SECRET_SIZE);
+
+    /* (n - j) * G = -(j * G) has the x coordinate of j * G. For n - 2, the last window digit of the
+     * shared secret is added to an equal point. */
+    for (uint32_t j = 1; j <= 32; ++j)
+    {
+        memset(private_key, 0, sizeof(private_key));
+        private_key[NRF_MESH_PROV_PRIVKEY_SIZE - 1] = (uint8_t) j;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(private_key, expected));
+
+        memcpy(private_key, m_order, sizeof(private_key));
+        private_key[NRF_MESH_PROV_PRIVKEY_SIZE - 1] -= (uint8_t) j;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_shared_secret_calculate(m_generator, private_key, secret));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, secret, NRF_MESH_ECDH_SHARED_SECRET_SIZE);
+    }
+
+    /* 0, n and 2^256 - 1 are not private keys */
+    memset(private_key, 0, sizeof(private_key));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, prov_ecc_p256_public_key_calculate(private_key, public_key));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INTERNAL, prov_ecc_p256_shared_secret_calculate(m_provisioner_public, private_key, secret));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, prov_ecc_p256_public_key_calculate(m_order, public_key));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INTERNAL, prov_ecc_p256_shared_secret_calculate(m_provisioner_public, m_order, secret));
+    memset(private_key, 0xff, sizeof(private_key));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, prov_ecc_p256_public_key_calculate(private_key, public_key));
+}
+
+void test_invalid_public_key(void)
+{
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t secret[NRF_MESH_ECDH_SHARED_SECRET_SIZE];
+
+    /* Not on the curve */
+    memcpy(public_key, m_provisionee_public, sizeof(public_key));
+    public_key[NRF_MESH_PROV_PUBKEY_SIZE - 1] ^= 0x01;
+    TEST_ASSERT_FALSE(prov_ecc_p256_public_key_is_valid(public_key));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INTERNAL, prov_ecc_p256_shared_secret_calculate(public_key, m_provisioner_private, secret));
+
+    /* The point at infinity has no affine coordinates */
+    memset(public_key, 0, sizeof(public_key));
+    TEST_ASSERT_FALSE(prov_ecc_p256_public_key_is_valid(public_key));
+
+    /* Coordinates must be reduced, x + p is not accepted for x = 0 */
+    memset(public_key, 0, sizeof(public_key));
+    static const uint8_t field_prime[] =
+    {
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    };
+    memcpy(public_key, field_prime, sizeof(field_prime));
+    memcpy(&public_key[32], m_provisionee_public, 32);
+    TEST_ASSERT_FALSE(prov_ecc_p256_public_key_is_valid(public_key));
+
+    /* Same verdict as micro-ecc for random points */
+    for (uint32_t i = 0; i < RANDOM_KEY_COUNT; ++i)
+    {
+        for (uint32_t j = 0; j < NRF_MESH_PROV_PUBKEY_SIZE; ++j)
+        {
+            public_key[j] = prng_byte();
+        }
+        TEST_ASSERT_EQUAL(uECC_valid_public_key(public_key, uECC_secp256r1()) == 1,
+                          prov_ecc_p256_public_key_is_valid(public_key));
+    }
+}
+
+void test_against_uecc(void)
+{
+    uint8_t private_a[NRF_MESH_PROV_PRIVKEY_SIZE];
+    uint8_t private_b[NRF_MESH_PROV_PRIVKEY_SIZE];
+    uint8_t public_a[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t public_b[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t expected[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t secret[NRF_MESH_ECDH_SHARED_SECRET_SIZE];
+    uint8_t expected_secret[NRF_MESH_ECDH_SHARED_SECRET_SIZE];
+
+    for (uint32_t i = 0; i < RANDOM_KEY_COUNT; ++i)
+    {
+        random_private_key_get(private_a);
+        random_private_key_get(private_b);
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(private_a, public_a));
+        TEST_ASSERT_EQUAL(1, uECC_compute_public_key(private_a, expected, uECC_secp256r1()));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, public_a, NRF_MESH_PROV_PUBKEY_SIZE);
+        TEST_ASSERT_EQUAL(1, uECC_compute_public_key(private_b, public_b, uECC_secp256r1()));
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_shared_secret_calculate(public_b, private_a, secret));
+        TEST_ASSERT_EQUAL(1, uECC_shared_secret(public_a, private_b, expected_secret, uECC_secp256r1()));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_secret, secret, NRF_MESH_ECDH_SHARED_SECRET_SIZE);
+    }
+}
+
+void test_keys_generate(void)
+{
+    uint8_t rand_data[3 * NRF_MESH_PROV_PRIVKEY_SIZE];
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+
+    /* Random numbers outside of [1, n - 1] are skipped */
+    memset(&rand_data[0], 0, NRF_MESH_PROV_PRIVKEY_SIZE);
+    memcpy(&rand_data[NRF_MESH_PROV_PRIVKEY_SIZE], m_order, NRF_MESH_PROV_PRIVKEY_SIZE);
+    memcpy(&rand_data[2 * NRF_MESH_PROV_PRIVKEY_SIZE], m_provisioner_private, NRF_MESH_PROV_PRIVKEY_SIZE);
+    mp_rand_data = rand_data;
+    m_rand_data_len = sizeof(rand_data);
+    rand_hw_rng_get_StubWithCallback(rand_hw_rng_get_cb);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_keys_generate(public_key, private_key));
+    TEST_ASSERT_EQUAL(0, m_rand_data_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_provisioner_private, private_key, NRF_MESH_PROV_PRIVKEY_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(m_provisioner_public, public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+
+    /* A broken random number generator */
+    uint8_t zeros[64 * NRF_MESH_PROV_PRIVKEY_SIZE];
+    memset(zeros, 0, sizeof(zeros));
+    mp_rand_data = zeros;
+    m_rand_data_len = sizeof(zeros);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INTERNAL, prov_ecc_p256_keys_generate(public_key, private_key));
+}
+
+void test_backend(void)
+{
+    const prov_utils_ecc_backend_t * p_backend = prov_ecc_p256_backend_get();
+    TEST_ASSERT_NOT_NULL(p_backend);
+    TEST_ASSERT_EQUAL_PTR(prov_ecc_p256_keys_generate, p_backend->keys_generate);
+    TEST_ASSERT_EQUAL_PTR(prov_ecc_p256_shared_secret_calculate, p_backend->shared_secret_calculate);
+    TEST_ASSERT_EQUAL_PTR(prov_ecc_p256_public_key_is_valid, p_backend->public_key_is_valid);
+}
+
+/* Compares the time per operation with micro-ecc. Only reported, the host timing is not stable
+ * enough to fail the test on. */
+void test_benchmark(void)
+{
+    uint8_t private_keys[BENCHMARK_ROUNDS][NRF_MESH_PROV_PRIVKEY_SIZE];
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t secret[NRF_MESH_ECDH_SHARED_SECRET_SIZE];
+
+    for (uint32_t i = 0; i < BENCHMARK_ROUNDS; ++i)
+    {
+        random_private_key_get(private_keys[i]);
+    }
+
+    clock_t start = clock();
+    for (uint32_t i = 0; i < BENCHMARK_ROUNDS; ++i)
+    {
+        TEST_ASSERT_EQUAL(1, uECC_compute_public_key(private_keys[i], public_key, uECC_secp256r1()));
+    }
+    uint32_t uecc_public_key_us = elapsed_us_get(start) / BENCHMARK_ROUNDS;
+
+    start = clock();
+    for (uint32_t i = 0; i < BENCHMARK_ROUNDS; ++i)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_public_key_calculate(private_keys[i], public_key));
+    }
+    uint32_t p256_public_key_us = elapsed_us_get(start) / BENCHMARK_ROUNDS;
+
+    start = clock();
+    for (uint32_t i = 0; i < BENCHMARK_ROUNDS; ++i)
+    {
+        TEST_ASSERT_EQUAL(1, uECC_shared_secret(m_provisionee_public, private_keys[i], secret, uECC_secp256r1()));
+    }
+    uint32_t uecc_shared_secret_us = elapsed_us_get(start) / BENCHMARK_ROUNDS;
+
+    start = clock();
+    for (uint32_t i = 0; i < BENCHMARK_ROUNDS; ++i)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_ecc_p256_shared_secret_calculate(m_provisionee_public, private_keys[i], secret));
+    }
+    uint32_t p256_shared_secret_us = elapsed_us_get(start) / BENCHMARK_ROUNDS;
+
+    printf("Public key:    micro-ecc %u us, P-256 comb %u us\n", uecc_public_key_us, p256_public_key_us);
+    printf("Shared secret: micro-ecc %u us, P-256 window %u us\n", uecc_shared_secret_us, p256_shared_secret_us);
+}
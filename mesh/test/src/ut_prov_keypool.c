@@ -0,0 +1,180 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "prov_keypool.h"
+#include "nrf_mesh_prov_types.h"
+#include "test_assert.h"
+
+#include "bearer_event_mock.h"
+#include "prov_utils_mock.h"
+
+#define TEST_FLAG 3
+
+static bearer_event_flag_callback_t m_available_flag_cb;
+static uint32_t m_available_calls;
+static uint8_t m_next_key;
+
+/*****************************************************************************
+* Mocked functions
+*****************************************************************************/
+static bearer_event_flag_t bearer_event_flag_add_cb(bearer_event_flag_callback_t cb, int calls)
+{
+    TEST_ASSERT_EQUAL(0, calls);
+    m_available_flag_cb = cb;
+    return TEST_FLAG;
+}
+
+/* Fills the keys with a counter, to tell them apart. */
+static uint32_t prov_utils_keys_generate_cb(uint8_t * p_public, uint8_t * p_private, int calls)
+{
+    memset(p_public, m_next_key, NRF_MESH_PROV_PUBKEY_SIZE);
+    memset(p_private, m_next_key, NRF_MESH_PROV_PRIVKEY_SIZE);
+    m_next_key++;
+    return NRF_SUCCESS;
+}
+
+static void available_cb(void)
+{
+    m_available_calls++;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    bearer_event_mock_Init();
+    prov_utils_mock_Init();
+
+    bearer_event_flag_add_StubWithCallback(bearer_event_flag_add_cb);
+
+    /* The pool is static, empty it from the previous test. */
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+    while (prov_keypool_get(public_key, private_key) == NRF_SUCCESS)
+    {
+    }
+
+    m_available_calls = 0;
+    m_next_key = 1;
+
+    prov_keypool_init(available_cb);
+    TEST_ASSERT_NOT_NULL(m_available_flag_cb);
+}
+
+void tearDown(void)
+{
+    bearer_event_mock_Verify();
+    bearer_event_mock_Destroy();
+    prov_utils_mock_Verify();
+    prov_utils_mock_Destroy();
+}
+
+/*****************************************************************************
+* Test functions
+*****************************************************************************/
+void test_refill(void)
+{
+    prov_utils_keys_generate_StubWithCallback(prov_utils_keys_generate_cb);
+
+    /* One keypair per call, until the pool is full. Only the first keypair is announced, from the
+     * bearer event. */
+    bearer_event_flag_set_Expect(TEST_FLAG);
+    for (uint32_t i = 1; i < NRF_MESH_PROV_KEYPOOL_SIZE; ++i)
+    {
+        TEST_ASSERT_FALSE(prov_keypool_refill());
+        TEST_ASSERT_EQUAL(i, prov_keypool_count_get());
+    }
+    TEST_ASSERT_TRUE(prov_keypool_refill());
+    TEST_ASSERT_EQUAL(NRF_MESH_PROV_KEYPOOL_SIZE, prov_keypool_count_get());
+    TEST_ASSERT_EQUAL(0, m_available_calls);
+
+    TEST_ASSERT_TRUE(m_available_flag_cb());
+    TEST_ASSERT_EQUAL(1, m_available_calls);
+
+    /* Nothing to do in a full pool */
+    prov_utils_mock_Verify();
+    prov_utils_mock_Init();
+    TEST_ASSERT_TRUE(prov_keypool_refill());
+}
+
+void test_get(void)
+{
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+    uint8_t expected[NRF_MESH_PROV_PUBKEY_SIZE];
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, prov_keypool_get(NULL, private_key));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, prov_keypool_get(public_key, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, prov_keypool_get(public_key, private_key));
+
+    prov_utils_keys_generate_StubWithCallback(prov_utils_keys_generate_cb);
+    bearer_event_flag_set_Expect(TEST_FLAG);
+    TEST_ASSERT_FALSE(prov_keypool_refill());
+    TEST_ASSERT_FALSE(prov_keypool_refill());
+
+    /* Every keypair is handed out once */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_keypool_get(public_key, private_key));
+    memset(expected, 2, sizeof(expected));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, private_key, NRF_MESH_PROV_PRIVKEY_SIZE);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_keypool_get(public_key, private_key));
+    memset(expected, 1, sizeof(expected));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, private_key, NRF_MESH_PROV_PRIVKEY_SIZE);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, prov_keypool_get(public_key, private_key));
+    TEST_ASSERT_EQUAL(0, prov_keypool_count_get());
+
+    /* The pool is announced again once it has been empty */
+    bearer_event_flag_set_Expect(TEST_FLAG);
+    TEST_ASSERT_FALSE(prov_keypool_refill());
+}
+
+void test_generate_failed(void)
+{
+    /* Nothing left to do until the next call, that would keep the main loop awake */
+    prov_utils_keys_generate_ExpectAnyArgsAndReturn(NRF_ERROR_NOT_SUPPORTED);
+    TEST_ASSERT_TRUE(prov_keypool_refill());
+    TEST_ASSERT_EQUAL(0, prov_keypool_count_get());
+}
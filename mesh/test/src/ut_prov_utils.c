@@ -629,3 +629,52 @@ void test_ecdh_deleter(void)
     TEST_ASSERT_FALSE(result);
 }
 
+
+static uint32_t m_backend_calls;
+
+static uint32_t backend_keys_generate(uint8_t * p_public, uint8_t * p_private)
+{
+    m_backend_calls++;
+    return NRF_SUCCESS;
+}
+
+static uint32_t backend_shared_secret_calculate(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared_secret)
+{
+    m_backend_calls++;
+    return NRF_ERROR_INTERNAL;
+}
+
+static bool backend_public_key_is_valid(const uint8_t * p_public)
+{
+    m_backend_calls++;
+    return true;
+}
+
+void test_ecc_backend_set(void)
+{
+    static const prov_utils_ecc_backend_t backend =
+    {
+        .keys_generate = backend_keys_generate,
+        .shared_secret_calculate = backend_shared_secret_calculate,
+        .public_key_is_valid = backend_public_key_is_valid
+    };
+    uint8_t pubkey[NRF_MESH_ECDH_PUBLIC_KEY_SIZE];
+    uint8_t privkey[NRF_MESH_ECDH_PRIVATE_KEY_SIZE] = {};
+    uint8_t shared_secret[NRF_MESH_KEY_SIZE] = {};
+    m_ctx.p_private_key = privkey;
+    m_backend_calls = 0;
+
+    /* micro-ecc is not used with another backend */
+    prov_utils_ecc_backend_set(&backend);
+    TEST_ASSERT_EQUAL_HEX32(NRF_SUCCESS, prov_utils_keys_generate(pubkey, privkey));
+    TEST_ASSERT_TRUE(prov_utils_is_valid_public_key(pubkey));
+    TEST_ASSERT_EQUAL_HEX32(NRF_ERROR_INTERNAL, prov_utils_calculate_shared_secret(&m_ctx, shared_secret));
+    TEST_ASSERT_EQUAL(4, m_backend_calls);
+
+    /* Back to the default backend */
+    prov_utils_ecc_backend_set(NULL);
+    uECC_secp256r1_ExpectAndReturn(NULL);
+    uECC_make_key_ExpectAndReturn(pubkey, privkey, NULL, 1);
+    TEST_ASSERT_EQUAL_HEX32(NRF_SUCCESS, prov_utils_keys_generate(pubkey, privkey));
+    TEST_ASSERT_EQUAL(4, m_backend_calls);
+}
@@ -0,0 +1,518 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "scene_snapshot.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+#include "mesh_config_entry_mock.h"
+
+#define MODEL_COUNT             (8)
+#define SCENE_COUNT             (SCENE_REGISTER_ARRAY_SIZE)
+#define STATE_SIZE_MAX          (8)
+#define BENCHMARK_RECALLS       (100000)
+
+/* Offsets of the header fields in a stored record. */
+#define RECORD_STATE_SIZE       (0)
+#define RECORD_LENGTH           (1)
+#define RECORD_RUNS             (2)
+
+typedef struct
+{
+    scene_snapshot_model_t model;
+    uint8_t state[STATE_SIZE_MAX];
+    uint8_t applied[STATE_SIZE_MAX];
+    uint32_t apply_count;
+    uint32_t delay_ms;
+    uint32_t transition_time_ms;
+    uint64_t apply_time_ns;
+} test_model_t;
+
+extern const mesh_config_entry_params_t m_m_scene_snapshot_reference_entry_params;
+extern const mesh_config_entry_params_t m_m_scene_snapshot_record_entry_params;
+
+/* Scene states of a light fixture: OnOff, Level, Lightness, CTL, HSL, LC mode and properties. */
+static const uint8_t m_state_sizes[MODEL_COUNT] = {1, 2, 2, 6, 6, 3, 4, 2};
+
+static scene_snapshot_t m_snapshot;
+static test_model_t m_models[MODEL_COUNT];
+static uint32_t m_entry_set_count;
+static uint32_t m_entry_delete_count;
+
+/*****************************************************************************
+* Mock functions
+*****************************************************************************/
+static uint64_t time_ns_get(void)
+{
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+}
+
+static const mesh_config_entry_params_t * entry_params_get(mesh_config_entry_id_t id)
+{
+    TEST_ASSERT_EQUAL(MESH_OPT_MODEL_FILE_ID, id.file);
+    if (id.record >= SCENE_SNAPSHOT_RECORD_EID_START)
+    {
+        TEST_ASSERT_TRUE(id.record < SCENE_SNAPSHOT_RECORD_EID_START + m_m_scene_snapshot_record_entry_params.max_count);
+        return &m_m_scene_snapshot_record_entry_params;
+    }
+    TEST_ASSERT_TRUE(id.record >= SCENE_SNAPSHOT_REFERENCE_EID_START);
+    return &m_m_scene_snapshot_reference_entry_params;
+}
+
+static uint32_t mesh_config_entry_set_cb(mesh_config_entry_id_t id, const void * p_entry, int num_calls)
+{
+    m_entry_set_count++;
+    return entry_params_get(id)->callbacks.setter(id, p_entry);
+}
+
+static uint32_t mesh_config_entry_delete_cb(mesh_config_entry_id_t id, int num_calls)
+{
+    m_entry_delete_count++;
+    entry_params_get(id)->callbacks.deleter(id);
+    return NRF_SUCCESS;
+}
+
+static void state_get_cb(const scene_snapshot_model_t * p_model, uint8_t * p_state)
+{
+    test_model_t * p_test = PARENT_BY_FIELD_GET(test_model_t, model, p_model);
+    memcpy(p_state, p_test->state, p_model->state_size);
+}
+
+static void state_apply_cb(const scene_snapshot_model_t * p_model,
+                           const uint8_t * p_state,
+                           uint32_t delay_ms,
+                           uint32_t transition_time_ms)
+{
+    test_model_t * p_test = PARENT_BY_FIELD_GET(test_model_t, model, p_model);
+
+    p_test->apply_time_ns = time_ns_get();
+    memcpy(p_test->applied, p_state, p_model->state_size);
+    p_test->apply_count++;
+    p_test->delay_ms = delay_ms;
+    p_test->transition_time_ms = transition_time_ms;
+}
+
+static const scene_snapshot_model_callbacks_t m_model_callbacks =
+{
+    .state_get_cb = state_get_cb,
+    .state_apply_cb = state_apply_cb
+};
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static void models_add(scene_snapshot_t * p_snapshot, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_model_add(p_snapshot, &m_models[i].model));
+    }
+}
+
+/* A scene: every model dimmed to a scene dependent level, most other states left alone. */
+static void scene_states_set(uint32_t scene)
+{
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        memset(m_models[i].state, 0x10 * (i + 1), m_models[i].model.state_size);
+        m_models[i].state[0] = (uint8_t) (scene * 7 + i);
+    }
+}
+
+static void record_get(uint8_t scene_index, uint8_t * p_record)
+{
+    mesh_config_entry_id_t id = SCENE_SNAPSHOT_RECORD_EID;
+    id.record += scene_index;
+    m_m_scene_snapshot_record_entry_params.callbacks.getter(id, p_record);
+}
+
+static void applied_states_check(uint32_t scene)
+{
+    scene_states_set(scene);
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(m_models[i].state, m_models[i].applied, m_models[i].model.state_size);
+    }
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    mesh_config_entry_mock_Init();
+    mesh_config_entry_set_StubWithCallback(mesh_config_entry_set_cb);
+    mesh_config_entry_delete_StubWithCallback(mesh_config_entry_delete_cb);
+
+    scene_snapshot_storage_init();
+    m_entry_set_count = 0;
+    m_entry_delete_count = 0;
+
+    memset(m_models, 0, sizeof(m_models));
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        m_models[i].model.p_callbacks = &m_model_callbacks;
+        m_models[i].model.state_size = m_state_sizes[i];
+    }
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_init(&m_snapshot, 0));
+}
+
+void tearDown(void)
+{
+    mesh_config_entry_mock_Verify();
+    mesh_config_entry_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_init(void)
+{
+    scene_snapshot_t snapshot;
+    scene_snapshot_model_t model = {.p_callbacks = &m_model_callbacks, .state_size = 1};
+    const scene_snapshot_model_callbacks_t no_apply = {.state_get_cb = state_get_cb};
+    scene_snapshot_model_t large_model = {.p_callbacks = &m_model_callbacks, .state_size = SCENE_SNAPSHOT_STATE_SIZE_MAX};
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scene_snapshot_init(NULL, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scene_snapshot_init(&snapshot, SCENE_SETUP_SERVER_INSTANCES_MAX));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_init(&snapshot, SCENE_SETUP_SERVER_INSTANCES_MAX - 1));
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scene_snapshot_model_add(NULL, &model));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scene_snapshot_model_add(&snapshot, NULL));
+    model.p_callbacks = &no_apply;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scene_snapshot_model_add(&snapshot, &model));
+    model.p_callbacks = &m_model_callbacks;
+    model.state_size = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scene_snapshot_model_add(&snapshot, &model));
+
+    /* The states are laid out in registration order. */
+    models_add(&snapshot, MODEL_COUNT);
+    uint8_t offset = 0;
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(offset, m_models[i].model.offset);
+        offset += m_models[i].model.state_size;
+    }
+
+    /* No more models, and no more room for states. */
+    model.state_size = 1;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, scene_snapshot_model_add(&snapshot, &model));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_init(&snapshot, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_model_add(&snapshot, &model));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, scene_snapshot_model_add(&snapshot, &large_model));
+
+    /* Store, recall and delete are harmless without models. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_init(&snapshot, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&snapshot, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&snapshot, 0, 0, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_delete(&snapshot, 0));
+    TEST_ASSERT_EQUAL(0, m_entry_set_count);
+}
+
+void test_index(void)
+{
+    scene_snapshot_t snapshot;
+
+    models_add(&m_snapshot, 1);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scene_snapshot_store(NULL, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scene_snapshot_recall(NULL, 0, 0, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scene_snapshot_delete(NULL, 0));
+
+    /* Scene indices of other instances are rejected. */
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scene_snapshot_store(&m_snapshot, SCENE_REGISTER_ARRAY_SIZE));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scene_snapshot_recall(&m_snapshot, SCENE_REGISTER_ARRAY_SIZE, 0, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scene_snapshot_delete(&m_snapshot, SCENE_REGISTER_ARRAY_SIZE));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_init(&snapshot, 1));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_model_add(&snapshot, &m_models[1].model));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scene_snapshot_store(&snapshot, SCENE_REGISTER_ARRAY_SIZE - 1));
+
+    /* Both instances keep their own reference. */
+    m_models[0].state[0] = 0x11;
+    m_models[1].state[0] = 0x22;
+    m_models[1].state[1] = 0x33;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&snapshot, SCENE_REGISTER_ARRAY_SIZE));
+    TEST_ASSERT_EQUAL(4, m_entry_set_count);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, scene_snapshot_recall(&m_snapshot, 1, 0, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, 0, 0, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&snapshot, SCENE_REGISTER_ARRAY_SIZE, 0, 0));
+    TEST_ASSERT_EQUAL(0x11, m_models[0].applied[0]);
+    TEST_ASSERT_EQUAL(0x22, m_models[1].applied[0]);
+    TEST_ASSERT_EQUAL(0x33, m_models[1].applied[1]);
+}
+
+void test_store_recall(void)
+{
+    models_add(&m_snapshot, MODEL_COUNT);
+
+    for (uint32_t scene = 0; scene < SCENE_COUNT; scene++)
+    {
+        scene_states_set(scene);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, scene));
+    }
+
+    /* One entry per scene, and the reference. */
+    TEST_ASSERT_EQUAL(SCENE_COUNT + 1, m_entry_set_count);
+
+    for (uint32_t scene = 0; scene < SCENE_COUNT; scene++)
+    {
+        uint32_t scene_index = (scene * 5) % SCENE_COUNT;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, scene_index, 100 + scene, 2000 + scene));
+
+        for (uint32_t i = 0; i < MODEL_COUNT; i++)
+        {
+            TEST_ASSERT_EQUAL(scene + 1, m_models[i].apply_count);
+            TEST_ASSERT_EQUAL(100 + scene, m_models[i].delay_ms);
+            TEST_ASSERT_EQUAL(2000 + scene, m_models[i].transition_time_ms);
+        }
+        applied_states_check(scene_index);
+    }
+
+    /* Storing over a scene replaces its record only. */
+    scene_states_set(40);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 3));
+    TEST_ASSERT_EQUAL(SCENE_COUNT + 2, m_entry_set_count);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, 3, 0, 0));
+    applied_states_check(40);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, 4, 0, 0));
+    applied_states_check(4);
+}
+
+void test_delta_encoding(void)
+{
+    uint8_t record[SCENE_SNAPSHOT_RECORD_SIZE];
+
+    models_add(&m_snapshot, MODEL_COUNT);
+
+    /* The first scene becomes the reference, and has no differences. */
+    scene_states_set(0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 0));
+    TEST_ASSERT_EQUAL(2, m_entry_set_count);
+    record_get(0, record);
+    TEST_ASSERT_EQUAL(m_snapshot.state_size, record[RECORD_STATE_SIZE]);
+    TEST_ASSERT_EQUAL(0, record[RECORD_LENGTH]);
+
+    /* Same as the reference. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 1));
+    record_get(1, record);
+    TEST_ASSERT_EQUAL(0, record[RECORD_LENGTH]);
+
+    /* One byte differs. */
+    m_models[3].state[2] ^= 0xFF;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 2));
+    record_get(2, record);
+    TEST_ASSERT_EQUAL(3, record[RECORD_LENGTH]);
+    TEST_ASSERT_EQUAL(m_models[3].model.offset + 2, record[RECORD_RUNS]);
+    TEST_ASSERT_EQUAL(1, record[RECORD_RUNS + 1]);
+    TEST_ASSERT_EQUAL(m_models[3].state[2], record[RECORD_RUNS + 2]);
+
+    /* Two equal bytes between differences are cheaper to keep in the run than a new run. */
+    m_models[3].state[5] ^= 0xFF;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 3));
+    record_get(3, record);
+    TEST_ASSERT_EQUAL(2 + 4, record[RECORD_LENGTH]);
+
+    /* Three are not. */
+    m_models[3].state[5] ^= 0xFF;
+    m_models[4].state[0] ^= 0xFF;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 4));
+    record_get(4, record);
+    TEST_ASSERT_EQUAL(3 + 3, record[RECORD_LENGTH]);
+
+    /* Everything differs, and doesn't fit. */
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        memset(m_models[i].state, 0xEE, m_models[i].model.state_size);
+    }
+    uint32_t set_count = m_entry_set_count;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, scene_snapshot_store(&m_snapshot, 5));
+    TEST_ASSERT_EQUAL(set_count, m_entry_set_count);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, scene_snapshot_recall(&m_snapshot, 5, 0, 0));
+
+    /* The recalled states are the stored ones. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, 4, 0, 0));
+    scene_states_set(0);
+    m_models[3].state[2] ^= 0xFF;
+    m_models[4].state[0] ^= 0xFF;
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(m_models[i].state, m_models[i].applied, m_models[i].model.state_size);
+    }
+}
+
+void test_delete(void)
+{
+    models_add(&m_snapshot, MODEL_COUNT);
+
+    scene_states_set(0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 0));
+    scene_states_set(1);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 1));
+
+    /* Deleting a scene that isn't stored does nothing. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_delete(&m_snapshot, 2));
+    TEST_ASSERT_EQUAL(0, m_entry_delete_count);
+
+    /* The reference stays while a scene depends on it. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_delete(&m_snapshot, 0));
+    TEST_ASSERT_EQUAL(1, m_entry_delete_count);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, scene_snapshot_recall(&m_snapshot, 0, 0, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, 1, 0, 0));
+    applied_states_check(1);
+
+    /* And goes with the last scene. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_delete(&m_snapshot, 1));
+    TEST_ASSERT_EQUAL(3, m_entry_delete_count);
+
+    /* The next scene becomes the new reference. */
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        memset(m_models[i].state, 0xEE, m_models[i].model.state_size);
+    }
+    uint32_t set_count = m_entry_set_count;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 7));
+    TEST_ASSERT_EQUAL(set_count + 2, m_entry_set_count);
+
+    /* A lone scene is rebased when stored over. */
+    scene_states_set(9);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, 7));
+    TEST_ASSERT_EQUAL(set_count + 4, m_entry_set_count);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, 7, 0, 0));
+    applied_states_check(9);
+
+    scene_snapshot_clear();
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, scene_snapshot_recall(&m_snapshot, 7, 0, 0));
+}
+
+void test_persistence(void)
+{
+    uint8_t reference[MESH_CONFIG_ENTRY_MAX_SIZE];
+    uint8_t records[SCENE_COUNT][SCENE_SNAPSHOT_RECORD_SIZE];
+    mesh_config_entry_id_t id = SCENE_SNAPSHOT_REFERENCE_EID;
+
+    models_add(&m_snapshot, MODEL_COUNT);
+    for (uint32_t scene = 0; scene < SCENE_COUNT; scene++)
+    {
+        scene_states_set(scene);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, scene));
+    }
+
+    m_m_scene_snapshot_reference_entry_params.callbacks.getter(id, reference);
+    for (uint32_t scene = 0; scene < SCENE_COUNT; scene++)
+    {
+        record_get(scene, records[scene]);
+    }
+
+    /* Reboot: the entries are loaded back through the setters. */
+    scene_snapshot_storage_init();
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, scene_snapshot_recall(&m_snapshot, 0, 0, 0));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_m_scene_snapshot_reference_entry_params.callbacks.setter(id, reference));
+    for (uint32_t scene = 0; scene < SCENE_COUNT; scene++)
+    {
+        id = SCENE_SNAPSHOT_RECORD_EID;
+        id.record += scene;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, m_m_scene_snapshot_record_entry_params.callbacks.setter(id, records[scene]));
+    }
+
+    for (uint32_t scene = 0; scene < SCENE_COUNT; scene++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, scene, 0, 0));
+        applied_states_check(scene);
+    }
+
+    /* Corrupt records are rejected on load. */
+    id = SCENE_SNAPSHOT_RECORD_EID;
+    records[1][RECORD_LENGTH] = SCENE_SNAPSHOT_RECORD_SIZE;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, m_m_scene_snapshot_record_entry_params.callbacks.setter(id, records[1]));
+    record_get(2, records[2]);
+    records[2][RECORD_RUNS] = m_snapshot.state_size;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, m_m_scene_snapshot_record_entry_params.callbacks.setter(id, records[2]));
+
+    /* Snapshots stored with other models don't apply. */
+    scene_snapshot_t snapshot;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_init(&snapshot, 0));
+    models_add(&snapshot, MODEL_COUNT - 1);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, scene_snapshot_recall(&snapshot, 0, 0, 0));
+}
+
+void test_recall_latency(void)
+{
+    uint64_t spread_ns = 0;
+
+    models_add(&m_snapshot, MODEL_COUNT);
+    for (uint32_t scene = 0; scene < SCENE_COUNT; scene++)
+    {
+        scene_states_set(scene);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_store(&m_snapshot, scene));
+    }
+    TEST_ASSERT_EQUAL(SCENE_COUNT + 1, m_entry_set_count);
+
+    uint64_t start_ns = time_ns_get();
+    for (uint32_t i = 0; i < BENCHMARK_RECALLS; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, scene_snapshot_recall(&m_snapshot, i % SCENE_COUNT, 0, 1000));
+
+        /* Time from the first model starting its transition to the last. */
+        spread_ns += m_models[MODEL_COUNT - 1].apply_time_ns - m_models[0].apply_time_ns;
+    }
+    uint64_t duration_ns = time_ns_get() - start_ns;
+
+    for (uint32_t i = 0; i < MODEL_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(BENCHMARK_RECALLS, m_models[i].apply_count);
+    }
+
+    printf("Scene recall, %u scenes x %u models: %llu ns per recall, %llu ns between first and last transition start, %u config entries\n",
+           SCENE_COUNT, MODEL_COUNT,
+           (unsigned long long) (duration_ns / BENCHMARK_RECALLS),
+           (unsigned long long) (spread_ns / BENCHMARK_RECALLS),
+           (unsigned) m_entry_set_count);
+}
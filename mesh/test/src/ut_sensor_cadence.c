@@ -0,0 +1,374 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sensor_cadence.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+
+#define TRIGGER_TYPE_PERCENT    (0x80)
+#define PROPERTIES_MAX          (32)
+#define BENCHMARK_SAMPLES       (200000)
+
+/* Cadence fields in host order, serialized by cadence_build(). */
+typedef struct
+{
+    uint8_t divisor;
+    bool percent;
+    int32_t delta_down;
+    int32_t delta_up;
+    uint8_t min_interval;
+    int32_t fast_low;
+    int32_t fast_high;
+} cadence_t;
+
+static sensor_cadence_eval_t m_eval;
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+
+static uint16_t cadence_build(const cadence_t * p_cadence, uint8_t value_bytes, uint8_t * p_buffer)
+{
+    uint8_t delta_bytes = p_cadence->percent ? 2 : value_bytes;
+    uint16_t offset = 0;
+
+    p_buffer[offset++] = p_cadence->divisor | (p_cadence->percent ? TRIGGER_TYPE_PERCENT : 0);
+    memcpy(&p_buffer[offset], &p_cadence->delta_down, delta_bytes);
+    offset += delta_bytes;
+    memcpy(&p_buffer[offset], &p_cadence->delta_up, delta_bytes);
+    offset += delta_bytes;
+    p_buffer[offset++] = p_cadence->min_interval;
+    memcpy(&p_buffer[offset], &p_cadence->fast_low, value_bytes);
+    offset += value_bytes;
+    memcpy(&p_buffer[offset], &p_cadence->fast_high, value_bytes);
+    offset += value_bytes;
+    return offset;
+}
+
+static void compile(sensor_cadence_eval_t * p_eval, const cadence_t * p_cadence, uint8_t value_bytes, bool is_signed)
+{
+    uint8_t buffer[32];
+    uint16_t length = cadence_build(p_cadence, value_bytes, buffer);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_cadence_compile(p_eval, value_bytes, is_signed, buffer, length));
+}
+
+static uint32_t evaluate(int32_t current, int32_t previous)
+{
+    return sensor_cadence_evaluate(&m_eval, (const uint8_t *) &current, (const uint8_t *) &previous);
+}
+
+static bool in_fast_region(int32_t value)
+{
+    return (evaluate(value, value) & SENSOR_CADENCE_FLAG_FAST_REGION) != 0;
+}
+
+static bool delta_trigger(int32_t current, int32_t previous)
+{
+    return (evaluate(current, previous) & SENSOR_CADENCE_FLAG_DELTA_TRIGGER) != 0;
+}
+
+static uint64_t time_ns_get(void)
+{
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+
+void setUp(void)
+{
+    memset(&m_eval, 0, sizeof(m_eval));
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_compile_invalid(void)
+{
+    cadence_t cadence = {.divisor = 2, .delta_down = 1, .delta_up = 1, .min_interval = 10, .fast_low = 0, .fast_high = 100};
+    uint8_t buffer[32];
+    uint16_t length = cadence_build(&cadence, 2, buffer);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_cadence_compile(NULL, 2, false, buffer, length));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_cadence_compile(&m_eval, 2, false, NULL, length));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_cadence_compile(&m_eval, 0, false, buffer, length));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_cadence_compile(&m_eval, SENSOR_CADENCE_VALUE_BYTES_MAX + 1, false, buffer, length));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_cadence_compile(&m_eval, 2, false, buffer, 0));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_cadence_compile(&m_eval, 2, false, buffer, length - 1));
+    /* The same bytes are too short for a larger value: */
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_cadence_compile(&m_eval, 3, false, buffer, length));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_cadence_compile(&m_eval, 2, false, buffer, length));
+
+    /* Percentage deltas are always 2 bytes: */
+    cadence.percent = true;
+    length = cadence_build(&cadence, 1, buffer);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_cadence_compile(&m_eval, 1, false, buffer, length - 1));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_cadence_compile(&m_eval, 1, false, buffer, length));
+
+    /* Prohibited values leave the evaluator untouched: */
+    sensor_cadence_eval_t eval = m_eval;
+    cadence.divisor = SENSOR_CADENCE_FAST_PERIOD_DIVISOR_MAX + 1;
+    length = cadence_build(&cadence, 1, buffer);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, sensor_cadence_compile(&m_eval, 1, false, buffer, length));
+    cadence.divisor = SENSOR_CADENCE_FAST_PERIOD_DIVISOR_MAX;
+    cadence.min_interval = SENSOR_CADENCE_STATUS_MIN_INTERVAL_MAX + 1;
+    length = cadence_build(&cadence, 1, buffer);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, sensor_cadence_compile(&m_eval, 1, false, buffer, length));
+    TEST_ASSERT_EQUAL_MEMORY(&eval, &m_eval, sizeof(eval));
+}
+
+void test_fast_region(void)
+{
+    /* Closed interval [Fast Cadence Low, Fast Cadence High]: */
+    cadence_t cadence = {.fast_low = 10, .fast_high = 20};
+    compile(&m_eval, &cadence, 1, false);
+    TEST_ASSERT_FALSE(in_fast_region(0));
+    TEST_ASSERT_FALSE(in_fast_region(9));
+    TEST_ASSERT_TRUE(in_fast_region(10));
+    TEST_ASSERT_TRUE(in_fast_region(20));
+    TEST_ASSERT_FALSE(in_fast_region(21));
+    TEST_ASSERT_FALSE(in_fast_region(255));
+
+    /* High lower than low: fast outside the interval (high, low) exclusive of the ends. */
+    cadence.fast_low = 20;
+    cadence.fast_high = 10;
+    compile(&m_eval, &cadence, 1, false);
+    TEST_ASSERT_TRUE(in_fast_region(0));
+    TEST_ASSERT_TRUE(in_fast_region(9));
+    TEST_ASSERT_FALSE(in_fast_region(10));
+    TEST_ASSERT_FALSE(in_fast_region(15));
+    TEST_ASSERT_FALSE(in_fast_region(20));
+    TEST_ASSERT_TRUE(in_fast_region(21));
+    TEST_ASSERT_TRUE(in_fast_region(255));
+
+    /* A single point: */
+    cadence.fast_low = 0x123456;
+    cadence.fast_high = 0x123456;
+    compile(&m_eval, &cadence, 3, false);
+    TEST_ASSERT_TRUE(in_fast_region(0x123456));
+    TEST_ASSERT_FALSE(in_fast_region(0x123455));
+    TEST_ASSERT_FALSE(in_fast_region(0x123457));
+    /* Bytes beyond the value size are ignored: */
+    TEST_ASSERT_TRUE(in_fast_region(0x7F123456));
+
+    /* Signed values across zero: */
+    cadence.fast_low = -10;
+    cadence.fast_high = 5;
+    compile(&m_eval, &cadence, 1, true);
+    TEST_ASSERT_FALSE(in_fast_region(-128));
+    TEST_ASSERT_FALSE(in_fast_region(-11));
+    TEST_ASSERT_TRUE(in_fast_region(-10));
+    TEST_ASSERT_TRUE(in_fast_region(0));
+    TEST_ASSERT_TRUE(in_fast_region(5));
+    TEST_ASSERT_FALSE(in_fast_region(6));
+    TEST_ASSERT_FALSE(in_fast_region(127));
+
+    cadence.fast_low = 2000;
+    cadence.fast_high = -2000;
+    compile(&m_eval, &cadence, 2, true);
+    TEST_ASSERT_TRUE(in_fast_region(INT16_MIN));
+    TEST_ASSERT_TRUE(in_fast_region(-2001));
+    TEST_ASSERT_FALSE(in_fast_region(-2000));
+    TEST_ASSERT_FALSE(in_fast_region(0));
+    TEST_ASSERT_FALSE(in_fast_region(2000));
+    TEST_ASSERT_TRUE(in_fast_region(2001));
+    TEST_ASSERT_TRUE(in_fast_region(INT16_MAX));
+
+    /* The full range of a 32-bit value: */
+    cadence.fast_low = 0;
+    cadence.fast_high = -1;
+    compile(&m_eval, &cadence, 4, false);
+    TEST_ASSERT_TRUE(in_fast_region(0));
+    TEST_ASSERT_TRUE(in_fast_region(INT32_MAX));
+    TEST_ASSERT_TRUE(in_fast_region(-1));
+}
+
+void test_delta_value(void)
+{
+    cadence_t cadence = {.delta_down = 3, .delta_up = 5};
+    compile(&m_eval, &cadence, 2, false);
+    TEST_ASSERT_FALSE(delta_trigger(1000, 1000));
+    TEST_ASSERT_FALSE(delta_trigger(1004, 1000));
+    TEST_ASSERT_TRUE(delta_trigger(1005, 1000));
+    TEST_ASSERT_TRUE(delta_trigger(UINT16_MAX, 0));
+    TEST_ASSERT_FALSE(delta_trigger(998, 1000));
+    TEST_ASSERT_TRUE(delta_trigger(997, 1000));
+    TEST_ASSERT_TRUE(delta_trigger(0, UINT16_MAX));
+
+    /* A zero delta never triggers: */
+    cadence.delta_up = 0;
+    compile(&m_eval, &cadence, 2, false);
+    TEST_ASSERT_FALSE(delta_trigger(UINT16_MAX, 0));
+    TEST_ASSERT_TRUE(delta_trigger(0, UINT16_MAX));
+
+    /* Signed values across zero, and negative deltas never trigger: */
+    cadence.delta_down = 20;
+    cadence.delta_up = -1;
+    compile(&m_eval, &cadence, 1, true);
+    TEST_ASSERT_FALSE(delta_trigger(-9, 10));
+    TEST_ASSERT_TRUE(delta_trigger(-10, 10));
+    TEST_ASSERT_TRUE(delta_trigger(-128, 127));
+    TEST_ASSERT_FALSE(delta_trigger(127, -128));
+
+    /* Full 32-bit range: */
+    cadence.delta_down = 1;
+    cadence.delta_up = -1;
+    compile(&m_eval, &cadence, 4, false);
+    TEST_ASSERT_TRUE(delta_trigger(0, 1));
+    TEST_ASSERT_FALSE(delta_trigger(0xFFFFFFFE, 0));
+    TEST_ASSERT_TRUE(delta_trigger(0xFFFFFFFF, 0));
+}
+
+void test_delta_percent(void)
+{
+    /* 10.00 % up, 2.50 % down: */
+    cadence_t cadence = {.percent = true, .delta_down = 250, .delta_up = 1000};
+    compile(&m_eval, &cadence, 4, false);
+    TEST_ASSERT_FALSE(delta_trigger(109999, 100000));
+    TEST_ASSERT_TRUE(delta_trigger(110000, 100000));
+    TEST_ASSERT_FALSE(delta_trigger(97501, 100000));
+    TEST_ASSERT_TRUE(delta_trigger(97500, 100000));
+    TEST_ASSERT_TRUE(delta_trigger(0, 100000));
+    /* No overflow on large values: */
+    TEST_ASSERT_TRUE(delta_trigger(0xFFFFFFFF, 0x80000000));
+    TEST_ASSERT_FALSE(delta_trigger(0xFFFFFFFF, 0xF0000000));
+    /* Any change from zero is infinite: */
+    TEST_ASSERT_TRUE(delta_trigger(1, 0));
+    TEST_ASSERT_TRUE(delta_trigger(0, 0));
+
+    cadence.delta_up = 0;
+    compile(&m_eval, &cadence, 4, false);
+    TEST_ASSERT_FALSE(delta_trigger(0xFFFFFFFF, 1));
+
+    /* Relative to the magnitude of negative values: */
+    cadence.delta_down = 1000;
+    cadence.delta_up = 1000;
+    compile(&m_eval, &cadence, 2, true);
+    TEST_ASSERT_TRUE(delta_trigger(-180, -200));
+    TEST_ASSERT_FALSE(delta_trigger(-181, -200));
+    TEST_ASSERT_TRUE(delta_trigger(-220, -200));
+    TEST_ASSERT_FALSE(delta_trigger(-219, -200));
+    TEST_ASSERT_TRUE(delta_trigger(20, -200));
+}
+
+void test_fast_period(void)
+{
+    cadence_t cadence = {.divisor = 2, .min_interval = 10};
+    compile(&m_eval, &cadence, 1, false);
+    TEST_ASSERT_TRUE(sensor_cadence_fast_period_us_get(&m_eval, 10000000) == 2500000);
+    TEST_ASSERT_TRUE(sensor_cadence_fast_period_us_get(&m_eval, 1000000) == MS_TO_US(1024ull));
+
+    cadence.divisor = 0;
+    cadence.min_interval = SENSOR_CADENCE_STATUS_MIN_INTERVAL_MAX;
+    compile(&m_eval, &cadence, 1, false);
+    TEST_ASSERT_TRUE(sensor_cadence_fast_period_us_get(&m_eval, 10000000) == MS_TO_US(1ull << 26));
+}
+
+void test_benchmark(void)
+{
+    static const struct
+    {
+        uint8_t value_bytes;
+        bool is_signed;
+        bool percent;
+    } formats[] =
+    {
+        {1, false, false}, {1, true, true}, {2, false, true}, {2, true, false},
+        {3, false, false}, {4, false, true}, {4, false, false}, {1, false, true},
+    };
+    static sensor_cadence_eval_t evals[PROPERTIES_MAX];
+    static uint32_t values[2][PROPERTIES_MAX];
+
+    for (uint32_t i = 0; i < PROPERTIES_MAX; i++)
+    {
+        uint32_t format = i % ARRAY_SIZE(formats);
+        cadence_t cadence = {.percent = formats[format].percent, .delta_down = 100, .delta_up = 50,
+                             .fast_low = (int32_t) (i * 7), .fast_high = (int32_t) (i * 3)};
+        compile(&evals[i], &cadence, formats[format].value_bytes, formats[format].is_signed);
+    }
+
+    const uint32_t property_counts[] = {1, 8, 32};
+    uint32_t rand_state = 1;
+    for (uint32_t i = 0; i < ARRAY_SIZE(property_counts); i++)
+    {
+        uint32_t samples = 0;
+        uint32_t fast_count = 0;
+        uint32_t trigger_count = 0;
+        uint64_t start_ns = time_ns_get();
+        while (samples < BENCHMARK_SAMPLES)
+        {
+            uint32_t current = samples & 1;
+            for (uint32_t j = 0; j < property_counts[i]; j++)
+            {
+                rand_state = rand_state * 1103515245u + 12345u;
+                values[current][j] = (values[!current][j] + (rand_state >> 24)) & 0xFF;
+                uint32_t flags = sensor_cadence_evaluate(&evals[j],
+                                                         (const uint8_t *) &values[current][j],
+                                                         (const uint8_t *) &values[!current][j]);
+                fast_count += (flags & SENSOR_CADENCE_FLAG_FAST_REGION) ? 1 : 0;
+                trigger_count += (flags & SENSOR_CADENCE_FLAG_DELTA_TRIGGER) ? 1 : 0;
+                samples++;
+            }
+        }
+        uint64_t duration_ns = time_ns_get() - start_ns;
+
+        TEST_ASSERT_TRUE(fast_count > 0 && fast_count < samples);
+        TEST_ASSERT_TRUE(trigger_count > 0 && trigger_count < samples);
+        printf("sensor_cadence: %2u properties: %6u ksamples/s (%u ns per sample)\n",
+               property_counts[i],
+               (uint32_t) (((uint64_t) samples * 1000000ull) / duration_ns),
+               (uint32_t) (duration_ns / samples));
+    }
+}
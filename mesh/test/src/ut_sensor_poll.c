@@ -0,0 +1,744 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sensor_poll.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "sensor_client.h"
+#include "sensor_utils.h"
+#include "access_mock.h"
+#include "access_config_mock.h"
+#include "access_reliable_mock.h"
+#include "device_state_manager_mock.h"
+#include "nrf_mesh_mock.h"
+
+#define SERVER_COUNT            (50)
+#define SERVER_ADDRESS_BASE     (0x0100)
+#define GROUP_ADDRESS_HANDLE    (SERVER_COUNT)
+#define CONTEXT_COUNT           (4)
+#define PROPERTY_COUNT          (4)
+#define VALUE_BYTES             (2)
+#define MESSAGE_BUFFER_BYTES    (8)
+
+/* Simulated network: the request and every segment of the response take HOP_MS each. */
+#define HOP_MS                  (30)
+#define TIMEOUT_MS              (1000)
+#define EVENTS_MAX              (16)
+
+typedef struct
+{
+    bool in_use;
+    uint32_t time_ms;
+    access_model_handle_t handle;
+    uint16_t address;
+    uint16_t property_id;
+    access_reliable_status_t status;
+} event_t;
+
+static const uint16_t m_property_ids[PROPERTY_COUNT] = {0x0042, 0x004D, 0x0059, 0x0801};
+static const uint16_t m_two_property_ids[] = {0x004D, 0x0801};
+static const uint16_t m_one_property_id[] = {0x0059};
+
+static sensor_client_t m_clients[CONTEXT_COUNT];
+static uint8_t m_message_buffer[CONTEXT_COUNT][MESSAGE_BUFFER_BYTES];
+static sensor_poll_context_t m_contexts[CONTEXT_COUNT];
+static sensor_poll_server_t m_servers[SERVER_COUNT * PROPERTY_COUNT];
+static sensor_poll_t m_poll;
+
+static const access_opcode_handler_t * mp_opcode_handlers[CONTEXT_COUNT];
+static uint16_t m_opcode_counts[CONTEXT_COUNT];
+static void * mp_model_args[CONTEXT_COUNT];
+static uint16_t m_publish_address[CONTEXT_COUNT];
+static bool m_in_flight[CONTEXT_COUNT];
+
+static event_t m_events[EVENTS_MAX];
+static uint32_t m_now_ms;
+static uint32_t m_request_count;
+static uint32_t m_in_flight_max;
+static uint32_t m_cancel_count;
+static uint8_t m_drop_count[SERVER_COUNT];
+static uint32_t m_status_count[SERVER_COUNT * PROPERTY_COUNT];
+static uint32_t m_value_count;
+static uint8_t m_expected_value_count;
+static uint32_t m_cycle_count;
+static uint16_t m_failed_count;
+
+/*****************************************************************************
+* Simulated servers
+*****************************************************************************/
+
+static uint16_t raw_value_get(uint16_t address, uint16_t property_id)
+{
+    return address ^ property_id;
+}
+
+/* Builds the Sensor Status of a server, for one property or all of them. */
+static uint16_t status_build(uint16_t address, uint16_t property_id, uint8_t * p_buffer)
+{
+    uint16_t length = 0;
+
+    for (uint32_t i = 0; i < PROPERTY_COUNT; i++)
+    {
+        if (property_id != 0 && property_id != m_property_ids[i])
+        {
+            continue;
+        }
+
+        /* Length is defined as 0-0xF representing 1-16, therefore - 1 */
+        if (m_property_ids[i] < 0x0800)
+        {
+            sensor_mpid_a_create(m_property_ids[i], VALUE_BYTES - 1, &p_buffer[length]);
+            length += SENSOR_MPID_A_BYTES;
+        }
+        else
+        {
+            sensor_mpid_b_create(m_property_ids[i], VALUE_BYTES - 1, &p_buffer[length]);
+            length += SENSOR_MPID_B_BYTES;
+        }
+
+        uint16_t value = raw_value_get(address, m_property_ids[i]);
+        memcpy(&p_buffer[length], &value, VALUE_BYTES);
+        length += VALUE_BYTES;
+    }
+    return length;
+}
+
+/* The request takes one hop, the response one per segment. */
+static uint32_t round_trip_ms_get(uint16_t status_length)
+{
+    /* One byte opcode and a four byte TransMIC: 15 bytes fit unsegmented, 12 per segment otherwise. */
+    uint16_t pdu_length = 1 + status_length + 4;
+    uint32_t segments = (pdu_length <= 15) ? 1 : (pdu_length + 11) / 12;
+    return HOP_MS + segments * HOP_MS;
+}
+
+static void event_add(uint32_t time_ms, access_model_handle_t handle, uint16_t address,
+                      uint16_t property_id, access_reliable_status_t status)
+{
+    for (uint32_t i = 0; i < EVENTS_MAX; i++)
+    {
+        if (!m_events[i].in_use)
+        {
+            m_events[i] = (event_t) {true, time_ms, handle, address, property_id, status};
+            return;
+        }
+    }
+    TEST_FAIL_MESSAGE("Event queue full");
+}
+
+static void status_deliver(access_model_handle_t handle, uint16_t address, uint16_t property_id)
+{
+    uint8_t buffer[SENSOR_STATUS_MAXLEN];
+    access_message_rx_t message;
+
+    memset(&message, 0, sizeof(message));
+    message.opcode.opcode = SENSOR_OPCODE_STATUS;
+    message.opcode.company_id = ACCESS_COMPANY_ID_NONE;
+    message.p_data = buffer;
+    message.length = status_build(address, property_id, buffer);
+    message.meta_data.src.type = NRF_MESH_ADDRESS_TYPE_UNICAST;
+    message.meta_data.src.value = address;
+
+    for (uint32_t i = 0; i < m_opcode_counts[handle]; i++)
+    {
+        if (mp_opcode_handlers[handle][i].opcode.opcode == SENSOR_OPCODE_STATUS)
+        {
+            mp_opcode_handlers[handle][i].handler(handle, &message, mp_model_args[handle]);
+            return;
+        }
+    }
+    TEST_FAIL_MESSAGE("No status handler");
+}
+
+/* Runs the simulation until there are no events left. */
+static void events_run(void)
+{
+    for (;;)
+    {
+        event_t * p_event = NULL;
+        for (uint32_t i = 0; i < EVENTS_MAX; i++)
+        {
+            if (m_events[i].in_use && (p_event == NULL || m_events[i].time_ms < p_event->time_ms))
+            {
+                p_event = &m_events[i];
+            }
+        }
+
+        if (p_event == NULL)
+        {
+            return;
+        }
+
+        event_t event = *p_event;
+        p_event->in_use = false;
+        m_now_ms = event.time_ms;
+        m_in_flight[event.handle] = false;
+
+        /* Same order as access_reliable_message_rx_cb() and the opcode handler in the access layer. */
+        m_clients[event.handle].settings.p_callbacks->ack_transaction_status_cb(event.handle,
+                                                                                mp_model_args[event.handle],
+                                                                                event.status);
+        if (event.status == ACCESS_RELIABLE_TRANSFER_SUCCESS)
+        {
+            status_deliver(event.handle, event.address, event.property_id);
+        }
+    }
+}
+
+/*****************************************************************************
+* Mock callbacks
+*****************************************************************************/
+
+static uint32_t access_model_add_cb(const access_model_add_params_t * p_params,
+                                    access_model_handle_t * p_model_handle,
+                                    int num_calls)
+{
+    TEST_ASSERT_TRUE(num_calls < CONTEXT_COUNT);
+    *p_model_handle = num_calls;
+    mp_opcode_handlers[num_calls] = p_params->p_opcode_handlers;
+    m_opcode_counts[num_calls] = p_params->opcode_count;
+    mp_model_args[num_calls] = p_params->p_args;
+    return NRF_SUCCESS;
+}
+
+static uint32_t access_model_subscription_list_alloc_cb(access_model_handle_t handle, int num_calls)
+{
+    return NRF_SUCCESS;
+}
+
+static uint32_t access_model_publish_address_override_set_cb(access_model_handle_t handle,
+                                                             dsm_handle_t address_handle,
+                                                             int num_calls)
+{
+    if (address_handle == DSM_HANDLE_INVALID)
+    {
+        m_publish_address[handle] = NRF_MESH_ADDR_UNASSIGNED;
+    }
+    else
+    {
+        TEST_ASSERT_TRUE(address_handle < SERVER_COUNT);
+        m_publish_address[handle] = SERVER_ADDRESS_BASE + address_handle;
+    }
+    return NRF_SUCCESS;
+}
+
+static bool access_reliable_model_is_free_cb(access_model_handle_t handle, int num_calls)
+{
+    return !m_in_flight[handle];
+}
+
+static uint32_t access_model_reliable_publish_cb(const access_reliable_t * p_reliable, int num_calls)
+{
+    access_model_handle_t handle = p_reliable->model_handle;
+    uint16_t address = m_publish_address[handle];
+    uint16_t property_id = 0;
+
+    TEST_ASSERT_FALSE(m_in_flight[handle]);
+    TEST_ASSERT_NOT_EQUAL(NRF_MESH_ADDR_UNASSIGNED, address);
+    TEST_ASSERT_EQUAL(SENSOR_OPCODE_GET, p_reliable->message.opcode.opcode);
+    TEST_ASSERT_EQUAL(SENSOR_OPCODE_STATUS, p_reliable->reply_opcode.opcode);
+    if (p_reliable->message.length == sizeof(uint16_t))
+    {
+        memcpy(&property_id, p_reliable->message.p_buffer, sizeof(uint16_t));
+    }
+    else
+    {
+        TEST_ASSERT_EQUAL(0, p_reliable->message.length);
+    }
+
+    m_in_flight[handle] = true;
+    m_request_count++;
+
+    uint32_t in_flight = 0;
+    for (uint32_t i = 0; i < CONTEXT_COUNT; i++)
+    {
+        in_flight += m_in_flight[i];
+    }
+    m_in_flight_max = MAX(m_in_flight_max, in_flight);
+
+    uint16_t server = address - SERVER_ADDRESS_BASE;
+    if (m_drop_count[server] > 0)
+    {
+        m_drop_count[server]--;
+        event_add(m_now_ms + TIMEOUT_MS, handle, address, property_id, ACCESS_RELIABLE_TRANSFER_TIMEOUT);
+    }
+    else
+    {
+        uint8_t buffer[SENSOR_STATUS_MAXLEN];
+        event_add(m_now_ms + round_trip_ms_get(status_build(address, property_id, buffer)),
+                  handle, address, property_id, ACCESS_RELIABLE_TRANSFER_SUCCESS);
+    }
+    return NRF_SUCCESS;
+}
+
+static uint32_t access_model_reliable_cancel_cb(access_model_handle_t handle, int num_calls)
+{
+    TEST_ASSERT_TRUE(m_in_flight[handle]);
+    for (uint32_t i = 0; i < EVENTS_MAX; i++)
+    {
+        if (m_events[i].in_use && m_events[i].handle == handle)
+        {
+            m_events[i].in_use = false;
+        }
+    }
+    m_in_flight[handle] = false;
+    m_cancel_count++;
+    m_clients[handle].settings.p_callbacks->ack_transaction_status_cb(handle, mp_model_args[handle],
+                                                                      ACCESS_RELIABLE_TRANSFER_CANCELLED);
+    return NRF_SUCCESS;
+}
+
+static uint32_t dsm_address_get_cb(dsm_handle_t address_handle, nrf_mesh_address_t * p_address, int num_calls)
+{
+    if (address_handle == GROUP_ADDRESS_HANDLE)
+    {
+        p_address->type = NRF_MESH_ADDRESS_TYPE_GROUP;
+        p_address->value = 0xC000;
+    }
+    else
+    {
+        p_address->type = NRF_MESH_ADDRESS_TYPE_UNICAST;
+        p_address->value = SERVER_ADDRESS_BASE + address_handle;
+    }
+    return NRF_SUCCESS;
+}
+
+static nrf_mesh_tx_token_t nrf_mesh_unique_token_get_cb(int num_calls)
+{
+    return (nrf_mesh_tx_token_t) num_calls;
+}
+
+/*****************************************************************************
+* Client and scheduler callbacks
+*****************************************************************************/
+
+static void client_status_cb(const sensor_client_t * p_self,
+                             const access_message_rx_meta_t * p_meta,
+                             const sensor_status_msg_pkt_t * p_in,
+                             uint16_t length)
+{
+    (void) sensor_poll_status_handle(&m_poll, p_self, p_meta, p_in, length);
+}
+
+static void client_transaction_cb(access_model_handle_t model_handle, void * p_args, access_reliable_status_t status)
+{
+    TEST_ASSERT_TRUE(sensor_poll_transaction_handle(&m_poll, model_handle, status));
+}
+
+static void client_descriptor_status_cb(const sensor_client_t * p_self, const access_message_rx_meta_t * p_meta,
+                                        const sensor_descriptor_t * p_in, uint16_t num_descriptors) {}
+static void client_cadence_status_cb(const sensor_client_t * p_self, const access_message_rx_meta_t * p_meta,
+                                     const sensor_cadence_status_msg_pkt_t * p_in, uint16_t length) {}
+static void client_column_status_cb(const sensor_client_t * p_self, const access_message_rx_meta_t * p_meta,
+                                    const sensor_column_status_msg_pkt_t * p_in, uint16_t length) {}
+static void client_series_status_cb(const sensor_client_t * p_self, const access_message_rx_meta_t * p_meta,
+                                    const sensor_series_status_msg_pkt_t * p_in, uint16_t length) {}
+static void client_settings_status_cb(const sensor_client_t * p_self, const access_message_rx_meta_t * p_meta,
+                                      const sensor_settings_status_msg_pkt_t * p_in, uint16_t length) {}
+static void client_setting_status_cb(const sensor_client_t * p_self, const access_message_rx_meta_t * p_meta,
+                                     const sensor_setting_status_msg_pkt_t * p_in, uint16_t length) {}
+static void client_publish_cb(access_model_handle_t handle, void * p_args) {}
+
+static const sensor_client_callbacks_t m_client_cbs =
+{
+    .sensor_status_cb = client_status_cb,
+    .sensor_descriptor_status_cb = client_descriptor_status_cb,
+    .sensor_cadence_status_cb = client_cadence_status_cb,
+    .sensor_column_status_cb = client_column_status_cb,
+    .sensor_series_status_cb = client_series_status_cb,
+    .sensor_settings_status_cb = client_settings_status_cb,
+    .sensor_setting_status_cb = client_setting_status_cb,
+    .ack_transaction_status_cb = client_transaction_cb,
+    .periodic_publish_cb = client_publish_cb
+};
+
+static void poll_status_cb(const sensor_poll_t * p_poll,
+                           uint16_t server_index,
+                           const sensor_poll_value_t * p_values,
+                           uint8_t value_count)
+{
+    const sensor_poll_server_t * p_server = &p_poll->p_servers[server_index];
+
+    TEST_ASSERT_EQUAL_PTR(&m_poll, p_poll);
+    if (m_expected_value_count > 0)
+    {
+        TEST_ASSERT_EQUAL(m_expected_value_count, value_count);
+    }
+    else
+    {
+        TEST_ASSERT_EQUAL(p_server->property_count ? p_server->property_count : PROPERTY_COUNT, value_count);
+    }
+
+    for (uint32_t i = 0; i < value_count; i++)
+    {
+        uint16_t value = 0;
+
+        if (p_server->property_count > 0)
+        {
+            TEST_ASSERT_EQUAL_HEX16(p_server->p_property_ids[i], p_values[i].property_id);
+        }
+        TEST_ASSERT_EQUAL(VALUE_BYTES, p_values[i].length);
+        memcpy(&value, p_values[i].p_raw_value, VALUE_BYTES);
+        TEST_ASSERT_EQUAL_HEX16(raw_value_get(p_server->address, p_values[i].property_id), value);
+    }
+
+    m_status_count[server_index]++;
+    m_value_count += value_count;
+}
+
+static void poll_cycle_cb(const sensor_poll_t * p_poll, uint16_t failed_count)
+{
+    TEST_ASSERT_EQUAL_PTR(&m_poll, p_poll);
+    m_cycle_count++;
+    m_failed_count = failed_count;
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+
+/* Every third server has all, two or one of its properties wanted. */
+static void servers_setup(void)
+{
+    for (uint32_t i = 0; i < SERVER_COUNT; i++)
+    {
+        m_servers[i].address_handle = i;
+        switch (i % 3)
+        {
+            case 0:
+                m_servers[i].p_property_ids = NULL;
+                m_servers[i].property_count = 0;
+                break;
+            case 1:
+                m_servers[i].p_property_ids = m_two_property_ids;
+                m_servers[i].property_count = ARRAY_SIZE(m_two_property_ids);
+                break;
+            default:
+                m_servers[i].p_property_ids = m_one_property_id;
+                m_servers[i].property_count = ARRAY_SIZE(m_one_property_id);
+                break;
+        }
+    }
+}
+
+static void poll_setup(uint16_t server_count, uint8_t context_count, uint8_t retries)
+{
+    m_poll.p_servers = m_servers;
+    m_poll.server_count = server_count;
+    m_poll.p_contexts = m_contexts;
+    m_poll.context_count = context_count;
+    m_poll.retries = retries;
+    m_poll.status_cb = poll_status_cb;
+    m_poll.cycle_cb = poll_cycle_cb;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_poll_init(&m_poll));
+}
+
+/* Runs a poll cycle and returns its duration. */
+static uint32_t cycle_run(void)
+{
+    uint32_t start_ms = m_now_ms;
+    uint32_t cycle_count = m_cycle_count;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_poll_cycle_start(&m_poll));
+    events_run();
+    TEST_ASSERT_EQUAL(cycle_count + 1, m_cycle_count);
+    return m_now_ms - start_ms;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+
+void setUp(void)
+{
+    access_mock_Init();
+    access_config_mock_Init();
+    access_reliable_mock_Init();
+    device_state_manager_mock_Init();
+    nrf_mesh_mock_Init();
+
+    access_model_add_StubWithCallback(access_model_add_cb);
+    access_model_subscription_list_alloc_StubWithCallback(access_model_subscription_list_alloc_cb);
+    access_model_publish_address_override_set_StubWithCallback(access_model_publish_address_override_set_cb);
+    access_reliable_model_is_free_StubWithCallback(access_reliable_model_is_free_cb);
+    access_model_reliable_publish_StubWithCallback(access_model_reliable_publish_cb);
+    access_model_reliable_cancel_StubWithCallback(access_model_reliable_cancel_cb);
+    dsm_address_get_StubWithCallback(dsm_address_get_cb);
+    nrf_mesh_unique_token_get_StubWithCallback(nrf_mesh_unique_token_get_cb);
+
+    memset(m_events, 0, sizeof(m_events));
+    memset(m_in_flight, 0, sizeof(m_in_flight));
+    memset(m_drop_count, 0, sizeof(m_drop_count));
+    memset(m_status_count, 0, sizeof(m_status_count));
+    memset(&m_poll, 0, sizeof(m_poll));
+    m_now_ms = 0;
+    m_request_count = 0;
+    m_in_flight_max = 0;
+    m_cancel_count = 0;
+    m_value_count = 0;
+    m_expected_value_count = 0;
+    m_cycle_count = 0;
+    m_failed_count = 0;
+
+    for (uint32_t i = 0; i < CONTEXT_COUNT; i++)
+    {
+        memset(&m_clients[i], 0, sizeof(m_clients[i]));
+        m_clients[i].settings.p_callbacks = &m_client_cbs;
+        m_clients[i].p_message_buffer = m_message_buffer[i];
+        m_clients[i].message_buffer_bytes = MESSAGE_BUFFER_BYTES;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_client_init(&m_clients[i], i));
+        m_contexts[i].p_client = &m_clients[i];
+    }
+
+    servers_setup();
+}
+
+void tearDown(void)
+{
+    access_mock_Verify();
+    access_mock_Destroy();
+    access_config_mock_Verify();
+    access_config_mock_Destroy();
+    access_reliable_mock_Verify();
+    access_reliable_mock_Destroy();
+    device_state_manager_mock_Verify();
+    device_state_manager_mock_Destroy();
+    nrf_mesh_mock_Verify();
+    nrf_mesh_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_init(void)
+{
+    m_poll.p_servers = m_servers;
+    m_poll.server_count = SERVER_COUNT;
+    m_poll.p_contexts = m_contexts;
+    m_poll.context_count = CONTEXT_COUNT;
+    m_poll.status_cb = poll_status_cb;
+    m_poll.cycle_cb = poll_cycle_cb;
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_poll_init(NULL));
+    m_poll.cycle_cb = NULL;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_poll_init(&m_poll));
+    m_poll.cycle_cb = poll_cycle_cb;
+
+    m_poll.context_count = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_poll_init(&m_poll));
+    m_poll.context_count = CONTEXT_COUNT;
+    m_poll.server_count = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_poll_init(&m_poll));
+    m_poll.server_count = SERVER_COUNT;
+
+    m_contexts[1].p_client = &m_clients[0];
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_poll_init(&m_poll));
+    m_contexts[1].p_client = &m_clients[1];
+
+    m_servers[5].p_property_ids = NULL;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_poll_init(&m_poll));
+    servers_setup();
+
+    m_servers[7].address_handle = GROUP_ADDRESS_HANDLE;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR, sensor_poll_init(&m_poll));
+    servers_setup();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_poll_init(&m_poll));
+    TEST_ASSERT_EQUAL(SERVER_ADDRESS_BASE + 7, m_servers[7].address);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_poll_cycle_start(NULL));
+}
+
+void test_cycle(void)
+{
+    poll_setup(SERVER_COUNT, CONTEXT_COUNT, 0);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_poll_cycle_start(&m_poll));
+    TEST_ASSERT_EQUAL(CONTEXT_COUNT, m_request_count);
+    TEST_ASSERT_EQUAL(NRF_ERROR_BUSY, sensor_poll_cycle_start(&m_poll));
+    events_run();
+
+    /* One request per server, with the contexts in use at the same time. */
+    TEST_ASSERT_EQUAL(SERVER_COUNT, m_request_count);
+    TEST_ASSERT_EQUAL(CONTEXT_COUNT, m_in_flight_max);
+    TEST_ASSERT_EQUAL(1, m_cycle_count);
+    TEST_ASSERT_EQUAL(0, m_failed_count);
+    for (uint32_t i = 0; i < SERVER_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(1, m_status_count[i]);
+    }
+
+    /* The clients publish to their own publish address again after the cycle. */
+    for (uint32_t i = 0; i < CONTEXT_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_MESH_ADDR_UNASSIGNED, m_publish_address[i]);
+    }
+
+    /* A status that isn't a response to the scheduler: */
+    access_message_rx_meta_t meta = {.src = {.type = NRF_MESH_ADDRESS_TYPE_UNICAST, .value = SERVER_ADDRESS_BASE}};
+    uint8_t status[8];
+    uint16_t length = status_build(SERVER_ADDRESS_BASE, 0x0042, status);
+    TEST_ASSERT_FALSE(sensor_poll_status_handle(&m_poll, &m_clients[0], &meta, status, length));
+
+    /* The next cycle starts over. */
+    (void) cycle_run();
+    TEST_ASSERT_EQUAL(2 * SERVER_COUNT, m_request_count);
+    for (uint32_t i = 0; i < SERVER_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(2, m_status_count[i]);
+    }
+}
+
+void test_malformed_status(void)
+{
+    m_servers[0].p_property_ids = m_property_ids;
+    m_servers[0].property_count = 2;
+    poll_setup(1, 1, 0);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_poll_cycle_start(&m_poll));
+    m_in_flight[0] = false;
+    m_events[0].in_use = false;
+
+    /* The second property is cut short, so only the first one is delivered. */
+    uint8_t status[SENSOR_STATUS_MAXLEN];
+    access_message_rx_meta_t meta = {.src = {.type = NRF_MESH_ADDRESS_TYPE_UNICAST, .value = SERVER_ADDRESS_BASE}};
+    (void) status_build(SERVER_ADDRESS_BASE, 0, status);
+
+    m_expected_value_count = 1;
+    TEST_ASSERT_TRUE(sensor_poll_status_handle(&m_poll, &m_clients[0], &meta, status,
+                                               SENSOR_MPID_A_BYTES + VALUE_BYTES + SENSOR_MPID_A_BYTES + 1));
+    TEST_ASSERT_EQUAL(1, m_status_count[0]);
+    TEST_ASSERT_EQUAL(1, m_value_count);
+    TEST_ASSERT_EQUAL(1, m_cycle_count);
+}
+
+void test_timeout(void)
+{
+    poll_setup(SERVER_COUNT, CONTEXT_COUNT, 1);
+
+    /* Server 3 misses the first request, server 7 doesn't respond at all. */
+    m_drop_count[3] = 1;
+    m_drop_count[7] = 2;
+    (void) cycle_run();
+
+    TEST_ASSERT_EQUAL(SERVER_COUNT + 2, m_request_count);
+    TEST_ASSERT_EQUAL(1, m_failed_count);
+    TEST_ASSERT_EQUAL(1, m_status_count[3]);
+    TEST_ASSERT_EQUAL(0, m_status_count[7]);
+
+    /* Without retries: */
+    poll_setup(SERVER_COUNT, CONTEXT_COUNT, 0);
+    m_drop_count[3] = 1;
+    m_request_count = 0;
+    (void) cycle_run();
+    TEST_ASSERT_EQUAL(SERVER_COUNT, m_request_count);
+    TEST_ASSERT_EQUAL(1, m_failed_count);
+    TEST_ASSERT_EQUAL(1, m_status_count[3]);
+}
+
+void test_stop(void)
+{
+    poll_setup(SERVER_COUNT, CONTEXT_COUNT, 0);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_poll_cycle_start(&m_poll));
+    sensor_poll_stop(&m_poll);
+    TEST_ASSERT_EQUAL(CONTEXT_COUNT, m_cancel_count);
+    for (uint32_t i = 0; i < CONTEXT_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_MESH_ADDR_UNASSIGNED, m_publish_address[i]);
+    }
+    events_run();
+    TEST_ASSERT_EQUAL(CONTEXT_COUNT, m_request_count);
+    TEST_ASSERT_EQUAL(0, m_cycle_count);
+
+    /* Stopping an idle scheduler does nothing. */
+    sensor_poll_stop(&m_poll);
+    TEST_ASSERT_EQUAL(CONTEXT_COUNT, m_cancel_count);
+
+    (void) cycle_run();
+    TEST_ASSERT_EQUAL(0, m_failed_count);
+    for (uint32_t i = 0; i < SERVER_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(1, m_status_count[i]);
+    }
+}
+
+void test_cycle_time(void)
+{
+    /* One Sensor Get per property on a single client, as without the scheduler. */
+    for (uint32_t i = 0; i < SERVER_COUNT * PROPERTY_COUNT; i++)
+    {
+        m_servers[i].address_handle = i / PROPERTY_COUNT;
+        m_servers[i].p_property_ids = &m_property_ids[i % PROPERTY_COUNT];
+        m_servers[i].property_count = 1;
+    }
+    poll_setup(SERVER_COUNT * PROPERTY_COUNT, 1, 0);
+    uint32_t single_ms = cycle_run();
+    TEST_ASSERT_EQUAL(SERVER_COUNT * PROPERTY_COUNT, m_request_count);
+    TEST_ASSERT_EQUAL(SERVER_COUNT * PROPERTY_COUNT, m_value_count);
+
+    /* One Sensor Get per server, spread over the contexts. */
+    uint32_t cycle_ms[CONTEXT_COUNT + 1];
+    for (uint32_t contexts = 1; contexts <= CONTEXT_COUNT; contexts++)
+    {
+        for (uint32_t i = 0; i < SERVER_COUNT; i++)
+        {
+            m_servers[i].address_handle = i;
+            m_servers[i].p_property_ids = NULL;
+            m_servers[i].property_count = 0;
+        }
+        poll_setup(SERVER_COUNT, contexts, 0);
+        m_request_count = 0;
+        m_value_count = 0;
+        cycle_ms[contexts] = cycle_run();
+        TEST_ASSERT_EQUAL(SERVER_COUNT, m_request_count);
+        TEST_ASSERT_EQUAL(SERVER_COUNT * PROPERTY_COUNT, m_value_count);
+    }
+
+    TEST_ASSERT_TRUE(cycle_ms[1] < single_ms);
+    TEST_ASSERT_TRUE(cycle_ms[CONTEXT_COUNT] < cycle_ms[1]);
+
+    printf("sensor_poll: %u servers x %u properties, %u ms per hop: per-property gets %u ms, "
+           "batched gets %u ms (1 context), %u ms (%u contexts)\n",
+           SERVER_COUNT, PROPERTY_COUNT, HOP_MS, single_ms, cycle_ms[1], cycle_ms[CONTEXT_COUNT], CONTEXT_COUNT);
+}
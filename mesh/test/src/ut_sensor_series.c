@@ -0,0 +1,386 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sensor_series.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+
+#define PROPERTY_ID         (0x0052)
+#define X_BYTES             (2)
+#define Y_BYTES             (3)
+#define COLUMN_BYTES        SENSOR_SERIES_COLUMN_BYTES(X_BYTES, Y_BYTES)
+#define LARGE_COLUMNS       (4096)
+#define LARGE_QUERIES       (20000)
+
+static sensor_series_t m_series;
+static uint8_t m_buffer[LARGE_COLUMNS * SENSOR_SERIES_COLUMN_BYTES(4, 2)];
+static uint8_t m_out[LARGE_COLUMNS * SENSOR_SERIES_COLUMN_BYTES(4, 2) + 2];
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+
+static uint32_t column_set(uint32_t raw_x, uint32_t width, uint32_t raw_y)
+{
+    return sensor_series_column_set(&m_series, (const uint8_t *) &raw_x, (const uint8_t *) &width, (const uint8_t *) &raw_y);
+}
+
+static uint16_t params_build(uint8_t * p_params, uint16_t property_id, const uint32_t * p_raw_x, uint32_t x_count)
+{
+    memcpy(p_params, &property_id, 2);
+    for (uint32_t i = 0; i < x_count; i++)
+    {
+        memcpy(&p_params[2 + i * m_series.x_bytes], &p_raw_x[i], m_series.x_bytes);
+    }
+    return 2 + x_count * m_series.x_bytes;
+}
+
+static uint32_t value_get(const uint8_t * p_value, uint8_t bytes)
+{
+    uint32_t value = 0;
+    memcpy(&value, p_value, bytes);
+    return value;
+}
+
+/* Checks the serialized triplet at p_column. Width and Y are derived from X in these tests. */
+static void column_check(const uint8_t * p_column, uint32_t raw_x)
+{
+    TEST_ASSERT_EQUAL(raw_x, value_get(&p_column[0], m_series.x_bytes));
+    TEST_ASSERT_EQUAL(1, value_get(&p_column[m_series.x_bytes], m_series.x_bytes));
+    TEST_ASSERT_EQUAL((raw_x * 3) & 0xFFFF, value_get(&p_column[2 * m_series.x_bytes], MIN(m_series.y_bytes, 2)));
+}
+
+/* Serializes a series status for [raw_x1, raw_x2] and checks it against the expected X values. */
+static void series_check(uint32_t raw_x1, uint32_t raw_x2, uint16_t bytes_max, const uint32_t * p_expected, uint32_t count)
+{
+    uint8_t params[2 + 2 * SENSOR_SERIES_X_BYTES_MAX];
+    uint32_t raw_x[2] = {raw_x1, raw_x2};
+    uint16_t length = params_build(params, m_series.property_id, raw_x, 2);
+    sensor_series_query_t query;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_range_query(&m_series, params, length, bytes_max, &query));
+    TEST_ASSERT_EQUAL(count, query.count);
+    TEST_ASSERT_EQUAL(2 + count * SENSOR_SERIES_COLUMN_BYTES(m_series.x_bytes, m_series.y_bytes), query.bytes);
+
+    memset(m_out, 0xAA, sizeof(m_out));
+    sensor_series_status_serialize(&m_series, &query, m_out);
+    TEST_ASSERT_EQUAL(PROPERTY_ID, value_get(m_out, 2));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        column_check(&m_out[2 + i * SENSOR_SERIES_COLUMN_BYTES(m_series.x_bytes, m_series.y_bytes)], p_expected[i]);
+    }
+    TEST_ASSERT_EQUAL_HEX8(0xAA, m_out[query.bytes]);
+}
+
+static uint64_t time_ns_get(void)
+{
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+
+void setUp(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_init(&m_series, PROPERTY_ID, X_BYTES, false, Y_BYTES, m_buffer, 8 * COLUMN_BYTES + COLUMN_BYTES - 1));
+    TEST_ASSERT_EQUAL(8, m_series.capacity);
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_init(void)
+{
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_init(NULL, PROPERTY_ID, X_BYTES, false, Y_BYTES, m_buffer, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_init(&m_series, PROPERTY_ID, X_BYTES, false, Y_BYTES, NULL, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_series_init(&m_series, 0, X_BYTES, false, Y_BYTES, m_buffer, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_series_init(&m_series, PROPERTY_ID, 0, false, Y_BYTES, m_buffer, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_series_init(&m_series, PROPERTY_ID, SENSOR_SERIES_X_BYTES_MAX + 1, false, Y_BYTES, m_buffer, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_series_init(&m_series, PROPERTY_ID, X_BYTES, false, 0, m_buffer, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_series_init(&m_series, PROPERTY_ID, X_BYTES, false, SENSOR_SERIES_Y_BYTES_MAX + 1, m_buffer, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_series_init(&m_series, PROPERTY_ID, X_BYTES, false, Y_BYTES, m_buffer, COLUMN_BYTES - 1));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_init(&m_series, PROPERTY_ID, X_BYTES, false, Y_BYTES, m_buffer, COLUMN_BYTES));
+    TEST_ASSERT_EQUAL(1, m_series.capacity);
+    TEST_ASSERT_EQUAL(0, m_series.count);
+
+    uint32_t raw_x = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_column_set(NULL, (uint8_t *) &raw_x, (uint8_t *) &raw_x, (uint8_t *) &raw_x));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_column_set(&m_series, NULL, (uint8_t *) &raw_x, (uint8_t *) &raw_x));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_column_set(&m_series, (uint8_t *) &raw_x, NULL, (uint8_t *) &raw_x));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_column_set(&m_series, (uint8_t *) &raw_x, (uint8_t *) &raw_x, NULL));
+}
+
+void test_append(void)
+{
+    /* Logged data wraps around the ring, keeping the newest columns. */
+    for (uint32_t raw_x = 100; raw_x < 120; raw_x++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(raw_x, 1, raw_x * 3));
+    }
+    TEST_ASSERT_EQUAL(8, m_series.count);
+
+    const uint32_t expected[] = {112, 113, 114, 115, 116, 117, 118, 119};
+    series_check(0, UINT16_MAX, UINT16_MAX, expected, ARRAY_SIZE(expected));
+
+    /* Older than everything in a full ring: */
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, column_set(111, 1, 111 * 3));
+    series_check(0, UINT16_MAX, UINT16_MAX, expected, ARRAY_SIZE(expected));
+
+    sensor_series_clear(&m_series);
+    series_check(0, UINT16_MAX, UINT16_MAX, NULL, 0);
+}
+
+void test_insert(void)
+{
+    const uint32_t values[] = {50, 10, 40, 20, 30, 60, 5};
+    for (uint32_t i = 0; i < ARRAY_SIZE(values); i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(values[i], 1, values[i] * 3));
+    }
+    const uint32_t expected[] = {5, 10, 20, 30, 40, 50, 60};
+    series_check(0, UINT16_MAX, UINT16_MAX, expected, ARRAY_SIZE(expected));
+
+    /* Updating keeps the column count: */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(30, 1, 0xFFFFFF));
+    TEST_ASSERT_EQUAL(7, m_series.count);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(30, 1, 30 * 3));
+
+    /* Filling up, then inserting in the middle drops the lowest column, while a column below the
+     * stored ones is rejected: */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(70, 1, 70 * 3));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(35, 1, 35 * 3));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, column_set(7, 1, 7 * 3));
+    const uint32_t expected_full[] = {10, 20, 30, 35, 40, 50, 60, 70};
+    series_check(0, UINT16_MAX, UINT16_MAX, expected_full, ARRAY_SIZE(expected_full));
+}
+
+void test_column_query(void)
+{
+    for (uint32_t raw_x = 0; raw_x < 12; raw_x++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(raw_x * 10, 1, raw_x * 10 * 3));
+    }
+
+    uint8_t params[2 + X_BYTES];
+    uint32_t raw_x = 70;
+    uint16_t length = params_build(params, PROPERTY_ID, &raw_x, 1);
+    sensor_series_query_t query;
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_column_query(NULL, params, length, &query));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, sensor_series_column_query(&m_series, params, length, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_series_column_query(&m_series, params, length - 1, &query));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_series_column_query(&m_series, params, 2, &query));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_column_query(&m_series, params, length, &query));
+    TEST_ASSERT_EQUAL(1, query.count);
+    TEST_ASSERT_EQUAL(2 + COLUMN_BYTES, query.bytes);
+    sensor_series_status_serialize(&m_series, &query, m_out);
+    TEST_ASSERT_EQUAL(PROPERTY_ID, value_get(m_out, 2));
+    column_check(&m_out[2], 70);
+
+    /* A column that isn't stored, within the range and outside it: */
+    const uint32_t missing[] = {75, 0, 200};
+    for (uint32_t i = 0; i < ARRAY_SIZE(missing); i++)
+    {
+        length = params_build(params, PROPERTY_ID, &missing[i], 1);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_column_query(&m_series, params, length, &query));
+        TEST_ASSERT_EQUAL(0, query.count);
+        TEST_ASSERT_EQUAL(2 + X_BYTES, query.bytes);
+        sensor_series_status_serialize(&m_series, &query, m_out);
+        TEST_ASSERT_EQUAL(PROPERTY_ID, value_get(m_out, 2));
+        TEST_ASSERT_EQUAL(missing[i], value_get(&m_out[2], X_BYTES));
+    }
+
+    length = params_build(params, PROPERTY_ID + 1, &raw_x, 1);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_series_column_query(&m_series, params, length, &query));
+}
+
+void test_range_query(void)
+{
+    /* 40..110 in steps of 10, wrapped around the ring. */
+    for (uint32_t raw_x = 0; raw_x < 12; raw_x++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(raw_x * 10, 1, raw_x * 10 * 3));
+    }
+
+    const uint32_t all[] = {40, 50, 60, 70, 80, 90, 100, 110};
+    uint8_t params[2 + 2 * X_BYTES];
+    uint16_t length = params_build(params, PROPERTY_ID, NULL, 0);
+    sensor_series_query_t query;
+
+    /* No interval means all columns: */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_range_query(&m_series, params, length, UINT16_MAX, &query));
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(all), query.count);
+    sensor_series_status_serialize(&m_series, &query, m_out);
+    for (uint32_t i = 0; i < ARRAY_SIZE(all); i++)
+    {
+        column_check(&m_out[2 + i * COLUMN_BYTES], all[i]);
+    }
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_series_range_query(&m_series, params, length + X_BYTES, UINT16_MAX, &query));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, sensor_series_range_query(&m_series, params, length, 1, &query));
+    params[0]++;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, sensor_series_range_query(&m_series, params, length, UINT16_MAX, &query));
+
+    /* Closed intervals, on and between columns: */
+    series_check(60, 90, UINT16_MAX, &all[2], 4);
+    series_check(55, 95, UINT16_MAX, &all[2], 4);
+    series_check(0, 40, UINT16_MAX, &all[0], 1);
+    series_check(110, UINT16_MAX, UINT16_MAX, &all[7], 1);
+    series_check(111, UINT16_MAX, UINT16_MAX, NULL, 0);
+    series_check(61, 69, UINT16_MAX, NULL, 0);
+    series_check(90, 60, UINT16_MAX, NULL, 0);
+
+    /* Truncated to what fits, from the lowest column: */
+    series_check(0, UINT16_MAX, 2 + 3 * COLUMN_BYTES + COLUMN_BYTES - 1, &all[0], 3);
+    series_check(70, UINT16_MAX, 2 + 2 * COLUMN_BYTES, &all[3], 2);
+    series_check(0, UINT16_MAX, 2, NULL, 0);
+}
+
+void test_signed_range_query(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_init(&m_series, PROPERTY_ID, X_BYTES, true, Y_BYTES, m_buffer, 8 * COLUMN_BYTES));
+
+    /* -30..40 in steps of 10, as 16-bit two's complement values. Negative values sort first. */
+    const uint32_t all[] = {0xFFE2, 0xFFEC, 0xFFF6, 0, 10, 20, 30, 40};
+    for (uint32_t i = ARRAY_SIZE(all); i > 0; i--)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(all[i - 1], 1, all[i - 1] * 3));
+    }
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(all), m_series.count);
+    series_check(0x8000, 0x7FFF, UINT16_MAX, &all[0], 8);
+    series_check(0xFFEC, 10, UINT16_MAX, &all[1], 4);
+    series_check(0xFFFF, 0x7FFF, UINT16_MAX, &all[3], 5);
+    series_check(10, 0xFFEC, UINT16_MAX, NULL, 0);
+
+    /* The lowest column is dropped when the store is full: */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(50, 1, 50 * 3));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, column_set(0xFFE0, 1, 0xFFE0 * 3));
+    series_check(0x8000, 40, UINT16_MAX, &all[1], 7);
+
+    uint8_t params[2 + X_BYTES];
+    uint32_t raw_x = 0xFFF6;
+    uint16_t length = params_build(params, PROPERTY_ID, &raw_x, 1);
+    sensor_series_query_t query;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_column_query(&m_series, params, length, &query));
+    TEST_ASSERT_EQUAL(1, query.count);
+    sensor_series_status_serialize(&m_series, &query, m_out);
+    column_check(&m_out[2], raw_x);
+}
+
+void test_large_series(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_init(&m_series, PROPERTY_ID, 4, false, 2, m_buffer, sizeof(m_buffer)));
+    TEST_ASSERT_EQUAL(LARGE_COLUMNS, m_series.capacity);
+
+    /* Time stamped samples with gaps, logged well past the capacity. */
+    static uint32_t stamps[LARGE_COLUMNS];
+    uint32_t rand_state = 1;
+    uint32_t stamp = 0x10000000;
+    for (uint32_t i = 0; i < 3 * LARGE_COLUMNS; i++)
+    {
+        rand_state = rand_state * 1103515245u + 12345u;
+        stamp += 1 + ((rand_state >> 16) & 0xF);
+        stamps[i % LARGE_COLUMNS] = stamp;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, column_set(stamp, 1, stamp * 3));
+    }
+    TEST_ASSERT_EQUAL(LARGE_COLUMNS, m_series.count);
+    uint32_t oldest = stamps[(3 * LARGE_COLUMNS) % LARGE_COLUMNS];
+
+    /* Compare range queries with a linear scan of the expected columns. */
+    uint64_t duration_ns = 0;
+    uint32_t columns_total = 0;
+    for (uint32_t i = 0; i < LARGE_QUERIES; i++)
+    {
+        rand_state = rand_state * 1103515245u + 12345u;
+        uint32_t raw_x1 = oldest - 100 + (rand_state % (stamp - oldest + 200));
+        uint32_t raw_x2 = raw_x1 + (rand_state >> 20);
+
+        uint32_t first = LARGE_COLUMNS;
+        uint32_t count = 0;
+        for (uint32_t j = 0; j < LARGE_COLUMNS; j++)
+        {
+            uint32_t x = stamps[(3 * LARGE_COLUMNS + j) % LARGE_COLUMNS];
+            if (x >= raw_x1 && x <= raw_x2)
+            {
+                first = MIN(first, j);
+                count++;
+            }
+        }
+        count = MIN(count, 60);
+
+        uint8_t params[2 + 8];
+        uint32_t raw_x[2] = {raw_x1, raw_x2};
+        uint16_t length = params_build(params, PROPERTY_ID, raw_x, 2);
+        sensor_series_query_t query;
+
+        uint64_t start_ns = time_ns_get();
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sensor_series_range_query(&m_series, params, length, 2 + 60 * 10, &query));
+        sensor_series_status_serialize(&m_series, &query, m_out);
+        duration_ns += time_ns_get() - start_ns;
+
+        TEST_ASSERT_EQUAL(count, query.count);
+        if (count > 0)
+        {
+            TEST_ASSERT_EQUAL(stamps[(3 * LARGE_COLUMNS + first) % LARGE_COLUMNS], value_get(&m_out[2], 4));
+            TEST_ASSERT_EQUAL(stamps[(3 * LARGE_COLUMNS + first + count - 1) % LARGE_COLUMNS],
+                              value_get(&m_out[2 + (count - 1) * 10], 4));
+        }
+        columns_total += count;
+    }
+
+    printf("sensor_series: %u columns: %u ns per series query (%u columns per response on average)\n",
+           LARGE_COLUMNS, (uint32_t) (duration_ns / LARGE_QUERIES), columns_total / LARGE_QUERIES);
+}
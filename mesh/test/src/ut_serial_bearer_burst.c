@@ -0,0 +1,150 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_serial_bearer_common.h"
+
+/*********************************************************************
+ * Helper functions                                                  *
+ *********************************************************************/
+
+static void tx_pop_expect(packet_buffer_packet_t * p_buf_packet, uint32_t status)
+{
+    packet_buffer_pop_ExpectAndReturn(NULL, NULL, status);
+    packet_buffer_pop_IgnoreArg_pp_packet();
+    packet_buffer_pop_IgnoreArg_p_buffer();
+    if (status == NRF_SUCCESS)
+    {
+        packet_buffer_pop_ReturnThruPtr_pp_packet(&p_buf_packet);
+    }
+}
+
+static void tx_free_expect(packet_buffer_packet_t * p_buf_packet)
+{
+    packet_buffer_free_Expect(NULL, p_buf_packet);
+    packet_buffer_free_IgnoreArg_p_buffer();
+}
+
+static void tx_byte_expect(uint8_t value)
+{
+    m_tx_cb();
+    TEST_ASSERT_EQUAL(value, NRF_UART0->TXD);
+    TEST_ASSERT_EQUAL(0, NRF_UART0->TASKS_STOPTX);
+    /* Calls to transmit should cause no effect while in transmit state */
+    transmit_bearer_event(NULL, false);
+}
+
+/*********************************************************************
+ * Tests                                                             *
+ *********************************************************************/
+void test_uart_tx_burst(void)
+{
+    serial_packet_t * p_packet;
+    packet_buffer_packet_t * p_buf_packet = (packet_buffer_packet_t *) m_buffer;
+    packet_buffer_packet_t * p_buf_packet2 = (packet_buffer_packet_t *) &m_buffer[ALIGN_VAL(sizeof(serial_packet_t) + sizeof(packet_buffer_packet_t), 4)];
+
+    /* Queue two packets, the second one with bytes that need SLIP escaping. */
+    serial_buffer_get(1, &p_packet, p_buf_packet);
+    p_packet->opcode = 1;
+    serial_transmit(p_packet, p_buf_packet);
+    serial_buffer_get(2, &p_packet, p_buf_packet2);
+    p_packet->opcode = SLIP_END;
+    *((uint8_t*) &p_packet->payload) = SLIP_ESC;
+    serial_transmit(p_packet, p_buf_packet2);
+
+    /* The bearer event starts the first packet */
+    transmit_bearer_event(p_buf_packet, true);
+#ifdef SERIAL_SLIP_ENCODING
+    TEST_ASSERT_EQUAL(SLIP_END, NRF_UART0->TXD);
+    tx_byte_expect(1); /* Length field of the first packet */
+    tx_byte_expect(1); /* Opcode of the first packet */
+    tx_free_expect(p_buf_packet);
+    tx_byte_expect(SLIP_END);
+
+    /* The second packet follows the END byte of the first one directly, without another END byte
+     * and without stopping the transmitter. */
+    tx_pop_expect(p_buf_packet2, NRF_SUCCESS);
+    tx_byte_expect(2);
+    tx_byte_expect(SLIP_ESC);
+    tx_byte_expect(SLIP_ESC_END);
+    tx_byte_expect(SLIP_ESC);
+    tx_byte_expect(SLIP_ESC_ESC);
+    tx_free_expect(p_buf_packet2);
+    tx_byte_expect(SLIP_END);
+#else
+    TEST_ASSERT_EQUAL(1, NRF_UART0->TXD); /* Length field of the first packet */
+    tx_byte_expect(1); /* Opcode of the first packet */
+
+    /* The first packet is freed and the second one started in the same interrupt, without
+     * stopping the transmitter. */
+    tx_free_expect(p_buf_packet);
+    tx_pop_expect(p_buf_packet2, NRF_SUCCESS);
+    tx_byte_expect(2);
+    tx_byte_expect(SLIP_END);
+    tx_byte_expect(SLIP_ESC);
+    tx_free_expect(p_buf_packet2);
+#endif
+
+    /* No more data to send */
+    tx_pop_expect(NULL, NRF_ERROR_NOT_FOUND);
+    m_tx_cb();
+    TEST_ASSERT_EQUAL(1, NRF_UART0->TASKS_STOPTX);
+    NRF_UART0->TASKS_STOPTX = 0;
+
+    /* Back in idle state, we should not be receiving another TXDRDY */
+    TEST_NRF_MESH_ASSERT_EXPECT(m_tx_cb());
+
+    /* A packet queued after the burst ended is started by the bearer event again */
+    serial_buffer_get(1, &p_packet, p_buf_packet);
+    p_packet->opcode = 3;
+    serial_transmit(p_packet, p_buf_packet);
+    transmit_bearer_event(p_buf_packet, true);
+#ifdef SERIAL_SLIP_ENCODING
+    TEST_ASSERT_EQUAL(SLIP_END, NRF_UART0->TXD);
+    tx_byte_expect(1);
+#else
+    TEST_ASSERT_EQUAL(1, NRF_UART0->TXD);
+#endif
+    tx_byte_expect(3);
+    tx_free_expect(p_buf_packet);
+#ifdef SERIAL_SLIP_ENCODING
+    tx_byte_expect(SLIP_END);
+#endif
+    tx_pop_expect(NULL, NRF_ERROR_NOT_FOUND);
+    m_tx_cb();
+    TEST_ASSERT_EQUAL(1, NRF_UART0->TASKS_STOPTX);
+    NRF_UART0->TASKS_STOPTX = 0;
+}
@@ -46,6 +46,7 @@
 #include "serial_mock.h"
 #include "access_config_mock.h"
 #include "access_mock.h"
+#include "mesh_config_mock.h"
 
 #define RX_PACK_INVALID_PACK_LENGTH(CMD, MIN, MAX)  do \
                                                     { \
@@ -564,11 +565,88 @@ static void test_access_elem_models_get()
 
 }
 
+static void test_access_model_subs_add_batch()
+{
+    serial_packet_t cmd;
+    uint8_t count;
+    cmd.opcode = SERIAL_OPCODE_CMD_ACCESS_MODEL_SUBS_ADD_BATCH;
+    RX_PACK_INVALID_PACK_LENGTH(cmd, SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(serial_cmd_access_handle_pair_t), SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(serial_cmd_access_handle_pair_batch_t));
+    cmd.length = SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(serial_cmd_access_handle_pair_t) + 1;
+    serial_cmd_rsp_send_Expect(cmd.opcode, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0);
+    serial_handler_access_rx(&cmd);
+
+    cmd.length = SERIAL_PACKET_LENGTH_OVERHEAD + 3 * sizeof(serial_cmd_access_handle_pair_t);
+    for (uint16_t i = 0; i < 3; ++i)
+    {
+        cmd.payload.cmd.access.handle_pair_batch.pairs[i].model_handle = i;
+        cmd.payload.cmd.access.handle_pair_batch.pairs[i].dsm_handle = 0x10 + i;
+    }
+    mesh_config_batch_begin_Expect();
+    for (uint16_t i = 0; i < 3; ++i)
+    {
+        access_model_subscription_add_ExpectAndReturn(i, 0x10 + i, NRF_SUCCESS);
+    }
+    mesh_config_batch_end_Expect();
+    count = 3;
+    serial_translate_error_ExpectAndReturn(NRF_SUCCESS, SERIAL_STATUS_SUCCESS);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_SUCCESS, &count, sizeof(count), sizeof(count));
+    serial_handler_access_rx(&cmd);
+
+    /* Stops at the first failing pair, and reports the number of pairs applied: */
+    mesh_config_batch_begin_Expect();
+    access_model_subscription_add_ExpectAndReturn(0, 0x10, NRF_SUCCESS);
+    access_model_subscription_add_ExpectAndReturn(1, 0x11, NRF_ERROR_NOT_FOUND);
+    mesh_config_batch_end_Expect();
+    count = 1;
+    serial_translate_error_ExpectAndReturn(NRF_ERROR_NOT_FOUND, SERIAL_STATUS_ERROR_INVALID_PARAMETER);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_ERROR_INVALID_PARAMETER, &count, sizeof(count), sizeof(count));
+    serial_handler_access_rx(&cmd);
+}
+
+static void test_access_model_app_bind_batch()
+{
+    serial_packet_t cmd;
+    uint8_t count;
+    cmd.opcode = SERIAL_OPCODE_CMD_ACCESS_MODEL_APP_BIND_BATCH;
+    RX_PACK_INVALID_PACK_LENGTH(cmd, SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(serial_cmd_access_handle_pair_t), SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(serial_cmd_access_handle_pair_batch_t));
+    cmd.length = SERIAL_PACKET_LENGTH_OVERHEAD + 2 * sizeof(serial_cmd_access_handle_pair_t) - 1;
+    serial_cmd_rsp_send_Expect(cmd.opcode, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0);
+    serial_handler_access_rx(&cmd);
+
+    cmd.length = SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(serial_cmd_access_handle_pair_batch_t);
+    const uint16_t pair_count = sizeof(serial_cmd_access_handle_pair_batch_t) / sizeof(serial_cmd_access_handle_pair_t);
+    for (uint16_t i = 0; i < pair_count; ++i)
+    {
+        cmd.payload.cmd.access.handle_pair_batch.pairs[i].model_handle = i;
+        cmd.payload.cmd.access.handle_pair_batch.pairs[i].dsm_handle = 0;
+    }
+    mesh_config_batch_begin_Expect();
+    for (uint16_t i = 0; i < pair_count; ++i)
+    {
+        access_model_application_bind_ExpectAndReturn(i, 0, NRF_SUCCESS);
+    }
+    mesh_config_batch_end_Expect();
+    count = pair_count;
+    serial_translate_error_ExpectAndReturn(NRF_SUCCESS, SERIAL_STATUS_SUCCESS);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_SUCCESS, &count, sizeof(count), sizeof(count));
+    serial_handler_access_rx(&cmd);
+
+    cmd.length = SERIAL_PACKET_LENGTH_OVERHEAD + 2 * sizeof(serial_cmd_access_handle_pair_t);
+    mesh_config_batch_begin_Expect();
+    access_model_application_bind_ExpectAndReturn(0, 0, NRF_ERROR_INVALID_PARAM);
+    mesh_config_batch_end_Expect();
+    count = 0;
+    serial_translate_error_ExpectAndReturn(NRF_ERROR_INVALID_PARAM, SERIAL_STATUS_ERROR_INVALID_PARAMETER);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_ERROR_INVALID_PARAMETER, &count, sizeof(count), sizeof(count));
+    serial_handler_access_rx(&cmd);
+}
+
 void setUp(void)
 {
     serial_mock_Init();
     access_config_mock_Init();
     access_mock_Init();
+    mesh_config_mock_Init();
 }
 
 void tearDown(void)
@@ -582,6 +660,8 @@ void tearDown(void)
     access_config_mock_Destroy();
     access_mock_Verify();
     access_mock_Destroy();
+    mesh_config_mock_Verify();
+    mesh_config_mock_Destroy();
 }
 
 static void (*opcode_test_fp[])() ={test_access_model_pub_addr_set, test_access_model_pub_addr_get,
@@ -591,7 +671,7 @@ static void (*opcode_test_fp[])() ={test_access_model_pub_addr_set, test_access_
     test_access_model_pub_app_get, test_access_model_pub_ttl_set, test_access_model_pub_ttl_get,
     test_access_elem_loc_set, test_access_elem_loc_get, test_access_elem_sig_model_count_get,
     test_access_elem_vendor_model_count_get, test_access_model_id_get, test_access_handle_get,
-    test_access_elem_models_get};
+    test_access_elem_models_get, test_access_model_subs_add_batch, test_access_model_app_bind_batch};
 /*****************************************************************************
 * Tests
 *****************************************************************************/
@@ -49,6 +49,7 @@
 #include "nrf_mesh_externs_mock.h"
 #include "config_server_mock.h"
 #include "mesh_stack_mock.h"
+#include "mesh_config_mock.h"
 
 #include "utils.h"
 #include "test_assert.h"
@@ -115,6 +116,7 @@ void setUp(void)
     nrf_mesh_externs_mock_Init();
     config_server_mock_Init();
     mesh_stack_mock_Init();
+    mesh_config_mock_Init();
     m_expected_packet_send = 0;
     m_packet_send_return = 0;
     memset(&m_expected_tx_params, 0, sizeof(m_expected_tx_params));
@@ -139,6 +141,8 @@ void tearDown(void)
     config_server_mock_Destroy();
     mesh_stack_mock_Verify();
     mesh_stack_mock_Destroy();
+    mesh_config_mock_Verify();
+    mesh_config_mock_Destroy();
 }
 
 /*****************************************************************************
@@ -673,6 +677,167 @@ void test_addr_publication(void)
     CMD_LENGTH_CHECK(cmd.opcode, cmd.length);
 }
 
+void test_appkey_batch(void)
+{
+    serial_packet_t cmd;
+    dsm_handle_t handles[2] = {0x0001, 0x0002};
+
+    cmd.opcode = SERIAL_OPCODE_CMD_MESH_APPKEY_ADD_BATCH;
+    cmd.length = 1 + 2 * sizeof(serial_cmd_mesh_appkey_add_t);
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        cmd.payload.cmd.mesh.appkey_add_batch.appkeys[i].app_key_index = 0x1230 + i;
+        cmd.payload.cmd.mesh.appkey_add_batch.appkeys[i].subnet_handle = 0xABCD;
+        memset(cmd.payload.cmd.mesh.appkey_add_batch.appkeys[i].key, i, NRF_MESH_KEY_SIZE);
+    }
+
+    mesh_config_batch_begin_Expect();
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        dsm_appkey_add_ExpectAndReturn(0x1230 + i, 0xABCD, cmd.payload.cmd.mesh.appkey_add_batch.appkeys[i].key, NULL, NRF_SUCCESS);
+        dsm_appkey_add_IgnoreArg_p_app_handle();
+        dsm_appkey_add_ReturnThruPtr_p_app_handle(&handles[i]);
+    }
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_SUCCESS, SERIAL_STATUS_SUCCESS);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_SUCCESS, (uint8_t *) handles, sizeof(handles), sizeof(handles));
+    serial_handler_mesh_rx(&cmd);
+
+    /* Failing keys roll back the keys added before them: */
+    mesh_config_batch_begin_Expect();
+    dsm_appkey_add_ExpectAndReturn(0x1230, 0xABCD, cmd.payload.cmd.mesh.appkey_add_batch.appkeys[0].key, NULL, NRF_SUCCESS);
+    dsm_appkey_add_IgnoreArg_p_app_handle();
+    dsm_appkey_add_ReturnThruPtr_p_app_handle(&handles[0]);
+    dsm_appkey_add_ExpectAndReturn(0x1231, 0xABCD, cmd.payload.cmd.mesh.appkey_add_batch.appkeys[1].key, NULL, NRF_ERROR_FORBIDDEN);
+    dsm_appkey_add_IgnoreArg_p_app_handle();
+    dsm_appkey_delete_ExpectAndReturn(handles[0], NRF_SUCCESS);
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_ERROR_FORBIDDEN, 0xAA);
+    serial_cmd_rsp_send_Expect(cmd.opcode, 0xAA, NULL, 0);
+    serial_handler_mesh_rx(&cmd);
+
+    /* Partial keys are rejected: */
+    cmd.length = 1 + sizeof(serial_cmd_mesh_appkey_add_t) + 1;
+    serial_cmd_rsp_send_Expect(cmd.opcode, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0);
+    serial_handler_mesh_rx(&cmd);
+    CMD_LENGTH_CHECK(cmd.opcode, 1 + sizeof(serial_cmd_mesh_appkey_add_batch_t));
+}
+
+void test_devkey_batch(void)
+{
+    serial_packet_t cmd;
+    dsm_handle_t handles[3] = {0x0010, 0x0011, 0x0012};
+
+    cmd.opcode = SERIAL_OPCODE_CMD_MESH_DEVKEY_ADD_BATCH;
+    cmd.length = 1 + 3 * sizeof(serial_cmd_mesh_devkey_add_t);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        cmd.payload.cmd.mesh.devkey_add_batch.devkeys[i].owner_addr = 0x0100 + i;
+        cmd.payload.cmd.mesh.devkey_add_batch.devkeys[i].subnet_handle = 0xABCD;
+        memset(cmd.payload.cmd.mesh.devkey_add_batch.devkeys[i].key, i, NRF_MESH_KEY_SIZE);
+    }
+
+    mesh_config_batch_begin_Expect();
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        dsm_devkey_add_ExpectAndReturn(0x0100 + i, 0xABCD, cmd.payload.cmd.mesh.devkey_add_batch.devkeys[i].key, NULL, NRF_SUCCESS);
+        dsm_devkey_add_IgnoreArg_p_devkey_handle();
+        dsm_devkey_add_ReturnThruPtr_p_devkey_handle(&handles[i]);
+    }
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_SUCCESS, SERIAL_STATUS_SUCCESS);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_SUCCESS, (uint8_t *) handles, sizeof(handles), sizeof(handles));
+    serial_handler_mesh_rx(&cmd);
+
+    /* The devkeys are removed in reverse order when the last one fails: */
+    mesh_config_batch_begin_Expect();
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        dsm_devkey_add_ExpectAndReturn(0x0100 + i, 0xABCD, cmd.payload.cmd.mesh.devkey_add_batch.devkeys[i].key, NULL, NRF_SUCCESS);
+        dsm_devkey_add_IgnoreArg_p_devkey_handle();
+        dsm_devkey_add_ReturnThruPtr_p_devkey_handle(&handles[i]);
+    }
+    dsm_devkey_add_ExpectAndReturn(0x0102, 0xABCD, cmd.payload.cmd.mesh.devkey_add_batch.devkeys[2].key, NULL, NRF_ERROR_NO_MEM);
+    dsm_devkey_add_IgnoreArg_p_devkey_handle();
+    dsm_devkey_delete_ExpectAndReturn(handles[1], NRF_SUCCESS);
+    dsm_devkey_delete_ExpectAndReturn(handles[0], NRF_SUCCESS);
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_ERROR_NO_MEM, 0xAA);
+    serial_cmd_rsp_send_Expect(cmd.opcode, 0xAA, NULL, 0);
+    serial_handler_mesh_rx(&cmd);
+
+    cmd.length = 1 + sizeof(serial_cmd_mesh_devkey_add_t) - 1;
+    serial_cmd_rsp_send_Expect(cmd.opcode, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0);
+    serial_handler_mesh_rx(&cmd);
+    CMD_LENGTH_CHECK(cmd.opcode, 1 + sizeof(serial_cmd_mesh_devkey_add_batch_t));
+}
+
+void test_addr_batch(void)
+{
+    serial_packet_t cmd;
+    dsm_handle_t handles[SERIAL_CMD_MESH_ADDR_ADD_BATCH_COUNT_MAX];
+
+    cmd.opcode = SERIAL_OPCODE_CMD_MESH_ADDR_SUBSCRIPTION_ADD_BATCH;
+    cmd.length = 1 + sizeof(serial_cmd_mesh_addr_add_batch_t);
+    mesh_config_batch_begin_Expect();
+    for (uint32_t i = 0; i < SERIAL_CMD_MESH_ADDR_ADD_BATCH_COUNT_MAX; ++i)
+    {
+        handles[i] = i;
+        cmd.payload.cmd.mesh.addr_add_batch.addresses[i] = 0xC000 + i;
+        dsm_address_subscription_add_ExpectAndReturn(0xC000 + i, NULL, NRF_SUCCESS);
+        dsm_address_subscription_add_IgnoreArg_p_address_handle();
+        dsm_address_subscription_add_ReturnThruPtr_p_address_handle(&handles[i]);
+    }
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_SUCCESS, SERIAL_STATUS_SUCCESS);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_SUCCESS, (uint8_t *) handles, sizeof(handles), sizeof(handles));
+    serial_handler_mesh_rx(&cmd);
+
+    mesh_config_batch_begin_Expect();
+    dsm_address_subscription_add_ExpectAndReturn(0xC000, NULL, NRF_SUCCESS);
+    dsm_address_subscription_add_IgnoreArg_p_address_handle();
+    dsm_address_subscription_add_ReturnThruPtr_p_address_handle(&handles[0]);
+    dsm_address_subscription_add_ExpectAndReturn(0xC001, NULL, NRF_ERROR_NO_MEM);
+    dsm_address_subscription_add_IgnoreArg_p_address_handle();
+    dsm_address_subscription_remove_ExpectAndReturn(handles[0], NRF_SUCCESS);
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_ERROR_NO_MEM, 0xAA);
+    serial_cmd_rsp_send_Expect(cmd.opcode, 0xAA, NULL, 0);
+    serial_handler_mesh_rx(&cmd);
+    CMD_LENGTH_CHECK(cmd.opcode, 1 + sizeof(serial_cmd_mesh_addr_add_batch_t));
+
+    cmd.opcode = SERIAL_OPCODE_CMD_MESH_ADDR_PUBLICATION_ADD_BATCH;
+    cmd.length = 1 + 2 * sizeof(uint16_t);
+    mesh_config_batch_begin_Expect();
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        dsm_address_publish_add_ExpectAndReturn(0xC000 + i, NULL, NRF_SUCCESS);
+        dsm_address_publish_add_IgnoreArg_p_address_handle();
+        dsm_address_publish_add_ReturnThruPtr_p_address_handle(&handles[i]);
+    }
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_SUCCESS, SERIAL_STATUS_SUCCESS);
+    serial_cmd_rsp_send_ExpectWithArray(cmd.opcode, SERIAL_STATUS_SUCCESS, (uint8_t *) handles, 2 * sizeof(dsm_handle_t), 2 * sizeof(dsm_handle_t));
+    serial_handler_mesh_rx(&cmd);
+
+    mesh_config_batch_begin_Expect();
+    dsm_address_publish_add_ExpectAndReturn(0xC000, NULL, NRF_SUCCESS);
+    dsm_address_publish_add_IgnoreArg_p_address_handle();
+    dsm_address_publish_add_ReturnThruPtr_p_address_handle(&handles[0]);
+    dsm_address_publish_add_ExpectAndReturn(0xC001, NULL, NRF_ERROR_NO_MEM);
+    dsm_address_publish_add_IgnoreArg_p_address_handle();
+    dsm_address_publish_remove_ExpectAndReturn(handles[0], NRF_SUCCESS);
+    mesh_config_batch_end_Expect();
+    serial_translate_error_ExpectAndReturn(NRF_ERROR_NO_MEM, 0xAA);
+    serial_cmd_rsp_send_Expect(cmd.opcode, 0xAA, NULL, 0);
+    serial_handler_mesh_rx(&cmd);
+
+    cmd.length = 1 + 3;
+    serial_cmd_rsp_send_Expect(cmd.opcode, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0);
+    serial_handler_mesh_rx(&cmd);
+    CMD_LENGTH_CHECK(cmd.opcode, 1 + sizeof(serial_cmd_mesh_addr_add_batch_t));
+}
+
 void test_packet_send(void)
 {
     serial_packet_t cmd;
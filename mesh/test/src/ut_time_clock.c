@@ -0,0 +1,387 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "time_clock.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+
+#define US_PER_SECOND           (1000000ull)
+/* Arbitrary TAI time, in microseconds. */
+#define TAI_START_US            (700000000ull * US_PER_SECOND)
+
+/* Multi-hop simulation: an authority and a chain of relays. */
+#define SIM_NODES               (7)
+#define SIM_PUBLISH_INTERVAL_US (60 * US_PER_SECOND)
+#define SIM_DURATION_US         (4 * 3600 * US_PER_SECOND)
+/* Stamp-to-air latency: processing and the advertiser's randomized scheduling. */
+#define SIM_TX_LATENCY_MIN_US   (1000)
+#define SIM_TX_LATENCY_SPAN_US  (10000)
+/* Timestamp capture jitter on the receiver. */
+#define SIM_RX_JITTER_US        (50)
+/* Time from receiving Time Status to relaying it. */
+#define SIM_RELAY_DELAY_US      (2000)
+
+typedef struct
+{
+    time_clock_t clock;
+    /* Offset and rate error of the local timebase against the true time. */
+    uint32_t offset_us;
+    int32_t skew_ppb;
+    /* Worst errors seen after the first synchronization. */
+    int64_t error_max_us;
+    uint32_t bound_max_us;
+    uint8_t wire_uncertainty_max;
+    bool synced;
+} sim_node_t;
+
+static uint32_t m_rand_state;
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+
+static uint32_t rand_get(void)
+{
+    m_rand_state = m_rand_state * 1664525 + 1013904223;
+    return m_rand_state >> 8;
+}
+
+static timestamp_t local_time_get(const sim_node_t * p_node, uint64_t true_us)
+{
+    int64_t skew_us = (int64_t) true_us * p_node->skew_ppb / 1000000000ll;
+    return (timestamp_t) (p_node->offset_us + true_us + skew_us);
+}
+
+static int64_t abs64(int64_t value)
+{
+    return value < 0 ? -value : value;
+}
+
+/** Sends Time Status from the sender at true time now, returns the true time it went on air. */
+static uint64_t sim_transfer(sim_node_t * p_sender, sim_node_t * p_receiver, uint64_t now_us, bool * p_accepted)
+{
+    time_status_param_t status;
+    timestamp_t now = local_time_get(p_sender, now_us);
+    timestamp_t stamp_time = time_clock_tx_stamp_time_get(&p_sender->clock, now);
+    /* The alignment delay is below a subsecond, the skew over it is negligible. */
+    uint64_t tx_us = now_us + (timestamp_t) (stamp_time - now) + SIM_TX_LATENCY_MIN_US + rand_get() % SIM_TX_LATENCY_SPAN_US;
+
+    timestamp_t expected_tx_time = time_clock_tx_time_get(&p_sender->clock, stamp_time);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_status_get(&p_sender->clock, expected_tx_time, &status));
+    time_clock_tx_complete(&p_sender->clock, expected_tx_time, local_time_get(p_sender, tx_us));
+
+    timestamp_t rx_time = local_time_get(p_receiver, tx_us) + rand_get() % SIM_RX_JITTER_US;
+    time_clock_update(&p_receiver->clock, rx_time);
+    *p_accepted = time_clock_status_sync(&p_receiver->clock, rx_time, &status);
+    p_receiver->wire_uncertainty_max = MAX(p_receiver->wire_uncertainty_max, status.uncertainty);
+    return tx_us;
+}
+
+static void sim_node_check(sim_node_t * p_node, uint64_t now_us)
+{
+    uint64_t tai_us;
+    uint32_t uncertainty_us;
+    timestamp_t now = local_time_get(p_node, now_us);
+
+    time_clock_update(&p_node->clock, now);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&p_node->clock, now, &tai_us, &uncertainty_us));
+
+    int64_t error_us = abs64((int64_t) (tai_us - (TAI_START_US + now_us)));
+    TEST_ASSERT_TRUE(error_us <= uncertainty_us);
+    p_node->error_max_us = MAX(p_node->error_max_us, error_us);
+    p_node->bound_max_us = MAX(p_node->bound_max_us, uncertainty_us);
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+
+void setUp(void)
+{
+    m_rand_state = 0x1234;
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_set_get(void)
+{
+    time_clock_t clock;
+    uint64_t tai_us;
+    uint32_t uncertainty_us;
+    time_status_param_t status;
+
+    /* Starts right before the timer wraps. */
+    timestamp_t start = UINT32_MAX - 500000;
+    time_clock_init(&clock, start);
+    TEST_ASSERT_FALSE(time_clock_is_set(&clock));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, time_clock_get(&clock, start, &tai_us, &uncertainty_us));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, time_clock_status_get(&clock, start, &status));
+    TEST_ASSERT_EQUAL(start, time_clock_tx_stamp_time_get(&clock, start));
+
+    time_clock_set(&clock, start, TAI_START_US, 1000);
+    TEST_ASSERT_TRUE(time_clock_is_set(&clock));
+
+    /* The uncertainty grows at the crystal tolerance. */
+    for (uint32_t i = 1; i <= 100; i++)
+    {
+        timestamp_t now = start + i * 60 * US_PER_SECOND;
+        time_clock_update(&clock, now);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&clock, now, &tai_us, &uncertainty_us));
+        TEST_ASSERT_TRUE(TAI_START_US + i * 60 * US_PER_SECOND == tai_us);
+        TEST_ASSERT_EQUAL(1000 + i * 60 * TIME_CLOCK_DRIFT_PPM_MAX, uncertainty_us);
+    }
+
+    /* Timestamps before the last update. */
+    timestamp_t now = start + 100 * 60 * US_PER_SECOND;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&clock, now - 1000000, &tai_us, &uncertainty_us));
+    TEST_ASSERT_TRUE(TAI_START_US + 100 * 60 * US_PER_SECOND - 1000000 == tai_us);
+}
+
+void test_sync(void)
+{
+    time_clock_t clock;
+    uint64_t tai_us;
+    uint32_t uncertainty_us;
+
+    time_clock_init(&clock, 0);
+    TEST_ASSERT_TRUE(time_clock_sync(&clock, 1000, TAI_START_US, 20000));
+
+    /* Only more certain time is accepted. */
+    time_clock_update(&clock, 1000000);
+    TEST_ASSERT_FALSE(time_clock_sync(&clock, 1000000, TAI_START_US + 5000000, 20050));
+    TEST_ASSERT_TRUE(time_clock_sync(&clock, 1000000, TAI_START_US + 1000000, 20000));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&clock, 1000000, &tai_us, &uncertainty_us));
+    TEST_ASSERT_TRUE(TAI_START_US + 1000000 == tai_us);
+    TEST_ASSERT_EQUAL(20000, uncertainty_us);
+
+    /* Received time is applied at the reception timestamp. */
+    time_clock_update(&clock, 3000000);
+    TEST_ASSERT_TRUE(time_clock_sync(&clock, 2000000, TAI_START_US + 2000100, 10000));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&clock, 3000000, &tai_us, &uncertainty_us));
+    TEST_ASSERT_TRUE(TAI_START_US + 3000100 == tai_us);
+    TEST_ASSERT_EQUAL(10000 + TIME_CLOCK_DRIFT_PPM_MAX, uncertainty_us);
+}
+
+void test_drift_compensation(void)
+{
+    sim_node_t node = {.offset_us = 12345, .skew_ppb = 37000};
+    uint64_t tai_us;
+    uint32_t uncertainty_us;
+
+    time_clock_init(&node.clock, local_time_get(&node, 0));
+
+    /* Updates every minute, off by up to 5 ms. */
+    for (uint64_t now_us = 0; now_us <= 3600 * US_PER_SECOND; now_us += 60 * US_PER_SECOND)
+    {
+        timestamp_t now = local_time_get(&node, now_us);
+        int64_t error_us = (int64_t) (rand_get() % 10000) - 5000;
+
+        time_clock_update(&node.clock, now);
+        if (time_clock_is_set(&node.clock))
+        {
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&node.clock, now, &tai_us, &uncertainty_us));
+            TEST_ASSERT_TRUE(abs64((int64_t) (tai_us - (TAI_START_US + now_us))) <= uncertainty_us);
+        }
+        (void) time_clock_sync(&node.clock, now, TAI_START_US + now_us + error_us, 5000);
+    }
+
+    /* The estimate is within its tolerance, which is far below the crystal tolerance. */
+    TEST_ASSERT_TRUE(node.clock.drift_tolerance_ppb < 5000);
+    TEST_ASSERT_TRUE(abs64(node.clock.drift_ppb - node.skew_ppb) <= node.clock.drift_tolerance_ppb);
+
+    /* Without updates the compensated clock holds the time an hour later. */
+    uint64_t now_us = 2 * 3600 * US_PER_SECOND;
+    for (uint64_t t = 3600 * US_PER_SECOND; t <= now_us; t += 600 * US_PER_SECOND)
+    {
+        time_clock_update(&node.clock, local_time_get(&node, t));
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&node.clock, local_time_get(&node, now_us), &tai_us, &uncertainty_us));
+    int64_t error_us = abs64((int64_t) (tai_us - (TAI_START_US + now_us)));
+    TEST_ASSERT_TRUE(error_us <= uncertainty_us);
+    TEST_ASSERT_TRUE(error_us < 20000);
+    TEST_ASSERT_TRUE(uncertainty_us < 3600 * TIME_CLOCK_DRIFT_PPM_MAX);
+
+    /* Jumps outside of the crystal tolerance don't corrupt the estimate. */
+    int32_t drift_ppb = node.clock.drift_ppb;
+    timestamp_t now = local_time_get(&node, now_us);
+    TEST_ASSERT_TRUE(time_clock_sync(&node.clock, now, TAI_START_US + now_us + 60 * US_PER_SECOND, 0));
+    TEST_ASSERT_EQUAL(drift_ppb, node.clock.drift_ppb);
+}
+
+void test_status(void)
+{
+    time_clock_t clock;
+    time_status_param_t status;
+    uint64_t tai_us;
+    uint32_t uncertainty_us;
+
+    time_clock_init(&clock, 0);
+    time_clock_set(&clock, 0, TAI_START_US + 123456, 0);
+    time_clock_update(&clock, 1000);
+
+    /* The message is stamped to go on air at a subsecond boundary. */
+    timestamp_t stamp_time = time_clock_tx_stamp_time_get(&clock, 1000);
+    TEST_ASSERT_TRUE(stamp_time >= 1000);
+    TEST_ASSERT_TRUE(stamp_time - 1000 <= US_PER_SECOND / TIME_CLOCK_SUBSECONDS_PER_SECOND);
+
+    timestamp_t tx_time = time_clock_tx_time_get(&clock, stamp_time);
+    TEST_ASSERT_EQUAL(stamp_time + TIME_CLOCK_TX_LATENCY_INITIAL_US, tx_time);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&clock, tx_time, &tai_us, &uncertainty_us));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_status_get(&clock, tx_time, &status));
+    TEST_ASSERT_TRUE(tai_us / US_PER_SECOND == status.TAI_seconds);
+    uint64_t boundary_us = status.TAI_seconds * US_PER_SECOND + status.subsecond * US_PER_SECOND / TIME_CLOCK_SUBSECONDS_PER_SECOND;
+    TEST_ASSERT_TRUE(tai_us - boundary_us <= 1);
+
+    /* Uncertainty covers the clock, the TX jitter and the hop, in 10 ms steps. */
+    uint32_t expected_us = uncertainty_us + 1 + TIME_CLOCK_TX_JITTER_INITIAL_US + TIME_CLOCK_HOP_UNCERTAINTY_US;
+    TEST_ASSERT_EQUAL((expected_us + TIME_CLOCK_UNCERTAINTY_STEP_US - 1) / TIME_CLOCK_UNCERTAINTY_STEP_US, status.uncertainty);
+
+    /* The receiver applies it at the reception timestamp. */
+    time_clock_t receiver;
+    time_clock_init(&receiver, 5000000);
+    TEST_ASSERT_TRUE(time_clock_status_sync(&receiver, 5000000, &status));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, time_clock_get(&receiver, 5000000, &tai_us, &uncertainty_us));
+    TEST_ASSERT_TRUE(abs64((int64_t) (tai_us - boundary_us)) <= 1);
+    TEST_ASSERT_EQUAL(status.uncertainty * TIME_CLOCK_UNCERTAINTY_STEP_US, uncertainty_us);
+
+    /* Unknown time and saturated uncertainty are ignored. */
+    time_clock_init(&receiver, 0);
+    status.uncertainty = TIME_CLOCK_UNCERTAINTY_MAX;
+    TEST_ASSERT_FALSE(time_clock_status_sync(&receiver, 0, &status));
+    status.uncertainty = 1;
+    status.TAI_seconds = 0;
+    TEST_ASSERT_FALSE(time_clock_status_sync(&receiver, 0, &status));
+    TEST_ASSERT_FALSE(time_clock_is_set(&receiver));
+}
+
+void test_tx_latency(void)
+{
+    time_clock_t clock;
+
+    time_clock_init(&clock, 0);
+    TEST_ASSERT_EQUAL(TIME_CLOCK_TX_LATENCY_INITIAL_US, clock.tx_latency_us);
+
+    /* Converges to the mean latency and holds the deviation peak. */
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        timestamp_t stamp_time = i * US_PER_SECOND;
+        timestamp_t expected = time_clock_tx_time_get(&clock, stamp_time);
+        time_clock_tx_complete(&clock, expected, stamp_time + 4000 + (i % 2) * 2000);
+    }
+    TEST_ASSERT_INT_WITHIN(500, 5000, clock.tx_latency_us);
+    TEST_ASSERT_TRUE(clock.tx_jitter_us >= 1000);
+    TEST_ASSERT_TRUE(clock.tx_jitter_us < 2000);
+}
+
+void test_multi_hop_simulation(void)
+{
+    sim_node_t nodes[SIM_NODES];
+    uint32_t rounds = 0;
+    uint32_t accepted = 0;
+
+    for (uint32_t i = 0; i < SIM_NODES; i++)
+    {
+        nodes[i] = (sim_node_t) {
+            .offset_us = rand_get(),
+            /* Crystals within +-40 ppm. */
+            .skew_ppb = (int32_t) (rand_get() % 80000) - 40000,
+        };
+        time_clock_init(&nodes[i].clock, local_time_get(&nodes[i], 0));
+    }
+
+    for (uint64_t round_us = 0; round_us < SIM_DURATION_US; round_us += SIM_PUBLISH_INTERVAL_US)
+    {
+        /* The authority has a reference clock. */
+        timestamp_t now = local_time_get(&nodes[0], round_us);
+        time_clock_update(&nodes[0].clock, now);
+        time_clock_set(&nodes[0].clock, now, TAI_START_US + round_us, 0);
+
+        uint64_t now_us = round_us;
+        for (uint32_t i = 1; i < SIM_NODES; i++)
+        {
+            bool is_accepted;
+            now_us = sim_transfer(&nodes[i - 1], &nodes[i], now_us, &is_accepted) + SIM_RELAY_DELAY_US;
+            if (!is_accepted)
+            {
+                break;
+            }
+            nodes[i].synced = true;
+            accepted++;
+        }
+
+        /* Worst case: right before the next round. */
+        for (uint32_t i = 1; i < SIM_NODES; i++)
+        {
+            if (nodes[i].synced)
+            {
+                sim_node_check(&nodes[i], round_us + SIM_PUBLISH_INTERVAL_US - 1);
+            }
+        }
+        rounds++;
+    }
+
+    /* Every relay was updated every round. */
+    TEST_ASSERT_EQUAL(rounds * (SIM_NODES - 1), accepted);
+
+    printf("Time propagation over %u hops, %u rounds of %u s:\n",
+           SIM_NODES - 1, (unsigned) rounds, (unsigned) (SIM_PUBLISH_INTERVAL_US / US_PER_SECOND));
+    for (uint32_t i = 1; i < SIM_NODES; i++)
+    {
+        printf("  hop %u: max error %6lld us, max bound %6u us, max Time Status uncertainty %3u0 ms, "
+               "drift %+6.2f ppm estimated %+6.2f ppm\n",
+               (unsigned) i,
+               (long long) nodes[i].error_max_us,
+               (unsigned) nodes[i].bound_max_us,
+               (unsigned) nodes[i].wire_uncertainty_max,
+               nodes[i].skew_ppb / 1000.0,
+               nodes[i].clock.drift_ppb / 1000.0);
+    }
+}
@@ -428,6 +428,70 @@ void test_unseg_tx(void)
     TEST_ASSERT_EQUAL(NRF_SUCCESS, transport_tx(&tx_params, NULL));
 }
 
+static void enc_aes_ccm_encrypt_in_place_callback(ccm_soft_data_t * p_ccm_data, int calls)
+{
+    TEST_ASSERT_EQUAL_PTR(p_ccm_data->p_m, p_ccm_data->p_out);
+    TEST_ASSERT_EQUAL_PTR(p_ccm_data->p_out + p_ccm_data->m_len, p_ccm_data->p_mic);
+}
+
+void test_unseg_tx_reserve(void)
+{
+    expect_init();
+    transport_init();
+    nrf_mesh_network_secmat_t net_secmat;
+    nrf_mesh_application_secmat_t app_secmat = {};
+    uint8_t * p_payload;
+
+    nrf_mesh_tx_params_t tx_params;
+    tx_params.data_len           = PACKET_MESH_TRS_SEG_ACCESS_PDU_MAX_SIZE - PACKET_MESH_TRS_TRANSMIC_SMALL_SIZE;
+    tx_params.dst.p_virtual_uuid = NULL;
+    tx_params.dst.value          = 0x0001;
+    tx_params.dst.type           = NRF_MESH_ADDRESS_TYPE_UNICAST;
+    tx_params.p_data             = NULL;
+    tx_params.security_material.p_net = &net_secmat;
+    tx_params.security_material.p_app = &app_secmat;
+    tx_params.force_segmented    = false;
+    tx_params.src                = 0x0002;
+    tx_params.ttl                = 9;
+    tx_params.tx_token           = TX_TOKEN;
+    tx_params.transmic_size      = NRF_MESH_TRANSMIC_SIZE_DEFAULT;
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, transport_tx_reserve(NULL, &p_payload));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, transport_tx_reserve(&tx_params, NULL));
+
+    /* Segmented packets can't be reserved in place. */
+    tx_params.force_segmented = true;
+    nrf_mesh_is_address_rx_ExpectAndReturn(&tx_params.dst, false);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, transport_tx_reserve(&tx_params, &p_payload));
+    tx_params.force_segmented = false;
+
+    packet_mesh_net_packet_t net_buffer;
+
+    m_expect_network_packet_alloc.calls                        = 1;
+    m_expect_network_packet_alloc.net_meta.control_packet      = false;
+    m_expect_network_packet_alloc.net_meta.dst                 = tx_params.dst;
+    m_expect_network_packet_alloc.net_meta.src                 = tx_params.src;
+    m_expect_network_packet_alloc.net_meta.ttl                 = tx_params.ttl;
+    m_expect_network_packet_alloc.net_meta.p_security_material = &net_secmat;
+    m_expect_network_packet_alloc.payload_len                  = PACKET_MESH_TRS_UNSEG_PDU_OFFSET + tx_params.data_len + PACKET_MESH_TRS_TRANSMIC_SMALL_SIZE;
+    m_expect_network_packet_alloc.tx_token                     = TX_TOKEN;
+    m_expect_network_packet_alloc.p_buffer                     = net_buffer.pdu;
+    m_expect_network_packet_alloc.bearer                       = CORE_TX_BEARER_TYPE_ALLOW_ALL ^ CORE_TX_BEARER_TYPE_LOCAL;
+
+    network_packet_alloc_StubWithCallback(network_packet_alloc_callback);
+    nrf_mesh_is_address_rx_ExpectAndReturn(&tx_params.dst, false);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, transport_tx_reserve(&tx_params, &p_payload));
+    TEST_ASSERT_EQUAL_PTR(&net_buffer.pdu[PACKET_MESH_TRS_UNSEG_PDU_OFFSET], p_payload);
+    TEST_ASSERT_EQUAL(NRF_ERROR_BUSY, transport_tx_reserve(&tx_params, &p_payload));
+
+    /* The payload is encrypted in place, and the packet is sent on commit. */
+    enc_nonce_generate_Ignore();
+    enc_aes_ccm_encrypt_StubWithCallback(enc_aes_ccm_encrypt_in_place_callback);
+    transport_tx_commit();
+    TEST_ASSERT_EQUAL(0, m_expect_network_packet_alloc.calls);
+}
+
 void test_core_tx_selection(void)
 {
     // this tests selection of core_tx for access data considering dst address
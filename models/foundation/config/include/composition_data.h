@@ -119,5 +119,14 @@ typedef enum
  */
 void config_composition_data_get(uint8_t * p_data, uint16_t * p_size);
 
+/**
+ * Drops the cached composition data block.
+ *
+ * The composition data block is serialized once and reused until the access layer composition
+ * changes. This function forces the next call to @ref config_composition_data_get to rebuild it,
+ * which is needed if the device information (for instance the features) changes at runtime.
+ */
+void config_composition_data_invalidate(void);
+
 /** @} */
 #endif /* CONFIG_SERVER_H__ */
@@ -54,6 +54,16 @@
  * @{
  */
 
+/**
+ * Number of model subscription and application key lists kept by the configuration server.
+ *
+ * The lists are resolved once per model and reused for repeated requests until the configuration
+ * of that model or the application keys change. The least recently used list is replaced.
+ */
+#ifndef CONFIG_SERVER_MODEL_LIST_CACHE_SIZE
+#define CONFIG_SERVER_MODEL_LIST_CACHE_SIZE (4)
+#endif
+
 /**
  * Initializes the configuration server model and registers it in the access layer.
  *
@@ -36,6 +36,7 @@
  */
 #include "composition_data.h"
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -43,6 +44,19 @@
 #include "access_config.h"
 #include "nrf_mesh_assert.h"
 
+/** Serialized composition data page, rebuilt when the access layer composition changes. */
+static struct
+{
+    /** Whether @c data holds a serialized page. */
+    bool is_valid;
+    /** Access layer composition version the page was built from. */
+    uint32_t version;
+    /** Size of the serialized page. */
+    uint16_t size;
+    /** Serialized page. */
+    uint8_t data[CONFIG_COMPOSITION_DATA_SIZE];
+} m_composition_cache;
+
 static uint16_t composition_data_vendor_models_write(uint16_t element_index, const access_model_handle_t * p_handles, uint16_t count, uint8_t * p_buffer)
 {
     uint16_t bytes = 0;
@@ -79,11 +93,8 @@ static uint16_t composition_data_sig_models_write(uint16_t element_index, const
     return bytes;
 }
 
-void config_composition_data_get(uint8_t * p_data, uint16_t * p_size)
+static void composition_data_build(uint8_t * p_data, uint16_t * p_size)
 {
-    NRF_MESH_ASSERT(p_data != NULL && p_size != NULL);
-    NRF_MESH_ASSERT(*p_size >= CONFIG_COMPOSITION_DATA_SIZE);
-
     access_model_handle_t model_handles[ACCESS_MODEL_COUNT];
     uint16_t element_models_count = 0;
     config_composition_data_header_t device;
@@ -142,3 +153,25 @@ void config_composition_data_get(uint8_t * p_data, uint16_t * p_size)
         }
     }
 }
+
+void config_composition_data_get(uint8_t * p_data, uint16_t * p_size)
+{
+    NRF_MESH_ASSERT(p_data != NULL && p_size != NULL);
+    NRF_MESH_ASSERT(*p_size >= CONFIG_COMPOSITION_DATA_SIZE);
+
+    uint32_t version = access_composition_version_get();
+    if (!m_composition_cache.is_valid || m_composition_cache.version != version)
+    {
+        composition_data_build(m_composition_cache.data, &m_composition_cache.size);
+        m_composition_cache.version = version;
+        m_composition_cache.is_valid = true;
+    }
+
+    memcpy(p_data, m_composition_cache.data, m_composition_cache.size);
+    *p_size = m_composition_cache.size;
+}
+
+void config_composition_data_invalidate(void)
+{
+    m_composition_cache.is_valid = false;
+}
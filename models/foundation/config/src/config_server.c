@@ -128,6 +128,32 @@ NRF_MESH_STATIC_ASSERT(CONFIG_COMPOSITION_DATA_SIZE <=
     (ACCESS_MESSAGE_LENGTH_MAX - ACCESS_UTILS_SIG_OPCODE_SIZE(CONFIG_OPCODE_COMPOSITION_DATA_STATUS) - sizeof(config_msg_composition_data_status_t)));
 
 
+/** Type of a cached model list. */
+typedef enum
+{
+    MODEL_LIST_SUBSCRIPTIONS,
+    MODEL_LIST_APPKEYS,
+} model_list_type_t;
+
+/** Subscription address list or bound application key index list of a model, as reported to the client. */
+typedef struct
+{
+    /** Model the list belongs to, or @ref ACCESS_HANDLE_INVALID if the entry is unused. */
+    access_model_handle_t model_handle;
+    /** Type of the list. */
+    model_list_type_t type;
+    /** Configuration version of the model the list was built from. */
+    uint32_t model_version;
+    /** Application key version the list was built from, only used for application key lists. */
+    uint32_t appkey_version;
+    /** Value of @ref m_model_list_cache_clock when the list was last used. */
+    uint32_t last_used;
+    /** Number of entries in @c list. */
+    uint16_t count;
+    /** Subscription addresses or application key indexes. */
+    uint16_t list[MAX(DSM_ADDR_MAX, DSM_APP_MAX)];
+} model_list_cache_entry_t;
+
 typedef enum
 {
     NODE_RESET_IDLE,
@@ -145,6 +171,10 @@ static config_server_evt_cb_t m_evt_cb;
 static void mesh_event_cb(const nrf_mesh_evt_t * p_evt);
 static nrf_mesh_evt_handler_t m_mesh_evt_handler = { .evt_cb = mesh_event_cb };
 
+/** Recently reported model lists, the least recently used one is replaced. */
+static model_list_cache_entry_t m_model_list_cache[CONFIG_SERVER_MODEL_LIST_CACHE_SIZE];
+static uint32_t m_model_list_cache_clock;
+
 static nrf_mesh_tx_token_t m_reset_token;
 static node_reset_state_t m_node_reset_pending = NODE_RESET_IDLE;
 
@@ -584,6 +614,99 @@ static inline access_status_t get_subscription_list(access_model_handle_t model_
     }
 }
 
+static void model_list_cache_clear(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_model_list_cache); ++i)
+    {
+        m_model_list_cache[i].model_handle = ACCESS_HANDLE_INVALID;
+        m_model_list_cache[i].last_used = 0;
+    }
+    m_model_list_cache_clock = 0;
+}
+
+static void appkey_list_get(access_model_handle_t model_handle, uint16_t * p_list, uint16_t * p_count)
+{
+    NRF_MESH_ASSERT(access_model_applications_get(model_handle, p_list, p_count) == NRF_SUCCESS);
+
+    /* Retrieve the appkey indexes from the DSM: */
+    for (uint16_t i = 0; i < *p_count; ++i)
+    {
+        NRF_MESH_ASSERT(dsm_appkey_handle_to_appkey_index(p_list[i], &p_list[i]) == NRF_SUCCESS);
+    }
+}
+
+/**
+ * Gets the subscription address list or the application key index list of a model.
+ *
+ * Each model has at most one cached list of each type. A list is resolved once and served from the
+ * cache until the configuration of its model changes or, for application key lists, until an
+ * application key is added or removed, so repeated requests for the same model do not walk the DSM
+ * again.
+ *
+ * @param[in]  type         List type.
+ * @param[in]  model_handle Model to get the list for.
+ * @param[out] pp_list      Returns a pointer to the list.
+ * @param[out] p_count      Returns the number of entries in the list.
+ *
+ * @returns Status to report to the client.
+ */
+static access_status_t model_list_get(model_list_type_t type, access_model_handle_t model_handle,
+                                      const uint16_t ** pp_list, uint16_t * p_count)
+{
+    uint32_t model_version = access_model_config_version_get(model_handle);
+    uint32_t appkey_version = (type == MODEL_LIST_APPKEYS) ? dsm_appkey_version_get() : 0;
+    model_list_cache_entry_t * p_entry = &m_model_list_cache[0];
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_model_list_cache); ++i)
+    {
+        if (m_model_list_cache[i].model_handle == model_handle && m_model_list_cache[i].type == type)
+        {
+            p_entry = &m_model_list_cache[i];
+            break;
+        }
+        else if (m_model_list_cache[i].last_used < p_entry->last_used)
+        {
+            p_entry = &m_model_list_cache[i];
+        }
+    }
+
+    if (p_entry->model_handle != model_handle ||
+        p_entry->type != type ||
+        p_entry->model_version != model_version ||
+        p_entry->appkey_version != appkey_version)
+    {
+        access_status_t status = ACCESS_STATUS_SUCCESS;
+
+        if (type == MODEL_LIST_SUBSCRIPTIONS)
+        {
+            p_entry->count = DSM_ADDR_MAX;
+            status = get_subscription_list(model_handle, p_entry->list, &p_entry->count);
+        }
+        else
+        {
+            p_entry->count = DSM_APP_MAX;
+            appkey_list_get(model_handle, p_entry->list, &p_entry->count);
+        }
+
+        if (status != ACCESS_STATUS_SUCCESS)
+        {
+            p_entry->model_handle = ACCESS_HANDLE_INVALID;
+            p_entry->last_used = 0;
+            return status;
+        }
+
+        p_entry->model_handle = model_handle;
+        p_entry->type = type;
+        p_entry->model_version = model_version;
+        p_entry->appkey_version = appkey_version;
+    }
+
+    p_entry->last_used = ++m_model_list_cache_clock;
+    *pp_list = p_entry->list;
+    *p_count = p_entry->count;
+    return ACCESS_STATUS_SUCCESS;
+}
+
 static uint32_t config_server_heartbeat_publication_params_get(heartbeat_publication_information_t * p_pub_info)
 {
 
@@ -2161,9 +2284,9 @@ static void handle_config_sig_model_subscription_get(access_model_handle_t handl
         return;
     }
 
-    uint16_t subscription_count = DSM_ADDR_MAX;
-    uint16_t subscription_list[DSM_ADDR_MAX];
-    access_status_t error_code = get_subscription_list(model_handle, subscription_list, &subscription_count);
+    uint16_t subscription_count;
+    const uint16_t * p_subscription_list;
+    access_status_t error_code = model_list_get(MODEL_LIST_SUBSCRIPTIONS, model_handle, &p_subscription_list, &subscription_count);
     if (error_code != ACCESS_STATUS_SUCCESS)
     {
         status_error_sub_send(handle, p_message, sig_model, error_code);
@@ -2176,7 +2299,7 @@ static void handle_config_sig_model_subscription_get(access_model_handle_t handl
     p_response->status = ACCESS_STATUS_SUCCESS;
     p_response->element_address = p_pdu->element_address;
     p_response->sig_model_id = model_id.model_id;
-    memcpy((void *) p_response->subscriptions, subscription_list, subscription_count * sizeof(uint16_t));
+    memcpy((void *) p_response->subscriptions, p_subscription_list, subscription_count * sizeof(uint16_t));
 
     send_reply(handle, p_message, CONFIG_OPCODE_SIG_MODEL_SUBSCRIPTION_LIST, response_buffer,
             sizeof(config_msg_sig_model_subscription_list_t) + subscription_count * sizeof(uint16_t), nrf_mesh_unique_token_get());
@@ -2215,9 +2338,9 @@ static void handle_config_vendor_model_subscription_get(access_model_handle_t ha
         return;
     }
 
-    uint16_t subscription_count = DSM_ADDR_MAX;
-    uint16_t subscription_list[DSM_ADDR_MAX];
-    access_status_t error_code = get_subscription_list(model_handle, subscription_list, &subscription_count);
+    uint16_t subscription_count;
+    const uint16_t * p_subscription_list;
+    access_status_t error_code = model_list_get(MODEL_LIST_SUBSCRIPTIONS, model_handle, &p_subscription_list, &subscription_count);
     if (error_code != ACCESS_STATUS_SUCCESS)
     {
         status_error_sub_send(handle, p_message, sig_model, error_code);
@@ -2232,7 +2355,7 @@ static void handle_config_vendor_model_subscription_get(access_model_handle_t ha
     p_response->element_address = p_pdu->element_address;
     p_response->vendor_model_id = p_pdu->model_id.vendor.model_id;
     p_response->vendor_company_id = p_pdu->model_id.vendor.company_id;
-    memcpy((void *) p_response->subscriptions, subscription_list, subscription_list_size);
+    memcpy((void *) p_response->subscriptions, p_subscription_list, subscription_list_size);
 
     send_reply(handle, p_message, CONFIG_OPCODE_VENDOR_MODEL_SUBSCRIPTION_LIST, response_buffer,
             sizeof(config_msg_vendor_model_subscription_list_t) + subscription_list_size, nrf_mesh_unique_token_get());
@@ -2894,7 +3017,7 @@ static uint8_t model_app_response_create(uint16_t opcode,
                                          access_status_t status,
                                          uint16_t element_address,
                                          access_model_id_t * p_model_id,
-                                         mesh_key_index_t * p_appkey_list,
+                                         const mesh_key_index_t * p_appkey_list,
                                          uint16_t appkey_count)
 {
     uint8_t size;
@@ -2978,23 +3101,17 @@ static void handle_model_app_get(access_model_handle_t handle, const access_mess
         return;
     }
 
-    /* Get the application list: */
-    uint16_t appkey_instances[DSM_APP_MAX];
-    uint16_t appkey_count = DSM_APP_MAX;
-    NRF_MESH_ASSERT(access_model_applications_get(model_handle, appkey_instances, &appkey_count) == NRF_SUCCESS);
-
-    /* Retrieve the appkey indexes from the DSM: */
-    for (uint16_t i = 0; i < appkey_count; ++i)
-    {
-        NRF_MESH_ASSERT(dsm_appkey_handle_to_appkey_index(appkey_instances[i], &appkey_instances[i]) == NRF_SUCCESS);
-    }
+    /* Get the application key index list: */
+    const uint16_t * p_appkey_indexes;
+    uint16_t appkey_count;
+    (void) model_list_get(MODEL_LIST_APPKEYS, model_handle, &p_appkey_indexes, &appkey_count);
 
     uint8_t response_size = model_app_response_create(p_message->opcode.opcode,
                                                       response_buffer,
                                                       ACCESS_STATUS_SUCCESS,
                                                       p_pdu->element_address,
                                                       &model_id,
-                                                      appkey_instances,
+                                                      p_appkey_indexes,
                                                       appkey_count);
     send_reply(handle, p_message, response_opcode, response_buffer, response_size, nrf_mesh_unique_token_get());
 
@@ -3042,6 +3159,7 @@ static void apply_reset(void)
 {
     /* Clear all the state. */
     mesh_stack_config_clear();
+    model_list_cache_clear();
 #if PERSISTENT_STORAGE
     if (!flash_manager_is_stable())
     {
@@ -3191,6 +3309,7 @@ uint32_t config_server_init(config_server_evt_cb_t evt_cb)
 #endif
 
     m_evt_cb = evt_cb;
+    model_list_cache_clear();
     return access_model_add(&init_params, &m_config_server_handle);
 }
 
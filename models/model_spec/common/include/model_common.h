@@ -210,6 +210,21 @@ typedef struct
     timer_event_t tid_expiry_timer;
 } tid_tracker_t;
 
+/** Rate limiter for unsolicited status publications. */
+typedef struct
+{
+    /** Called when a held back publication is due. */
+    timer_sch_callback_t cb;
+    /** Context pointer for the callback. */
+    void * p_context;
+    /** Internal variable. */
+    timer_event_t timer;
+    /** Internal variable. */
+    timestamp_t last_publish;
+    /** Internal variable. */
+    bool has_published;
+} model_publish_limiter_t;
+
 /** Timer modes. */
 typedef enum
 {
@@ -408,6 +423,42 @@ bool model_timer_is_running(model_timer_t * p_timer);
  */
 uint32_t model_timer_create(model_timer_t * p_timer);
 
+/**
+ * Reserves space for a status message, either as a reply or as a publication.
+ *
+ * Helper for models sending status messages with @ref access_model_publish_reserve and
+ * @ref access_model_reply_reserve. The model serializes its parameters into the returned buffer and
+ * sends the message with @ref access_model_tx_commit.
+ *
+ * @param[in]  handle    Access handle of the model sending the message.
+ * @param[in]  p_rx_msg  Message being replied to, or NULL to publish.
+ * @param[in]  p_tx_msg  Message parameters. @c p_buffer is ignored.
+ * @param[out] pp_params Returns a pointer to where the message parameters should be written.
+ *
+ * @returns Return values of @ref access_model_publish_reserve or @ref access_model_reply_reserve.
+ */
+uint32_t model_tx_reserve(access_model_handle_t handle,
+                          const access_message_rx_t * p_rx_msg,
+                          const access_message_tx_t * p_tx_msg,
+                          uint8_t ** pp_params);
+
+/**
+ * Checks whether a status publication may be sent now.
+ *
+ * Publications are allowed at most once every `interval_ms`. A publication that is held back is
+ * rescheduled: the limiter calls its callback once the interval has passed, and the model then
+ * publishes the latest value of its state, calling this function again. This way a model changing
+ * its state at a high rate publishes its first and last state and at most one state per interval in
+ * between.
+ *
+ * @param[in,out] p_limiter    Limiter instance, with the callback set.
+ * @param[in]     interval_ms  Minimum time between two publications, or zero to not limit.
+ *
+ * @retval true   The publication should be sent now.
+ * @retval false  The publication was held back, and the callback will be called when it is due.
+ */
+bool model_publish_limiter_check(model_publish_limiter_t * p_limiter, uint32_t interval_ms);
+
 /** @} end of MODEL_COMMON */
 
 #endif /* MODEL_COMMON_H__ */
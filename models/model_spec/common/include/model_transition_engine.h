@@ -0,0 +1,238 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MODEL_TRANSITION_ENGINE_H__
+#define MODEL_TRANSITION_ENGINE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "timer.h"
+
+/**
+ * @defgroup MODEL_TRANSITION_ENGINE Shared transition engine
+ * @ingroup MESH_API_GROUP_MODELS
+ * Drives any number of concurrent linear transitions from a single timer.
+ *
+ * Each transition runs on a channel, which moves a value from 0 towards a given delta over a given
+ * time. The step size and step interval are computed once when the transition starts, and each tick
+ * only adds the precomputed step, distributing the division remainders over the steps so that the
+ * channel lands on the exact delta at the exact transition time. No 64-bit or division operations
+ * are performed per tick.
+ *
+ * The step interval of each channel adapts to its transition: a channel never steps more often than
+ * needed to change its value by one, or more often than its minimum step time allows. Channel ticks
+ * that fall within @ref MODEL_TRANSITION_ENGINE_COALESCE_US of each other are processed in the same
+ * timer callback.
+ *
+ * @note The channel callbacks are called from the timer scheduler context, and must not do time
+ * consuming operations.
+ *
+ * @{
+ */
+
+/** Smallest step interval in milliseconds for any channel. */
+#ifndef MODEL_TRANSITION_ENGINE_TICK_MIN_MS
+#define MODEL_TRANSITION_ENGINE_TICK_MIN_MS     (1)
+#endif
+
+/** Largest number of steps in one transition. */
+#ifndef MODEL_TRANSITION_ENGINE_STEPS_MAX
+#define MODEL_TRANSITION_ENGINE_STEPS_MAX       (UINT16_MAX)
+#endif
+
+/** Channel ticks due within this time from the current tick are processed together. */
+#ifndef MODEL_TRANSITION_ENGINE_COALESCE_US
+#define MODEL_TRANSITION_ENGINE_COALESCE_US     (500)
+#endif
+
+/** Transition channel context. */
+typedef struct model_transition_channel model_transition_channel_t;
+
+/**
+ * Channel callback, called for every step of the transition.
+ *
+ * @param[in] p_channel     Channel that stepped.
+ * @param[in] value         Channel value, from 0 towards the transition delta.
+ * @param[in] is_complete   The transition has reached its delta, and the channel is idle.
+ */
+typedef void (*model_transition_channel_cb_t)(model_transition_channel_t * p_channel,
+                                              int32_t value,
+                                              bool is_complete);
+
+/** Transition parameters. */
+typedef struct
+{
+    /** Total change of the channel value over `transition_time_ms`. */
+    int32_t delta;
+    /** Transition time in milliseconds. */
+    uint32_t transition_time_ms;
+    /** Minimum time between two steps in milliseconds. */
+    uint32_t minimum_step_ms;
+    /** Keep moving by `delta` every `transition_time_ms` until the channel is aborted. */
+    bool is_move;
+} model_transition_params_t;
+
+/** Transition channel context. All fields except `cb` and `p_context` are internal. */
+struct model_transition_channel
+{
+    /** Step callback. */
+    model_transition_channel_cb_t cb;
+    /** Context pointer for the user. */
+    void * p_context;
+
+    model_transition_channel_t * p_next;
+    bool is_active;
+    bool is_move;
+    int32_t value;
+    int32_t step;
+    int8_t step_sign;
+    uint32_t step_rem;
+    uint32_t step_err;
+    uint32_t steps;
+    uint32_t step_index;
+    uint32_t interval_us;
+    uint32_t interval_rem;
+    uint32_t interval_err;
+    uint32_t transition_time_ms;
+    uint32_t elapsed_base_ms;
+    timestamp_t last_tick;
+    timestamp_t next_tick;
+};
+
+/**
+ * Value interpolated over the steps of a channel. All fields are internal.
+ *
+ * A follower moves a second value from 0 towards its own delta, in lockstep with the steps of a
+ * channel transition. It is used to interpolate several values with a single timer, like the
+ * components of a color, or a value that differs from the delta the channel was started with.
+ */
+typedef struct
+{
+    int32_t value;
+    int32_t step;
+    int8_t step_sign;
+    uint32_t step_rem;
+    uint32_t step_err;
+    uint32_t steps;
+    uint32_t step_index;
+} model_transition_follower_t;
+
+/**
+ * Starts a transition on a channel, replacing any ongoing transition on it.
+ *
+ * The channel value is reset to 0.
+ *
+ * @param[in,out] p_channel Channel to run the transition on.
+ * @param[in]     p_params  Transition parameters.
+ *
+ * @retval NRF_SUCCESS              The transition has been started.
+ * @retval NRF_ERROR_NULL           NULL pointer given, or the channel has no callback.
+ * @retval NRF_ERROR_INVALID_PARAM  The delta or the transition time is zero, or the transition time
+ *                                  is longer than the engine can represent.
+ */
+uint32_t model_transition_engine_start(model_transition_channel_t * p_channel,
+                                       const model_transition_params_t * p_params);
+
+/**
+ * Stops the transition on a channel, if any. The channel callback is not called.
+ *
+ * @param[in,out] p_channel Channel to stop.
+ */
+void model_transition_engine_abort(model_transition_channel_t * p_channel);
+
+/**
+ * Checks whether a channel has an ongoing transition.
+ *
+ * @param[in] p_channel Channel to check.
+ *
+ * @returns Whether the channel has an ongoing transition.
+ */
+bool model_transition_engine_is_active(const model_transition_channel_t * p_channel);
+
+/**
+ * Gets the time since the start of the transition on a channel.
+ *
+ * @param[in] p_channel Channel to check.
+ *
+ * @returns Elapsed time in milliseconds, or zero if the channel is idle.
+ */
+uint32_t model_transition_engine_elapsed_ms_get(const model_transition_channel_t * p_channel);
+
+/**
+ * Starts a follower on the transition that was just started on a channel.
+ *
+ * Must be called before the first step of the channel, i.e. right after
+ * @ref model_transition_engine_start(). Move transitions can't be followed.
+ *
+ * @param[out] p_follower   Follower to start. The follower value is reset to 0.
+ * @param[in]  p_channel    Channel to follow.
+ * @param[in]  delta        Total change of the follower value over the channel transition.
+ */
+void model_transition_engine_follower_start(model_transition_follower_t * p_follower,
+                                            const model_transition_channel_t * p_channel,
+                                            int32_t delta);
+
+/**
+ * Gets the current value of a follower.
+ *
+ * The follower catches up with the steps the channel has taken since the last call, without any
+ * division. Once the channel is idle, the follower value is its full delta.
+ *
+ * @param[in,out] p_follower    Follower to get the value of.
+ * @param[in]     p_channel     Channel the follower was started on.
+ *
+ * @returns The follower value, from 0 towards the follower delta.
+ */
+int32_t model_transition_engine_follower_value_get(model_transition_follower_t * p_follower,
+                                                   const model_transition_channel_t * p_channel);
+
+/**
+ * Gets the current value of a channel.
+ *
+ * @param[in] p_channel Channel to check.
+ *
+ * @returns The channel value, from 0 towards the transition delta.
+ */
+static inline int32_t model_transition_engine_value_get(const model_transition_channel_t * p_channel)
+{
+    return p_channel->value;
+}
+
+/** @} end of MODEL_TRANSITION_ENGINE */
+
+#endif /* MODEL_TRANSITION_ENGINE_H__ */
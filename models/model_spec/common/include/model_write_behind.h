@@ -0,0 +1,132 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MODEL_WRITE_BEHIND_H__
+#define MODEL_WRITE_BEHIND_H__
+
+#include <stdint.h>
+
+#include "mesh_config_entry.h"
+
+/**
+ * @defgroup MODEL_WRITE_BEHIND Deferred storage of model state entries
+ * @ingroup MESH_API_GROUP_MODELS
+ * Keeps the latest value of frequently changing model states in RAM and writes it to the model
+ * config file only after the state has been stable for @ref MODEL_WRITE_BEHIND_DELAY_MS. A state
+ * that keeps changing is written at least every @ref MODEL_WRITE_BEHIND_DELAY_MAX_MS.
+ *
+ * Pending values are flushed to the mesh config module when it starts storing power-down state, so
+ * they are stored through the emergency cache together with the rest of the power-down data.
+ *
+ * `*_mc.c` modules use @ref model_write_behind_set() and @ref model_write_behind_get() in place of
+ * `mesh_config_entry_set()` and `mesh_config_entry_get()` for states that change during transitions.
+ *
+ * @{
+ */
+
+/** Time a state must be unchanged before its pending value is written. */
+#ifndef MODEL_WRITE_BEHIND_DELAY_MS
+#define MODEL_WRITE_BEHIND_DELAY_MS         (500)
+#endif
+
+/** Longest time a pending value may be held back while the state keeps changing. */
+#ifndef MODEL_WRITE_BEHIND_DELAY_MAX_MS
+#define MODEL_WRITE_BEHIND_DELAY_MAX_MS     (5000)
+#endif
+
+/** Number of entries that can have a pending value at the same time. */
+#ifndef MODEL_WRITE_BEHIND_SLOT_COUNT
+#define MODEL_WRITE_BEHIND_SLOT_COUNT       (8)
+#endif
+
+/** Largest entry value that can be deferred, in bytes. */
+#ifndef MODEL_WRITE_BEHIND_VALUE_SIZE_MAX
+#define MODEL_WRITE_BEHIND_VALUE_SIZE_MAX   (8)
+#endif
+
+/**
+ * Initializes the write-behind module.
+ *
+ * @note Called by @ref model_config_file_init().
+ */
+void model_write_behind_init(void);
+
+/**
+ * Sets a new value for a model config entry, deferring the write.
+ *
+ * The value is validated and applied by the entry setter right away with
+ * `mesh_config_entry_set_deferred()`, only the write to persistent storage is deferred. The value is
+ * written directly if no slot is available for the entry.
+ *
+ * @param[in] id        Entry to set.
+ * @param[in] p_value   New entry value.
+ * @param[in] size      Size of the entry value.
+ *
+ * @retval NRF_SUCCESS              The value was applied and its write deferred, or written directly.
+ * @retval NRF_ERROR_INVALID_LENGTH The value is larger than @ref MODEL_WRITE_BEHIND_VALUE_SIZE_MAX.
+ * @returns Otherwise, the error returned by the entry setter.
+ */
+uint32_t model_write_behind_set(mesh_config_entry_id_t id, const void * p_value, uint8_t size);
+
+/**
+ * Gets the latest value of a model config entry, including a pending value.
+ *
+ * @param[in]  id       Entry to get.
+ * @param[out] p_value  Entry value output.
+ * @param[in]  size     Size of the entry value.
+ *
+ * @retval NRF_SUCCESS  The value was returned.
+ * @returns Otherwise, the result of the `mesh_config_entry_get()` call.
+ */
+uint32_t model_write_behind_get(mesh_config_entry_id_t id, void * p_value, uint8_t size);
+
+/**
+ * Writes all pending values to the mesh config module immediately.
+ */
+void model_write_behind_flush(void);
+
+/**
+ * Drops all pending values without writing them.
+ *
+ * @note Called by @ref model_config_file_clear() and when the model config file is reset after a
+ * load failure.
+ */
+void model_write_behind_clear(void);
+
+/** @} end of MODEL_WRITE_BEHIND */
+
+#endif /* MODEL_WRITE_BEHIND_H__ */
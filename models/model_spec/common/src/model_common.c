@@ -313,3 +313,53 @@ uint32_t model_timer_create(model_timer_t * p_timer)
     /* For simplicity, always operate app_timer in single shot mode */
     return (app_timer_create(p_timer->p_timer_id, APP_TIMER_MODE_SINGLE_SHOT, model_timer_cb));
 }
+
+uint32_t model_tx_reserve(access_model_handle_t handle,
+                          const access_message_rx_t * p_rx_msg,
+                          const access_message_tx_t * p_tx_msg,
+                          uint8_t ** pp_params)
+{
+    if (p_rx_msg == NULL)
+    {
+        return access_model_publish_reserve(handle, p_tx_msg, pp_params);
+    }
+    else
+    {
+        return access_model_reply_reserve(handle, p_rx_msg, p_tx_msg, pp_params);
+    }
+}
+
+bool model_publish_limiter_check(model_publish_limiter_t * p_limiter, uint32_t interval_ms)
+{
+    NRF_MESH_ASSERT(p_limiter != NULL);
+
+    if (interval_ms == 0)
+    {
+        return true;
+    }
+
+    NRF_MESH_ASSERT(p_limiter->cb != NULL);
+
+    timestamp_t now = timer_now();
+    timestamp_t next_publish = p_limiter->last_publish + MS_TO_US(interval_ms);
+
+    if (p_limiter->has_published && TIMER_OLDER_THAN(now, next_publish))
+    {
+        if (!timer_sch_is_scheduled(&p_limiter->timer))
+        {
+            p_limiter->timer.cb = p_limiter->cb;
+            p_limiter->timer.p_context = p_limiter->p_context;
+            p_limiter->timer.interval = 0;
+            timer_sch_reschedule(&p_limiter->timer, next_publish);
+        }
+        return false;
+    }
+
+    if (timer_sch_is_scheduled(&p_limiter->timer))
+    {
+        timer_sch_abort(&p_limiter->timer);
+    }
+    p_limiter->last_publish = now;
+    p_limiter->has_published = true;
+    return true;
+}
@@ -37,6 +37,7 @@
 
 #include "model_common.h"
 #include "model_config_file.h"
+#include "model_write_behind.h"
 
 #include <stdint.h>
 
@@ -247,6 +248,8 @@ __WEAK void custom_mc_clear(void)
 
 static void model_config_clear(void)
 {
+    model_write_behind_clear();
+
     generic_level_mc_clear();
     generic_onoff_mc_clear();
     generic_ponoff_mc_clear();
@@ -267,6 +270,8 @@ void model_config_file_init(void)
 
     m_status.is_load_failed = 0;
 
+    model_write_behind_init();
+
     generic_level_mc_init();
     generic_onoff_mc_init();
     generic_ponoff_mc_init();
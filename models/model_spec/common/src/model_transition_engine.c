@@ -0,0 +1,303 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "model_transition_engine.h"
+
+#include <stddef.h>
+
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "timer_scheduler.h"
+#include "utils.h"
+
+/** Longest step interval, keeps step timestamps well within the timer range. */
+#define STEP_INTERVAL_MAX_MS    (60000)
+/** Longest transition that fits in the steps at the longest step interval. */
+#define ENGINE_TIME_MAX_MS      ((uint32_t) MODEL_TRANSITION_ENGINE_STEPS_MAX * STEP_INTERVAL_MAX_MS)
+
+NRF_MESH_STATIC_ASSERT(MODEL_TRANSITION_ENGINE_TICK_MIN_MS > 0);
+/* A channel must never be due twice within one coalesced tick. */
+NRF_MESH_STATIC_ASSERT(MODEL_TRANSITION_ENGINE_COALESCE_US < MS_TO_US(MODEL_TRANSITION_ENGINE_TICK_MIN_MS));
+/* Keeps the step interval and transition time computations within 32 bits. */
+NRF_MESH_STATIC_ASSERT(MODEL_TRANSITION_ENGINE_STEPS_MAX <= (UINT32_MAX / STEP_INTERVAL_MAX_MS));
+
+static void timeout_cb(timestamp_t timestamp, void * p_context);
+
+/** Active channels. New channels are added at the head. */
+static model_transition_channel_t * mp_channels;
+static timer_event_t m_timer = {.cb = timeout_cb};
+
+static void channel_remove(model_transition_channel_t * p_channel)
+{
+    for (model_transition_channel_t ** pp_item = &mp_channels; *pp_item != NULL; pp_item = &(*pp_item)->p_next)
+    {
+        if (*pp_item == p_channel)
+        {
+            *pp_item = p_channel->p_next;
+            break;
+        }
+    }
+
+    p_channel->p_next = NULL;
+    p_channel->is_active = false;
+}
+
+static void timer_update(void)
+{
+    const model_transition_channel_t * p_first = mp_channels;
+
+    for (const model_transition_channel_t * p_item = mp_channels; p_item != NULL; p_item = p_item->p_next)
+    {
+        if (TIMER_OLDER_THAN(p_item->next_tick, p_first->next_tick))
+        {
+            p_first = p_item;
+        }
+    }
+
+    if (p_first == NULL)
+    {
+        timer_sch_abort(&m_timer);
+    }
+    else if (!timer_sch_is_scheduled(&m_timer) || m_timer.timestamp != p_first->next_tick)
+    {
+        timer_sch_reschedule(&m_timer, p_first->next_tick);
+    }
+}
+
+/* Moves next_tick to the end of the next step, i.e. to (index * time) / steps from the start. */
+static void next_tick_advance(model_transition_channel_t * p_channel)
+{
+    p_channel->next_tick += p_channel->interval_us;
+    p_channel->interval_err += p_channel->interval_rem;
+    if (p_channel->interval_err >= p_channel->steps)
+    {
+        p_channel->interval_err -= p_channel->steps;
+        p_channel->next_tick++;
+    }
+}
+
+/* Takes one step. Returns whether the transition is complete. */
+static bool step_take(model_transition_channel_t * p_channel)
+{
+    p_channel->value += p_channel->step;
+    p_channel->step_err += p_channel->step_rem;
+    if (p_channel->step_err >= p_channel->steps)
+    {
+        p_channel->step_err -= p_channel->steps;
+        p_channel->value += p_channel->step_sign;
+    }
+
+    p_channel->last_tick = p_channel->next_tick;
+    p_channel->step_index++;
+    if (p_channel->step_index == p_channel->steps)
+    {
+        if (!p_channel->is_move)
+        {
+            return true;
+        }
+
+        /* Both remainders have been fully distributed, and the next window repeats this one. */
+        p_channel->step_index = 0;
+        p_channel->elapsed_base_ms += p_channel->transition_time_ms;
+    }
+
+    next_tick_advance(p_channel);
+    return false;
+}
+
+static void timeout_cb(timestamp_t timestamp, void * p_context)
+{
+    timestamp_t horizon = timestamp + MODEL_TRANSITION_ENGINE_COALESCE_US;
+    model_transition_channel_t * p_channel = mp_channels;
+
+    while (p_channel != NULL)
+    {
+        /* The callback may abort the next channel, which clears its link and ends this pass. The
+         * remaining channels are then processed on the next timeout, scheduled right away. */
+        model_transition_channel_t * p_next = p_channel->p_next;
+
+        if (p_channel->is_active && !TIMER_OLDER_THAN(horizon, p_channel->next_tick))
+        {
+            bool is_complete;
+            do
+            {
+                is_complete = step_take(p_channel);
+            } while (!is_complete && !TIMER_OLDER_THAN(horizon, p_channel->next_tick));
+
+            if (is_complete)
+            {
+                channel_remove(p_channel);
+            }
+
+            p_channel->cb(p_channel, p_channel->value, is_complete);
+        }
+
+        p_channel = p_next;
+    }
+
+    timer_update();
+}
+
+uint32_t model_transition_engine_start(model_transition_channel_t * p_channel,
+                                       const model_transition_params_t * p_params)
+{
+    if (p_channel == NULL || p_params == NULL || p_channel->cb == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (p_params->delta == 0 || p_params->transition_time_ms == 0 ||
+        p_params->transition_time_ms > ENGINE_TIME_MAX_MS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (p_channel->is_active)
+    {
+        channel_remove(p_channel);
+    }
+
+    uint32_t magnitude = (p_params->delta < 0) ? (0u - (uint32_t) p_params->delta) : (uint32_t) p_params->delta;
+    uint32_t minimum_step_ms = MAX(p_params->minimum_step_ms, MODEL_TRANSITION_ENGINE_TICK_MIN_MS);
+    uint32_t steps = MIN(magnitude, p_params->transition_time_ms / minimum_step_ms);
+    steps = MIN(steps, MODEL_TRANSITION_ENGINE_STEPS_MAX);
+    steps = MAX(steps, CEIL_DIV(p_params->transition_time_ms, STEP_INTERVAL_MAX_MS));
+
+    /* Split the value and the time in equal steps and a remainder, to be spread over the steps. */
+    p_channel->steps = steps;
+    p_channel->step_sign = (p_params->delta < 0) ? -1 : 1;
+    p_channel->step = p_channel->step_sign * (int32_t) (magnitude / steps);
+    p_channel->step_rem = magnitude % steps;
+
+    uint32_t interval_ms_rem = p_params->transition_time_ms % steps;
+    p_channel->interval_us = MS_TO_US(p_params->transition_time_ms / steps) + MS_TO_US(interval_ms_rem) / steps;
+    p_channel->interval_rem = MS_TO_US(interval_ms_rem) % steps;
+
+    p_channel->is_move = p_params->is_move;
+    p_channel->transition_time_ms = p_params->transition_time_ms;
+    p_channel->value = 0;
+    p_channel->step_err = 0;
+    p_channel->interval_err = 0;
+    p_channel->step_index = 0;
+    p_channel->elapsed_base_ms = 0;
+    p_channel->last_tick = timer_now();
+    p_channel->next_tick = p_channel->last_tick;
+    next_tick_advance(p_channel);
+
+    p_channel->is_active = true;
+    p_channel->p_next = mp_channels;
+    mp_channels = p_channel;
+
+    timer_update();
+    return NRF_SUCCESS;
+}
+
+void model_transition_engine_abort(model_transition_channel_t * p_channel)
+{
+    NRF_MESH_ASSERT(p_channel != NULL);
+
+    if (p_channel->is_active)
+    {
+        channel_remove(p_channel);
+        timer_update();
+    }
+}
+
+bool model_transition_engine_is_active(const model_transition_channel_t * p_channel)
+{
+    NRF_MESH_ASSERT(p_channel != NULL);
+
+    return p_channel->is_active;
+}
+
+uint32_t model_transition_engine_elapsed_ms_get(const model_transition_channel_t * p_channel)
+{
+    NRF_MESH_ASSERT(p_channel != NULL);
+
+    if (!p_channel->is_active)
+    {
+        return 0;
+    }
+
+    /* Counted from the last step, as the transition may be longer than the timestamp range. */
+    uint32_t elapsed_ms = p_channel->elapsed_base_ms +
+                          (uint32_t) (((uint64_t) p_channel->step_index * p_channel->transition_time_ms) / p_channel->steps) +
+                          (timer_now() - p_channel->last_tick) / 1000;
+
+    return p_channel->is_move ? elapsed_ms : MIN(elapsed_ms, p_channel->transition_time_ms);
+}
+
+void model_transition_engine_follower_start(model_transition_follower_t * p_follower,
+                                            const model_transition_channel_t * p_channel,
+                                            int32_t delta)
+{
+    NRF_MESH_ASSERT(p_follower != NULL && p_channel != NULL);
+    NRF_MESH_ASSERT(p_channel->is_active && !p_channel->is_move && p_channel->step_index == 0);
+
+    uint32_t magnitude = (delta < 0) ? (0u - (uint32_t) delta) : (uint32_t) delta;
+
+    p_follower->steps = p_channel->steps;
+    p_follower->step_sign = (delta < 0) ? -1 : 1;
+    p_follower->step = p_follower->step_sign * (int32_t) (magnitude / p_follower->steps);
+    p_follower->step_rem = magnitude % p_follower->steps;
+    p_follower->step_err = 0;
+    p_follower->step_index = 0;
+    p_follower->value = 0;
+}
+
+int32_t model_transition_engine_follower_value_get(model_transition_follower_t * p_follower,
+                                                   const model_transition_channel_t * p_channel)
+{
+    NRF_MESH_ASSERT(p_follower != NULL && p_channel != NULL);
+
+    uint32_t step_index = p_channel->is_active ? p_channel->step_index : p_follower->steps;
+
+    /* Same stepping as the channel itself, so the follower lands on its delta on the last step. */
+    while (p_follower->step_index < step_index)
+    {
+        p_follower->value += p_follower->step;
+        p_follower->step_err += p_follower->step_rem;
+        if (p_follower->step_err >= p_follower->steps)
+        {
+            p_follower->step_err -= p_follower->steps;
+            p_follower->value += p_follower->step_sign;
+        }
+        p_follower->step_index++;
+    }
+
+    return p_follower->value;
+}
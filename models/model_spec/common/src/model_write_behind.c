@@ -0,0 +1,277 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "model_write_behind.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "mesh_config.h"
+#include "nrf_mesh_assert.h"
+#include "nrf_mesh_events.h"
+#include "timer.h"
+#include "timer_scheduler.h"
+#include "utils.h"
+#include "log.h"
+
+NRF_MESH_STATIC_ASSERT(MODEL_WRITE_BEHIND_DELAY_MS <= MODEL_WRITE_BEHIND_DELAY_MAX_MS);
+
+typedef struct
+{
+    bool in_use;
+    uint8_t size;
+    mesh_config_entry_id_t id;
+    /** Time of the first change since the entry was last written. */
+    timestamp_t first_change;
+    /** Time at which the pending value is written. */
+    timestamp_t deadline;
+    uint8_t value[MODEL_WRITE_BEHIND_VALUE_SIZE_MAX];
+} write_behind_slot_t;
+
+static write_behind_slot_t m_slots[MODEL_WRITE_BEHIND_SLOT_COUNT];
+static timer_event_t m_timer;
+static nrf_mesh_evt_handler_t m_mesh_evt_handler;
+static bool m_is_power_down;
+
+static bool entry_id_equal(mesh_config_entry_id_t a, mesh_config_entry_id_t b)
+{
+    return (a.file == b.file && a.record == b.record);
+}
+
+static write_behind_slot_t * slot_find(mesh_config_entry_id_t id)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (m_slots[i].in_use && entry_id_equal(m_slots[i].id, id))
+        {
+            return &m_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static write_behind_slot_t * slot_alloc(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (!m_slots[i].in_use)
+        {
+            return &m_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void slot_write(write_behind_slot_t * p_slot)
+{
+    p_slot->in_use = false;
+
+    uint32_t status = mesh_config_entry_set(p_slot->id, p_slot->value);
+    if (status != NRF_SUCCESS)
+    {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Deferred write of 0x%04x:0x%04x failed: %u\n",
+              p_slot->id.file, p_slot->id.record, status);
+    }
+}
+
+static void slots_write_all(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (m_slots[i].in_use)
+        {
+            slot_write(&m_slots[i]);
+        }
+    }
+}
+
+static void timer_update(void)
+{
+    const write_behind_slot_t * p_next = NULL;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (m_slots[i].in_use &&
+            (p_next == NULL || TIMER_OLDER_THAN(m_slots[i].deadline, p_next->deadline)))
+        {
+            p_next = &m_slots[i];
+        }
+    }
+
+    if (p_next == NULL)
+    {
+        timer_sch_abort(&m_timer);
+    }
+    else if (!timer_sch_is_scheduled(&m_timer) || m_timer.timestamp != p_next->deadline)
+    {
+        timer_sch_reschedule(&m_timer, p_next->deadline);
+    }
+}
+
+static void timeout_cb(timestamp_t timestamp, void * p_context)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        if (m_slots[i].in_use && !TIMER_OLDER_THAN(timestamp, m_slots[i].deadline))
+        {
+            slot_write(&m_slots[i]);
+        }
+    }
+
+    timer_update();
+}
+
+static void mesh_evt_handler(const nrf_mesh_evt_t * p_evt)
+{
+    if (p_evt->type == NRF_MESH_EVT_CONFIG_POWER_DOWN)
+    {
+        /* The timer scheduler is stopped at this point, writes from here on go to the emergency
+         * cache. */
+        m_is_power_down = true;
+        slots_write_all();
+    }
+}
+
+void model_write_behind_init(void)
+{
+    memset(m_slots, 0, sizeof(m_slots));
+    m_is_power_down = false;
+
+    m_timer.cb = timeout_cb;
+    m_timer.interval = 0;
+    m_timer.p_context = NULL;
+
+    m_mesh_evt_handler.evt_cb = mesh_evt_handler;
+    nrf_mesh_evt_handler_add(&m_mesh_evt_handler);
+}
+
+uint32_t model_write_behind_set(mesh_config_entry_id_t id, const void * p_value, uint8_t size)
+{
+    if (size > MODEL_WRITE_BEHIND_VALUE_SIZE_MAX)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    if (m_is_power_down)
+    {
+        return mesh_config_entry_set(id, p_value);
+    }
+
+    timestamp_t now = timer_now();
+    write_behind_slot_t * p_slot = slot_find(id);
+
+    if (p_slot == NULL)
+    {
+        uint8_t current[MODEL_WRITE_BEHIND_VALUE_SIZE_MAX];
+        if (mesh_config_entry_get(id, current) == NRF_SUCCESS &&
+            memcmp(current, p_value, size) == 0)
+        {
+            return NRF_SUCCESS;
+        }
+
+        p_slot = slot_alloc();
+        if (p_slot == NULL)
+        {
+            return mesh_config_entry_set(id, p_value);
+        }
+    }
+    else if (memcmp(p_slot->value, p_value, size) == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    /* Let the state owner validate and apply the value now, only the flash write is deferred. */
+    uint32_t status = mesh_config_entry_set_deferred(id, p_value);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    if (!p_slot->in_use)
+    {
+        p_slot->in_use = true;
+        p_slot->id = id;
+        p_slot->size = size;
+        p_slot->first_change = now;
+    }
+
+    memcpy(p_slot->value, p_value, size);
+
+    timestamp_t deadline = now + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MS);
+    timestamp_t deadline_max = p_slot->first_change + MS_TO_US(MODEL_WRITE_BEHIND_DELAY_MAX_MS);
+    p_slot->deadline = TIMER_OLDER_THAN(deadline_max, deadline) ? deadline_max : deadline;
+
+    timer_update();
+    return NRF_SUCCESS;
+}
+
+uint32_t model_write_behind_get(mesh_config_entry_id_t id, void * p_value, uint8_t size)
+{
+    const write_behind_slot_t * p_slot = slot_find(id);
+
+    if (p_slot == NULL)
+    {
+        return mesh_config_entry_get(id, p_value);
+    }
+
+    NRF_MESH_ASSERT_DEBUG(p_slot->size == size);
+    memcpy(p_value, p_slot->value, size);
+    return NRF_SUCCESS;
+}
+
+void model_write_behind_flush(void)
+{
+    slots_write_all();
+
+    if (!m_is_power_down)
+    {
+        timer_sch_abort(&m_timer);
+    }
+}
+
+void model_write_behind_clear(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_slots); i++)
+    {
+        m_slots[i].in_use = false;
+    }
+
+    if (!m_is_power_down)
+    {
+        timer_sch_abort(&m_timer);
+    }
+}
@@ -52,6 +52,18 @@
 /** Server model ID */
 #define GENERIC_LEVEL_SERVER_MODEL_ID 0x1002
 
+/** Default window for coalescing unacknowledged Delta Set and Move Set messages, in milliseconds.
+ * See @ref generic_level_server_settings_t::coalesce_interval_ms. */
+#ifndef GENERIC_LEVEL_SERVER_COALESCE_INTERVAL_MS
+#define GENERIC_LEVEL_SERVER_COALESCE_INTERVAL_MS (100)
+#endif
+
+/** Default minimum interval between unsolicited Status publications, in milliseconds.
+ * See @ref generic_level_server_settings_t::publish_interval_min_ms. */
+#ifndef GENERIC_LEVEL_SERVER_PUBLISH_INTERVAL_MIN_MS
+#define GENERIC_LEVEL_SERVER_PUBLISH_INTERVAL_MIN_MS (250)
+#endif
+
 /* Forward declaration */
 typedef struct __generic_level_server_t generic_level_server_t;
 
@@ -158,10 +170,50 @@ typedef struct
      * See @ref nrf_mesh_transmic_size_t and @ref mesh_model_large_mic. */
     nrf_mesh_transmic_size_t transmic_size;
 
+    /** Window for coalescing unacknowledged Delta Set and Move Set messages, in milliseconds, or
+     * zero to pass every message to the application.
+     *
+     * The first message of a stream is passed to the application immediately. The messages received
+     * within the window after it are merged into one: the deltas of consecutive transactions are
+     * accumulated and the last Move Set wins. The merged message is passed to the application at the
+     * end of the window, which opens the next window. A received Set, Get or acknowledged message
+     * passes the merged message to the application before it is handled.
+     *
+     * Merged deltas are passed to the application as if they were one cumulative transaction, so
+     * @ref model_transaction_is_new() tells the application whether to apply them to the present
+     * level or to the initial level of the ongoing transaction. */
+    uint32_t coalesce_interval_ms;
+    /** Minimum interval between unsolicited Status publications, in milliseconds, or zero to not
+     * limit. See @ref generic_level_server_status_publish(). */
+    uint32_t publish_interval_min_ms;
+
     /** Callback list. */
     const generic_level_server_callbacks_t * p_callbacks;
 } generic_level_server_settings_t;
 
+/** Unacknowledged Delta Set and Move Set messages held back within the coalescing window. */
+typedef struct
+{
+    /** Internal variable. Coalescing window timer. */
+    timer_event_t timer;
+    /** Internal variable. Metadata of the last merged message. */
+    access_message_rx_meta_t meta;
+    /** Internal variable. Opcode of the held back message, if any. */
+    uint16_t pending_opcode;
+    /** Internal variable. Whether the held back message starts a new transaction for the application. */
+    bool new_transaction;
+    /** Internal variable. Deltas of the merged transactions before the last one. */
+    int32_t delta_base;
+    /** Internal variable. Last Delta Set message. */
+    generic_level_delta_set_params_t delta_set;
+    /** Internal variable. Last Move Set message. */
+    generic_level_move_set_params_t move_set;
+    /** Internal variable. Transition parameters of the held back message. */
+    model_transition_t transition;
+    /** Internal variable. Whether the held back message has transition parameters. */
+    bool has_transition;
+} generic_level_server_coalesce_t;
+
 /**  */
 struct __generic_level_server_t
 {
@@ -175,6 +227,13 @@ struct __generic_level_server_t
 
     /** State handle for this instance. */
     uint8_t state_handle;
+
+    /** Coalesced Delta Set and Move Set messages. */
+    generic_level_server_coalesce_t coalesce;
+    /** Rate limiter for unsolicited Status publications. */
+    model_publish_limiter_t publish_limiter;
+    /** Last Status parameters given for publication. */
+    generic_level_status_params_t publish_params;
 };
 
 /**
@@ -202,10 +261,14 @@ uint32_t generic_level_server_init(generic_level_server_t * p_server, uint8_t el
  *
  * This API can be used to send unsolicited messages to report updated state value as a result of local action.
  *
+ * If the previous publication is more recent than
+ * @ref generic_level_server_settings_t::publish_interval_min_ms, the message is held back and the
+ * parameters of the last call are published when the interval has passed.
+ *
  * @param[in]     p_server                 Status server context pointer.
  * @param[in]     p_params                 Message parameters.
  *
- * @retval NRF_SUCCESS              If the message is published successfully.
+ * @retval NRF_SUCCESS              If the message is published successfully, or held back.
  * @retval NRF_ERROR_NULL           NULL pointer given to function.
  * @retval NRF_ERROR_NO_MEM         No memory available to send the message at this point.
  * @retval NRF_ERROR_NOT_FOUND      The model is not initialized.
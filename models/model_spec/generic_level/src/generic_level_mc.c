@@ -42,6 +42,7 @@
 #include "mesh_config_entry.h"
 #include "mesh_config.h"
 #include "mesh_opt.h"
+#include "model_write_behind.h"
 
 #include "nrf_mesh_assert.h"
 
@@ -207,7 +208,7 @@ uint32_t generic_level_mc_level_state_set(uint8_t index, int16_t value)
     mesh_config_entry_id_t id = GENERIC_LEVEL_EID;
 
     id.record += index;
-    return mesh_config_entry_set(id, &value);
+    return model_write_behind_set(id, &value, sizeof(value));
 }
 
 uint32_t generic_level_mc_level_state_get(uint8_t index, int16_t * p_value)
@@ -215,7 +216,7 @@ uint32_t generic_level_mc_level_state_get(uint8_t index, int16_t * p_value)
     mesh_config_entry_id_t id = GENERIC_LEVEL_EID;
 
     id.record += index;
-    return mesh_config_entry_get(id, p_value);
+    return model_write_behind_get(id, p_value, sizeof(*p_value));
 }
 
 #if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
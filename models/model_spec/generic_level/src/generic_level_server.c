@@ -52,31 +52,40 @@ static uint32_t status_send(generic_level_server_t * p_server,
                             const access_message_rx_t * p_message,
                             const generic_level_status_params_t * p_params)
 {
-    generic_level_status_msg_pkt_t msg_pkt;
-
-    msg_pkt.present_level = p_params->present_level;
-    if (p_params->remaining_time_ms > 0)
-    {
-        msg_pkt.target_level = p_params->target_level;
-        msg_pkt.remaining_time = model_transition_time_encode(p_params->remaining_time_ms);
-    }
-
     access_message_tx_t reply =
     {
         .opcode = ACCESS_OPCODE_SIG(GENERIC_LEVEL_OPCODE_STATUS),
-        .p_buffer = (const uint8_t *) &msg_pkt,
+        .p_buffer = NULL,
         .length = p_params->remaining_time_ms > 0 ? GENERIC_LEVEL_STATUS_MAXLEN : GENERIC_LEVEL_STATUS_MINLEN,
         .force_segmented = p_server->settings.force_segmented,
         .transmic_size = p_server->settings.transmic_size
     };
 
-    if (p_message == NULL)
+    uint8_t * p_buffer;
+    uint32_t status = model_tx_reserve(p_server->model_handle, p_message, &reply, &p_buffer);
+    if (status != NRF_SUCCESS)
     {
-        return access_model_publish(p_server->model_handle, &reply);
+        return status;
     }
-    else
+
+    generic_level_status_msg_pkt_t * p_msg_pkt = (generic_level_status_msg_pkt_t *) p_buffer;
+    p_msg_pkt->present_level = p_params->present_level;
+    if (p_params->remaining_time_ms > 0)
     {
-        return access_model_reply(p_server->model_handle, p_message, &reply);
+        p_msg_pkt->target_level = p_params->target_level;
+        p_msg_pkt->remaining_time = model_transition_time_encode(p_params->remaining_time_ms);
+    }
+
+    return access_model_tx_commit(p_server->model_handle);
+}
+
+static void publish_limiter_cb(timestamp_t timestamp, void * p_context)
+{
+    generic_level_server_t * p_server = (generic_level_server_t *) p_context;
+
+    if (model_publish_limiter_check(&p_server->publish_limiter, p_server->settings.publish_interval_min_ms))
+    {
+        (void) status_send(p_server, NULL, &p_server->publish_params);
     }
 }
 
@@ -89,6 +98,142 @@ static void periodic_publish_cb(access_model_handle_t handle, void * p_args)
     (void) status_send(p_server, NULL, &out_data);
 }
 
+/** Coalescing of unacknowledged Delta Set and Move Set messages */
+
+static int32_t delta_add(int32_t delta, int32_t addend)
+{
+    int64_t sum = (int64_t) delta + addend;
+
+    return (int32_t) MAX(INT32_MIN, MIN(INT32_MAX, sum));
+}
+
+static void coalesce_deliver(generic_level_server_t * p_server)
+{
+    generic_level_server_coalesce_t * p_coalesce = &p_server->coalesce;
+    const model_transition_t * p_in_transition = p_coalesce->has_transition ? &p_coalesce->transition : NULL;
+    uint16_t opcode = p_coalesce->pending_opcode;
+
+    if (opcode == 0)
+    {
+        return;
+    }
+
+    /* The application checks the transaction of the merged message, not of the last received one. */
+    p_coalesce->pending_opcode = 0;
+    p_server->tid_tracker.new_transaction = p_coalesce->new_transaction;
+    p_coalesce->new_transaction = false;
+
+    if (opcode == GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED)
+    {
+        generic_level_delta_set_params_t in_data = p_coalesce->delta_set;
+        in_data.delta_level = delta_add(p_coalesce->delta_base, p_coalesce->delta_set.delta_level);
+
+        p_server->settings.p_callbacks->level_cbs.delta_set_cb(p_server, &p_coalesce->meta, &in_data,
+                                                               p_in_transition, NULL);
+    }
+    else
+    {
+        p_server->settings.p_callbacks->level_cbs.move_set_cb(p_server, &p_coalesce->meta, &p_coalesce->move_set,
+                                                              p_in_transition, NULL);
+    }
+}
+
+static void coalesce_flush(generic_level_server_t * p_server)
+{
+    coalesce_deliver(p_server);
+    p_server->coalesce.delta_base = 0;
+}
+
+static void coalesce_timer_cb(timestamp_t timestamp, void * p_context)
+{
+    generic_level_server_t * p_server = (generic_level_server_t *) p_context;
+
+    /* Messages merged within the window are passed on at its end, which opens the next window. */
+    if (p_server->coalesce.pending_opcode != 0)
+    {
+        coalesce_deliver(p_server);
+        timer_sch_reschedule(&p_server->coalesce.timer,
+                             timestamp + MS_TO_US(p_server->settings.coalesce_interval_ms));
+    }
+}
+
+static void coalesce_add(generic_level_server_t * p_server,
+                         const access_message_rx_meta_t * p_meta,
+                         uint16_t opcode,
+                         const model_transition_t * p_in_transition)
+{
+    generic_level_server_coalesce_t * p_coalesce = &p_server->coalesce;
+
+    p_coalesce->pending_opcode = opcode;
+    p_coalesce->meta = *p_meta;
+    p_coalesce->meta.p_core_metadata = NULL;
+    p_coalesce->has_transition = (p_in_transition != NULL);
+    if (p_in_transition != NULL)
+    {
+        p_coalesce->transition = *p_in_transition;
+    }
+
+    if (!timer_sch_is_scheduled(&p_coalesce->timer))
+    {
+        coalesce_deliver(p_server);
+        timer_sch_reschedule(&p_coalesce->timer,
+                             timer_now() + MS_TO_US(p_server->settings.coalesce_interval_ms));
+    }
+}
+
+static void delta_set_coalesce(generic_level_server_t * p_server,
+                               const access_message_rx_meta_t * p_meta,
+                               const generic_level_delta_set_params_t * p_in,
+                               const model_transition_t * p_in_transition,
+                               bool new_transaction)
+{
+    generic_level_server_coalesce_t * p_coalesce = &p_server->coalesce;
+
+    if (p_coalesce->pending_opcode == GENERIC_LEVEL_OPCODE_MOVE_SET_UNACKNOWLEDGED)
+    {
+        coalesce_deliver(p_server);
+    }
+
+    /* The delta of a transaction is cumulative, so only the last message of a transaction counts.
+     * A new transaction that follows a held back message continues from its target: the held back
+     * delta becomes part of the base the new deltas are added to. Otherwise the application has
+     * already seen the last message of the previous transaction, and the new transaction starts
+     * from the present level. */
+    if (new_transaction)
+    {
+        if (p_coalesce->pending_opcode == GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED)
+        {
+            p_coalesce->delta_base = delta_add(p_coalesce->delta_base, p_coalesce->delta_set.delta_level);
+        }
+        else
+        {
+            p_coalesce->delta_base = 0;
+            p_coalesce->new_transaction = true;
+        }
+    }
+
+    p_coalesce->delta_set = *p_in;
+    coalesce_add(p_server, p_meta, GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED, p_in_transition);
+}
+
+static void move_set_coalesce(generic_level_server_t * p_server,
+                              const access_message_rx_meta_t * p_meta,
+                              const generic_level_move_set_params_t * p_in,
+                              const model_transition_t * p_in_transition)
+{
+    generic_level_server_coalesce_t * p_coalesce = &p_server->coalesce;
+
+    if (p_coalesce->pending_opcode == GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED)
+    {
+        coalesce_flush(p_server);
+    }
+
+    /* Only the last move matters. */
+    p_coalesce->move_set = *p_in;
+    p_coalesce->new_transaction = true;
+    coalesce_add(p_server, p_meta, GENERIC_LEVEL_OPCODE_MOVE_SET_UNACKNOWLEDGED, p_in_transition);
+}
+
 /** Opcode Handlers */
 
 static void handle_set(access_model_handle_t model_handle, const access_message_rx_t * p_rx_msg, void * p_args)
@@ -98,6 +243,8 @@ static void handle_set(access_model_handle_t model_handle, const access_message_
     model_transition_t in_data_tr = {0};
     generic_level_status_params_t out_data = {0};
 
+    coalesce_flush(p_server);
+
     if (p_rx_msg->length == GENERIC_LEVEL_SET_MINLEN || p_rx_msg->length == GENERIC_LEVEL_SET_MAXLEN)
     {
         generic_level_set_msg_pkt_t * p_msg_params_packed = (generic_level_set_msg_pkt_t *) p_rx_msg->p_data;
@@ -136,6 +283,13 @@ static void handle_delta_set(access_model_handle_t model_handle, const access_me
     generic_level_delta_set_params_t in_data = {0};
     model_transition_t in_data_tr = {0};
     generic_level_status_params_t out_data = {0};
+    bool coalesce = (p_rx_msg->opcode.opcode == GENERIC_LEVEL_OPCODE_DELTA_SET_UNACKNOWLEDGED &&
+                     p_server->settings.coalesce_interval_ms > 0);
+
+    if (!coalesce)
+    {
+        coalesce_flush(p_server);
+    }
 
     if (p_rx_msg->length == GENERIC_LEVEL_DELTA_SET_MINLEN || p_rx_msg->length == GENERIC_LEVEL_DELTA_SET_MAXLEN)
     {
@@ -143,7 +297,8 @@ static void handle_delta_set(access_model_handle_t model_handle, const access_me
         in_data.delta_level = p_msg_params_packed->delta_level;
         in_data.tid = p_msg_params_packed->tid;
 
-        (void) model_tid_validate(&p_server->tid_tracker, &p_rx_msg->meta_data, GENERIC_LEVEL_OPCODE_DELTA_SET, in_data.tid);
+        bool new_transaction = model_tid_validate(&p_server->tid_tracker, &p_rx_msg->meta_data,
+                                                  GENERIC_LEVEL_OPCODE_DELTA_SET, in_data.tid);
         if (p_rx_msg->length == GENERIC_LEVEL_DELTA_SET_MAXLEN)
         {
             if (!model_transition_time_is_valid(p_msg_params_packed->transition_time))
@@ -155,6 +310,14 @@ static void handle_delta_set(access_model_handle_t model_handle, const access_me
             in_data_tr.delay_ms = model_delay_decode(p_msg_params_packed->delay);
         }
 
+        if (coalesce)
+        {
+            delta_set_coalesce(p_server, &p_rx_msg->meta_data, &in_data,
+                               (p_rx_msg->length == GENERIC_LEVEL_DELTA_SET_MINLEN) ? NULL : &in_data_tr,
+                               new_transaction);
+            return;
+        }
+
         p_server->settings.p_callbacks->level_cbs.delta_set_cb(p_server,
                                                             &p_rx_msg->meta_data, &in_data,
                                                             (p_rx_msg->length == GENERIC_LEVEL_DELTA_SET_MINLEN) ? NULL : &in_data_tr,
@@ -173,6 +336,13 @@ static void handle_move_set(access_model_handle_t model_handle, const access_mes
     generic_level_move_set_params_t in_data = {0};
     model_transition_t in_data_tr = {0};
     generic_level_status_params_t out_data = {0};
+    bool coalesce = (p_rx_msg->opcode.opcode == GENERIC_LEVEL_OPCODE_MOVE_SET_UNACKNOWLEDGED &&
+                     p_server->settings.coalesce_interval_ms > 0);
+
+    if (!coalesce)
+    {
+        coalesce_flush(p_server);
+    }
 
     if (p_rx_msg->length == GENERIC_LEVEL_MOVE_SET_MINLEN || p_rx_msg->length == GENERIC_LEVEL_MOVE_SET_MAXLEN)
     {
@@ -193,6 +363,13 @@ static void handle_move_set(access_model_handle_t model_handle, const access_mes
                 in_data_tr.delay_ms = model_delay_decode(p_msg_params_packed->delay);
             }
 
+            if (coalesce)
+            {
+                move_set_coalesce(p_server, &p_rx_msg->meta_data, &in_data,
+                                  (p_rx_msg->length == GENERIC_LEVEL_MOVE_SET_MINLEN) ? NULL : &in_data_tr);
+                return;
+            }
+
             p_server->settings.p_callbacks->level_cbs.move_set_cb(p_server,
                                                                 &p_rx_msg->meta_data, &in_data,
                                                                 (p_rx_msg->length == GENERIC_LEVEL_MOVE_SET_MINLEN) ? NULL : &in_data_tr,
@@ -211,6 +388,8 @@ static void handle_get(access_model_handle_t model_handle, const access_message_
     generic_level_server_t * p_server = (generic_level_server_t *) p_args;
     generic_level_status_params_t out_data = {0};
 
+    coalesce_flush(p_server);
+
     if (p_rx_msg->length == 0)
     {
         p_server->settings.p_callbacks->level_cbs.get_cb(p_server, &p_rx_msg->meta_data, &out_data);
@@ -253,6 +432,11 @@ uint32_t generic_level_server_init(generic_level_server_t * p_server, uint8_t el
         .publish_timeout_cb = periodic_publish_cb
     };
 
+    p_server->coalesce.timer.cb = coalesce_timer_cb;
+    p_server->coalesce.timer.p_context = p_server;
+    p_server->publish_limiter.cb = publish_limiter_cb;
+    p_server->publish_limiter.p_context = p_server;
+
     uint32_t status = access_model_add(&init_params, &p_server->model_handle);
 
     if (status == NRF_SUCCESS)
@@ -271,7 +455,14 @@ uint32_t generic_level_server_status_publish(generic_level_server_t * p_server,
         return NRF_ERROR_NULL;
     }
 
-    return status_send(p_server, NULL, p_params);
+    /* A held back publication sends the latest parameters when it is due. */
+    p_server->publish_params = *p_params;
+    if (!model_publish_limiter_check(&p_server->publish_limiter, p_server->settings.publish_interval_min_ms))
+    {
+        return NRF_SUCCESS;
+    }
+
+    return status_send(p_server, NULL, &p_server->publish_params);
 }
 
 
@@ -42,6 +42,7 @@
 #include "mesh_config_entry.h"
 #include "mesh_config.h"
 #include "mesh_opt.h"
+#include "model_write_behind.h"
 #include "nrf_mesh_assert.h"
 
 #if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
@@ -195,7 +196,7 @@ uint32_t generic_onoff_mc_onoff_state_set(uint8_t index, bool value)
     mesh_config_entry_id_t id = GENERIC_ONOFF_EID;
 
     id.record += index;
-    return mesh_config_entry_set(id, &value);
+    return model_write_behind_set(id, &value, sizeof(value));
 }
 
 uint32_t generic_onoff_mc_onoff_state_get(uint8_t index, bool * p_value)
@@ -203,7 +204,7 @@ uint32_t generic_onoff_mc_onoff_state_get(uint8_t index, bool * p_value)
     mesh_config_entry_id_t id = GENERIC_ONOFF_EID;
 
     id.record += index;
-    return mesh_config_entry_get(id, p_value);
+    return model_write_behind_get(id, p_value, sizeof(*p_value));
 }
 
 #if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
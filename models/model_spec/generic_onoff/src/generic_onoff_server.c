@@ -54,8 +54,6 @@ static uint32_t status_send(generic_onoff_server_t * p_server,
                             const access_message_rx_t * p_message,
                             const generic_onoff_status_params_t * p_params)
 {
-    generic_onoff_status_msg_pkt_t msg_pkt;
-
     if (p_params->present_on_off > GENERIC_ONOFF_MAX ||
         p_params->target_on_off  > GENERIC_ONOFF_MAX ||
         p_params->remaining_time_ms > TRANSITION_TIME_STEP_10M_MAX)
@@ -63,30 +61,32 @@ static uint32_t status_send(generic_onoff_server_t * p_server,
         return NRF_ERROR_INVALID_PARAM;
     }
 
-    msg_pkt.present_on_off = p_params->present_on_off;
-    if (p_params->remaining_time_ms > 0)
-    {
-        msg_pkt.target_on_off = p_params->target_on_off;
-        msg_pkt.remaining_time = model_transition_time_encode(p_params->remaining_time_ms);
-    }
-
     access_message_tx_t reply =
     {
         .opcode = ACCESS_OPCODE_SIG(GENERIC_ONOFF_OPCODE_STATUS),
-        .p_buffer = (const uint8_t *) &msg_pkt,
+        .p_buffer = NULL,
         .length = p_params->remaining_time_ms > 0 ? GENERIC_ONOFF_STATUS_MAXLEN : GENERIC_ONOFF_STATUS_MINLEN,
         .force_segmented = p_server->settings.force_segmented,
         .transmic_size = p_server->settings.transmic_size
     };
 
-    if (p_message == NULL)
+    uint8_t * p_buffer;
+    uint32_t status = model_tx_reserve(p_server->model_handle, p_message, &reply, &p_buffer);
+    if (status != NRF_SUCCESS)
     {
-        return access_model_publish(p_server->model_handle, &reply);
+        return status;
     }
-    else
+
+    /* Serialize straight into the reserved network buffer. Only the reserved length is written. */
+    generic_onoff_status_msg_pkt_t * p_msg_pkt = (generic_onoff_status_msg_pkt_t *) p_buffer;
+    p_msg_pkt->present_on_off = p_params->present_on_off;
+    if (p_params->remaining_time_ms > 0)
     {
-        return access_model_reply(p_server->model_handle, p_message, &reply);
+        p_msg_pkt->target_on_off = p_params->target_on_off;
+        p_msg_pkt->remaining_time = model_transition_time_encode(p_params->remaining_time_ms);
     }
+
+    return access_model_tx_commit(p_server->model_handle);
 }
 
 static void periodic_publish_cb(access_model_handle_t handle, void * p_args)
@@ -41,6 +41,7 @@
 
 #include "mesh_config_entry.h"
 #include "mesh_opt.h"
+#include "model_write_behind.h"
 
 #include "light_ctl_common.h"
 #include "light_ctl_utils.h"
@@ -356,7 +357,7 @@ uint32_t light_ctl_mc_temperature32_state_set(uint8_t index, uint32_t value)
     mesh_config_entry_id_t id = LIGHT_CTL_TEMPERATURE_EID;
 
     id.record += index;
-    return mesh_config_entry_set(id, &value);
+    return model_write_behind_set(id, &value, sizeof(value));
 }
 
 uint32_t light_ctl_mc_temperature32_state_get(uint8_t index, uint32_t * p_value)
@@ -364,7 +365,7 @@ uint32_t light_ctl_mc_temperature32_state_get(uint8_t index, uint32_t * p_value)
     mesh_config_entry_id_t id = LIGHT_CTL_TEMPERATURE_EID;
 
     id.record += index;
-    return mesh_config_entry_get(id, p_value);
+    return model_write_behind_get(id, p_value, sizeof(*p_value));
 }
 
 uint32_t light_ctl_mc_delta_uv_state_set(uint8_t index, int16_t value)
@@ -372,7 +373,7 @@ uint32_t light_ctl_mc_delta_uv_state_set(uint8_t index, int16_t value)
     mesh_config_entry_id_t id = LIGHT_CTL_DELTA_UV_EID;
 
     id.record += index;
-    return mesh_config_entry_set(id, &value);
+    return model_write_behind_set(id, &value, sizeof(value));
 }
 
 uint32_t light_ctl_mc_delta_uv_state_get(uint8_t index, int16_t * p_value)
@@ -380,7 +381,7 @@ uint32_t light_ctl_mc_delta_uv_state_get(uint8_t index, int16_t * p_value)
     mesh_config_entry_id_t id = LIGHT_CTL_DELTA_UV_EID;
 
     id.record += index;
-    return mesh_config_entry_get(id, p_value);
+    return model_write_behind_get(id, p_value, sizeof(*p_value));
 }
 
 uint32_t light_ctl_mc_default_temperature32_state_set(uint8_t index, uint32_t value)
@@ -2,6 +2,7 @@
 #include "nrf_mesh_config_app.h"
 #include "mesh_config_entry.h"
 #include "mesh_opt.h"
+#include "model_write_behind.h"
 #include "light_hsl_common.h"
 
 
@@ -303,7 +304,7 @@ uint32_t light_hsl_mc_hue_state_set(uint8_t index, uint16_t value)
     mesh_config_entry_id_t id = LIGHT_HSL_HUE_EID;
 
     id.record += index;
-    return mesh_config_entry_set(id, &value);
+    return model_write_behind_set(id, &value, sizeof(value));
 }
 
 
@@ -312,7 +313,7 @@ uint32_t light_hsl_mc_hue_state_get(uint8_t index, uint16_t *p_value)
     mesh_config_entry_id_t id = LIGHT_HSL_HUE_EID;
 
     id.record += index;
-    return mesh_config_entry_get(id, p_value);
+    return model_write_behind_get(id, p_value, sizeof(*p_value));
 }
 
 
@@ -321,7 +322,7 @@ uint32_t light_hsl_mc_saturation_state_set(uint8_t index, uint16_t value)
     mesh_config_entry_id_t id = LIGHT_HSL_SATURATION_EID;
 
     id.record += index;
-    return mesh_config_entry_set(id, &value);
+    return model_write_behind_set(id, &value, sizeof(value));
 }
 
 
@@ -330,7 +331,7 @@ uint32_t light_hsl_mc_saturation_state_get(uint8_t index, uint16_t *p_value)
     mesh_config_entry_id_t id = LIGHT_HSL_SATURATION_EID;
 
     id.record += index;
-    return mesh_config_entry_get(id, p_value);
+    return model_write_behind_get(id, p_value, sizeof(*p_value));
 }
 
 
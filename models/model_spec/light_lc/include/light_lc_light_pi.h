@@ -56,12 +56,56 @@
 
 /** Updates Light LC PI Feedback Regulator state.
  *
- * The Light LC PI Feedback Regulator is supposed to run periodically at the interval
- * specified in @ref LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS.
+ * Runs one regulator step with the cached coefficients. The regulator tick calls this for every
+ * started instance, at the interval set with @ref light_lc_light_pi_interval_set().
  *
  * @param[in] p_s_server           Pointer to the model structure.
  */
 void light_lc_light_pi_update(light_lc_setup_server_t * p_s_server);
 
+/** Starts the Light LC PI Feedback Regulator for a server instance.
+ *
+ * Caches the regulator coefficients and adds the instance to the regulator tick, which is shared
+ * by all instances. The tick is started with the first instance.
+ *
+ * @param[in] p_s_server           Pointer to the model structure.
+ *
+ * @retval NRF_SUCCESS             The regulator runs for the instance.
+ * @retval NRF_ERROR_NULL          NULL pointer given to function.
+ */
+uint32_t light_lc_light_pi_start(light_lc_setup_server_t * p_s_server);
+
+/** Updates the cached regulator coefficients of a server instance.
+ *
+ * Must be called whenever the Regulator Kiu, Kid, Kpu, Kpd or Accuracy property changes.
+ * @ref light_lc_state_utils_property_set() does this.
+ *
+ * @param[in] p_s_server           Pointer to the model structure.
+ */
+void light_lc_light_pi_coefficients_update(light_lc_setup_server_t * p_s_server);
+
+/** Sets the summation interval of the regulator tick.
+ *
+ * The default interval is @ref LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS.
+ *
+ * @param[in] interval_ms          Summation interval in milliseconds, within
+ *                                 [@ref LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MIN_MS,
+ *                                 @ref LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MAX_MS].
+ *
+ * @retval NRF_SUCCESS             The interval is used from the next tick.
+ * @retval NRF_ERROR_INVALID_PARAM The interval is out of range.
+ */
+uint32_t light_lc_light_pi_interval_set(uint32_t interval_ms);
+
+#ifdef UNIT_TEST
+
+/**
+ * @internal
+ * Reset the regulator tick state. Unsafe outside of unit testing.
+ */
+void light_lc_light_pi_reset(void);
+
+#endif
+
 /**@} end of LIGHT_LC_LIGHT_PI */
 #endif /* LIGHT_LC_LIGHT_PI_H__ */
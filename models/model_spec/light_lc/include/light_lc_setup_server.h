@@ -307,6 +307,35 @@ typedef struct
     uint32_t target_luxlevel;
 } light_lc_transition_info_t;
 
+/** Light LC PI Feedback Regulator state of a server instance.
+ *
+ * Coefficients are cached from the regulator properties in Q16.16 fixed point, see
+ * @ref light_lc_light_pi_coefficients_update().
+ */
+typedef struct
+{
+    /** Integral term, Q16.16. */
+    uint32_t integral;
+    /** Kiu multiplied by the summation interval in seconds, Q16.16. */
+    uint32_t kiu_dt;
+    /** Kid multiplied by the summation interval in seconds, Q16.16. */
+    uint32_t kid_dt;
+    /** Kiu coefficient, Q16.16. */
+    uint32_t kiu;
+    /** Kid coefficient, Q16.16. */
+    uint32_t kid;
+    /** Kpu coefficient, Q16.16. */
+    uint32_t kpu;
+    /** Kpd coefficient, Q16.16. */
+    uint32_t kpd;
+    /** Regulator accuracy, Percentage 8. */
+    uint8_t accuracy;
+    /** Whether the instance is driven by the regulator tick. */
+    bool running;
+    /** Next instance driven by the regulator tick. */
+    struct __light_lc_setup_server_t * p_next;
+} light_lc_light_pi_t;
+
 /**  */
 struct __light_lc_setup_server_t
 {
@@ -331,8 +360,8 @@ struct __light_lc_setup_server_t
     /** @internal The timer instance pointer for the state machine */
     model_timer_t fsm_timer;
 
-    /** @internal The timer instance pointer for the light pi server */
-    model_timer_t light_pi_timer;
+    /** @internal The Light LC PI Feedback Regulator state */
+    light_lc_light_pi_t light_pi;
 
     /** @internal The timer instance pointer for the sensor occupancy delay */
     model_timer_t sensor_delay_timer;
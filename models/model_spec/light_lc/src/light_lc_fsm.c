@@ -920,14 +920,6 @@ static void timer_fired_cb(void * p_context)
     fsm_event_post(&p_s_server->fsm, E_TIMER_OFF, p_s_server);
 }
 
-/* The light PI regulator is supposed to run periodically (@tagMeshMdlSp section 6.2.6). */
-static void light_pi_cb(void * p_context)
-{
-    light_lc_setup_server_t * p_s_server = (light_lc_setup_server_t *) p_context;
-
-    light_lc_light_pi_update(p_s_server);
-}
-
 static void lightonoff_event_generate(light_lc_setup_server_t * p_s_server, bool light_onoff)
 {
 #if LIGHT_LC_FSM_DEBUG
@@ -1078,24 +1070,11 @@ uint32_t light_lc_fsm_init(light_lc_setup_server_t * p_s_server, bool initial_fs
         return status;
     }
 
-    /* Create and start timer used by the light pi */
-    p_s_server->light_pi_timer.p_context = p_s_server;
-    p_s_server->light_pi_timer.cb = light_pi_cb;
-    status = model_timer_create(&p_s_server->light_pi_timer);
-    if (status != NRF_SUCCESS)
-    {
-        __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR, "model_timer_create light_pi_timer %d\n", status);
-        return status;
-    }
-
-    p_s_server->light_pi_timer.timeout_rtc_ticks =
-        MODEL_TIMER_TICKS_GET_US(MS_TO_US(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS));
-
-    p_s_server->light_pi_timer.mode = MODEL_TIMER_MODE_REPEATED;
-    status = model_timer_schedule(&p_s_server->light_pi_timer);
+    /* The light PI regulator is supposed to run periodically (@tagMeshMdlSp section 6.2.6). */
+    status = light_lc_light_pi_start(p_s_server);
     if (status != NRF_SUCCESS)
     {
-        __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR, "model_timer_schedule %d\n", status);
+        __LOG(LOG_SRC_APP, LOG_LEVEL_ERROR, "light_lc_light_pi_start %d\n", status);
         return status;
     }
 
@@ -37,7 +37,11 @@
 
 #include "light_lc_light_pi.h"
 
+#include <string.h>
+
 #include "log.h"
+#include "timer.h"
+#include "timer_scheduler.h"
 #include "light_lightness_utils.h"
 #include "light_lc_state_utils.h"
 #include "light_lc_server_property_constants.h"
@@ -67,32 +71,73 @@
  */
 #define LIGHT_PI_INTEGRAL_MAX              (65535)
 
-/** Fixed point multiplier for coefficients */
-#define LIGHT_PI_COEFFICIENT_MULT (100)
+/** Number of fractional bits of the fixed point coefficients and integral term. */
+#define LIGHT_PI_Q_BITS (16)
+
+/** Largest coefficient value. The properties are floats, @tagMeshMdlSp gives them a range of 0-1000. */
+#define LIGHT_PI_COEFFICIENT_MAX (65535.0f)
 
 /** Divisor for converting raw Illuminance characteristic values to Lux. */
 #define LIGHT_PI_ILLUMINANCE_TO_LUX_DIV (100)
 
-/** @tagMeshMdlSp requires I be 0-65535 (Table 6.53). */
-#define ANTI_RESET_WINDUP(i) MAX(MIN(LIGHT_PI_INTEGRAL_MAX, i), LIGHT_PI_INTEGRAL_MIN)
-
 NRF_MESH_STATIC_ASSERT(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS >= LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MIN_MS);
 NRF_MESH_STATIC_ASSERT(LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS <= LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MAX_MS);
 
-/* Return a fixed point value (if float value was 250.5, return integer of 25050) */
+/** Instances driven by the regulator tick. */
+static light_lc_setup_server_t * mp_servers;
+/** Regulator tick, shared by all instances. */
+static timer_event_t m_tick_timer;
+/** Summation interval of the regulator tick. */
+static uint32_t m_interval_ms = LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS;
+
+/* Return a coefficient property as a Q16.16 fixed point value. */
 static uint32_t coefficient_get(light_lc_setup_server_t * p_s_server, uint16_t property_id)
 {
-    uint32_t coefficient_word;
-    uint32_t coefficient_int;
-    float * p_coefficient_float;
+    uint32_t coefficient_word = light_lc_state_utils_property_get(p_s_server, property_id);
     float coefficient_float;
 
-    coefficient_word =  light_lc_state_utils_property_get(p_s_server, property_id);
-    p_coefficient_float = (float *) &coefficient_word;
-    coefficient_float = *p_coefficient_float;
-    coefficient_float *= LIGHT_PI_COEFFICIENT_MULT;
-    coefficient_int = (uint32_t) coefficient_float;
-    return coefficient_int;
+    memcpy(&coefficient_float, &coefficient_word, sizeof(coefficient_float));
+
+    /* Negative and NaN values disable the term. */
+    if (!(coefficient_float > 0.0f))
+    {
+        return 0;
+    }
+
+    coefficient_float = MIN(coefficient_float, LIGHT_PI_COEFFICIENT_MAX);
+    return (uint32_t) (coefficient_float * (1ul << LIGHT_PI_Q_BITS));
+}
+
+/* Scale an integral coefficient by the summation interval. */
+static uint32_t coefficient_dt_get(uint32_t coefficient)
+{
+    return (uint32_t) (((uint64_t) coefficient * m_interval_ms) / 1000);
+}
+
+/* Q16.16 to integer, rounding towards zero like the division in the integer regulator. */
+static int32_t q_to_int(int64_t value)
+{
+    if (value < 0)
+    {
+        return (int32_t) -((-value) >> LIGHT_PI_Q_BITS);
+    }
+    return (int32_t) (value >> LIGHT_PI_Q_BITS);
+}
+
+static void tick_cb(timestamp_t timestamp, void * p_context)
+{
+    for (light_lc_setup_server_t * p_s_server = mp_servers; p_s_server != NULL; p_s_server = p_s_server->light_pi.p_next)
+    {
+        light_lc_light_pi_update(p_s_server);
+    }
+}
+
+static void tick_schedule(void)
+{
+    m_tick_timer.cb = tick_cb;
+    m_tick_timer.p_context = NULL;
+    m_tick_timer.interval = MS_TO_US(m_interval_ms);
+    timer_sch_reschedule(&m_tick_timer, timer_now() + MS_TO_US(m_interval_ms));
 }
 
 /* Pass in the current linear lightness, and the one generated by light PI, and this function will
@@ -149,22 +194,14 @@ static void linear_binding_output_set(light_lc_setup_server_t * p_s_server,
 
 void light_lc_light_pi_update(light_lc_setup_server_t * p_s_server)
 {
-    static int32_t i_internal_sum = 0;
-
-    /* Valid values are 0.0-100.0, all other values invalid - Percentage 8 */
-    uint8_t regulator_accuracy;
     uint32_t luxlevel_out;
     uint32_t ambient_luxlevel_illum;
     uint16_t actual_lightness;
     int32_t e_adjustment_error;
     uint32_t d_accuracy;
     int32_t u_regulator_input;
-    int32_t l_regulator_output;
-    uint32_t t_summation_interval;
-    uint32_t k_iu;
-    uint32_t k_id;
-    uint32_t k_pu;
-    uint32_t k_pd;
+    int64_t integral;
+    int64_t regulator_output;
     uint16_t current_lightness_linear;
     uint16_t computed_lightness_linear;
     int32_t computed_lightness_linear_diff;
@@ -174,6 +211,8 @@ void light_lc_light_pi_update(light_lc_setup_server_t * p_s_server)
         return;
     }
 
+    light_lc_light_pi_t * p_pi = &p_s_server->light_pi;
+
     /* Get the current lightness (this is what has contributed into our lightness value we received
      * from the sensor) */
     p_s_server->settings.p_callbacks->light_lc_cbs.light_lc_actual_get_cb(p_s_server, &actual_lightness);
@@ -206,11 +245,9 @@ void light_lc_light_pi_update(light_lc_setup_server_t * p_s_server)
 
     e_adjustment_error = (int64_t)ROUNDED_DIV((int64_t)luxlevel_out - (int64_t)ambient_luxlevel_illum, LIGHT_PI_ILLUMINANCE_TO_LUX_DIV);
 
-    regulator_accuracy = light_lc_state_utils_property_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_ACCURACY_PID);
-
     /* Divide by 2 since regulator_accuracy is is percentage 8, then /2 since width is 2D wide (-D
      * <=> +D) Then / 100 to use as a percentage */
-    d_accuracy = (regulator_accuracy *  (ROUNDED_DIV(luxlevel_out, LIGHT_PI_ILLUMINANCE_TO_LUX_DIV)) / 2) / 2 / 100;
+    d_accuracy = (p_pi->accuracy *  (ROUNDED_DIV(luxlevel_out, LIGHT_PI_ILLUMINANCE_TO_LUX_DIV)) / 2) / 2 / 100;
 
     if (e_adjustment_error > (int32_t) d_accuracy)
     {
@@ -226,51 +263,33 @@ void light_lc_light_pi_update(light_lc_setup_server_t * p_s_server)
     }
 #if LIGHT_PI_DEBUG
     __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "Accuracy=%d, D=%d, Luxlevel SP=%d, measured=%d, E=%d, U=%d\n",
-          regulator_accuracy, d_accuracy, ROUNDED_DIV(luxlevel_out, LIGHT_PI_ILLUMINANCE_TO_LUX_DIV),
+          p_pi->accuracy, d_accuracy, ROUNDED_DIV(luxlevel_out, LIGHT_PI_ILLUMINANCE_TO_LUX_DIV),
           ROUNDED_DIV(ambient_luxlevel_illum, LIGHT_PI_ILLUMINANCE_TO_LUX_DIV), e_adjustment_error, u_regulator_input);
 #endif
 
-    t_summation_interval = LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS;
-    /* Convert the Coefficient properties (floats) to fixed point integers (1/100s) */
-    k_iu = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KIU_PID);
-    k_id = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KID_PID);
-    k_pu = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KPU_PID);
-    k_pd = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KPD_PID);
-
+    /* The coefficients are Q16.16, and the integral ones are already scaled by the summation interval. */
     if (u_regulator_input >= 0)
     {
-        /* Divide by 1000 to convert msec to sec, divide by conversion factor used for coefficient fixed point conversion */
-        i_internal_sum +=
-            ((int64_t) u_regulator_input * (int64_t) t_summation_interval * (int64_t) k_iu / 1000) / LIGHT_PI_COEFFICIENT_MULT;
-        l_regulator_output =
-            i_internal_sum + ((int64_t) u_regulator_input * (int64_t) k_pu) / LIGHT_PI_COEFFICIENT_MULT;
-#if LIGHT_PI_DEBUG
-        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "U >= 0: I=%d, L=%d Kiu(*%d)=%d Kpu(*%d)=%d\n",
-              i_internal_sum, l_regulator_output, LIGHT_PI_COEFFICIENT_MULT, k_iu,
-              LIGHT_PI_COEFFICIENT_MULT, k_pu);
-#endif
+        integral = (int64_t) p_pi->integral + (int64_t) u_regulator_input * p_pi->kiu_dt;
+        regulator_output = integral + (int64_t) u_regulator_input * p_pi->kpu;
     }
     else
     {
-        /* Divide by 1000 to convert msec to sec, divide by LIGHT_PI_COEFFICIENT_MULT for coefficient fixed point */
-        i_internal_sum +=
-            ((int64_t) u_regulator_input * (int64_t) t_summation_interval * (int64_t) k_id / 1000) / LIGHT_PI_COEFFICIENT_MULT;
-        l_regulator_output = i_internal_sum + ((int64_t) u_regulator_input * (int64_t) k_pd) / LIGHT_PI_COEFFICIENT_MULT;
-#if LIGHT_PI_DEBUG
-        __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "U < 0: I=%d, L=%d Kid(*%d)=%d Kpd(*%d)=%d\n",
-              i_internal_sum, l_regulator_output, LIGHT_PI_COEFFICIENT_MULT, k_id,
-              LIGHT_PI_COEFFICIENT_MULT, k_pd);
-#endif
+        integral = (int64_t) p_pi->integral + (int64_t) u_regulator_input * p_pi->kid_dt;
+        regulator_output = integral + (int64_t) u_regulator_input * p_pi->kpd;
     }
 
-    i_internal_sum = ANTI_RESET_WINDUP(i_internal_sum);
+    /* @tagMeshMdlSp requires I be 0-65535 (Table 6.53). */
+    p_pi->integral = (uint32_t) MAX(MIN(integral, (int64_t) LIGHT_PI_INTEGRAL_MAX << LIGHT_PI_Q_BITS),
+                                    (int64_t) LIGHT_PI_INTEGRAL_MIN << LIGHT_PI_Q_BITS);
 #if LIGHT_PI_DEBUG
-    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "after anti reset windup, I=%d\n", curr_i_internal_sum);
+    __LOG(LOG_SRC_APP, LOG_LEVEL_INFO, "U=%d: I=%d, L=%d\n", u_regulator_input,
+          q_to_int(p_pi->integral), q_to_int(regulator_output));
 #endif
 
     /* Conversion function from Lux to linear lightness depends on the Ambient light sensor distance
      * and angle from the light - use customer-tuned divisor */
-    computed_lightness_linear_diff = l_regulator_output / LIGHT_LC_LIGHT_PI_CONVERSION_DIVISOR;
+    computed_lightness_linear_diff = q_to_int(regulator_output) / LIGHT_LC_LIGHT_PI_CONVERSION_DIVISOR;
 
     computed_lightness_linear = current_lightness_linear + computed_lightness_linear_diff;
 
@@ -292,3 +311,75 @@ void light_lc_light_pi_update(light_lc_setup_server_t * p_s_server)
     }
     linear_binding_output_set(p_s_server, current_lightness_linear, computed_lightness_linear);
 }
+
+uint32_t light_lc_light_pi_start(light_lc_setup_server_t * p_s_server)
+{
+    if (p_s_server == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    light_lc_light_pi_coefficients_update(p_s_server);
+
+    if (!p_s_server->light_pi.running)
+    {
+        p_s_server->light_pi.integral = 0;
+        p_s_server->light_pi.running = true;
+        p_s_server->light_pi.p_next = mp_servers;
+        mp_servers = p_s_server;
+
+        if (p_s_server->light_pi.p_next == NULL)
+        {
+            tick_schedule();
+        }
+    }
+    return NRF_SUCCESS;
+}
+
+void light_lc_light_pi_coefficients_update(light_lc_setup_server_t * p_s_server)
+{
+    NRF_MESH_ASSERT(p_s_server);
+
+    light_lc_light_pi_t * p_pi = &p_s_server->light_pi;
+
+    p_pi->kiu = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KIU_PID);
+    p_pi->kid = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KID_PID);
+    p_pi->kpu = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KPU_PID);
+    p_pi->kpd = coefficient_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_KPD_PID);
+    p_pi->kiu_dt = coefficient_dt_get(p_pi->kiu);
+    p_pi->kid_dt = coefficient_dt_get(p_pi->kid);
+    /* Valid values are 0.0-100.0, all other values invalid - Percentage 8 */
+    p_pi->accuracy = light_lc_state_utils_property_get(p_s_server, LIGHT_LC_SERVER_REGULATOR_ACCURACY_PID);
+}
+
+uint32_t light_lc_light_pi_interval_set(uint32_t interval_ms)
+{
+    if (interval_ms < LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MIN_MS ||
+        interval_ms > LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MAX_MS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_interval_ms = interval_ms;
+
+    for (light_lc_setup_server_t * p_s_server = mp_servers; p_s_server != NULL; p_s_server = p_s_server->light_pi.p_next)
+    {
+        p_s_server->light_pi.kiu_dt = coefficient_dt_get(p_s_server->light_pi.kiu);
+        p_s_server->light_pi.kid_dt = coefficient_dt_get(p_s_server->light_pi.kid);
+    }
+
+    if (mp_servers != NULL)
+    {
+        tick_schedule();
+    }
+    return NRF_SUCCESS;
+}
+
+#ifdef UNIT_TEST
+void light_lc_light_pi_reset(void)
+{
+    mp_servers = NULL;
+    m_interval_ms = LIGHT_LC_LIGHT_PI_SUMMATION_INTERVAL_MS;
+    memset(&m_tick_timer, 0, sizeof(m_tick_timer));
+}
+#endif
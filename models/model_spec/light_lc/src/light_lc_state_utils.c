@@ -40,6 +40,7 @@
 #include "mesh_opt.h"
 
 #include "light_lc_server_property_constants.h"
+#include "light_lc_light_pi.h"
 #include "light_lc_mc.h"
 #include "mesh_config_entry.h"
 
@@ -441,6 +442,21 @@ void light_lc_state_utils_property_set(light_lc_setup_server_t * p_s_server,
     NRF_MESH_ERROR_CHECK(light_lc_state_utils_lc_state_from_property_id(property_id, &lc_state));
 
     p_s_server->settings.p_callbacks->light_lc_cbs.light_lc_persist_set_cb(p_s_server, lc_state, &set_value);
+
+    switch (property_id)
+    {
+        /* The regulator caches these in fixed point, refresh them. */
+        case LIGHT_LC_SERVER_REGULATOR_KIU_PID:
+        case LIGHT_LC_SERVER_REGULATOR_KID_PID:
+        case LIGHT_LC_SERVER_REGULATOR_KPU_PID:
+        case LIGHT_LC_SERVER_REGULATOR_KPD_PID:
+        case LIGHT_LC_SERVER_REGULATOR_ACCURACY_PID:
+            light_lc_light_pi_coefficients_update(p_s_server);
+            break;
+
+        default:
+            break;
+    }
 }
 
 void light_lc_state_utils_ambient_luxlevel_set(light_lc_setup_server_t * p_s_server, uint32_t set_value)
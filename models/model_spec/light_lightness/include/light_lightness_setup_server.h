@@ -233,6 +233,13 @@ typedef struct
     /** TransMIC size used by the outgoing server messages.
      * See @ref nrf_mesh_transmic_size_t and @ref mesh_model_large_mic. */
     nrf_mesh_transmic_size_t transmic_size;
+    /** Window for coalescing unacknowledged Generic Level Delta Set and Move Set messages, in
+     * milliseconds, or zero to not coalesce.
+     * See @ref generic_level_server_settings_t::coalesce_interval_ms. */
+    uint32_t coalesce_interval_ms;
+    /** Minimum interval between unsolicited Status publications of the Light Lightness state and
+     * its bound states, in milliseconds, or zero to not limit. */
+    uint32_t publish_interval_min_ms;
 
     /* There are no callbacks for the state for this model, these
      * callbacks are defined for the setup server. */
@@ -253,6 +260,11 @@ struct __light_lightness_server_t
 
     /** Settings and callbacks for this instance. */
     light_lightness_server_settings_t settings;
+
+    /** Rate limiter for unsolicited Status publications. */
+    model_publish_limiter_t publish_limiter;
+    /** Last Status parameters given for publication. */
+    light_lightness_status_params_t publish_params;
 };
 
 /**
@@ -261,10 +273,14 @@ struct __light_lightness_server_t
  * This API can be used to send unsolicited messages to report updated
  * state value as a result of local action.
  *
+ * If the previous publication is more recent than
+ * @ref light_lightness_server_settings_t::publish_interval_min_ms, the message is held back and the
+ * parameters of the last call are published when the interval has passed.
+ *
  * @param[in]     p_server          Status server context pointer.
  * @param[in]     p_params          Message parameters.
  *
- * @retval NRF_SUCCESS              If the message is published successfully.
+ * @retval NRF_SUCCESS              If the message is published successfully, or held back.
  * @retval NRF_ERROR_NULL           NULL pointer given to function.
  * @retval NRF_ERROR_NO_MEM         No memory available to send the message at this point.
  * @retval NRF_ERROR_NOT_FOUND      The model is not initialized.
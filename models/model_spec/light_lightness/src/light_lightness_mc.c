@@ -42,6 +42,7 @@
 #include "mesh_config_entry.h"
 #include "mesh_config.h"
 #include "mesh_opt.h"
+#include "model_write_behind.h"
 
 #include "nrf_mesh_assert.h"
 
@@ -592,7 +593,7 @@ uint32_t light_lightness_mc_actual_state_set(uint8_t index, uint16_t value)
     mesh_config_entry_id_t id = LIGHT_LIGHTNESS_ACTUAL_EID;
 
     id.record += index;
-    return mesh_config_entry_set(id, &value);
+    return model_write_behind_set(id, &value, sizeof(value));
 }
 
 uint32_t light_lightness_mc_actual_state_get(uint8_t index, uint16_t * p_value)
@@ -600,7 +601,7 @@ uint32_t light_lightness_mc_actual_state_get(uint8_t index, uint16_t * p_value)
     mesh_config_entry_id_t id = LIGHT_LIGHTNESS_ACTUAL_EID;
 
     id.record += index;
-    return mesh_config_entry_get(id, p_value);
+    return model_write_behind_get(id, p_value, sizeof(*p_value));
 }
 
 uint32_t light_lightness_mc_dtt_state_set(uint8_t index, uint32_t value)
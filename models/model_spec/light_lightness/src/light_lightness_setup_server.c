@@ -75,19 +75,10 @@ static uint32_t status_actual_send(const light_lightness_server_t * p_server,
                                    const access_message_rx_t * p_message,
                                    const light_lightness_status_params_t * p_params)
 {
-    light_lightness_status_msg_pkt_t msg_pkt;
-
-    msg_pkt.present_lightness = p_params->present_lightness;
-    if (p_params->remaining_time_ms > 0)
-    {
-        msg_pkt.target_lightness = p_params->target_lightness;
-        msg_pkt.remaining_time = model_transition_time_encode(p_params->remaining_time_ms);
-    }
-
     access_message_tx_t reply =
     {
         .opcode = ACCESS_OPCODE_SIG(LIGHT_LIGHTNESS_OPCODE_STATUS),
-        .p_buffer = (const uint8_t *) &msg_pkt,
+        .p_buffer = NULL,
         .length = (p_params->remaining_time_ms > 0 ?
                    LIGHT_LIGHTNESS_STATUS_MAXLEN :
                    LIGHT_LIGHTNESS_STATUS_MINLEN),
@@ -95,14 +86,22 @@ static uint32_t status_actual_send(const light_lightness_server_t * p_server,
         .transmic_size = p_server->settings.transmic_size
     };
 
-    if (p_message == NULL)
+    uint8_t * p_buffer;
+    uint32_t status = model_tx_reserve(p_server->model_handle, p_message, &reply, &p_buffer);
+    if (status != NRF_SUCCESS)
     {
-        return access_model_publish(p_server->model_handle, &reply);
+        return status;
     }
-    else
+
+    light_lightness_status_msg_pkt_t * p_msg_pkt = (light_lightness_status_msg_pkt_t *) p_buffer;
+    p_msg_pkt->present_lightness = p_params->present_lightness;
+    if (p_params->remaining_time_ms > 0)
     {
-        return access_model_reply(p_server->model_handle, p_message, &reply);
+        p_msg_pkt->target_lightness = p_params->target_lightness;
+        p_msg_pkt->remaining_time = model_transition_time_encode(p_params->remaining_time_ms);
     }
+
+    return access_model_tx_commit(p_server->model_handle);
 }
 
 
@@ -939,6 +938,17 @@ static void publish_bound_linear_states(const light_lightness_server_t * p_serve
     publish_bound_states((light_lightness_server_t *) p_server, &pub_params);
 }
 
+static void publish_limiter_cb(timestamp_t timestamp, void * p_context)
+{
+    light_lightness_server_t * p_server = (light_lightness_server_t *) p_context;
+
+    if (model_publish_limiter_check(&p_server->publish_limiter, p_server->settings.publish_interval_min_ms))
+    {
+        publish_bound_actual_states(p_server, &p_server->publish_params);
+        (void) status_actual_send(p_server, NULL, &p_server->publish_params);
+    }
+}
+
 static uint32_t light_lightness_server_init(light_lightness_server_t * p_server,
                                             uint8_t element_index)
 {
@@ -949,8 +959,13 @@ static uint32_t light_lightness_server_init(light_lightness_server_t * p_server,
         return NRF_ERROR_NULL;
     }
 
+    p_server->publish_limiter.cb = publish_limiter_cb;
+    p_server->publish_limiter.p_context = p_server;
+
     /* Initialize parent model instances - Generic Level */
     p_server->generic_level_srv.settings.p_callbacks = &m_level_srv_cbs;
+    p_server->generic_level_srv.settings.coalesce_interval_ms = p_server->settings.coalesce_interval_ms;
+    p_server->generic_level_srv.settings.publish_interval_min_ms = p_server->settings.publish_interval_min_ms;
 
     status = generic_level_server_init(&p_server->generic_level_srv, element_index);
 
@@ -988,6 +1003,14 @@ uint32_t light_lightness_server_status_publish(const light_lightness_server_t *
         return NRF_ERROR_NULL;
     }
 
+    /* A held back publication sends the latest parameters when it is due. */
+    light_lightness_server_t * p_ll_server = (light_lightness_server_t *) p_server;
+    p_ll_server->publish_params = *p_params;
+    if (!model_publish_limiter_check(&p_ll_server->publish_limiter, p_server->settings.publish_interval_min_ms))
+    {
+        return NRF_SUCCESS;
+    }
+
     publish_bound_actual_states(p_server, p_params);
 
     return status_actual_send(p_server, NULL, p_params);
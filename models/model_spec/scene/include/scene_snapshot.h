@@ -0,0 +1,236 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SCENE_SNAPSHOT_H__
+#define SCENE_SNAPSHOT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "scene_common.h"
+#include "mesh_config.h"
+#include "mesh_opt.h"
+#include "model_config_file.h"
+
+/**
+ * @defgroup SCENE_SNAPSHOT Scene snapshots
+ * @ingroup SCENE_MODELS
+ *
+ * Stores the states of all models registered with a Scene Setup Server instance as one record per
+ * scene, and recalls them in one pass.
+ *
+ * Each model describes its scene state as a fixed size byte string. The snapshot of a scene is the
+ * concatenation of the strings of all registered models. The first scene stored in an empty Scene
+ * Register becomes the reference snapshot of the register, and every scene is stored as the runs
+ * of bytes in which it differs from the reference. Scenes of a room or a building usually differ in
+ * a few states only, so the records stay small, and one config entry holds a scene of all models.
+ *
+ * On recall, the record is decoded against the reference, and the state of every model is applied
+ * back to back with the same delay and transition time, so the model transitions start together.
+ *
+ * @{
+ */
+
+/** Largest snapshot size, the sum of the state sizes of all models registered with an instance. */
+#ifndef SCENE_SNAPSHOT_STATE_SIZE_MAX
+#define SCENE_SNAPSHOT_STATE_SIZE_MAX (48)
+#endif
+
+/** Size of a delta encoded scene record. Scenes differing more from the reference snapshot
+ * can't be stored. */
+#ifndef SCENE_SNAPSHOT_RECORD_SIZE
+#define SCENE_SNAPSHOT_RECORD_SIZE (24)
+#endif
+
+/** Number of models that can be registered with an instance. */
+#ifndef SCENE_SNAPSHOT_MODELS_MAX
+#define SCENE_SNAPSHOT_MODELS_MAX (8)
+#endif
+
+/** Reference snapshot entry IDs start, after the Scene Number entries. */
+#define SCENE_SNAPSHOT_REFERENCE_EID_START  (MESH_APP_MODEL_SCENE_SERVER_ID_START + 0x80)
+/** Scene record entry IDs start. */
+#define SCENE_SNAPSHOT_RECORD_EID_START     (SCENE_SNAPSHOT_REFERENCE_EID_START + 0x10)
+
+/** Reference snapshot entry ID */
+#define SCENE_SNAPSHOT_REFERENCE_EID MESH_CONFIG_ENTRY_ID(MESH_OPT_MODEL_FILE_ID, SCENE_SNAPSHOT_REFERENCE_EID_START)
+/** Scene record entry ID */
+#define SCENE_SNAPSHOT_RECORD_EID    MESH_CONFIG_ENTRY_ID(MESH_OPT_MODEL_FILE_ID, SCENE_SNAPSHOT_RECORD_EID_START)
+
+/* Forward declaration */
+typedef struct __scene_snapshot_model_t scene_snapshot_model_t;
+
+/** Callback for reading the present scene state of a model.
+ *
+ * @param[in]  p_model          Model registered with the snapshot.
+ * @param[out] p_state          Buffer of @ref scene_snapshot_model_t::state_size bytes to write the
+ *                              state to.
+ */
+typedef void (*scene_snapshot_state_get_cb_t)(const scene_snapshot_model_t * p_model, uint8_t * p_state);
+
+/** Callback for applying a recalled scene state to a model.
+ *
+ * The model starts its transition to the state right away, all models of the snapshot get the
+ * same delay and transition time.
+ *
+ * @param[in] p_model            Model registered with the snapshot.
+ * @param[in] p_state            State of @ref scene_snapshot_model_t::state_size bytes.
+ * @param[in] delay_ms           Delay in milliseconds.
+ * @param[in] transition_time_ms Transition time in milliseconds.
+ */
+typedef void (*scene_snapshot_state_apply_cb_t)(const scene_snapshot_model_t * p_model,
+                                                const uint8_t * p_state,
+                                                uint32_t delay_ms,
+                                                uint32_t transition_time_ms);
+
+/** Model callbacks. */
+typedef struct
+{
+    scene_snapshot_state_get_cb_t state_get_cb;
+    scene_snapshot_state_apply_cb_t state_apply_cb;
+} scene_snapshot_model_callbacks_t;
+
+/** Scene state of a model, stored with the snapshots. */
+struct __scene_snapshot_model_t
+{
+    /** Model callbacks. */
+    const scene_snapshot_model_callbacks_t * p_callbacks;
+    /** Size of the scene state of the model. */
+    uint8_t state_size;
+
+    /** Internal variable. Offset of the state in the snapshot. */
+    uint8_t offset;
+};
+
+/** Snapshot context of a Scene Setup Server instance. */
+typedef struct
+{
+    /** Internal variable. Registered models. */
+    scene_snapshot_model_t * p_models[SCENE_SNAPSHOT_MODELS_MAX];
+    /** Internal variable. Number of registered models. */
+    uint8_t model_count;
+    /** Internal variable. Snapshot size. */
+    uint8_t state_size;
+    /** Internal variable. Scene Setup Server persistent state handle. */
+    uint8_t handle;
+} scene_snapshot_t;
+
+/** Initializes the snapshot context of a Scene Setup Server instance.
+ *
+ * @param[in,out] p_snapshot    Snapshot context.
+ * @param[in]     handle        Scene Setup Server persistent state handle, see @ref scene_mc_open().
+ *
+ * @retval NRF_SUCCESS              The context was initialized.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  The handle is out of range.
+ */
+uint32_t scene_snapshot_init(scene_snapshot_t * p_snapshot, uint8_t handle);
+
+/** Registers a model with the snapshots.
+ *
+ * Models must be registered in the same order on every boot, as the stored snapshots are laid out
+ * in registration order.
+ *
+ * @param[in,out] p_snapshot    Snapshot context.
+ * @param[in,out] p_model       Model to register.
+ *
+ * @retval NRF_SUCCESS              The model was registered.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  The model has no state.
+ * @retval NRF_ERROR_NO_MEM         @ref SCENE_SNAPSHOT_MODELS_MAX models are registered, or the
+ *                                  snapshot would exceed @ref SCENE_SNAPSHOT_STATE_SIZE_MAX.
+ */
+uint32_t scene_snapshot_model_add(scene_snapshot_t * p_snapshot, scene_snapshot_model_t * p_model);
+
+/** Stores the present states of all registered models as a scene.
+ *
+ * Does nothing if no models are registered.
+ *
+ * @param[in] p_snapshot        Snapshot context.
+ * @param[in] scene_index       Scene index given by @ref scene_mc_store().
+ *
+ * @retval NRF_SUCCESS              The scene was stored.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  The scene index doesn't belong to the instance.
+ * @retval NRF_ERROR_NO_MEM         The scene differs too much from the reference snapshot to fit
+ *                                  in @ref SCENE_SNAPSHOT_RECORD_SIZE.
+ */
+uint32_t scene_snapshot_store(scene_snapshot_t * p_snapshot, uint8_t scene_index);
+
+/** Recalls a scene, applying the stored state to all registered models in one pass.
+ *
+ * Does nothing if no models are registered.
+ *
+ * @param[in] p_snapshot         Snapshot context.
+ * @param[in] scene_index        Scene index given by @ref scene_mc_recall().
+ * @param[in] delay_ms           Delay in milliseconds.
+ * @param[in] transition_time_ms Transition time in milliseconds.
+ *
+ * @retval NRF_SUCCESS              The scene was recalled.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  The scene index doesn't belong to the instance.
+ * @retval NRF_ERROR_NOT_FOUND      No snapshot is stored for the scene.
+ */
+uint32_t scene_snapshot_recall(scene_snapshot_t * p_snapshot,
+                               uint8_t scene_index,
+                               uint32_t delay_ms,
+                               uint32_t transition_time_ms);
+
+/** Deletes the snapshot of a scene.
+ *
+ * @param[in] p_snapshot        Snapshot context.
+ * @param[in] scene_index       Scene index given by @ref scene_mc_delete().
+ *
+ * @retval NRF_SUCCESS              The snapshot was deleted, or there was none.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  The scene index doesn't belong to the instance.
+ */
+uint32_t scene_snapshot_delete(scene_snapshot_t * p_snapshot, uint8_t scene_index);
+
+/**
+ * Clear all stored snapshots.
+ */
+void scene_snapshot_clear(void);
+
+/**
+ * Initialize the snapshot persistent memory.
+ */
+void scene_snapshot_storage_init(void);
+
+/** @} end of SCENE_SNAPSHOT */
+
+#endif /* SCENE_SNAPSHOT_H__ */
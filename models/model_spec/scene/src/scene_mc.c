@@ -36,6 +36,7 @@
  */
 
 #include "scene_mc.h"
+#include "scene_snapshot.h"
 
 #include "nrf_mesh_config_app.h"
 
@@ -151,6 +152,8 @@ static void scene_flash_storage_config_clear(void)
         }
     }
     m_next_handle = 0;
+
+    scene_snapshot_clear();
 }
 
 /* Setter and getter definitions.
@@ -297,5 +300,6 @@ void scene_mc_clear(void)
 void scene_mc_init(void)
 {
     state_contexts_all_default_set();
+    scene_snapshot_storage_init();
 }
 #endif /* SCENE_SETUP_SERVER_INSTANCES_MAX > 0*/
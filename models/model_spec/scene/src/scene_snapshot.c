@@ -0,0 +1,501 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "scene_snapshot.h"
+
+#include "nrf_mesh_config_app.h"
+
+#if SCENE_SETUP_SERVER_INSTANCES_MAX > 0
+#include <string.h>
+
+#include "mesh_config_entry.h"
+#include "nrf_mesh_assert.h"
+#include "nrf_error.h"
+#include "utils.h"
+
+/** Size of the header of a run of differing bytes: offset and length. */
+#define RUN_HEADER_SIZE     (2)
+/** Longest stretch of equal bytes merged into a run, as a new run header would cost as much. */
+#define RUN_GAP_MAX         (RUN_HEADER_SIZE)
+
+/** Number of scene records. */
+#define RECORD_COUNT        (SCENE_SETUP_SERVER_INSTANCES_MAX * SCENE_REGISTER_ARRAY_SIZE)
+
+typedef struct
+{
+    /** Snapshot size, 0 if there is no reference. */
+    uint8_t state_size;
+    uint8_t state[SCENE_SNAPSHOT_STATE_SIZE_MAX];
+} reference_t;
+
+typedef struct
+{
+    /** Snapshot size of the reference the record was encoded against, 0 if there is no record. */
+    uint8_t state_size;
+    /** Length of the encoded runs. */
+    uint8_t length;
+    /** Runs of bytes differing from the reference: offset, length and the bytes. */
+    uint8_t runs[SCENE_SNAPSHOT_RECORD_SIZE - 2];
+} record_t;
+
+NRF_MESH_STATIC_ASSERT(SCENE_SNAPSHOT_STATE_SIZE_MAX <= UINT8_MAX);
+NRF_MESH_STATIC_ASSERT(SCENE_SNAPSHOT_RECORD_SIZE > 2 + RUN_HEADER_SIZE);
+NRF_MESH_STATIC_ASSERT(SCENE_SETUP_SERVER_INSTANCES_MAX <= (SCENE_SNAPSHOT_RECORD_EID_START - SCENE_SNAPSHOT_REFERENCE_EID_START));
+NRF_MESH_STATIC_ASSERT((SCENE_SNAPSHOT_RECORD_EID_START + RECORD_COUNT - 1) <= MESH_APP_MODEL_SCENE_SERVER_ID_END);
+NRF_MESH_STATIC_ASSERT((MESH_APP_MODEL_SCENE_SERVER_ID_START + RECORD_COUNT) <= SCENE_SNAPSHOT_REFERENCE_EID_START);
+
+static uint32_t reference_setter(mesh_config_entry_id_t id, const void * p_entry);
+static void     reference_getter(mesh_config_entry_id_t id, void * p_entry);
+static void     reference_deleter(mesh_config_entry_id_t id);
+static uint32_t record_setter(mesh_config_entry_id_t id, const void * p_entry);
+static void     record_getter(mesh_config_entry_id_t id, void * p_entry);
+static void     record_deleter(mesh_config_entry_id_t id);
+
+MESH_CONFIG_ENTRY(m_scene_snapshot_reference_entry,
+                  SCENE_SNAPSHOT_REFERENCE_EID,
+                  SCENE_SETUP_SERVER_INSTANCES_MAX,
+                  sizeof(reference_t),
+                  reference_setter,
+                  reference_getter,
+                  reference_deleter,
+                  false);
+
+MESH_CONFIG_ENTRY(m_scene_snapshot_record_entry,
+                  SCENE_SNAPSHOT_RECORD_EID,
+                  RECORD_COUNT,
+                  sizeof(record_t),
+                  record_setter,
+                  record_getter,
+                  record_deleter,
+                  false);
+
+static reference_t m_references[SCENE_SETUP_SERVER_INSTANCES_MAX];
+static record_t m_records[RECORD_COUNT];
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+static bool runs_are_valid(const record_t * p_record)
+{
+    uint32_t i = 0;
+
+    if (p_record->length > sizeof(p_record->runs))
+    {
+        return false;
+    }
+
+    while (i < p_record->length)
+    {
+        if (i + RUN_HEADER_SIZE > p_record->length)
+        {
+            return false;
+        }
+
+        uint8_t offset = p_record->runs[i];
+        uint8_t length = p_record->runs[i + 1];
+        if (length == 0 ||
+            offset + length > p_record->state_size ||
+            i + RUN_HEADER_SIZE + length > p_record->length)
+        {
+            return false;
+        }
+        i += RUN_HEADER_SIZE + length;
+    }
+    return true;
+}
+
+static uint32_t reference_setter(mesh_config_entry_id_t id, const void * p_entry)
+{
+    const reference_t * p_reference = (const reference_t *) p_entry;
+
+    NRF_MESH_ASSERT_DEBUG(id.record >= SCENE_SNAPSHOT_REFERENCE_EID_START &&
+                          id.record < SCENE_SNAPSHOT_REFERENCE_EID_START + SCENE_SETUP_SERVER_INSTANCES_MAX);
+    if (p_reference->state_size > SCENE_SNAPSHOT_STATE_SIZE_MAX)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    m_references[id.record - SCENE_SNAPSHOT_REFERENCE_EID_START] = *p_reference;
+    return NRF_SUCCESS;
+}
+
+static void reference_getter(mesh_config_entry_id_t id, void * p_entry)
+{
+    NRF_MESH_ASSERT_DEBUG(id.record >= SCENE_SNAPSHOT_REFERENCE_EID_START &&
+                          id.record < SCENE_SNAPSHOT_REFERENCE_EID_START + SCENE_SETUP_SERVER_INSTANCES_MAX);
+    *(reference_t *) p_entry = m_references[id.record - SCENE_SNAPSHOT_REFERENCE_EID_START];
+}
+
+static void reference_deleter(mesh_config_entry_id_t id)
+{
+    NRF_MESH_ASSERT_DEBUG(id.record >= SCENE_SNAPSHOT_REFERENCE_EID_START &&
+                          id.record < SCENE_SNAPSHOT_REFERENCE_EID_START + SCENE_SETUP_SERVER_INSTANCES_MAX);
+    m_references[id.record - SCENE_SNAPSHOT_REFERENCE_EID_START].state_size = 0;
+}
+
+static uint32_t record_setter(mesh_config_entry_id_t id, const void * p_entry)
+{
+    const record_t * p_record = (const record_t *) p_entry;
+
+    NRF_MESH_ASSERT_DEBUG(id.record >= SCENE_SNAPSHOT_RECORD_EID_START &&
+                          id.record < SCENE_SNAPSHOT_RECORD_EID_START + RECORD_COUNT);
+    if (p_record->state_size > SCENE_SNAPSHOT_STATE_SIZE_MAX || !runs_are_valid(p_record))
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    m_records[id.record - SCENE_SNAPSHOT_RECORD_EID_START] = *p_record;
+    return NRF_SUCCESS;
+}
+
+static void record_getter(mesh_config_entry_id_t id, void * p_entry)
+{
+    NRF_MESH_ASSERT_DEBUG(id.record >= SCENE_SNAPSHOT_RECORD_EID_START &&
+                          id.record < SCENE_SNAPSHOT_RECORD_EID_START + RECORD_COUNT);
+    *(record_t *) p_entry = m_records[id.record - SCENE_SNAPSHOT_RECORD_EID_START];
+}
+
+static void record_deleter(mesh_config_entry_id_t id)
+{
+    NRF_MESH_ASSERT_DEBUG(id.record >= SCENE_SNAPSHOT_RECORD_EID_START &&
+                          id.record < SCENE_SNAPSHOT_RECORD_EID_START + RECORD_COUNT);
+    m_records[id.record - SCENE_SNAPSHOT_RECORD_EID_START].state_size = 0;
+}
+
+static bool scene_index_is_valid(const scene_snapshot_t * p_snapshot, uint8_t scene_index)
+{
+    return (scene_index / SCENE_REGISTER_ARRAY_SIZE) == p_snapshot->handle;
+}
+
+/* Whether any scene of the instance, other than the given one, is encoded against the reference. */
+static bool other_records_exist(const scene_snapshot_t * p_snapshot, uint8_t scene_index)
+{
+    uint32_t start = p_snapshot->handle * SCENE_REGISTER_ARRAY_SIZE;
+
+    for (uint32_t i = start; i < start + SCENE_REGISTER_ARRAY_SIZE; i++)
+    {
+        if (i != scene_index && m_records[i].state_size != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void snapshot_capture(const scene_snapshot_t * p_snapshot, uint8_t * p_state)
+{
+    for (uint32_t i = 0; i < p_snapshot->model_count; i++)
+    {
+        const scene_snapshot_model_t * p_model = p_snapshot->p_models[i];
+        p_model->p_callbacks->state_get_cb(p_model, &p_state[p_model->offset]);
+    }
+}
+
+/* Encodes the runs of bytes differing from the reference. Returns the encoded length, which is
+ * larger than the capacity if the runs don't fit. */
+static uint32_t delta_encode(const uint8_t * p_reference,
+                             const uint8_t * p_state,
+                             uint32_t size,
+                             uint8_t * p_runs,
+                             uint32_t capacity)
+{
+    uint32_t length = 0;
+    uint32_t i = 0;
+
+    while (i < size)
+    {
+        if (p_reference[i] == p_state[i])
+        {
+            i++;
+            continue;
+        }
+
+        /* Extend the run over short stretches of equal bytes. */
+        uint32_t end = i + 1;
+        for (uint32_t j = end; j < size && (j - end) <= RUN_GAP_MAX; j++)
+        {
+            if (p_reference[j] != p_state[j])
+            {
+                end = j + 1;
+            }
+        }
+
+        if (length + RUN_HEADER_SIZE + (end - i) <= capacity)
+        {
+            p_runs[length] = (uint8_t) i;
+            p_runs[length + 1] = (uint8_t) (end - i);
+            memcpy(&p_runs[length + RUN_HEADER_SIZE], &p_state[i], end - i);
+        }
+        length += RUN_HEADER_SIZE + (end - i);
+        i = end;
+    }
+    return length;
+}
+
+static void delta_decode(const reference_t * p_reference, const record_t * p_record, uint8_t * p_state)
+{
+    memcpy(p_state, p_reference->state, p_reference->state_size);
+
+    for (uint32_t i = 0; i < p_record->length; )
+    {
+        uint8_t offset = p_record->runs[i];
+        uint8_t length = p_record->runs[i + 1];
+        memcpy(&p_state[offset], &p_record->runs[i + RUN_HEADER_SIZE], length);
+        i += RUN_HEADER_SIZE + length;
+    }
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+
+uint32_t scene_snapshot_init(scene_snapshot_t * p_snapshot, uint8_t handle)
+{
+    if (p_snapshot == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (handle >= SCENE_SETUP_SERVER_INSTANCES_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_snapshot, 0, sizeof(scene_snapshot_t));
+    p_snapshot->handle = handle;
+    return NRF_SUCCESS;
+}
+
+uint32_t scene_snapshot_model_add(scene_snapshot_t * p_snapshot, scene_snapshot_model_t * p_model)
+{
+    if (p_snapshot == NULL || p_model == NULL || p_model->p_callbacks == NULL ||
+        p_model->p_callbacks->state_get_cb == NULL || p_model->p_callbacks->state_apply_cb == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (p_model->state_size == 0)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (p_snapshot->model_count >= SCENE_SNAPSHOT_MODELS_MAX ||
+        p_snapshot->state_size + p_model->state_size > SCENE_SNAPSHOT_STATE_SIZE_MAX)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_model->offset = p_snapshot->state_size;
+    p_snapshot->p_models[p_snapshot->model_count++] = p_model;
+    p_snapshot->state_size += p_model->state_size;
+    return NRF_SUCCESS;
+}
+
+uint32_t scene_snapshot_store(scene_snapshot_t * p_snapshot, uint8_t scene_index)
+{
+    uint8_t state[SCENE_SNAPSHOT_STATE_SIZE_MAX];
+    record_t record;
+    uint32_t status;
+
+    if (p_snapshot == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (!scene_index_is_valid(p_snapshot, scene_index))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (p_snapshot->model_count == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    snapshot_capture(p_snapshot, state);
+
+    memset(&record, 0, sizeof(record));
+    record.state_size = p_snapshot->state_size;
+
+    reference_t * p_reference = &m_references[p_snapshot->handle];
+    if (p_reference->state_size == p_snapshot->state_size && other_records_exist(p_snapshot, scene_index))
+    {
+        uint32_t length = delta_encode(p_reference->state, state, p_snapshot->state_size,
+                                       record.runs, sizeof(record.runs));
+        if (length > sizeof(record.runs))
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+        record.length = (uint8_t) length;
+    }
+    else
+    {
+        /* No other scene depends on the reference, this scene becomes the new reference. */
+        reference_t reference;
+        mesh_config_entry_id_t id = SCENE_SNAPSHOT_REFERENCE_EID;
+
+        memset(&reference, 0, sizeof(reference));
+        reference.state_size = p_snapshot->state_size;
+        memcpy(reference.state, state, p_snapshot->state_size);
+
+        id.record += p_snapshot->handle;
+        status = mesh_config_entry_set(id, &reference);
+        if (status != NRF_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    mesh_config_entry_id_t id = SCENE_SNAPSHOT_RECORD_EID;
+    id.record += scene_index;
+    return mesh_config_entry_set(id, &record);
+}
+
+uint32_t scene_snapshot_recall(scene_snapshot_t * p_snapshot,
+                               uint8_t scene_index,
+                               uint32_t delay_ms,
+                               uint32_t transition_time_ms)
+{
+    uint8_t state[SCENE_SNAPSHOT_STATE_SIZE_MAX];
+
+    if (p_snapshot == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (!scene_index_is_valid(p_snapshot, scene_index))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (p_snapshot->model_count == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    const reference_t * p_reference = &m_references[p_snapshot->handle];
+    const record_t * p_record = &m_records[scene_index];
+
+    /* Snapshots stored with another set of models can't be applied. */
+    if (p_record->state_size == 0 ||
+        p_record->state_size != p_snapshot->state_size ||
+        p_reference->state_size != p_snapshot->state_size)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    delta_decode(p_reference, p_record, state);
+
+    for (uint32_t i = 0; i < p_snapshot->model_count; i++)
+    {
+        const scene_snapshot_model_t * p_model = p_snapshot->p_models[i];
+        p_model->p_callbacks->state_apply_cb(p_model, &state[p_model->offset], delay_ms, transition_time_ms);
+    }
+    return NRF_SUCCESS;
+}
+
+uint32_t scene_snapshot_delete(scene_snapshot_t * p_snapshot, uint8_t scene_index)
+{
+    uint32_t status;
+
+    if (p_snapshot == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (!scene_index_is_valid(p_snapshot, scene_index))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (m_records[scene_index].state_size == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    mesh_config_entry_id_t id = SCENE_SNAPSHOT_RECORD_EID;
+    id.record += scene_index;
+    status = mesh_config_entry_delete(id);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    /* The reference goes with the last scene, the next stored scene becomes the new one. */
+    if (!other_records_exist(p_snapshot, scene_index) && m_references[p_snapshot->handle].state_size != 0)
+    {
+        id = SCENE_SNAPSHOT_REFERENCE_EID;
+        id.record += p_snapshot->handle;
+        status = mesh_config_entry_delete(id);
+    }
+    return status;
+}
+
+void scene_snapshot_clear(void)
+{
+    mesh_config_entry_id_t id;
+
+    for (uint32_t i = 0; i < RECORD_COUNT; i++)
+    {
+        if (m_records[i].state_size != 0)
+        {
+            id = SCENE_SNAPSHOT_RECORD_EID;
+            id.record += i;
+            (void) mesh_config_entry_delete(id);
+        }
+    }
+
+    for (uint32_t i = 0; i < SCENE_SETUP_SERVER_INSTANCES_MAX; i++)
+    {
+        if (m_references[i].state_size != 0)
+        {
+            id = SCENE_SNAPSHOT_REFERENCE_EID;
+            id.record += i;
+            (void) mesh_config_entry_delete(id);
+        }
+    }
+
+    scene_snapshot_storage_init();
+}
+
+void scene_snapshot_storage_init(void)
+{
+    memset(m_references, 0, sizeof(m_references));
+    memset(m_records, 0, sizeof(m_records));
+}
+#endif /* SCENE_SETUP_SERVER_INSTANCES_MAX > 0*/
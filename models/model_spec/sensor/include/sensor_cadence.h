@@ -0,0 +1,137 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SENSOR_CADENCE_H__
+#define SENSOR_CADENCE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @defgroup SENSOR_CADENCE Sensor cadence engine
+ * @ingroup SENSOR_MODEL
+ *
+ * Evaluates the Sensor Cadence state (see @tagMeshMdlSp section 4.1.3) of a sensor property.
+ *
+ * A cadence is compiled once, when it is set, into an evaluator holding the thresholds in a
+ * normalized form: values of any format up to 4 bytes, signed or unsigned, are mapped to unsigned
+ * 32-bit numbers that keep their order, and the fast cadence region is reduced to a single
+ * unsigned range check. Evaluating a sample then needs no knowledge of the property format, and no
+ * division.
+ *
+ * @{
+ */
+
+/** Largest sensor value supported by the cadence engine, in bytes. */
+#define SENSOR_CADENCE_VALUE_BYTES_MAX              (4)
+/** Largest valid Fast Cadence Period Divisor exponent. */
+#define SENSOR_CADENCE_FAST_PERIOD_DIVISOR_MAX      (15)
+/** Largest valid Status Min Interval exponent. */
+#define SENSOR_CADENCE_STATUS_MIN_INTERVAL_MAX      (26)
+
+/** The sensor value is in the fast cadence region. */
+#define SENSOR_CADENCE_FLAG_FAST_REGION             (1 << 0)
+/** The change from the previously published value exceeds the status trigger delta. */
+#define SENSOR_CADENCE_FLAG_DELTA_TRIGGER           (1 << 1)
+
+/** Compiled cadence of a single sensor property. */
+typedef struct
+{
+    uint32_t value_mask;            /**< Mask of the value bytes. */
+    uint32_t sign_bit;              /**< Sign bit of signed values, 0 for unsigned values. */
+    uint32_t order_bias;            /**< Flips the sign of signed values to give them unsigned order. */
+    uint32_t fast_base;             /**< Start of the checked range, normalized. */
+    uint32_t fast_span;             /**< Length of the checked range. */
+    uint32_t delta_down;            /**< Status Trigger Delta Down, 0 if disabled. */
+    uint32_t delta_up;              /**< Status Trigger Delta Up, 0 if disabled. */
+    uint8_t value_bytes;            /**< Size of the sensor value. */
+    uint8_t fast_period_exponent;   /**< Fast Cadence Period Divisor, as a power of two. */
+    uint8_t min_interval_exponent;  /**< Status Min Interval, as a power of two milliseconds. */
+    bool fast_region_inverted;      /**< The fast region is outside the checked range. */
+    bool trigger_percent;           /**< The deltas are in units of 0.01 percent. */
+} sensor_cadence_eval_t;
+
+/**
+ * Compiles a serialized cadence into an evaluator.
+ *
+ * @param[out] p_eval       Evaluator to compile into.
+ * @param[in]  value_bytes  Size of the sensor value, 1 to @ref SENSOR_CADENCE_VALUE_BYTES_MAX.
+ * @param[in]  is_signed    Whether the sensor value is a signed number.
+ * @param[in]  p_cadence    Serialized cadence, starting with the Fast Cadence Period Divisor field
+ *                          (i.e. following the property ID of a Sensor Cadence Set message).
+ * @param[in]  length       Number of bytes at @p p_cadence.
+ *
+ * @retval NRF_SUCCESS              The cadence was compiled into @p p_eval.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  Unsupported value format.
+ * @retval NRF_ERROR_INVALID_LENGTH The cadence is too short for the value format.
+ * @retval NRF_ERROR_INVALID_DATA   The cadence contains prohibited values. @p p_eval is not changed.
+ */
+uint32_t sensor_cadence_compile(sensor_cadence_eval_t * p_eval,
+                                uint8_t value_bytes,
+                                bool is_signed,
+                                const uint8_t * p_cadence,
+                                uint16_t length);
+
+/**
+ * Evaluates a sensor sample.
+ *
+ * @param[in] p_eval      Compiled cadence.
+ * @param[in] p_current   Current sensor value, in the property format.
+ * @param[in] p_previous  Previously published sensor value, in the property format.
+ *
+ * @returns A combination of @ref SENSOR_CADENCE_FLAG_FAST_REGION and
+ * @ref SENSOR_CADENCE_FLAG_DELTA_TRIGGER.
+ */
+uint32_t sensor_cadence_evaluate(const sensor_cadence_eval_t * p_eval,
+                                 const uint8_t * p_current,
+                                 const uint8_t * p_previous);
+
+/**
+ * Gets the publication period to use while the sensor value is in the fast cadence region.
+ *
+ * @param[in] p_eval             Compiled cadence.
+ * @param[in] publish_period_us  Publish period of the model.
+ *
+ * @returns The publish period divided by the Fast Cadence Period Divisor, but no shorter than the
+ * Status Min Interval.
+ */
+uint64_t sensor_cadence_fast_period_us_get(const sensor_cadence_eval_t * p_eval,
+                                           uint64_t publish_period_us);
+
+/**@} end of SENSOR_CADENCE */
+#endif /* SENSOR_CADENCE_H__ */
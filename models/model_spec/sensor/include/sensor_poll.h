@@ -0,0 +1,225 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SENSOR_POLL_H__
+#define SENSOR_POLL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "access.h"
+#include "access_reliable.h"
+#include "device_state_manager.h"
+#include "sensor_client.h"
+
+/**
+ * @defgroup SENSOR_POLL Sensor client polling scheduler
+ * @ingroup SENSOR_MODEL
+ * Polls the Sensor Data state of a list of sensor servers, one request per server and poll cycle.
+ *
+ * A server from which several properties are wanted is polled with a single Sensor Get without a
+ * property ID, which returns all its properties in one Sensor Status. The requests are spread over
+ * several sensor client instances (contexts), each with its own acknowledged transaction, so one
+ * request per context is in flight to different servers at the same time. The decoded properties
+ * of each server are delivered in one callback.
+ *
+ * The scheduler doesn't register any callbacks of its own. The application forwards the Sensor
+ * Status messages and the transaction status of its context clients with
+ * @ref sensor_poll_status_handle() and @ref sensor_poll_transaction_handle().
+ *
+ * @{
+ */
+
+/** Largest number of properties delivered for a server in one callback. */
+#ifndef SENSOR_POLL_VALUES_MAX
+#define SENSOR_POLL_VALUES_MAX      (16)
+#endif
+
+/** Decoded property value in a Sensor Status. */
+typedef struct
+{
+    uint16_t property_id;           /**< Property ID of the value. */
+    uint8_t length;                 /**< Length of the raw value in bytes. */
+    const uint8_t * p_raw_value;    /**< Raw value, valid only in the status callback. */
+} sensor_poll_value_t;
+
+/** Server polled by the scheduler. */
+typedef struct
+{
+    /** Publish address handle of the server, see @ref dsm_address_publish_add(). */
+    dsm_handle_t address_handle;
+    /** Properties wanted from the server, or NULL for all of them. */
+    const uint16_t * p_property_ids;
+    /** Number of properties at @c p_property_ids. */
+    uint8_t property_count;
+
+    /* Internal state, set up by @ref sensor_poll_init(). */
+    uint16_t address;
+    uint8_t attempts;
+} sensor_poll_server_t;
+
+/** Sensor client instance used for the requests. */
+typedef struct
+{
+    /** Initialized sensor client, bound to an application key the servers use. */
+    sensor_client_t * p_client;
+
+    /* Internal state, set up by @ref sensor_poll_init(). */
+    uint16_t server_index;
+} sensor_poll_context_t;
+
+/* Forward declaration */
+typedef struct __sensor_poll_t sensor_poll_t;
+
+/**
+ * Callback for the properties received from a server.
+ *
+ * @param[in] p_poll        Polling scheduler.
+ * @param[in] server_index  Index of the server in the server list.
+ * @param[in] p_values      Decoded values of the wanted properties, in the order of the message.
+ * @param[in] value_count   Number of values at @p p_values.
+ */
+typedef void (*sensor_poll_status_cb_t)(const sensor_poll_t * p_poll,
+                                        uint16_t server_index,
+                                        const sensor_poll_value_t * p_values,
+                                        uint8_t value_count);
+
+/**
+ * Callback at the end of a poll cycle.
+ *
+ * @param[in] p_poll        Polling scheduler.
+ * @param[in] failed_count  Number of servers that didn't respond in this cycle.
+ */
+typedef void (*sensor_poll_cycle_cb_t)(const sensor_poll_t * p_poll, uint16_t failed_count);
+
+/** Polling scheduler. */
+struct __sensor_poll_t
+{
+    /** Servers to poll. */
+    sensor_poll_server_t * p_servers;
+    /** Number of servers at @c p_servers. */
+    uint16_t server_count;
+    /** Contexts for the requests. */
+    sensor_poll_context_t * p_contexts;
+    /** Number of contexts at @c p_contexts. */
+    uint8_t context_count;
+    /** Number of times a request is repeated after a timeout. */
+    uint8_t retries;
+    /** Callback for the received properties. */
+    sensor_poll_status_cb_t status_cb;
+    /** Callback at the end of each poll cycle. */
+    sensor_poll_cycle_cb_t cycle_cb;
+
+    /* Internal state. */
+    uint16_t next_server;
+    uint16_t done_count;
+    uint16_t failed_count;
+    bool active;
+};
+
+/**
+ * Initializes a polling scheduler.
+ *
+ * The user fills in the public fields of the scheduler, the servers and the contexts first.
+ *
+ * @param[in,out] p_poll    Polling scheduler.
+ *
+ * @retval NRF_SUCCESS              The scheduler is ready for @ref sensor_poll_cycle_start().
+ * @retval NRF_ERROR_NULL           A pointer or callback was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM  There are no servers or contexts, or a context client is used
+ *                                  twice.
+ * @retval NRF_ERROR_INVALID_ADDR   A server address handle isn't a unicast address.
+ */
+uint32_t sensor_poll_init(sensor_poll_t * p_poll);
+
+/**
+ * Starts a poll cycle.
+ *
+ * @param[in,out] p_poll    Polling scheduler.
+ *
+ * @retval NRF_SUCCESS              The first requests have been sent.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_BUSY           The previous poll cycle hasn't ended.
+ */
+uint32_t sensor_poll_cycle_start(sensor_poll_t * p_poll);
+
+/**
+ * Stops the current poll cycle, cancelling the requests in flight.
+ *
+ * No cycle callback is called for the stopped cycle.
+ *
+ * @param[in,out] p_poll    Polling scheduler.
+ */
+void sensor_poll_stop(sensor_poll_t * p_poll);
+
+/**
+ * Handles a Sensor Status received by a context client.
+ *
+ * Call from the @ref sensor_client_callbacks_t::sensor_status_cb of the context clients.
+ *
+ * @param[in,out] p_poll    Polling scheduler.
+ * @param[in]     p_client  Client that received the message.
+ * @param[in]     p_meta    Access metadata of the message.
+ * @param[in]     p_in      Message parameters.
+ * @param[in]     length    Length of the message parameters.
+ *
+ * @returns Whether the message was a response to a request of the scheduler.
+ */
+bool sensor_poll_status_handle(sensor_poll_t * p_poll,
+                               const sensor_client_t * p_client,
+                               const access_message_rx_meta_t * p_meta,
+                               const sensor_status_msg_pkt_t * p_in,
+                               uint16_t length);
+
+/**
+ * Handles the end of an acknowledged transaction of a context client.
+ *
+ * Call from the @ref sensor_client_callbacks_t::ack_transaction_status_cb of the context clients.
+ *
+ * @param[in,out] p_poll        Polling scheduler.
+ * @param[in]     model_handle  Model handle of the client.
+ * @param[in]     status        Transaction status.
+ *
+ * @returns Whether the transaction belonged to the scheduler.
+ */
+bool sensor_poll_transaction_handle(sensor_poll_t * p_poll,
+                                    access_model_handle_t model_handle,
+                                    access_reliable_status_t status);
+
+/** @} end of SENSOR_POLL */
+
+#endif /* SENSOR_POLL_H__ */
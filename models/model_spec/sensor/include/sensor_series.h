@@ -0,0 +1,204 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SENSOR_SERIES_H__
+#define SENSOR_SERIES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @defgroup SENSOR_SERIES Sensor series column store
+ * @ingroup SENSOR_MODEL
+ *
+ * Stores the Sensor Series Column states (see @tagMeshMdlSp section 4.1.5) of a sensor property,
+ * so the Sensor Setup Server can answer Sensor Column Get and Sensor Series Get messages itself.
+ *
+ * The columns are kept in a fixed size ring buffer provided by the application, sorted by their
+ * Raw Value X. Adding a column with a higher Raw Value X than all stored columns is the fast path,
+ * which fits data logging sensors using a time stamp or sample counter as Raw Value X. When the
+ * ring is full, the column with the lowest Raw Value X is dropped. Lookups are binary searches, and
+ * the stored columns have the same layout as in the status messages, so responses are serialized
+ * with at most two copies.
+ *
+ * Raw values are little endian. Raw Value X is compared as a signed or unsigned number, depending
+ * on the format of the property.
+ *
+ * @{
+ */
+
+/** Largest supported Raw Value X (and Column Width) size, in bytes. */
+#define SENSOR_SERIES_X_BYTES_MAX       (4)
+/** Largest supported Raw Value Y size, in bytes. */
+#define SENSOR_SERIES_Y_BYTES_MAX       (16)
+
+/** Size of a stored column: Raw Value X, Column Width and Raw Value Y. */
+#define SENSOR_SERIES_COLUMN_BYTES(x_bytes, y_bytes)    (2 * (x_bytes) + (y_bytes))
+
+/** Series column store of a single sensor property. */
+typedef struct
+{
+    uint16_t property_id;   /**< Sensor property the columns belong to. */
+    uint8_t x_bytes;        /**< Size of Raw Value X and Column Width. */
+    bool x_signed;          /**< Whether Raw Value X is a signed number. */
+    uint8_t y_bytes;        /**< Size of Raw Value Y. */
+    uint8_t * p_buffer;     /**< Column storage. */
+    uint16_t capacity;      /**< Number of columns that fit in the storage. */
+    uint16_t head;          /**< Slot of the column with the lowest Raw Value X. */
+    uint16_t count;         /**< Number of stored columns. */
+} sensor_series_t;
+
+/** Columns selected by a lookup, see @ref sensor_series_status_serialize. */
+typedef struct
+{
+    uint16_t first;         /**< Index of the first selected column, in Raw Value X order. */
+    uint16_t count;         /**< Number of selected columns. */
+    uint16_t bytes;         /**< Size of the status message parameters. */
+    bool is_column;         /**< Whether the lookup was for a Sensor Column Status message. */
+    uint8_t raw_x[SENSOR_SERIES_X_BYTES_MAX]; /**< Requested Raw Value X of a column lookup. */
+} sensor_series_query_t;
+
+/**
+ * Initializes a series column store.
+ *
+ * @param[out] p_series     Store to initialize.
+ * @param[in]  property_id  Sensor property the columns belong to.
+ * @param[in]  x_bytes      Size of Raw Value X and Column Width, 1 to @ref SENSOR_SERIES_X_BYTES_MAX.
+ * @param[in]  x_signed     Whether the property format of Raw Value X is a signed number.
+ * @param[in]  y_bytes      Size of Raw Value Y, 1 to @ref SENSOR_SERIES_Y_BYTES_MAX.
+ * @param[in]  p_buffer     Column storage.
+ * @param[in]  buffer_bytes Size of the column storage. Must fit at least one column of
+ *                          @ref SENSOR_SERIES_COLUMN_BYTES.
+ *
+ * @retval NRF_SUCCESS              The store was initialized.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  Invalid property ID or value size.
+ * @retval NRF_ERROR_INVALID_LENGTH The buffer is too small.
+ */
+uint32_t sensor_series_init(sensor_series_t * p_series,
+                            uint16_t property_id,
+                            uint8_t x_bytes,
+                            bool x_signed,
+                            uint8_t y_bytes,
+                            uint8_t * p_buffer,
+                            uint32_t buffer_bytes);
+
+/**
+ * Removes all columns from a store.
+ *
+ * @param[in,out] p_series Store to clear.
+ */
+void sensor_series_clear(sensor_series_t * p_series);
+
+/**
+ * Adds or updates a column.
+ *
+ * If a column with the same Raw Value X is stored, its Column Width and Raw Value Y are updated.
+ * Otherwise the column is inserted in order. If the store is full, the column with the lowest Raw
+ * Value X is dropped to make room.
+ *
+ * @param[in,out] p_series  Store to add the column to.
+ * @param[in]     p_raw_x   Raw Value X, @c x_bytes long.
+ * @param[in]     p_width   Column Width, @c x_bytes long.
+ * @param[in]     p_raw_y   Raw Value Y, @c y_bytes long.
+ *
+ * @retval NRF_SUCCESS      The column was stored.
+ * @retval NRF_ERROR_NULL   NULL pointer given to function.
+ * @retval NRF_ERROR_NO_MEM The store is full, and the column is below all stored columns.
+ */
+uint32_t sensor_series_column_set(sensor_series_t * p_series,
+                                  const uint8_t * p_raw_x,
+                                  const uint8_t * p_width,
+                                  const uint8_t * p_raw_y);
+
+/**
+ * Looks up the column requested by a Sensor Column Get message.
+ *
+ * @param[in]  p_series Store to look in.
+ * @param[in]  p_params Sensor Column Get message parameters, starting with the property ID.
+ * @param[in]  length   Length of the message parameters.
+ * @param[out] p_query  Lookup result. If the column is not stored, @c count is 0 and the status
+ *                      contains the Raw Value X only.
+ *
+ * @retval NRF_SUCCESS              The status message can be serialized.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  The message is for another property.
+ * @retval NRF_ERROR_INVALID_LENGTH The message length doesn't match the Raw Value X size.
+ */
+uint32_t sensor_series_column_query(const sensor_series_t * p_series,
+                                    const uint8_t * p_params,
+                                    uint16_t length,
+                                    sensor_series_query_t * p_query);
+
+/**
+ * Looks up the columns requested by a Sensor Series Get message.
+ *
+ * Selects the columns with Raw Value X in the closed interval [Raw Value X1, Raw Value X2], or all
+ * columns if the message has no interval. If the columns don't fit in @p bytes_max, the selection
+ * is truncated to the lowest Raw Values X that fit.
+ *
+ * @param[in]  p_series  Store to look in.
+ * @param[in]  p_params  Sensor Series Get message parameters, starting with the property ID.
+ * @param[in]  length    Length of the message parameters.
+ * @param[in]  bytes_max Largest size of the status message parameters.
+ * @param[out] p_query   Lookup result.
+ *
+ * @retval NRF_SUCCESS              The status message can be serialized.
+ * @retval NRF_ERROR_NULL           NULL pointer given to function.
+ * @retval NRF_ERROR_INVALID_PARAM  The message is for another property.
+ * @retval NRF_ERROR_INVALID_LENGTH The message length doesn't match the Raw Value X size, or
+ *                                  @p bytes_max doesn't fit the property ID.
+ */
+uint32_t sensor_series_range_query(const sensor_series_t * p_series,
+                                   const uint8_t * p_params,
+                                   uint16_t length,
+                                   uint16_t bytes_max,
+                                   sensor_series_query_t * p_query);
+
+/**
+ * Serializes the status message parameters for a lookup.
+ *
+ * @param[in]  p_series Store the lookup was done in. Must not be changed since the lookup.
+ * @param[in]  p_query  Lookup result.
+ * @param[out] p_out    Buffer for the message parameters, at least @c p_query->bytes long.
+ */
+void sensor_series_status_serialize(const sensor_series_t * p_series,
+                                    const sensor_series_query_t * p_query,
+                                    uint8_t * p_out);
+
+/**@} end of SENSOR_SERIES */
+#endif /* SENSOR_SERIES_H__ */
@@ -43,6 +43,7 @@
 #include "sensor_common.h"
 #include "model_common.h"
 #include "sensor_messages.h"
+#include "sensor_series.h"
 
 /**
  * @defgroup SENSOR_SERVER Sensor Setup server model interface
@@ -260,6 +261,8 @@ typedef struct
 {
     sensor_descriptor_get_cb_t       descriptor_get_cb;
     sensor_state_get_cb_t            get_cb;
+    /** Column and series callbacks may be NULL if the server has series column stores, see
+     *  @ref sensor_setup_server_settings_t. */
     sensor_column_get_cb_t           column_get_cb;
     sensor_series_get_cb_t           series_get_cb;
     sensor_cadence_get_cb_t          cadence_get_cb;
@@ -298,6 +301,14 @@ typedef struct
      */
     uint16_t * property_array;
 
+    /** Series column stores for the properties that have series data (optional). Sensor Column Get
+     *  and Sensor Series Get messages for these properties are answered from the stores, without
+     *  calling @c column_get_cb or @c series_get_cb. See @ref SENSOR_SERIES.
+     */
+    const sensor_series_t * p_series;
+    /** Number of series column stores at @c p_series. */
+    uint8_t series_count;
+
     /** Callback list. */
     const sensor_setup_server_callbacks_t * p_callbacks;
 } sensor_setup_server_settings_t;
@@ -0,0 +1,210 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sensor_cadence.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "nrf_error.h"
+#include "utils.h"
+
+/** Status Trigger Type: deltas are in the format of the property value. */
+#define TRIGGER_TYPE_VALUE      (0)
+/** Status Trigger Type: deltas are uint16 percentages with a resolution of 0.01 percent. */
+#define TRIGGER_TYPE_PERCENT    (1)
+
+#define DIVISOR_MASK            (0x7F)
+#define TRIGGER_TYPE_SHIFT      (7)
+#define PERCENT_BYTES           (2)
+/** 100 percent at a resolution of 0.01 percent. */
+#define PERCENT_SCALE           (10000ull)
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+/* Loads a value and maps it to an unsigned number with the same order. */
+static inline uint32_t value_normalize(const sensor_cadence_eval_t * p_eval, const uint8_t * p_value)
+{
+    uint32_t raw = 0;
+    memcpy(&raw, p_value, p_eval->value_bytes);
+    raw &= p_eval->value_mask;
+    return ((raw ^ p_eval->sign_bit) - p_eval->sign_bit) ^ p_eval->order_bias;
+}
+
+/* Loads a delta in the property format. Negative deltas can never trigger. */
+static uint32_t delta_get(const sensor_cadence_eval_t * p_eval, const uint8_t * p_value)
+{
+    uint32_t delta = value_normalize(p_eval, p_value) ^ p_eval->order_bias;
+    return (p_eval->order_bias && (int32_t) delta < 0) ? 0 : delta;
+}
+
+static inline bool in_fast_region(const sensor_cadence_eval_t * p_eval, uint32_t value)
+{
+    return ((value - p_eval->fast_base) <= p_eval->fast_span) != p_eval->fast_region_inverted;
+}
+
+static inline bool delta_trigger(const sensor_cadence_eval_t * p_eval, uint32_t current, uint32_t previous)
+{
+    bool rising = (current > previous);
+    uint32_t difference = rising ? current - previous : previous - current;
+    uint32_t threshold = rising ? p_eval->delta_up : p_eval->delta_down;
+
+    if (!p_eval->trigger_percent)
+    {
+        return (threshold != 0) & (difference >= threshold);
+    }
+
+    /* The change relative to the previous value, compared without dividing. Any change from 0 is
+     * considered infinite. */
+    uint32_t magnitude = previous ^ p_eval->order_bias;
+    if (p_eval->order_bias && (int32_t) magnitude < 0)
+    {
+        magnitude = -magnitude;
+    }
+    return (magnitude == 0) ||
+           ((threshold != 0) & ((uint64_t) difference * PERCENT_SCALE >= (uint64_t) threshold * magnitude));
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+
+uint32_t sensor_cadence_compile(sensor_cadence_eval_t * p_eval,
+                                uint8_t value_bytes,
+                                bool is_signed,
+                                const uint8_t * p_cadence,
+                                uint16_t length)
+{
+    if (p_eval == NULL || p_cadence == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (value_bytes == 0 || value_bytes > SENSOR_CADENCE_VALUE_BYTES_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (length < 1)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    uint8_t fast_period_exponent = p_cadence[0] & DIVISOR_MASK;
+    uint8_t trigger_type = p_cadence[0] >> TRIGGER_TYPE_SHIFT;
+    uint8_t delta_bytes = (trigger_type == TRIGGER_TYPE_PERCENT) ? PERCENT_BYTES : value_bytes;
+
+    /* Divisor, two deltas, min interval, two range values. */
+    uint16_t offset = 1;
+    if (length < offset + 2 * delta_bytes + 1 + 2 * value_bytes)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    const uint8_t * p_delta_down = &p_cadence[offset];
+    offset += delta_bytes;
+    const uint8_t * p_delta_up = &p_cadence[offset];
+    offset += delta_bytes;
+    uint8_t min_interval_exponent = p_cadence[offset++];
+    const uint8_t * p_fast_low = &p_cadence[offset];
+    offset += value_bytes;
+    const uint8_t * p_fast_high = &p_cadence[offset];
+
+    /* @tagMeshMdlSp sections 4.1.3.1 and 4.1.3.5: other values are Prohibited. */
+    if (fast_period_exponent > SENSOR_CADENCE_FAST_PERIOD_DIVISOR_MAX ||
+        min_interval_exponent > SENSOR_CADENCE_STATUS_MIN_INTERVAL_MAX)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    sensor_cadence_eval_t eval;
+    memset(&eval, 0, sizeof(eval));
+    eval.value_bytes = value_bytes;
+    eval.value_mask = UINT32_MAX >> (32 - 8 * value_bytes);
+    eval.sign_bit = is_signed ? (1ul << (8 * value_bytes - 1)) : 0;
+    eval.order_bias = is_signed ? (1ul << 31) : 0;
+    eval.fast_period_exponent = fast_period_exponent;
+    eval.min_interval_exponent = min_interval_exponent;
+    eval.trigger_percent = (trigger_type == TRIGGER_TYPE_PERCENT);
+
+    if (eval.trigger_percent)
+    {
+        uint16_t delta;
+        memcpy(&delta, p_delta_down, sizeof(delta));
+        eval.delta_down = delta;
+        memcpy(&delta, p_delta_up, sizeof(delta));
+        eval.delta_up = delta;
+    }
+    else
+    {
+        eval.delta_down = delta_get(&eval, p_delta_down);
+        eval.delta_up = delta_get(&eval, p_delta_up);
+    }
+
+    /* @tagMeshMdlSp section 4.1.3: If Fast Cadence High is lower than Fast Cadence Low, the fast
+     * region is everything outside the open interval between them. In both cases, a single
+     * unsigned comparison of the distance to the range start does the check. */
+    uint32_t fast_low = value_normalize(&eval, p_fast_low);
+    uint32_t fast_high = value_normalize(&eval, p_fast_high);
+    eval.fast_region_inverted = (fast_high < fast_low);
+    eval.fast_base = eval.fast_region_inverted ? fast_high : fast_low;
+    eval.fast_span = eval.fast_region_inverted ? fast_low - fast_high : fast_high - fast_low;
+
+    *p_eval = eval;
+    return NRF_SUCCESS;
+}
+
+uint32_t sensor_cadence_evaluate(const sensor_cadence_eval_t * p_eval,
+                                 const uint8_t * p_current,
+                                 const uint8_t * p_previous)
+{
+    uint32_t current = value_normalize(p_eval, p_current);
+    uint32_t previous = value_normalize(p_eval, p_previous);
+
+    return (in_fast_region(p_eval, current) ? SENSOR_CADENCE_FLAG_FAST_REGION : 0) |
+           (delta_trigger(p_eval, current, previous) ? SENSOR_CADENCE_FLAG_DELTA_TRIGGER : 0);
+}
+
+uint64_t sensor_cadence_fast_period_us_get(const sensor_cadence_eval_t * p_eval,
+                                           uint64_t publish_period_us)
+{
+    uint64_t period_us = publish_period_us >> p_eval->fast_period_exponent;
+    uint64_t min_interval_us = MS_TO_US(1ull << p_eval->min_interval_exponent);
+    return MAX(period_us, min_interval_us);
+}
@@ -0,0 +1,367 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sensor_poll.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include "access_config.h"
+#include "nrf_mesh_assert.h"
+#include "log.h"
+
+#include "sensor_utils.h"
+
+/** Context not waiting for a response. */
+#define SERVER_INDEX_NONE   (0xFFFF)
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+static bool property_wanted(const sensor_poll_server_t * p_server, uint16_t property_id)
+{
+    if (p_server->p_property_ids == NULL)
+    {
+        return true;
+    }
+
+    for (uint32_t i = 0; i < p_server->property_count; i++)
+    {
+        if (p_server->p_property_ids[i] == property_id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Decodes the marshalled sensor data of a Sensor Status, keeping the wanted properties. */
+static uint8_t status_decode(const sensor_poll_server_t * p_server,
+                             const uint8_t * p_data,
+                             uint16_t length,
+                             sensor_poll_value_t * p_values)
+{
+    uint8_t count = 0;
+    uint16_t offset = 0;
+
+    while (offset < length && count < SENSOR_POLL_VALUES_MAX)
+    {
+        sensor_poll_value_t value;
+
+        if ((p_data[offset] & 0x01) == SENSOR_FORMAT_A_BIT)
+        {
+            if (offset + SENSOR_MPID_A_BYTES > length)
+            {
+                break;
+            }
+            uint16_t mpid = p_data[offset] | (p_data[offset + 1] << 8);
+            /* Length is defined as 0-0xF representing 1-16. */
+            value.length = ((mpid >> 1) & 0x0F) + 1;
+            value.property_id = mpid >> 5;
+            offset += SENSOR_MPID_A_BYTES;
+        }
+        else
+        {
+            if (offset + SENSOR_MPID_B_BYTES > length)
+            {
+                break;
+            }
+            /* Length is defined as 0-0x7F representing 1-127, 0x7F = 0. */
+            value.length = p_data[offset] >> 1;
+            value.length = (value.length == SENSOR_MPID_B_ZERO_DATA_BYTES) ? 0 : value.length + 1;
+            value.property_id = p_data[offset + 1] | (p_data[offset + 2] << 8);
+            offset += SENSOR_MPID_B_BYTES;
+        }
+
+        if (offset + value.length > length)
+        {
+            __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Truncated sensor data for property 0x%04x\n", value.property_id);
+            break;
+        }
+
+        value.p_raw_value = &p_data[offset];
+        offset += value.length;
+
+        if (property_wanted(p_server, value.property_id))
+        {
+            p_values[count++] = value;
+        }
+    }
+    return count;
+}
+
+static uint32_t request_send(const sensor_poll_t * p_poll, const sensor_poll_context_t * p_context)
+{
+    const sensor_poll_server_t * p_server = &p_poll->p_servers[p_context->server_index];
+
+    /* Overridden rather than set, so the publication state of the client isn't changed or stored. */
+    uint32_t status = access_model_publish_address_override_set(p_context->p_client->model_handle,
+                                                                p_server->address_handle);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    /* A single wanted property is asked for by itself, otherwise all properties come in one status. */
+    return sensor_client_get(p_context->p_client,
+                             (p_server->property_count == 1) ? p_server->p_property_ids[0] : 0);
+}
+
+static void server_done(sensor_poll_t * p_poll, bool failed)
+{
+    p_poll->done_count++;
+    if (failed)
+    {
+        p_poll->failed_count++;
+    }
+}
+
+static void cycle_end_check(sensor_poll_t * p_poll)
+{
+    if (p_poll->active && p_poll->done_count == p_poll->server_count)
+    {
+        p_poll->active = false;
+        p_poll->cycle_cb(p_poll, p_poll->failed_count);
+    }
+}
+
+/* Sends the next request of the cycle on the context, if any. */
+static void context_dispatch(sensor_poll_t * p_poll, sensor_poll_context_t * p_context)
+{
+    p_context->server_index = SERVER_INDEX_NONE;
+
+    while (p_poll->active && p_poll->next_server < p_poll->server_count)
+    {
+        p_context->server_index = p_poll->next_server++;
+        p_poll->p_servers[p_context->server_index].attempts = 1;
+
+        uint32_t status = request_send(p_poll, p_context);
+        if (status == NRF_SUCCESS)
+        {
+            return;
+        }
+
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Sensor poll of 0x%04x failed: %d\n",
+              p_poll->p_servers[p_context->server_index].address, status);
+        p_context->server_index = SERVER_INDEX_NONE;
+        server_done(p_poll, true);
+    }
+
+    (void) access_model_publish_address_override_set(p_context->p_client->model_handle, DSM_HANDLE_INVALID);
+}
+
+static sensor_poll_context_t * context_get(const sensor_poll_t * p_poll, access_model_handle_t model_handle)
+{
+    for (uint32_t i = 0; i < p_poll->context_count; i++)
+    {
+        if (p_poll->p_contexts[i].p_client->model_handle == model_handle)
+        {
+            return &p_poll->p_contexts[i];
+        }
+    }
+    return NULL;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+
+uint32_t sensor_poll_init(sensor_poll_t * p_poll)
+{
+    if (p_poll == NULL || p_poll->p_servers == NULL || p_poll->p_contexts == NULL ||
+        p_poll->status_cb == NULL || p_poll->cycle_cb == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (p_poll->server_count == 0 || p_poll->server_count == SERVER_INDEX_NONE || p_poll->context_count == 0)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < p_poll->context_count; i++)
+    {
+        if (p_poll->p_contexts[i].p_client == NULL)
+        {
+            return NRF_ERROR_NULL;
+        }
+
+        for (uint32_t j = 0; j < i; j++)
+        {
+            if (p_poll->p_contexts[j].p_client == p_poll->p_contexts[i].p_client)
+            {
+                return NRF_ERROR_INVALID_PARAM;
+            }
+        }
+        p_poll->p_contexts[i].server_index = SERVER_INDEX_NONE;
+    }
+
+    for (uint32_t i = 0; i < p_poll->server_count; i++)
+    {
+        sensor_poll_server_t * p_server = &p_poll->p_servers[i];
+        nrf_mesh_address_t address;
+
+        if (p_server->p_property_ids == NULL && p_server->property_count > 0)
+        {
+            return NRF_ERROR_NULL;
+        }
+
+        if (dsm_address_get(p_server->address_handle, &address) != NRF_SUCCESS ||
+            address.type != NRF_MESH_ADDRESS_TYPE_UNICAST)
+        {
+            return NRF_ERROR_INVALID_ADDR;
+        }
+        p_server->address = address.value;
+        p_server->attempts = 0;
+    }
+
+    p_poll->next_server = 0;
+    p_poll->done_count = 0;
+    p_poll->failed_count = 0;
+    p_poll->active = false;
+    return NRF_SUCCESS;
+}
+
+uint32_t sensor_poll_cycle_start(sensor_poll_t * p_poll)
+{
+    if (p_poll == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (p_poll->active)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    p_poll->next_server = 0;
+    p_poll->done_count = 0;
+    p_poll->failed_count = 0;
+    p_poll->active = true;
+
+    for (uint32_t i = 0; i < p_poll->context_count; i++)
+    {
+        context_dispatch(p_poll, &p_poll->p_contexts[i]);
+    }
+
+    cycle_end_check(p_poll);
+    return NRF_SUCCESS;
+}
+
+void sensor_poll_stop(sensor_poll_t * p_poll)
+{
+    NRF_MESH_ASSERT(p_poll != NULL);
+
+    /* Cleared first, so the cancelled transactions don't dispatch new requests. */
+    p_poll->active = false;
+
+    for (uint32_t i = 0; i < p_poll->context_count; i++)
+    {
+        if (p_poll->p_contexts[i].server_index != SERVER_INDEX_NONE)
+        {
+            p_poll->p_contexts[i].server_index = SERVER_INDEX_NONE;
+            (void) access_model_reliable_cancel(p_poll->p_contexts[i].p_client->model_handle);
+            (void) access_model_publish_address_override_set(p_poll->p_contexts[i].p_client->model_handle,
+                                                             DSM_HANDLE_INVALID);
+        }
+    }
+}
+
+bool sensor_poll_status_handle(sensor_poll_t * p_poll,
+                               const sensor_client_t * p_client,
+                               const access_message_rx_meta_t * p_meta,
+                               const sensor_status_msg_pkt_t * p_in,
+                               uint16_t length)
+{
+    NRF_MESH_ASSERT(p_poll != NULL && p_client != NULL && p_meta != NULL);
+
+    sensor_poll_context_t * p_context = context_get(p_poll, p_client->model_handle);
+    if (p_context == NULL || p_context->server_index == SERVER_INDEX_NONE ||
+        p_poll->p_servers[p_context->server_index].address != p_meta->src.value)
+    {
+        return false;
+    }
+
+    /* The acknowledged transaction has already ended when the status is processed, see
+     * access_reliable_message_rx_cb(), so the context is free for the next request. */
+    uint16_t server_index = p_context->server_index;
+    sensor_poll_value_t values[SENSOR_POLL_VALUES_MAX];
+    uint8_t count = status_decode(&p_poll->p_servers[server_index], p_in, length, values);
+
+    server_done(p_poll, false);
+    context_dispatch(p_poll, p_context);
+
+    p_poll->status_cb(p_poll, server_index, values, count);
+    cycle_end_check(p_poll);
+    return true;
+}
+
+bool sensor_poll_transaction_handle(sensor_poll_t * p_poll,
+                                    access_model_handle_t model_handle,
+                                    access_reliable_status_t status)
+{
+    NRF_MESH_ASSERT(p_poll != NULL);
+
+    sensor_poll_context_t * p_context = context_get(p_poll, model_handle);
+    if (p_context == NULL)
+    {
+        return false;
+    }
+
+    if (p_context->server_index == SERVER_INDEX_NONE || status == ACCESS_RELIABLE_TRANSFER_SUCCESS)
+    {
+        /* Successful requests are completed by their status message. */
+        return true;
+    }
+
+    sensor_poll_server_t * p_server = &p_poll->p_servers[p_context->server_index];
+    if (status == ACCESS_RELIABLE_TRANSFER_TIMEOUT && p_server->attempts <= p_poll->retries &&
+        p_poll->active)
+    {
+        p_server->attempts++;
+        if (request_send(p_poll, p_context) == NRF_SUCCESS)
+        {
+            return true;
+        }
+    }
+
+    __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Sensor server 0x%04x didn't respond\n", p_server->address);
+    server_done(p_poll, true);
+    context_dispatch(p_poll, p_context);
+    cycle_end_check(p_poll);
+    return true;
+}
@@ -0,0 +1,324 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sensor_series.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "utils.h"
+
+/** Size of the property ID at the start of the column and series messages. */
+#define PROPERTY_ID_BYTES       (2)
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+
+static inline uint16_t column_bytes(const sensor_series_t * p_series)
+{
+    return SENSOR_SERIES_COLUMN_BYTES(p_series->x_bytes, p_series->y_bytes);
+}
+
+static inline uint16_t slot_get(const sensor_series_t * p_series, uint16_t index)
+{
+    uint32_t slot = (uint32_t) p_series->head + index;
+    return (slot >= p_series->capacity) ? slot - p_series->capacity : slot;
+}
+
+static inline uint8_t * column_get(const sensor_series_t * p_series, uint16_t index)
+{
+    return &p_series->p_buffer[slot_get(p_series, index) * column_bytes(p_series)];
+}
+
+/* Raw Value X as an unsigned key in the same order as the values. Signed values are biased by
+ * flipping their sign bit. */
+static inline uint32_t raw_x_get(const sensor_series_t * p_series, const uint8_t * p_raw_x)
+{
+    uint32_t raw_x = 0;
+    memcpy(&raw_x, p_raw_x, p_series->x_bytes);
+    if (p_series->x_signed)
+    {
+        raw_x ^= 1ul << (8 * p_series->x_bytes - 1);
+    }
+    return raw_x;
+}
+
+/* Index of the first column with a Raw Value X not below raw_x. */
+static uint16_t lower_bound(const sensor_series_t * p_series, uint32_t raw_x)
+{
+    uint16_t low = 0;
+    uint16_t high = p_series->count;
+
+    while (low < high)
+    {
+        uint16_t middle = low + (high - low) / 2;
+        if (raw_x_get(p_series, column_get(p_series, middle)) < raw_x)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void column_write(const sensor_series_t * p_series,
+                         uint8_t * p_column,
+                         const uint8_t * p_raw_x,
+                         const uint8_t * p_width,
+                         const uint8_t * p_raw_y)
+{
+    memcpy(&p_column[0], p_raw_x, p_series->x_bytes);
+    memcpy(&p_column[p_series->x_bytes], p_width, p_series->x_bytes);
+    memcpy(&p_column[2 * p_series->x_bytes], p_raw_y, p_series->y_bytes);
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+
+uint32_t sensor_series_init(sensor_series_t * p_series,
+                            uint16_t property_id,
+                            uint8_t x_bytes,
+                            bool x_signed,
+                            uint8_t y_bytes,
+                            uint8_t * p_buffer,
+                            uint32_t buffer_bytes)
+{
+    if (p_series == NULL || p_buffer == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    /* 0 is a prohibited sensor property id value, see @tagMeshMdlSp 4.1.1.1 Sensor Property ID. */
+    if (property_id == 0 ||
+        x_bytes == 0 || x_bytes > SENSOR_SERIES_X_BYTES_MAX ||
+        y_bytes == 0 || y_bytes > SENSOR_SERIES_Y_BYTES_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t capacity = buffer_bytes / SENSOR_SERIES_COLUMN_BYTES(x_bytes, y_bytes);
+    if (capacity == 0)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_series->property_id = property_id;
+    p_series->x_bytes = x_bytes;
+    p_series->x_signed = x_signed;
+    p_series->y_bytes = y_bytes;
+    p_series->p_buffer = p_buffer;
+    p_series->capacity = (capacity > UINT16_MAX) ? UINT16_MAX : capacity;
+    sensor_series_clear(p_series);
+    return NRF_SUCCESS;
+}
+
+void sensor_series_clear(sensor_series_t * p_series)
+{
+    NRF_MESH_ASSERT(p_series != NULL);
+    p_series->head = 0;
+    p_series->count = 0;
+}
+
+uint32_t sensor_series_column_set(sensor_series_t * p_series,
+                                  const uint8_t * p_raw_x,
+                                  const uint8_t * p_width,
+                                  const uint8_t * p_raw_y)
+{
+    if (p_series == NULL || p_raw_x == NULL || p_width == NULL || p_raw_y == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    uint32_t raw_x = raw_x_get(p_series, p_raw_x);
+    uint16_t index;
+
+    if (p_series->count == 0 || raw_x > raw_x_get(p_series, column_get(p_series, p_series->count - 1)))
+    {
+        /* Appending is the common case for logged data. */
+        index = p_series->count;
+    }
+    else
+    {
+        index = lower_bound(p_series, raw_x);
+        if (raw_x_get(p_series, column_get(p_series, index)) == raw_x)
+        {
+            column_write(p_series, column_get(p_series, index), p_raw_x, p_width, p_raw_y);
+            return NRF_SUCCESS;
+        }
+    }
+
+    if (p_series->count == p_series->capacity)
+    {
+        if (index == 0)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+
+        /* Drop the lowest column. */
+        p_series->head = slot_get(p_series, 1);
+        p_series->count--;
+        index--;
+    }
+
+    /* Make room by moving the columns above the new one one step up. */
+    for (uint16_t i = p_series->count; i > index; i--)
+    {
+        memcpy(column_get(p_series, i), column_get(p_series, i - 1), column_bytes(p_series));
+    }
+
+    column_write(p_series, column_get(p_series, index), p_raw_x, p_width, p_raw_y);
+    p_series->count++;
+    return NRF_SUCCESS;
+}
+
+uint32_t sensor_series_column_query(const sensor_series_t * p_series,
+                                    const uint8_t * p_params,
+                                    uint16_t length,
+                                    sensor_series_query_t * p_query)
+{
+    if (p_series == NULL || p_params == NULL || p_query == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (length != PROPERTY_ID_BYTES + p_series->x_bytes)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    uint16_t property_id;
+    memcpy(&property_id, p_params, sizeof(property_id));
+    if (property_id != p_series->property_id)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    const uint8_t * p_raw_x = &p_params[PROPERTY_ID_BYTES];
+    uint32_t raw_x = raw_x_get(p_series, p_raw_x);
+
+    p_query->is_column = true;
+    memcpy(p_query->raw_x, p_raw_x, p_series->x_bytes);
+    p_query->first = lower_bound(p_series, raw_x);
+    p_query->count = (p_query->first < p_series->count &&
+                      raw_x_get(p_series, column_get(p_series, p_query->first)) == raw_x) ? 1 : 0;
+
+    /* @tagMeshMdlSp section 4.2.16: Only the Raw Value X is included for a column that doesn't
+     * exist. */
+    p_query->bytes = PROPERTY_ID_BYTES +
+                     (p_query->count ? column_bytes(p_series) : p_series->x_bytes);
+    return NRF_SUCCESS;
+}
+
+uint32_t sensor_series_range_query(const sensor_series_t * p_series,
+                                   const uint8_t * p_params,
+                                   uint16_t length,
+                                   uint16_t bytes_max,
+                                   sensor_series_query_t * p_query)
+{
+    if (p_series == NULL || p_params == NULL || p_query == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if ((length != PROPERTY_ID_BYTES && length != PROPERTY_ID_BYTES + 2 * p_series->x_bytes) ||
+        bytes_max < PROPERTY_ID_BYTES)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    uint16_t property_id;
+    memcpy(&property_id, p_params, sizeof(property_id));
+    if (property_id != p_series->property_id)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    uint16_t first = 0;
+    uint16_t end = p_series->count;
+    if (length > PROPERTY_ID_BYTES)
+    {
+        uint32_t raw_x1 = raw_x_get(p_series, &p_params[PROPERTY_ID_BYTES]);
+        uint32_t raw_x2 = raw_x_get(p_series, &p_params[PROPERTY_ID_BYTES + p_series->x_bytes]);
+
+        first = lower_bound(p_series, raw_x1);
+        end = (raw_x2 < raw_x1) ? first
+            : (raw_x2 == UINT32_MAX) ? p_series->count
+            : lower_bound(p_series, raw_x2 + 1);
+    }
+
+    uint16_t count_max = (bytes_max - PROPERTY_ID_BYTES) / column_bytes(p_series);
+
+    p_query->is_column = false;
+    p_query->first = first;
+    p_query->count = MIN(end - first, count_max);
+    p_query->bytes = PROPERTY_ID_BYTES + p_query->count * column_bytes(p_series);
+    return NRF_SUCCESS;
+}
+
+void sensor_series_status_serialize(const sensor_series_t * p_series,
+                                    const sensor_series_query_t * p_query,
+                                    uint8_t * p_out)
+{
+    NRF_MESH_ASSERT(p_series != NULL && p_query != NULL && p_out != NULL);
+    NRF_MESH_ASSERT(p_query->first + p_query->count <= p_series->count);
+
+    memcpy(p_out, &p_series->property_id, PROPERTY_ID_BYTES);
+    p_out += PROPERTY_ID_BYTES;
+
+    if (p_query->is_column && p_query->count == 0)
+    {
+        memcpy(p_out, p_query->raw_x, p_series->x_bytes);
+        return;
+    }
+
+    /* The selected columns are contiguous in the ring, except where it wraps. */
+    uint16_t first_slot = slot_get(p_series, p_query->first);
+    uint16_t count_before_wrap = MIN(p_query->count, p_series->capacity - first_slot);
+    uint16_t bytes_before_wrap = count_before_wrap * column_bytes(p_series);
+
+    memcpy(p_out, &p_series->p_buffer[first_slot * column_bytes(p_series)], bytes_before_wrap);
+    memcpy(&p_out[bytes_before_wrap],
+           &p_series->p_buffer[0],
+           (p_query->count - count_before_wrap) * column_bytes(p_series));
+}
@@ -47,6 +47,7 @@
 #include "sensor_common.h"
 #include "sensor_utils.h"
 #include "sensor_messages.h"
+#include "sensor_series.h"
 
 #include "mesh_mem.h"
 
@@ -57,6 +58,8 @@
 #include "nrf_mesh_utils.h"
 #include "nordic_common.h"
 
+/** Largest Sensor Series Status parameters, after the one byte opcode. */
+#define SERIES_STATUS_PARAMS_BYTES_MAX  (ACCESS_MESSAGE_LENGTH_MAX - 1)
 
 static uint32_t server_publish(const sensor_server_t * p_server,
                                const sensor_status_msg_pkt_t * p_status_message,
@@ -94,6 +97,46 @@ static uint32_t server_respond(sensor_server_t * p_server,
 }
 
 
+static const sensor_series_t * series_get(const sensor_setup_server_t * p_s_server, uint16_t property_id)
+{
+    for (uint32_t i = 0; i < p_s_server->settings.series_count; i++)
+    {
+        if (p_s_server->settings.p_series[i].property_id == property_id)
+        {
+            return &p_s_server->settings.p_series[i];
+        }
+    }
+    return NULL;
+}
+
+/* Serializes the status straight into the reserved reply, see @ref model_tx_reserve. */
+static uint32_t series_respond(sensor_server_t * p_server,
+                               const access_message_rx_t * p_access_message,
+                               const sensor_series_t * p_series,
+                               const sensor_series_query_t * p_query,
+                               sensor_opcode_t status_opcode)
+{
+    access_message_tx_t reply =
+    {
+        .opcode = ACCESS_OPCODE_SIG(status_opcode),
+        .p_buffer = NULL,
+        .length = p_query->bytes,
+        .force_segmented = p_server->settings.force_segmented,
+        .transmic_size = p_server->settings.transmic_size
+    };
+    uint8_t * p_buffer;
+
+    uint32_t status = model_tx_reserve(p_server->model_handle, p_access_message, &reply, &p_buffer);
+    if (status != NRF_SUCCESS)
+    {
+        return status;
+    }
+
+    sensor_series_status_serialize(p_series, p_query, p_buffer);
+    return access_model_tx_commit(p_server->model_handle);
+}
+
+
 static uint32_t setup_server_publish(const sensor_setup_server_t * p_s_server,
                                      const uint8_t * p_message,
                                      uint16_t bytes,
@@ -274,6 +317,22 @@ static void handle_column_get(access_model_handle_t model_handle,
         return;
     }
 
+    const sensor_series_t * p_series = series_get(p_s_server, p_in->property_id);
+    if (p_series != NULL)
+    {
+        sensor_series_query_t query;
+        if (NRF_SUCCESS == sensor_series_column_query(p_series, p_rx_msg->p_data, p_rx_msg->length, &query))
+        {
+            (void) series_respond(p_server, p_rx_msg, p_series, &query, SENSOR_OPCODE_COLUMN_STATUS);
+        }
+        return;
+    }
+
+    if (p_s_server->settings.p_callbacks->sensor_cbs.column_get_cb == NULL)
+    {
+        return;
+    }
+
     p_s_server->settings.p_callbacks->sensor_cbs.column_get_cb(p_s_server,
                                                                &p_rx_msg->meta_data,
                                                                p_in,
@@ -312,6 +371,26 @@ static void handle_series_get(access_model_handle_t model_handle,
         return;
     }
 
+    const sensor_series_t * p_series = series_get(p_s_server, p_in->property_id);
+    if (p_series != NULL)
+    {
+        sensor_series_query_t query;
+        if (NRF_SUCCESS == sensor_series_range_query(p_series,
+                                                     p_rx_msg->p_data,
+                                                     p_rx_msg->length,
+                                                     SERIES_STATUS_PARAMS_BYTES_MAX,
+                                                     &query))
+        {
+            (void) series_respond(p_server, p_rx_msg, p_series, &query, SENSOR_OPCODE_SERIES_STATUS);
+        }
+        return;
+    }
+
+    if (p_s_server->settings.p_callbacks->sensor_cbs.series_get_cb == NULL)
+    {
+        return;
+    }
+
     p_s_server->settings.p_callbacks->sensor_cbs.series_get_cb(p_s_server,
                                                                &p_rx_msg->meta_data,
                                                                p_in,
@@ -604,8 +683,10 @@ uint32_t sensor_setup_server_init(sensor_setup_server_t * p_server, uint16_t ele
        && p_server->settings.p_callbacks
        && p_server->settings.p_callbacks->sensor_cbs.descriptor_get_cb
        && p_server->settings.p_callbacks->sensor_cbs.get_cb
-       && p_server->settings.p_callbacks->sensor_cbs.column_get_cb
-       && p_server->settings.p_callbacks->sensor_cbs.series_get_cb
+       && (p_server->settings.p_series || p_server->settings.series_count == 0)
+       && ((p_server->settings.p_callbacks->sensor_cbs.column_get_cb
+            && p_server->settings.p_callbacks->sensor_cbs.series_get_cb)
+           || p_server->settings.series_count > 0)
        && p_server->settings.p_callbacks->sensor_cbs.cadence_get_cb
        && p_server->settings.p_callbacks->sensor_cbs.cadence_set_cb
        && p_server->settings.p_callbacks->sensor_cbs.settings_get_cb
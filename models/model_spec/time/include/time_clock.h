@@ -0,0 +1,142 @@
+/* (C) 2024, Alexander Ozumenko
+ */
+
+#ifndef TIME_CLOCK_H__
+#define TIME_CLOCK_H__
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timer.h"
+#include "time_common.h"
+
+
+
+/* crystal tolerance assumed until the clock drift has been measured, in ppm */
+#ifndef TIME_CLOCK_DRIFT_PPM_MAX
+#define TIME_CLOCK_DRIFT_PPM_MAX            (50)
+#endif
+
+/* lowest tolerance of the drift compensated clock, covering oscillator wander, in ppm */
+#ifndef TIME_CLOCK_RESIDUAL_DRIFT_PPM
+#define TIME_CLOCK_RESIDUAL_DRIFT_PPM       (5)
+#endif
+
+/* stamp-to-air latency of outgoing Time Status messages assumed before the first TX complete
+ * timestamp, and its deviation, in microseconds */
+#ifndef TIME_CLOCK_TX_LATENCY_INITIAL_US
+#define TIME_CLOCK_TX_LATENCY_INITIAL_US    (10000)
+#endif
+
+#ifndef TIME_CLOCK_TX_JITTER_INITIAL_US
+#define TIME_CLOCK_TX_JITTER_INITIAL_US     (20000)
+#endif
+
+/* weight of a new TX latency measurement, as a right shift */
+#ifndef TIME_CLOCK_TX_LATENCY_FILTER_SHIFT
+#define TIME_CLOCK_TX_LATENCY_FILTER_SHIFT  (3)
+#endif
+
+/* decay of the TX latency deviation peak per message, as a right shift */
+#ifndef TIME_CLOCK_TX_JITTER_DECAY_SHIFT
+#define TIME_CLOCK_TX_JITTER_DECAY_SHIFT    (5)
+#endif
+
+/* uncertainty added per hop for the timestamp capture on both ends and the channel spread of
+ * an advertising event, in microseconds */
+#ifndef TIME_CLOCK_HOP_UNCERTAINTY_US
+#define TIME_CLOCK_HOP_UNCERTAINTY_US       (500)
+#endif
+
+/* Time state resolution */
+#define TIME_CLOCK_SUBSECONDS_PER_SECOND    (256)
+#define TIME_CLOCK_UNCERTAINTY_STEP_US      (10000)
+#define TIME_CLOCK_UNCERTAINTY_MAX          (UINT8_MAX)
+
+
+
+/* Local clock keeping TAI time between Time Status messages.
+ *
+ * The clock runs on the timer_now() timebase, extended to 64 bits. Every accepted time update
+ * anchors the clock at the local timestamp the time was valid at; the TAI time at any later local
+ * timestamp is extrapolated from the anchor and corrected by the measured drift of the local
+ * oscillator. The drift is measured against the first update after the clock was set, and its
+ * tolerance is the sum of both update uncertainties over the measured interval, so the estimate
+ * improves for as long as the clock keeps receiving updates. The uncertainty grows from the anchor
+ * uncertainty at the crystal tolerance until the drift estimate is better than that.
+ *
+ * Time Status messages are stamped for the moment they go on air: the sender schedules the message
+ * so that its expected TX time lands on a subsecond boundary, and learns the stamp-to-air latency
+ * from the TX complete timestamps. The receiver takes the scanner timestamp of the packet as the
+ * local time the message time was valid at. */
+typedef struct
+{
+    /* extended local time at local_timestamp */
+    uint64_t local_us;
+    timestamp_t local_timestamp;
+
+    /* local and TAI time of the last accepted update */
+    uint64_t anchor_local_us;
+    uint64_t anchor_tai_us;
+    uint32_t anchor_uncertainty_us;
+
+    /* start of the drift measurement */
+    uint64_t drift_local_us;
+    uint64_t drift_tai_us;
+    uint32_t drift_uncertainty_us;
+
+    /* local oscillator drift in parts per billion, positive if the local clock runs fast,
+     * and the tolerance of the estimate */
+    int32_t drift_ppb;
+    uint32_t drift_tolerance_ppb;
+
+    bool is_set;
+
+    /* stamp-to-air latency of outgoing Time Status messages and its deviation */
+    uint32_t tx_latency_us;
+    uint32_t tx_jitter_us;
+} time_clock_t;
+
+
+
+/* initializes the clock as not set */
+void time_clock_init(time_clock_t *p_clock, timestamp_t now);
+
+/* extends the local timebase, must be called at least once every half timer_now() wrap */
+void time_clock_update(time_clock_t *p_clock, timestamp_t now);
+
+/* checks if the clock has been set */
+bool time_clock_is_set(const time_clock_t *p_clock);
+
+/* sets the clock unconditionally, as done by the Time Set message */
+void time_clock_set(time_clock_t *p_clock, timestamp_t at, uint64_t tai_us, uint32_t uncertainty_us);
+
+/* updates the clock with a time valid at the given local timestamp, if the time is more
+ * certain than the local clock, returns true if the time was accepted */
+bool time_clock_sync(time_clock_t *p_clock, timestamp_t at, uint64_t tai_us, uint32_t uncertainty_us);
+
+/* gets the TAI time and its uncertainty at the given local timestamp,
+ * returns NRF_ERROR_INVALID_STATE if the clock is not set */
+uint32_t time_clock_get(const time_clock_t *p_clock, timestamp_t at,
+                        uint64_t *p_tai_us, uint32_t *p_uncertainty_us);
+
+/* gets the first local timestamp not earlier than now to stamp a Time Status message at, so that
+ * the message is expected on air at a subsecond boundary */
+timestamp_t time_clock_tx_stamp_time_get(const time_clock_t *p_clock, timestamp_t now);
+
+/* gets the expected on air timestamp of a message stamped at the given local timestamp */
+timestamp_t time_clock_tx_time_get(const time_clock_t *p_clock, timestamp_t stamp_time);
+
+/* feeds the actual on air timestamp of a message expected on air at expected_tx_time */
+void time_clock_tx_complete(time_clock_t *p_clock, timestamp_t expected_tx_time, timestamp_t tx_time);
+
+/* fills the TAI seconds, subsecond and uncertainty of a Time Status message going on air at the given
+ * local timestamp, returns NRF_ERROR_INVALID_STATE if the clock is not set */
+uint32_t time_clock_status_get(const time_clock_t *p_clock, timestamp_t tx_time, time_status_param_t *p_status);
+
+/* updates the clock with a received Time Status message, returns true if the time was accepted */
+bool time_clock_status_sync(time_clock_t *p_clock, timestamp_t rx_time, const time_status_param_t *p_status);
+
+
+
+#endif /* TIME_CLOCK_H__ */
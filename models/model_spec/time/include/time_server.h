@@ -0,0 +1,117 @@
+/* (C) 2024, Alexander Ozumenko
+ */
+
+#ifndef TIME_SERVER_H__
+#define TIME_SERVER_H__
+
+
+#include <stdint.h>
+#include "access.h"
+#include "timer_scheduler.h"
+#include "time_common.h"
+#include "time_clock.h"
+#include "model_common.h"
+
+
+
+/* server model IDs */
+#define TIME_SERVER_MODEL_ID        0x1200
+#define TIME_SETUP_SERVER_MODEL_ID  0x1201
+
+/* interval the local timebase is extended at, must be below half the timer_now() wrap */
+#ifndef TIME_SERVER_CLOCK_UPDATE_INTERVAL_US
+#define TIME_SERVER_CLOCK_UPDATE_INTERVAL_US    (60000000)
+#endif
+
+
+/* forward declaration */
+typedef struct time_server_s time_server_t;
+
+
+/* callback type for the Time state changes, called when the time has been set
+ * or updated from a received Time Status message */
+typedef void (*time_server_time_update_cb_t)(const time_server_t *p_self,
+                                             const time_status_param_t *p_time);
+
+/* callback type for the Time Role state changes */
+typedef void (*time_server_role_update_cb_t)(const time_server_t *p_self,
+                                             time_role_values_t time_role);
+
+
+
+typedef struct
+{
+    /* state change callbacks, may be NULL */
+    time_server_time_update_cb_t time_update_cb;
+    time_server_role_update_cb_t role_update_cb;
+} time_server_callbacks_t;
+
+
+
+/* user provided settings and callbacks for the model instance */
+typedef struct
+{
+    /* if server should force outgoing messages as segmented messages */
+    bool force_segmented;
+
+    /* transMIC size used by the outgoing server messages */
+    nrf_mesh_transmic_size_t transmic_size;
+
+    /* callback list */
+    const time_server_callbacks_t * p_callbacks;
+} time_server_settings_t;
+
+
+
+/* Time Server and Time Setup Server on one element.
+ *
+ * The time is kept by a drift compensating local clock. Time Status messages are stamped for the
+ * moment they go on air and received Time Status messages are applied at the scanner timestamp of
+ * the packet, see @ref time_clock_t. As a Time Relay or Time Client the server takes the time from
+ * Time Status messages sent with TTL 0 over the advertising bearer, when they are more certain than
+ * the local clock, and a Time Relay republishes the time right after accepting it. */
+struct time_server_s
+{
+    /* model handles assigned to this instance */
+    access_model_handle_t model_handle;
+    access_model_handle_t setup_model_handle;
+
+    /** model settings and callbacks for this instance */
+    time_server_settings_t settings;
+
+    /* Time state */
+    time_clock_t clock;
+    bool time_authority;
+    uint16_t tai_utc_delta;
+    uint8_t time_zone_offset;
+
+    /* Time Role state */
+    time_role_values_t time_role;
+
+    /* unsolicited Time Status scheduled to be stamped */
+    timer_event_t stamp_timer;
+    timer_event_t update_timer;
+
+    /* last stamped Time Status, waiting for its TX complete timestamp */
+    nrf_mesh_tx_token_t tx_token;
+    timestamp_t expected_tx_time;
+    bool tx_pending;
+
+    time_server_t *p_next;
+};
+
+
+
+
+/* initializes Time server and Time Setup server */
+uint32_t time_server_init(time_server_t *p_server, uint8_t element_index);
+
+/* gets the current Time state, TAI_seconds is 0 if the time is unknown */
+uint32_t time_server_time_get(time_server_t *p_server, time_status_param_t *p_time);
+
+/* publishes unsolicited Time Status at the next subsecond boundary */
+uint32_t time_server_status_publish(time_server_t *p_server);
+
+
+
+#endif /* TIME_SERVER_H__ */
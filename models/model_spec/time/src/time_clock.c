@@ -0,0 +1,258 @@
+/* (C) 2024, Alexander Ozumenko
+ */
+
+#include "time_clock.h"
+#include "time_common.h"
+
+#include <stddef.h>
+
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+
+
+
+
+#define US_PER_SECOND           (1000000ull)
+#define PPB_PER_UNIT            (1000000000ll)
+#define PPB_PER_PPM             (1000)
+
+
+
+/* local helpers */
+
+static uint64_t local_time_get(const time_clock_t *p_clock, timestamp_t at)
+{
+    /* timestamps within half a timer wrap before or after the last update */
+    return p_clock->local_us + (int64_t)(int32_t)(at - p_clock->local_timestamp);
+}
+
+
+static uint32_t tolerance_ppb_get(const time_clock_t *p_clock)
+{
+    if (p_clock->drift_tolerance_ppb < TIME_CLOCK_RESIDUAL_DRIFT_PPM * PPB_PER_PPM) {
+        return TIME_CLOCK_RESIDUAL_DRIFT_PPM * PPB_PER_PPM;
+    }
+    return p_clock->drift_tolerance_ppb;
+}
+
+
+static uint64_t tai_time_get(const time_clock_t *p_clock, uint64_t local_us)
+{
+    int64_t elapsed = (int64_t)(local_us - p_clock->anchor_local_us);
+    int64_t correction = elapsed * p_clock->drift_ppb / PPB_PER_UNIT;
+
+    return p_clock->anchor_tai_us + elapsed - correction;
+}
+
+
+static uint32_t uncertainty_get(const time_clock_t *p_clock, uint64_t local_us)
+{
+    int64_t elapsed = (int64_t)(local_us - p_clock->anchor_local_us);
+    if (elapsed < 0) {
+        elapsed = -elapsed;
+    }
+
+    uint64_t growth = ((uint64_t)elapsed * tolerance_ppb_get(p_clock) + PPB_PER_UNIT - 1) / PPB_PER_UNIT;
+    uint64_t uncertainty = p_clock->anchor_uncertainty_us + growth;
+
+    return (uncertainty > UINT32_MAX) ? UINT32_MAX : (uint32_t)uncertainty;
+}
+
+
+static void anchor_set(time_clock_t *p_clock, uint64_t local_us, uint64_t tai_us, uint32_t uncertainty_us)
+{
+    p_clock->anchor_local_us = local_us;
+    p_clock->anchor_tai_us = tai_us;
+    p_clock->anchor_uncertainty_us = uncertainty_us;
+    p_clock->is_set = true;
+}
+
+
+static void drift_measure(time_clock_t *p_clock, uint64_t local_us, uint64_t tai_us, uint32_t uncertainty_us)
+{
+    int64_t span = (int64_t)(local_us - p_clock->drift_local_us);
+    if (span <= 0) {
+        return;
+    }
+
+    /* both ends of the interval are known within their uncertainties */
+    uint64_t tolerance = ((uint64_t)p_clock->drift_uncertainty_us + uncertainty_us) * PPB_PER_UNIT / (uint64_t)span;
+    if (tolerance >= p_clock->drift_tolerance_ppb) {
+        return;
+    }
+
+    int64_t error = span - (int64_t)(tai_us - p_clock->drift_tai_us);
+    int64_t drift = error * PPB_PER_UNIT / span;
+
+    if (drift > TIME_CLOCK_DRIFT_PPM_MAX * PPB_PER_PPM || drift < -TIME_CLOCK_DRIFT_PPM_MAX * PPB_PER_PPM) {
+        /* outside of the crystal tolerance, the reference time must have jumped */
+        return;
+    }
+
+    p_clock->drift_ppb = (int32_t)drift;
+    p_clock->drift_tolerance_ppb = (uint32_t)tolerance;
+}
+
+
+static void drift_reset(time_clock_t *p_clock, uint64_t local_us, uint64_t tai_us, uint32_t uncertainty_us)
+{
+    p_clock->drift_local_us = local_us;
+    p_clock->drift_tai_us = tai_us;
+    p_clock->drift_uncertainty_us = uncertainty_us;
+}
+
+
+
+/* interface functions */
+
+void time_clock_init(time_clock_t *p_clock, timestamp_t now)
+{
+    NRF_MESH_ASSERT(p_clock != NULL);
+
+    p_clock->local_us = 0;
+    p_clock->local_timestamp = now;
+    p_clock->anchor_local_us = 0;
+    p_clock->anchor_tai_us = 0;
+    p_clock->anchor_uncertainty_us = 0;
+    p_clock->drift_ppb = 0;
+    p_clock->drift_tolerance_ppb = TIME_CLOCK_DRIFT_PPM_MAX * PPB_PER_PPM;
+    p_clock->is_set = false;
+    p_clock->tx_latency_us = TIME_CLOCK_TX_LATENCY_INITIAL_US;
+    p_clock->tx_jitter_us = TIME_CLOCK_TX_JITTER_INITIAL_US;
+    drift_reset(p_clock, 0, 0, 0);
+}
+
+
+void time_clock_update(time_clock_t *p_clock, timestamp_t now)
+{
+    p_clock->local_us += (timestamp_t)(now - p_clock->local_timestamp);
+    p_clock->local_timestamp = now;
+}
+
+
+bool time_clock_is_set(const time_clock_t *p_clock)
+{
+    return p_clock->is_set;
+}
+
+
+void time_clock_set(time_clock_t *p_clock, timestamp_t at, uint64_t tai_us, uint32_t uncertainty_us)
+{
+    uint64_t local_us = local_time_get(p_clock, at);
+
+    /* the drift estimate is kept, but a set time may not be continuous with the measured one */
+    anchor_set(p_clock, local_us, tai_us, uncertainty_us);
+    drift_reset(p_clock, local_us, tai_us, uncertainty_us);
+}
+
+
+bool time_clock_sync(time_clock_t *p_clock, timestamp_t at, uint64_t tai_us, uint32_t uncertainty_us)
+{
+    uint64_t local_us = local_time_get(p_clock, at);
+
+    if (!p_clock->is_set) {
+        drift_reset(p_clock, local_us, tai_us, uncertainty_us);
+    } else if (uncertainty_us >= uncertainty_get(p_clock, local_us)) {
+        return false;
+    } else {
+        drift_measure(p_clock, local_us, tai_us, uncertainty_us);
+    }
+
+    anchor_set(p_clock, local_us, tai_us, uncertainty_us);
+    return true;
+}
+
+
+uint32_t time_clock_get(const time_clock_t *p_clock, timestamp_t at,
+                        uint64_t *p_tai_us, uint32_t *p_uncertainty_us)
+{
+    if (!p_clock->is_set) {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    uint64_t local_us = local_time_get(p_clock, at);
+    *p_tai_us = tai_time_get(p_clock, local_us);
+    *p_uncertainty_us = uncertainty_get(p_clock, local_us);
+
+    return NRF_SUCCESS;
+}
+
+
+timestamp_t time_clock_tx_stamp_time_get(const time_clock_t *p_clock, timestamp_t now)
+{
+    if (!p_clock->is_set) {
+        return now;
+    }
+
+    uint64_t tai_us = tai_time_get(p_clock, local_time_get(p_clock, now) + p_clock->tx_latency_us);
+    uint64_t fraction_us = tai_us % US_PER_SECOND;
+
+    /* first subsecond boundary at or after the expected TX time, rounded up to the next microsecond
+     * so that it truncates to the boundary subsecond */
+    uint64_t subsecond = (fraction_us * TIME_CLOCK_SUBSECONDS_PER_SECOND + US_PER_SECOND - 1) / US_PER_SECOND;
+    uint64_t boundary_us = (subsecond * US_PER_SECOND + TIME_CLOCK_SUBSECONDS_PER_SECOND - 1) / TIME_CLOCK_SUBSECONDS_PER_SECOND;
+
+    /* the drift over less than one subsecond is far below a microsecond */
+    return now + (timestamp_t)(boundary_us - fraction_us);
+}
+
+
+timestamp_t time_clock_tx_time_get(const time_clock_t *p_clock, timestamp_t stamp_time)
+{
+    return stamp_time + p_clock->tx_latency_us;
+}
+
+
+void time_clock_tx_complete(time_clock_t *p_clock, timestamp_t expected_tx_time, timestamp_t tx_time)
+{
+    int32_t error = (int32_t)(tx_time - expected_tx_time);
+    uint32_t deviation = (error < 0) ? (uint32_t)-error : (uint32_t)error;
+    int32_t latency = (int32_t)p_clock->tx_latency_us + error / (1 << TIME_CLOCK_TX_LATENCY_FILTER_SHIFT);
+
+    p_clock->tx_latency_us = (latency < 0) ? 0 : (uint32_t)latency;
+
+    /* peak of the deviation, slowly forgetting old peaks */
+    p_clock->tx_jitter_us -= p_clock->tx_jitter_us >> TIME_CLOCK_TX_JITTER_DECAY_SHIFT;
+    if (deviation > p_clock->tx_jitter_us) {
+        p_clock->tx_jitter_us = deviation;
+    }
+}
+
+
+uint32_t time_clock_status_get(const time_clock_t *p_clock, timestamp_t tx_time, time_status_param_t *p_status)
+{
+    uint64_t tai_us;
+    uint32_t uncertainty_us;
+    uint32_t status = time_clock_get(p_clock, tx_time, &tai_us, &uncertainty_us);
+
+    if (status != NRF_SUCCESS) {
+        return status;
+    }
+
+    uint64_t fraction_us = tai_us % US_PER_SECOND;
+    uint64_t subsecond = fraction_us * TIME_CLOCK_SUBSECONDS_PER_SECOND / US_PER_SECOND;
+    uint64_t truncation_us = fraction_us - subsecond * US_PER_SECOND / TIME_CLOCK_SUBSECONDS_PER_SECOND;
+
+    uint64_t total_us = (uint64_t)uncertainty_us + truncation_us + p_clock->tx_jitter_us + TIME_CLOCK_HOP_UNCERTAINTY_US;
+    uint64_t uncertainty = (total_us + TIME_CLOCK_UNCERTAINTY_STEP_US - 1) / TIME_CLOCK_UNCERTAINTY_STEP_US;
+
+    p_status->TAI_seconds = tai_us / US_PER_SECOND;
+    p_status->subsecond = (uint8_t)subsecond;
+    p_status->uncertainty = (uncertainty > TIME_CLOCK_UNCERTAINTY_MAX) ? TIME_CLOCK_UNCERTAINTY_MAX : (uint8_t)uncertainty;
+
+    return NRF_SUCCESS;
+}
+
+
+bool time_clock_status_sync(time_clock_t *p_clock, timestamp_t rx_time, const time_status_param_t *p_status)
+{
+    if (p_status->TAI_seconds == 0 || p_status->uncertainty == TIME_CLOCK_UNCERTAINTY_MAX) {
+        /* unknown time, or saturated uncertainty */
+        return false;
+    }
+
+    uint64_t tai_us = p_status->TAI_seconds * US_PER_SECOND +
+                      (p_status->subsecond * US_PER_SECOND + TIME_CLOCK_SUBSECONDS_PER_SECOND / 2) / TIME_CLOCK_SUBSECONDS_PER_SECOND;
+
+    return time_clock_sync(p_clock, rx_time, tai_us, (uint32_t)p_status->uncertainty * TIME_CLOCK_UNCERTAINTY_STEP_US);
+}
@@ -0,0 +1,414 @@
+/* (C) 2024, Alexander Ozumenko
+ */
+
+#include "time_server.h"
+#include "time_common.h"
+#include "time_messages.h"
+#include "time_clock.h"
+
+#include "access.h"
+#include "access_config.h"
+#include "nrf_mesh_events.h"
+#include "timer.h"
+#include "timer_scheduler.h"
+
+#include "nrf5_sdk_log.h"
+
+
+
+
+static time_server_t *mp_servers;
+static nrf_mesh_evt_handler_t m_mesh_evt_handler;
+
+
+
+/* local helpers */
+
+static void time_status_pack(const time_status_param_t *p_in, time_status_msg_pkt_t *p_msg)
+{
+    for (uint32_t i = 0; i < sizeof(p_msg->TAI_seconds); i++) {
+        p_msg->TAI_seconds[i] = (uint8_t)(p_in->TAI_seconds >> (8 * i));
+    }
+    p_msg->subsecond = p_in->subsecond;
+    p_msg->uncertainty = p_in->uncertainty;
+    p_msg->time_authority = p_in->time_authority ? 1 : 0;
+    p_msg->tai_utc_delta = p_in->tai_utc_delta;
+    p_msg->time_zone_offset = p_in->time_zone_offset;
+}
+
+
+static void time_status_unpack(const time_status_msg_pkt_t *p_msg, time_status_param_t *p_out)
+{
+    p_out->TAI_seconds = 0;
+    for (uint32_t i = 0; i < sizeof(p_msg->TAI_seconds); i++) {
+        p_out->TAI_seconds |= (uint64_t)p_msg->TAI_seconds[i] << (8 * i);
+    }
+    p_out->subsecond = p_msg->subsecond;
+    p_out->uncertainty = p_msg->uncertainty;
+    p_out->time_authority = p_msg->time_authority != 0;
+    p_out->tai_utc_delta = p_msg->tai_utc_delta;
+    p_out->time_zone_offset = p_msg->time_zone_offset;
+}
+
+
+/* fills the Time state of a message going on air at tx_time */
+static void time_status_fill(const time_server_t *p_server, timestamp_t tx_time, time_status_param_t *p_status)
+{
+    if (time_clock_status_get(&p_server->clock, tx_time, p_status) != NRF_SUCCESS) {
+        /* unknown time */
+        p_status->TAI_seconds = 0;
+        p_status->subsecond = 0;
+        p_status->uncertainty = 0;
+    }
+    p_status->time_authority = p_server->time_authority;
+    p_status->tai_utc_delta = p_server->tai_utc_delta;
+    p_status->time_zone_offset = p_server->time_zone_offset;
+}
+
+
+static void message_create(time_server_t *p_server, uint16_t tx_opcode,
+                           const uint8_t *p_buffer, uint16_t length,
+                           access_message_tx_t *p_message)
+{
+    p_message->opcode.opcode = tx_opcode;
+    p_message->opcode.company_id = ACCESS_COMPANY_ID_NONE;
+    p_message->p_buffer = p_buffer;
+    p_message->length = length;
+    p_message->force_segmented = p_server->settings.force_segmented;
+    p_message->transmic_size = p_server->settings.transmic_size;
+    p_message->access_token = nrf_mesh_unique_token_get();
+}
+
+
+/* sends Time Status stamped for the expected TX time of a message stamped now */
+static uint32_t time_status_send(time_server_t *p_server, const access_message_rx_t *p_rx_msg)
+{
+    time_status_param_t status;
+    time_status_msg_pkt_t msg_pkt;
+    access_message_tx_t reply;
+    timestamp_t now = timer_now();
+
+    time_clock_update(&p_server->clock, now);
+
+    timestamp_t tx_time = time_clock_tx_time_get(&p_server->clock, now);
+    time_status_fill(p_server, tx_time, &status);
+    time_status_pack(&status, &msg_pkt);
+    message_create(p_server, TIME_OPCODE_TIME_STATUS, (const uint8_t *)&msg_pkt, sizeof(msg_pkt), &reply);
+
+    uint32_t ret;
+    if (p_rx_msg != NULL) {
+        ret = access_model_reply(p_server->model_handle, p_rx_msg, &reply);
+    } else {
+        /* unsolicited Time Status is only valid for the receivers in direct radio range */
+        ret = access_model_publish_with_ttl(p_server->model_handle, &reply, 0);
+    }
+
+    if (ret == NRF_SUCCESS && status.TAI_seconds != 0) {
+        p_server->tx_token = reply.access_token;
+        p_server->expected_tx_time = tx_time;
+        p_server->tx_pending = true;
+    }
+
+    return ret;
+}
+
+
+static void time_update_notify(time_server_t *p_server)
+{
+    if (p_server->settings.p_callbacks != NULL &&
+        p_server->settings.p_callbacks->time_update_cb != NULL) {
+        time_status_param_t status;
+        time_status_fill(p_server, timer_now(), &status);
+        p_server->settings.p_callbacks->time_update_cb(p_server, &status);
+    }
+}
+
+
+static bool rx_timestamp_get(const access_message_rx_meta_t *p_meta, timestamp_t *p_timestamp)
+{
+    if (p_meta->ttl != 0 || p_meta->p_core_metadata == NULL) {
+        /* relayed messages are stamped for another hop */
+        return false;
+    }
+
+    switch (p_meta->p_core_metadata->source) {
+        case NRF_MESH_RX_SOURCE_SCANNER:
+            *p_timestamp = p_meta->p_core_metadata->params.scanner.timestamp;
+            return true;
+        case NRF_MESH_RX_SOURCE_INSTABURST:
+            *p_timestamp = p_meta->p_core_metadata->params.instaburst.timestamp;
+            return true;
+        default:
+            /* GATT and loopback timestamps are taken long after the time was stamped */
+            return false;
+    }
+}
+
+
+static void stamp_timer_cb(timestamp_t timestamp, void *p_context)
+{
+    time_server_t *p_server = (time_server_t *)p_context;
+
+    if (time_status_send(p_server, NULL) != NRF_SUCCESS) {
+        __LOG(LOG_SRC_APP, LOG_LEVEL_WARN, "Time Status publish failed\n");
+    }
+}
+
+
+static void update_timer_cb(timestamp_t timestamp, void *p_context)
+{
+    time_server_t *p_server = (time_server_t *)p_context;
+
+    time_clock_update(&p_server->clock, timer_now());
+}
+
+
+static void mesh_evt_cb(const nrf_mesh_evt_t *p_evt)
+{
+    if (p_evt->type != NRF_MESH_EVT_TX_COMPLETE) {
+        return;
+    }
+
+    for (time_server_t *p_server = mp_servers; p_server != NULL; p_server = p_server->p_next) {
+        if (p_server->tx_pending && p_server->tx_token == p_evt->params.tx_complete.token) {
+            time_clock_tx_complete(&p_server->clock, p_server->expected_tx_time,
+                                   p_evt->params.tx_complete.timestamp);
+            p_server->tx_pending = false;
+        }
+    }
+}
+
+
+
+/* opcode Handlers */
+
+static void time_get_handle(access_model_handle_t handle, const access_message_rx_t *p_rx_msg, void *p_args)
+{
+    time_server_t *p_server = (time_server_t *)p_args;
+
+    if (p_rx_msg->length == 0) {
+        (void)time_status_send(p_server, p_rx_msg);
+    }
+}
+
+
+static void time_status_handle(access_model_handle_t handle, const access_message_rx_t *p_rx_msg, void *p_args)
+{
+    time_server_t *p_server = (time_server_t *)p_args;
+    time_status_param_t in_data;
+    timestamp_t rx_time;
+
+    if (p_rx_msg->length != sizeof(time_status_msg_pkt_t) ||
+        (p_server->time_role != TIME_ROLE_MESH_TIME_RELAY && p_server->time_role != TIME_ROLE_TIME_TIME_CLIENT) ||
+        !rx_timestamp_get(&p_rx_msg->meta_data, &rx_time)) {
+        return;
+    }
+
+    time_status_unpack((const time_status_msg_pkt_t *)p_rx_msg->p_data, &in_data);
+
+    time_clock_update(&p_server->clock, timer_now());
+    if (!time_clock_status_sync(&p_server->clock, rx_time, &in_data)) {
+        return;
+    }
+
+    p_server->time_authority = in_data.time_authority;
+    p_server->tai_utc_delta = in_data.tai_utc_delta;
+    p_server->time_zone_offset = in_data.time_zone_offset;
+    time_update_notify(p_server);
+
+    if (p_server->time_role == TIME_ROLE_MESH_TIME_RELAY) {
+        (void)time_server_status_publish(p_server);
+    }
+}
+
+
+static void time_set_handle(access_model_handle_t handle, const access_message_rx_t *p_rx_msg, void *p_args)
+{
+    time_server_t *p_server = (time_server_t *)p_args;
+    time_status_param_t in_data;
+
+    if (p_rx_msg->length != sizeof(time_set_msg_pkt_t)) {
+        return;
+    }
+
+    time_status_unpack((const time_status_msg_pkt_t *)p_rx_msg->p_data, &in_data);
+
+    timestamp_t now = timer_now();
+    time_clock_update(&p_server->clock, now);
+    if (in_data.TAI_seconds != 0) {
+        uint64_t tai_us = in_data.TAI_seconds * 1000000ull +
+                          in_data.subsecond * 1000000ull / TIME_CLOCK_SUBSECONDS_PER_SECOND;
+        time_clock_set(&p_server->clock, now, tai_us, (uint32_t)in_data.uncertainty * TIME_CLOCK_UNCERTAINTY_STEP_US);
+    }
+    p_server->time_authority = in_data.time_authority;
+    p_server->tai_utc_delta = in_data.tai_utc_delta;
+    p_server->time_zone_offset = in_data.time_zone_offset;
+    time_update_notify(p_server);
+
+    (void)time_status_send(p_server, p_rx_msg);
+}
+
+
+static void time_role_status_send(time_server_t *p_server, const access_message_rx_t *p_rx_msg)
+{
+    time_role_status_msg_pkt_t msg_pkt = {.time_role = p_server->time_role};
+    access_message_tx_t reply;
+
+    message_create(p_server, TIME_OPCODE_TIME_ROLE_STATUS, (const uint8_t *)&msg_pkt, sizeof(msg_pkt), &reply);
+    (void)access_model_reply(p_server->setup_model_handle, p_rx_msg, &reply);
+}
+
+
+static void time_role_get_handle(access_model_handle_t handle, const access_message_rx_t *p_rx_msg, void *p_args)
+{
+    time_server_t *p_server = (time_server_t *)p_args;
+
+    if (p_rx_msg->length == 0) {
+        time_role_status_send(p_server, p_rx_msg);
+    }
+}
+
+
+static void time_role_set_handle(access_model_handle_t handle, const access_message_rx_t *p_rx_msg, void *p_args)
+{
+    time_server_t *p_server = (time_server_t *)p_args;
+
+    if (p_rx_msg->length != sizeof(time_role_set_msg_pkt_t)) {
+        return;
+    }
+
+    const time_role_set_msg_pkt_t *p_msg_params_packed = (const time_role_set_msg_pkt_t *)p_rx_msg->p_data;
+    if (p_msg_params_packed->time_role > TIME_ROLE_TIME_TIME_CLIENT) {
+        return;
+    }
+
+    p_server->time_role = (time_role_values_t)p_msg_params_packed->time_role;
+    if (p_server->settings.p_callbacks != NULL &&
+        p_server->settings.p_callbacks->role_update_cb != NULL) {
+        p_server->settings.p_callbacks->role_update_cb(p_server, p_server->time_role);
+    }
+
+    time_role_status_send(p_server, p_rx_msg);
+}
+
+
+static void periodic_publish_cb(access_model_handle_t handle, void *p_args)
+{
+    time_server_t *p_server = (time_server_t *)p_args;
+
+    if (p_server->time_role == TIME_ROLE_MESH_TIME_AUTHORITY ||
+        p_server->time_role == TIME_ROLE_MESH_TIME_RELAY) {
+        (void)time_server_status_publish(p_server);
+    }
+}
+
+
+static const access_opcode_handler_t m_opcode_handlers[] =
+{
+    {ACCESS_OPCODE_SIG(TIME_OPCODE_TIME_GET), time_get_handle},
+    {ACCESS_OPCODE_SIG(TIME_OPCODE_TIME_STATUS), time_status_handle},
+};
+
+
+static const access_opcode_handler_t m_setup_opcode_handlers[] =
+{
+    {ACCESS_OPCODE_SIG(TIME_OPCODE_TIME_SET), time_set_handle},
+    {ACCESS_OPCODE_SIG(TIME_OPCODE_TIME_ROLE_GET), time_role_get_handle},
+    {ACCESS_OPCODE_SIG(TIME_OPCODE_TIME_ROLE_SET), time_role_set_handle},
+};
+
+
+
+/* interface functions */
+
+uint32_t time_server_init(time_server_t *p_server, uint8_t element_index)
+{
+    if (p_server == NULL) {
+        return NRF_ERROR_NULL;
+    }
+
+    timestamp_t now = timer_now();
+
+    time_clock_init(&p_server->clock, now);
+    p_server->time_authority = false;
+    p_server->tai_utc_delta = 0;
+    p_server->time_zone_offset = 0;
+    p_server->time_role = TIME_ROLE_NONE;
+    p_server->tx_pending = false;
+
+    access_model_add_params_t add_params =
+    {
+        .model_id = ACCESS_MODEL_SIG(TIME_SERVER_MODEL_ID),
+        .element_index = element_index,
+        .p_opcode_handlers = m_opcode_handlers,
+        .opcode_count = ARRAY_SIZE(m_opcode_handlers),
+        .p_args = p_server,
+        .publish_timeout_cb = periodic_publish_cb
+    };
+
+    uint32_t status = access_model_add(&add_params, &p_server->model_handle);
+
+    if (status == NRF_SUCCESS) {
+        status = access_model_subscription_list_alloc(p_server->model_handle);
+    }
+
+    if (status == NRF_SUCCESS) {
+        add_params.model_id.model_id = TIME_SETUP_SERVER_MODEL_ID;
+        add_params.p_opcode_handlers = m_setup_opcode_handlers;
+        add_params.opcode_count = ARRAY_SIZE(m_setup_opcode_handlers);
+        add_params.publish_timeout_cb = NULL;
+        status = access_model_add(&add_params, &p_server->setup_model_handle);
+    }
+
+    if (status != NRF_SUCCESS) {
+        return status;
+    }
+
+    p_server->stamp_timer.cb = stamp_timer_cb;
+    p_server->stamp_timer.interval = 0;
+    p_server->stamp_timer.p_context = p_server;
+
+    p_server->update_timer.cb = update_timer_cb;
+    p_server->update_timer.interval = TIME_SERVER_CLOCK_UPDATE_INTERVAL_US;
+    p_server->update_timer.p_context = p_server;
+    timer_sch_reschedule(&p_server->update_timer, now + TIME_SERVER_CLOCK_UPDATE_INTERVAL_US);
+
+    if (mp_servers == NULL) {
+        m_mesh_evt_handler.evt_cb = mesh_evt_cb;
+        nrf_mesh_evt_handler_add(&m_mesh_evt_handler);
+    }
+    p_server->p_next = mp_servers;
+    mp_servers = p_server;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t time_server_time_get(time_server_t *p_server, time_status_param_t *p_time)
+{
+    if (p_server == NULL || p_time == NULL) {
+        return NRF_ERROR_NULL;
+    }
+
+    timestamp_t now = timer_now();
+    time_clock_update(&p_server->clock, now);
+    time_status_fill(p_server, now, p_time);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t time_server_status_publish(time_server_t *p_server)
+{
+    if (p_server == NULL) {
+        return NRF_ERROR_NULL;
+    }
+
+    if (!timer_sch_is_scheduled(&p_server->stamp_timer)) {
+        timestamp_t now = timer_now();
+        time_clock_update(&p_server->clock, now);
+        timer_sch_reschedule(&p_server->stamp_timer, time_clock_tx_stamp_time_get(&p_server->clock, now));
+    }
+
+    return NRF_SUCCESS;
+}
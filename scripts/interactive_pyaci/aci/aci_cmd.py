@@ -156,6 +156,50 @@ class HousekeepingDataClear(CommandPacket):
         super(HousekeepingDataClear, self).__init__(0x15, __data)
 
 
+class InternalEventsTraceRead(CommandPacket):
+    """Read the oldest internal event trace records, and start or stop recording them.
+
+    Parameters
+    ----------
+        enable : uint8_t
+            Set to 1 to keep recording trace records, or 0 to stop recording after this read.
+    """
+    def __init__(self, enable):
+        __data = bytearray()
+        __data += struct.pack("<B", enable)
+        super(InternalEventsTraceRead, self).__init__(0x16, __data)
+
+
+class MetricsCountersGet(CommandPacket):
+    """Get the packet pipeline counters, counting the packets processed and dropped at each stage
+    from the bearers to the access layer."""
+    def __init__(self):
+        __data = bytearray()
+        super(MetricsCountersGet, self).__init__(0x17, __data)
+
+
+class MetricsHistogramGet(CommandPacket):
+    """Get one of the packet pipeline latency histograms, with sample counts in log2 buckets of
+    microseconds.
+
+    Parameters
+    ----------
+        histogram : uint8_t
+            Histogram to get.
+    """
+    def __init__(self, histogram):
+        __data = bytearray()
+        __data += struct.pack("<B", histogram)
+        super(MetricsHistogramGet, self).__init__(0x18, __data)
+
+
+class MetricsClear(CommandPacket):
+    """Clear all packet pipeline counters and latency histograms."""
+    def __init__(self):
+        __data = bytearray()
+        super(MetricsClear, self).__init__(0x19, __data)
+
+
 class Application(CommandPacket):
     """Application-specific command.
 
@@ -969,6 +1013,73 @@ class NetStateGet(CommandPacket):
         super(NetStateGet, self).__init__(0xAF, __data)
 
 
+class AppkeyAddBatch(CommandPacket):
+    """Add several application keys to the device. Either all the keys are added, or none of
+    them.
+
+    Parameters
+    ----------
+        appkeys : list of (app_key_index, subnet_handle, key)
+            Appkeys to add, at most 12.
+    """
+    def __init__(self, appkeys):
+        __data = bytearray()
+        for app_key_index, subnet_handle, key in appkeys:
+            __data += struct.pack("<H", app_key_index)
+            __data += struct.pack("<H", subnet_handle)
+            __data += iterable_to_barray(key)
+        super(AppkeyAddBatch, self).__init__(0xB0, __data)
+
+
+class DevkeyAddBatch(CommandPacket):
+    """Add several device keys to the device. Either all the keys are added, or none of them.
+
+    Parameters
+    ----------
+        devkeys : list of (owner_addr, subnet_handle, key)
+            Devkeys to add, at most 12.
+    """
+    def __init__(self, devkeys):
+        __data = bytearray()
+        for owner_addr, subnet_handle, key in devkeys:
+            __data += struct.pack("<H", owner_addr)
+            __data += struct.pack("<H", subnet_handle)
+            __data += iterable_to_barray(key)
+        super(DevkeyAddBatch, self).__init__(0xB1, __data)
+
+
+class AddrSubscriptionAddBatch(CommandPacket):
+    """Add several addresses to the set of active address subscriptions. Either all the
+    addresses are added, or none of them.
+
+    Parameters
+    ----------
+        addresses : list of uint16_t
+            Addresses to add, at most 126.
+    """
+    def __init__(self, addresses):
+        __data = bytearray()
+        for address in addresses:
+            __data += struct.pack("<H", address)
+        super(AddrSubscriptionAddBatch, self).__init__(0xB2, __data)
+
+
+class AddrPublicationAddBatch(CommandPacket):
+    """Add several addresses to the set of publication addresses. Either all the addresses are
+    added, or none of them.
+
+    Parameters
+    ----------
+        addresses : list of uint16_t
+            Addresses to add, at most 126.
+    """
+    def __init__(self, addresses):
+        __data = bytearray()
+        for address in addresses:
+            __data += struct.pack("<H", address)
+        super(AddrPublicationAddBatch, self).__init__(0xB3, __data)
+
+
 class JumpToBootloader(CommandPacket):
     """Immediately jump to bootloader mode."""
     def __init__(self):
@@ -1383,6 +1494,40 @@ class ElemModelsGet(CommandPacket):
         super(ElemModelsGet, self).__init__(0xF4, __data)
 
 
+class ModelSubsAddBatch(CommandPacket):
+    """Add several subscription addresses to model instances. The pairs are applied in order,
+    and the command stops at the first pair that fails.
+
+    Parameters
+    ----------
+        handle_pairs : list of (model_handle, dsm_handle)
+            Model and address handles, at most 63.
+    """
+    def __init__(self, handle_pairs):
+        __data = bytearray()
+        for model_handle, dsm_handle in handle_pairs:
+            __data += struct.pack("<H", model_handle)
+            __data += struct.pack("<H", dsm_handle)
+        super(ModelSubsAddBatch, self).__init__(0xF5, __data)
+
+
+class ModelAppBindBatch(CommandPacket):
+    """Bind several application keys to model instances. The pairs are applied in order, and
+    the command stops at the first pair that fails.
+
+    Parameters
+    ----------
+        handle_pairs : list of (model_handle, dsm_handle)
+            Model and appkey handles, at most 63.
+    """
+    def __init__(self, handle_pairs):
+        __data = bytearray()
+        for model_handle, dsm_handle in handle_pairs:
+            __data += struct.pack("<H", model_handle)
+            __data += struct.pack("<H", dsm_handle)
+        super(ModelAppBindBatch, self).__init__(0xF6, __data)
+
+
 class ModelsGet(CommandPacket):
     """Get a list of all the models available on the device."""
     def __init__(self):
@@ -1467,6 +1612,36 @@ class HousekeepingDataGetRsp(ResponsePacket):
         super(HousekeepingDataGetRsp, self).__init__("HousekeepingDataGet", 0x14, __data)
 
 
+class InternalEventsTraceReadRsp(ResponsePacket):
+    """Response to a(n) InternalEventsTraceRead command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["timestamp_hz"], = struct.unpack("<I", raw_data[0:4])
+        __data["dropped_count"], = struct.unpack("<I", raw_data[4:8])
+        __data["records"] = raw_data[8:248]
+        super(InternalEventsTraceReadRsp, self).__init__("InternalEventsTraceRead", 0x16, __data)
+
+
+class MetricsCountersGetRsp(ResponsePacket):
+    """Response to a(n) MetricsCountersGet command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["counters"] = raw_data[0:76]
+        super(MetricsCountersGetRsp, self).__init__("MetricsCountersGet", 0x17, __data)
+
+
+class MetricsHistogramGetRsp(ResponsePacket):
+    """Response to a(n) MetricsHistogramGet command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["histogram"], = struct.unpack("<B", raw_data[0:1])
+        __data["count"], = struct.unpack("<I", raw_data[1:5])
+        __data["max_us"], = struct.unpack("<I", raw_data[5:9])
+        __data["sum_us"], = struct.unpack("<I", raw_data[9:13])
+        __data["buckets"] = raw_data[13:93]
+        super(MetricsHistogramGetRsp, self).__init__("MetricsHistogramGet", 0x18, __data)
+
+
 class AdvAddrGetRsp(ResponsePacket):
     """Response to a(n) AdvAddrGet command."""
     def __init__(self, raw_data):
@@ -1741,6 +1916,38 @@ class NetStateGetRsp(ResponsePacket):
         super(NetStateGetRsp, self).__init__("NetStateGet", 0xAF, __data)
 
 
+class AppkeyAddBatchRsp(ResponsePacket):
+    """Response to a(n) AppkeyAddBatch command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["handles"] = list(struct.unpack("<%dH" % (len(raw_data) // 2), raw_data))
+        super(AppkeyAddBatchRsp, self).__init__("AppkeyAddBatch", 0xB0, __data)
+
+
+class DevkeyAddBatchRsp(ResponsePacket):
+    """Response to a(n) DevkeyAddBatch command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["handles"] = list(struct.unpack("<%dH" % (len(raw_data) // 2), raw_data))
+        super(DevkeyAddBatchRsp, self).__init__("DevkeyAddBatch", 0xB1, __data)
+
+
+class AddrSubscriptionAddBatchRsp(ResponsePacket):
+    """Response to a(n) AddrSubscriptionAddBatch command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["handles"] = list(struct.unpack("<%dH" % (len(raw_data) // 2), raw_data))
+        super(AddrSubscriptionAddBatchRsp, self).__init__("AddrSubscriptionAddBatch", 0xB2, __data)
+
+
+class AddrPublicationAddBatchRsp(ResponsePacket):
+    """Response to a(n) AddrPublicationAddBatch command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["handles"] = list(struct.unpack("<%dH" % (len(raw_data) // 2), raw_data))
+        super(AddrPublicationAddBatchRsp, self).__init__("AddrPublicationAddBatch", 0xB3, __data)
+
+
 class BankInfoGetRsp(ResponsePacket):
     """Response to a(n) BankInfoGet command."""
     def __init__(self, raw_data):
@@ -1865,6 +2072,22 @@ class ElemModelsGetRsp(ResponsePacket):
         super(ElemModelsGetRsp, self).__init__("ElemModelsGet", 0xF4, __data)
 
 
+class ModelSubsAddBatchRsp(ResponsePacket):
+    """Response to a(n) ModelSubsAddBatch command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["count"], = struct.unpack("<B", raw_data[0:1])
+        super(ModelSubsAddBatchRsp, self).__init__("ModelSubsAddBatch", 0xF5, __data)
+
+
+class ModelAppBindBatchRsp(ResponsePacket):
+    """Response to a(n) ModelAppBindBatch command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["count"], = struct.unpack("<B", raw_data[0:1])
+        super(ModelAppBindBatchRsp, self).__init__("ModelAppBindBatch", 0xF6, __data)
+
+
 class ModelsGetRsp(ResponsePacket):
     """Response to a(n) ModelsGet command."""
     def __init__(self, raw_data):
@@ -1897,6 +2120,9 @@ RESPONSE_LUT = {
     0x0A: {"object": FwInfoGetRsp, "name": "FwInfoGet"},
     0x13: {"object": BeaconParamsGetRsp, "name": "BeaconParamsGet"},
     0x14: {"object": HousekeepingDataGetRsp, "name": "HousekeepingDataGet"},
+    0x16: {"object": InternalEventsTraceReadRsp, "name": "InternalEventsTraceRead"},
+    0x17: {"object": MetricsCountersGetRsp, "name": "MetricsCountersGet"},
+    0x18: {"object": MetricsHistogramGetRsp, "name": "MetricsHistogramGet"},
     0x41: {"object": AdvAddrGetRsp, "name": "AdvAddrGet"},
     0x45: {"object": TxPowerGetRsp, "name": "TxPowerGet"},
     0x54: {"object": UuidGetRsp, "name": "UuidGet"},
@@ -1930,6 +2156,10 @@ RESPONSE_LUT = {
     0xA6: {"object": AddrPublicationRemoveRsp, "name": "AddrPublicationRemove"},
     0xAB: {"object": PacketSendRsp, "name": "PacketSend"},
     0xAF: {"object": NetStateGetRsp, "name": "NetStateGet"},
+    0xB0: {"object": AppkeyAddBatchRsp, "name": "AppkeyAddBatch"},
+    0xB1: {"object": DevkeyAddBatchRsp, "name": "DevkeyAddBatch"},
+    0xB2: {"object": AddrSubscriptionAddBatchRsp, "name": "AddrSubscriptionAddBatch"},
+    0xB3: {"object": AddrPublicationAddBatchRsp, "name": "AddrPublicationAddBatch"},
     0xD4: {"object": BankInfoGetRsp, "name": "BankInfoGet"},
     0xD6: {"object": StateGetRsp, "name": "StateGet"},
     0xE1: {"object": ModelPubAddrGetRsp, "name": "ModelPubAddrGet"},
@@ -1944,6 +2174,8 @@ RESPONSE_LUT = {
     0xF2: {"object": ModelIdGetRsp, "name": "ModelIdGet"},
     0xF3: {"object": HandleGetRsp, "name": "HandleGet"},
     0xF4: {"object": ElemModelsGetRsp, "name": "ElemModelsGet"},
+    0xF5: {"object": ModelSubsAddBatchRsp, "name": "ModelSubsAddBatch"},
+    0xF6: {"object": ModelAppBindBatchRsp, "name": "ModelAppBindBatch"},
     0xFC: {"object": ModelsGetRsp, "name": "ModelsGet"},
     0xFD: {"object": InitRsp, "name": "Init"},
     0xFE: {"object": CommandRsp, "name": "Command"}
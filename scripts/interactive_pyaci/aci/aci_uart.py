@@ -31,6 +31,7 @@ import logging
 import traceback
 import threading
 import collections
+import time
 from serial import Serial
 from aci.aci_cmd import CommandPacket
 from aci.aci_evt import event_deserialize
@@ -38,16 +39,41 @@ import queue
 
 EVT_Q_BUF = 128
 SEGGER_UART_BYTES_MAX = 63
+CMD_RSP_TIMEOUT = 2
+
+# Events ending a command: DeviceStarted for Reset, DeviceEchoRsp for Echo and CmdRsp for the rest
+CMD_RSP_OPCODES = (0x81, 0x82, 0x84)
+CMD_RSP_OPCODE = 0x84
+# Command opcode answered by each of the events without a command opcode field
+CMD_RSP_COMMAND_OPCODES = {0x81: 0x0E, 0x82: 0x02}
+
+OutstandingCommand = collections.namedtuple("OutstandingCommand", ["sequence_number", "cmd", "deadline"])
 
 
 class Device(object):
-    def __init__(self, device_name):
+    """ACI device with a window of commands in flight.
+
+    The device processes commands in the order they were received, and answers every command
+    before it starts on the next one. The host may therefore send up to `window` commands without
+    waiting for their responses, and matches the responses to the outstanding commands in order.
+    Every command is given a sequence number by the host, which is returned by write_aci_cmd().
+
+    A response is matched to the oldest outstanding command with the opcode it answers. Older
+    commands are taken as lost, so one missing or late response doesn't shift the matching of
+    the responses after it.
+    """
+    def __init__(self, device_name, window=1):
         self.device_name = device_name
         self.logger = logging.getLogger(self.device_name)
         self._pack_recipients = []
         self._cmd_recipients = []
-        self.lock = threading.Event()
-        self.events = list()
+        self.window = window
+        self.__window_slots = threading.Semaphore(window)
+        self.__outstanding = collections.deque()
+        self.__outstanding_lock = threading.Lock()
+        self.__sequence_number = 0
+        self.__completed_count = 0
+        self.__sequence_lock = threading.Lock()
         self.__write_queue = queue.Queue()
         self.writer_alive = True
         threading.Thread(target=self.__writer).start()
@@ -59,17 +85,53 @@ class Device(object):
         self.writer_alive = False
         self.__write_queue.put(None)
 
-    def __wait(self, timeout=2):
-        if len(self.events) == 0:
-            self.lock.wait(timeout)
-        self.lock.clear()
+    def __oldest_timeout_get(self):
+        with self.__outstanding_lock:
+            if len(self.__outstanding) == 0:
+                return CMD_RSP_TIMEOUT
+            return max(0, self.__outstanding[0].deadline - time.monotonic())
 
-        if len(self.events) == 0:
-            return None
+    def __window_slot_wait(self):
+        while not self.__window_slots.acquire(timeout=self.__oldest_timeout_get()):
+            if not self.writer_alive:
+                return False
+            with self.__outstanding_lock:
+                if len(self.__outstanding) == 0 or self.__outstanding[0].deadline > time.monotonic():
+                    continue
+                expired = self.__outstanding.popleft()
+                self.__completed_count += 1
+            self.__window_slots.release()
+            self.logger.info('cmd %s (#%d), timeout waiting for event',
+                             expired.cmd.__class__.__name__, expired.sequence_number)
+        return True
+
+    def __command_complete(self, packet):
+        if packet._opcode == CMD_RSP_OPCODE:
+            opcode = packet._data["opcode"]
         else:
-            event = self.events[:]
-            self.events.clear()
-            return event
+            opcode = CMD_RSP_COMMAND_OPCODES[packet._opcode]
+
+        with self.__outstanding_lock:
+            index = next((i for i, outstanding in enumerate(self.__outstanding)
+                          if outstanding.cmd._opcode == opcode), None)
+            if index is None:
+                # Late response to a command that has timed out, or an unsolicited event
+                self.logger.debug('response to opcode 0x%02x without a command', opcode)
+                return
+            lost = [self.__outstanding.popleft() for _ in range(index)]
+            self.__outstanding.popleft()
+            self.__completed_count += index + 1
+
+        for _ in range(index + 1):
+            self.__window_slots.release()
+        for command in lost:
+            self.logger.warning('cmd %s (#%d), no response',
+                                command.cmd.__class__.__name__, command.sequence_number)
+
+    def outstanding_count(self):
+        """Number of commands queued or sent, and not yet answered or timed out."""
+        with self.__sequence_lock, self.__outstanding_lock:
+            return self.__sequence_number - self.__completed_count
 
     def add_packet_recipient(self, function):
         self._pack_recipients.append(function)
@@ -82,8 +144,8 @@ class Device(object):
         self._cmd_recipients.append(function)
 
     def process_packet(self, packet):
-        self.events.append(packet)
-        self.lock.set()
+        if packet._opcode in CMD_RSP_OPCODES:
+            self.__command_complete(packet)
         for fun in self._pack_recipients[:]:
             try:
                 fun(packet)
@@ -105,27 +167,35 @@ class Device(object):
             if cmd is None:
                 return
             cmd.logger = self.logger
+            if not self.__window_slot_wait():
+                return
+            with self.__outstanding_lock:
+                self.__outstanding.append(OutstandingCommand(cmd.sequence_number, cmd,
+                                                             time.monotonic() + CMD_RSP_TIMEOUT))
             self.write_data(cmd.serialize())
-            retval = self.__wait()
-            if retval == None:
-                self.logger.info('cmd %s, timeout waiting for event' % (cmd.__class__.__name__))
 
     def write_aci_cmd(self, cmd):
+        """Queues a command for the device, and returns its sequence number."""
         if isinstance(cmd, CommandPacket):
+            with self.__sequence_lock:
+                cmd.sequence_number = self.__sequence_number
+                self.__sequence_number += 1
             self.__write_queue.put(cmd)
+            return cmd.sequence_number
         else:
             self.logger.error('The command provided is not valid: %s\nIt must be an instance of the CommandPacket class (or one of its subclasses)', str(cmd))
+            return None
 
 
 class Uart(threading.Thread, Device):
-    def __init__(self, port, baudrate=115200, device_name=None, rtscts=True):
+    def __init__(self, port, baudrate=115200, device_name=None, rtscts=True, window=1):
         self.events_queue = collections.deque(maxlen=EVT_Q_BUF)
         threading.Thread.__init__(self)
         if not device_name:
             device_name = port
         self.device_name = device_name
         self.logger = logging.getLogger(self.device_name)
-        Device.__init__(self, self.device_name)
+        Device.__init__(self, self.device_name, window)
 
         self._write_lock = threading.Lock()
 
@@ -214,7 +214,8 @@ def start_ipython(options):
     for dev_com in comports:
         d.append(Interactive(Uart(port=dev_com,
                                   baudrate=options.baudrate,
-                                  device_name=dev_com.split("/")[-1])))
+                                  device_name=dev_com.split("/")[-1],
+                                  window=options.window)))
 
     device = d[0]
     send = device.acidev.write_aci_cmd  # NOQA: Ignore unused variable
@@ -259,6 +260,13 @@ if __name__ == '__main__':
                         required=False,
                         default='115200',
                         help="Baud rate. Default: 115200")
+    parser.add_argument("-w", "--window",
+                        dest="window",
+                        type=int,
+                        required=False,
+                        default=1,
+                        help=("Number of commands sent to the device without "
+                              + "waiting for their responses. Default: 1"))
     parser.add_argument("--no-logfile",
                         dest="no_logfile",
                         action="store_true",
@@ -0,0 +1,279 @@
+# Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Network import benchmark.
+
+Imports a synthetic network database into the device, first with one serial command per key,
+address and model binding, and then with the batched commands. Reports the number of commands and the
+time taken for each import. Each command is stored with one mesh_config flush, so the number of
+commands is also the number of flushes. Without
+a device, the import runs against a model of the device, with the UART byte time given by the baud
+rate, a fixed host round trip latency and a fixed processing time per command and per item.
+
+The batched import must be run on a freshly reset device, as the single import leaves its keys
+and addresses behind: run the benchmark with either `--single` or `--batch` against a device. The
+device must be built with room for the device keys and addresses of all the nodes.
+"""
+
+import logging
+import os
+import struct
+import threading
+import time
+from argparse import ArgumentParser
+
+from aci.aci_cmd import (AppkeyAdd, DevkeyAdd, AddrSubscriptionAdd, AddrPublicationAdd,
+                         ModelSubsAdd, ModelAppBind, AppkeyAddBatch, DevkeyAddBatch,
+                         AddrSubscriptionAddBatch, AddrPublicationAddBatch, ModelSubsAddBatch,
+                         ModelAppBindBatch)
+from aci.aci_uart import Uart
+
+UART_BITS_PER_BYTE = 10
+CMD_RSP_OPCODE = 0x84
+CMD_RSP_TIMEOUT = 2.0
+
+KEY_ADD_BATCH_COUNT_MAX = 12
+ADDR_ADD_BATCH_COUNT_MAX = 126
+HANDLE_PAIR_BATCH_COUNT_MAX = 63
+
+UNICAST_ADDRESS_START = 0x0100
+GROUP_ADDRESS_START = 0xC000
+
+
+class NetworkImportError(Exception):
+    pass
+
+
+class Network(object):
+    """Synthetic network database: a number of nodes with a device key and a unicast address
+    each, a set of application keys and group addresses, and local models bound to all the
+    application keys and subscribed to all the group addresses."""
+    def __init__(self, nodes, appkeys, groups, models):
+        self.appkeys = [(i, 0, os.urandom(16)) for i in range(appkeys)]
+        self.devkeys = [(UNICAST_ADDRESS_START + i, 0, os.urandom(16)) for i in range(nodes)]
+        self.unicast_addresses = [UNICAST_ADDRESS_START + i for i in range(nodes)]
+        self.group_addresses = [GROUP_ADDRESS_START + i for i in range(groups)]
+        self.model_handles = list(range(models))
+
+
+class DeviceImporter(object):
+    """Sends one command at a time to a device, and waits for its response."""
+    def __init__(self, port, baudrate):
+        self.device = Uart(port=port, baudrate=baudrate)
+        self.__response = None
+        self.__responded = threading.Event()
+        self.device.add_packet_recipient(self.__packet_handle)
+
+    def __packet_handle(self, packet):
+        if packet._opcode == CMD_RSP_OPCODE:
+            self.__response = packet
+            self.__responded.set()
+
+    def time_get(self):
+        return time.monotonic()
+
+    def send(self, cmd):
+        self.__responded.clear()
+        self.device.write_aci_cmd(cmd)
+        if not self.__responded.wait(CMD_RSP_TIMEOUT):
+            raise NetworkImportError("No response to %s" % cmd.__class__.__name__)
+        if self.__response._data["status"] != 0:
+            raise NetworkImportError("%s failed with status 0x%02x" % (cmd.__class__.__name__,
+                                                                 self.__response._data["status"]))
+        return self.__response._data["data"]
+
+    def stop(self):
+        self.device.stop()
+
+
+class ModelImporter(object):
+    """Model of the device side of the serial link, running on a simulated clock.
+
+    Every command waits for the response to the previous one. A command costs the host round
+    trip latency, the UART time of the command and its response, and the processing time of the
+    command and each of its items. Handles are given out in order, as by a freshly reset device.
+    """
+    HANDLE_OPCODES = {0x97: "appkey", 0x9C: "devkey", 0xA1: "subscription", 0xA4: "publication",
+                      0xB0: "appkey", 0xB1: "devkey", 0xB2: "subscription", 0xB3: "publication"}
+
+    def __init__(self, baudrate, latency, process_time, item_time):
+        self.__byte_time = UART_BITS_PER_BYTE / baudrate
+        self.__latency = latency
+        self.__process_time = process_time
+        self.__item_time = item_time
+        self.__now = 0.0
+        self.__handles = {}
+
+    def time_get(self):
+        return self.__now
+
+    def send(self, cmd, items=1):
+        rsp = bytearray()
+        table = self.HANDLE_OPCODES.get(cmd._opcode)
+        if table is not None:
+            for _ in range(items):
+                handle = self.__handles.get(table, 0)
+                self.__handles[table] = handle + 1
+                rsp += struct.pack("<H", handle)
+        elif cmd._opcode in (0xF5, 0xF6):
+            rsp += struct.pack("<B", items)
+
+        # Length and opcode of the command, and length, opcode, command opcode and status of the response
+        uart_bytes = len(cmd.serialize()) + 4 + len(rsp)
+        self.__now += (self.__latency + uart_bytes * self.__byte_time
+                       + self.__process_time + items * self.__item_time)
+        return rsp
+
+    def stop(self):
+        pass
+
+
+def chunks(items, size):
+    return [items[i:i + size] for i in range(0, len(items), size)]
+
+
+def handles_get(rsp):
+    return list(struct.unpack("<%dH" % (len(rsp) // 2), rsp))
+
+
+def import_single(importer, network):
+    commands = 0
+
+    appkey_handles = []
+    for appkey in network.appkeys:
+        appkey_handles += handles_get(importer.send(AppkeyAdd(*appkey)))
+    for devkey in network.devkeys:
+        importer.send(DevkeyAdd(*devkey))
+    for address in network.unicast_addresses:
+        importer.send(AddrPublicationAdd(address))
+    subscription_handles = []
+    for address in network.group_addresses:
+        subscription_handles += handles_get(importer.send(AddrSubscriptionAdd(address)))
+    commands += (len(network.appkeys) + len(network.devkeys) + len(network.unicast_addresses)
+                 + len(network.group_addresses))
+
+    for model_handle in network.model_handles:
+        for appkey_handle in appkey_handles:
+            importer.send(ModelAppBind(model_handle, appkey_handle))
+            commands += 1
+        for subscription_handle in subscription_handles:
+            importer.send(ModelSubsAdd(model_handle, subscription_handle))
+            commands += 1
+
+    return commands
+
+
+def send_batch(importer, cmd, items):
+    if isinstance(importer, ModelImporter):
+        return importer.send(cmd, items)
+    return importer.send(cmd)
+
+
+def import_batch(importer, network):
+    commands = 0
+
+    appkey_handles = []
+    for appkeys in chunks(network.appkeys, KEY_ADD_BATCH_COUNT_MAX):
+        appkey_handles += handles_get(send_batch(importer, AppkeyAddBatch(appkeys), len(appkeys)))
+        commands += 1
+    for devkeys in chunks(network.devkeys, KEY_ADD_BATCH_COUNT_MAX):
+        send_batch(importer, DevkeyAddBatch(devkeys), len(devkeys))
+        commands += 1
+    for addresses in chunks(network.unicast_addresses, ADDR_ADD_BATCH_COUNT_MAX):
+        send_batch(importer, AddrPublicationAddBatch(addresses), len(addresses))
+        commands += 1
+    subscription_handles = []
+    for addresses in chunks(network.group_addresses, ADDR_ADD_BATCH_COUNT_MAX):
+        rsp = send_batch(importer, AddrSubscriptionAddBatch(addresses), len(addresses))
+        subscription_handles += handles_get(rsp)
+        commands += 1
+
+    binds = [(m, a) for m in network.model_handles for a in appkey_handles]
+    subscriptions = [(m, s) for m in network.model_handles for s in subscription_handles]
+    for cls, pairs in ((ModelAppBindBatch, binds), (ModelSubsAddBatch, subscriptions)):
+        for batch in chunks(pairs, HANDLE_PAIR_BATCH_COUNT_MAX):
+            rsp = send_batch(importer, cls(batch), len(batch))
+            if rsp[0] != len(batch):
+                raise NetworkImportError("%s stopped after %d of %d pairs" % (cls.__name__, rsp[0], len(batch)))
+            commands += 1
+
+    return commands
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description="Network import benchmark")
+    parser.add_argument("-d", "--device", dest="device", required=False, default=None,
+                        help="Device communication port. Runs against a model of the device if not given.")
+    parser.add_argument("-b", "--baudrate", dest="baudrate", type=int, required=False, default=115200,
+                        help="Baud rate. Default: 115200")
+    parser.add_argument("-n", "--nodes", dest="nodes", type=int, required=False, default=2000,
+                        help="Number of nodes in the network. Default: 2000")
+    parser.add_argument("--appkeys", dest="appkeys", type=int, required=False, default=4,
+                        help="Number of application keys. Default: 4")
+    parser.add_argument("--groups", dest="groups", type=int, required=False, default=32,
+                        help="Number of group addresses. Default: 32")
+    parser.add_argument("--models", dest="models", type=int, required=False, default=8,
+                        help="Number of local models to bind and subscribe. Default: 8")
+    parser.add_argument("--single", dest="single_only", action="store_true",
+                        help="Only run the import with single commands")
+    parser.add_argument("--batch", dest="batch_only", action="store_true",
+                        help="Only run the import with batched commands")
+    parser.add_argument("--latency", dest="latency", type=float, required=False, default=1000,
+                        help="Device model: host round trip latency in microseconds. Default: 1000")
+    parser.add_argument("--process-time", dest="process_time", type=float, required=False, default=100,
+                        help="Device model: command processing time in microseconds. Default: 100")
+    parser.add_argument("--item-time", dest="item_time", type=float, required=False, default=50,
+                        help="Device model: processing time per item in microseconds. Default: 50")
+    options = parser.parse_args()
+
+    logging.basicConfig(level=logging.WARNING)
+
+    if options.device and not (options.single_only or options.batch_only):
+        parser.error("Select --single or --batch when importing into a device")
+
+    network = Network(options.nodes, options.appkeys, options.groups, options.models)
+    imports = [("single", import_single), ("batch", import_batch)]
+    if options.single_only:
+        imports = imports[:1]
+    elif options.batch_only:
+        imports = imports[1:]
+
+    print("%8s %10s %10s" % ("import", "commands", "seconds"))
+    for name, function in imports:
+        if options.device:
+            importer = DeviceImporter(options.device, options.baudrate)
+        else:
+            importer = ModelImporter(options.baudrate, options.latency / 1e6,
+                                     options.process_time / 1e6, options.item_time / 1e6)
+        start = importer.time_get()
+        try:
+            commands = function(importer, network)
+        finally:
+            importer.stop()
+        print("%8s %10d %10.3f" % (name, commands, importer.time_get() - start))
@@ -0,0 +1,168 @@
+# Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Serial command throughput benchmark.
+
+Sends a number of Echo commands to the device for a range of command windows, and reports the
+number of commands per second completed with each window. Without a device, the benchmark runs
+against a loopback model of the device, with the UART byte time given by the baud rate and a fixed
+processing time per command.
+"""
+
+import collections
+import logging
+import queue
+import threading
+import time
+from argparse import ArgumentParser
+
+from aci.aci_cmd import Echo
+from aci.aci_evt import event_deserialize
+from aci.aci_uart import Device, Uart
+
+UART_BITS_PER_BYTE = 10
+ECHO_RSP_OPCODE = 0x82
+
+
+class LoopbackDevice(Device):
+    """Model of the device side of the serial link.
+
+    Commands arrive after their bytes have gone over the host-to-device link, and are processed
+    one at a time in the order they arrived. The device receive buffer holds `rx_packets`
+    commands, after which flow control holds back the host. Responses are sent in order on the
+    device-to-host link, with `tx_gap` seconds of idle line between packets unless the device
+    sends queued packets back to back.
+    """
+    def __init__(self, window, baudrate, process_time, tx_gap, rx_packets):
+        self.__byte_time = UART_BITS_PER_BYTE / baudrate
+        self.__process_time = process_time
+        self.__tx_gap = tx_gap
+        self.__rx_packets = rx_packets
+        self.__host_link_free = 0.0
+        self.__uart_free = 0.0
+        self.__device_free = 0.0
+        self.__processed = collections.deque()
+        self.__rx_queue = queue.Queue()
+        self.__alive = True
+        Device.__init__(self, "loopback", window)
+        threading.Thread(target=self.__device).start()
+
+    def stop(self):
+        self.__alive = False
+        self.__rx_queue.put(None)
+        self.kill_writer()
+
+    def write_data(self, data):
+        now = time.monotonic()
+        start = max(now, self.__host_link_free)
+        if len(self.__processed) >= self.__rx_packets:
+            # Flow control: the command waits for a free slot in the receive buffer
+            start = max(start, self.__processed[-self.__rx_packets])
+        self.__host_link_free = start + len(data) * self.__byte_time
+        self.__rx_queue.put((self.__host_link_free, bytearray(data)))
+        self.process_command(data)
+
+    def __sleep_until(self, t):
+        delay = t - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+
+    def __device(self):
+        while self.__alive:
+            item = self.__rx_queue.get()
+            if item is None:
+                return
+            arrival, cmd = item
+            done = max(arrival, self.__device_free) + self.__process_time
+            self.__device_free = done
+            self.__processed.append(done)
+            if len(self.__processed) > self.__rx_packets:
+                self.__processed.popleft()
+
+            rsp = bytearray([len(cmd) - 1, ECHO_RSP_OPCODE]) + cmd[2:]
+            gap = 0 if self.__uart_free < done else self.__tx_gap
+            self.__uart_free = max(done, self.__uart_free + gap) + len(rsp) * self.__byte_time
+            self.__sleep_until(self.__uart_free)
+            self.process_packet(event_deserialize(rsp))
+
+
+def run(device, count, length):
+    completed = [0]
+    done = threading.Event()
+
+    def echo_rsp_count(packet):
+        if packet._opcode == ECHO_RSP_OPCODE:
+            completed[0] += 1
+            if completed[0] == count:
+                done.set()
+
+    device.add_packet_recipient(echo_rsp_count)
+    start = time.monotonic()
+    for i in range(count):
+        device.write_aci_cmd(Echo(bytearray([i & 0x7F] * length)))
+    done.wait(count * 2)
+    elapsed = time.monotonic() - start
+    device.remove_packet_recipient(echo_rsp_count)
+    return completed[0], elapsed
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description="Serial command throughput benchmark")
+    parser.add_argument("-d", "--device", dest="device", required=False, default=None,
+                        help="Device communication port. Runs against a loopback model if not given.")
+    parser.add_argument("-b", "--baudrate", dest="baudrate", type=int, required=False, default=115200,
+                        help="Baud rate. Default: 115200")
+    parser.add_argument("-w", "--windows", dest="windows", type=int, nargs="+", required=False,
+                        default=[1, 2, 4, 8], help="Command windows to measure. Default: 1 2 4 8")
+    parser.add_argument("-n", "--count", dest="count", type=int, required=False, default=500,
+                        help="Number of commands per window. Default: 500")
+    parser.add_argument("-l", "--length", dest="length", type=int, required=False, default=16,
+                        help="Echo data length in bytes. Default: 16")
+    parser.add_argument("--process-time", dest="process_time", type=float, required=False, default=100,
+                        help="Loopback model: command processing time in microseconds. Default: 100")
+    parser.add_argument("--tx-gap", dest="tx_gap", type=float, required=False, default=0,
+                        help=("Loopback model: idle time between device packets in microseconds, "
+                              + "0 for back to back transmission. Default: 0"))
+    parser.add_argument("--rx-packets", dest="rx_packets", type=int, required=False, default=2,
+                        help="Loopback model: device receive buffer size in packets. Default: 2")
+    options = parser.parse_args()
+
+    logging.basicConfig(level=logging.WARNING)
+
+    print("%8s %10s %10s %12s" % ("window", "commands", "seconds", "commands/s"))
+    for window in options.windows:
+        if options.device:
+            device = Uart(port=options.device, baudrate=options.baudrate, window=window)
+        else:
+            device = LoopbackDevice(window, options.baudrate, options.process_time / 1e6,
+                                    options.tx_gap / 1e6, options.rx_packets)
+
+        completed, elapsed = run(device, options.count, options.length)
+        device.stop()
+        print("%8d %10d %10.3f %12.1f" % (window, completed, elapsed, completed / elapsed))
@@ -0,0 +1,197 @@
+# Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Captures internal event trace records from a device running the serial example, and converts
+them to the Chrome trace event format, to be viewed in chrome://tracing or Perfetto.
+
+The device must be built with INTERNAL_EVENT_TRACE_ENABLE=1.
+
+Usage:
+    trace_to_chrome.py capture -d /dev/ttyACM0 -t 10 -o trace.bin
+    trace_to_chrome.py convert trace.bin -o trace.json
+"""
+
+from argparse import ArgumentParser
+import json
+import os
+import struct
+import sys
+import time
+
+
+OPCODE_INTERNAL_EVENTS_TRACE_READ = 0x16
+SERIAL_STATUS_SUCCESS = 0x00
+
+RESPONSE_OVERHEAD = 8
+RECORD_SIZE = 8
+
+PHASE_INSTANT = 0
+PHASE_BEGIN = 1
+PHASE_END = 2
+
+# Must be kept in sync with internal_event_type_t in mesh/core/include/internal_event.h
+EVENT_NAMES = [
+    "Decrypt app",
+    "Transport decrypted",
+    "Transport segment decrypted",
+    "Packet dropped",
+    "Packet relayed",
+    "Network packet queued for TX",
+    "Transport ACK received",
+    "Transport ACK queued",
+    "SAR cancelled",
+    "Flash manager action",
+    "Flash manager defrag",
+    "SAR success",
+    "Network packet received",
+    "GATT provisioning PDU ignored",
+    "Friend packet queued",
+    "Network beacon TX",
+    "Network decrypt",
+    "Transport decrypt",
+    "Access dispatch",
+    "Flash operation",
+    "Bearer action",
+]
+
+
+def event_name(event_type):
+    if event_type < len(EVENT_NAMES):
+        return EVENT_NAMES[event_type]
+    return "Event %u" % event_type
+
+
+def responses_read(data):
+    """Splits a capture file into the (timestamp_hz, dropped_count, records) of each response."""
+    offset = 0
+    while offset + 2 <= len(data):
+        length, = struct.unpack_from("<H", data, offset)
+        offset += 2
+        response = data[offset:offset + length]
+        offset += length
+        if len(response) < RESPONSE_OVERHEAD:
+            break
+        timestamp_hz, dropped_count = struct.unpack_from("<II", response, 0)
+        records = [struct.unpack_from("<IBBBB", response, i)
+                   for i in range(RESPONSE_OVERHEAD, len(response) - RECORD_SIZE + 1, RECORD_SIZE)]
+        yield timestamp_hz, dropped_count, records
+
+
+def chrome_trace_convert(responses):
+    """Converts the trace records to Chrome trace events.
+
+    Spans of each type get their own track, so that spans running in different interrupt
+    priorities don't have to nest. The 32-bit timestamps are unwrapped assuming that less than
+    one timer wrap passes between consecutive records.
+    """
+    events = []
+    ticks = None
+    last_timestamp = 0
+    for timestamp_hz, dropped_count, records in responses:
+        if dropped_count > 0 and ticks is not None:
+            events.append({"name": "%u records dropped" % dropped_count, "ph": "i", "s": "g",
+                           "ts": ticks * 1e6 / timestamp_hz, "pid": 0, "tid": 0})
+
+        for timestamp, event_type, phase, state, packet_size in records:
+            if ticks is None:
+                ticks = 0
+            else:
+                ticks += (timestamp - last_timestamp) & 0xFFFFFFFF
+            last_timestamp = timestamp
+
+            event = {"name": event_name(event_type),
+                     "ts": ticks * 1e6 / timestamp_hz,
+                     "pid": 0,
+                     "args": {"state": state, "packet_size": packet_size}}
+            if phase == PHASE_INSTANT:
+                event.update({"ph": "i", "s": "t", "tid": 0})
+            else:
+                event.update({"ph": "B" if phase == PHASE_BEGIN else "E", "tid": event_type + 1})
+            events.append(event)
+
+    metadata = [{"name": "thread_name", "ph": "M", "pid": 0, "tid": 0, "args": {"name": "Internal events"}}]
+    for event_type in sorted(set(e["tid"] for e in events if e["tid"] != 0)):
+        metadata.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": event_type,
+                         "args": {"name": event_name(event_type - 1)}})
+
+    return {"traceEvents": metadata + events, "displayTimeUnit": "ns"}
+
+
+def capture(device, baudrate, duration, interval, output):
+    sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "scripts", "interactive_pyaci"))
+    from aci.aci_uart import Uart
+    from aci.aci_evt import CmdRsp
+    from aci import aci_cmd
+
+    def response_write(packet):
+        if (isinstance(packet, CmdRsp) and
+                packet._data["opcode"] == OPCODE_INTERNAL_EVENTS_TRACE_READ and
+                packet._data["status"] == SERIAL_STATUS_SUCCESS):
+            output.write(struct.pack("<H", len(packet._data["data"])) + bytes(packet._data["data"]))
+
+    uart = Uart(port=device, baudrate=baudrate)
+    uart.add_packet_recipient(response_write)
+    try:
+        end = time.time() + duration
+        while time.time() < end:
+            uart.write_aci_cmd(aci_cmd.InternalEventsTraceRead(1))
+            time.sleep(interval)
+        uart.write_aci_cmd(aci_cmd.InternalEventsTraceRead(0))
+        time.sleep(interval)
+    finally:
+        uart.stop()
+
+
+if __name__ == "__main__":
+    parser = ArgumentParser(description="Capture and convert internal event traces")
+    subparsers = parser.add_subparsers(dest="command")
+
+    capture_parser = subparsers.add_parser("capture", help="poll trace records from a device over serial")
+    capture_parser.add_argument("-d", "--device", required=True, help="serial port of the device")
+    capture_parser.add_argument("-b", "--baudrate", type=int, default=115200, help="serial baudrate")
+    capture_parser.add_argument("-t", "--time", type=float, default=10.0, help="capture duration in seconds")
+    capture_parser.add_argument("-i", "--interval", type=float, default=0.02,
+                                help="poll interval in seconds, must drain the trace buffer faster than it fills")
+    capture_parser.add_argument("-o", "--output", required=True, help="capture file")
+
+    convert_parser = subparsers.add_parser("convert", help="convert a capture file to Chrome trace JSON")
+    convert_parser.add_argument("capture", help="capture file")
+    convert_parser.add_argument("-o", "--output", required=True, help="Chrome trace JSON file")
+
+    args = parser.parse_args()
+    if args.command == "capture":
+        with open(args.output, "wb") as f:
+            capture(args.device, args.baudrate, args.time, args.interval, f)
+    elif args.command == "convert":
+        with open(args.capture, "rb") as f:
+            trace = chrome_trace_convert(responses_read(f.read()))
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        parser.print_help()
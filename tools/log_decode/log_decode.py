@@ -0,0 +1,212 @@
+# Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Decoder for the deferred binary log records of log_callback_deferred().
+
+The records carry the addresses of the format and file name strings instead of the strings
+themselves. The strings are read from the ELF file of the firmware that produced the log, so the
+ELF file must match the firmware exactly.
+
+Usage: log_decode.py <firmware.elf> <records.bin>
+"""
+
+from argparse import ArgumentParser
+import re
+import struct
+import sys
+
+
+RECORD_TYPE_PRINTF = 0
+RECORD_TYPE_HEXDUMP = 1
+RECORD_TYPE_DROP = 2
+
+RECORD_HEADER_SIZE = 16
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGaApn%])")
+
+
+class ElfStrings(object):
+    """Reads NUL terminated strings at their addresses from the loadable sections of an ELF file."""
+
+    def __init__(self, filename):
+        with open(filename, "rb") as f:
+            self.data = f.read()
+
+        if self.data[:4] != b"\x7fELF" or self.data[5] != 1:
+            raise ValueError("%s is not a little endian ELF file" % filename)
+
+        if self.data[4] == 1:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+            section_fmt = "<IIIIII"
+        else:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x3A)
+            section_fmt = "<IIQQQQ"
+
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(section_fmt, self.data, shoff + i * shentsize)
+            if (flags & SHF_ALLOC) and sh_type != SHT_NOBITS and addr != 0:
+                self.sections.append((addr, offset, size))
+
+    def get(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.index(b"\x00", start)
+                return self.data[start:end].decode("ascii", "replace")
+        return "<unknown string 0x%08x>" % address
+
+
+class Arguments(object):
+    """Raw arguments of a record, in the order of the format string conversions."""
+
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def get(self, fmt, size):
+        if self.offset + size > len(self.data):
+            raise IndexError
+        value, = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += size
+        return value
+
+    def string(self):
+        length = self.get("<B", 1)
+        if self.offset + length > len(self.data):
+            raise IndexError
+        value = self.data[self.offset:self.offset + length].decode("ascii", "replace")
+        self.offset += length
+        return value
+
+
+def conversion_render(match, args):
+    flags, width, precision, length, conversion = match.groups()
+    if conversion == "%":
+        return "%"
+
+    if width == "*":
+        width = str(args.get("<i", 4))
+    if precision == "*":
+        precision = str(args.get("<i", 4))
+    spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+
+    is_long = length in ("l", "ll", "j", "z", "t", "L")
+    if conversion in "di":
+        return (spec + "d") % args.get("<q" if is_long else "<i", 8 if is_long else 4)
+    if conversion in "ouxX":
+        value = args.get("<Q" if is_long else "<I", 8 if is_long else 4)
+        return (spec + conversion.replace("u", "d")) % value
+    if conversion == "c":
+        return (spec + "s") % chr(args.get("<i", 4) & 0xFF)
+    if conversion in "aA":
+        value = float.hex(args.get("<d", 8))
+        return value.upper() if conversion == "A" else value
+    if conversion in "fFeEgG":
+        return (spec + conversion) % args.get("<d", 8)
+    if conversion == "s":
+        return (spec + "s") % args.string()
+    if conversion == "p":
+        return "0x%x" % args.get("<Q", 8)
+    return ""
+
+
+def printf_render(format_string, data):
+    args = Arguments(data)
+    output = []
+    position = 0
+    for match in CONVERSION.finditer(format_string):
+        output.append(format_string[position:match.start()])
+        try:
+            output.append(conversion_render(match, args))
+        except IndexError:
+            output.append("<truncated>")
+            position = len(format_string)
+            if format_string.endswith("\n"):
+                output.append("\n")
+            break
+        position = match.end()
+    output.append(format_string[position:])
+    return "".join(output)
+
+
+def hexdump_render(message, data):
+    length = data[0]
+    text = "".join("%02X" % b for b in data[1:])
+    if length > len(data) - 1:
+        text += ".."
+    return "%s: %s\n" % (message, text)
+
+
+def records_decode(strings, data):
+    offset = 0
+    while offset + 4 <= len(data):
+        header, = struct.unpack_from("<I", data, offset)
+        len_words = header & 0xFF
+        record_type = (header >> 8) & 0x03
+        padding = (header >> 10) & 0x03
+        line = header >> 16
+
+        if len_words == 0 or offset + len_words * 4 > len(data):
+            break
+
+        if record_type == RECORD_TYPE_DROP:
+            dropped, = struct.unpack_from("<I", data, offset + 4)
+            yield "<%u log records dropped>\n" % dropped
+        else:
+            timestamp, string, filename = struct.unpack_from("<III", data, offset + 4)
+            args = data[offset + RECORD_HEADER_SIZE:offset + len_words * 4 - padding]
+            if record_type == RECORD_TYPE_HEXDUMP:
+                message = hexdump_render(strings.get(string), args)
+            else:
+                message = printf_render(strings.get(string), args)
+            yield "<t: %10u>, %s, %4d, %s" % (timestamp, strings.get(filename), line, message)
+
+        offset += len_words * 4
+
+
+if __name__ == "__main__":
+    parser = ArgumentParser(description="Decode deferred binary log records")
+    parser.add_argument("elf", help="ELF file of the firmware that produced the log")
+    parser.add_argument("records", help="file with the records read by log_deferred_read(), - for stdin")
+    args = parser.parse_args()
+
+    if args.records == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.records, "rb") as f:
+            data = f.read()
+
+    for text in records_decode(ElfStrings(args.elf), data):
+        sys.stdout.write(text)